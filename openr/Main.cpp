@@ -50,6 +50,7 @@
 #include <openr/prefix-manager/PrefixManager.h>
 #include <openr/spark/IoProvider.h>
 #include <openr/spark/Spark.h>
+#include <openr/telemetry/Telemetry.h>
 #include <openr/watchdog/Watchdog.h>
 
 using namespace fbzmq;
@@ -112,6 +113,47 @@ waitForFibService(const fbzmq::ZmqEventLoop& evl, int port) {
   LOG(INFO) << "FibService up. Waited for " << waitMs << " ms.";
 }
 
+void
+watchConfigFile(const fbzmq::ZmqEventLoop& evl, openr::Config& config) {
+  std::string activeContents;
+  if (not folly::readFile(FLAGS_config.c_str(), activeContents)) {
+    LOG(ERROR) << "Config-watch could not read " << FLAGS_config
+               << ". Config reload is disabled.";
+    return;
+  }
+
+  auto sinceLastCheck = std::chrono::seconds(0);
+  while (evl.isRunning()) {
+    // sleep in short slices so shutdown is not delayed by the poll interval
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    sinceLastCheck += std::chrono::seconds(1);
+    if (sinceLastCheck < std::chrono::seconds(FLAGS_config_reload_interval_s)) {
+      continue;
+    }
+    sinceLastCheck = std::chrono::seconds(0);
+
+    std::string contents;
+    if (not folly::readFile(FLAGS_config.c_str(), contents) or
+        contents == activeContents) {
+      continue;
+    }
+    activeContents = contents;
+
+    openr::thrift::OpenrConfig newConfig;
+    try {
+      apache::thrift::SimpleJSONSerializer().deserialize(contents, newConfig);
+      if (config.applyUpdate(std::move(newConfig))) {
+        LOG(INFO) << "Applied config update from " << FLAGS_config;
+      } else {
+        LOG(WARNING) << "Config update in " << FLAGS_config
+                     << " changes immutable knobs. Restart to apply it.";
+      }
+    } catch (const std::exception& ex) {
+      LOG(ERROR) << "Ignoring bad config update: " << folly::exceptionStr(ex);
+    }
+  }
+}
+
 /**
  * Start an EventBase in a thread, maintain order of thread creation and
  * returns raw pointer of Derived class.
@@ -122,6 +164,7 @@ startEventBase(
     std::vector<std::thread>& allThreads,
     std::vector<std::unique_ptr<OpenrEventBase>>& orderedEvbs,
     Watchdog* watchdog,
+    std::shared_ptr<const Config> config,
     const std::string& name,
     std::unique_ptr<T> evbT) {
   CHECK(evbT);
@@ -130,9 +173,15 @@ startEventBase(
       reinterpret_cast<OpenrEventBase*>(evbT.release()));
 
   // Start a thread
-  allThreads.emplace_back(std::thread([evb = evb.get(), name]() noexcept {
+  allThreads.emplace_back(std::thread([evb = evb.get(),
+                                       config,
+                                       name]() noexcept {
     LOG(INFO) << "Starting " << name << " thread ...";
     folly::setThreadName(name);
+    // pin and prioritize the thread if the config says so
+    if (auto threadConfig = config->getThreadConfig(name)) {
+      applyThreadSchedulingConfig(threadConfig.value());
+    }
     evb->run();
     LOG(INFO) << name << " thread got stopped.";
   }));
@@ -240,13 +289,20 @@ main(int argc, char** argv) {
   folly::setThreadName("openr");
 
   // Queue for inter-module communication
-  ReplicateQueue<openr::thrift::RouteDatabaseDelta> routeUpdatesQueue;
-  ReplicateQueue<openr::thrift::InterfaceDatabase> interfaceUpdatesQueue;
-  ReplicateQueue<openr::thrift::SparkNeighborEvent> neighborUpdatesQueue;
-  ReplicateQueue<openr::thrift::PrefixUpdateRequest> prefixUpdateRequestQueue;
-  ReplicateQueue<openr::thrift::Publication> kvStoreUpdatesQueue;
-  ReplicateQueue<openr::thrift::PeerUpdateRequest> peerUpdatesQueue;
-  ReplicateQueue<openr::thrift::RouteDatabaseDelta> staticRoutesUpdateQueue;
+  ReplicateQueue<openr::thrift::RouteDatabaseDelta> routeUpdatesQueue{
+      "route_updates"};
+  ReplicateQueue<openr::thrift::InterfaceDatabase> interfaceUpdatesQueue{
+      "interface_updates"};
+  ReplicateQueue<openr::thrift::SparkNeighborEvent> neighborUpdatesQueue{
+      "neighbor_updates"};
+  ReplicateQueue<openr::thrift::PrefixUpdateRequest> prefixUpdateRequestQueue{
+      "prefix_update_requests"};
+  ReplicateQueue<openr::thrift::Publication> kvStoreUpdatesQueue{
+      "kvstore_updates"};
+  ReplicateQueue<openr::thrift::PeerUpdateRequest> peerUpdatesQueue{
+      "peer_updates"};
+  ReplicateQueue<openr::thrift::RouteDatabaseDelta> staticRoutesUpdateQueue{
+      "static_route_updates"};
 
   // structures to organize our modules
   std::vector<std::thread> allThreads;
@@ -259,6 +315,7 @@ main(int argc, char** argv) {
         allThreads,
         orderedEvbs,
         nullptr /* watchdog won't monitor itself */,
+        config,
         "Watchdog",
         std::make_unique<Watchdog>(config));
   }
@@ -283,8 +340,17 @@ main(int argc, char** argv) {
 
     // Create Netlink Protocol object in a new thread
     nlEvb = std::make_unique<OpenrEventBase>();
-    nlSock =
-        std::make_unique<openr::fbnl::NetlinkProtocolSocket>(nlEvb->getEvb());
+    const size_t nlMaxInFlightMsgs = FLAGS_netlink_max_inflight_msgs;
+    uint32_t nlEventGroups = openr::fbnl::kNetlinkDefaultEventGroups;
+    if (not FLAGS_netlink_enable_neighbor_events) {
+      nlEventGroups &= ~RTMGRP_NEIGH;
+    }
+    nlSock = std::make_unique<openr::fbnl::NetlinkProtocolSocket>(
+        nlEvb->getEvb(),
+        false /* enableIPv6RouteReplaceSemantics */,
+        nlMaxInFlightMsgs,
+        std::min(openr::fbnl::kMinIovMsg, nlMaxInFlightMsgs),
+        nlEventGroups);
     allThreads.emplace_back([&]() {
       LOG(INFO) << "Starting NetlinkEvb thread ...";
       folly::setThreadName("NetlinkEvb");
@@ -298,9 +364,15 @@ main(int argc, char** argv) {
       watchdog->addEvb(nlEvb.get(), "NetlinkEvb");
     }
 
-    // Create event publisher to handle event subscription
-    eventPublisher = std::make_unique<PlatformPublisher>(
-        context, PlatformPublisherUrl{FLAGS_platform_pub_url}, nlSock.get());
+    // Create event publisher to handle event subscription. In link-monitor
+    // direct-netlink mode LinkMonitor owns the netlink event callbacks, so
+    // the publisher is not instantiated
+    if (not config->getConfig()
+                .enable_link_monitor_direct_netlink_ref()
+                .value_or(false)) {
+      eventPublisher = std::make_unique<PlatformPublisher>(
+          context, PlatformPublisherUrl{FLAGS_platform_pub_url}, nlSock.get());
+    }
 
     // ATTN: intentionally set evl capacity to be 1e5 instead of default 1e2
     if (config->isNetlinkFibHandlerEnabled()) {
@@ -363,8 +435,28 @@ main(int argc, char** argv) {
   });
   mainEventLoop.waitUntilRunning();
 
+  // FibService readiness only gates the Fib module, which is created
+  // last. Poll for it in the background so config-store, KvStore, Spark
+  // and friends come up concurrently with the wait; the join right
+  // before Fib construction preserves the old ordering guarantee
+  // Watch the config file for updates and apply dynamic knob changes
+  // in-process; immutable changes are logged as restart-required
+  std::unique_ptr<std::thread> configWatchThread{nullptr};
+  if (not FLAGS_config.empty() and FLAGS_config_reload_interval_s > 0) {
+    configWatchThread = std::make_unique<std::thread>(
+        [&mainEventLoop, &config]() noexcept {
+          folly::setThreadName("ConfigWatch");
+          watchConfigFile(mainEventLoop, *config);
+        });
+  }
+
+  std::unique_ptr<std::thread> fibServiceWaitThread{nullptr};
   if (FLAGS_enable_fib_service_waiting) {
-    waitForFibService(mainEventLoop, config->getConfig().fib_port);
+    fibServiceWaitThread = std::make_unique<std::thread>(
+        [&mainEventLoop, port = config->getConfig().fib_port]() noexcept {
+          folly::setThreadName("FibServiceWait");
+          waitForFibService(mainEventLoop, port);
+        });
   }
 
   // Starting openrCtrlEvb for thrift handler
@@ -382,6 +474,7 @@ main(int argc, char** argv) {
       allThreads,
       orderedEvbs,
       watchdog,
+      config,
       "ConfigStore",
       std::make_unique<PersistentStore>(
           config->getNodeName(), FLAGS_config_store_filepath, context));
@@ -410,11 +503,24 @@ main(int argc, char** argv) {
   monitor.waitUntilRunning();
   allThreads.emplace_back(std::move(monitorThread));
 
+  // Start sampled-telemetry exporter, shipping hot-path histograms
+  // through the monitor just started
+  if (config->getConfig().enable_telemetry_ref().value_or(false)) {
+    startEventBase(
+        allThreads,
+        orderedEvbs,
+        watchdog,
+        config,
+        "Telemetry",
+        std::make_unique<Telemetry>(config, monitorSubmitUrl, context));
+  }
+
   // Start KVStore
   auto kvStore = startEventBase(
       allThreads,
       orderedEvbs,
       watchdog,
+      config,
       "KvStore",
       std::make_unique<KvStore>(
           context,
@@ -429,12 +535,14 @@ main(int argc, char** argv) {
           maybeIpTos,
           std::unordered_map<std::string, openr::thrift::PeerSpec>{},
           FLAGS_kvstore_zmq_hwm,
-          FLAGS_enable_kvstore_thrift));
+          FLAGS_enable_kvstore_thrift,
+          configStore));
 
   auto prefixManager = startEventBase(
       allThreads,
       orderedEvbs,
       watchdog,
+      config,
       "PrefixManager",
       std::make_unique<PrefixManager>(
           prefixUpdateRequestQueue.getReader(),
@@ -451,6 +559,7 @@ main(int argc, char** argv) {
         allThreads,
         orderedEvbs,
         watchdog,
+        config,
         "PrefixAllocator",
         std::make_unique<PrefixAllocator>(
             config,
@@ -468,6 +577,7 @@ main(int argc, char** argv) {
       allThreads,
       orderedEvbs,
       watchdog,
+      config,
       "Spark",
       std::make_unique<Spark>(
           config->getConfig().domain, // My domain
@@ -523,11 +633,23 @@ main(int argc, char** argv) {
     return -1;
   }
 
+  // In direct-netlink mode LinkMonitor subscribes to link/address events
+  // straight on the in-process netlink socket and syncs interfaces without
+  // the thrift system-handler hop
+  openr::fbnl::NetlinkProtocolSocket* linkMonitorNlSock{nullptr};
+  if (config->getConfig().enable_link_monitor_direct_netlink_ref().value_or(
+          false)) {
+    CHECK(nlSock) << "link-monitor direct-netlink mode requires the netlink "
+                  << "handlers to be enabled";
+    linkMonitorNlSock = nlSock.get();
+  }
+
   // Create link monitor instance.
   auto linkMonitor = startEventBase(
       allThreads,
       orderedEvbs,
       watchdog,
+      config,
       "LinkMonitor",
       std::make_unique<LinkMonitor>(
           context,
@@ -544,7 +666,8 @@ main(int argc, char** argv) {
           FLAGS_assume_drained,
           prefixUpdateRequestQueue,
           PlatformPublisherUrl{FLAGS_platform_pub_url},
-          initialDumpTime));
+          initialDumpTime,
+          linkMonitorNlSock));
 
   // Wait for the above two threads to start and run before running
   // SPF in Decision module.  This is to make sure the Decision module
@@ -555,6 +678,7 @@ main(int argc, char** argv) {
       allThreads,
       orderedEvbs,
       watchdog,
+      config,
       "Decision",
       std::make_unique<Decision>(
           config,
@@ -567,11 +691,26 @@ main(int argc, char** argv) {
           routeUpdatesQueue,
           context));
 
+  // Block until FibService is reachable before bringing up Fib
+  if (fibServiceWaitThread) {
+    fibServiceWaitThread->join();
+  }
+
+  // In direct-netlink mode Fib programs routes through an in-process
+  // handler, bypassing serialization and the thrift hop to the local agent
+  std::shared_ptr<NetlinkFibHandler> inProcessFibHandler{nullptr};
+  if (config->getConfig().enable_fib_direct_netlink_ref().value_or(false)) {
+    CHECK(nlSock) << "direct-netlink fib mode requires the netlink handlers "
+                  << "to be enabled";
+    inProcessFibHandler = std::make_shared<NetlinkFibHandler>(nlSock.get());
+  }
+
   // Define and start Fib Module
   auto fib = startEventBase(
       allThreads,
       orderedEvbs,
       watchdog,
+      config,
       "Fib",
       std::make_unique<Fib>(
           config,
@@ -581,7 +720,9 @@ main(int argc, char** argv) {
           interfaceUpdatesQueue.getReader(),
           monitorSubmitUrl,
           kvStore,
-          context));
+          context,
+          inProcessFibHandler,
+          configStore));
 
   // Start OpenrCtrl thrift server
   apache::thrift::ThriftServer thriftCtrlServer;
@@ -669,6 +810,11 @@ main(int argc, char** argv) {
   // Wait for main-event loop to return
   mainEventLoopThread.join();
 
+  // Config-watch thread notices the stopped main event loop within a second
+  if (configWatchThread) {
+    configWatchThread->join();
+  }
+
   // Stop all threads (in reverse order of their creation)
   routeUpdatesQueue.close();
   interfaceUpdatesQueue.close();
@@ -57,7 +57,9 @@ PrefixAllocator::PrefixAllocator(
       area_(*config->getAreaIds().begin()),
       configStore_(configStore),
       prefixUpdatesQueue_(prefixUpdatesQueue),
-      zmqMonitorClient_(zmqContext, monitorSubmitUrl),
+      eventLogger_(
+          std::make_shared<fbzmq::ZmqMonitorClient>(
+              zmqContext, monitorSubmitUrl)),
       systemServicePort_(systemServicePort) {
   // check non-empty module ptr
   CHECK(configStore_);
@@ -552,6 +554,28 @@ PrefixAllocator::startAllocation(
     endIndex -= 1;
   }
 
+  // Warm-boot fast path - optimistically re-advertise the prefix elected
+  // before restart while the election is still in progress, so loopback
+  // programming and route origination resume right away. If KvStore later
+  // disagrees, the election callback above withdraws or replaces it. The
+  // disk cache only survives into this point on a genuine warm boot -
+  // collision restarts erase it when clearing local state
+  auto maybeThriftAllocPrefix =
+      configStore_->loadThriftObj<thrift::AllocPrefix>(kConfigKey).get();
+  if (maybeThriftAllocPrefix.hasValue()) {
+    const auto cachedParams = std::make_pair(
+        toIPNetwork(maybeThriftAllocPrefix->seedPrefix),
+        static_cast<uint8_t>(maybeThriftAllocPrefix->allocPrefixLen));
+    const auto cachedIndex =
+        static_cast<uint32_t>(maybeThriftAllocPrefix->allocPrefixIndex);
+    if (cachedParams == *allocParams_ and cachedIndex >= startIndex and
+        cachedIndex <= endIndex and not checkE2eAllocIndex(cachedIndex)) {
+      LOG(INFO) << "Optimistically re-advertising cached prefix index "
+                << cachedIndex << " while election is in progress";
+      applyMyPrefixIndex(cachedIndex);
+    }
+  }
+
   rangeAllocator_->startAllocator(
       std::make_pair(startIndex, endIndex), getInitPrefixIndex());
 }
@@ -819,7 +843,7 @@ PrefixAllocator::logPrefixEvent(
     sample.addInt("new_alloc_len", newAllocParams->second);
   }
 
-  zmqMonitorClient_.addEventLog(fbzmq::thrift::EventLog(
+  eventLogger_.log(fbzmq::thrift::EventLog(
       apache::thrift::FRAGILE,
       Constants::kEventLogCategory.toString(),
       {sample.toJson()}));
@@ -20,6 +20,7 @@
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 
 #include <openr/common/Constants.h>
+#include <openr/common/EventLogger.h>
 #include <openr/common/NetworkUtil.h>
 #include <openr/common/OpenrEventBase.h>
 #include <openr/common/Util.h>
@@ -197,8 +198,8 @@ class PrefixAllocator : public OpenrEventBase {
   // Queue to send prefix update request to PrefixManager
   messaging::ReplicateQueue<thrift::PrefixUpdateRequest>& prefixUpdatesQueue_;
 
-  // Monitor client for submitting counters/logs
-  fbzmq::ZmqMonitorClient zmqMonitorClient_;
+  // async event-log submitter towards the monitor
+  EventLogger eventLogger_;
 
   // Thriftclient for system service
   int32_t systemServicePort_{0};
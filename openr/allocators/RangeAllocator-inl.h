@@ -59,10 +59,22 @@ RangeAllocator<T>::RangeAllocator(
       area_(area) {
   timeout_ =
       fbzmq::ZmqTimeout::make(eventBase_->getEvb(), [this]() mutable noexcept {
-        CHECK(allocateValue_.has_value());
-        auto allocateValue = allocateValue_.value();
-        allocateValue_.reset();
-        tryAllocate(allocateValue);
+        CHECK(not allocateValues_.empty());
+        auto allocateValues = std::move(allocateValues_);
+        allocateValues_.clear();
+        // Probe all candidates in parallel. First one echoed back as ours
+        // wins - remaining claims get withdrawn upon the win
+        bool probing{false};
+        for (const auto& allocateValue : allocateValues) {
+          if (myValue_.has_value()) {
+            break; // won already (re-owned from previous incarnation)
+          }
+          probing |= tryAllocate(allocateValue);
+        }
+        if (not probing and not myValue_.has_value()) {
+          // no candidate could be owned - pick new ones
+          scheduleAllocate(allocateValues.back());
+        }
       });
 }
 
@@ -72,7 +84,14 @@ RangeAllocator<T>::~RangeAllocator() {
   // We need to cancel any pending timeout
   if (timeout_) {
     timeout_.reset();
-    allocateValue_.reset();
+    allocateValues_.clear();
+  }
+
+  // Withdraw any outstanding probes
+  for (const auto& val : myRequestedValues_) {
+    const auto key = createKey(val);
+    kvStoreClient_->unsubscribeKey(key);
+    kvStoreClient_->unsetKey(key, area_);
   }
 
   // Unsubscribe from KvStoreClientInternal if we have been to
@@ -122,7 +141,7 @@ RangeAllocator<T>::startAllocator(
   // Subscribe to changes in KvStore
   VLOG(2) << "RangeAllocator: Created. Scheduling first tryAllocate. "
           << "Node: " << nodeName_ << ", Prefix: " << keyPrefix_;
-  allocateValue_ = initValue;
+  allocateValues_ = {initValue};
   timeout_->scheduleTimeout(backoff_.getTimeRemainingUntilRetry());
 }
 
@@ -164,7 +183,7 @@ RangeAllocator<T>::getValueFromKvStore() const {
 }
 
 template <typename T>
-void
+bool
 RangeAllocator<T>::tryAllocate(const T newVal) noexcept {
   // Sanity check. We should not have any previously allocated value.
   CHECK(!myValue_.has_value())
@@ -192,23 +211,21 @@ RangeAllocator<T>::tryAllocate(const T newVal) noexcept {
   const bool shouldOwnMine =
       maybeThriftVal and (nodeName_ == maybeThriftVal->originatorId);
 
-  // If we cannot own then we should try some other value
+  // If we cannot own then the caller should try some other value
   if (!shouldOwnOther && !shouldOwnMine) {
     VLOG(1) << "RangeAllocator: failed to allocate " << newVal << " bcoz of "
             << maybeThriftVal->originatorId;
-    scheduleAllocate(newVal);
-    return;
+    return false;
   }
   // check if prefix index is already in use
   if (checkValueInUseCb_ and checkValueInUseCb_(newVal)) {
     VLOG(1) << "RangeAllocator: failed to allocate " << newVal
             << " as value already exists";
-    scheduleAllocate(newVal);
-    return;
+    return false;
   }
 
   if (shouldOwnOther) {
-    myRequestedValue_ = newVal;
+    myRequestedValues_.emplace(newVal);
     // Either no one owns it or owner has lower originator ID
     // Set new value in KvStore
     auto ttlVersion = maybeThriftVal ? maybeThriftVal->ttlVersion + 1 : 0;
@@ -250,6 +267,7 @@ RangeAllocator<T>::tryAllocate(const T newVal) noexcept {
       },
       false,
       area_);
+  return true;
 }
 
 template <typename T>
@@ -258,8 +276,9 @@ RangeAllocator<T>::scheduleAllocate(const T seedVal) noexcept {
   // Apply exponential backoff
   backoff_.reportError();
 
-  // Use random value selection logic based on seedVal
-  std::mt19937_64 gen(seedVal + folly::Random::rand64());
+  // Use random value selection logic seeded from node ID and seedVal, so
+  // contending nodes start probing from different spots in the range
+  std::mt19937_64 gen(std::hash<std::string>()(nodeName_) + seedVal);
   std::uniform_int_distribution<T> dist(allocRange_.first, allocRange_.second);
   auto newVal = dist(gen);
 
@@ -277,7 +296,8 @@ RangeAllocator<T>::scheduleAllocate(const T seedVal) noexcept {
       folly::gen::as<
           std::unordered_map<T /* value */, std::string /* owner */>>();
 
-  // look for a value I can own
+  // look for values I can own, up to kNumParallelProbes of them
+  std::vector<T> candidates;
   T i;
   for (i = 0; i < allocRangeSize_; ++i) {
     const auto it = valOwners.find(newVal);
@@ -285,18 +305,22 @@ RangeAllocator<T>::scheduleAllocate(const T seedVal) noexcept {
     if (it == valOwners.end() or (overrideOwner_ and nodeName_ >= it->second)) {
       if (!checkValueInUseCb_ or !checkValueInUseCb_(newVal)) {
         // found
-        break;
+        candidates.emplace_back(newVal);
+        if (candidates.size() == kNumParallelProbes) {
+          break;
+        }
       }
     }
     // try next
     newVal = (newVal < allocRange_.second) ? (newVal + 1) : allocRange_.first;
   }
-  if (i == allocRangeSize_) {
+  if (candidates.empty()) {
     LOG(ERROR) << "All values are owned by higher originatorIds";
+    candidates.emplace_back(newVal);
   }
 
-  // Schedule timeout to allocate new value
-  allocateValue_ = newVal;
+  // Schedule timeout to allocate new values
+  allocateValues_ = std::move(candidates);
   timeout_->scheduleTimeout(backoff_.getTimeRemainingUntilRetry());
 }
 
@@ -308,11 +332,8 @@ RangeAllocator<T>::keyValUpdated(
 
   // Some sanity checks
   CHECK_EQ(1, thriftVal.version);
-  // no timeout being scheduled
-  CHECK(!timeout_->isScheduled());
   // only subscribed to requested/allocated value change
-  CHECK(myRequestedValue_ or myValue_);
-  CHECK_EQ(myValue_ ? *myValue_ : *myRequestedValue_, val);
+  CHECK((myValue_ and *myValue_ == val) or myRequestedValues_.count(val));
 
   // this occurs when I submit a key to kvstore owned by a lower id1
   // before my id or even higher id overrides it, an intermediate id2
@@ -323,14 +344,40 @@ RangeAllocator<T>::keyValUpdated(
   }
 
   if (nodeName_ == thriftVal.originatorId) {
+    if (myValue_) {
+      if (*myValue_ == val) {
+        return; // duplicate echo of the committed value
+      }
+      // another probe won first - withdraw this late winner
+      VLOG(3) << "RangeAllocator " << nodeName_ << ": Withdrawing late win "
+              << val << ", already committed " << *myValue_;
+      myRequestedValues_.erase(val);
+      kvStoreClient_->unsubscribeKey(key);
+      kvStoreClient_->unsetKey(key, area_);
+      return;
+    }
     VLOG(3) << "RangeAllocator " << nodeName_ << ": Won " << val;
     // Our own advertisement got echoed back
     // Let the application know of newly allocated value
     myValue_ = val;
+    myRequestedValues_.erase(val);
     callback_(myValue_);
 
     // Clear backoff
     backoff_.reportSuccess();
+
+    // First-winner commit - withdraw all other outstanding probes and
+    // cancel any scheduled re-allocation
+    for (const auto& otherVal : myRequestedValues_) {
+      const auto otherKey = createKey(otherVal);
+      kvStoreClient_->unsubscribeKey(otherKey);
+      kvStoreClient_->unsetKey(otherKey, area_);
+    }
+    myRequestedValues_.clear();
+    if (timeout_->isScheduled()) {
+      timeout_->cancelTimeout();
+      allocateValues_.clear();
+    }
   } else {
     // We lost the currently trying value or allocated value
     VLOG(3) << "RangeAllocator " << nodeName_ << ": Lost " << val
@@ -344,12 +391,16 @@ RangeAllocator<T>::keyValUpdated(
       callback_(std::nullopt);
       myValue_.reset();
     }
+    myRequestedValues_.erase(val);
 
     // Unsubscribe to update of lost value
     kvStoreClient_->unsubscribeKey(key);
     kvStoreClient_->unsetKey(key, area_);
-    // Schedule allocation for new value
-    scheduleAllocate(val);
+    // Schedule allocation of new values once every outstanding probe has
+    // resolved
+    if (myRequestedValues_.empty() and not timeout_->isScheduled()) {
+      scheduleAllocate(val);
+    }
   }
 }
 
@@ -10,6 +10,8 @@
 #include <chrono>
 #include <random>
 #include <string>
+#include <unordered_set>
+#include <vector>
 
 #include <fbzmq/async/ZmqTimeout.h>
 #include <folly/Format.h>
@@ -36,9 +38,12 @@ class RangeAllocator {
    * bus.
    *
    * Idea:
-   * - Generate a random value to be claimed
-   * - Try electing it via KvStore. Higher originatorId wins.
-   * - If we fail we should try again with another random number
+   * - Generate random values to be claimed, seeded from the node ID
+   * - Probe several candidate values in parallel via KvStore. Higher
+   *   originatorId wins. The first candidate to be echoed back as ours gets
+   *   committed and the remaining probes are withdrawn, so contention on
+   *   dense ranges costs one propagation round instead of one per collision
+   * - If all probes fail we should try again with other random numbers
    * - To ease up re-tries we use ExponentialBackoff
    *
    * callback: tells you of new allocated value.
@@ -100,14 +105,15 @@ class RangeAllocator {
   void start(const std::optional<T> maybeInitValue);
 
   /**
-   * Invoked asynchronously to allocate a new value. On success callback
-   * will be executed.
+   * Invoked asynchronously to probe a candidate value. Returns true if a
+   * claim was submitted (or the value was re-owned from a previous
+   * incarnation), false if the value cannot be owned
    */
-  void tryAllocate(const T newVal) noexcept;
+  bool tryAllocate(const T newVal) noexcept;
 
   /**
-   * Schedule allocation of a new value. A new random value will be chosen
-   * based on the seed value.
+   * Schedule allocation of new values. Up to kNumParallelProbes random
+   * candidates are chosen, seeded from the node ID and the seed value.
    */
   void scheduleAllocate(const T seedVal) noexcept;
 
@@ -155,17 +161,21 @@ class RangeAllocator {
   // Size of range
   T allocRangeSize_;
 
+  // Number of candidate values probed in parallel per election round
+  static constexpr size_t kNumParallelProbes{4};
+
   // Currently allocated value
   std::optional<T> myValue_;
 
-  // Currently requested value
-  std::optional<T> myRequestedValue_;
+  // Values with an outstanding claim in KvStore. First one echoed back as
+  // ours wins; the others get withdrawn
+  std::unordered_set<T> myRequestedValues_;
 
   // Exponential backoff to avoid frequent allocation retries
   ExponentialBackoff<std::chrono::milliseconds> backoff_;
 
-  // Scheduled timeout token
-  std::optional<int64_t> allocateValue_{std::nullopt};
+  // Candidate values to probe when the timeout fires
+  std::vector<T> allocateValues_;
   std::unique_ptr<fbzmq::ZmqTimeout> timeout_;
 
   // if allocator has started
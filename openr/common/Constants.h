@@ -82,6 +82,10 @@ class Constants {
       100};
   static constexpr std::chrono::milliseconds kPersistentStoreMaxBackoff{5000};
 
+  // Minimum serialized size of a compacted config-store snapshot before it
+  // is worth zstd-compressing on disk
+  static constexpr size_t kPersistentStoreCompressionThreshold{4096};
+
   //
   // KvStore specific
 
@@ -92,6 +96,64 @@ class Constants {
   // kMaxBackoff to send the next sync request
   static constexpr size_t kMaxFullSyncPendingCountThreshold{32};
 
+  // interval between flood-topology rebalancing passes, where a node
+  // re-elects its flood parent among loop-free equal-cost candidates
+  static constexpr std::chrono::seconds kFloodTopoRebalanceInterval{60};
+
+  // grace window after a successful sync within which a bounced peer is
+  // re-synced incrementally (tail since the last cursor) instead of with
+  // a full-database dump
+  static constexpr std::chrono::seconds kPeerResyncGraceWindow{60};
+
+  // Maximum staleness of batched hot-path stats before they are drained
+  // into fb303
+  static constexpr std::chrono::milliseconds kStatsDrainInterval{100};
+
+  // Maximum number of key-vals carried in a single full-sync message.
+  // Bigger dumps are streamed as a sequence of bounded chunks so neither
+  // side ever serializes or merges the entire database in one shot
+  static constexpr size_t kMaxFullSyncChunkKeyCnt{4096};
+
+  // Maximum number of concurrent flood RPCs towards one thrift peer.
+  // Pipelining within this window keeps flood throughput from being
+  // bound to one publication per round-trip on high-RTT sessions
+  static constexpr size_t kMaxFloodInFlightPerPeer{4};
+
+  // Receive-side reordering of pipelined floods: at most this many
+  // publications are buffered per direct sender while a sequence gap is
+  // open, and the buffer is flushed in order after this timeout anyway so
+  // a failed RPC in the sender's window cannot stall newer data
+  static constexpr size_t kFloodReorderBufferSize{16};
+  static constexpr std::chrono::milliseconds kFloodReorderFlushTimeout{100};
+
+  // Per-peer adaptive flood rate control (publications/sec). Each peer's
+  // rate moves between min and max by AIMD on observed flood RPC latency:
+  // additive increase per timely ack, multiplicative decrease when an ack
+  // exceeds the latency target or the RPC fails
+  static constexpr double kPeerFloodRateMax{512.0};
+  static constexpr double kPeerFloodRateMin{8.0};
+  static constexpr double kPeerFloodRateAdditiveStep{16.0};
+  static constexpr double kPeerFloodRateDecayFactor{0.5};
+  static constexpr double kPeerFloodBurstSize{64.0};
+  static constexpr std::chrono::milliseconds kPeerFloodLatencyTarget{200};
+
+  // Maximum number of entries in the duplicate-flood suppression cache
+  // before it is reset
+  static constexpr size_t kFloodDupCacheMaxSize{16384};
+
+  // Minimum serialized size of a full-sync response before it is worth
+  // zstd-compressing for the wire
+  static constexpr size_t kFullSyncCompressionThreshold{4096};
+
+  //
+  // Decision specific
+  //
+
+  // how long the route compute thread waits for a build request before
+  // spending one idle slice on precomputing a likely-failure scenario
+  // (when enable_failure_precompute is set)
+  static constexpr std::chrono::milliseconds kFailurePrecomputeIdleWait{200};
+
   //
   // PrefixAllocator specific
 
@@ -117,6 +179,26 @@ class Constants {
   // the time we hold on announcing a link when it comes up
   static constexpr std::chrono::milliseconds kLinkThrottleTimeout{1000};
   static constexpr std::chrono::milliseconds kLinkImmediateTimeout{1};
+  // after an immediate advertisement, further link/addr events accumulate
+  // for this long and go out as one net update - bounds the advertisement
+  // rate during bulk port churn (e.g. linecard reset) while keeping the
+  // first link-down propagation fast
+  static constexpr std::chrono::milliseconds kLinkCoalesceTimeout{100};
+
+  // Link flap damping (BGP route-flap-damping style). Every down transition
+  // accrues penalty on the interface, which decays exponentially with the
+  // half-life below. A micro-flap (the interface stayed up for less than
+  // kLinkMicroFlapWindow before going down again, typical of failing optics)
+  // is penalized more heavily than a sustained down event. Once the penalty
+  // crosses the suppress threshold the interface is kept out of service
+  // until the penalty decays below the reuse threshold, so one pathological
+  // port cannot keep the advertisement pipeline busy
+  static constexpr std::chrono::milliseconds kLinkFlapDampingHalfLife{60000};
+  static constexpr std::chrono::milliseconds kLinkMicroFlapWindow{1000};
+  static constexpr double kLinkFlapMicroFlapPenalty{1000};
+  static constexpr double kLinkFlapDownPenalty{250};
+  static constexpr double kLinkFlapSuppressThreshold{10000};
+  static constexpr double kLinkFlapReuseThreshold{2500};
 
   // overloaded note metric value
   static constexpr uint64_t kOverloadNodeMetric{1ull << 32};
@@ -158,6 +240,15 @@ class Constants {
   // time interval for keep alive check between fib and switch agent
   static constexpr std::chrono::milliseconds kKeepAliveCheckInterval{1000};
 
+  // Default number of routes handed to the fib agent per thrift call.
+  // Bulk deltas are programmed as a sequence of bounded chunks so one
+  // call never occupies the agent for multiple seconds
+  static constexpr size_t kFibRouteProgramChunkSize{4096};
+
+  // Default number of routes per page for the paginated/streamed route
+  // database dump APIs, used when the caller does not ask for a size
+  static constexpr size_t kRouteDumpPageSize{1024};
+
   // Timeout duration for which if a client connection has no activity, then it
   // will be dropped. We keep it 3 * kPlatformSyncInterval so that thrift
   // connection between OpenR and platform service remains up forever under
@@ -181,6 +272,12 @@ class Constants {
   // Kvstore timer for flooding pending publication
   static constexpr std::chrono::milliseconds kFloodPendingPublication{100};
 
+  // Throttle for batching KvStoreClientInternal key advertisements. Kept
+  // tiny so a synchronous burst of persistKey calls (e.g. PrefixManager
+  // re-advertising all prefixes) collapses into one KeySetParams
+  // submission per area without delaying individual updates
+  static constexpr std::chrono::milliseconds kKvClientThrottleTimeout{1};
+
   // KvStore database TTLs
   static constexpr std::chrono::milliseconds kKvStoreDbTtl{5min};
 
@@ -195,6 +292,7 @@ class Constants {
   static constexpr folly::StringPiece kPrefixDbMarker{"prefix:"};
   static constexpr folly::StringPiece kPrefixAllocMarker{"allocprefix:"};
   static constexpr folly::StringPiece kFibTimeMarker{"fibtime:"};
+  static constexpr folly::StringPiece kFibAckMarker{"fiback:"};
   static constexpr folly::StringPiece kNodeLabelRangePrefix{"nodeLabel:"};
 
   static constexpr folly::StringPiece kGlobalCmdLocalIdTemplate{
@@ -222,6 +320,9 @@ class Constants {
   static constexpr uint16_t kPerfBufferSize{10};
   static constexpr std::chrono::seconds kConvergenceMaxDuration{3s};
 
+  // bucket width of the streaming convergence-latency histogram in Fib
+  static constexpr std::chrono::milliseconds kPerfHistogramBucketWidth{10};
+
   // hold time for longPoll requests in openrCtrl thrift server
   static constexpr std::chrono::milliseconds kLongPollReqHoldTime{20000};
 
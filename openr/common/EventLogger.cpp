@@ -0,0 +1,80 @@
+/**
+ * Copyright (c) 2014-present, Facebook, Inc.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "EventLogger.h"
+
+#include <sys/resource.h>
+
+#include <fb303/ServiceData.h>
+#include <folly/ExceptionString.h>
+#include <folly/String.h>
+#include <folly/system/ThreadName.h>
+#include <glog/logging.h>
+
+namespace fb303 = facebook::fb303;
+
+namespace openr {
+
+EventLogger::EventLogger(
+    std::shared_ptr<fbzmq::ZmqMonitorClient> zmqMonitorClient,
+    uint32_t queueCapacity)
+    : zmqMonitorClient_(std::move(zmqMonitorClient)), queue_(queueCapacity) {
+  CHECK(zmqMonitorClient_);
+  thread_ = std::thread([this]() noexcept {
+    folly::setThreadName("EventLogger");
+    // best effort: drain at the lowest scheduling priority so submission
+    // never competes with protocol threads for cpu
+    errno = 0;
+    if (setpriority(PRIO_PROCESS, 0, 19) != 0 and errno) {
+      VLOG(1) << "Failed to lower EventLogger thread priority: "
+              << folly::errnoStr(errno);
+    }
+    while (true) {
+      std::optional<fbzmq::thrift::EventLog> eventLog;
+      queue_.blockingRead(eventLog);
+      if (not eventLog.has_value()) {
+        break;
+      }
+      try {
+        zmqMonitorClient_->addEventLog(std::move(eventLog).value());
+      } catch (std::exception const& e) {
+        LOG(ERROR) << "Failed to submit event log: " << folly::exceptionStr(e);
+      }
+    }
+  });
+}
+
+EventLogger::~EventLogger() {
+  // push the shutdown sentinel; blockingWrite is fine as the drain thread
+  // keeps consuming until it pops the sentinel
+  queue_.blockingWrite(std::nullopt);
+  thread_.join();
+  if (auto const dropped = numDropped_.load()) {
+    LOG(WARNING) << "Dropped " << dropped
+                 << " event logs on queue overflow over process lifetime";
+  }
+}
+
+void
+EventLogger::log(fbzmq::thrift::EventLog eventLog) {
+  if (queue_.writeIfNotFull(std::move(eventLog))) {
+    return;
+  }
+  // queue full - drop and account. Log only every 1000th drop so overflow
+  // stays visible without amplifying the very storm that caused it
+  auto const dropped = numDropped_.fetch_add(1, std::memory_order_relaxed);
+  fb303::fbData->addStatValue("event_logger.dropped", 1, fb303::COUNT);
+  LOG_IF(WARNING, dropped % 1000 == 0)
+      << "Event log queue full. Dropped " << dropped + 1 << " samples so far";
+}
+
+uint64_t
+EventLogger::getNumDropped() const {
+  return numDropped_.load();
+}
+
+} // namespace openr
@@ -0,0 +1,60 @@
+/**
+ * Copyright (c) 2014-present, Facebook, Inc.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <thread>
+
+#include <fbzmq/service/monitor/ZmqMonitorClient.h>
+#include <folly/MPMCQueue.h>
+
+namespace openr {
+
+/*
+ * Asynchronous submitter of event logs towards the monitor.
+ *
+ * Samples are put on a bounded lock-free queue and shipped by a dedicated
+ * low-priority drain thread, so logging on protocol threads costs a single
+ * enqueue regardless of how slow the monitor is. When the drain thread falls
+ * behind, the queue overflows by dropping the sample - event logs are an
+ * observability aid, and stalling the hot path exactly when the system is
+ * busiest to preserve them would be backwards. Drops are counted and
+ * exported as the "event_logger.dropped" counter.
+ */
+class EventLogger final {
+ public:
+  explicit EventLogger(
+      std::shared_ptr<fbzmq::ZmqMonitorClient> zmqMonitorClient,
+      uint32_t queueCapacity = 1024);
+  ~EventLogger();
+
+  // disable copying
+  EventLogger(EventLogger const&) = delete;
+  EventLogger& operator=(EventLogger const&) = delete;
+
+  // bounded enqueue. Safe to call from any thread, never blocks
+  void log(fbzmq::thrift::EventLog eventLog);
+
+  // number of samples dropped on queue overflow so far
+  uint64_t getNumDropped() const;
+
+ private:
+  // the synchronous client the drain thread submits through
+  std::shared_ptr<fbzmq::ZmqMonitorClient> zmqMonitorClient_;
+
+  // nullopt is the shutdown sentinel pushed by the destructor
+  folly::MPMCQueue<std::optional<fbzmq::thrift::EventLog>> queue_;
+
+  std::atomic<uint64_t> numDropped_{0};
+
+  std::thread thread_;
+};
+
+} // namespace openr
@@ -195,6 +195,17 @@ DEFINE_bool(
     enable_netlink_system_handler,
     true,
     "If set, netlink system handler will be started");
+DEFINE_int32(
+    netlink_max_inflight_msgs,
+    500, /* fbnl::kMaxIovMsg */
+    "Maximum number of netlink requests awaiting a kernel ack. Bulk route "
+    "programming benefits from a window of thousands.");
+DEFINE_bool(
+    netlink_enable_neighbor_events,
+    true,
+    "If set, subscribe to kernel neighbor (ARP/NDP) events. Disable on "
+    "servers with busy neighbor tables when no FIB agent client listens for "
+    "neighbor updates, to cut steady state wakeups of the netlink thread.");
 DEFINE_int32(
     ip_tos,
     openr::Constants::kIpTos,
@@ -394,3 +405,8 @@ DEFINE_uint32(
 DEFINE_int32(add_path, 0, "add path value");
 
 DEFINE_string(config, "", "OpenR config file path");
+DEFINE_int32(
+    config_reload_interval_s,
+    0,
+    "If > 0, poll the config file at this interval and apply dynamic knob "
+    "changes without a restart. 0 (default) disables config reload.");
@@ -66,6 +66,8 @@ DECLARE_int32(spark_fastinit_keepalive_time_ms);
 
 DECLARE_bool(enable_netlink_fib_handler);
 DECLARE_bool(enable_netlink_system_handler);
+DECLARE_int32(netlink_max_inflight_msgs);
+DECLARE_bool(netlink_enable_neighbor_events);
 
 DECLARE_int32(ip_tos);
 DECLARE_int32(zmq_context_threads);
@@ -143,3 +145,4 @@ DECLARE_uint32(bgp_min_nexthop);
 DECLARE_int32(add_path);
 
 DECLARE_string(config);
+DECLARE_int32(config_reload_interval_s);
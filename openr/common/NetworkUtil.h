@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include <folly/Format.h>
 #include <folly/IPAddress.h>
 #include <thrift/lib/cpp/util/EnumUtils.h>
@@ -84,6 +86,31 @@ toBinaryAddress(const std::string& addr) {
   return toBinaryAddress(folly::IPAddress(addr));
 }
 
+/**
+ * Interned flavor of toBinaryAddress for per-nexthop conversion paths.
+ * A deployment sees a small bounded set of distinct nexthop addresses, so
+ * the converted payload of each is built once per thread and handed out
+ * by reference afterwards - a hash lookup instead of a fresh conversion.
+ * Callers copy the result into their thrift object as usual. The cache is
+ * thread-local (each module converts on its own event-base) and resets
+ * if it ever exceeds a sanity bound, so unexpected address churn cannot
+ * grow it without limit.
+ */
+inline const thrift::BinaryAddress&
+toBinaryAddressCached(const folly::IPAddress& addr) {
+  constexpr size_t kMaxCacheSize{4096};
+  thread_local std::unordered_map<folly::IPAddress, thrift::BinaryAddress>
+      cache;
+  auto it = cache.find(addr);
+  if (it == cache.end()) {
+    if (cache.size() >= kMaxCacheSize) {
+      cache.clear();
+    }
+    it = cache.emplace(addr, toBinaryAddress(addr)).first;
+  }
+  return it->second;
+}
+
 template <typename T>
 inline folly::IPAddress
 toIPAddress(const T& input) {
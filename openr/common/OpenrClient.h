@@ -75,6 +75,10 @@ getOpenrCtrlPlainTextClient(
       folly::SocketOptionKey v6Opts = {IPPROTO_IPV6, IPV6_TCLASS};
       optionMap.emplace(v6Opts, maybeIpTos.value());
     }
+    // Keep long-lived/pooled connections alive and let dead peers be
+    // detected while the connection sits idle
+    folly::SocketOptionKey keepAliveOpt = {SOL_SOCKET, SO_KEEPALIVE};
+    optionMap.emplace(keepAliveOpt, 1);
 
     // Establish connection
     transport->connect(
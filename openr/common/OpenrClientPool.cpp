@@ -0,0 +1,133 @@
+/**
+ * Copyright (c) 2014-present, Facebook, Inc.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <openr/common/OpenrClientPool.h>
+
+#include <utility>
+
+#include <glog/logging.h>
+#include <thrift/lib/cpp2/async/ClientChannel.h>
+
+namespace openr {
+
+OpenrClientPool::Lease::Lease(
+    OpenrClientPool* pool,
+    folly::SocketAddress addr,
+    std::unique_ptr<thrift::OpenrCtrlCppAsyncClient> client)
+    : pool_(pool), addr_(std::move(addr)), client_(std::move(client)) {}
+
+OpenrClientPool::Lease::~Lease() {
+  if (pool_ and client_) {
+    pool_->returnClient(addr_, std::move(client_), broken_);
+  }
+}
+
+OpenrClientPool::Lease::Lease(Lease&& other) noexcept
+    : pool_(std::exchange(other.pool_, nullptr)),
+      addr_(std::move(other.addr_)),
+      client_(std::move(other.client_)),
+      broken_(other.broken_) {}
+
+OpenrClientPool::Lease&
+OpenrClientPool::Lease::operator=(Lease&& other) noexcept {
+  if (this != &other) {
+    if (pool_ and client_) {
+      pool_->returnClient(addr_, std::move(client_), broken_);
+    }
+    pool_ = std::exchange(other.pool_, nullptr);
+    addr_ = std::move(other.addr_);
+    client_ = std::move(other.client_);
+    broken_ = other.broken_;
+  }
+  return *this;
+}
+
+OpenrClientPool&
+OpenrClientPool::instance() {
+  static OpenrClientPool* pool = new OpenrClientPool();
+  return *pool;
+}
+
+folly::EventBase&
+OpenrClientPool::getEventBase() {
+  return *evbThread_.getEventBase();
+}
+
+OpenrClientPool::Lease
+OpenrClientPool::getClient(
+    const folly::SocketAddress& addr,
+    std::chrono::milliseconds connectTimeout,
+    std::chrono::milliseconds processingTimeout,
+    std::optional<int> maybeIpTos,
+    const folly::SocketAddress& bindAddr) {
+  auto& evb = getEventBase();
+
+  // Reuse a healthy idle connection when one is available. The health
+  // check inspects channel state on the event-base thread; a connection
+  // that went bad while idle (peer restart, idle timeout) is discarded
+  // and the next candidate is tried
+  while (true) {
+    std::unique_ptr<thrift::OpenrCtrlCppAsyncClient> candidate;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = idleClients_.find(addr);
+      if (it == idleClients_.end() or it->second.empty()) {
+        break;
+      }
+      candidate = std::move(it->second.back());
+      it->second.pop_back();
+    }
+
+    bool good{false};
+    evb.runImmediatelyOrRunInEventBaseThreadAndWait([&]() {
+      auto* channel = dynamic_cast<apache::thrift::ClientChannel*>(
+          candidate->getChannel());
+      good = channel and channel->good();
+      if (not good) {
+        candidate.reset(); // destroy on the event-base thread
+      }
+    });
+    if (good) {
+      VLOG(3) << "Reusing pooled connection to " << addr.describe();
+      return Lease(this, addr, std::move(candidate));
+    }
+    VLOG(3) << "Dropping stale pooled connection to " << addr.describe();
+  }
+
+  // No reusable connection - establish a new one
+  auto client = getOpenrCtrlPlainTextClient(
+      evb,
+      folly::IPAddress(addr.getAddressStr()),
+      addr.getPort(),
+      connectTimeout,
+      processingTimeout,
+      bindAddr,
+      maybeIpTos);
+  return Lease(this, addr, std::move(client));
+}
+
+void
+OpenrClientPool::returnClient(
+    const folly::SocketAddress& addr,
+    std::unique_ptr<thrift::OpenrCtrlCppAsyncClient> client,
+    bool broken) {
+  if (not broken) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& idle = idleClients_[addr];
+    if (idle.size() < kMaxIdlePerPeer) {
+      idle.emplace_back(std::move(client));
+      return;
+    }
+  }
+
+  // broken connection or idle bound reached - destroy on the event-base
+  // thread the transport is bound to
+  getEventBase().runInEventBaseThread(
+      [toDestroy = std::move(client)]() mutable { toDestroy.reset(); });
+}
+
+} // namespace openr
@@ -0,0 +1,123 @@
+/**
+ * Copyright (c) 2014-present, Facebook, Inc.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <folly/SocketAddress.h>
+#include <folly/io/async/ScopedEventBaseThread.h>
+
+#include <openr/common/OpenrClient.h>
+
+namespace openr {
+
+/*
+ * Process-wide pool of connected OpenrCtrlCppAsyncClient instances, shared
+ * by everything that repeatedly queries other Open/R nodes (tooling built on
+ * dumpAllWithThriftClientFromMultiple(), periodic monitoring scripts, etc.).
+ * Connections are kept alive between queries, health-checked on borrow and
+ * bounded in number while idle, so repeated control-plane queries skip the
+ * TCP connect (and the TLS handshake once secure clients land) entirely.
+ *
+ * All pooled clients are bound to the pool's own event-base thread; issue
+ * RPCs via getEventBase() and destroy the lease when done. A lease hands its
+ * client back to the pool on destruction unless markBroken() was called
+ * (e.g. after an RPC error), in which case the connection is discarded.
+ */
+class OpenrClientPool {
+ public:
+  /*
+   * Exclusive handle on one pooled client. Move-only; the connection goes
+   * back to the pool (or is discarded when marked broken or when the pool
+   * already retains enough idle connections for the peer) on destruction.
+   */
+  class Lease {
+   public:
+    Lease() = default;
+    ~Lease();
+
+    Lease(Lease&& other) noexcept;
+    Lease& operator=(Lease&& other) noexcept;
+    Lease(Lease const&) = delete;
+    Lease& operator=(Lease const&) = delete;
+
+    thrift::OpenrCtrlCppAsyncClient* operator->() const {
+      return client_.get();
+    }
+
+    explicit operator bool() const {
+      return client_ != nullptr;
+    }
+
+    // discard the connection instead of returning it to the pool. Call
+    // after an RPC error - the channel may be left in an undefined state
+    void
+    markBroken() {
+      broken_ = true;
+    }
+
+   private:
+    friend class OpenrClientPool;
+    Lease(
+        OpenrClientPool* pool,
+        folly::SocketAddress addr,
+        std::unique_ptr<thrift::OpenrCtrlCppAsyncClient> client);
+
+    OpenrClientPool* pool_{nullptr};
+    folly::SocketAddress addr_;
+    std::unique_ptr<thrift::OpenrCtrlCppAsyncClient> client_{nullptr};
+    bool broken_{false};
+  };
+
+  static OpenrClientPool& instance();
+
+  // event base all pooled clients are bound to. RPCs on leased clients must
+  // be issued from this event base's thread
+  folly::EventBase& getEventBase();
+
+  // Borrow a client connected to `addr`. Reuses a healthy idle connection
+  // when one is available, else establishes a new one via
+  // getOpenrCtrlPlainTextClient(). Connection establishment is asynchronous;
+  // failures surface on the first RPC just as with a freshly created client
+  Lease getClient(
+      const folly::SocketAddress& addr,
+      std::chrono::milliseconds connectTimeout = Constants::kServiceConnTimeout,
+      std::chrono::milliseconds processingTimeout =
+          Constants::kServiceProcTimeout,
+      std::optional<int> maybeIpTos = std::nullopt,
+      const folly::SocketAddress& bindAddr = folly::AsyncSocket::anyAddress());
+
+ private:
+  OpenrClientPool() = default;
+  OpenrClientPool(OpenrClientPool const&) = delete;
+  OpenrClientPool& operator=(OpenrClientPool const&) = delete;
+
+  // hand a leased client back. Broken clients and clients exceeding the
+  // idle bound are destroyed on the event-base thread
+  void returnClient(
+      const folly::SocketAddress& addr,
+      std::unique_ptr<thrift::OpenrCtrlCppAsyncClient> client,
+      bool broken);
+
+  // number of idle connections retained per remote address
+  static constexpr size_t kMaxIdlePerPeer{2};
+
+  // event-base thread owning every pooled connection
+  folly::ScopedEventBaseThread evbThread_{"openr_client_pool"};
+
+  // idle connections keyed by remote address, guarded by mutex_
+  std::mutex mutex_;
+  std::unordered_map<
+      folly::SocketAddress,
+      std::vector<std::unique_ptr<thrift::OpenrCtrlCppAsyncClient>>>
+      idleClients_;
+};
+
+} // namespace openr
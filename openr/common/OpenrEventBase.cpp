@@ -7,6 +7,9 @@
 
 #include "openr/common/OpenrEventBase.h"
 
+#include <algorithm>
+#include <limits>
+
 #include <folly/fibers/FiberManagerMap.h>
 
 namespace openr {
@@ -128,6 +131,8 @@ OpenrEventBase::OpenrEventBase()
   timestamp_ = getElapsedSeconds();
   timeout_ = folly::AsyncTimeout::make(evb_, [this]() noexcept {
     timestamp_ = getElapsedSeconds();
+    recordLoopDelay();
+    timerDueAt_ = std::chrono::steady_clock::now() + std::chrono::seconds(1);
     timeout_->scheduleTimeout(std::chrono::seconds(1));
   });
   timeout_->scheduleTimeout(0);
@@ -135,8 +140,59 @@ OpenrEventBase::OpenrEventBase()
 
 OpenrEventBase::~OpenrEventBase() {}
 
+void
+OpenrEventBase::recordLoopDelay() {
+  const auto now = std::chrono::steady_clock::now();
+  const auto delayMs = std::max<int64_t>(
+      0,
+      std::chrono::duration_cast<std::chrono::milliseconds>(now - timerDueAt_)
+          .count());
+  const auto sample =
+      static_cast<int32_t>(std::min<int64_t>(
+          delayMs, std::numeric_limits<int32_t>::max()));
+
+  const auto count = loopDelaySampleCount_.load(std::memory_order_relaxed);
+  loopDelaySamples_[count % kLoopDelaySamples].store(
+      sample, std::memory_order_relaxed);
+  loopDelaySampleCount_.store(count + 1, std::memory_order_release);
+  if (sample > loopDelayMaxMs_.load(std::memory_order_relaxed)) {
+    loopDelayMaxMs_.store(sample, std::memory_order_relaxed);
+  }
+}
+
+OpenrEventBase::LoopLatencyStats
+OpenrEventBase::getLoopLatencyStats() const {
+  LoopLatencyStats stats;
+  const auto count = std::min(
+      loopDelaySampleCount_.load(std::memory_order_acquire),
+      kLoopDelaySamples);
+  if (count == 0) {
+    return stats;
+  }
+  std::vector<int32_t> samples;
+  samples.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    samples.emplace_back(loopDelaySamples_[i].load(std::memory_order_relaxed));
+  }
+  std::sort(samples.begin(), samples.end());
+  stats.p50Ms = samples[count / 2];
+  stats.p99Ms = samples[(count * 99) / 100];
+  stats.maxMs = loopDelayMaxMs_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void
+OpenrEventBase::CoarseTimeCallback::runLoopCallback() noexcept {
+  ebase_.coarseTime_ = std::chrono::steady_clock::now();
+  // re-register so the cache is refreshed before every loop iteration
+  ebase_.evb_.runBeforeLoop(this);
+}
+
 void
 OpenrEventBase::run() {
+  // Arm the coarse-clock refresh from the loop thread
+  coarseTime_ = std::chrono::steady_clock::now();
+  evb_.runBeforeLoop(&coarseTimeCallback_);
   evb_.loopForever();
 }
 
@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <csignal>
 
 #include <fbzmq/async/ZmqEventLoop.h>
@@ -14,6 +16,7 @@
 #include <folly/fibers/FiberManager.h>
 #include <folly/io/async/AsyncSignalHandler.h>
 #include <folly/io/async/EventHandler.h>
+#include <folly/io/async/HHWheelTimer.h>
 
 namespace openr {
 
@@ -25,6 +28,40 @@ class EventBaseStopSignalHandler : public folly::AsyncSignalHandler {
   void signalReceived(int signum) noexcept override;
 };
 
+/**
+ * Reusable timeout backed by the event-base's hashed hierarchical timer
+ * wheel instead of an individual libevent timeout. Arm and cancel are O(1)
+ * regardless of how many timeouts are outstanding, at the cost of firing
+ * on wheel-tick granularity (~10ms) - the right trade-off for the tens of
+ * thousands of per-neighbor/per-key timers modules maintain. Drop-in for
+ * the folly::AsyncTimeout::make usage pattern; destruction cancels.
+ */
+class WheelTimeout final : public folly::HHWheelTimer::Callback {
+ public:
+  static std::unique_ptr<WheelTimeout>
+  make(folly::EventBase& evb, folly::EventBase::Func callback) {
+    return std::unique_ptr<WheelTimeout>(
+        new WheelTimeout(evb, std::move(callback)));
+  }
+
+  void
+  scheduleTimeout(std::chrono::milliseconds timeout) {
+    evb_.timer().scheduleTimeout(this, timeout);
+  }
+
+ private:
+  WheelTimeout(folly::EventBase& evb, folly::EventBase::Func callback)
+      : evb_(evb), callback_(std::move(callback)) {}
+
+  void
+  timeoutExpired() noexcept override {
+    callback_();
+  }
+
+  folly::EventBase& evb_;
+  folly::EventBase::Func callback_;
+};
+
 class OpenrEventBase {
  public:
   OpenrEventBase();
@@ -76,6 +113,32 @@ class OpenrEventBase {
     return timestamp_.load();
   }
 
+  /**
+   * Loop responsiveness stats, sampled by the per-second health timer:
+   * each sample is the delay between when the timer was due and when the
+   * loop actually ran it. Creeping values mean long callbacks are holding
+   * the loop below the watchdog's kill threshold. Readable from any
+   * thread; percentiles cover roughly the last minute of samples.
+   */
+  struct LoopLatencyStats {
+    int64_t p50Ms{0};
+    int64_t p99Ms{0};
+    int64_t maxMs{0};
+  };
+  LoopLatencyStats getLoopLatencyStats() const;
+
+  /**
+   * Cached steady-clock reading, refreshed once at the top of every
+   * event-loop iteration. Hot paths that consult the clock several times
+   * per event can use this instead of repeated steady_clock::now() calls;
+   * all reads within one callback observe the same instant. Only
+   * meaningful on the event-base thread while the loop is running.
+   */
+  std::chrono::steady_clock::time_point
+  getCoarseTime() const {
+    return coarseTime_;
+  }
+
   /**
    * Runnable interface APIs
    */
@@ -157,6 +220,40 @@ class OpenrEventBase {
   // Timestamp
   std::atomic<std::chrono::seconds> timestamp_{std::chrono::seconds(0)};
   std::unique_ptr<folly::AsyncTimeout> timeout_;
+
+  // record one loop-delay sample; invoked by the health timer
+  void recordLoopDelay();
+
+  // ring of recent loop-delay samples in ms. Written only by the health
+  // timer on the loop thread, read by the watchdog thread; samples are
+  // individually atomic so cross-thread reads are merely slightly stale
+  static constexpr size_t kLoopDelaySamples{64};
+  std::array<std::atomic<int32_t>, kLoopDelaySamples> loopDelaySamples_{};
+  std::atomic<size_t> loopDelaySampleCount_{0};
+  std::atomic<int32_t> loopDelayMaxMs_{0};
+
+  // when the health timer is next due, for delay measurement
+  std::chrono::steady_clock::time_point timerDueAt_{
+      std::chrono::steady_clock::now()};
+
+  /**
+   * Loop callback refreshing the cached coarse timestamp. Re-registers
+   * itself so it runs before every loop iteration.
+   */
+  class CoarseTimeCallback : public folly::EventBase::LoopCallback {
+   public:
+    explicit CoarseTimeCallback(OpenrEventBase& ebase) : ebase_(ebase) {}
+
+    void runLoopCallback() noexcept override;
+
+   private:
+    OpenrEventBase& ebase_;
+  };
+
+  // Coarse timestamp cache backing getCoarseTime()
+  std::chrono::steady_clock::time_point coarseTime_{
+      std::chrono::steady_clock::now()};
+  CoarseTimeCallback coarseTimeCallback_{*this};
 };
 
 } // namespace openr
@@ -0,0 +1,196 @@
+/**
+ * Copyright (c) 2014-present, Facebook, Inc.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "openr/common/PrefixTrie.h"
+
+#include <algorithm>
+#include <set>
+
+#include <folly/IPAddress.h>
+
+namespace openr {
+
+namespace {
+
+// i-th most significant bit of the prefix address
+inline int
+getPrefixBit(std::string const& addr, int16_t i) {
+  return (static_cast<uint8_t>(addr[i / 8]) >> (7 - i % 8)) & 1;
+}
+
+// number of leading bits two equal-length addresses have in common
+inline int16_t
+getCommonPrefixBits(std::string const& lhs, std::string const& rhs) {
+  int16_t byte = 0;
+  while (byte < static_cast<int16_t>(lhs.size()) and lhs[byte] == rhs[byte]) {
+    ++byte;
+  }
+  int16_t bits = byte * 8;
+  if (byte < static_cast<int16_t>(lhs.size())) {
+    auto diff =
+        static_cast<uint8_t>(lhs[byte]) ^ static_cast<uint8_t>(rhs[byte]);
+    while (not(diff & 0x80)) {
+      diff <<= 1;
+      ++bits;
+    }
+  }
+  return bits;
+}
+
+} // namespace
+
+void
+PrefixTrie::insert(thrift::IpPrefix const& prefix) {
+  auto* node = &rootFor(prefix);
+  for (int16_t i = 0; i < prefix.prefixLength; ++i) {
+    auto& child = node->children[getPrefixBit(prefix.prefixAddress.addr, i)];
+    if (not child) {
+      child = std::make_unique<TrieNode>();
+    }
+    node = child.get();
+  }
+  node->prefix = prefix;
+}
+
+void
+PrefixTrie::erase(thrift::IpPrefix const& prefix) {
+  // remember the path walked so now-empty branches can be pruned bottom-up
+  std::vector<std::pair<TrieNode*, int>> path;
+  auto* node = &rootFor(prefix);
+  for (int16_t i = 0; i < prefix.prefixLength; ++i) {
+    int const bit = getPrefixBit(prefix.prefixAddress.addr, i);
+    if (not node->children[bit]) {
+      return;
+    }
+    path.emplace_back(node, bit);
+    node = node->children[bit].get();
+  }
+  node->prefix = std::nullopt;
+  while (not path.empty() and not node->prefix and not node->children[0] and
+         not node->children[1]) {
+    auto const& [parent, bit] = path.back();
+    parent->children[bit].reset();
+    node = parent;
+    path.pop_back();
+  }
+}
+
+std::vector<thrift::IpPrefix>
+PrefixTrie::getCoveredPrefixes(thrift::IpPrefix const& prefix) const {
+  std::vector<thrift::IpPrefix> covered;
+  auto const* node = &rootFor(prefix);
+  for (int16_t i = 0; i < prefix.prefixLength; ++i) {
+    node = node->children[getPrefixBit(prefix.prefixAddress.addr, i)].get();
+    if (not node) {
+      return covered;
+    }
+  }
+  // collect everything at or below the node the prefix walks to
+  std::vector<TrieNode const*> toVisit{node};
+  while (not toVisit.empty()) {
+    auto const* visit = toVisit.back();
+    toVisit.pop_back();
+    if (visit->prefix) {
+      covered.emplace_back(visit->prefix.value());
+    }
+    for (auto const& child : visit->children) {
+      if (child) {
+        toVisit.emplace_back(child.get());
+      }
+    }
+  }
+  return covered;
+}
+
+std::optional<thrift::IpPrefix>
+PrefixTrie::getLongestMatch(thrift::IpPrefix const& prefix) const {
+  std::optional<thrift::IpPrefix> match;
+  auto const* node = &rootFor(prefix);
+  for (int16_t i = 0; i <= prefix.prefixLength; ++i) {
+    if (node->prefix) {
+      match = node->prefix;
+    }
+    if (i == prefix.prefixLength) {
+      break;
+    }
+    node = node->children[getPrefixBit(prefix.prefixAddress.addr, i)].get();
+    if (not node) {
+      break;
+    }
+  }
+  return match;
+}
+
+std::vector<thrift::IpPrefix>
+PrefixTrie::getLongestMatches(std::vector<thrift::IpPrefix> prefixes) const {
+  // sort queries by bit string so consecutive ones share their descent
+  // path down to their first differing bit
+  std::sort(
+      prefixes.begin(), prefixes.end(), [](auto const& lhs, auto const& rhs) {
+        if (lhs.prefixAddress.addr != rhs.prefixAddress.addr) {
+          return lhs.prefixAddress.addr < rhs.prefixAddress.addr;
+        }
+        return lhs.prefixLength < rhs.prefixLength;
+      });
+
+  std::set<thrift::IpPrefix> matches;
+  // descent state carried from one query to the next: path[i] is the node
+  // reached after consuming i bits and matchAtDepth[i] the most specific
+  // indexed prefix terminating along path[0..i]
+  std::vector<TrieNode const*> path;
+  std::vector<std::optional<thrift::IpPrefix>> matchAtDepth;
+  std::string const* prevAddr{nullptr};
+
+  for (auto const& prefix : prefixes) {
+    auto const& addr = prefix.prefixAddress.addr;
+    if (not prevAddr or prevAddr->size() != addr.size()) {
+      // first query of an address family: restart from its root
+      path = {&rootFor(prefix)};
+      matchAtDepth = {path.front()->prefix};
+    } else {
+      // keep the part of the path shared with the previous query
+      auto const keepDepth = std::min(
+          {static_cast<int16_t>(path.size() - 1),
+           getCommonPrefixBits(*prevAddr, addr),
+           prefix.prefixLength});
+      path.resize(keepDepth + 1);
+      matchAtDepth.resize(keepDepth + 1);
+    }
+    for (auto i = static_cast<int16_t>(path.size() - 1);
+         i < prefix.prefixLength;
+         ++i) {
+      auto const* child = path.back()->children[getPrefixBit(addr, i)].get();
+      if (not child) {
+        break;
+      }
+      path.emplace_back(child);
+      matchAtDepth.emplace_back(
+          child->prefix ? child->prefix : matchAtDepth.back());
+    }
+    if (matchAtDepth.back()) {
+      matches.insert(matchAtDepth.back().value());
+    }
+    prevAddr = &addr;
+  }
+  return {matches.begin(), matches.end()};
+}
+
+PrefixTrie::TrieNode&
+PrefixTrie::rootFor(thrift::IpPrefix const& prefix) {
+  return prefix.prefixAddress.addr.size() == folly::IPAddressV4::byteCount()
+      ? rootV4_
+      : rootV6_;
+}
+
+PrefixTrie::TrieNode const&
+PrefixTrie::rootFor(thrift::IpPrefix const& prefix) const {
+  return prefix.prefixAddress.addr.size() == folly::IPAddressV4::byteCount()
+      ? rootV4_
+      : rootV6_;
+}
+
+} // namespace openr
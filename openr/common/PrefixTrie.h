@@ -0,0 +1,60 @@
+/**
+ * Copyright (c) 2014-present, Facebook, Inc.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <openr/if/gen-cpp2/Network_types.h>
+
+namespace openr {
+
+// Binary radix trie over advertised prefixes. Indexes prefixes by their bit
+// string so aggregation queries (covered prefixes, longest prefix match) walk
+// at most prefixLength nodes instead of scanning every advertised prefix.
+class PrefixTrie {
+ public:
+  // index the given prefix. no-op if already present
+  void insert(thrift::IpPrefix const& prefix);
+
+  // drop the given prefix from the index, pruning now-empty trie branches.
+  // no-op if not present
+  void erase(thrift::IpPrefix const& prefix);
+
+  // all indexed prefixes equal to or more specific than the given prefix
+  std::vector<thrift::IpPrefix> getCoveredPrefixes(
+      thrift::IpPrefix const& prefix) const;
+
+  // most specific indexed prefix covering the given prefix, if any
+  std::optional<thrift::IpPrefix> getLongestMatch(
+      thrift::IpPrefix const& prefix) const;
+
+  // longest match for a whole batch of query prefixes in one pass. Queries
+  // are sorted by bit string internally so consecutive lookups re-descend
+  // only below their first differing bit instead of from the root. Returns
+  // the distinct matched prefixes in sorted order
+  std::vector<thrift::IpPrefix> getLongestMatches(
+      std::vector<thrift::IpPrefix> prefixes) const;
+
+ private:
+  struct TrieNode {
+    std::array<std::unique_ptr<TrieNode>, 2> children;
+    // set iff a prefix terminates at this node
+    std::optional<thrift::IpPrefix> prefix;
+  };
+
+  // v4 and v6 prefixes live in separate tries so their bit strings never alias
+  TrieNode& rootFor(thrift::IpPrefix const& prefix);
+  TrieNode const& rootFor(thrift::IpPrefix const& prefix) const;
+
+  TrieNode rootV4_, rootV6_;
+}; // class PrefixTrie
+
+} // namespace openr
@@ -0,0 +1,119 @@
+/**
+ * Copyright (c) 2014-present, Facebook, Inc.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <openr/common/ReplayLog.h>
+
+#include <chrono>
+
+#include <fcntl.h>
+
+#include <folly/FileUtil.h>
+#include <glog/logging.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+namespace {
+
+// fixed per-record frame, written in host byte order
+struct RecordHeader {
+  int64_t timestampNs;
+  int32_t type;
+  uint32_t payloadLength;
+};
+
+} // namespace
+
+namespace openr {
+
+ReplayLogWriter::ReplayLogWriter(const std::string& filename)
+    : file_(filename, O_WRONLY | O_CREAT | O_TRUNC) {
+  LOG(INFO) << "Capturing replay log to " << filename;
+}
+
+void
+ReplayLogWriter::appendPublication(const thrift::Publication& publication) {
+  apache::thrift::CompactSerializer serializer;
+  std::string payload;
+  serializer.serialize(publication, &payload);
+  append(ReplayRecordType::PUBLICATION, payload);
+}
+
+void
+ReplayLogWriter::appendPlatformEvent(const thrift::PlatformEvent& event) {
+  apache::thrift::CompactSerializer serializer;
+  std::string payload;
+  serializer.serialize(event, &payload);
+  append(ReplayRecordType::PLATFORM_EVENT, payload);
+}
+
+void
+ReplayLogWriter::append(ReplayRecordType type, const std::string& payload) {
+  if (disabled_) {
+    return;
+  }
+
+  RecordHeader header;
+  header.timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::system_clock::now().time_since_epoch())
+                           .count();
+  header.type = static_cast<int32_t>(type);
+  header.payloadLength = payload.size();
+
+  if (folly::writeFull(file_.fd(), &header, sizeof(header)) !=
+          static_cast<ssize_t>(sizeof(header)) or
+      folly::writeFull(file_.fd(), payload.data(), payload.size()) !=
+          static_cast<ssize_t>(payload.size())) {
+    LOG(ERROR) << "Failed to append replay log record, disabling capture: "
+               << folly::errnoStr(errno);
+    disabled_ = true;
+  }
+}
+
+ReplayLogReader::ReplayLogReader(const std::string& filename)
+    : file_(filename, O_RDONLY) {}
+
+std::optional<ReplayRecord>
+ReplayLogReader::next() {
+  RecordHeader header;
+  const auto headerRead = folly::readFull(file_.fd(), &header, sizeof(header));
+  if (headerRead == 0) {
+    return std::nullopt; // clean end of file
+  }
+  if (headerRead != static_cast<ssize_t>(sizeof(header))) {
+    throw std::runtime_error("truncated replay log record header");
+  }
+
+  ReplayRecord record;
+  record.timestampNs = header.timestampNs;
+  record.type = static_cast<ReplayRecordType>(header.type);
+  record.payload.resize(header.payloadLength);
+  if (folly::readFull(
+          file_.fd(), record.payload.data(), record.payload.size()) !=
+      static_cast<ssize_t>(record.payload.size())) {
+    throw std::runtime_error("truncated replay log record payload");
+  }
+  return record;
+}
+
+thrift::Publication
+ReplayLogReader::decodePublication(const ReplayRecord& record) {
+  CHECK(record.type == ReplayRecordType::PUBLICATION);
+  apache::thrift::CompactSerializer serializer;
+  thrift::Publication publication;
+  serializer.deserialize(record.payload, publication);
+  return publication;
+}
+
+thrift::PlatformEvent
+ReplayLogReader::decodePlatformEvent(const ReplayRecord& record) {
+  CHECK(record.type == ReplayRecordType::PLATFORM_EVENT);
+  apache::thrift::CompactSerializer serializer;
+  thrift::PlatformEvent event;
+  serializer.deserialize(record.payload, event);
+  return event;
+}
+
+} // namespace openr
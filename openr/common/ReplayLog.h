@@ -0,0 +1,96 @@
+/**
+ * Copyright (c) 2014-present, Facebook, Inc.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <optional>
+#include <string>
+
+#include <folly/File.h>
+
+#include <openr/if/gen-cpp2/KvStore_types.h>
+#include <openr/if/gen-cpp2/Platform_types.h>
+
+namespace openr {
+
+/*
+ * Compact binary capture of module input streams for offline replay.
+ *
+ * Records are framed as a fixed header (capture timestamp in system-clock
+ * nanoseconds, record type, payload length) followed by the
+ * compact-serialized thrift payload. Header fields are written in host
+ * byte order - captures are meant to be replayed on machines of the same
+ * architecture, not archived as a portable interchange format.
+ *
+ * Captured today: the publication stream entering
+ * Decision::processPublication and the platform events entering
+ * LinkMonitor (see OpenrConfig.event_capture_dir). The replay driver in
+ * openr/tests/ReplayBenchmark.cpp feeds a capture back into a Decision
+ * instance at original or accelerated timing.
+ */
+
+enum class ReplayRecordType : int32_t {
+  PUBLICATION = 1,
+  PLATFORM_EVENT = 2,
+};
+
+struct ReplayRecord {
+  int64_t timestampNs{0};
+  ReplayRecordType type;
+  std::string payload;
+};
+
+/*
+ * Appends records to a capture file. Writes happen synchronously on the
+ * caller's thread and are cheap (one writev-sized write per record); a
+ * write failure logs once and disables the writer for the rest of its
+ * lifetime. Not thread-safe - each capturing module owns its writer and
+ * appends from its own thread.
+ */
+class ReplayLogWriter final {
+ public:
+  explicit ReplayLogWriter(const std::string& filename);
+
+  // disable copying
+  ReplayLogWriter(ReplayLogWriter const&) = delete;
+  ReplayLogWriter& operator=(ReplayLogWriter const&) = delete;
+
+  void appendPublication(const thrift::Publication& publication);
+  void appendPlatformEvent(const thrift::PlatformEvent& event);
+
+ private:
+  // frame and write one record, stamping the current time
+  void append(ReplayRecordType type, const std::string& payload);
+
+  folly::File file_;
+  bool disabled_{false};
+};
+
+/*
+ * Sequentially reads records from a capture file. next() returns
+ * std::nullopt at end of file and throws std::runtime_error on a
+ * truncated or malformed frame.
+ */
+class ReplayLogReader final {
+ public:
+  explicit ReplayLogReader(const std::string& filename);
+
+  // disable copying
+  ReplayLogReader(ReplayLogReader const&) = delete;
+  ReplayLogReader& operator=(ReplayLogReader const&) = delete;
+
+  std::optional<ReplayRecord> next();
+
+  // typed payload decoders
+  static thrift::Publication decodePublication(const ReplayRecord& record);
+  static thrift::PlatformEvent decodePlatformEvent(const ReplayRecord& record);
+
+ private:
+  folly::File file_;
+};
+
+} // namespace openr
@@ -9,9 +9,11 @@
 
 #include <cmath>
 #include <functional>
+#include <numeric>
 #include <stdexcept>
+#include <vector>
 
-#include <folly/stats/BucketedTimeSeries.h>
+#include <glog/logging.h>
 
 namespace openr {
 
@@ -37,8 +39,9 @@ template <typename ValueType, typename TimeType>
 class StepDetector {
  public:
   StepDetector(
-      // interval time series is sampled
-      TimeType samplePeriod,
+      // interval time series is sampled; windows are sample-count based
+      // with one sample expected per period
+      TimeType /* samplePeriod */,
       // fast sliding window size
       size_t fastWndSize,
       // slow sliding window size
@@ -52,8 +55,8 @@ class StepDetector {
       // callback when step is detected
       std::function<void(const ValueType&)> stepCb)
       : slowWndSize_(slowWndSize),
-        fastSlideWindow_(fastWndSize, samplePeriod * fastWndSize),
-        slowSlideWindow_(slowWndSize, samplePeriod * slowWndSize),
+        fastSlideWindow_(fastWndSize),
+        slowSlideWindow_(slowWndSize),
         loThreshold_(loThreshold),
         hiThreshold_(hiThreshold),
         absThreshold_(absThreshold),
@@ -65,8 +68,8 @@ class StepDetector {
   // add the value 'val' at time 'now' to both fast and slow sliding window
   bool
   addValue(TimeType now, const ValueType& val) {
-    bool fastSuccess = fastSlideWindow_.addValue(now, val);
-    bool slowSuccess = slowSlideWindow_.addValue(now, val);
+    fastSlideWindow_.addValue(val);
+    slowSlideWindow_.addValue(val);
 
     auto fastAvg = fastSlideWindow_.avg();
     auto slowAvg = slowSlideWindow_.avg();
@@ -97,7 +100,7 @@ class StepDetector {
         stepCb_(fastAvg);
         lastAvg_ = fastAvg;
         lastAvgInit_ = true;
-        return fastSuccess && slowSuccess;
+        return true;
       }
     } else {
       if (diff >= hiThreshold_) {
@@ -117,7 +120,7 @@ class StepDetector {
       lastAvg_ = slowAvg;
     }
 
-    return fastSuccess && slowSuccess;
+    return true;
   }
 
  private:
@@ -125,16 +128,63 @@ class StepDetector {
   StepDetector(StepDetector const&) = delete;
   StepDetector& operator=(StepDetector const&) = delete;
 
+  /*
+   * fixed-size sample ring with a running sum: O(1) per sample and no
+   * rescan of history to compute the window mean. Windows are sample
+   * count based rather than time based - RTT samples arrive once per
+   * sampling period, so a window of N samples spans N periods
+   */
+  class SlidingWindow {
+   public:
+    explicit SlidingWindow(size_t capacity)
+        : samples_(capacity, ValueType{}) {}
+
+    void
+    addValue(const ValueType& val) {
+      sum_ += static_cast<double>(val);
+      if (size_ < samples_.size()) {
+        ++size_;
+      } else {
+        sum_ -= static_cast<double>(samples_[next_]);
+      }
+      samples_[next_] = val;
+      next_ = (next_ + 1) % samples_.size();
+      if (next_ == 0 && size_ == samples_.size()) {
+        // refresh the running sum once per wrap so floating point drift
+        // cannot accumulate over days of continuous samples
+        sum_ = std::accumulate(samples_.begin(), samples_.end(), 0.0);
+      }
+    }
+
+    double
+    avg() const {
+      return size_ == 0 ? 0.0 : sum_ / size_;
+    }
+
+    size_t
+    count() const {
+      return size_;
+    }
+
+   private:
+    // sample ring; sized once at construction
+    std::vector<ValueType> samples_;
+    // number of valid samples, saturates at capacity
+    size_t size_{0};
+    // slot the next sample lands in
+    size_t next_{0};
+    // running sum of the samples currently in the window
+    double sum_{0.0};
+  };
+
   // slow sliding window size
   size_t slowWndSize_{0};
 
   // fast sliding window
-  folly::BucketedTimeSeries<ValueType, folly::LegacyStatsClock<TimeType>>
-      fastSlideWindow_;
+  SlidingWindow fastSlideWindow_;
 
-  // slow sliding window size
-  folly::BucketedTimeSeries<ValueType, folly::LegacyStatsClock<TimeType>>
-      slowSlideWindow_;
+  // slow sliding window
+  SlidingWindow slowSlideWindow_;
 
   // lower threshold, in percentage
   const uint8_t loThreshold_{0};
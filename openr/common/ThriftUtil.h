@@ -6,6 +6,8 @@
  */
 #pragma once
 
+#include <folly/io/IOBuf.h>
+#include <folly/io/IOBufQueue.h>
 #include <thrift/lib/cpp2/server/ThriftServer.h>
 #include <wangle/ssl/SSLContextConfig.h>
 
@@ -18,4 +20,40 @@ void setupThriftServerTls(
     std::string const& ticketSeedPath,
     std::shared_ptr<wangle::SSLContextConfig> sslContext);
 
+// wire size of a thrift object under the serializer's protocol. The
+// size pass is specialized per type and protocol at compile time, so
+// for flat structs it inlines down to plain arithmetic
+template <typename ThriftType, typename Serializer>
+size_t
+serializedSize(ThriftType const& obj, Serializer& /* serializer */) {
+  typename Serializer::ProtocolWriter writer;
+  return obj.serializedSize(&writer);
+}
+
+// serialize a thrift object into an IOBuf chain. Unlike the *Str
+// helpers there is no intermediate std::string, so the payload is never
+// copied out of the serializer's buffers. The output buffer is sized up
+// front from the protocol's size pass, so large objects (full-sync
+// publications) land in one buffer instead of growing a chain
+template <typename ThriftType, typename Serializer>
+std::unique_ptr<folly::IOBuf>
+writeThriftObj(ThriftType const& obj, Serializer& serializer) {
+  const auto sizeHint = serializedSize(obj, serializer);
+  folly::IOBufQueue queue{folly::IOBufQueue::cacheChainLength()};
+  queue.preallocate(sizeHint, sizeHint);
+  serializer.serialize(obj, &queue);
+  return queue.move();
+}
+
+// deserialize a thrift object straight out of an IOBuf chain. The
+// deserializer walks the chain with a cursor, so chained input is not
+// linearized first
+template <typename ThriftType, typename Serializer>
+ThriftType
+readThriftObj(folly::IOBuf const& buf, Serializer& serializer) {
+  ThriftType obj;
+  serializer.deserialize(&buf, obj);
+  return obj;
+}
+
 } // namespace openr
@@ -7,20 +7,72 @@
 
 #include "Util.h"
 
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <unordered_map>
+
+#include <folly/Synchronized.h>
+#include <folly/hash/SpookyHashV2.h>
+#include <folly/memory/Malloc.h>
+
 #include <ifaddrs.h>
 #include <net/if.h>
 #include <netinet/in.h>
+#include <pthread.h>
+#include <sched.h>
 #include <stdlib.h>
+#include <sys/resource.h>
 #include <sys/stat.h>
+#include <sys/syscall.h>
 #include <unistd.h>
 
+namespace {
+
+// MPOL_PREFERRED from <numaif.h>, defined locally so we don't grow a
+// libnuma dependency for a single syscall constant
+constexpr int kMpolPreferred{1};
+
+// any of these characters turns a "prefix" into a real regex for RE2
+bool
+isRegexPrefix(std::string const& prefix) {
+  return prefix.find_first_of(R"(.^$*+?()[]{}\|)") != std::string::npos;
+}
+
+} // anonymous namespace
+
 namespace openr {
 
-// create RE2 set for the list of key prefixes
+// compile literal prefix lists into a trie; fall back to an RE2 set when
+// any entry uses regex syntax
 KeyPrefix::KeyPrefix(std::vector<std::string> const& keyPrefixList) {
   if (keyPrefixList.empty()) {
     return;
   }
+
+  if (std::none_of(
+          keyPrefixList.begin(), keyPrefixList.end(), isRegexPrefix)) {
+    trieNodes_.emplace_back();
+    trieNodes_.back().fill(-1);
+    trieTerminal_.push_back(false);
+    for (auto const& keyPrefix : keyPrefixList) {
+      int32_t node{0};
+      for (char const c : keyPrefix) {
+        int32_t next = trieNodes_[node][static_cast<uint8_t>(c)];
+        if (next < 0) {
+          next = static_cast<int32_t>(trieNodes_.size());
+          trieNodes_.emplace_back();
+          trieNodes_.back().fill(-1);
+          trieTerminal_.push_back(false);
+          trieNodes_[node][static_cast<uint8_t>(c)] = next;
+        }
+        node = next;
+      }
+      trieTerminal_[node] = true;
+    }
+    return;
+  }
+
   re2::RE2::Options re2Options;
   re2Options.set_case_sensitive(true);
   keyPrefix_ =
@@ -43,6 +95,23 @@ KeyPrefix::KeyPrefix(std::vector<std::string> const& keyPrefixList) {
 // match the key with the list of prefixes
 bool
 KeyPrefix::keyMatch(std::string const& key) const {
+  if (not trieNodes_.empty()) {
+    int32_t node{0};
+    if (trieTerminal_[node]) {
+      // empty prefix configured; everything matches
+      return true;
+    }
+    for (char const c : key) {
+      node = trieNodes_[node][static_cast<uint8_t>(c)];
+      if (node < 0) {
+        return false;
+      }
+      if (trieTerminal_[node]) {
+        return true;
+      }
+    }
+    return false;
+  }
   if (!keyPrefix_) {
     return true;
   }
@@ -123,6 +192,93 @@ executeShellCommand(const std::string& command) {
   return ret;
 }
 
+void
+applyThreadSchedulingConfig(
+    const thrift::ThreadConfig& threadConfig) noexcept {
+  // cpu affinity
+  if (not threadConfig.cpu_affinity.empty()) {
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (const auto cpu : threadConfig.cpu_affinity) {
+      CPU_SET(cpu, &cpuSet);
+    }
+    if (auto err =
+            pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet)) {
+      LOG(WARNING) << folly::sformat(
+          "Failed to set cpu affinity for thread {}: {}",
+          threadConfig.thread_name,
+          folly::errnoStr(err));
+    }
+  }
+
+  // scheduling policy and priority
+  if (threadConfig.sched_policy != "other") {
+    struct sched_param schedParam;
+    schedParam.sched_priority = threadConfig.sched_priority;
+    const int policy =
+        threadConfig.sched_policy == "rr" ? SCHED_RR : SCHED_FIFO;
+    if (auto err =
+            pthread_setschedparam(pthread_self(), policy, &schedParam)) {
+      LOG(WARNING) << folly::sformat(
+          "Failed to set {} policy for thread {}: {}",
+          threadConfig.sched_policy,
+          threadConfig.thread_name,
+          folly::errnoStr(err));
+    }
+  } else if (threadConfig.nice_level != 0) {
+    // nice level applies per thread on linux
+    errno = 0;
+    if (setpriority(PRIO_PROCESS, 0, threadConfig.nice_level) != 0 and errno) {
+      LOG(WARNING) << folly::sformat(
+          "Failed to set nice level for thread {}: {}",
+          threadConfig.thread_name,
+          folly::errnoStr(errno));
+    }
+  }
+
+  // NUMA memory binding: prefer the given node for this thread's
+  // allocations so the module's heap is faulted local to the cpus pinned
+  // above. Memory policy is per-task on linux, so this only covers pages
+  // first touched by this thread - pair it with dedicated_malloc_arena to
+  // keep the module's extents off other threads
+  if (threadConfig.numa_node >= 0) {
+    unsigned long nodeMask = 1UL << threadConfig.numa_node;
+    if (syscall(
+            SYS_set_mempolicy,
+            kMpolPreferred,
+            &nodeMask,
+            sizeof(nodeMask) * 8) != 0) {
+      LOG(WARNING) << folly::sformat(
+          "Failed to set numa node {} for thread {}: {}",
+          threadConfig.numa_node,
+          threadConfig.thread_name,
+          folly::errnoStr(errno));
+    }
+  }
+
+  // dedicated jemalloc arena: module allocations stop interleaving with
+  // the rest of the process, and with numa_node set above the arena's
+  // fresh extents land on the local socket
+  if (threadConfig.dedicated_malloc_arena) {
+    if (folly::usingJEMalloc()) {
+      unsigned arena{0};
+      size_t arenaSize = sizeof(arena);
+      if (mallctl("arenas.create", &arena, &arenaSize, nullptr, 0) != 0 or
+          mallctl("thread.arena", nullptr, nullptr, &arena, sizeof(arena)) !=
+              0) {
+        LOG(WARNING) << folly::sformat(
+            "Failed to bind dedicated malloc arena for thread {}",
+            threadConfig.thread_name);
+      }
+    } else {
+      LOG(WARNING) << folly::sformat(
+          "dedicated_malloc_arena set for thread {} but jemalloc is not in "
+          "use",
+          threadConfig.thread_name);
+    }
+  }
+}
+
 bool
 matchRegexSet(
     const std::string& name, std::shared_ptr<const re2::RE2::Set> regexSet) {
@@ -361,11 +517,114 @@ addPerfEvent(
     thrift::PerfEvents& perfEvents,
     const std::string& nodeName,
     const std::string& eventDescr) noexcept {
+  perftrace::recordEvent(
+      perftrace::internEventName(nodeName),
+      perftrace::internEventName(eventDescr));
   thrift::PerfEvent event(
       apache::thrift::FRAGILE, nodeName, eventDescr, getUnixTimeStampMs());
   perfEvents.events.emplace_back(std::move(event));
 }
 
+namespace perftrace {
+
+namespace {
+
+constexpr size_t kTraceCapacity{8192};
+
+struct TraceRecord {
+  // 0 means empty/in-flight; a completed record holds 1 + its sequence
+  // number so readers can tell a slot being overwritten from a valid one
+  std::atomic<uint64_t> seq{0};
+  uint16_t nodeId{0};
+  uint16_t eventId{0};
+  int64_t unixTsMs{0};
+};
+
+struct TraceState {
+  folly::Synchronized<std::vector<std::string>> names;
+  folly::Synchronized<std::unordered_map<std::string, uint16_t>> ids;
+  std::array<TraceRecord, kTraceCapacity> ring;
+  std::atomic<uint64_t> next{0};
+};
+
+// leaked on purpose so records written during static destruction of
+// other modules stay safe
+TraceState&
+traceState() {
+  static TraceState* const state = new TraceState();
+  return *state;
+}
+
+} // anonymous namespace
+
+uint16_t
+internEventName(const std::string& name) {
+  auto& state = traceState();
+  {
+    const auto ids = state.ids.rlock();
+    auto it = ids->find(name);
+    if (it != ids->end()) {
+      return it->second;
+    }
+  }
+  const auto ids = state.ids.wlock();
+  auto it = ids->find(name);
+  if (it != ids->end()) {
+    return it->second;
+  }
+  const auto names = state.names.wlock();
+  if (names->size() > std::numeric_limits<uint16_t>::max()) {
+    // the name set is expected to be a handful of literals; if it ever
+    // explodes, alias the overflow onto id 0 rather than growing forever
+    return 0;
+  }
+  const auto id = static_cast<uint16_t>(names->size());
+  names->emplace_back(name);
+  ids->emplace(name, id);
+  return id;
+}
+
+void
+recordEvent(uint16_t nodeId, uint16_t eventId) noexcept {
+  auto& state = traceState();
+  const auto seq = state.next.fetch_add(1, std::memory_order_relaxed);
+  auto& slot = state.ring[seq % kTraceCapacity];
+  slot.seq.store(0, std::memory_order_release);
+  slot.nodeId = nodeId;
+  slot.eventId = eventId;
+  slot.unixTsMs = getUnixTimeStampMs();
+  slot.seq.store(seq + 1, std::memory_order_release);
+}
+
+thrift::PerfEvents
+dumpPerfTrace() {
+  auto& state = traceState();
+  thrift::PerfEvents trace;
+  const auto next = state.next.load(std::memory_order_acquire);
+  const auto first = next > kTraceCapacity ? next - kTraceCapacity : 0;
+  const auto names = state.names.rlock();
+  for (auto seq = first; seq < next; ++seq) {
+    auto& slot = state.ring[seq % kTraceCapacity];
+    if (slot.seq.load(std::memory_order_acquire) != seq + 1) {
+      continue;
+    }
+    thrift::PerfEvent event(
+        apache::thrift::FRAGILE,
+        names->at(slot.nodeId),
+        names->at(slot.eventId),
+        slot.unixTsMs);
+    // writers bump seq only after their payload stores, so an unchanged
+    // seq here means the fields read above were not torn
+    if (slot.seq.load(std::memory_order_acquire) != seq + 1) {
+      continue;
+    }
+    trace.events.emplace_back(std::move(event));
+  }
+  return trace;
+}
+
+} // namespace perftrace
+
 std::vector<std::string>
 sprintPerfEvents(const thrift::PerfEvents& perfEvents) noexcept {
   const auto& events = perfEvents.events;
@@ -433,17 +692,29 @@ getDurationBetweenPerfEvents(
   return std::chrono::milliseconds(second - first);
 }
 
+// stream the fields through SpookyHash as one logical message instead of
+// hash_combine'ing them: no temporary concatenation, and the value blob -
+// the bulk of the input on fat keys - runs through SpookyHash's wide
+// 96-byte mixing loop rather than a byte-at-a-time string hash. The
+// originator length is folded in as a separator so field boundaries are
+// unambiguous. NOTE: hashes are exchanged between peers (dumpDifference,
+// hash dumps), so all nodes of a domain must agree on this function
 template <class T>
 int64_t
 generateHashImpl(
     const int64_t version, const std::string& originatorId, const T& value) {
-  size_t seed = 0;
-  boost::hash_combine(seed, version);
-  boost::hash_combine(seed, originatorId);
+  folly::hash::SpookyHashV2 hasher;
+  hasher.Init(0 /* seed1 */, 0 /* seed2 */);
+  hasher.Update(&version, sizeof(version));
+  const uint64_t originatorLen = originatorId.size();
+  hasher.Update(&originatorLen, sizeof(originatorLen));
+  hasher.Update(originatorId.data(), originatorId.size());
   if (value.has_value()) {
-    boost::hash_combine(seed, value.value());
+    hasher.Update(value.value().data(), value.value().size());
   }
-  return static_cast<int64_t>(seed);
+  uint64_t hash1{0}, hash2{0};
+  hasher.Final(&hash1, &hash2);
+  return static_cast<int64_t>(hash1);
 }
 
 int64_t
@@ -797,6 +1068,91 @@ createAdjDb(
   return adjDb;
 }
 
+void
+compactAdjacencyDb(thrift::AdjacencyDatabase& adjDb) {
+  std::vector<std::string> stringTable;
+  std::unordered_map<std::string, int32_t> stringIndex;
+  auto intern = [&](const std::string& s) -> int32_t {
+    auto it = stringIndex.find(s);
+    if (it != stringIndex.end()) {
+      return it->second;
+    }
+    const int32_t idx = stringTable.size();
+    stringIndex.emplace(s, idx);
+    stringTable.emplace_back(s);
+    return idx;
+  };
+  auto internAddrIfName = [&](const thrift::BinaryAddress& addr) -> int32_t {
+    return addr.ifName_ref().has_value() ? intern(addr.ifName_ref().value())
+                                         : -1;
+  };
+
+  std::vector<thrift::CompactAdjacency> compactAdjs;
+  compactAdjs.reserve(adjDb.adjacencies.size());
+  for (auto& adj : adjDb.adjacencies) {
+    thrift::CompactAdjacency compact;
+    compact.otherNodeNameIdx = intern(adj.otherNodeName);
+    compact.ifNameIdx = intern(adj.ifName);
+    compact.otherIfNameIdx =
+        adj.otherIfName.empty() ? -1 : intern(adj.otherIfName);
+    compact.nextHopV6IfNameIdx = internAddrIfName(adj.nextHopV6);
+    compact.nextHopV6Addr = std::move(adj.nextHopV6.addr);
+    compact.nextHopV4IfNameIdx = internAddrIfName(adj.nextHopV4);
+    compact.nextHopV4Addr = std::move(adj.nextHopV4.addr);
+    compact.metric = adj.metric;
+    compact.adjLabel = adj.adjLabel;
+    compact.isOverloaded = adj.isOverloaded;
+    compact.rtt = adj.rtt;
+    compact.timestamp = adj.timestamp;
+    compact.weight = adj.weight;
+    compactAdjs.emplace_back(std::move(compact));
+  }
+
+  adjDb.adjacencies.clear();
+  adjDb.stringTable_ref() = std::move(stringTable);
+  adjDb.compactAdjacencies_ref() = std::move(compactAdjs);
+}
+
+void
+expandAdjacencyDb(thrift::AdjacencyDatabase& adjDb) {
+  if (not adjDb.compactAdjacencies_ref().has_value()) {
+    return;
+  }
+  const std::vector<std::string> emptyTable;
+  const auto& stringTable = adjDb.stringTable_ref().has_value()
+      ? adjDb.stringTable_ref().value()
+      : emptyTable;
+
+  adjDb.adjacencies.clear();
+  adjDb.adjacencies.reserve(adjDb.compactAdjacencies_ref()->size());
+  for (auto& compact : adjDb.compactAdjacencies_ref().value()) {
+    thrift::Adjacency adj;
+    adj.otherNodeName = stringTable.at(compact.otherNodeNameIdx);
+    adj.ifName = stringTable.at(compact.ifNameIdx);
+    if (compact.otherIfNameIdx >= 0) {
+      adj.otherIfName = stringTable.at(compact.otherIfNameIdx);
+    }
+    adj.nextHopV6.addr = std::move(compact.nextHopV6Addr);
+    if (compact.nextHopV6IfNameIdx >= 0) {
+      adj.nextHopV6.ifName_ref() = stringTable.at(compact.nextHopV6IfNameIdx);
+    }
+    adj.nextHopV4.addr = std::move(compact.nextHopV4Addr);
+    if (compact.nextHopV4IfNameIdx >= 0) {
+      adj.nextHopV4.ifName_ref() = stringTable.at(compact.nextHopV4IfNameIdx);
+    }
+    adj.metric = compact.metric;
+    adj.adjLabel = compact.adjLabel;
+    adj.isOverloaded = compact.isOverloaded;
+    adj.rtt = compact.rtt;
+    adj.timestamp = compact.timestamp;
+    adj.weight = compact.weight;
+    adjDb.adjacencies.emplace_back(std::move(adj));
+  }
+
+  adjDb.stringTable_ref().reset();
+  adjDb.compactAdjacencies_ref().reset();
+}
+
 thrift::PrefixDatabase
 createPrefixDb(
     const std::string& nodeName,
@@ -925,7 +1281,7 @@ createMplsRoute(const MplsLabelAndNextHops& prefixInfo) {
   mplsRoute.topLabel = prefixInfo.label;
   for (const auto& [key, _] : prefixInfo.multiNextHops) {
     thrift::NextHopThrift nh;
-    nh.address = toBinaryAddress(key);
+    nh.address = toBinaryAddressCached(key);
     nh.mplsAction_ref() = createMplsAction(thrift::MplsActionCode::PHP);
     mplsRoute.nextHops.emplace_back(std::move(nh));
   }
@@ -1017,12 +1373,30 @@ createMplsRoutesWithBestNextHopsMap(
 
 std::string
 getNodeNameFromKey(const std::string& key) {
-  std::vector<std::string> split;
-  folly::split(Constants::kPrefixNameSeparator.toString(), key, split);
-  if (split.size() < 2) {
-    return "";
+  return getNodeNameViewFromKey(key).str();
+}
+
+folly::StringPiece
+getNodeNameViewFromKey(folly::StringPiece key) {
+  const auto sepPos = key.find(Constants::kPrefixNameSeparator);
+  if (sepPos == folly::StringPiece::npos) {
+    return folly::StringPiece{};
+  }
+  auto node = key.subpiece(sepPos + Constants::kPrefixNameSeparator.size());
+  const auto endPos = node.find(Constants::kPrefixNameSeparator);
+  if (endPos != folly::StringPiece::npos) {
+    node = node.subpiece(0, endPos);
   }
-  return split[1];
+  return node;
+}
+
+void
+composeNodeKey(
+    std::string& buf, folly::StringPiece marker, folly::StringPiece node) {
+  buf.clear();
+  buf.reserve(marker.size() + node.size());
+  buf.append(marker.data(), marker.size());
+  buf.append(node.data(), node.size());
 }
 
 std::string
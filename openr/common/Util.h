@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <array>
 #include <string>
 #include <vector>
 
@@ -86,7 +87,21 @@ class KeyPrefix {
   explicit KeyPrefix(std::vector<std::string> const& keyPrefixList);
   bool keyMatch(std::string const& key) const;
 
+  // true when the trie was built, i.e. the prefix list is non-empty and
+  // every configured prefix is a plain literal
+  bool
+  isLiteralOnly() const {
+    return not trieNodes_.empty();
+  }
+
  private:
+  // byte-wise trie over the prefix list, built when every configured
+  // prefix is a plain literal (the common case). Matching walks at most
+  // one node per key byte, independent of the number of prefixes
+  std::vector<std::array<int32_t, 256>> trieNodes_;
+  std::vector<bool> trieTerminal_;
+
+  // fallback matcher for prefix lists containing regex syntax
   std::unique_ptr<re2::RE2::Set> keyPrefix_;
 };
 
@@ -168,6 +183,15 @@ uint32_t bitStrValue(const folly::IPAddress& ip, uint32_t start, uint32_t end);
 std::vector<folly::CIDRNetwork> getIfacePrefixes(
     std::string ifName, sa_family_t afNet);
 
+/**
+ * apply cpu affinity, scheduling policy, nice level, NUMA memory policy
+ * and malloc-arena binding from the given thread config to the calling
+ * thread. Failures (e.g. missing CAP_SYS_NICE in dev environments) are
+ * logged and ignored.
+ */
+void applyThreadSchedulingConfig(
+    const thrift::ThreadConfig& threadConfig) noexcept;
+
 bool matchRegexSet(
     const std::string& name, std::shared_ptr<const re2::RE2::Set> regexSet);
 bool checkIncludeExcludeRegex(
@@ -226,6 +250,38 @@ void addPerfEvent(
     const std::string& nodeName,
     const std::string& eventDescr) noexcept;
 
+/**
+ * process-wide binary perf trace. addPerfEvent() mirrors every
+ * annotation into a fixed ring of compact records (interned name ids
+ * plus a timestamp), so the in-memory trace allocates nothing per event
+ * and is retained even when the publications carrying the thrift form
+ * are long gone. The thrift PerfEvents attached to publications are
+ * inter-node protocol and stay as they are; records are converted back
+ * to thrift only when the trace is dumped.
+ */
+namespace perftrace {
+
+/**
+ * intern an event or node name, returning its stable id. Names are
+ * expected to be a small fixed set of literals; repeated calls for the
+ * same name are a hash lookup
+ */
+uint16_t internEventName(const std::string& name);
+
+/**
+ * record one event into the trace ring. Lock-free: a relaxed
+ * fetch_add to claim a slot plus plain stores into it
+ */
+void recordEvent(uint16_t nodeId, uint16_t eventId) noexcept;
+
+/**
+ * convert the retained records to thrift, oldest first. Records being
+ * overwritten concurrently are skipped, not torn
+ */
+thrift::PerfEvents dumpPerfTrace();
+
+} // namespace perftrace
+
 // util for parsing lists from the command line
 std::vector<std::string> splitByComma(const std::string& input);
 
@@ -445,6 +501,16 @@ thrift::AdjacencyDatabase createAdjDb(
     std::optional<std::string> area = std::string{
         openr::thrift::KvStore_constants::kDefaultArea()});
 
+// convert AdjacencyDatabase.adjacencies into the compact wire encoding
+// (stringTable + compactAdjacencies, see Lsdb.thrift), clearing the
+// expanded list. Inverse of expandAdjacencyDb
+void compactAdjacencyDb(thrift::AdjacencyDatabase& adjDb);
+
+// rebuild AdjacencyDatabase.adjacencies from the compact encoding if
+// present (no-op otherwise), clearing the compact fields. Throws
+// std::out_of_range on a corrupt string-table index
+void expandAdjacencyDb(thrift::AdjacencyDatabase& adjDb);
+
 thrift::PrefixDatabase createPrefixDb(
     const std::string& nodeName,
     const std::vector<thrift::PrefixEntry>& prefixEntries);
@@ -520,6 +586,36 @@ std::vector<thrift::MplsRoute> createMplsRoutesWithBestNextHopsMap(
 
 std::string getNodeNameFromKey(const std::string& key);
 
+/**
+ * Allocation-free KvStore key codec helpers. Publication processing runs
+ * these against every key; they operate on views and compose into
+ * caller-provided buffers instead of materializing temporaries.
+ */
+
+/**
+ * True if key begins with the given marker (e.g. Constants::kAdjDbMarker).
+ * Equivalent to `key.find(marker.toString()) == 0` minus the temporary
+ * string per check.
+ */
+inline bool
+isKeyForMarker(folly::StringPiece key, folly::StringPiece marker) {
+  return key.startsWith(marker);
+}
+
+/**
+ * View of the node-name segment of a "<marker><node>[:<suffix>]" key.
+ * Same contract as getNodeNameFromKey without the splits and copies; the
+ * returned view aliases `key` and must not outlive it.
+ */
+folly::StringPiece getNodeNameViewFromKey(folly::StringPiece key);
+
+/**
+ * Compose "<marker><node>" into buf (cleared first), so repeat callers
+ * reuse buf's capacity instead of concatenating fresh strings.
+ */
+void composeNodeKey(
+    std::string& buf, folly::StringPiece marker, folly::StringPiece node);
+
 std::string createPeerSyncId(const std::string& node, const std::string& area);
 
 namespace MetricVectorUtils {
@@ -140,6 +140,24 @@ TEST_F(OpenrEventBaseTestFixture, Timestamp) {
   EXPECT_EQ(ts3, ts4);
 }
 
+TEST_F(OpenrEventBaseTestFixture, LoopLatencyStatsTest) {
+  // hold the loop hostage across the health timer's due time
+  evb.getEvb()->runInEventBaseThreadAndWait([]() {
+    /* sleep override */
+    std::this_thread::sleep_for(std::chrono::milliseconds(1200));
+  });
+
+  // wait for the delayed health timer to record its sample
+  auto stats = evb.getLoopLatencyStats();
+  for (int i = 0; i < 50 and stats.maxMs < 100; ++i) {
+    /* sleep override */
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    stats = evb.getLoopLatencyStats();
+  }
+  EXPECT_GE(stats.maxMs, 100);
+  EXPECT_GE(stats.p99Ms, stats.p50Ms);
+}
+
 TEST_F(OpenrEventBaseTestFixture, TimeoutTest) {
   folly::Baton waitBaton;
 
@@ -157,6 +175,55 @@ TEST_F(OpenrEventBaseTestFixture, TimeoutTest) {
   EXPECT_LE(std::chrono::milliseconds(200), elapsedMs);
 }
 
+TEST_F(OpenrEventBaseTestFixture, WheelTimeoutTest) {
+  folly::Baton waitBaton;
+
+  const auto startTs = std::chrono::steady_clock::now();
+  std::unique_ptr<WheelTimeout> timeout;
+  bool fired{false};
+  evb.getEvb()->runInEventBaseThread([&]() noexcept {
+    timeout = WheelTimeout::make(*evb.getEvb(), [&]() noexcept {
+      // re-arming from within the callback must work
+      if (not fired) {
+        fired = true;
+        timeout->scheduleTimeout(std::chrono::milliseconds(50));
+        return;
+      }
+      waitBaton.post();
+    });
+    timeout->scheduleTimeout(std::chrono::milliseconds(100));
+  });
+
+  waitBaton.wait();
+  const auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - startTs);
+  EXPECT_LE(std::chrono::milliseconds(150), elapsedMs);
+
+  // destroy on the evb thread - destruction cancels any pending timeout
+  folly::Baton destroyBaton;
+  evb.getEvb()->runInEventBaseThread([&]() noexcept {
+    timeout->scheduleTimeout(std::chrono::seconds(60));
+    timeout.reset();
+    destroyBaton.post();
+  });
+  destroyBaton.wait();
+}
+
+TEST_F(OpenrEventBaseTestFixture, CoarseTimeTest) {
+  folly::Baton waitBaton;
+  evb.getEvb()->runInEventBaseThread([&]() noexcept {
+    const auto coarse = evb.getCoarseTime();
+    const auto now = std::chrono::steady_clock::now();
+    // cached reading must be recent and never ahead of the real clock
+    EXPECT_LE(coarse, now);
+    EXPECT_LE(now - coarse, std::chrono::seconds(2));
+    // stable within one callback
+    EXPECT_EQ(coarse, evb.getCoarseTime());
+    waitBaton.post();
+  });
+  waitBaton.wait();
+}
+
 TEST_F(OpenrEventBaseTestFixture, ZmqSocketPollTest) {
   const auto msg = fbzmq::Message::from(std::string("test message")).value();
   const size_t expectedMsgs{16};
@@ -123,6 +123,13 @@ TEST(UtilTest, NetworkUtilTest) {
 
   thrift::BinaryAddress empty;
   EXPECT_EQ("", toString(empty));
+
+  // cached conversion matches the uncached one and interns the payload
+  EXPECT_EQ(toBinaryAddress(v4), toBinaryAddressCached(v4));
+  EXPECT_EQ(toBinaryAddress(v6), toBinaryAddressCached(v6));
+  EXPECT_EQ(
+      std::addressof(toBinaryAddressCached(v6)),
+      std::addressof(toBinaryAddressCached(v6)));
 }
 
 TEST(UtilTest, PrefixKeyTest) {
@@ -283,6 +290,32 @@ TEST(UtilTest, GetNodeNameFromKeyTest) {
   }
 }
 
+TEST(UtilTest, KeyCodecTest) {
+  // view-based node-name parse matches the string flavor
+  const std::unordered_map<std::string, std::string> expectedIo = {
+      {"prefix:node1", "node1"},
+      {"prefix:nodename.0.0:10:[0.0.0.0/0]", "nodename.0.0"},
+      {"", ""},
+      {"adj:", ""},
+      {"adj", ""}};
+  for (auto const& io : expectedIo) {
+    EXPECT_EQ(getNodeNameViewFromKey(io.first).str(), io.second);
+  }
+
+  // marker match without temporaries
+  EXPECT_TRUE(isKeyForMarker("adj:node1", Constants::kAdjDbMarker));
+  EXPECT_TRUE(isKeyForMarker("prefix:node1", Constants::kPrefixDbMarker));
+  EXPECT_FALSE(isKeyForMarker("adj:node1", Constants::kPrefixDbMarker));
+  EXPECT_FALSE(isKeyForMarker("ad", Constants::kAdjDbMarker));
+
+  // composition reuses the caller's buffer
+  std::string buf;
+  composeNodeKey(buf, Constants::kAdjDbMarker, "node1");
+  EXPECT_EQ("adj:node1", buf);
+  composeNodeKey(buf, Constants::kPrefixDbMarker, "node2");
+  EXPECT_EQ("prefix:node2", buf);
+}
+
 // test getNthPrefix()
 TEST(UtilTest, getNthPrefix) {
   // v6 allocation parameters
@@ -379,6 +412,29 @@ TEST(UtilTest, checkIncludeExcludeRegex) {
       checkIncludeExcludeRegex("eth", includeRegexList, excludeRegexList));
 }
 
+TEST(UtilTest, keyPrefixMatch) {
+  // empty prefix list matches everything
+  KeyPrefix emptyPrefix{{}};
+  EXPECT_TRUE(emptyPrefix.keyMatch("adj:node-1"));
+
+  // literal prefixes are matched via the compiled trie
+  KeyPrefix literalPrefix{{"adj:", "prefix:", "allocprefix:"}};
+  EXPECT_TRUE(literalPrefix.keyMatch("adj:node-1"));
+  EXPECT_TRUE(literalPrefix.keyMatch("prefix:node-1"));
+  EXPECT_TRUE(literalPrefix.keyMatch("allocprefix:node-1"));
+  EXPECT_TRUE(literalPrefix.keyMatch("adj:"));
+  EXPECT_FALSE(literalPrefix.keyMatch("adj"));
+  EXPECT_FALSE(literalPrefix.keyMatch("nodeLabel:1"));
+  EXPECT_FALSE(literalPrefix.keyMatch("xadj:node-1"));
+
+  // prefix lists with regex syntax keep RE2 semantics
+  KeyPrefix regexPrefix{{"adj:node-.", "prefix:.*"}};
+  EXPECT_TRUE(regexPrefix.keyMatch("adj:node-1"));
+  EXPECT_TRUE(regexPrefix.keyMatch("prefix:whatever"));
+  EXPECT_FALSE(regexPrefix.keyMatch("adj:node"));
+  EXPECT_FALSE(regexPrefix.keyMatch("nodeLabel:1"));
+}
+
 TEST(UtilTest, createLoopbackAddr) {
   {
     auto network = folly::IPAddress::createNetwork("fc00::/64");
@@ -514,6 +570,30 @@ TEST(UtilTest, addPerfEventTest) {
   }
 }
 
+TEST(UtilTest, perfTraceTest) {
+  // interned ids are stable across calls
+  const auto id = perftrace::internEventName("TRACE_TEST_EVENT");
+  EXPECT_EQ(id, perftrace::internEventName("TRACE_TEST_EVENT"));
+  EXPECT_NE(id, perftrace::internEventName("TRACE_TEST_OTHER"));
+
+  // annotations land in the process-wide trace; other tests may have
+  // written records too, so check containment and ordering only
+  thrift::PerfEvents perfEvents;
+  addPerfEvent(perfEvents, "trace-node", "TRACE_TEST_MARKER");
+  const auto trace = perftrace::dumpPerfTrace();
+  int64_t lastTs{0};
+  bool sawMarker{false};
+  for (const auto& event : trace.events) {
+    EXPECT_LE(lastTs, event.unixTs);
+    lastTs = event.unixTs;
+    if (event.nodeName == "trace-node" and
+        event.eventDescr == "TRACE_TEST_MARKER") {
+      sawMarker = true;
+    }
+  }
+  EXPECT_TRUE(sawMarker);
+}
+
 TEST(UtilTest, sprintPerfEventsTest) {
   {
     thrift::PerfEvents perfEvents;
@@ -816,6 +896,61 @@ TEST(UtilTest, getPrefixForwardingType) {
       thrift::PrefixForwardingType::SR_MPLS, getPrefixForwardingType(prefixes));
 }
 
+TEST(UtilTest, compactAdjacencyDbRoundTrip) {
+  auto adj1 = createThriftAdjacency(
+      "node-2",
+      "iface_2_1",
+      "fe80::2",
+      "192.168.0.2",
+      10 /* metric */,
+      100 /* adjLabel */,
+      false /* isOverloaded */,
+      100 /* rtt */,
+      1 /* timestamp */,
+      1 /* weight */,
+      "iface_1_2");
+  auto adj2 = createThriftAdjacency(
+      "node-3",
+      "iface_3_1",
+      "fe80::3",
+      "192.168.0.3",
+      10 /* metric */,
+      200 /* adjLabel */,
+      true /* isOverloaded */,
+      200 /* rtt */,
+      2 /* timestamp */,
+      2 /* weight */,
+      "" /* otherIfName */);
+  // link-local nexthops commonly carry their scoping interface
+  adj1.nextHopV6.ifName_ref() = "iface_2_1";
+  auto adjDb = createAdjDb("node-1", {adj1, adj2}, 1 /* nodeLabel */);
+  const auto origAdjDb = adjDb;
+
+  compactAdjacencyDb(adjDb);
+  EXPECT_TRUE(adjDb.adjacencies.empty());
+  ASSERT_TRUE(adjDb.stringTable_ref().has_value());
+  ASSERT_TRUE(adjDb.compactAdjacencies_ref().has_value());
+  EXPECT_EQ(2, adjDb.compactAdjacencies_ref()->size());
+  // "iface_2_1" appears as both adj ifName and nexthop scoping ifName but
+  // is interned once; adj2's empty otherIfName is not interned at all
+  EXPECT_EQ(
+      1,
+      std::count(
+          adjDb.stringTable_ref()->begin(),
+          adjDb.stringTable_ref()->end(),
+          "iface_2_1"));
+  EXPECT_EQ(-1, adjDb.compactAdjacencies_ref()->at(1).otherIfNameIdx);
+
+  expandAdjacencyDb(adjDb);
+  EXPECT_FALSE(adjDb.stringTable_ref().has_value());
+  EXPECT_FALSE(adjDb.compactAdjacencies_ref().has_value());
+  EXPECT_EQ(origAdjDb, adjDb);
+
+  // expanding an already-expanded db is a no-op
+  expandAdjacencyDb(adjDb);
+  EXPECT_EQ(origAdjDb, adjDb);
+}
+
 using namespace openr::MetricVectorUtils;
 TEST(MetricVectorUtilsTest, CompareResultInverseOperator) {
   EXPECT_EQ(CompareResult::WINNER, !CompareResult::LOOSER);
@@ -9,7 +9,11 @@
 
 #include <chrono>
 
+#include <folly/File.h>
 #include <folly/FileUtil.h>
+#include <folly/MemoryMapping.h>
+#include <folly/compression/Compression.h>
+#include <folly/hash/Checksum.h>
 #include <folly/io/IOBuf.h>
 
 #include <openr/common/Util.h>
@@ -31,6 +35,12 @@ PersistentStore::PersistentStore(
     bool dryrun,
     bool periodicallySaveToDisk)
     : storageFilePath_(storageFilePath), dryrun_(dryrun) {
+  // Create default shard. It owns every key not claimed by a registered shard
+  StoreShard defaultShard;
+  defaultShard.filePath = storageFilePath_;
+  defaultShard.dbFlushRatio = kDbFlushRatio;
+  shards_.emplace("", std::move(defaultShard));
+
   if (periodicallySaveToDisk) {
     // Create timer and backoff mechanism only if backoff is requested
     saveDbTimerBackoff_ =
@@ -62,6 +72,27 @@ PersistentStore::~PersistentStore() {
   saveDatabaseToDisk();
 }
 
+void
+PersistentStore::registerShard(
+    const std::string& keyPrefix, long dbFlushRatio, bool fsyncAppends) {
+  CHECK(not keyPrefix.empty()) << "Shard key prefix must be non-empty";
+
+  StoreShard shard;
+  shard.filePath = fs::path(storageFilePath_.string() + "." + keyPrefix);
+  shard.dbFlushRatio = dbFlushRatio;
+  shard.fsyncAppends = fsyncAppends;
+
+  auto result = shards_.emplace(keyPrefix, std::move(shard));
+  CHECK(result.second) << "Shard already registered for prefix: " << keyPrefix;
+
+  // Load shard's file. Its records override stale copies of migrated keys
+  // that may still sit in the default file until its next compaction
+  if (not loadShardFromDisk(result.first->second)) {
+    LOG(ERROR) << "Failed to load config-database from file: "
+               << result.first->second.filePath;
+  }
+}
+
 folly::SemiFuture<folly::Unit>
 PersistentStore::store(std::string key, std::string value) {
   folly::Promise<folly::Unit> p;
@@ -77,7 +108,7 @@ PersistentStore::store(std::string key, std::string value) {
     // Override previous value if any
     database_.keyVals[key] = value;
     auto pObject = toPersistentObject(ActionType::ADD, key, value);
-    pObjects_.emplace_back(std::move(pObject));
+    getShardFor(key).pObjects.emplace_back(std::move(pObject));
     maybeSaveObjectToDisk();
     p.setValue();
   });
@@ -93,7 +124,7 @@ PersistentStore::erase(std::string key) {
         SYSLOG(INFO) << "Erase key: " << key << " from config-store";
         if (database_.keyVals.erase(key) > 0) {
           auto pObject = toPersistentObject(ActionType::DEL, key, "");
-          pObjects_.emplace_back(std::move(pObject));
+          getShardFor(key).pObjects.emplace_back(std::move(pObject));
           maybeSaveObjectToDisk();
           p.setValue(true);
         } else {
@@ -135,46 +166,54 @@ PersistentStore::maybeSaveObjectToDisk() noexcept {
 bool
 PersistentStore::savePersistentObjectToDisk() noexcept {
   if (not dryrun_) {
-    // Write PersistentObject to ioBuf
-    std::vector<PersistentObject> newObjects;
-    newObjects = std::move(pObjects_);
+    // Flush each shard with pending objects independently
+    for (auto& [keyPrefix, shard] : shards_) {
+      if (shard.pObjects.empty()) {
+        continue;
+      }
 
-    auto queue = folly::IOBufQueue(folly::IOBufQueue::cacheChainLength());
+      // Write PersistentObject to ioBuf
+      std::vector<PersistentObject> newObjects;
+      newObjects = std::move(shard.pObjects);
 
-    for (auto& pObject : newObjects) {
-      auto buf = encodePersistentObject(pObject);
-      if (buf.hasError()) {
-        LOG(ERROR) << "Failed to encode PersistentObject to ioBuf. Error: "
-                   << folly::exceptionStr(buf.error());
-        return false;
+      auto queue = folly::IOBufQueue(folly::IOBufQueue::cacheChainLength());
+
+      for (auto& pObject : newObjects) {
+        auto buf = encodePersistentObject(pObject);
+        if (buf.hasError()) {
+          LOG(ERROR) << "Failed to encode PersistentObject to ioBuf. Error: "
+                     << folly::exceptionStr(buf.error());
+          return false;
+        }
+        queue.append(std::move(**buf));
       }
-      queue.append(std::move(**buf));
-    }
 
-    // Append IoBuf to disk
-    auto ioBuf = queue.move();
-    auto success = writeIoBufToDisk(ioBuf, WriteType::APPEND);
-    if (success.hasError()) {
-      LOG(ERROR) << "Failed to write PersistentObject to file '"
-                 << storageFilePath_
-                 << "'. Error: " << folly::exceptionStr(success.error());
-      return false;
-    }
+      // Append IoBuf to disk
+      auto ioBuf = queue.move();
+      auto success = writeIoBufToDisk(
+          ioBuf, WriteType::APPEND, shard.filePath, shard.fsyncAppends);
+      if (success.hasError()) {
+        LOG(ERROR) << "Failed to write PersistentObject to file '"
+                   << shard.filePath
+                   << "'. Error: " << folly::exceptionStr(success.error());
+        return false;
+      }
 
-    numOfNewWritesToDisk_++;
+      shard.numOfNewWrites++;
 
-    // Write the whole database to disk periodically
-    if (numOfNewWritesToDisk_ >= kDbFlushRatio) {
-      numOfNewWritesToDisk_ = 0;
-      const auto startTs = std::chrono::steady_clock::now();
-      if (not saveDatabaseToDisk()) {
-        return false;
+      // Write the whole shard to disk periodically
+      if (shard.numOfNewWrites >= shard.dbFlushRatio) {
+        shard.numOfNewWrites = 0;
+        const auto startTs = std::chrono::steady_clock::now();
+        if (not saveShardToDisk(shard)) {
+          return false;
+        }
+        LOG(INFO) << "Updated shard '" << shard.filePath << "' on disk. Took "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(
+                         std::chrono::steady_clock::now() - startTs)
+                         .count()
+                  << "ms";
       }
-      LOG(INFO) << "Updated database on disk. Took "
-                << std::chrono::duration_cast<std::chrono::milliseconds>(
-                       std::chrono::steady_clock::now() - startTs)
-                       .count()
-                << "ms";
     }
   } else {
     VLOG(1) << "Skipping writing to disk in dryrun mode";
@@ -186,37 +225,73 @@ PersistentStore::savePersistentObjectToDisk() noexcept {
 
 bool
 PersistentStore::saveDatabaseToDisk() noexcept {
-  std::unique_ptr<folly::IOBuf> ioBuf;
-  // If database is empty, write 'kTlvFormatMarker' to disk and return
-  if (database_.keyVals.size() == 0) {
-    ioBuf = folly::IOBuf::copyBuffer(
-        kTlvFormatMarker.data(), kTlvFormatMarker.size());
-  } else {
-    // Append kTlvFormatMarker to queue
-    auto queue = folly::IOBufQueue(folly::IOBufQueue::cacheChainLength());
-    queue.append(kTlvFormatMarker.data(), kTlvFormatMarker.size());
-
-    // Encode database_ and append to queue
-    for (auto& keyPair : database_.keyVals) {
-      PersistentObject pObject;
-      pObject =
-          toPersistentObject(ActionType::ADD, keyPair.first, keyPair.second);
-
-      auto buf = encodePersistentObject(pObject);
-      if (buf.hasError()) {
-        LOG(ERROR) << "Failed to encode PersistentObject to ioBuf. Error:  "
-                   << folly::exceptionStr(buf.error());
-        return false;
-      }
-      queue.append(std::move(*buf));
+  bool success = true;
+  for (auto& [keyPrefix, shard] : shards_) {
+    success &= saveShardToDisk(shard);
+  }
+  return success;
+}
+
+bool
+PersistentStore::saveShardToDisk(StoreShard& shard) noexcept {
+  // Encode shard-owned keys into a record stream
+  auto recordQueue = folly::IOBufQueue(folly::IOBufQueue::cacheChainLength());
+  for (auto& keyPair : database_.keyVals) {
+    if (&getShardFor(keyPair.first) != &shard) {
+      continue;
+    }
+    PersistentObject pObject;
+    pObject =
+        toPersistentObject(ActionType::ADD, keyPair.first, keyPair.second);
+
+    auto buf = encodePersistentObject(pObject);
+    if (buf.hasError()) {
+      LOG(ERROR) << "Failed to encode PersistentObject to ioBuf. Error:  "
+                 << folly::exceptionStr(buf.error());
+      return false;
+    }
+    recordQueue.append(std::move(*buf));
+  }
+  auto records = recordQueue.move();
+  const size_t recordsLength = records ? records->computeChainDataLength() : 0;
+
+  // Compacted snapshots compress well (keys share long prefixes, values
+  // share node names); on flash-backed boxes the smaller write matters more
+  // than the trivial decode cost at load. Delta appends stay raw records -
+  // they must remain appendable - so only the snapshot gets compressed
+  auto queue = folly::IOBufQueue(folly::IOBufQueue::cacheChainLength());
+  if (recordsLength >= Constants::kPersistentStoreCompressionThreshold) {
+    try {
+      auto compressed = folly::io::getCodec(folly::io::CodecType::ZSTD)
+                            ->compress(records.get());
+      auto lengthBuf = folly::IOBuf::create(sizeof(uint32_t));
+      folly::io::Appender appender(lengthBuf.get(), 0);
+      appender.writeBE<uint32_t>(compressed->computeChainDataLength());
+      queue.append(kTlvZstdFormatMarker.data(), kTlvZstdFormatMarker.size());
+      queue.append(std::move(lengthBuf));
+      queue.append(std::move(compressed));
+      records.reset();
+    } catch (std::exception const& e) {
+      LOG(ERROR) << "Failed to compress snapshot for '" << shard.filePath
+                 << "'. Writing uncompressed. Error: "
+                 << folly::exceptionStr(e);
+    }
+  }
+  if (queue.empty()) {
+    // Snapshot below the compression threshold (or compression failed).
+    // If the shard owns no keys only the marker gets written
+    queue.append(kTlvCrcFormatMarker.data(), kTlvCrcFormatMarker.size());
+    if (records) {
+      queue.append(std::move(records));
     }
-    // Write queue to disk
-    ioBuf = queue.move();
   }
+  // Write queue to disk
+  auto ioBuf = queue.move();
 
-  auto success = writeIoBufToDisk(ioBuf, WriteType::WRITE);
+  auto success = writeIoBufToDisk(
+      ioBuf, WriteType::WRITE, shard.filePath, true /* fsync */);
   if (success.hasError()) {
-    LOG(ERROR) << "Failed to write database to file '" << storageFilePath_
+    LOG(ERROR) << "Failed to write database to file '" << shard.filePath
                << "'. Error: " << folly::exceptionStr(success.error());
     return false;
   }
@@ -225,59 +300,116 @@ PersistentStore::saveDatabaseToDisk() noexcept {
 
 bool
 PersistentStore::loadDatabaseFromDisk() noexcept {
+  bool success = true;
+  for (auto& [keyPrefix, shard] : shards_) {
+    success &= loadShardFromDisk(shard);
+  }
+  return success;
+}
+
+bool
+PersistentStore::loadShardFromDisk(StoreShard& shard) noexcept {
   // Check if file exists
-  if (not fs::exists(storageFilePath_)) {
-    LOG(INFO) << "Storage file " << storageFilePath_ << " doesn't exists. "
+  if (not fs::exists(shard.filePath)) {
+    LOG(INFO) << "Storage file " << shard.filePath << " doesn't exists. "
               << "Starting with empty database";
     return true;
   }
 
-  // Read data from file
-  std::string fileData{""};
-  if (not folly::readFile(storageFilePath_.c_str(), fileData)) {
-    LOG(ERROR) << "Failed to read file contents from '" << storageFilePath_
-               << "'. Error (" << errno << "): " << folly::errnoStr(errno);
+  // Memory-map the file instead of copying it through a read buffer. The
+  // mapping is released once the database has been replayed
+  std::unique_ptr<folly::MemoryMapping> mapping;
+  std::unique_ptr<folly::IOBuf> ioBuf;
+  try {
+    if (fs::file_size(shard.filePath) == 0) {
+      return true; // empty file - empty database
+    }
+    mapping = std::make_unique<folly::MemoryMapping>(shard.filePath.c_str());
+    const auto range = mapping->range();
+    ioBuf = folly::IOBuf::wrapBuffer(range.data(), range.size());
+  } catch (std::exception const& e) {
+    LOG(ERROR) << "Failed to mmap file contents from '" << shard.filePath
+               << "'. Error: " << folly::exceptionStr(e);
     return false;
   }
 
-  // Create IoBuf and cursor for loading data from disk
-  auto ioBuf = folly::IOBuf::wrapBuffer(fileData.c_str(), fileData.size());
-  folly::io::Cursor cursor(ioBuf.get());
-
-  // Read 'kTlvFormatMarker' from ioBuf
-  if (not cursor.canAdvance(kTlvFormatMarker.size()) or
-      cursor.readFixedString(kTlvFormatMarker.size()) != kTlvFormatMarker) {
-    // Load old Format and write TlvFormat
-    auto oldSuccess = loadDatabaseOldFormat(ioBuf);
-    if (oldSuccess.hasError()) {
-      LOG(ERROR) << "Failed to read old-format file contents from '"
-                 << storageFilePath_
-                 << "'. Error: " << folly::exceptionStr(oldSuccess.error());
+  // Dispatch on the format marker
+  const auto fileData = folly::StringPiece(
+      reinterpret_cast<const char*>(ioBuf->data()), ioBuf->length());
+  if (fileData.startsWith(kTlvZstdFormatMarker)) {
+    // Load zstd-compressed snapshot plus any raw delta records behind it
+    auto zstdSuccess = loadDatabaseZstdFormat(shard, ioBuf);
+    if (zstdSuccess.hasError()) {
+      LOG(ERROR) << "Failed to read zstd-format file contents from '"
+                 << shard.filePath
+                 << "'. Error: " << folly::exceptionStr(zstdSuccess.error());
       return false;
     }
     return true;
   }
-  // Load TlvFormat
-  auto tlvSuccess = loadDatabaseTlvFormat(ioBuf);
-  if (tlvSuccess.hasError()) {
-    LOG(ERROR) << "Failed to read Tlv-format file contents from '"
-               << storageFilePath_
-               << "'. Error: " << folly::exceptionStr(tlvSuccess.error());
+  if (fileData.startsWith(kTlvCrcFormatMarker)) {
+    // Load checksummed TlvFormat
+    auto tlvSuccess =
+        loadDatabaseTlvFormat(shard, ioBuf, true /* withChecksum */);
+    if (tlvSuccess.hasError()) {
+      LOG(ERROR) << "Failed to read Tlv-format file contents from '"
+                 << shard.filePath
+                 << "'. Error: " << folly::exceptionStr(tlvSuccess.error());
+      return false;
+    }
+    return true;
+  }
+  if (fileData.startsWith(kTlvFormatMarker)) {
+    // Load legacy checksum-less TlvFormat
+    auto tlvSuccess =
+        loadDatabaseTlvFormat(shard, ioBuf, false /* withChecksum */);
+    if (tlvSuccess.hasError()) {
+      LOG(ERROR) << "Failed to read Tlv-format file contents from '"
+                 << shard.filePath
+                 << "'. Error: " << folly::exceptionStr(tlvSuccess.error());
+      return false;
+    }
+    // Upgrade to the checksummed format so subsequent appends are covered
+    saveShardToDisk(shard);
+    return true;
+  }
+
+  // Load old Format and write TlvFormat
+  auto oldSuccess = loadDatabaseOldFormat(shard, ioBuf);
+  if (oldSuccess.hasError()) {
+    LOG(ERROR) << "Failed to read old-format file contents from '"
+               << shard.filePath
+               << "'. Error: " << folly::exceptionStr(oldSuccess.error());
     return false;
   }
   return true;
 }
 
+PersistentStore::StoreShard&
+PersistentStore::getShardFor(const std::string& key) {
+  // Shards are held in descending prefix order, so the first prefix match
+  // is the longest one
+  for (auto& [keyPrefix, shard] : shards_) {
+    if (key.compare(0, keyPrefix.size(), keyPrefix) == 0) {
+      return shard;
+    }
+  }
+  // Not reachable - the default shard ("") matches every key
+  return shards_.at("");
+}
+
 folly::Expected<folly::Unit, std::string>
 PersistentStore::loadDatabaseOldFormat(
-    const std::unique_ptr<folly::IOBuf>& ioBuf) noexcept {
+    StoreShard& shard, const std::unique_ptr<folly::IOBuf>& ioBuf) noexcept {
   // Parse ioBuf into `database_`
   try {
     thrift::StoreDatabase newDatabase;
     serializer_.deserialize(ioBuf.get(), newDatabase);
-    database_ = std::move(newDatabase);
+    for (auto& keyVal : newDatabase.keyVals) {
+      database_.keyVals[keyVal.first] = keyVal.second;
+    }
     // Write Tlv format to disk
-    saveDatabaseToDisk();
+    saveShardToDisk(shard);
   } catch (std::exception const& e) {
     return folly::makeUnexpected<std::string>(
         folly::exceptionStr(e).toStdString());
@@ -287,23 +419,77 @@ PersistentStore::loadDatabaseOldFormat(
 
 folly::Expected<folly::Unit, std::string>
 PersistentStore::loadDatabaseTlvFormat(
-    const std::unique_ptr<folly::IOBuf>& ioBuf) noexcept {
+    StoreShard& shard,
+    const std::unique_ptr<folly::IOBuf>& ioBuf,
+    bool withChecksum) noexcept {
   // Parse ioBuf to persistentObject and then to `database_`
   folly::io::Cursor cursor(ioBuf.get());
   thrift::StoreDatabase newDatabase;
-  // Read 'kTlvFormatMarker'
+  // Read format marker
+  const auto& marker = withChecksum ? kTlvCrcFormatMarker : kTlvFormatMarker;
   try {
-    cursor.readFixedString(kTlvFormatMarker.size());
+    cursor.readFixedString(marker.size());
   } catch (std::out_of_range& e) {
     return folly::makeUnexpected<std::string>(
         folly::exceptionStr(e).toStdString());
   }
   // Iteratively read persistentObject from disk
+  replayTlvRecords(shard, cursor, withChecksum, newDatabase);
+  for (auto& keyVal : newDatabase.keyVals) {
+    database_.keyVals[keyVal.first] = keyVal.second;
+  }
+  return folly::Unit();
+}
+
+folly::Expected<folly::Unit, std::string>
+PersistentStore::loadDatabaseZstdFormat(
+    StoreShard& shard, const std::unique_ptr<folly::IOBuf>& ioBuf) noexcept {
+  folly::io::Cursor cursor(ioBuf.get());
+  thrift::StoreDatabase newDatabase;
+  std::unique_ptr<folly::IOBuf> snapshot;
+  try {
+    // Read format marker followed by the length-prefixed compressed snapshot
+    cursor.readFixedString(kTlvZstdFormatMarker.size());
+    const auto compressedLength = cursor.readBE<uint32_t>();
+    std::unique_ptr<folly::IOBuf> compressed;
+    cursor.clone(compressed, compressedLength);
+    snapshot = folly::io::getCodec(folly::io::CodecType::ZSTD)
+                   ->uncompress(compressed.get());
+  } catch (std::exception const& e) {
+    return folly::makeUnexpected<std::string>(
+        folly::exceptionStr(e).toStdString());
+  }
+
+  // Replay the snapshot's records, then the raw delta records appended
+  // behind the compressed frame since the last compaction
+  folly::io::Cursor snapshotCursor(snapshot.get());
+  replayTlvRecords(shard, snapshotCursor, true /* withChecksum */, newDatabase);
+  replayTlvRecords(shard, cursor, true /* withChecksum */, newDatabase);
+
+  for (auto& keyVal : newDatabase.keyVals) {
+    database_.keyVals[keyVal.first] = keyVal.second;
+  }
+  return folly::Unit();
+}
+
+void
+PersistentStore::replayTlvRecords(
+    StoreShard& shard,
+    folly::io::Cursor& cursor,
+    bool withChecksum,
+    thrift::StoreDatabase& newDatabase) noexcept {
   while (true) {
     // Read and decode into persistentObject
-    auto optionalObject = decodePersistentObject(cursor);
+    auto optionalObject = decodePersistentObject(cursor, withChecksum);
     if (optionalObject.hasError()) {
-      return folly::makeUnexpected(optionalObject.error());
+      // A torn or corrupted record invalidates the tail of the log, not the
+      // records replayed before it. Keep what we have instead of falling
+      // back to an empty database
+      LOG(ERROR) << "Encountered corrupted record in '" << shard.filePath
+                 << "'. Error: " << optionalObject.error()
+                 << ". Discarding log tail and keeping "
+                 << newDatabase.keyVals.size() << " keys replayed so far";
+      break;
     }
 
     // Read finish
@@ -320,14 +506,15 @@ PersistentStore::loadDatabaseTlvFormat(
       newDatabase.keyVals.erase(pObject.key);
     }
   }
-  database_ = std::move(newDatabase);
-  return folly::Unit();
 }
 
 // Write over or append IoBuf to disk atomically
 folly::Expected<folly::Unit, std::string>
 PersistentStore::writeIoBufToDisk(
-    const std::unique_ptr<folly::IOBuf>& ioBuf, WriteType writeType) noexcept {
+    const std::unique_ptr<folly::IOBuf>& ioBuf,
+    WriteType writeType,
+    const fs::path& filePath,
+    bool fsync) noexcept {
   std::string fileData("");
   try {
     ioBuf->coalesce();
@@ -335,14 +522,29 @@ PersistentStore::writeIoBufToDisk(
 
     if (writeType == WriteType::WRITE) {
       // Write over
-      folly::writeFileAtomic(storageFilePath_.c_str(), fileData, 0666);
+      folly::writeFileAtomic(filePath.c_str(), fileData, 0666);
+      // Make the compacted snapshot durable - the log entries it subsumes
+      // are gone after this point
+      if (fsync) {
+        folly::File file(filePath.c_str(), O_WRONLY);
+        if (folly::fsyncNoInt(file.fd()) != 0) {
+          return folly::makeUnexpected<std::string>(
+              folly::errnoStr(errno).toStdString());
+        }
+      }
     } else {
-      // Append to file
-      folly::writeFile(
-          fileData,
-          storageFilePath_.c_str(),
-          O_WRONLY | O_APPEND | O_CREAT,
-          0666);
+      // Append all batched log entries and make them durable with a single
+      // fsync - one flush per batch window regardless of how many
+      // store()/erase() calls got grouped into it
+      folly::File file(filePath.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0666);
+      if (folly::writeFull(file.fd(), fileData.data(), fileData.size()) < 0) {
+        return folly::makeUnexpected<std::string>(
+            folly::errnoStr(errno).toStdString());
+      }
+      if (fsync and folly::fsyncNoInt(file.fd()) != 0) {
+        return folly::makeUnexpected<std::string>(
+            folly::errnoStr(errno).toStdString());
+      }
     }
   } catch (std::exception const& e) {
     return folly::makeUnexpected<std::string>(
@@ -355,11 +557,12 @@ PersistentStore::writeIoBufToDisk(
 folly::Expected<std::unique_ptr<folly::IOBuf>, std::string>
 PersistentStore::encodePersistentObject(
     const PersistentObject& pObject) noexcept {
-  // Create buf with reserved size
+  // Create buf with reserved size, including the CRC32C trailer
   auto buf = folly::IOBuf::create(
       sizeof(uint8_t) + sizeof(uint32_t) + pObject.key.size() +
       sizeof(uint32_t) +
-      (pObject.data.has_value() ? pObject.data.value().size() : 0));
+      (pObject.data.has_value() ? pObject.data.value().size() : 0) +
+      sizeof(uint32_t));
 
   folly::io::Appender appender(buf.get(), 0);
   try {
@@ -377,6 +580,9 @@ PersistentStore::encodePersistentObject(
     } else {
       appender.writeBE<uint32_t>(0);
     }
+
+    // Append CRC32C of all preceding record bytes to buf
+    appender.writeBE<uint32_t>(folly::crc32c(buf->data(), buf->length()));
     return buf;
   } catch (const exception& e) {
     return folly::makeUnexpected<std::string>(
@@ -386,26 +592,43 @@ PersistentStore::encodePersistentObject(
 
 // A made up decoding of a PersistentObject.
 folly::Expected<std::optional<PersistentObject>, std::string>
-PersistentStore::decodePersistentObject(folly::io::Cursor& cursor) noexcept {
+PersistentStore::decodePersistentObject(
+    folly::io::Cursor& cursor, bool validateChecksum) noexcept {
   // If nothing can be read, return
   if (not cursor.canAdvance(1)) {
     return std::nullopt;
   }
 
+  // Remember where the record starts so its bytes can be checksummed
+  folly::io::Cursor recordStart(cursor);
+
   PersistentObject pObject;
   try {
     // Read 'type'
     pObject.type = ActionType(cursor.readBE<uint8_t>());
     // Read key length and key
-    auto length = cursor.readBE<uint32_t>();
-    pObject.key = cursor.readFixedString(length);
+    auto keyLength = cursor.readBE<uint32_t>();
+    pObject.key = cursor.readFixedString(keyLength);
 
     // Read data length and data
-    length = cursor.readBE<uint32_t>();
-    if (length == 0) {
-      return pObject;
+    auto dataLength = cursor.readBE<uint32_t>();
+    if (dataLength != 0) {
+      pObject.data = cursor.readFixedString(dataLength);
+    }
+
+    if (validateChecksum) {
+      // Compute CRC32C over the record bytes and compare with the trailer
+      const size_t recordLength =
+          sizeof(uint8_t) + 2 * sizeof(uint32_t) + keyLength + dataLength;
+      std::unique_ptr<folly::IOBuf> record;
+      recordStart.clone(record, recordLength);
+      record->coalesce();
+      const auto checksum = folly::crc32c(record->data(), record->length());
+      if (checksum != cursor.readBE<uint32_t>()) {
+        return folly::makeUnexpected<std::string>(folly::sformat(
+            "Checksum mismatch for record with key: {}", pObject.key));
+      }
     }
-    pObject.data = cursor.readFixedString(length);
     return pObject;
   } catch (std::out_of_range& e) {
     return folly::makeUnexpected<std::string>(
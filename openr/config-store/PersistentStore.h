@@ -8,6 +8,7 @@
 #pragma once
 
 #include <chrono>
+#include <map>
 #if __has_include("filesystem")
 #include <filesystem>
 namespace fs = std::filesystem;
@@ -24,11 +25,17 @@ namespace fs = std::experimental::filesystem;
 #include <openr/common/Constants.h>
 #include <openr/common/ExponentialBackoff.h>
 #include <openr/common/OpenrEventBase.h>
+#include <openr/common/ThriftUtil.h>
 #include <openr/common/Types.h>
 #include <openr/if/gen-cpp2/PersistentStore_types.h>
 
 namespace {
 constexpr folly::StringPiece kTlvFormatMarker{"TlvFormatMarker"};
+// Tlv format with a per-record CRC32C trailer for corruption detection
+constexpr folly::StringPiece kTlvCrcFormatMarker{"TlvCrcFormatMarker"};
+// Tlv format whose compacted snapshot is stored as a length-prefixed zstd
+// frame of CRC'd records. Delta appends behind the frame stay raw records
+constexpr folly::StringPiece kTlvZstdFormatMarker{"TlvZstdFormatMarker"};
 enum WriteType { APPEND = 1, WRITE = 2 };
 
 } // anonymous namespace
@@ -68,6 +75,20 @@ class PersistentStore : public OpenrEventBase {
   // Destructor will try to save DB to disk before destroying the object
   ~PersistentStore() override;
 
+  /**
+   * Register a shard for keys matching the given prefix. Keys are routed to
+   * the shard with the longest matching registered prefix; keys matching no
+   * shard live in the default database file. Each shard gets its own file
+   * (`<storageFilePath>.<keyPrefix>`), its own compaction threshold and its
+   * own fsync policy, so churn on one shard does not amplify I/O on stable
+   * state in another. Callers keep using the store()/storeThriftObj() APIs
+   * unchanged. Must be invoked before the event loop is started; the shard's
+   * file is loaded immediately and its records take precedence over stale
+   * copies read from the default file
+   */
+  void registerShard(
+      const std::string& keyPrefix, long dbFlushRatio, bool fsyncAppends);
+
   uint64_t
   getNumOfDbWritesToDisk() const {
     return numOfWritesToDisk_;
@@ -75,12 +96,14 @@ class PersistentStore : public OpenrEventBase {
 
   /**
    * Encode/Decode a PersistentObject, this can be private method, but for unit
-   * test, we make it public
+   * test, we make it public. Every encoded record carries a CRC32C trailer;
+   * decoding validates it unless reading the legacy checksum-less format
    */
   static folly::Expected<std::unique_ptr<folly::IOBuf>, std::string>
   encodePersistentObject(const PersistentObject& pObject) noexcept;
   static folly::Expected<std::optional<PersistentObject>, std::string>
-  decodePersistentObject(folly::io::Cursor& cursor) noexcept;
+  decodePersistentObject(
+      folly::io::Cursor& cursor, bool validateChecksum = true) noexcept;
 
   //
   // Public API
@@ -100,9 +123,10 @@ class PersistentStore : public OpenrEventBase {
   folly::SemiFuture<folly::Unit>
   storeThriftObj(std::string key, ThriftType const& value) noexcept {
     apache::thrift::CompactSerializer serializer;
-    std::string result;
-    serializer.serialize(value, &result);
-    return store(std::move(key), std::move(result));
+    // serialize straight into an IOBuf; the only copy left is into the
+    // std::string taken by the store() API
+    auto buf = writeThriftObj(value, serializer);
+    return store(std::move(key), buf->moveToFbString().toStdString());
   }
 
   // Utility function to load thrift objects
@@ -117,25 +141,72 @@ class PersistentStore : public OpenrEventBase {
             return folly::makeUnexpected(folly::Unit());
           }
           apache::thrift::CompactSerializer serializer;
-          ThriftType obj;
-          serializer.deserialize(*value.value(), obj);
-          return obj;
+          // wrap the stored payload instead of handing the deserializer
+          // a string it would wrap (and possibly copy) itself
+          const auto buf = folly::IOBuf::wrapBufferAsValue(
+              folly::StringPiece(value.value().value()));
+          return readThriftObj<ThriftType>(buf, serializer);
         });
   }
 
  private:
+  // Per-shard persistence state. Shards are independent append-logs with
+  // their own compaction cadence and durability policy
+  struct StoreShard {
+    // Location on disk where the shard's data is synced up
+    fs::path filePath;
+
+    // Objects appended since the last flush of this shard
+    std::vector<PersistentObject> pObjects;
+
+    // Number of delta batches appended since the last compaction
+    long numOfNewWrites{0};
+
+    // Compact the shard file after this many delta batches
+    long dbFlushRatio{0};
+
+    // Fsync delta appends. Compactions are always fsync'd
+    bool fsyncAppends{true};
+  };
+
   // Function to save/load `database_` to local disk. Returns true on success
-  // else false. Doesn't throw exception.
+  // else false. Doesn't throw exception. Saving compacts every shard;
+  // loading replays every shard file registered so far
   bool saveDatabaseToDisk() noexcept;
   bool loadDatabaseFromDisk() noexcept;
 
+  // Same as above for a single shard. Only keys owned by the shard get
+  // written to its file
+  bool saveShardToDisk(StoreShard& shard) noexcept;
+  bool loadShardFromDisk(StoreShard& shard) noexcept;
+
+  // Find the shard owning the given key (longest matching registered prefix)
+  StoreShard& getShardFor(const std::string& key);
+
   // Load old format file from disk, this is for compatible with the old version
   folly::Expected<folly::Unit, std::string> loadDatabaseOldFormat(
-      const std::unique_ptr<folly::IOBuf>& ioBuf) noexcept;
+      StoreShard& shard, const std::unique_ptr<folly::IOBuf>& ioBuf) noexcept;
 
-  // Load TlvFormat from disk
+  // Load TlvFormat from disk. withChecksum selects between the CRC32C
+  // format and the legacy checksum-less one
   folly::Expected<folly::Unit, std::string> loadDatabaseTlvFormat(
-      const std::unique_ptr<folly::IOBuf>& ioBuf) noexcept;
+      StoreShard& shard,
+      const std::unique_ptr<folly::IOBuf>& ioBuf,
+      bool withChecksum) noexcept;
+
+  // Load zstd format from disk: a compressed snapshot of CRC'd records,
+  // optionally followed by raw delta records appended since the last
+  // compaction
+  folly::Expected<folly::Unit, std::string> loadDatabaseZstdFormat(
+      StoreShard& shard, const std::unique_ptr<folly::IOBuf>& ioBuf) noexcept;
+
+  // Replay a stream of Tlv records into `newDatabase`. Stops at the end of
+  // the stream or at the first corrupted record, keeping what was replayed
+  void replayTlvRecords(
+      StoreShard& shard,
+      folly::io::Cursor& cursor,
+      bool withChecksum,
+      thrift::StoreDatabase& newDatabase) noexcept;
 
   // Wrapper function to save persistent object to disk immediately or later
   void maybeSaveObjectToDisk() noexcept;
@@ -145,7 +216,10 @@ class PersistentStore : public OpenrEventBase {
 
   // Write IoBuf ro local disk
   folly::Expected<folly::Unit, std::string> writeIoBufToDisk(
-      const std::unique_ptr<folly::IOBuf>& ioBuf, WriteType writeType) noexcept;
+      const std::unique_ptr<folly::IOBuf>& ioBuf,
+      WriteType writeType,
+      const fs::path& filePath,
+      bool fsync) noexcept;
 
   // Function to create a PersistentObject.
   PersistentObject toPersistentObject(
@@ -154,13 +228,15 @@ class PersistentStore : public OpenrEventBase {
   // Keeps track of number of writes of Database to disk
   std::atomic<std::uint64_t> numOfWritesToDisk_{0};
 
-  // Keeps track of number of writes of PersistentObject to disk
-  std::atomic<std::uint64_t> numOfNewWritesToDisk_{0};
-
   // Location on disk where data will be synced up. A file will be created
-  // if doesn't exists.
+  // if doesn't exists. Registered shards use this path with the key prefix
+  // as a suffix
   const fs::path storageFilePath_;
 
+  // Shards keyed by key prefix, in descending order so the longest matching
+  // prefix is found first. The default shard lives under ""
+  std::map<std::string, StoreShard, std::greater<std::string>> shards_;
+
   // Dryrun to avoid disk writes in UTs
   bool dryrun_{false};
 
@@ -175,9 +251,6 @@ class PersistentStore : public OpenrEventBase {
 
   // Serializer for encoding/decoding of thrift objects
   apache::thrift::CompactSerializer serializer_;
-
-  // Define a persistent object
-  std::vector<PersistentObject> pObjects_;
 };
 
 } // namespace openr
@@ -32,8 +32,8 @@ loadDatabaseFromDisk(const std::string& filePath) {
   auto ioBuf = folly::IOBuf::wrapBuffer(fileData.c_str(), fileData.size());
   folly::io::Cursor cursor(ioBuf.get());
 
-  // Read 'kTlvFormatMarker'
-  cursor.readFixedString(kTlvFormatMarker.size());
+  // Read 'kTlvCrcFormatMarker'
+  cursor.readFixedString(kTlvCrcFormatMarker.size());
   // Iteratively read persistentObject from disk
   while (true) {
     auto optionalObject = PersistentStore::decodePersistentObject(cursor);
@@ -182,6 +182,53 @@ TEST(PersistentStoreTest, EncodeDecodePersistentObject) {
   EXPECT_EQ(false, pObjectGetDel.data.has_value());
 }
 
+TEST(PersistentStoreTest, ShardedStoreLoad) {
+  fbzmq::Context context;
+  const auto tid = std::hash<std::thread::id>()(std::this_thread::get_id());
+
+  std::string filePath;
+  {
+    PersistentStoreWrapper store(context, tid);
+    filePath = store.filePath;
+    store->registerShard(
+        "link-", 1000 /* dbFlushRatio */, false /* fsyncAppends */);
+    store.run();
+
+    store->store("link-metric", "10").get();
+    store->store("prefix-alloc", "face:b00c").get();
+
+    // Stop & destroy store, compacting each shard into its own file
+  }
+
+  // Shard keys land in the shard's file, others in the default file
+  auto defaultDb = loadDatabaseFromDisk(filePath);
+  auto shardDb = loadDatabaseFromDisk(filePath + ".link-");
+  EXPECT_EQ(1, defaultDb.keyVals.count("prefix-alloc"));
+  EXPECT_EQ(0, defaultDb.keyVals.count("link-metric"));
+  EXPECT_EQ(1, shardDb.keyVals.count("link-metric"));
+  EXPECT_EQ(0, shardDb.keyVals.count("prefix-alloc"));
+
+  // Re-create the store and verify content of both shards is recovered
+  {
+    PersistentStoreWrapper store(context, tid);
+    store->registerShard(
+        "link-", 1000 /* dbFlushRatio */, false /* fsyncAppends */);
+    store.run();
+
+    auto responseLoadMetric = store->load("link-metric").get();
+    EXPECT_TRUE(responseLoadMetric);
+    EXPECT_EQ("10", *responseLoadMetric);
+
+    auto responseLoadPrefix = store->load("prefix-alloc").get();
+    EXPECT_TRUE(responseLoadPrefix);
+    EXPECT_EQ("face:b00c", *responseLoadPrefix);
+
+    // Erase keys before we end the test
+    store->erase("link-metric").get();
+    store->erase("prefix-alloc").get();
+  }
+}
+
 TEST(PersistentStoreTest, BulkStoreLoad) {
   fbzmq::Context context;
   const auto tid = std::hash<std::thread::id>()(std::this_thread::get_id());
@@ -218,6 +265,66 @@ TEST(PersistentStoreTest, BulkStoreLoad) {
   }
 }
 
+TEST(PersistentStoreTest, CompressedSnapshotLoad) {
+  fbzmq::Context context;
+  const auto tid = std::hash<std::thread::id>()(std::this_thread::get_id());
+
+  thrift::StoreDatabase database;
+  std::string filePath;
+  {
+    PersistentStoreWrapper store(context, tid);
+    store.run();
+    filePath = store.filePath;
+
+    // Store enough data to push the compacted snapshot over the
+    // compression threshold
+    for (auto index = 0; index < 100; index++) {
+      const std::pair<std::string, std::string> tmpKeyVal{
+          folly::sformat("key-{}", index),
+          std::string(128, 'a' + index % 26)};
+      database.keyVals[tmpKeyVal.first] = tmpKeyVal.second;
+      auto responseStoreTmpKey =
+          store->store(tmpKeyVal.first, tmpKeyVal.second).get();
+      EXPECT_EQ(folly::Unit(), responseStoreTmpKey);
+    }
+
+    // Stop & destroy store, compacting into a compressed snapshot
+  }
+
+  // The compacted file is a zstd snapshot, much smaller than its records
+  std::string fileData("");
+  ASSERT_TRUE(folly::readFile(filePath.c_str(), fileData));
+  EXPECT_TRUE(folly::StringPiece(fileData).startsWith(kTlvZstdFormatMarker));
+  EXPECT_LT(fileData.size(), 100 * 128);
+
+  // Append a raw delta record behind the compressed snapshot, like the
+  // store does for writes between compactions
+  PersistentObject pObject;
+  pObject.type = ActionType::ADD;
+  pObject.key = "extra-key";
+  pObject.data = "extra-val";
+  auto buf = PersistentStore::encodePersistentObject(pObject);
+  ASSERT_FALSE(buf.hasError());
+  fileData.append(
+      reinterpret_cast<const char*>((*buf)->data()), (*buf)->length());
+  ASSERT_TRUE(folly::writeFile(fileData, filePath.c_str()));
+
+  // Re-create the store and verify both snapshot and delta content
+  {
+    PersistentStoreWrapper store(context, tid);
+    store.run();
+
+    for (auto& keyVal : database.keyVals) {
+      auto responseLoad = store->load(keyVal.first).get();
+      ASSERT_TRUE(responseLoad);
+      EXPECT_EQ(keyVal.second, *responseLoad);
+    }
+    auto responseLoadExtra = store->load("extra-key").get();
+    ASSERT_TRUE(responseLoadExtra);
+    EXPECT_EQ("extra-val", *responseLoadExtra);
+  }
+}
+
 } // namespace openr
 
 int
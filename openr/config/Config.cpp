@@ -45,6 +45,48 @@ Config::getRunningConfig() const {
   return contents;
 }
 
+std::optional<thrift::ThreadConfig>
+Config::getThreadConfig(const std::string& threadName) const {
+  auto it = threadConfigs_.find(threadName);
+  if (it != threadConfigs_.end()) {
+    return it->second;
+  }
+  return std::nullopt;
+}
+
+bool
+Config::applyUpdate(thrift::OpenrConfig newConfig) {
+  if (config_ == newConfig) {
+    return true; // nothing changed
+  }
+
+  // validate and compile the candidate in full; throws on bad input
+  Config updated(std::move(newConfig));
+
+  // Classify the diff. Overlay the dynamic knobs of the candidate onto the
+  // running config; any remaining difference is immutable - modules copy
+  // those values at construction - and needs a restart to take effect.
+  auto overlaid = config_;
+  auto& lmConf = overlaid.link_monitor_config;
+  const auto& newLmConf = updated.config_.link_monitor_config;
+  lmConf.include_interface_regexes = newLmConf.include_interface_regexes;
+  lmConf.exclude_interface_regexes = newLmConf.exclude_interface_regexes;
+  lmConf.redistribute_interface_regexes =
+      newLmConf.redistribute_interface_regexes;
+  if (not(overlaid == updated.config_)) {
+    return false;
+  }
+
+  // publish the already-compiled regex sets; getters hand out shared_ptr
+  // copies via atomic loads, so in-flight matches keep the old sets alive
+  std::atomic_store(&includeItfRegexes_, std::move(updated.includeItfRegexes_));
+  std::atomic_store(&excludeItfRegexes_, std::move(updated.excludeItfRegexes_));
+  std::atomic_store(
+      &redistributeItfRegexes_, std::move(updated.redistributeItfRegexes_));
+  config_ = std::move(overlaid);
+  return true;
+}
+
 PrefixAllocationParams
 Config::createPrefixAllocationParams(
     const std::string& seedPfxStr, uint8_t allocationPfxLen) {
@@ -125,6 +167,7 @@ Config::populateInternalDb() {
   // Kvstore
   //
   const auto& kvConf = config_.kvstore_config;
+  kvStoreKeyTtl_ = std::chrono::milliseconds(kvConf.key_ttl_ms);
   if (const auto& floodRate = kvConf.flood_rate_ref()) {
     if (floodRate->flood_msg_per_sec <= 0) {
       throw std::out_of_range("kvstore flood_msg_per_sec should be > 0");
@@ -271,6 +314,60 @@ Config::populateInternalDb() {
         "enable_bgp_peering = true, but bgp_config is empty");
   }
 
+  //
+  // decision failure precompute
+  //
+  if (const auto& topK = config_.failure_precompute_top_k_ref()) {
+    if (*topK <= 0) {
+      throw std::out_of_range(folly::sformat(
+          "failure_precompute_top_k ({}) should be > 0", *topK));
+    }
+  }
+
+  //
+  // thread topology
+  //
+  if (const auto& threadConfigs = config_.thread_configs_ref()) {
+    for (const auto& threadConfig : *threadConfigs) {
+      if (threadConfig.sched_policy != "other" and
+          threadConfig.sched_policy != "rr" and
+          threadConfig.sched_policy != "fifo") {
+        throw std::invalid_argument(folly::sformat(
+            "invalid sched_policy '{}' for thread {}",
+            threadConfig.sched_policy,
+            threadConfig.thread_name));
+      }
+      if (threadConfig.sched_policy != "other" and
+          (threadConfig.sched_priority < 1 or
+           threadConfig.sched_priority > 99)) {
+        throw std::out_of_range(folly::sformat(
+            "sched_priority ({}) for thread {} should be in [1, 99]",
+            threadConfig.sched_priority,
+            threadConfig.thread_name));
+      }
+      for (const auto cpu : threadConfig.cpu_affinity) {
+        if (cpu < 0) {
+          throw std::out_of_range(folly::sformat(
+              "invalid cpu id ({}) in affinity for thread {}",
+              cpu,
+              threadConfig.thread_name));
+        }
+      }
+      if (threadConfig.numa_node < -1) {
+        throw std::out_of_range(folly::sformat(
+            "invalid numa_node ({}) for thread {}",
+            threadConfig.numa_node,
+            threadConfig.thread_name));
+      }
+      if (not threadConfigs_.emplace(threadConfig.thread_name, threadConfig)
+                  .second) {
+        throw std::invalid_argument(folly::sformat(
+            "Duplicate thread config: thread_name {}",
+            threadConfig.thread_name));
+      }
+    }
+  }
+
   //
   // watchdog
   //
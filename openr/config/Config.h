@@ -7,6 +7,9 @@
 
 #pragma once
 
+#include <memory>
+#include <optional>
+
 #include <folly/IPAddress.h>
 #include <re2/re2.h>
 #include <re2/set.h>
@@ -37,6 +40,19 @@ class Config {
   }
   std::string getRunningConfig() const;
 
+  /*
+   * apply a reloaded config to the running process without a restart.
+   *
+   * The candidate is validated in full first and throws just like the
+   * constructors do. Knobs that modules consult through this object at
+   * runtime - today the link-monitor interface regexes - are applied in
+   * place; the regex getters hand out the new sets via atomic loads, so
+   * in-flight matches keep the old sets alive. Any other change is left
+   * untouched and false is returned, signalling that a restart is
+   * required to apply it. Must be invoked from a single thread.
+   */
+  bool applyUpdate(thrift::OpenrConfig newConfig);
+
   const std::string&
   getNodeName() const {
     return config_.node_name;
@@ -97,7 +113,7 @@ class Config {
 
   std::chrono::milliseconds
   getKvStoreKeyTtl() const {
-    return std::chrono::milliseconds(config_.kvstore_config.key_ttl_ms);
+    return kvStoreKeyTtl_;
   }
 
   bool
@@ -115,17 +131,17 @@ class Config {
 
   std::shared_ptr<const re2::RE2::Set>
   getIncludeItfRegexes() const {
-    return includeItfRegexes_;
+    return std::atomic_load(&includeItfRegexes_);
   }
 
   std::shared_ptr<const re2::RE2::Set>
   getExcludeItfRegexes() const {
-    return excludeItfRegexes_;
+    return std::atomic_load(&excludeItfRegexes_);
   }
 
   std::shared_ptr<const re2::RE2::Set>
   getRedistributeItfRegexes() const {
-    return redistributeItfRegexes_;
+    return std::atomic_load(&redistributeItfRegexes_);
   }
 
   //
@@ -142,12 +158,27 @@ class Config {
     return *config_.prefix_allocation_config_ref();
   }
 
-  PrefixAllocationParams
+  const PrefixAllocationParams&
   getPrefixAllocationParams() const {
     CHECK(isPrefixAllocationEnabled());
     return *prefixAllocationParams_;
   }
 
+  //
+  // prefix aggregation
+  //
+  bool
+  isPrefixAggregationEnabled() const {
+    return config_.enable_prefix_aggregation_ref().value_or(false) and
+        config_.prefix_aggregation_config_ref().has_value();
+  }
+
+  const thrift::PrefixAggregationConfig&
+  getPrefixAggregationConfig() const {
+    CHECK(isPrefixAggregationEnabled());
+    return *config_.prefix_aggregation_config_ref();
+  }
+
   //
   // bgp peering
   //
@@ -162,6 +193,39 @@ class Config {
     return *config_.bgp_config_ref();
   }
 
+  //
+  // event capture
+  //
+  std::optional<std::string>
+  getEventCaptureDir() const {
+    if (const auto& dir = config_.event_capture_dir_ref()) {
+      return *dir;
+    }
+    return std::nullopt;
+  }
+
+  //
+  // decision failure precompute
+  //
+  bool
+  isFailurePrecomputeEnabled() const {
+    return config_.enable_failure_precompute_ref().value_or(false);
+  }
+
+  // number of single-link failure scenarios kept precomputed
+  size_t
+  getFailurePrecomputeTopK() const {
+    return config_.failure_precompute_top_k_ref().value_or(8);
+  }
+
+  //
+  // thread topology
+  //
+
+  // scheduling knobs for the named module thread, if configured
+  std::optional<thrift::ThreadConfig> getThreadConfig(
+      const std::string& threadName) const;
+
   //
   // watch dog
   //
@@ -180,13 +244,22 @@ class Config {
   void populateInternalDb();
   // thrift config
   thrift::OpenrConfig config_;
+
+  // Artifacts derived from config_, computed once in populateInternalDb()
+  // so every accessor above is a plain field read. A reloaded config (see
+  // applyUpdate) recomputes them on its candidate Config before anything
+  // is published.
   std::unordered_set<std::string> areaIds_;
+  // kvstore key TTL, parsed from key_ttl_ms
+  std::chrono::milliseconds kvStoreKeyTtl_{0};
   // link monitor regexes
   std::shared_ptr<re2::RE2::Set> includeItfRegexes_{nullptr};
   std::shared_ptr<re2::RE2::Set> excludeItfRegexes_{nullptr};
   std::shared_ptr<re2::RE2::Set> redistributeItfRegexes_{nullptr};
   // prefix allocation
   folly::Optional<PrefixAllocationParams> prefixAllocationParams_{folly::none};
+  // per-thread scheduling knobs keyed by thread name
+  std::unordered_map<std::string, thrift::ThreadConfig> threadConfigs_;
 };
 
 } // namespace openr
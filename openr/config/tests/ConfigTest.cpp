@@ -190,6 +190,77 @@ TEST(ConfigTest, PopulateInternalDb) {
     EXPECT_THROW(new Config(confInvalidFloodMsgPerSec), std::out_of_range);
   }
 
+  // failure precompute
+
+  // failure_precompute_top_k <= 0
+  {
+    auto confInvalidTopK = getBasicOpenrConfig();
+    confInvalidTopK.failure_precompute_top_k_ref() = 0;
+    EXPECT_THROW(new Config(confInvalidTopK), std::out_of_range);
+  }
+
+  // thread topology
+
+  // invalid sched_policy
+  {
+    auto confInvalidThread = getBasicOpenrConfig();
+    thrift::ThreadConfig threadConfig;
+    threadConfig.thread_name = "Spark";
+    threadConfig.sched_policy = "batch";
+    confInvalidThread.thread_configs_ref() = {threadConfig};
+    EXPECT_THROW(new Config(confInvalidThread), std::invalid_argument);
+  }
+  // realtime priority out of range
+  {
+    auto confInvalidThread = getBasicOpenrConfig();
+    thrift::ThreadConfig threadConfig;
+    threadConfig.thread_name = "Spark";
+    threadConfig.sched_policy = "rr";
+    threadConfig.sched_priority = 100;
+    confInvalidThread.thread_configs_ref() = {threadConfig};
+    EXPECT_THROW(new Config(confInvalidThread), std::out_of_range);
+  }
+  // negative cpu id
+  {
+    auto confInvalidThread = getBasicOpenrConfig();
+    thrift::ThreadConfig threadConfig;
+    threadConfig.thread_name = "KvStore";
+    threadConfig.cpu_affinity = {-1};
+    confInvalidThread.thread_configs_ref() = {threadConfig};
+    EXPECT_THROW(new Config(confInvalidThread), std::out_of_range);
+  }
+  // invalid numa node
+  {
+    auto confInvalidThread = getBasicOpenrConfig();
+    thrift::ThreadConfig threadConfig;
+    threadConfig.thread_name = "KvStore";
+    threadConfig.numa_node = -2;
+    confInvalidThread.thread_configs_ref() = {threadConfig};
+    EXPECT_THROW(new Config(confInvalidThread), std::out_of_range);
+  }
+  // duplicate thread name
+  {
+    auto confInvalidThread = getBasicOpenrConfig();
+    thrift::ThreadConfig threadConfig;
+    threadConfig.thread_name = "Spark";
+    confInvalidThread.thread_configs_ref() = {threadConfig, threadConfig};
+    EXPECT_THROW(new Config(confInvalidThread), std::invalid_argument);
+  }
+  // valid entry is retrievable by thread name
+  {
+    auto conf = getBasicOpenrConfig();
+    thrift::ThreadConfig threadConfig;
+    threadConfig.thread_name = "Spark";
+    threadConfig.sched_policy = "rr";
+    threadConfig.sched_priority = 50;
+    threadConfig.cpu_affinity = {0, 1};
+    conf.thread_configs_ref() = {threadConfig};
+    auto config = Config(conf);
+    ASSERT_TRUE(config.getThreadConfig("Spark").has_value());
+    EXPECT_EQ(threadConfig, config.getThreadConfig("Spark").value());
+    EXPECT_FALSE(config.getThreadConfig("KvStore").has_value());
+  }
+
   // link monitor
 
   // linkflap_initial_backoff_ms < 0
@@ -439,6 +510,46 @@ TEST(ConfigTest, LinkMonitorGetter) {
   }
 }
 
+TEST(ConfigTest, ApplyUpdate) {
+  auto tConfig = getBasicOpenrConfig();
+  tConfig.link_monitor_config = getTestLinkMonitorConfig();
+  auto config = Config(tConfig);
+
+  // identical config is a no-op
+  EXPECT_TRUE(config.applyUpdate(tConfig));
+
+  // regex change is dynamic and visible through the getters
+  {
+    auto updated = tConfig;
+    updated.link_monitor_config.include_interface_regexes = {"port.*"};
+    EXPECT_TRUE(config.applyUpdate(updated));
+
+    std::vector<int> matches;
+    auto includeItfRegexes = config.getIncludeItfRegexes();
+    EXPECT_TRUE(includeItfRegexes->Match("port1", &matches));
+    EXPECT_FALSE(includeItfRegexes->Match("fboss10", &matches));
+    EXPECT_EQ(updated, config.getConfig());
+    tConfig = updated;
+  }
+
+  // immutable change is rejected and leaves the running config untouched
+  {
+    auto updated = tConfig;
+    updated.node_name = "someone-else";
+    EXPECT_FALSE(config.applyUpdate(updated));
+    EXPECT_EQ(tConfig, config.getConfig());
+  }
+
+  // invalid candidate throws, like construction does
+  {
+    auto updated = tConfig;
+    updated.kvstore_config.flood_rate_ref() = getFloodRate();
+    updated.kvstore_config.flood_rate_ref()->flood_msg_per_sec = 0;
+    EXPECT_THROW(config.applyUpdate(updated), std::out_of_range);
+    EXPECT_EQ(tConfig, config.getConfig());
+  }
+}
+
 TEST(ConfigTest, PrefixAllocatorGetter) {
   auto tConfig = getBasicOpenrConfig();
   tConfig.enable_prefix_allocation_ref() = true;
@@ -42,6 +42,7 @@ OpenrCtrlHandler::OpenrCtrlHandler(
     : facebook::fb303::BaseService("openr"),
       nodeName_(nodeName),
       acceptablePeerCommonNames_(acceptablePeerCommonNames),
+      ctrlEvb_(ctrlEvb),
       decision_(decision),
       fib_(fib),
       kvStore_(kvStore),
@@ -49,9 +50,21 @@ OpenrCtrlHandler::OpenrCtrlHandler(
       configStore_(configStore),
       prefixManager_(prefixManager),
       config_(config) {
-  // Create monitor client
+  // Create monitor client and the async event-log submitter wrapping it
   zmqMonitorClient_ =
-      std::make_unique<fbzmq::ZmqMonitorClient>(context, monitorSubmitUrl);
+      std::make_shared<fbzmq::ZmqMonitorClient>(context, monitorSubmitUrl);
+  eventLogger_ = std::make_unique<EventLogger>(zmqMonitorClient_);
+
+  // Create CPU pool serving expensive read-only dump requests off the
+  // module event-bases
+  dumpExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+      2 /* num threads */,
+      std::make_shared<folly::NamedThreadFactory>("OpenrCtrlDump"));
+
+  // Create timer driving counter delta pushes. Armed only while counters
+  // subscribers exist
+  countersStreamTimer_ = folly::AsyncTimeout::make(
+      *ctrlEvb->getEvb(), [this]() noexcept { pushCounterUpdates(); });
 
   // Add fiber task to receive publication from KvStore
   if (kvStore_) {
@@ -69,8 +82,14 @@ OpenrCtrlHandler::OpenrCtrlHandler(
         }
 
         SYNCHRONIZED(kvStorePublishers_) {
+          // Filtered views of the publication are computed once per
+          // distinct filter signature and shared across subscribers
+          std::unordered_map<
+              std::string,
+              std::shared_ptr<const thrift::Publication>>
+              pubCache;
           for (auto& kv : kvStorePublishers_) {
-            kv.second.next(maybePublication.value());
+            kv.second.publish(maybePublication.value(), pubCache);
           }
         }
 
@@ -86,7 +105,7 @@ OpenrCtrlHandler::OpenrCtrlHandler(
           }
 
           // "adj:*" key has changed. Update local collection
-          if (key.find(Constants::kAdjDbMarker.toString()) == 0) {
+          if (isKeyForMarker(key, Constants::kAdjDbMarker)) {
             VLOG(3) << "Adj key: " << key << " change received";
             isAdjChanged = true;
             break;
@@ -144,7 +163,7 @@ OpenrCtrlHandler::~OpenrCtrlHandler() {
   // SYNCHRONIZED block
   SYNCHRONIZED(kvStorePublishers_) {
     for (auto& kv : kvStorePublishers_) {
-      publishers.emplace_back(std::move(kv.second));
+      publishers.emplace_back(std::move(kv.second.publisher));
     }
   }
   LOG(INFO) << "Terminating " << publishers.size()
@@ -153,6 +172,20 @@ OpenrCtrlHandler::~OpenrCtrlHandler() {
     std::move(publisher).complete();
   }
 
+  // Same dance for counters subscription streams
+  std::vector<apache::thrift::ServerStreamPublisher<thrift::CounterUpdate>>
+      counterPublishers;
+  SYNCHRONIZED(countersPublishers_) {
+    for (auto& kv : countersPublishers_) {
+      counterPublishers.emplace_back(std::move(kv.second.publisher));
+    }
+  }
+  LOG(INFO) << "Terminating " << counterPublishers.size()
+            << " active counters stream(s).";
+  for (auto& publisher : counterPublishers) {
+    std::move(publisher).complete();
+  }
+
   LOG(INFO) << "Cleanup all pending request(s).";
   longPollReqs_.withWLock([&](auto& longPollReqs) { longPollReqs.clear(); });
 
@@ -185,7 +218,7 @@ OpenrCtrlHandler::authorizeConnection() {
         "peer_address", connContext->getPeerAddress()->getAddressStr());
     sample.addString("peer_common_name", peerCommonName);
 
-    zmqMonitorClient_->addEventLog(fbzmq::thrift::EventLog(
+    eventLogger_->log(fbzmq::thrift::EventLog(
         apache::thrift::FRAGILE,
         Constants::kEventLogCategory.toString(),
         {sample.toJson()}));
@@ -373,6 +406,56 @@ OpenrCtrlHandler::semifuture_getRouteDb() {
   return fib_->getRouteDb();
 }
 
+folly::SemiFuture<std::unique_ptr<thrift::RouteDatabasePage>>
+OpenrCtrlHandler::semifuture_getRouteDbPaginated(
+    std::unique_ptr<std::string> cursor, int32_t maxRoutes) {
+  CHECK(fib_);
+  return fib_->getRouteDbPaginated(std::move(*cursor), maxRoutes);
+}
+
+apache::thrift::ServerStream<thrift::RouteDatabasePage>
+OpenrCtrlHandler::streamRouteDb(int32_t maxChunkSize) {
+  CHECK(fib_);
+  auto streamAndPublisher =
+      apache::thrift::ServerStream<thrift::RouteDatabasePage>::createPublisher(
+          []() {});
+  publishRouteDbPages(
+      std::make_shared<
+          apache::thrift::ServerStreamPublisher<thrift::RouteDatabasePage>>(
+          std::move(streamAndPublisher.second)),
+      "",
+      maxChunkSize);
+  return std::move(streamAndPublisher.first);
+}
+
+void
+OpenrCtrlHandler::publishRouteDbPages(
+    std::shared_ptr<
+        apache::thrift::ServerStreamPublisher<thrift::RouteDatabasePage>>
+        publisher,
+    std::string cursor,
+    int32_t maxChunkSize) noexcept {
+  // Produce one page at a time - the next page is only requested after the
+  // previous one has been handed to the stream, so no more than one page
+  // worth of thrift routes is alive at any moment
+  fib_->getRouteDbPaginated(std::move(cursor), maxChunkSize)
+      .via(ctrlEvb_->getEvb())
+      .thenValue([this, publisher, maxChunkSize](
+                     std::unique_ptr<thrift::RouteDatabasePage>&& page) {
+        std::optional<std::string> nextCursor;
+        if (page->nextCursor_ref().has_value()) {
+          nextCursor = page->nextCursor_ref().value();
+        }
+        publisher->next(std::move(*page));
+        if (nextCursor.has_value()) {
+          publishRouteDbPages(
+              publisher, std::move(nextCursor).value(), maxChunkSize);
+        } else {
+          std::move(*publisher).complete();
+        }
+      });
+}
+
 folly::SemiFuture<std::unique_ptr<std::vector<thrift::UnicastRoute>>>
 OpenrCtrlHandler::semifuture_getUnicastRoutesFiltered(
     std::unique_ptr<std::vector<std::string>> prefixes) {
@@ -419,13 +502,25 @@ OpenrCtrlHandler::semifuture_getRouteDbComputed(
 folly::SemiFuture<std::unique_ptr<thrift::AdjDbs>>
 OpenrCtrlHandler::semifuture_getDecisionAdjacencyDbs() {
   CHECK(decision_);
-  return decision_->getDecisionAdjacencyDbs();
+  // expand the shared copy-on-write snapshot on the dump pool - neither
+  // the Decision loop nor a thrift IO thread pays for the copy
+  return decision_->getDecisionAdjacencyDbsSnapshot()
+      .via(dumpExecutor_.get())
+      .thenValue([](std::shared_ptr<thrift::AdjDbs const>&& snapshot) {
+        return std::make_unique<thrift::AdjDbs>(*snapshot);
+      })
+      .semi();
 }
 
 folly::SemiFuture<std::unique_ptr<thrift::PrefixDbs>>
 OpenrCtrlHandler::semifuture_getDecisionPrefixDbs() {
   CHECK(decision_);
-  return decision_->getDecisionPrefixDbs();
+  return decision_->getDecisionPrefixDbsSnapshot()
+      .via(dumpExecutor_.get())
+      .thenValue([](std::shared_ptr<thrift::PrefixDbs const>&& snapshot) {
+        return std::make_unique<thrift::PrefixDbs>(*snapshot);
+      })
+      .semi();
 }
 
 //
@@ -488,6 +583,13 @@ OpenrCtrlHandler::semifuture_getKvStoreHashFilteredArea(
   return kvStore_->dumpKvStoreHashes(std::move(*filter), std::move(*area));
 }
 
+folly::SemiFuture<std::unique_ptr<std::vector<thrift::FloodTraceRecord>>>
+OpenrCtrlHandler::semifuture_getKvStoreFloodTraces(
+    std::unique_ptr<std::string> area) {
+  CHECK(kvStore_);
+  return kvStore_->getFloodTraces(std::move(*area));
+}
+
 folly::SemiFuture<folly::Unit>
 OpenrCtrlHandler::semifuture_setKvStoreKeyVals(
     std::unique_ptr<thrift::KeySetParams> setParams,
@@ -511,7 +613,7 @@ OpenrCtrlHandler::semifuture_longPollKvStoreAdj(
   // to ensure KvStore ONLY compare "adj:" key
   thrift::KeyVals adjKeyVals;
   for (auto& kv : *snapshot) {
-    if (kv.first.find(Constants::kAdjDbMarker.toString()) == 0) {
+    if (isKeyForMarker(kv.first, Constants::kAdjDbMarker)) {
       adjKeyVals.emplace(kv.first, kv.second);
     }
   }
@@ -590,8 +692,74 @@ OpenrCtrlHandler::semifuture_getKvStorePeersArea(
   return kvStore_->getKvStorePeers(std::move(*area));
 }
 
+void
+OpenrCtrlHandler::KvStoreStreamPublisher::publish(
+    thrift::Publication const& pub,
+    std::unordered_map<std::string, std::shared_ptr<const thrift::Publication>>&
+        pubCache) {
+  // Unfiltered subscription - push publication as is
+  if (not filters and areas.empty()) {
+    publisher.next(pub);
+    return;
+  }
+
+  // Materialize the filtered view at most once per filter signature;
+  // subsequent subscribers with the same signature reuse it
+  auto it = pubCache.find(filterSignature);
+  if (it == pubCache.end()) {
+    it = pubCache.emplace(filterSignature, filterPublication(pub)).first;
+  }
+  if (it->second) {
+    publisher.next(*it->second);
+  }
+}
+
+std::shared_ptr<const thrift::Publication>
+OpenrCtrlHandler::KvStoreStreamPublisher::filterPublication(
+    thrift::Publication const& pub) const {
+  // Drop publications from unsubscribed areas
+  if (not areas.empty() and
+      (not pub.area_ref().has_value() or
+       areas.count(pub.area_ref().value()) == 0)) {
+    return nullptr;
+  }
+  if (not filters) {
+    return std::make_shared<const thrift::Publication>(pub);
+  }
+
+  // Narrow the publication down to matching content. Clients with no
+  // matching content don't cost any serialization or egress
+  thrift::Publication filtered;
+  for (auto& kv : pub.keyVals) {
+    if (filters->keyMatch(kv.first, kv.second)) {
+      filtered.keyVals.emplace(kv.first, kv.second);
+    }
+  }
+  for (auto& key : pub.expiredKeys) {
+    if (filters->keyPrefixMatch(key)) {
+      filtered.expiredKeys.emplace_back(key);
+    }
+  }
+  if (filtered.keyVals.empty() and filtered.expiredKeys.empty()) {
+    return nullptr;
+  }
+  if (pub.area_ref().has_value()) {
+    filtered.area_ref() = pub.area_ref().value();
+  }
+  return std::make_shared<const thrift::Publication>(std::move(filtered));
+}
+
 apache::thrift::ServerStream<thrift::Publication>
 OpenrCtrlHandler::subscribeKvStore() {
+  return subscribeKvStoreFiltered(
+      std::make_unique<thrift::KeyDumpParams>(),
+      std::make_unique<std::set<std::string>>());
+}
+
+apache::thrift::ServerStream<thrift::Publication>
+OpenrCtrlHandler::subscribeKvStoreFiltered(
+    std::unique_ptr<thrift::KeyDumpParams> filter,
+    std::unique_ptr<std::set<std::string>> areas) {
   // Get new client-ID (monotonically increasing)
   auto clientToken = publisherToken_++;
 
@@ -609,15 +777,119 @@ OpenrCtrlHandler::subscribeKvStore() {
             }
           });
 
+  // Build server-side filters. Empty params means no key-val filtering
+  std::unique_ptr<KvStoreFilters> kvFilters{nullptr};
+  std::vector<std::string> keyPrefixList;
+  folly::split(",", filter->prefix, keyPrefixList, true);
+  if (not keyPrefixList.empty() or not filter->originatorIds.empty()) {
+    kvFilters =
+        std::make_unique<KvStoreFilters>(keyPrefixList, filter->originatorIds);
+  }
+
+  // Subscribers with identical filters share one filtered publication
+  // object per update
+  auto filterSignature = folly::sformat(
+      "{}|{}", kvFilters ? kvFilters->str() : "", folly::join(",", *areas));
+
   SYNCHRONIZED(kvStorePublishers_) {
     assert(kvStorePublishers_.count(clientToken) == 0);
     LOG(INFO) << "KvStore snoop stream-" << clientToken << " started.";
     kvStorePublishers_.emplace(
-        clientToken, std::move(streamAndPublisher.second));
+        clientToken,
+        KvStoreStreamPublisher{std::move(kvFilters),
+                               std::move(*areas),
+                               std::move(filterSignature),
+                               std::move(streamAndPublisher.second)});
   }
   return std::move(streamAndPublisher.first);
 }
 
+apache::thrift::ServerStream<thrift::CounterUpdate>
+OpenrCtrlHandler::subscribeCounters(int64_t intervalMs) {
+  // Get new client-ID (monotonically increasing)
+  auto clientToken = publisherToken_++;
+  const auto interval =
+      std::chrono::milliseconds(std::max<int64_t>(intervalMs, 1000));
+
+  auto streamAndPublisher =
+      apache::thrift::ServerStream<thrift::CounterUpdate>::createPublisher(
+          [this, clientToken]() {
+            SYNCHRONIZED(countersPublishers_) {
+              if (countersPublishers_.erase(clientToken)) {
+                LOG(INFO) << "Counters stream-" << clientToken << " ended.";
+              } else {
+                LOG(ERROR) << "Can't remove unknown counters stream-"
+                           << clientToken;
+              }
+            }
+          });
+
+  SYNCHRONIZED(countersPublishers_) {
+    assert(countersPublishers_.count(clientToken) == 0);
+    LOG(INFO) << "Counters stream-" << clientToken << " started.";
+    countersPublishers_.emplace(
+        clientToken,
+        CountersStreamPublisher{interval,
+                                std::move(streamAndPublisher.second)});
+  }
+
+  // (Re)arm the push timer at the smallest requested cadence
+  ctrlEvb_->getEvb()->runInEventBaseThread(
+      [this]() { scheduleCountersTimer(); });
+  return std::move(streamAndPublisher.first);
+}
+
+void
+OpenrCtrlHandler::pushCounterUpdates() noexcept {
+  // Materialize and diff the counter map once for all subscribers
+  std::map<std::string, int64_t> counters;
+  getCounters(counters);
+
+  thrift::CounterUpdate update;
+  for (auto const& kv : counters) {
+    auto it = lastCounterSnapshot_.find(kv.first);
+    if (it == lastCounterSnapshot_.end() or it->second != kv.second) {
+      update.changedCounters.emplace(kv);
+    }
+  }
+  for (auto const& kv : lastCounterSnapshot_) {
+    if (counters.count(kv.first) == 0) {
+      update.removedCounters.emplace_back(kv.first);
+    }
+  }
+  lastCounterSnapshot_ = std::move(counters);
+
+  if (not update.changedCounters.empty() or
+      not update.removedCounters.empty()) {
+    SYNCHRONIZED(countersPublishers_) {
+      for (auto& kv : countersPublishers_) {
+        kv.second.publisher.next(update);
+      }
+    }
+  }
+
+  scheduleCountersTimer();
+}
+
+void
+OpenrCtrlHandler::scheduleCountersTimer() noexcept {
+  std::optional<std::chrono::milliseconds> interval;
+  SYNCHRONIZED(countersPublishers_) {
+    for (auto& kv : countersPublishers_) {
+      if (not interval.has_value() or kv.second.interval < interval.value()) {
+        interval = kv.second.interval;
+      }
+    }
+  }
+  if (not interval.has_value()) {
+    // No subscribers left. Drop the baseline so the next subscription
+    // starts with a full snapshot push
+    lastCounterSnapshot_.clear();
+    return;
+  }
+  countersStreamTimer_->scheduleTimeout(interval.value());
+}
+
 folly::SemiFuture<apache::thrift::ResponseAndServerStream<
     thrift::Publication,
     thrift::Publication>>
@@ -10,6 +10,8 @@
 #include <fb303/BaseService.h>
 #include <fbzmq/service/monitor/ZmqMonitorClient.h>
 #include <fbzmq/zmq/Zmq.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <openr/common/EventLogger.h>
 #include <openr/common/Types.h>
 #include <openr/config-store/PersistentStore.h>
 #include <openr/config/Config.h>
@@ -110,6 +112,15 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
   folly::SemiFuture<std::unique_ptr<thrift::RouteDatabase>>
   semifuture_getRouteDb() override;
 
+  folly::SemiFuture<std::unique_ptr<thrift::RouteDatabasePage>>
+  semifuture_getRouteDbPaginated(
+      std::unique_ptr<std::string> cursor, int32_t maxRoutes) override;
+
+  // Stream the route database in bounded pages. Pages are produced one at
+  // a time on the ctrl event-base so dump memory stays flat
+  apache::thrift::ServerStream<thrift::RouteDatabasePage> streamRouteDb(
+      int32_t maxChunkSize) override;
+
   folly::SemiFuture<std::unique_ptr<std::vector<thrift::UnicastRoute>>>
   semifuture_getUnicastRoutesFiltered(
       std::unique_ptr<std::vector<::std::string>> prefixes) override;
@@ -177,6 +188,9 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
       std::unique_ptr<thrift::KeyDumpParams> filter,
       std::unique_ptr<std::string> area) override;
 
+  folly::SemiFuture<std::unique_ptr<std::vector<thrift::FloodTraceRecord>>>
+  semifuture_getKvStoreFloodTraces(std::unique_ptr<std::string> area) override;
+
   folly::SemiFuture<folly::Unit> semifuture_setKvStoreKeyVals(
       std::unique_ptr<thrift::KeySetParams> setParams,
       std::unique_ptr<std::string> area) override;
@@ -202,6 +216,16 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
   // immediately create and return the stream handler
   apache::thrift::ServerStream<thrift::Publication> subscribeKvStore() override;
 
+  // Same as above with server-side filtering of streamed publications
+  apache::thrift::ServerStream<thrift::Publication> subscribeKvStoreFiltered(
+      std::unique_ptr<thrift::KeyDumpParams> filter,
+      std::unique_ptr<std::set<std::string>> areas) override;
+
+  // Stream deltas of the counter map at the requested cadence. The
+  // snapshot+diff is computed once per push and shared by all subscribers
+  apache::thrift::ServerStream<thrift::CounterUpdate> subscribeCounters(
+      int64_t intervalMs) override;
+
   folly::SemiFuture<apache::thrift::ResponseAndServerStream<
       thrift::Publication,
       thrift::Publication>>
@@ -274,6 +298,11 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
     return longPollReqs_->size();
   }
 
+  inline size_t
+  getNumCountersPublishers() {
+    return countersPublishers_.wlock()->size();
+  }
+
   //
   // API to cleanup private variables
   //
@@ -285,9 +314,67 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
  private:
   void authorizeConnection();
 
+  // compute the counters delta once and push it to every subscriber, then
+  // re-arm the push timer. Runs on the ctrl event-base
+  void pushCounterUpdates() noexcept;
+
+  // (re)arm the counters push timer at the smallest cadence requested
+  // across active subscriptions. Runs on the ctrl event-base
+  void scheduleCountersTimer() noexcept;
+
+  // fetch one route-db page from Fib, publish it and chain the next page
+  // until the dump is complete. Backs streamRouteDb
+  void publishRouteDbPages(
+      std::shared_ptr<
+          apache::thrift::ServerStreamPublisher<thrift::RouteDatabasePage>>
+          publisher,
+      std::string cursor,
+      int32_t maxChunkSize) noexcept;
+
+  // KvStore snoop publisher with optional server-side filtering. The
+  // publication is filtered down to matching key-vals before it gets
+  // serialized onto the stream; a publication with no matching content is
+  // skipped for the client altogether
+  struct KvStoreStreamPublisher {
+    // key-prefix/originator filters. null matches every key-val
+    std::unique_ptr<KvStoreFilters> filters;
+
+    // areas to stream. Empty set matches every area
+    std::set<std::string> areas;
+
+    // subscribers sharing the same signature share one filtered
+    // publication object per update instead of materializing N copies
+    std::string filterSignature;
+
+    apache::thrift::ServerStreamPublisher<thrift::Publication> publisher;
+
+    // publish the subset of the publication matching the filters. The
+    // filtered view is computed at most once per distinct filter signature
+    // and shared across subscribers via `pubCache`
+    void publish(
+        thrift::Publication const& pub,
+        std::unordered_map<
+            std::string,
+            std::shared_ptr<const thrift::Publication>>& pubCache);
+
+    // build the filtered view. nullptr means nothing matched
+    std::shared_ptr<const thrift::Publication> filterPublication(
+        thrift::Publication const& pub) const;
+  };
+
+  // Counters subscription stream with its requested push cadence
+  struct CountersStreamPublisher {
+    std::chrono::milliseconds interval;
+
+    apache::thrift::ServerStreamPublisher<thrift::CounterUpdate> publisher;
+  };
+
   const std::string nodeName_;
   const std::unordered_set<std::string> acceptablePeerCommonNames_;
 
+  // Event base hosting the publication fiber and the counters push timer
+  OpenrEventBase* ctrlEvb_{nullptr};
+
   // Pointers to Open/R modules
   Decision* decision_{nullptr};
   Fib* fib_{nullptr};
@@ -298,15 +385,33 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
   std::shared_ptr<const Config> config_;
 
   // client to interact with monitor
-  std::unique_ptr<fbzmq::ZmqMonitorClient> zmqMonitorClient_;
+  std::shared_ptr<fbzmq::ZmqMonitorClient> zmqMonitorClient_;
+
+  // async event-log submitter wrapping zmqMonitorClient_
+  std::unique_ptr<EventLogger> eventLogger_;
 
   // Active kvstore snoop publishers
   std::atomic<int64_t> publisherToken_{0};
-  folly::Synchronized<std::unordered_map<
-      int64_t,
-      apache::thrift::ServerStreamPublisher<thrift::Publication>>>
+  folly::Synchronized<std::unordered_map<int64_t, KvStoreStreamPublisher>>
       kvStorePublishers_;
 
+  // Active counters subscription publishers
+  folly::Synchronized<std::unordered_map<int64_t, CountersStreamPublisher>>
+      countersPublishers_;
+
+  // Baseline counter snapshot deltas are computed against. Only accessed
+  // from the ctrl event-base
+  std::map<std::string, int64_t> lastCounterSnapshot_;
+
+  // Timer driving counter delta pushes while subscribers exist
+  std::unique_ptr<folly::AsyncTimeout> countersStreamTimer_;
+
+  // Dedicated CPU pool for expensive read-only dump requests. The thrift
+  // response is expanded here from copy-on-write module snapshots, so a
+  // burst of operator dumps never queues work behind SPF or flood
+  // processing on the module event-bases
+  std::unique_ptr<folly::CPUThreadPoolExecutor> dumpExecutor_;
+
   // pending longPoll requests from clients, which consists of
   // 1). promise; 2). timestamp when req received on server
   std::atomic<int64_t> pendingRequestId_{0};
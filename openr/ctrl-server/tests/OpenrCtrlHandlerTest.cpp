@@ -723,6 +723,87 @@ TEST_F(OpenrCtrlFixture, KvStoreApis) {
       std::this_thread::yield();
     }
   }
+
+  //
+  // Subscribe API with server-side filtering
+  //
+
+  {
+    std::atomic<int> received{0};
+    const std::string key{"snoop-key"};
+    auto handler = openrThriftServerWrapper_->getOpenrCtrlHandler();
+    thrift::KeyDumpParams filter;
+    filter.prefix = "snoop-";
+    auto subscription =
+        handler
+            ->subscribeKvStoreFiltered(
+                std::make_unique<thrift::KeyDumpParams>(filter),
+                std::make_unique<std::set<std::string>>())
+            .toClientStream()
+            .subscribeExTry(folly::getEventBase(), [&received, key](auto&& t) {
+              if (!t.hasValue()) {
+                return;
+              }
+              // Filtering happens server-side. Every streamed publication
+              // must hold nothing but matching key-vals
+              auto& pub = *t;
+              EXPECT_EQ(1, pub.keyVals.size());
+              ASSERT_EQ(1, pub.keyVals.count(key));
+              EXPECT_EQ("value1", pub.keyVals.at(key).value_ref().value());
+              received++;
+            });
+    EXPECT_EQ(1, handler->getNumKvStorePublishers());
+    kvStoreWrapper->setKey(
+        "other-key", createThriftValue(1, "node1", std::string("value1")));
+    kvStoreWrapper->setKey(
+        key, createThriftValue(10, "node1", std::string("value1")));
+
+    // Check we should receive-1 update
+    while (received < 1) {
+      std::this_thread::yield();
+    }
+
+    // Cancel subscription
+    subscription.cancel();
+    std::move(subscription).detach();
+
+    // Wait until publisher is destroyed
+    while (handler->getNumKvStorePublishers() != 0) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+TEST_F(OpenrCtrlFixture, SubscribeCountersApi) {
+  std::atomic<int> received{0};
+  auto handler = openrThriftServerWrapper_->getOpenrCtrlHandler();
+  auto subscription =
+      handler->subscribeCounters(1000).toClientStream().subscribeExTry(
+          folly::getEventBase(), [&received](auto&& t) {
+            if (!t.hasValue()) {
+              return;
+            }
+            // First push carries the full counter map (empty baseline),
+            // subsequent pushes only changed counters
+            auto& update = *t;
+            EXPECT_FALSE(update.changedCounters.empty());
+            received++;
+          });
+  EXPECT_EQ(1, handler->getNumCountersPublishers());
+
+  // Wait for at least one delta push
+  while (received < 1) {
+    std::this_thread::yield();
+  }
+
+  // Cancel subscription
+  subscription.cancel();
+  std::move(subscription).detach();
+
+  // Wait until publisher is destroyed
+  while (handler->getNumCountersPublishers() != 0) {
+    std::this_thread::yield();
+  }
 }
 
 TEST_F(OpenrCtrlFixture, LinkMonitorApis) {
@@ -7,9 +7,11 @@
 
 #include "Decision.h"
 
+#include <atomic>
 #include <chrono>
 #include <set>
 #include <string>
+#include <thread>
 #include <unordered_set>
 
 #include <fb303/ServiceData.h>
@@ -20,6 +22,8 @@
 #include <folly/Memory.h>
 #include <folly/Optional.h>
 #include <folly/String.h>
+#include <folly/Synchronized.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/futures/Future.h>
 #if FOLLY_USE_SYMBOLIZER
 #include <folly/experimental/exception_tracer/ExceptionTracer.h>
@@ -31,6 +35,7 @@
 #include <openr/common/Util.h>
 #include <openr/decision/LinkState.h>
 #include <openr/decision/PrefixState.h>
+#include <openr/telemetry/Telemetry.h>
 
 using namespace std;
 
@@ -45,6 +50,22 @@ using SpfResult = openr::LinkState::SpfResult;
 
 namespace openr {
 
+namespace {
+
+// stable identity of a single-link failure scenario, derived from the
+// link's name-ordered endpoints so both ends of the link agree on it
+std::string
+getLinkScenarioKey(Link const& link) {
+  return folly::sformat(
+      "{}%{}<->{}%{}",
+      link.firstNodeName(),
+      link.getIfaceFromNode(link.firstNodeName()),
+      link.secondNodeName(),
+      link.getIfaceFromNode(link.secondNodeName()));
+}
+
+} // namespace
+
 /**
  * Private implementation of the SpfSolver
  */
@@ -77,6 +98,8 @@ class SpfSolver::SpfSolverImpl {
     fb303::fbData->addStatExportType("decision.prefix_db_update", fb303::COUNT);
     fb303::fbData->addStatExportType("decision.route_build_ms", fb303::AVG);
     fb303::fbData->addStatExportType("decision.route_build_runs", fb303::COUNT);
+    fb303::fbData->addStatExportType("decision.route_delta_ms", fb303::AVG);
+    fb303::fbData->addStatExportType("decision.route_delta_runs", fb303::COUNT);
     fb303::fbData->addStatExportType(
         "decision.skipped_mpls_route", fb303::COUNT);
     fb303::fbData->addStatExportType(
@@ -84,6 +107,8 @@ class SpfSolver::SpfSolverImpl {
     fb303::fbData->addStatExportType(
         "decision.skipped_unicast_route", fb303::COUNT);
     fb303::fbData->addStatExportType("decision.spf_ms", fb303::AVG);
+    fb303::fbData->addStatExportType("decision.spf_patch_ms", fb303::AVG);
+    fb303::fbData->addStatExportType("decision.spf_patch_runs", fb303::COUNT);
     fb303::fbData->addStatExportType("decision.spf_runs", fb303::COUNT);
     fb303::fbData->addStatExportType("decision.errors", fb303::COUNT);
   }
@@ -107,8 +132,16 @@ class SpfSolver::SpfSolverImpl {
 
   thrift::StaticRoutes const& getStaticRoutes();
 
-  // returns true if the prefixDb changed
-  bool updatePrefixDatabase(const thrift::PrefixDatabase& prefixDb);
+  // returns the exact set of prefixes dirtied by the prefixDb
+  std::unordered_set<thrift::IpPrefix> updatePrefixDatabase(
+      const thrift::PrefixDatabase& prefixDb);
+
+  // delta entry points for per-prefix key advertisements. Processing cost
+  // is proportional to the one prefix touched, not the node's full set
+  std::unordered_set<thrift::IpPrefix> updatePrefix(
+      const std::string& nodeName, thrift::PrefixEntry const& prefixEntry);
+  std::unordered_set<thrift::IpPrefix> withdrawPrefix(
+      const std::string& nodeName, thrift::IpPrefix const& prefix);
 
   std::unordered_map<std::string /* nodeName */, thrift::PrefixDatabase>
   getPrefixDatabases();
@@ -116,10 +149,25 @@ class SpfSolver::SpfSolverImpl {
   std::optional<thrift::RouteDatabase> buildRouteDb(
       const std::string& myNodeName);
 
+  std::optional<thrift::RouteDatabaseDelta> buildRouteDelta(
+      const std::string& myNodeName,
+      std::unordered_set<thrift::IpPrefix> const& changedPrefixes);
+
   bool decrementHolds();
 
   void updateGlobalCounters();
 
+  int64_t getTopologyGeneration() const;
+
+  std::vector<std::string> getFailureScenarioLinks(
+      const std::string& myNodeName, size_t topK);
+
+  std::optional<thrift::RouteDatabase> buildRouteDbExcludingLink(
+      const std::string& myNodeName, const std::string& linkKey);
+
+  std::optional<std::string> detectSingleLinkDown(
+      thrift::AdjacencyDatabase const& newAdjacencyDb);
+
   std::optional<thrift::RouteDatabaseDelta> processStaticRouteUpdates();
 
   void pushRoutesDeltaUpdates(thrift::RouteDatabaseDelta& staticRoutesDelta);
@@ -134,6 +182,18 @@ class SpfSolver::SpfSolverImpl {
   SpfSolverImpl(SpfSolverImpl const&) = delete;
   SpfSolverImpl& operator=(SpfSolverImpl const&) = delete;
 
+  // Computes the unicast route for one prefix from myNodeName's perspective.
+  // When the prefix wants the KSP2_ED_ECMP algorithm the best announcing
+  // nodes are returned instead, as the path computation mutates cached
+  // linkState and must run serially
+  std::pair<
+      std::optional<thrift::UnicastRoute>,
+      std::optional<BestPathCalResult>>
+  createRouteForPrefix(
+      const std::string& myNodeName,
+      thrift::IpPrefix const& prefix,
+      std::unordered_map<std::string, thrift::PrefixEntry> const& nodePrefixes);
+
   std::optional<thrift::UnicastRoute> createOpenRRoute(
       std::string const& myNodeName,
       thrift::IpPrefix const& prefix,
@@ -226,6 +286,33 @@ class SpfSolver::SpfSolverImpl {
 
   // Use IGP metric in metric vector comparision
   const bool bgpUseIgpMetric_{false};
+
+  // lazily created pool used by buildRouteDb to fan the independent
+  // per-prefix route computation out across cores
+  std::unique_ptr<folly::CPUThreadPoolExecutor> routeBuildPool_;
+
+  // flyweight table of distinct ECMP next-hop sets, hash-consed by the
+  // announcing-node set they were computed from. In Clos-style fabrics
+  // many prefixes share one set - compute it once and share the storage.
+  // Entries derive purely from link state, so each one is stamped with
+  // the topology generation it was computed in and treated as a miss
+  // once the generation moves on. Stale entries are replaced in place on
+  // the next computation for the same node set, keeping invalidation
+  // O(1) instead of a wholesale flush
+  folly::Synchronized<std::unordered_map<
+      std::string /* isV4 | perDestination | announcing nodes */,
+      std::pair<
+          int64_t /* topology generation */,
+          std::shared_ptr<const std::vector<thrift::NextHopThrift>>>>>
+      nextHopSetTable_;
+
+  // monotonically bumped on every link-state change; see nextHopSetTable_
+  std::atomic<int64_t> topologyGeneration_{0};
+
+  // never-reused negative generations that scenario builds run under, so
+  // their next-hop set entries can neither serve nor poison builds
+  // against the real topology (see buildRouteDbExcludingLink)
+  int64_t scenarioGeneration_{-1};
 };
 
 std::pair<
@@ -241,8 +328,159 @@ SpfSolver::SpfSolverImpl::updateAdjacencyDatabase(
         linkState_.getMaxHopsToNode(newAdjacencyDb.thisNodeName) - holdUpTtl;
   }
   fb303::fbData->addStatValue("decision.adj_db_update", 1, fb303::COUNT);
-  return linkState_.updateAdjacencyDatabase(
+  auto const res = linkState_.updateAdjacencyDatabase(
       newAdjacencyDb, holdUpTtl, holdDownTtl);
+  if (res.first or res.second) {
+    // cached next-hop sets derive from link state
+    ++topologyGeneration_;
+  }
+  return res;
+}
+
+int64_t
+SpfSolver::SpfSolverImpl::getTopologyGeneration() const {
+  return topologyGeneration_.load(std::memory_order_relaxed);
+}
+
+std::vector<std::string>
+SpfSolver::SpfSolverImpl::getFailureScenarioLinks(
+    const std::string& myNodeName, size_t topK) {
+  // no per-link failure statistics are tracked here, so rank candidates
+  // by relevance to this node: links we are attached to first (their
+  // failure changes our own nexthops), then the rest in deterministic
+  // order so the cache converges onto a stable candidate set
+  std::vector<std::shared_ptr<Link>> candidates;
+  for (auto const& link : linkState_.allLinks()) {
+    // a held or already-down link is no what-if - its failure is either
+    // in flight or already converged on
+    if (link->isUp() and not link->hasHolds()) {
+      candidates.emplace_back(link);
+    }
+  }
+  std::sort(
+      candidates.begin(),
+      candidates.end(),
+      [&myNodeName](auto const& lhs, auto const& rhs) {
+        bool const lhsLocal = lhs->firstNodeName() == myNodeName or
+            lhs->secondNodeName() == myNodeName;
+        bool const rhsLocal = rhs->firstNodeName() == myNodeName or
+            rhs->secondNodeName() == myNodeName;
+        if (lhsLocal != rhsLocal) {
+          return lhsLocal;
+        }
+        return *lhs < *rhs;
+      });
+  if (candidates.size() > topK) {
+    candidates.resize(topK);
+  }
+
+  std::vector<std::string> linkKeys;
+  linkKeys.reserve(candidates.size());
+  for (auto const& link : candidates) {
+    linkKeys.emplace_back(getLinkScenarioKey(*link));
+  }
+  return linkKeys;
+}
+
+std::optional<thrift::RouteDatabase>
+SpfSolver::SpfSolverImpl::buildRouteDbExcludingLink(
+    const std::string& myNodeName, const std::string& linkKey) {
+  std::shared_ptr<Link> target{nullptr};
+  for (auto const& link : linkState_.allLinks()) {
+    if (getLinkScenarioKey(*link) == linkKey) {
+      target = link;
+      break;
+    }
+  }
+  if (nullptr == target or not target->isUp() or target->hasHolds()) {
+    // the scenario no longer applies to the current topology
+    return std::nullopt;
+  }
+
+  // run the scenario under its own never-reused generation: next-hop
+  // sets built against the failed topology must neither be served to
+  // builds against the real topology nor read stale real-topology
+  // entries, and the real generation must be restored unchanged so
+  // previously cached scenarios stay valid
+  auto const realGeneration = topologyGeneration_.load();
+  topologyGeneration_.store(scenarioGeneration_--);
+  linkState_.setLinkScenarioOverload(target, true);
+  auto maybeRouteDb = buildRouteDb(myNodeName);
+  linkState_.setLinkScenarioOverload(target, false);
+  topologyGeneration_.store(realGeneration);
+
+  // adjacency-label routes are emitted per link, up or not, so the
+  // overloaded scenario link still produced one; a real removal of the
+  // link would not. Drop it so the scenario matches the post-failure
+  // build exactly
+  if (maybeRouteDb.has_value() and
+      (target->firstNodeName() == myNodeName or
+       target->secondNodeName() == myNodeName)) {
+    auto const topLabel = target->getAdjLabelFromNode(myNodeName);
+    if (topLabel != 0) {
+      auto& mplsRoutes = maybeRouteDb->mplsRoutes;
+      mplsRoutes.erase(
+          std::remove_if(
+              mplsRoutes.begin(),
+              mplsRoutes.end(),
+              [topLabel](thrift::MplsRoute const& route) {
+                return route.topLabel == topLabel;
+              }),
+          mplsRoutes.end());
+    }
+  }
+  return maybeRouteDb;
+}
+
+std::optional<std::string>
+SpfSolver::SpfSolverImpl::detectSingleLinkDown(
+    thrift::AdjacencyDatabase const& newAdjacencyDb) {
+  auto const& adjDbs = linkState_.getAdjacencyDatabases();
+  auto const search = adjDbs.find(newAdjacencyDb.thisNodeName);
+  if (search == adjDbs.end()) {
+    return std::nullopt;
+  }
+  auto const& oldAdjacencyDb = search->second;
+  if (oldAdjacencyDb.isOverloaded != newAdjacencyDb.isOverloaded or
+      oldAdjacencyDb.nodeLabel != newAdjacencyDb.nodeLabel or
+      oldAdjacencyDb.adjacencies.size() !=
+          newAdjacencyDb.adjacencies.size() + 1) {
+    return std::nullopt;
+  }
+
+  // the update must reduce to exactly one adjacency disappearing: every
+  // surviving adjacency has to be carried unchanged. A publication that
+  // also touches metrics, labels or nexthops takes the full SPF path
+  thrift::Adjacency const* removedAdj{nullptr};
+  for (auto const& oldAdj : oldAdjacencyDb.adjacencies) {
+    auto const match = std::find(
+        newAdjacencyDb.adjacencies.begin(),
+        newAdjacencyDb.adjacencies.end(),
+        oldAdj);
+    if (match != newAdjacencyDb.adjacencies.end()) {
+      continue;
+    }
+    if (nullptr != removedAdj) {
+      return std::nullopt;
+    }
+    removedAdj = &oldAdj;
+  }
+  if (nullptr == removedAdj) {
+    return std::nullopt;
+  }
+
+  // map the lost adjacency onto the bidirectional link it formed; losing
+  // a one-sided adjacency never changes the topology
+  for (auto const& link :
+       linkState_.linksFromNode(newAdjacencyDb.thisNodeName)) {
+    if (link->getIfaceFromNode(newAdjacencyDb.thisNodeName) ==
+            removedAdj->ifName and
+        link->getOtherNodeName(newAdjacencyDb.thisNodeName) ==
+            removedAdj->otherNodeName) {
+      return getLinkScenarioKey(*link);
+    }
+  }
+  return std::nullopt;
 }
 
 bool
@@ -263,11 +501,13 @@ SpfSolver::SpfSolverImpl::hasHolds() const {
 
 bool
 SpfSolver::SpfSolverImpl::decrementHolds() {
+  ++topologyGeneration_;
   return linkState_.decrementHolds();
 }
 
 bool
 SpfSolver::SpfSolverImpl::deleteAdjacencyDatabase(const std::string& nodeName) {
+  ++topologyGeneration_;
   return linkState_.deleteAdjacencyDatabase(nodeName);
 }
 
@@ -281,7 +521,7 @@ SpfSolver::SpfSolverImpl::getStaticRoutes() {
   return staticRoutes_;
 }
 
-bool
+std::unordered_set<thrift::IpPrefix>
 SpfSolver::SpfSolverImpl::updatePrefixDatabase(
     thrift::PrefixDatabase const& prefixDb) {
   auto const& nodeName = prefixDb.thisNodeName;
@@ -290,11 +530,112 @@ SpfSolver::SpfSolverImpl::updatePrefixDatabase(
   return prefixState_.updatePrefixDatabase(prefixDb);
 }
 
+std::unordered_set<thrift::IpPrefix>
+SpfSolver::SpfSolverImpl::updatePrefix(
+    const std::string& nodeName, thrift::PrefixEntry const& prefixEntry) {
+  VLOG(2) << "Updating prefix " << toString(prefixEntry.prefix)
+          << " for node " << nodeName;
+  fb303::fbData->addStatValue("decision.prefix_db_update", 1, fb303::COUNT);
+  prefixState_.updatePrefix(nodeName, prefixEntry);
+  auto changed = prefixState_.getChangedPrefixes();
+  prefixState_.clearChangedPrefixes();
+  return changed;
+}
+
+std::unordered_set<thrift::IpPrefix>
+SpfSolver::SpfSolverImpl::withdrawPrefix(
+    const std::string& nodeName, thrift::IpPrefix const& prefix) {
+  VLOG(2) << "Withdrawing prefix " << toString(prefix) << " for node "
+          << nodeName;
+  fb303::fbData->addStatValue("decision.prefix_db_update", 1, fb303::COUNT);
+  prefixState_.withdrawPrefix(nodeName, prefix);
+  auto changed = prefixState_.getChangedPrefixes();
+  prefixState_.clearChangedPrefixes();
+  return changed;
+}
+
 std::unordered_map<std::string /* nodeName */, thrift::PrefixDatabase>
 SpfSolver::SpfSolverImpl::getPrefixDatabases() {
   return prefixState_.getPrefixDatabases();
 }
 
+std::pair<
+    std::optional<thrift::UnicastRoute>,
+    std::optional<BestPathCalResult>>
+SpfSolver::SpfSolverImpl::createRouteForPrefix(
+    const std::string& myNodeName,
+    thrift::IpPrefix const& prefix,
+    std::unordered_map<std::string, thrift::PrefixEntry> const& nodePrefixes) {
+  bool hasBGP = false, hasNonBGP = false, missingMv = false;
+  bool hasSpEcmp = false, hasKsp2EdEcmp = false;
+  for (auto const& npKv : nodePrefixes) {
+    bool isBGP = npKv.second.type == thrift::PrefixType::BGP;
+    hasBGP |= isBGP;
+    hasNonBGP |= !isBGP;
+    if (isBGP and not npKv.second.mv_ref().has_value()) {
+      missingMv = true;
+      LOG(ERROR) << "Prefix entry for prefix " << toString(npKv.second.prefix)
+                 << " advertised by " << npKv.first
+                 << " is of type BGP but does not contain a metric vector.";
+    }
+    hasSpEcmp |= npKv.second.forwardingAlgorithm ==
+        thrift::PrefixForwardingAlgorithm::SP_ECMP;
+    hasKsp2EdEcmp |= npKv.second.forwardingAlgorithm ==
+        thrift::PrefixForwardingAlgorithm::KSP2_ED_ECMP;
+  }
+
+  // skip adding route for BGP prefixes that have issues
+  if (hasBGP) {
+    if (hasNonBGP) {
+      LOG(ERROR) << "Skipping route for prefix " << toString(prefix)
+                 << " which is advertised with BGP and non-BGP type.";
+      fb303::fbData->addStatValue(
+          "decision.skipped_unicast_route", 1, fb303::COUNT);
+      return {std::nullopt, std::nullopt};
+    }
+    if (missingMv) {
+      LOG(ERROR) << "Skipping route for prefix " << toString(prefix)
+                 << " at least one advertiser is missing its metric vector.";
+      fb303::fbData->addStatValue(
+          "decision.skipped_unicast_route", 1, fb303::COUNT);
+      return {std::nullopt, std::nullopt};
+    }
+  }
+
+  // skip adding route for prefixes advertised by this node
+  if (nodePrefixes.count(myNodeName) and not hasBGP) {
+    return {std::nullopt, std::nullopt};
+  }
+
+  // Check for enabledV4_
+  auto prefixStr = prefix.prefixAddress.addr;
+  bool isV4Prefix = prefixStr.size() == folly::IPAddressV4::byteCount();
+  if (isV4Prefix && !enableV4_) {
+    LOG(WARNING) << "Received v4 prefix while v4 is not enabled.";
+    fb303::fbData->addStatValue(
+        "decision.skipped_unicast_route", 1, fb303::COUNT);
+    return {std::nullopt, std::nullopt};
+  }
+
+  const auto forwardingAlgorithm = hasKsp2EdEcmp and not hasSpEcmp
+      ? thrift::PrefixForwardingAlgorithm::KSP2_ED_ECMP
+      : thrift::PrefixForwardingAlgorithm::SP_ECMP;
+
+  if (forwardingAlgorithm == thrift::PrefixForwardingAlgorithm::SP_ECMP) {
+    auto route = hasBGP
+        ? createBGPRoute(myNodeName, prefix, nodePrefixes, isV4Prefix)
+        : createOpenRRoute(myNodeName, prefix, nodePrefixes, isV4Prefix);
+    return {std::move(route), std::nullopt};
+  }
+
+  const auto nodes = getBestAnnouncingNodes(
+      myNodeName, prefix, nodePrefixes, isV4Prefix, hasBGP, true);
+  if (nodes.success && nodes.nodes.size() != 0) {
+    return {std::nullopt, nodes};
+  }
+  return {std::nullopt, std::nullopt};
+}
+
 std::optional<thrift::RouteDatabase>
 SpfSolver::SpfSolverImpl::buildRouteDb(const std::string& myNodeName) {
   if (not linkState_.hasNode(myNodeName)) {
@@ -312,80 +653,89 @@ SpfSolver::SpfSolverImpl::buildRouteDb(const std::string& myNodeName) {
   //
   std::unordered_map<thrift::IpPrefix, BestPathCalResult> prefixToPerformKsp;
 
-  for (const auto& kv : prefixState_.prefixes()) {
-    const auto& prefix = kv.first;
-    const auto& nodePrefixes = kv.second;
-
-    bool hasBGP = false, hasNonBGP = false, missingMv = false;
-    bool hasSpEcmp = false, hasKsp2EdEcmp = false;
-    for (auto const& npKv : nodePrefixes) {
-      bool isBGP = npKv.second.type == thrift::PrefixType::BGP;
-      hasBGP |= isBGP;
-      hasNonBGP |= !isBGP;
-      if (isBGP and not npKv.second.mv_ref().has_value()) {
-        missingMv = true;
-        LOG(ERROR) << "Prefix entry for prefix " << toString(npKv.second.prefix)
-                   << " advertised by " << npKv.first
-                   << " is of type BGP but does not contain a metric vector.";
-      }
-      hasSpEcmp |= npKv.second.forwardingAlgorithm ==
-          thrift::PrefixForwardingAlgorithm::SP_ECMP;
-      hasKsp2EdEcmp |= npKv.second.forwardingAlgorithm ==
-          thrift::PrefixForwardingAlgorithm::KSP2_ED_ECMP;
-    }
+  // prefixes are independent once the SPF results are computed, so the
+  // per-prefix work can be spread across a pool. Each worker owns a chunk
+  // of this snapshot and fills one PrefixChunkResult; chunks are merged
+  // in order so the output matches the serial iteration exactly
+  const auto& prefixes = prefixState_.prefixes();
+  std::vector<std::pair<
+      const thrift::IpPrefix,
+      std::unordered_map<std::string, thrift::PrefixEntry>> const*>
+      prefixEntries;
+  prefixEntries.reserve(prefixes.size());
+  for (const auto& kv : prefixes) {
+    prefixEntries.push_back(&kv);
+  }
 
-    // skip adding route for BGP prefixes that have issues
-    if (hasBGP) {
-      if (hasNonBGP) {
-        LOG(ERROR) << "Skipping route for prefix " << toString(prefix)
-                   << " which is advertised with BGP and non-BGP type.";
-        fb303::fbData->addStatValue(
-            "decision.skipped_unicast_route", 1, fb303::COUNT);
-        continue;
-      }
-      if (missingMv) {
-        LOG(ERROR) << "Skipping route for prefix " << toString(prefix)
-                   << " at least one advertiser is missing its metric vector.";
-        fb303::fbData->addStatValue(
-            "decision.skipped_unicast_route", 1, fb303::COUNT);
-        continue;
+  struct PrefixChunkResult {
+    std::vector<thrift::UnicastRoute> unicastRoutes;
+    std::vector<std::pair<thrift::IpPrefix, BestPathCalResult>> toPerformKsp;
+  };
+
+  auto const processPrefixes = [&](size_t chunkBegin, size_t chunkEnd) {
+    PrefixChunkResult res;
+    for (size_t i = chunkBegin; i < chunkEnd; ++i) {
+      const auto& prefix = prefixEntries[i]->first;
+      auto [route, ksp2Nodes] =
+          createRouteForPrefix(myNodeName, prefix, prefixEntries[i]->second);
+      if (route.has_value()) {
+        res.unicastRoutes.emplace_back(std::move(route.value()));
+      } else if (ksp2Nodes.has_value()) {
+        res.toPerformKsp.emplace_back(prefix, std::move(ksp2Nodes.value()));
       }
-    }
+    } // for prefixEntries chunk
+    return res;
+  };
 
-    // skip adding route for prefixes advertised by this node
-    if (nodePrefixes.count(myNodeName) and not hasBGP) {
-      continue;
-    }
+  // a worker should own enough prefixes to amortize the dispatch overhead
+  constexpr size_t kMinPrefixesPerWorker{512};
+  const size_t workerCnt = std::min<size_t>(
+      std::thread::hardware_concurrency(),
+      prefixEntries.size() / kMinPrefixesPerWorker);
 
-    // Check for enabledV4_
-    auto prefixStr = prefix.prefixAddress.addr;
-    bool isV4Prefix = prefixStr.size() == folly::IPAddressV4::byteCount();
-    if (isV4Prefix && !enableV4_) {
-      LOG(WARNING) << "Received v4 prefix while v4 is not enabled.";
-      fb303::fbData->addStatValue(
-          "decision.skipped_unicast_route", 1, fb303::COUNT);
-      continue;
+  std::vector<PrefixChunkResult> chunkResults;
+  if (workerCnt <= 1) {
+    chunkResults.emplace_back(processPrefixes(0, prefixEntries.size()));
+  } else {
+    if (not routeBuildPool_) {
+      routeBuildPool_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+          std::thread::hardware_concurrency());
     }
-
-    const auto forwardingAlgorithm = hasKsp2EdEcmp and not hasSpEcmp
-        ? thrift::PrefixForwardingAlgorithm::KSP2_ED_ECMP
-        : thrift::PrefixForwardingAlgorithm::SP_ECMP;
-
-    if (forwardingAlgorithm == thrift::PrefixForwardingAlgorithm::SP_ECMP) {
-      auto route = hasBGP
-          ? createBGPRoute(myNodeName, prefix, nodePrefixes, isV4Prefix)
-          : createOpenRRoute(myNodeName, prefix, nodePrefixes, isV4Prefix);
-      if (route.has_value()) {
-        routeDb.unicastRoutes.emplace_back(std::move(route.value()));
-      }
-    } else {
-      const auto nodes = getBestAnnouncingNodes(
-          myNodeName, prefix, nodePrefixes, isV4Prefix, hasBGP, true);
-      if (nodes.success && nodes.nodes.size() != 0) {
-        prefixToPerformKsp[prefix] = nodes;
+    // SPF results are memoized inside LinkState and must not be computed
+    // concurrently by the per-prefix workers. Warm every source the
+    // per-prefix work can read before fanning out; the independent Dijkstra
+    // runs themselves spread across the pool. After this all shared state
+    // is touched read-only
+    std::vector<std::string> spfSources{myNodeName};
+    if (computeLfaPaths_) {
+      for (const auto& link : linkState_.linksFromNode(myNodeName)) {
+        if (link->isUp()) {
+          spfSources.emplace_back(link->getOtherNodeName(myNodeName));
+        }
       }
     }
-  } // for prefixState_.prefixes()
+    linkState_.warmSpfResults(spfSources, routeBuildPool_.get());
+    std::vector<folly::Future<PrefixChunkResult>> chunkFutures;
+    const size_t chunkSize = (prefixEntries.size() + workerCnt - 1) / workerCnt;
+    for (size_t begin = 0; begin < prefixEntries.size(); begin += chunkSize) {
+      const size_t end = std::min(begin + chunkSize, prefixEntries.size());
+      chunkFutures.emplace_back(
+          folly::via(routeBuildPool_.get(), [&processPrefixes, begin, end]() {
+            return processPrefixes(begin, end);
+          }));
+    }
+    for (auto& chunkTry : folly::collectAll(std::move(chunkFutures)).get()) {
+      chunkResults.emplace_back(std::move(chunkTry.value()));
+    }
+  }
+  for (auto& chunk : chunkResults) {
+    for (auto& route : chunk.unicastRoutes) {
+      routeDb.unicastRoutes.emplace_back(std::move(route));
+    }
+    for (auto& kv : chunk.toPerformKsp) {
+      prefixToPerformKsp[kv.first] = std::move(kv.second);
+    }
+  }
 
   for (const auto& kv : prefixToPerformKsp) {
     auto unicastRoute = selectKsp2Routes(
@@ -434,7 +784,9 @@ SpfSolver::SpfSolverImpl::buildRouteDb(const std::string& myNodeName) {
     // Install POP_AND_LOOKUP for next layer
     if (adjDb.thisNodeName == myNodeName) {
       thrift::NextHopThrift nh;
-      nh.address = toBinaryAddress(folly::IPAddressV6("::"));
+      static const auto zeroedV6Addr =
+          toBinaryAddress(folly::IPAddressV6("::"));
+      nh.address = zeroedV6Addr;
       nh.mplsAction_ref() =
           createMplsAction(thrift::MplsActionCode::POP_AND_LOOKUP);
       labelToNode[topLabel] = std::make_pair(
@@ -510,6 +862,54 @@ SpfSolver::SpfSolverImpl::buildRouteDb(const std::string& myNodeName) {
   return routeDb;
 } // buildRouteDb
 
+std::optional<thrift::RouteDatabaseDelta>
+SpfSolver::SpfSolverImpl::buildRouteDelta(
+    const std::string& myNodeName,
+    std::unordered_set<thrift::IpPrefix> const& changedPrefixes) {
+  if (not linkState_.hasNode(myNodeName)) {
+    return std::nullopt;
+  }
+  if (changedPrefixes.empty()) {
+    return std::nullopt;
+  }
+
+  const auto startTime = std::chrono::steady_clock::now();
+  fb303::fbData->addStatValue("decision.route_delta_runs", 1, fb303::COUNT);
+
+  thrift::RouteDatabaseDelta routeDbDelta;
+  routeDbDelta.thisNodeName = myNodeName;
+
+  // only the prefixes whose advertisements changed can have new best paths;
+  // node-label and adjacency MPLS routes don't depend on prefix databases
+  for (auto const& prefix : changedPrefixes) {
+    auto prefixIt = prefixState_.prefixes().find(prefix);
+    if (prefixIt == prefixState_.prefixes().end()) {
+      routeDbDelta.unicastRoutesToDelete.emplace_back(prefix);
+      continue;
+    }
+    auto [route, ksp2Nodes] =
+        createRouteForPrefix(myNodeName, prefix, prefixIt->second);
+    if (ksp2Nodes.has_value()) {
+      route = selectKsp2Routes(
+          prefix, myNodeName, ksp2Nodes.value(), prefixIt->second);
+    }
+    if (route.has_value()) {
+      routeDbDelta.unicastRoutesToUpdate.emplace_back(
+          std::move(route.value()));
+    } else {
+      // no longer routable - whatever was programmed before must go away
+      routeDbDelta.unicastRoutesToDelete.emplace_back(prefix);
+    }
+  }
+
+  auto deltaTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - startTime);
+  LOG(INFO) << "Decision::buildRouteDelta took " << deltaTime.count() << "ms.";
+  fb303::fbData->addStatValue(
+      "decision.route_delta_ms", deltaTime.count(), fb303::AVG);
+  return routeDbDelta;
+} // buildRouteDelta
+
 BestPathCalResult
 SpfSolver::SpfSolverImpl::getBestAnnouncingNodes(
     std::string const& myNodeName,
@@ -636,6 +1036,21 @@ SpfSolver::SpfSolverImpl::createOpenRRoute(
   const bool perDestination = getPrefixForwardingType(nodePrefixes) ==
       thrift::PrefixForwardingType::SR_MPLS;
 
+  // prefixes announced by the same node set share one next-hop set; serve
+  // it from the flyweight table when it was already built in the current
+  // topology generation
+  const auto generation = topologyGeneration_.load(std::memory_order_relaxed);
+  const auto nhSetKey = folly::sformat(
+      "{}|{}|{}", isV4, perDestination, folly::join(",", prefixNodes));
+  {
+    auto lockedTable = nextHopSetTable_.rlock();
+    auto tableIter = lockedTable->find(nhSetKey);
+    if (tableIter != lockedTable->end() and
+        tableIter->second.first == generation) {
+      return createUnicastRoute(prefix, *tableIter->second.second);
+    }
+  }
+
   const auto metricNhs =
       getNextHopsWithMetric(myNodeName, prefixNodes, perDestination);
   if (metricNhs.second.empty()) {
@@ -646,8 +1061,7 @@ SpfSolver::SpfSolverImpl::createOpenRRoute(
   }
 
   // Convert list of neighbor nodes to nexthops (considering adjacencies)
-  return createUnicastRoute(
-      prefix,
+  auto nextHopSet = std::make_shared<const std::vector<thrift::NextHopThrift>>(
       getNextHopsThrift(
           myNodeName,
           prefixNodes,
@@ -656,6 +1070,9 @@ SpfSolver::SpfSolverImpl::createOpenRRoute(
           metricNhs.first,
           metricNhs.second,
           std::nullopt));
+  nextHopSetTable_.wlock()->insert_or_assign(
+      nhSetKey, std::make_pair(generation, nextHopSet));
+  return createUnicastRoute(prefix, *nextHopSet);
 }
 
 BestPathCalResult
@@ -1282,11 +1699,23 @@ SpfSolver::getStaticRoutes() {
 }
 
 // update prefixes for a given router
-bool
+std::unordered_set<thrift::IpPrefix>
 SpfSolver::updatePrefixDatabase(const thrift::PrefixDatabase& prefixDb) {
   return impl_->updatePrefixDatabase(prefixDb);
 }
 
+std::unordered_set<thrift::IpPrefix>
+SpfSolver::updatePrefix(
+    const std::string& nodeName, thrift::PrefixEntry const& prefixEntry) {
+  return impl_->updatePrefix(nodeName, prefixEntry);
+}
+
+std::unordered_set<thrift::IpPrefix>
+SpfSolver::withdrawPrefix(
+    const std::string& nodeName, thrift::IpPrefix const& prefix) {
+  return impl_->withdrawPrefix(nodeName, prefix);
+}
+
 std::unordered_map<std::string /* nodeName */, thrift::PrefixDatabase>
 SpfSolver::getPrefixDatabases() {
   return impl_->getPrefixDatabases();
@@ -1297,6 +1726,13 @@ SpfSolver::buildRouteDb(const std::string& myNodeName) {
   return impl_->buildRouteDb(myNodeName);
 }
 
+std::optional<thrift::RouteDatabaseDelta>
+SpfSolver::buildRouteDelta(
+    const std::string& myNodeName,
+    std::unordered_set<thrift::IpPrefix> const& changedPrefixes) {
+  return impl_->buildRouteDelta(myNodeName, changedPrefixes);
+}
+
 std::optional<thrift::RouteDatabaseDelta>
 SpfSolver::processStaticRouteUpdates() {
   return impl_->processStaticRouteUpdates();
@@ -1312,6 +1748,29 @@ SpfSolver::updateGlobalCounters() {
   return impl_->updateGlobalCounters();
 }
 
+int64_t
+SpfSolver::getTopologyGeneration() const {
+  return impl_->getTopologyGeneration();
+}
+
+std::vector<std::string>
+SpfSolver::getFailureScenarioLinks(
+    const std::string& myNodeName, size_t topK) {
+  return impl_->getFailureScenarioLinks(myNodeName, topK);
+}
+
+std::optional<thrift::RouteDatabase>
+SpfSolver::buildRouteDbExcludingLink(
+    const std::string& myNodeName, const std::string& linkKey) {
+  return impl_->buildRouteDbExcludingLink(myNodeName, linkKey);
+}
+
+std::optional<std::string>
+SpfSolver::detectSingleLinkDown(
+    thrift::AdjacencyDatabase const& newAdjacencyDb) {
+  return impl_->detectSingleLinkDown(newAdjacencyDb);
+}
+
 //
 // Decision class implementation
 //
@@ -1329,10 +1788,17 @@ Decision::Decision(
     fbzmq::Context& /* zmqContext */)
     : config_(config),
       processUpdatesBackoff_(debounceMinDur, debounceMaxDur),
+      debounceController_(debounceMinDur, debounceMaxDur),
       routeUpdatesQueue_(routeUpdatesQueue),
       myNodeName_(config->getConfig().node_name) {
   auto tConfig = config->getConfig();
   routeDb_.thisNodeName = myNodeName_;
+  enableFailurePrecompute_ = config->isFailurePrecomputeEnabled();
+  failurePrecomputeTopK_ = config->getFailurePrecomputeTopK();
+  if (const auto captureDir = config->getEventCaptureDir()) {
+    replayLogWriter_ = std::make_unique<ReplayLogWriter>(
+        folly::sformat("{}/decision-publications.bin", *captureDir));
+  }
   processUpdatesTimer_ = folly::AsyncTimeout::make(
       *getEvb(), [this]() noexcept { processPendingUpdates(); });
   spfSolver_ = std::make_unique<SpfSolver>(
@@ -1351,7 +1817,10 @@ Decision::Decision(
 
   // Schedule periodic timer for counter submission
   counterUpdateTimer_ = folly::AsyncTimeout::make(*getEvb(), [this]() noexcept {
-    spfSolver_->updateGlobalCounters();
+    {
+      std::lock_guard<std::mutex> lock(spfSolverMutex_);
+      spfSolver_->updateGlobalCounters();
+    }
     // Schedule next counters update
     counterUpdateTimer_->scheduleTimeout(Constants::kCounterSubmitInterval);
   });
@@ -1361,6 +1830,7 @@ Decision::Decision(
   if (tConfig.enable_ordered_fib_programming_ref().value_or(false)) {
     orderedFibTimer_ = folly::AsyncTimeout::make(*getEvb(), [this]() noexcept {
       LOG(INFO) << "Decrementing Holds";
+      std::lock_guard<std::mutex> lock(spfSolverMutex_);
       decrementOrderedFibHolds();
       if (spfSolver_->hasHolds()) {
         auto timeout = getMaxFib();
@@ -1382,32 +1852,14 @@ Decision::Decision(
         break;
       }
 
-      // Apply publication and update stored update status
-      ProcessPublicationResult res; // default initialized to false
-      try {
-        res = processPublication(maybeThriftPub.value());
-      } catch (const std::exception& e) {
-#if FOLLY_USE_SYMBOLIZER
-        // collect stack strace then fail the process
-        for (auto& exInfo : folly::exception_tracer::getCurrentExceptions()) {
-          LOG(ERROR) << exInfo;
-        }
-#endif
-        // FATAL to produce core dump
-        LOG(FATAL) << "Exception occured in Decision::processPublication - "
-                   << folly::exceptionStr(e);
-      }
-      processUpdatesStatus_.adjChanged |= res.adjChanged;
-      processUpdatesStatus_.prefixesChanged |= res.prefixesChanged;
-      // compute routes with exponential backoff timer if needed
-      if (res.adjChanged || res.prefixesChanged) {
-        if (!processUpdatesBackoff_.atMaxBackoff()) {
-          processUpdatesBackoff_.reportError();
-          processUpdatesTimer_->scheduleTimeout(
-              processUpdatesBackoff_.getTimeRemainingUntilRetry());
-        } else {
-          CHECK(processUpdatesTimer_->isScheduled());
-        }
+      // apply right away when the solver is free; buffer instead of
+      // blocking when the compute thread is mid-build, so consumption
+      // never stalls behind an in-progress SPF run
+      std::unique_lock<std::mutex> lock(spfSolverMutex_, std::try_to_lock);
+      if (lock.owns_lock()) {
+        applyPublication(maybeThriftPub.value());
+      } else {
+        bufferedPublications_.emplace_back(std::move(maybeThriftPub).value());
       }
     }
   });
@@ -1425,6 +1877,7 @@ Decision::Decision(
           }
           // Apply publication and update stored update status
           pushRoutesDeltaUpdates(maybeThriftPub.value());
+          debounceController_.reportArrival();
           if (!processUpdatesBackoff_.atMaxBackoff()) {
             processUpdatesBackoff_.reportError();
             processUpdatesTimer_->scheduleTimeout(
@@ -1434,36 +1887,236 @@ Decision::Decision(
           }
         }
       });
+
+  fb303::fbData->addStatExportType(
+      "decision.route_builds_superseded", fb303::COUNT);
+  fb303::fbData->addStatExportType(
+      "decision.failure_precompute_builds", fb303::COUNT);
+  fb303::fbData->addStatExportType(
+      "decision.failure_precompute_hits", fb303::COUNT);
+
+  // spawn the route compute thread
+  routeComputeThread_ = std::thread([this]() noexcept { routeComputeLoop(); });
+}
+
+Decision::~Decision() {
+  {
+    std::lock_guard<std::mutex> lock(computeMutex_);
+    computeStopRequested_ = true;
+  }
+  computeCv_.notify_one();
+  if (routeComputeThread_.joinable()) {
+    routeComputeThread_.join();
+  }
+}
+
+void
+Decision::stop() {
+  // wind down the compute thread first so no build completion is posted
+  // to the evb after the loop terminates
+  {
+    std::lock_guard<std::mutex> lock(computeMutex_);
+    computeStopRequested_ = true;
+  }
+  computeCv_.notify_one();
+  if (routeComputeThread_.joinable()) {
+    routeComputeThread_.join();
+  }
+  OpenrEventBase::stop();
+}
+
+void
+Decision::scheduleRouteBuild(
+    std::optional<thrift::PerfEvents> perfEvents,
+    std::string eventDescription) {
+  {
+    std::lock_guard<std::mutex> lock(computeMutex_);
+    if (computeRequest_.has_value()) {
+      // latest-wins: the newer request covers a superset of the applied
+      // updates, so the queued build would compute routes for an
+      // already-stale topology - replace it
+      VLOG(1) << "Superseding queued route build ("
+              << computeRequest_->eventDescription << ") with "
+              << eventDescription;
+      fb303::fbData->addStatValue(
+          "decision.route_builds_superseded", 1, fb303::COUNT);
+    }
+    computeRequest_ =
+        RouteBuildRequest{std::move(perfEvents), std::move(eventDescription)};
+  }
+  computeCv_.notify_one();
+}
+
+void
+Decision::routeComputeLoop() noexcept {
+  folly::setThreadName("DecisionCompute");
+  LOG(INFO) << "Starting Decision route compute thread";
+  while (true) {
+    RouteBuildRequest request;
+    {
+      std::unique_lock<std::mutex> lock(computeMutex_);
+      if (enableFailurePrecompute_) {
+        // wait in bounded slices: whenever no build request shows up
+        // within the slice, spend the idle time precomputing one
+        // likely-failure scenario. A posted request or stop always wins
+        while (not computeCv_.wait_for(
+            lock, Constants::kFailurePrecomputeIdleWait, [this] {
+              return computeStopRequested_ or computeRequest_.has_value();
+            })) {
+          lock.unlock();
+          precomputeFailureScenarios();
+          lock.lock();
+        }
+      } else {
+        computeCv_.wait(lock, [this] {
+          return computeStopRequested_ or computeRequest_.has_value();
+        });
+      }
+      if (computeStopRequested_) {
+        break;
+      }
+      request = std::move(computeRequest_.value());
+      computeRequest_.reset();
+    }
+
+    // run the expensive build on a consistent view of the solver; the
+    // consumer buffers publications instead of blocking on this lock
+    const auto buildStart = std::chrono::steady_clock::now();
+    std::optional<thrift::RouteDatabase> maybeRouteDb;
+    {
+      std::lock_guard<std::mutex> lock(spfSolverMutex_);
+      maybeRouteDb = spfSolver_->buildRouteDb(myNodeName_);
+    }
+    const auto buildDuration =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - buildStart);
+    TelemetrySampler::instance().record(
+        "decision.spf_duration_ms", buildDuration.count());
+
+    // hand the result back to the Decision evb for diffing/publishing
+    runInEventBaseThread([this,
+                          maybeRouteDb = std::move(maybeRouteDb),
+                          request = std::move(request),
+                          buildDuration]() mutable {
+      onRouteBuildDone(
+          std::move(maybeRouteDb),
+          std::move(request.perfEvents),
+          request.eventDescription,
+          buildDuration);
+    });
+  }
+  LOG(INFO) << "Decision route compute thread stopped";
+}
+
+void
+Decision::precomputeFailureScenarios() {
+  {
+    std::lock_guard<std::mutex> lock(spfSolverMutex_);
+    auto const generation = spfSolver_->getTopologyGeneration();
+    // drop entries computed against a topology that has since changed
+    for (auto it = failureCache_.begin(); it != failureCache_.end();) {
+      it = it->second.generation == generation ? std::next(it)
+                                               : failureCache_.erase(it);
+    }
+    for (auto const& linkKey : spfSolver_->getFailureScenarioLinks(
+             myNodeName_, failurePrecomputeTopK_)) {
+      if (failureCache_.count(linkKey)) {
+        continue;
+      }
+      auto maybeRouteDb =
+          spfSolver_->buildRouteDbExcludingLink(myNodeName_, linkKey);
+      if (maybeRouteDb.has_value()) {
+        fb303::fbData->addStatValue(
+            "decision.failure_precompute_builds", 1, fb303::COUNT);
+        failureCache_.emplace(
+            linkKey,
+            PrecomputedFailure{generation, std::move(maybeRouteDb).value()});
+      }
+      // one scenario per idle slice keeps the solver available for real
+      // work; the remaining candidates fill in on later slices
+      break;
+    }
+  }
+  // a publication may have been buffered while the scenario build held
+  // the solver, and no route build is going to complete and flush it
+  runInEventBaseThread([this]() { flushBufferedPublications(); });
+}
+
+void
+Decision::onRouteBuildDone(
+    std::optional<thrift::RouteDatabase> maybeRouteDb,
+    std::optional<thrift::PerfEvents> perfEvents,
+    std::string const& eventDescription,
+    std::chrono::milliseconds buildDuration) {
+  debounceController_.reportRouteBuildDuration(buildDuration);
+
+  flushBufferedPublications();
+
+  if (not maybeRouteDb.has_value()) {
+    LOG(WARNING) << "Route build for " << eventDescription
+                 << " incurred no route updates";
+    return;
+  }
+
+  fromStdOptional(maybeRouteDb.value().perfEvents_ref(), perfEvents);
+  sendRouteUpdate(std::move(maybeRouteDb).value(), eventDescription);
+}
+
+void
+Decision::flushBufferedPublications() {
+  if (bufferedPublications_.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(spfSolverMutex_);
+  for (auto const& thriftPub : bufferedPublications_) {
+    applyPublication(thriftPub);
+  }
+  bufferedPublications_.clear();
 }
 
 folly::SemiFuture<std::unique_ptr<thrift::RouteDatabase>>
 Decision::getDecisionRouteDb(std::string nodeName) {
   folly::Promise<std::unique_ptr<thrift::RouteDatabase>> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([p = std::move(p), nodeName, this]() mutable {
-    thrift::RouteDatabase routeDb;
-    if (nodeName.empty()) {
-      nodeName = myNodeName_;
-    }
-    auto maybeRouteDb = spfSolver_->buildRouteDb(nodeName);
-    if (maybeRouteDb.has_value()) {
-      routeDb = std::move(maybeRouteDb.value());
-    } else {
-      routeDb.thisNodeName = nodeName;
-    }
-    for (const auto& [key, val] : spfSolver_->getStaticRoutes().mplsRoutes) {
-      routeDb.mplsRoutes.emplace_back(createMplsRoute(key, val));
-    }
-    p.setValue(std::make_unique<thrift::RouteDatabase>(std::move(routeDb)));
-  });
+  runInEventBaseThread(
+      [p = std::move(p), nodeName = std::move(nodeName), this]() mutable {
+        p.setValue(buildDecisionRouteDb(std::move(nodeName)));
+      });
   return sf;
 }
 
+#if FOLLY_HAS_COROUTINES
+folly::coro::Task<std::unique_ptr<thrift::RouteDatabase>>
+Decision::getDecisionRouteDbCoro(std::string nodeName) {
+  co_return buildDecisionRouteDb(std::move(nodeName));
+}
+#endif
+
+std::unique_ptr<thrift::RouteDatabase>
+Decision::buildDecisionRouteDb(std::string nodeName) {
+  thrift::RouteDatabase routeDb;
+  if (nodeName.empty()) {
+    nodeName = myNodeName_;
+  }
+  std::lock_guard<std::mutex> lock(spfSolverMutex_);
+  auto maybeRouteDb = spfSolver_->buildRouteDb(nodeName);
+  if (maybeRouteDb.has_value()) {
+    routeDb = std::move(maybeRouteDb.value());
+  } else {
+    routeDb.thisNodeName = nodeName;
+  }
+  for (const auto& [key, val] : spfSolver_->getStaticRoutes().mplsRoutes) {
+    routeDb.mplsRoutes.emplace_back(createMplsRoute(key, val));
+  }
+  return std::make_unique<thrift::RouteDatabase>(std::move(routeDb));
+}
+
 folly::SemiFuture<std::unique_ptr<thrift::StaticRoutes>>
 Decision::getDecisionStaticRoutes() {
   folly::Promise<std::unique_ptr<thrift::StaticRoutes>> p;
   auto sf = p.getSemiFuture();
   runInEventBaseThread([p = std::move(p), this]() mutable {
+    std::lock_guard<std::mutex> lock(spfSolverMutex_);
     auto staticRoutes = spfSolver_->getStaticRoutes();
     p.setValue(std::make_unique<thrift::StaticRoutes>(std::move(staticRoutes)));
   });
@@ -1472,22 +2125,55 @@ Decision::getDecisionStaticRoutes() {
 
 folly::SemiFuture<std::unique_ptr<thrift::AdjDbs>>
 Decision::getDecisionAdjacencyDbs() {
-  folly::Promise<std::unique_ptr<thrift::AdjDbs>> p;
+  // the copy for the caller happens on the caller's thread, off the
+  // Decision loop
+  return getDecisionAdjacencyDbsSnapshot().deferValue(
+      [](std::shared_ptr<thrift::AdjDbs const>&& snapshot) {
+        return std::make_unique<thrift::AdjDbs>(*snapshot);
+      });
+}
+
+folly::SemiFuture<std::shared_ptr<thrift::AdjDbs const>>
+Decision::getDecisionAdjacencyDbsSnapshot() {
+  // serve the immutable snapshot directly when fresh
+  if (auto snapshot = adjDbsSnapshot_.copy()) {
+    return folly::makeSemiFuture(
+        std::shared_ptr<thrift::AdjDbs const>(std::move(snapshot)));
+  }
+  folly::Promise<std::shared_ptr<thrift::AdjDbs const>> p;
   auto sf = p.getSemiFuture();
   runInEventBaseThread([p = std::move(p), this]() mutable {
-    auto adjDbs = spfSolver_->getAdjacencyDatabases();
-    p.setValue(std::make_unique<thrift::AdjDbs>(std::move(adjDbs)));
+    std::lock_guard<std::mutex> lock(spfSolverMutex_);
+    auto snapshot = std::make_shared<thrift::AdjDbs const>(
+        spfSolver_->getAdjacencyDatabases());
+    *adjDbsSnapshot_.wlock() = snapshot;
+    p.setValue(std::move(snapshot));
   });
   return sf;
 }
 
 folly::SemiFuture<std::unique_ptr<thrift::PrefixDbs>>
 Decision::getDecisionPrefixDbs() {
-  folly::Promise<std::unique_ptr<thrift::PrefixDbs>> p;
+  return getDecisionPrefixDbsSnapshot().deferValue(
+      [](std::shared_ptr<thrift::PrefixDbs const>&& snapshot) {
+        return std::make_unique<thrift::PrefixDbs>(*snapshot);
+      });
+}
+
+folly::SemiFuture<std::shared_ptr<thrift::PrefixDbs const>>
+Decision::getDecisionPrefixDbsSnapshot() {
+  if (auto snapshot = prefixDbsSnapshot_.copy()) {
+    return folly::makeSemiFuture(
+        std::shared_ptr<thrift::PrefixDbs const>(std::move(snapshot)));
+  }
+  folly::Promise<std::shared_ptr<thrift::PrefixDbs const>> p;
   auto sf = p.getSemiFuture();
   runInEventBaseThread([p = std::move(p), this]() mutable {
-    auto prefixDbs = spfSolver_->getPrefixDatabases();
-    p.setValue(std::make_unique<thrift::PrefixDbs>(std::move(prefixDbs)));
+    std::lock_guard<std::mutex> lock(spfSolverMutex_);
+    auto snapshot = std::make_shared<thrift::PrefixDbs const>(
+        spfSolver_->getPrefixDatabases());
+    *prefixDbsSnapshot_.wlock() = snapshot;
+    p.setValue(std::move(snapshot));
   });
   return sf;
 }
@@ -1534,6 +2220,33 @@ Decision::updateNodePrefixDatabase(
   return nodePrefixDb;
 }
 
+std::optional<std::unordered_set<thrift::IpPrefix>>
+Decision::updateNodePrefixKey(
+    const PrefixKey& prefixKey, const thrift::PrefixDatabase& prefixDb) {
+  auto const& nodeName = prefixDb.thisNodeName;
+  auto fullDbIt = fullDbPrefixEntries_.find(nodeName);
+  if (fullDbIt != fullDbPrefixEntries_.end() and
+      not fullDbIt->second.empty()) {
+    // node (also) advertises a monolithic prefix db which per-prefix keys
+    // must keep shadowing - take the full-merge path
+    return std::nullopt;
+  }
+
+  auto const& prefix = prefixKey.getIpPrefix();
+  if (prefixDb.deletePrefix) {
+    perPrefixPrefixEntries_[nodeName].erase(prefix);
+    return spfSolver_->withdrawPrefix(nodeName, prefix);
+  }
+  if (prefixDb.prefixEntries.empty()) {
+    LOG(ERROR) << "Received no entries for prefix db";
+    return std::unordered_set<thrift::IpPrefix>{};
+  }
+  LOG_IF(ERROR, prefixDb.prefixEntries.size() > 1)
+      << "Received more than one prefix, only the first prefix is processed";
+  perPrefixPrefixEntries_[nodeName][prefix] = prefixDb.prefixEntries[0];
+  return spfSolver_->updatePrefix(nodeName, prefixDb.prefixEntries[0]);
+}
+
 ProcessPublicationResult
 Decision::processPublication(thrift::Publication const& thriftPub) {
   ProcessPublicationResult res;
@@ -1546,10 +2259,17 @@ Decision::processPublication(thrift::Publication const& thriftPub) {
     return res;
   }
 
+  // Deserialization scratch objects reused across all keys of this
+  // publication. __clear__() resets contents but containers keep their
+  // capacity, so decoding a publication's worth of adj/prefix databases
+  // reuses the same heap slabs instead of reallocating them per key; the
+  // slabs are released once when the scratch objects go out of scope
+  thrift::AdjacencyDatabase adjacencyDb;
+  thrift::PrefixDatabase prefixDb;
+
   for (const auto& kv : thriftPub.keyVals) {
     const auto& key = kv.first;
     const auto& rawVal = kv.second;
-    std::string nodeName = getNodeNameFromKey(key);
 
     if (not rawVal.value_ref().has_value()) {
       // skip TTL update
@@ -1557,15 +2277,48 @@ Decision::processPublication(thrift::Publication const& thriftPub) {
       continue;
     }
 
+    const auto nodeName = getNodeNameViewFromKey(key);
+
     try {
-      if (key.find(Constants::kAdjDbMarker.toString()) == 0) {
+      if (isKeyForMarker(key, Constants::kAdjDbMarker)) {
         // update adjacencyDb
-        auto adjacencyDb =
-            fbzmq::util::readThriftObjStr<thrift::AdjacencyDatabase>(
-                rawVal.value_ref().value(), serializer_);
+        adjacencyDb.__clear__();
+        serializer_.deserialize(rawVal.value_ref().value(), adjacencyDb);
+        // transparently accept the compact wire encoding (no-op for the
+        // expanded form)
+        expandAdjacencyDb(adjacencyDb);
         CHECK_EQ(nodeName, adjacencyDb.thisNodeName);
+        // stored adjacency db is replaced even when no route-affecting
+        // change results, so the dump snapshot is always stale here
+        adjDbsSnapshot_.wlock()->reset();
+        std::optional<std::string> failedLinkKey;
+        int64_t preGeneration{0};
+        if (enableFailurePrecompute_) {
+          preGeneration = spfSolver_->getTopologyGeneration();
+          failedLinkKey = spfSolver_->detectSingleLinkDown(adjacencyDb);
+        }
         auto rc = spfSolver_->updateAdjacencyDatabase(adjacencyDb);
         if (rc.first) {
+          // a cached scenario matching this exact failure converges
+          // right here; the debounced rebuild below still runs as a
+          // safety net and diffs to an empty delta when the cached
+          // answer was right
+          if (failedLinkKey.has_value() and not rc.second and
+              not coldStartTimer_->isScheduled()) {
+            auto cacheIter = failureCache_.find(failedLinkKey.value());
+            if (cacheIter != failureCache_.end() and
+                cacheIter->second.generation == preGeneration) {
+              fb303::fbData->addStatValue(
+                  "decision.failure_precompute_hits", 1, fb303::COUNT);
+              auto cachedRouteDb = std::move(cacheIter->second.routeDb);
+              failureCache_.erase(cacheIter);
+              fromStdOptional(
+                  cachedRouteDb.perfEvents_ref(),
+                  castToStd(adjacencyDb.perfEvents_ref()));
+              sendRouteUpdate(
+                  std::move(cachedRouteDb), "DECISION_PRECOMPUTED_FAILOVER");
+            }
+          }
           res.adjChanged = true;
           pendingAdjUpdates_.addUpdate(
               myNodeName_, castToStd(adjacencyDb.perfEvents_ref()));
@@ -1585,24 +2338,40 @@ Decision::processPublication(thrift::Publication const& thriftPub) {
         continue;
       }
 
-      if (key.find(Constants::kPrefixDbMarker.toString()) == 0) {
+      if (isKeyForMarker(key, Constants::kPrefixDbMarker)) {
         // update prefixDb
-        auto prefixDb = fbzmq::util::readThriftObjStr<thrift::PrefixDatabase>(
-            rawVal.value_ref().value(), serializer_);
+        prefixDb.__clear__();
+        serializer_.deserialize(rawVal.value_ref().value(), prefixDb);
         CHECK_EQ(nodeName, prefixDb.thisNodeName);
-        auto nodePrefixDb = updateNodePrefixDatabase(key, prefixDb);
-        if (spfSolver_->updatePrefixDatabase(nodePrefixDb)) {
+        // per-prefix keys are applied incrementally - only fall back to
+        // rebuilding and re-diffing the node's full prefix db for the
+        // monolithic key schema
+        std::optional<std::unordered_set<thrift::IpPrefix>> changedPrefixes;
+        auto prefixKey = PrefixKey::fromStr(key);
+        if (prefixKey.hasValue()) {
+          changedPrefixes = updateNodePrefixKey(prefixKey.value(), prefixDb);
+        }
+        if (not changedPrefixes.has_value()) {
+          auto nodePrefixDb = updateNodePrefixDatabase(key, prefixDb);
+          changedPrefixes = spfSolver_->updatePrefixDatabase(nodePrefixDb);
+        }
+        if (not changedPrefixes->empty()) {
+          prefixDbsSnapshot_.wlock()->reset();
           res.prefixesChanged = true;
+          res.changedPrefixes.insert(
+              changedPrefixes->begin(), changedPrefixes->end());
           pendingPrefixUpdates_.addUpdate(
-              myNodeName_, castToStd(nodePrefixDb.perfEvents_ref()));
+              myNodeName_, castToStd(prefixDb.perfEvents_ref()));
+          // precomputed scenario routes embed the old prefix state
+          failureCache_.clear();
         }
         continue;
       }
 
-      if (key.find(Constants::kFibTimeMarker.toString()) == 0) {
+      if (isKeyForMarker(key, Constants::kFibTimeMarker)) {
         try {
           std::chrono::milliseconds fibTime{stoll(rawVal.value_ref().value())};
-          fibTimes_[nodeName] = fibTime;
+          fibTimes_[nodeName.str()] = fibTime;
         } catch (...) {
           LOG(ERROR) << "Could not convert "
                      << Constants::kFibTimeMarker.toString()
@@ -1610,6 +2379,23 @@ Decision::processPublication(thrift::Publication const& thriftPub) {
         }
         continue;
       }
+
+      if (isKeyForMarker(key, Constants::kFibAckMarker)) {
+        try {
+          int64_t const ackSeq{stoll(rawVal.value_ref().value())};
+          auto& lastSeq = fibAckSeqs_[nodeName.str()];
+          if (ackSeq > lastSeq) {
+            lastSeq = ackSeq;
+            fibAcksSinceDecrement_.emplace(nodeName.str());
+            maybeDecrementOrderedFibHolds();
+          }
+        } catch (...) {
+          LOG(ERROR) << "Could not convert "
+                     << Constants::kFibAckMarker.toString()
+                     << " value to int64";
+        }
+        continue;
+      }
     } catch (const std::exception& e) {
       LOG(ERROR) << "Failed to deserialize info for key " << key
                  << ". Exception: " << folly::exceptionStr(e);
@@ -1618,10 +2404,11 @@ Decision::processPublication(thrift::Publication const& thriftPub) {
 
   // LSDB deletion
   for (const auto& key : thriftPub.expiredKeys) {
-    std::string nodeName = getNodeNameFromKey(key);
+    const auto nodeName = getNodeNameViewFromKey(key);
 
-    if (key.find(Constants::kAdjDbMarker.toString()) == 0) {
-      if (spfSolver_->deleteAdjacencyDatabase(nodeName)) {
+    if (isKeyForMarker(key, Constants::kAdjDbMarker)) {
+      if (spfSolver_->deleteAdjacencyDatabase(nodeName.str())) {
+        adjDbsSnapshot_.wlock()->reset();
         res.adjChanged = true;
         pendingAdjUpdates_.addUpdate(
             myNodeName_, castToStd(thrift::PrefixDatabase().perfEvents_ref()));
@@ -1629,14 +2416,27 @@ Decision::processPublication(thrift::Publication const& thriftPub) {
       continue;
     }
 
-    if (key.find(Constants::kPrefixDbMarker.toString()) == 0) {
+    if (isKeyForMarker(key, Constants::kPrefixDbMarker)) {
       // manually build delete prefix db to signal delete just as a client would
       thrift::PrefixDatabase deletePrefixDb;
-      deletePrefixDb.thisNodeName = nodeName;
+      deletePrefixDb.thisNodeName = nodeName.str();
       deletePrefixDb.deletePrefix = true;
-      auto nodePrefixDb = updateNodePrefixDatabase(key, deletePrefixDb);
-      if (spfSolver_->updatePrefixDatabase(nodePrefixDb)) {
+      std::optional<std::unordered_set<thrift::IpPrefix>> changedPrefixes;
+      auto prefixKey = PrefixKey::fromStr(key);
+      if (prefixKey.hasValue()) {
+        changedPrefixes =
+            updateNodePrefixKey(prefixKey.value(), deletePrefixDb);
+      }
+      if (not changedPrefixes.has_value()) {
+        auto nodePrefixDb = updateNodePrefixDatabase(key, deletePrefixDb);
+        changedPrefixes = spfSolver_->updatePrefixDatabase(nodePrefixDb);
+      }
+      if (not changedPrefixes->empty()) {
+        prefixDbsSnapshot_.wlock()->reset();
         res.prefixesChanged = true;
+        res.changedPrefixes.insert(
+            changedPrefixes->begin(), changedPrefixes->end());
+        failureCache_.clear();
       }
       continue;
     }
@@ -1645,6 +2445,58 @@ Decision::processPublication(thrift::Publication const& thriftPub) {
   return res;
 }
 
+void
+Decision::applyPublication(thrift::Publication const& thriftPub) {
+  // record the raw input stream before any processing so a capture
+  // replays exactly what production saw
+  if (replayLogWriter_) {
+    replayLogWriter_->appendPublication(thriftPub);
+  }
+
+  // KvStore signalling completion of its initial full-sync means the
+  // topology is as complete as it will get on boot: run the first SPF
+  // right away on the full view instead of waiting out the cold-start
+  // timer, which only remains as a fallback for peers that never sync
+  if (thriftPub.initialSyncComplete_ref().value_or(false) and
+      coldStartTimer_->isScheduled()) {
+    LOG(INFO) << "KvStore initial sync complete, ending cold-start early";
+    coldStartTimer_->cancelTimeout();
+    coldStartUpdateLocked();
+    return;
+  }
+
+  // Apply publication and update stored update status
+  ProcessPublicationResult res; // default initialized to false
+  try {
+    res = processPublication(thriftPub);
+  } catch (const std::exception& e) {
+#if FOLLY_USE_SYMBOLIZER
+    // collect stack strace then fail the process
+    for (auto& exInfo : folly::exception_tracer::getCurrentExceptions()) {
+      LOG(ERROR) << exInfo;
+    }
+#endif
+    // FATAL to produce core dump
+    LOG(FATAL) << "Exception occured in Decision::processPublication - "
+               << folly::exceptionStr(e);
+  }
+  processUpdatesStatus_.adjChanged |= res.adjChanged;
+  processUpdatesStatus_.prefixesChanged |= res.prefixesChanged;
+  processUpdatesStatus_.changedPrefixes.insert(
+      res.changedPrefixes.begin(), res.changedPrefixes.end());
+  // compute routes with exponential backoff timer if needed
+  if (res.adjChanged || res.prefixesChanged) {
+    debounceController_.reportArrival();
+    if (!processUpdatesBackoff_.atMaxBackoff()) {
+      processUpdatesBackoff_.reportError();
+      processUpdatesTimer_->scheduleTimeout(
+          processUpdatesBackoff_.getTimeRemainingUntilRetry());
+    } else {
+      CHECK(processUpdatesTimer_->isScheduled());
+    }
+  }
+}
+
 void
 Decision::processStaticRouteUpdates() {
   auto maybePerfEvents = pendingPrefixUpdates_.getPerfEvents();
@@ -1672,11 +2524,16 @@ Decision::processStaticRouteUpdates() {
 void
 Decision::pushRoutesDeltaUpdates(
     thrift::RouteDatabaseDelta& staticRoutesDelta) {
+  std::lock_guard<std::mutex> lock(spfSolverMutex_);
   spfSolver_->pushRoutesDeltaUpdates(staticRoutesDelta);
+  // precomputed scenario routes embed the old static-route state
+  failureCache_.clear();
 }
 
 void
 Decision::processPendingUpdates() {
+  std::lock_guard<std::mutex> lock(spfSolverMutex_);
+
   // we need to update  static route first, because there maybe routes
   // depending on static routes.
   bool staticRoutesUpdated{false};
@@ -1688,20 +2545,26 @@ Decision::processPendingUpdates() {
   if (processUpdatesStatus_.adjChanged) {
     processPendingAdjUpdates();
   } else if (
-      processUpdatesStatus_.prefixesChanged ||
-      staticRoutesUpdated) // if only static routes gets updated, we still need
-                           // to update routes because there maybe routes
-                           // depended on static routes.
-  {
+      staticRoutesUpdated or
+      (processUpdatesStatus_.prefixesChanged and
+       processUpdatesStatus_.changedPrefixes.empty())) {
+    // full route build: any prefix's nexthops may depend on static routes,
+    // and route attribute changes (labels, local nexthops) dirty no
+    // specific prefix
     processPendingPrefixUpdates();
+  } else if (processUpdatesStatus_.prefixesChanged) {
+    processPendingPrefixDeltaUpdates();
   }
 
   // reset update status
   processUpdatesStatus_.adjChanged = false;
   processUpdatesStatus_.prefixesChanged = false;
+  processUpdatesStatus_.changedPrefixes.clear();
 
-  // update decision debounce flag
-  processUpdatesBackoff_.reportSuccess();
+  // start the next burst from the adapted (cleared) window; the measured
+  // compute cost is fed back by onRouteBuildDone() once a build finishes
+  processUpdatesBackoff_ = ExponentialBackoff<std::chrono::milliseconds>(
+      debounceController_.initialBackoff(), debounceController_.maxBackoff());
 }
 
 void
@@ -1733,20 +2596,30 @@ Decision::processPendingAdjUpdates() {
     return;
   }
 
-  // run SPF once for all updates received
-  LOG(INFO) << "Decision: computing new paths.";
-  auto maybeRouteDb = spfSolver_->buildRouteDb(myNodeName_);
-  if (not maybeRouteDb.has_value()) {
-    LOG(WARNING) << "AdjacencyDb updates incurred no route updates";
+  // hand the SPF run for all received updates to the compute thread; a
+  // newer request supersedes this one if more updates arrive meanwhile
+  LOG(INFO) << "Decision: scheduling SPF computation.";
+  scheduleRouteBuild(std::move(maybePerfEvents), "DECISION_SPF");
+}
+
+void
+Decision::processPendingPrefixUpdates() {
+  auto maybePerfEvents = pendingPrefixUpdates_.getPerfEvents();
+  pendingPrefixUpdates_.clear();
+  if (coldStartTimer_->isScheduled()) {
     return;
   }
 
-  fromStdOptional(maybeRouteDb.value().perfEvents_ref(), maybePerfEvents);
-  sendRouteUpdate(std::move(maybeRouteDb).value(), "DECISION_SPF");
+  if (maybePerfEvents) {
+    addPerfEvent(*maybePerfEvents, myNodeName_, "DECISION_DEBOUNCE");
+  }
+  // build routeDb once for all updates received, on the compute thread
+  LOG(INFO) << "Decision: scheduling routeDb update.";
+  scheduleRouteBuild(std::move(maybePerfEvents), "ROUTE_UPDATE");
 }
 
 void
-Decision::processPendingPrefixUpdates() {
+Decision::processPendingPrefixDeltaUpdates() {
   auto maybePerfEvents = pendingPrefixUpdates_.getPerfEvents();
   pendingPrefixUpdates_.clear();
   if (coldStartTimer_->isScheduled()) {
@@ -1756,40 +2629,128 @@ Decision::processPendingPrefixUpdates() {
   if (maybePerfEvents) {
     addPerfEvent(*maybePerfEvents, myNodeName_, "DECISION_DEBOUNCE");
   }
-  // update routeDb once for all updates received
-  LOG(INFO) << "Decision: updating new routeDb.";
-  auto maybeRouteDb = spfSolver_->buildRouteDb(myNodeName_);
-  if (not maybeRouteDb.has_value()) {
+  // only recompute routes for the prefixes that changed
+  LOG(INFO) << "Decision: updating changed routes.";
+  auto maybeRouteDelta = spfSolver_->buildRouteDelta(
+      myNodeName_, processUpdatesStatus_.changedPrefixes);
+  if (not maybeRouteDelta.has_value()) {
     LOG(WARNING) << "PrefixDb updates incurred no route updates";
     return;
   }
 
-  fromStdOptional(maybeRouteDb.value().perfEvents_ref(), maybePerfEvents);
-  sendRouteUpdate(std::move(maybeRouteDb).value(), "ROUTE_UPDATE");
+  applyRouteDatabaseDelta(maybeRouteDelta.value());
+
+  fromStdOptional(maybeRouteDelta.value().perfEvents_ref(), maybePerfEvents);
+  if (maybeRouteDelta.value().perfEvents_ref().has_value()) {
+    addPerfEvent(
+        maybeRouteDelta.value().perfEvents_ref().value(),
+        myNodeName_,
+        "ROUTE_UPDATE");
+  }
+
+  // publish the new route state
+  routeUpdatesQueue_.push(std::move(maybeRouteDelta.value()));
+}
+
+void
+Decision::applyRouteDatabaseDelta(thrift::RouteDatabaseDelta& delta) {
+  auto& routes = routeDb_.unicastRoutes;
+  // routeDb_ is kept sorted by sendRouteUpdate and by the insertions below;
+  // routes are unique per destination prefix
+  auto const lowerBound = [&routes](thrift::IpPrefix const& prefix) {
+    return std::lower_bound(
+        routes.begin(),
+        routes.end(),
+        prefix,
+        [](thrift::UnicastRoute const& route, thrift::IpPrefix const& p) {
+          return route.dest < p;
+        });
+  };
+
+  std::vector<thrift::UnicastRoute> toUpdate;
+  for (auto& route : delta.unicastRoutesToUpdate) {
+    auto iter = lowerBound(route.dest);
+    if (iter != routes.end() and iter->dest == route.dest) {
+      if (*iter == route) {
+        // no-op for Fib
+        continue;
+      }
+      *iter = route;
+    } else {
+      routes.insert(iter, route);
+    }
+    toUpdate.emplace_back(std::move(route));
+  }
+  delta.unicastRoutesToUpdate = std::move(toUpdate);
+
+  std::vector<thrift::IpPrefix> toDelete;
+  for (auto& prefix : delta.unicastRoutesToDelete) {
+    auto iter = lowerBound(prefix);
+    if (iter != routes.end() and iter->dest == prefix) {
+      routes.erase(iter);
+      toDelete.emplace_back(std::move(prefix));
+    }
+  }
+  delta.unicastRoutesToDelete = std::move(toDelete);
+
+  // emit the delta in the same sorted order findDeltaRoutes() produces
+  std::sort(
+      delta.unicastRoutesToUpdate.begin(), delta.unicastRoutesToUpdate.end());
+  std::sort(
+      delta.unicastRoutesToDelete.begin(), delta.unicastRoutesToDelete.end());
+}
+
+void
+Decision::maybeDecrementOrderedFibHolds() {
+  if (orderedFibTimer_ == nullptr or not orderedFibTimer_->isScheduled() or
+      not spfSolver_->hasHolds()) {
+    return;
+  }
+  // acks are only meaningful once we know who participates; a node announces
+  // itself by advertising its fib programming time
+  if (fibTimes_.empty()) {
+    return;
+  }
+  for (auto const& kv : fibTimes_) {
+    if (not fibAcksSinceDecrement_.count(kv.first)) {
+      return;
+    }
+  }
+  // every participant has programmed its routes since the last decrement -
+  // the current hop ring is done, release the holds without waiting out the
+  // worst-case timer
+  LOG(INFO) << "All nodes acked fib programming, decrementing holds early";
+  orderedFibTimer_->cancelTimeout();
+  decrementOrderedFibHolds();
+  if (spfSolver_->hasHolds()) {
+    orderedFibTimer_->scheduleTimeout(getMaxFib());
+  }
 }
 
 void
 Decision::decrementOrderedFibHolds() {
+  // caller must hold spfSolverMutex_
+  // start a fresh ack round for the next (timer- or ack-driven) decrement
+  fibAcksSinceDecrement_.clear();
   if (spfSolver_->decrementHolds()) {
     if (coldStartTimer_->isScheduled()) {
       return;
     }
-    auto maybeRouteDb = spfSolver_->buildRouteDb(myNodeName_);
-    if (not maybeRouteDb.has_value()) {
-      LOG(INFO) << "decrementOrderedFibHolds incurred no route updates";
-      return;
-    }
-
-    // Create empty perfEvents list. In this case we don't this route update to
-    // be inculded in the Fib time
-    maybeRouteDb.value().perfEvents_ref() = thrift::PerfEvents{};
-    sendRouteUpdate(
-        std::move(maybeRouteDb).value(), "ORDERED_FIB_HOLDS_EXPIRED");
+    // Pass empty perfEvents list. In this case we don't want this route
+    // update to be included in the Fib time
+    scheduleRouteBuild(thrift::PerfEvents{}, "ORDERED_FIB_HOLDS_EXPIRED");
   }
 }
 
 void
 Decision::coldStartUpdate() {
+  std::lock_guard<std::mutex> lock(spfSolverMutex_);
+  coldStartUpdateLocked();
+}
+
+void
+Decision::coldStartUpdateLocked() {
+  // caller must hold spfSolverMutex_
   auto maybeRouteDb = spfSolver_->buildRouteDb(myNodeName_);
   if (not maybeRouteDb.has_value()) {
     LOG(ERROR) << "SEVERE: No routes to program after cold start duration. "
@@ -7,9 +7,16 @@
 
 #pragma once
 
+#include <algorithm>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <boost/serialization/strong_typedef.hpp>
 #include <fbzmq/async/ZmqThrottle.h>
@@ -19,13 +26,18 @@
 #include <folly/IPAddress.h>
 #include <folly/Memory.h>
 #include <folly/String.h>
+#include <folly/Synchronized.h>
 #include <folly/futures/Future.h>
 #include <folly/io/async/AsyncTimeout.h>
+#if FOLLY_HAS_COROUTINES
+#include <folly/experimental/coro/Task.h>
+#endif
 #include <thrift/lib/cpp2/Thrift.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 
 #include <openr/common/ExponentialBackoff.h>
 #include <openr/common/OpenrEventBase.h>
+#include <openr/common/ReplayLog.h>
 #include <openr/common/Util.h>
 #include <openr/config/Config.h>
 #include <openr/if/gen-cpp2/Decision_types.h>
@@ -42,6 +54,10 @@ namespace openr {
 struct ProcessPublicationResult {
   bool adjChanged{false};
   bool prefixesChanged{false};
+  // exact prefixes dirtied by the publication; empty with prefixesChanged
+  // set means a change (e.g. route attributes) that dirties no specific
+  // prefix and needs a full route build
+  std::unordered_set<thrift::IpPrefix> changedPrefixes;
 };
 
 struct BestPathCalResult {
@@ -110,6 +126,76 @@ struct DecisionPendingUpdates {
   std::optional<int64_t> minTs_;
   std::optional<thrift::PerfEvents> perfEvents_;
 };
+
+/**
+ * Adaptive controller for the processPendingUpdates debounce window.
+ *
+ * Tracks exponentially-weighted averages of publication inter-arrival time
+ * and route recomputation runtime. When recomputation is cheap and arrivals
+ * are sparse it recommends the configured minimum window (fast convergence);
+ * when recomputation is expensive relative to the arrival rate it widens the
+ * window so several publications coalesce into one run instead of thrashing
+ * back-to-back recomputations.
+ */
+class DecisionDebounceController {
+ public:
+  DecisionDebounceController(
+      std::chrono::milliseconds minDur, std::chrono::milliseconds maxDur)
+      : configuredMin_(minDur), configuredMax_(maxDur) {}
+
+  // record a publication arrival
+  void
+  reportArrival() {
+    auto const now = std::chrono::steady_clock::now();
+    if (lastArrival_.has_value()) {
+      auto const interval =
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              now - lastArrival_.value())
+              .count();
+      arrivalIntervalMsEwma_ = kEwmaWeight * interval +
+          (1 - kEwmaWeight) * arrivalIntervalMsEwma_;
+    }
+    lastArrival_ = now;
+  }
+
+  // record how long the last route recomputation took
+  void
+  reportRouteBuildDuration(std::chrono::milliseconds duration) {
+    buildDurationMsEwma_ = kEwmaWeight * duration.count() +
+        (1 - kEwmaWeight) * buildDurationMsEwma_;
+  }
+
+  // recommended initial debounce, within the configured [min, max] bounds
+  std::chrono::milliseconds
+  initialBackoff() const {
+    double window = buildDurationMsEwma_;
+    if (arrivalIntervalMsEwma_ > 0 and
+        arrivalIntervalMsEwma_ < buildDurationMsEwma_) {
+      // publications arrive faster than we can recompute - widen the
+      // window proportionally so each run absorbs the backlog
+      window *= buildDurationMsEwma_ / arrivalIntervalMsEwma_;
+    }
+    window = std::max<double>(window, configuredMin_.count());
+    window = std::min<double>(window, configuredMax_.count());
+    return std::chrono::milliseconds(static_cast<int64_t>(window));
+  }
+
+  // the adaptive window never exceeds the configured maximum
+  std::chrono::milliseconds
+  maxBackoff() const {
+    return configuredMax_;
+  }
+
+ private:
+  // weight of the newest sample in the averages
+  static constexpr double kEwmaWeight{0.25};
+
+  const std::chrono::milliseconds configuredMin_;
+  const std::chrono::milliseconds configuredMax_;
+  double arrivalIntervalMsEwma_{0};
+  double buildDurationMsEwma_{0};
+  std::optional<std::chrono::steady_clock::time_point> lastArrival_;
+};
 } // namespace detail
 
 // The class to compute shortest-paths using Dijkstra algorithm
@@ -157,9 +243,18 @@ class SpfSolver {
       thrift::AdjacencyDatabase> const&
   getAdjacencyDatabases();
 
-  // update prefixes for a given router. Returns true if this has caused any
-  // routeDb change
-  bool updatePrefixDatabase(thrift::PrefixDatabase const& prefixDb);
+  // update prefixes for a given router. Returns the exact set of prefixes
+  // whose routes may have changed; empty means no routeDb change
+  std::unordered_set<thrift::IpPrefix> updatePrefixDatabase(
+      thrift::PrefixDatabase const& prefixDb);
+
+  // delta entry points for per-prefix key advertisements. Processing cost
+  // is proportional to the one prefix touched, not the node's full
+  // advertised set. Returns the same dirty set as updatePrefixDatabase
+  std::unordered_set<thrift::IpPrefix> updatePrefix(
+      const std::string& nodeName, thrift::PrefixEntry const& prefixEntry);
+  std::unordered_set<thrift::IpPrefix> withdrawPrefix(
+      const std::string& nodeName, thrift::IpPrefix const& prefix);
 
   // get prefix databases
   std::unordered_map<std::string /* nodeName */, thrift::PrefixDatabase>
@@ -171,10 +266,42 @@ class SpfSolver {
   std::optional<thrift::RouteDatabase> buildRouteDb(
       const std::string& myNodeName);
 
+  // Build only the routes for the given dirty prefixes, as a native delta
+  // for Fib. Returns std::nullopt if the set is empty or myNodeName is
+  // unknown
+  std::optional<thrift::RouteDatabaseDelta> buildRouteDelta(
+      const std::string& myNodeName,
+      std::unordered_set<thrift::IpPrefix> const& changedPrefixes);
+
   bool decrementHolds();
 
   void updateGlobalCounters();
 
+  //
+  // speculative precompute of likely single-link failure scenarios
+  //
+
+  // current topology generation; entries precomputed at an older
+  // generation are stale
+  int64_t getTopologyGeneration() const;
+
+  // scenario keys for the topK most likely single-link failures, most
+  // likely first (links attached to myNodeName, then the rest in
+  // deterministic order)
+  std::vector<std::string> getFailureScenarioLinks(
+      const std::string& myNodeName, size_t topK);
+
+  // what-if route build with the given link failed; the link is restored
+  // before returning. std::nullopt when the scenario no longer applies
+  std::optional<thrift::RouteDatabase> buildRouteDbExcludingLink(
+      const std::string& myNodeName, const std::string& linkKey);
+
+  // if the adjacency db update reduces to exactly one bidirectional link
+  // disappearing (every surviving adjacency carried unchanged), return
+  // that link's scenario key. Must be called before the update is applied
+  std::optional<std::string> detectSingleLinkDown(
+      thrift::AdjacencyDatabase const& newAdjacencyDb);
+
  private:
   // no-copy
   SpfSolver(SpfSolver const&) = delete;
@@ -215,7 +342,12 @@ class Decision : public OpenrEventBase {
       messaging::ReplicateQueue<thrift::RouteDatabaseDelta>& routeUpdatesQueue,
       fbzmq::Context& zmqContext);
 
-  virtual ~Decision() = default;
+  ~Decision() override;
+
+  /*
+   * Stop the route compute thread before stopping the event loop.
+   */
+  void stop() override;
 
   /*
    * Retrieve routeDb from specified node.
@@ -224,6 +356,17 @@ class Decision : public OpenrEventBase {
   folly::SemiFuture<std::unique_ptr<thrift::RouteDatabase>> getDecisionRouteDb(
       std::string nodeName);
 
+#if FOLLY_HAS_COROUTINES
+  /*
+   * Coroutine-native variant of getDecisionRouteDb(). The route build is
+   * guarded by spfSolverMutex_, so it runs inline on the caller's
+   * executor as one coroutine frame - no promise/future pair and no
+   * event-base hop.
+   */
+  folly::coro::Task<std::unique_ptr<thrift::RouteDatabase>>
+  getDecisionRouteDbCoro(std::string nodeName);
+#endif
+
   folly::SemiFuture<std::unique_ptr<thrift::StaticRoutes>>
   getDecisionStaticRoutes();
 
@@ -232,11 +375,25 @@ class Decision : public OpenrEventBase {
    */
   folly::SemiFuture<std::unique_ptr<thrift::AdjDbs>> getDecisionAdjacencyDbs();
 
+  /*
+   * Retrieve the immutable adjacency-database snapshot without copying it.
+   * Only touches the Decision loop when the snapshot is stale; callers may
+   * expand/copy the shared snapshot on whatever thread suits them.
+   */
+  folly::SemiFuture<std::shared_ptr<thrift::AdjDbs const>>
+  getDecisionAdjacencyDbsSnapshot();
+
   /*
    * Retrieve PrefixDatabase as a map.
    */
   folly::SemiFuture<std::unique_ptr<thrift::PrefixDbs>> getDecisionPrefixDbs();
 
+  /*
+   * Same contract as getDecisionAdjacencyDbsSnapshot, for prefix databases.
+   */
+  folly::SemiFuture<std::shared_ptr<thrift::PrefixDbs const>>
+  getDecisionPrefixDbsSnapshot();
+
  private:
   Decision(Decision const&) = delete;
   Decision& operator=(Decision const&) = delete;
@@ -245,6 +402,10 @@ class Decision : public OpenrEventBase {
   ProcessPublicationResult processPublication(
       thrift::Publication const& thriftPub);
 
+  // apply one KvStore publication to SpfSolver state and schedule the
+  // debounced route computation. Caller must hold spfSolverMutex_
+  void applyPublication(thrift::Publication const& thriftPub);
+
   // process static routes publication from prefix manager.
   void processStaticRouteUpdates();
 
@@ -265,6 +426,10 @@ class Decision : public OpenrEventBase {
   // openr config
   std::shared_ptr<const Config> config_;
 
+  // capture of the incoming publication stream for offline replay, only
+  // set when event_capture_dir is configured
+  std::unique_ptr<ReplayLogWriter> replayLogWriter_{nullptr};
+
   // callback timer used on startup to publish routes after
   // gracefulRestartDuration
   std::unique_ptr<folly::AsyncTimeout> coldStartTimer_{nullptr};
@@ -278,6 +443,9 @@ class Decision : public OpenrEventBase {
   std::unique_ptr<folly::AsyncTimeout> processUpdatesTimer_;
   ExponentialBackoff<std::chrono::milliseconds> processUpdatesBackoff_;
 
+  // adapts the debounce window to recent recompute cost and arrival rate
+  detail::DecisionDebounceController debounceController_;
+
   // store update to-do status
   ProcessPublicationResult processUpdatesStatus_;
 
@@ -297,14 +465,43 @@ class Decision : public OpenrEventBase {
   void processPendingAdjUpdates();
 
   /**
-   * Function to process prefix updates.
+   * Function to process prefix updates with a full route build.
    */
   void processPendingPrefixUpdates();
 
+  /**
+   * Function to process prefix updates natively as a route delta, only
+   * recomputing routes for the prefixes that changed.
+   */
+  void processPendingPrefixDeltaUpdates();
+
+  /**
+   * Drop entries of the delta that match routeDb_ (no-ops for Fib) and fold
+   * the remainder into routeDb_, so later full rebuilds diff against
+   * accurate state.
+   */
+  void applyRouteDatabaseDelta(thrift::RouteDatabaseDelta& delta);
+
   void decrementOrderedFibHolds();
 
+  /**
+   * Release ordered-fib holds early once every participating node has acked
+   * programming its routes (kFibAckMarker keys) since the last decrement,
+   * instead of waiting out the worst-case fib-programming timer.
+   */
+  void maybeDecrementOrderedFibHolds();
+
   void coldStartUpdate();
 
+  // cold-start route build; caller must hold spfSolverMutex_
+  void coldStartUpdateLocked();
+
+  // build the route database dump for the given node (own node when
+  // empty); shared by getDecisionRouteDb() and its coroutine variant.
+  // Takes spfSolverMutex_, safe to call from any thread
+  std::unique_ptr<thrift::RouteDatabase> buildDecisionRouteDb(
+      std::string nodeName);
+
   void sendRouteUpdate(
       thrift::RouteDatabase&& db, std::string const& eventDescription);
 
@@ -314,8 +511,24 @@ class Decision : public OpenrEventBase {
   thrift::PrefixDatabase updateNodePrefixDatabase(
       const std::string& key, const thrift::PrefixDatabase& prefixDb);
 
+  // incrementally apply a per-prefix key publication through SpfSolver's
+  // delta entry points - the node's full prefix set is neither rebuilt nor
+  // re-diffed. Returns std::nullopt when the node also advertises a
+  // monolithic prefix db key, in which case the caller must take the
+  // full-merge path above so per-prefix entries keep shadowing it
+  std::optional<std::unordered_set<thrift::IpPrefix>> updateNodePrefixKey(
+      const PrefixKey& prefixKey, const thrift::PrefixDatabase& prefixDb);
+
   thrift::RouteDatabase routeDb_;
 
+  // immutable copy-on-write snapshots served to the debug dump APIs.
+  // Invalidated (reset) by LSDB mutations and rebuilt on the Decision loop
+  // only when a dump finds them stale, so steady-state polls copy off the
+  // snapshot on the caller's thread and never block SPF processing
+  folly::Synchronized<std::shared_ptr<thrift::AdjDbs const>> adjDbsSnapshot_;
+  folly::Synchronized<std::shared_ptr<thrift::PrefixDbs const>>
+      prefixDbsSnapshot_;
+
   // Queue to publish route changes
   messaging::ReplicateQueue<thrift::RouteDatabaseDelta>& routeUpdatesQueue_;
 
@@ -326,6 +539,11 @@ class Decision : public OpenrEventBase {
   // across the network
   std::unordered_map<std::string, std::chrono::milliseconds> fibTimes_;
 
+  // For orderedFib programming: highest programming-completion ack sequence
+  // seen per node, and the nodes that acked since the last hold decrement
+  std::unordered_map<std::string, int64_t> fibAckSeqs_;
+  std::unordered_set<std::string> fibAcksSinceDecrement_;
+
   apache::thrift::CompactSerializer serializer_;
 
   // base interval to submit to monitor with (jitter will be added)
@@ -349,6 +567,85 @@ class Decision : public OpenrEventBase {
 
   // this node's name and the key markers
   const std::string myNodeName_;
+
+  /**
+   * Consumer/compute split. The Decision evb acts as the consumer: it
+   * drains publications and applies them to SpfSolver state. Full route
+   * builds run on a dedicated compute thread so late-arriving updates
+   * are not stuck behind an in-progress SPF run. Scheduling is
+   * latest-wins: a queued-but-not-started build is replaced by a newer
+   * one, so SPF never runs for an already-stale topology.
+   */
+  struct RouteBuildRequest {
+    std::optional<thrift::PerfEvents> perfEvents;
+    std::string eventDescription;
+  };
+
+  // queue a route build towards the compute thread, superseding any
+  // build still waiting to start
+  void scheduleRouteBuild(
+      std::optional<thrift::PerfEvents> perfEvents,
+      std::string eventDescription);
+
+  // body of the compute thread
+  void routeComputeLoop() noexcept;
+
+  // runs on the Decision evb once a build finishes: flushes publications
+  // buffered during the build and publishes the new routes
+  void onRouteBuildDone(
+      std::optional<thrift::RouteDatabase> maybeRouteDb,
+      std::optional<thrift::PerfEvents> perfEvents,
+      std::string const& eventDescription,
+      std::chrono::milliseconds buildDuration);
+
+  // evb-side: apply publications that were buffered while the compute
+  // thread held the solver
+  void flushBufferedPublications();
+
+  /**
+   * Speculative precompute of likely failures. When enabled, an idle
+   * compute thread builds the route database for the topK most likely
+   * single-link failure scenarios against the current topology
+   * generation. When a publication later reports exactly one of those
+   * links going down, the cached routes are published immediately - the
+   * common-case failure converges with a cache lookup instead of waiting
+   * on debounce plus a fresh SPF run. The regular (debounced) build is
+   * still scheduled as a safety net; it diffs to an empty delta when the
+   * cached answer was right.
+   */
+  struct PrecomputedFailure {
+    int64_t generation{0};
+    thrift::RouteDatabase routeDb;
+  };
+
+  // one idle-time slice: evict stale entries and build at most one
+  // missing scenario. Runs on the compute thread
+  void precomputeFailureScenarios();
+
+  // cached scenario routes keyed by link scenario key; guarded by
+  // spfSolverMutex_
+  std::unordered_map<std::string, PrecomputedFailure> failureCache_;
+
+  bool enableFailurePrecompute_{false};
+  size_t failurePrecomputeTopK_{0};
+
+  // serializes SpfSolver access between the consumer and the compute
+  // thread. Consumer-side holders are short-lived; the compute thread
+  // holds it for the duration of one buildRouteDb() run
+  std::mutex spfSolverMutex_;
+
+  // latest-wins request slot towards the compute thread
+  std::mutex computeMutex_;
+  std::condition_variable computeCv_;
+  std::optional<RouteBuildRequest> computeRequest_;
+  bool computeStopRequested_{false};
+
+  // publications received while the compute thread held the solver;
+  // flushed on the evb right after the build completes
+  std::deque<thrift::Publication> bufferedPublications_;
+
+  // the compute thread described above
+  std::thread routeComputeThread_;
 };
 
 } // namespace openr
@@ -9,10 +9,12 @@
 
 #include <algorithm>
 #include <functional>
+#include <iterator>
 #include <utility>
 
 #include <fb303/ServiceData.h>
 #include <folly/Format.h>
+#include <folly/futures/Future.h>
 #include <openr/common/Util.h>
 
 namespace fb303 = facebook::fb303;
@@ -168,6 +170,19 @@ Link::getOtherNodeName(const std::string& nodeName) const {
   throw std::invalid_argument(nodeName);
 }
 
+void
+Link::setNodeIds(uint32_t firstNodeId, uint32_t secondNodeId) {
+  // ids arrive in name order; map them onto the constructor-order
+  // endpoints so the id accessors mirror the name-based ones
+  if (firstNodeName() == n1_) {
+    id1_ = firstNodeId;
+    id2_ = secondNodeId;
+  } else {
+    id1_ = secondNodeId;
+    id2_ = firstNodeId;
+  }
+}
+
 const std::string&
 Link::firstNodeName() const {
   return orderedNames_.first.first;
@@ -395,27 +410,60 @@ LinkState::traceOnePath(
     std::string const& dest,
     SpfResult const& result,
     LinkSet const& linksToIgnore) {
+  std::unordered_map<std::string, std::optional<Path>> subPathMemo;
+  return traceOnePath(src, dest, result, linksToIgnore, subPathMemo);
+}
+
+std::optional<LinkState::Path>
+LinkState::traceOnePath(
+    std::string const& src,
+    std::string const& dest,
+    SpfResult const& result,
+    LinkSet const& linksToIgnore,
+    std::unordered_map<std::string, std::optional<Path>>& subPathMemo) {
   if (src == dest) {
     return LinkState::Path{};
   }
+  auto const memoIter = subPathMemo.find(dest);
+  if (memoIter != subPathMemo.end()) {
+    return memoIter->second;
+  }
   auto const& nodeResult = result.at(dest);
   for (auto const& pathLink : nodeResult.pathLinks()) {
     if (!linksToIgnore.count(pathLink.link)) {
-      auto path = traceOnePath(src, pathLink.prevNode, result, linksToIgnore);
+      auto path = traceOnePath(
+          src, pathLink.prevNode, result, linksToIgnore, subPathMemo);
       if (path) {
         path->push_back(pathLink.link);
+        subPathMemo[dest] = path;
         return path;
       }
     }
   }
+  subPathMemo[dest] = std::nullopt;
   return std::nullopt;
 }
 
+uint32_t
+LinkState::nodeId(const std::string& nodeName) {
+  auto it = nodeIds_.find(nodeName);
+  if (it == nodeIds_.end()) {
+    it = nodeIds_.emplace(nodeName, nodeNames_.size()).first;
+    nodeNames_.push_back(nodeName);
+    // the CSR offset array covers one span per known id
+    csrDirty_ = true;
+  }
+  return it->second;
+}
+
 void
 LinkState::addLink(std::shared_ptr<Link> link) {
+  link->setNodeIds(
+      nodeId(link->firstNodeName()), nodeId(link->secondNodeName()));
   CHECK(linkMap_[link->firstNodeName()].insert(link).second);
   CHECK(linkMap_[link->secondNodeName()].insert(link).second);
   CHECK(allLinks_.insert(link).second);
+  csrDirty_ = true;
 }
 
 // throws std::out_of_range if links are not present
@@ -424,6 +472,17 @@ LinkState::removeLink(std::shared_ptr<Link> link) {
   CHECK(linkMap_.at(link->firstNodeName()).erase(link));
   CHECK(linkMap_.at(link->secondNodeName()).erase(link));
   CHECK(allLinks_.erase(link));
+  linksWithHolds_.erase(link);
+  csrDirty_ = true;
+}
+
+void
+LinkState::trackLinkHolds(std::shared_ptr<Link> const& link) {
+  if (link->hasHolds()) {
+    linksWithHolds_.insert(link);
+  } else {
+    linksWithHolds_.erase(link);
+  }
 }
 
 void
@@ -439,12 +498,15 @@ LinkState::removeNode(const std::string& nodeName) {
     try {
       CHECK(linkMap_.at(link->getOtherNodeName(nodeName)).erase(link));
       CHECK(allLinks_.erase(link));
+      linksWithHolds_.erase(link);
     } catch (std::out_of_range const& e) {
       LOG(FATAL) << "std::out_of_range for " << nodeName;
     }
   }
   linkMap_.erase(search);
   nodeOverloads_.erase(nodeName);
+  heldNodeOverloads_.erase(nodeName);
+  csrDirty_ = true;
 }
 
 const LinkState::LinkSet&
@@ -470,6 +532,29 @@ LinkState::orderedLinksFromNode(const std::string& nodeName) const {
   return links;
 }
 
+void
+LinkState::rebuildCsrAdjacency() {
+  csrOffsets_.assign(nodeNames_.size() + 1, 0);
+  csrEdges_.clear();
+  csrEdges_.reserve(2 * allLinks_.size());
+  for (uint32_t id = 0; id < nodeNames_.size(); ++id) {
+    csrOffsets_[id] = csrEdges_.size();
+    auto search = linkMap_.find(nodeNames_[id]);
+    if (search == linkMap_.end()) {
+      continue;
+    }
+    for (auto const& link : search->second) {
+      csrEdges_.push_back(CsrEdge{
+          link->getOtherNodeId(id),
+          link->isUp(),
+          link->getMetricFromNodeId(id),
+          link});
+    }
+  }
+  csrOffsets_[nodeNames_.size()] = csrEdges_.size();
+  csrDirty_ = false;
+}
+
 bool
 LinkState::updateNodeOverloaded(
     const std::string& nodeName,
@@ -477,8 +562,14 @@ LinkState::updateNodeOverloaded(
     LinkStateMetric holdUpTtl,
     LinkStateMetric holdDownTtl) {
   if (nodeOverloads_.count(nodeName)) {
-    return nodeOverloads_.at(nodeName).updateValue(
+    bool const changed = nodeOverloads_.at(nodeName).updateValue(
         isOverloaded, holdUpTtl, holdDownTtl);
+    if (nodeOverloads_.at(nodeName).hasHold()) {
+      heldNodeOverloads_.insert(nodeName);
+    } else {
+      heldNodeOverloads_.erase(nodeName);
+    }
+    return changed;
   }
   nodeOverloads_.emplace(nodeName, HoldableValue<bool>{isOverloaded});
   // don't indicate LinkState changed if this is a new node
@@ -492,33 +583,30 @@ LinkState::isNodeOverloaded(const std::string& nodeName) const {
 
 bool
 LinkState::decrementHolds() {
+  // only entries in the hold indices can change here; links and node
+  // overloads without holds are no-ops for decrement
   bool holdChange = false;
-  for (auto& link : allLinks_) {
-    holdChange |= link->decrementHolds();
+  for (auto it = linksWithHolds_.begin(); it != linksWithHolds_.end();) {
+    holdChange |= (*it)->decrementHolds();
+    it = (*it)->hasHolds() ? std::next(it) : linksWithHolds_.erase(it);
   }
-  for (auto& kv : nodeOverloads_) {
-    holdChange |= kv.second.decrementTtl();
+  for (auto it = heldNodeOverloads_.begin(); it != heldNodeOverloads_.end();) {
+    auto& overload = nodeOverloads_.at(*it);
+    holdChange |= overload.decrementTtl();
+    it = overload.hasHold() ? std::next(it) : heldNodeOverloads_.erase(it);
   }
   if (holdChange) {
     spfResults_.clear();
     kthPathResults_.clear();
+    maxHopsResults_.clear();
+    csrDirty_ = true;
   }
   return holdChange;
 }
 
 bool
 LinkState::hasHolds() const {
-  for (auto& link : allLinks_) {
-    if (link->hasHolds()) {
-      return true;
-    }
-  }
-  for (auto& kv : nodeOverloads_) {
-    if (kv.second.hasHold()) {
-      return true;
-    }
-  }
-  return false;
+  return not linksWithHolds_.empty() or not heldNodeOverloads_.empty();
 }
 
 std::shared_ptr<Link>
@@ -554,6 +642,47 @@ LinkState::getOrderedLinkSet(const thrift::AdjacencyDatabase& adjDb) const {
   return links;
 }
 
+namespace {
+
+// return true if the shortest-path DAG stored in result traversed any of
+// the given links. The pathLinks record exactly the links each SPF tree
+// used, so they double as the dependency set for cache invalidation
+bool
+spfTreeUsesAny(
+    LinkState::SpfResult const& result,
+    std::vector<std::shared_ptr<Link>> const& links) {
+  if (links.empty()) {
+    return false;
+  }
+  for (auto const& entry : result) {
+    for (auto const& pathLink : entry.second.pathLinks()) {
+      for (auto const& link : links) {
+        if (pathLink.link == link) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+// return true if any shortest path in result goes through the given node,
+// i.e. the node contributed next hops as somebody's DAG parent
+bool
+spfTreeTransitsNode(
+    LinkState::SpfResult const& result, std::string const& nodeName) {
+  for (auto const& entry : result) {
+    for (auto const& pathLink : entry.second.pathLinks()) {
+      if (pathLink.prevNode == nodeName) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+} // namespace
+
 std::pair<
     bool /* topology has changed*/,
     bool /* route attributes has changed (nexthop addr, node/adj label */>
@@ -576,6 +705,10 @@ LinkState::updateAdjacencyDatabase(
       std::move(adjacencyDatabases_[nodeName]));
   // replace
   adjacencyDatabases_[nodeName] = newAdjacencyDb;
+  ++generation_;
+  if (adjDbSnapshot_) {
+    snapshotDirtyNodes_.insert(nodeName);
+  }
 
   // for comparing old and new state, we order the links based on the tuple
   // <nodeName1, iface1, nodeName2, iface2>, this allows us to easily discern
@@ -590,6 +723,31 @@ LinkState::updateAdjacencyDatabase(
   bool topoChanged = updateNodeOverloaded(
       nodeName, newAdjacencyDb.isOverloaded, holdUpTtl, holdDownTtl);
 
+  // metric changes applied without a hold, eligible for incremental SPF
+  // patching of the memoized results; any other kind of topology change
+  // forces the full recompute below
+  std::vector<std::pair<std::shared_ptr<Link>, LinkStateMetric /* old */>>
+      metricChanges;
+  bool nonMetricTopoChange = topoChanged;
+
+  // classify the update for cache invalidation. Changes that only remove
+  // capacity (links going down, metrics increasing, overloads being set)
+  // cannot create new shortest paths, so only the cached trees that
+  // actually depended on the affected link or node need to be dropped.
+  // Any additive change may improve paths for arbitrary sources and
+  // still flushes the whole cache
+  std::vector<std::shared_ptr<Link>> downedLinks;
+  std::vector<std::shared_ptr<Link>> increasedMetricLinks;
+  bool restrictiveNodeOverload{false};
+  bool additiveChange{false};
+  if (topoChanged) {
+    if (isNodeOverloaded(nodeName)) {
+      restrictiveNodeOverload = true;
+    } else {
+      additiveChange = true;
+    }
+  }
+
   bool routeAttrChanged = false;
 
   routeAttrChanged |= priorAdjacencyDb.nodeLabel != newAdjacencyDb.nodeLabel;
@@ -603,10 +761,13 @@ LinkState::updateAdjacencyDatabase(
       // link to add and advance newIter
       (*newIter)->setHoldUpTtl(holdUpTtl);
       topoChanged |= (*newIter)->isUp();
+      nonMetricTopoChange |= (*newIter)->isUp();
+      additiveChange |= (*newIter)->isUp();
       // even if we are holding a change, we apply the change to our link state
       // and check for holds when running spf. this ensures we don't add the
       // same hold twice
       addLink(*newIter);
+      trackLinkHolds(*newIter);
       VLOG(1) << "addLink " << (*newIter)->toString();
       ++newIter;
       continue;
@@ -618,6 +779,10 @@ LinkState::updateAdjacencyDatabase(
       // If this link was previously overloaded or had a hold up, this does not
       // change the topology.
       topoChanged |= (*oldIter)->isUp();
+      nonMetricTopoChange |= (*oldIter)->isUp();
+      if ((*oldIter)->isUp()) {
+        downedLinks.push_back(*oldIter);
+      }
       removeLink(*oldIter);
       VLOG(1) << "removeLink " << (*oldIter)->toString();
       ++oldIter;
@@ -632,16 +797,27 @@ LinkState::updateAdjacencyDatabase(
     // change the metric on the link object we already have
     if (newLink.getMetricFromNode(nodeName) !=
         oldLink.getMetricFromNode(nodeName)) {
+      auto const oldMetric = oldLink.getMetricFromNode(nodeName);
       LOG(INFO) << folly::sformat(
           "Metric change on link {}: {} => {}",
           newLink.directionalToString(nodeName),
-          oldLink.getMetricFromNode(nodeName),
+          oldMetric,
           newLink.getMetricFromNode(nodeName));
       topoChanged = oldLink.setMetricFromNode(
           nodeName,
           newLink.getMetricFromNode(nodeName),
           holdUpTtl,
           holdDownTtl);
+      trackLinkHolds(*oldIter);
+      if (topoChanged) {
+        metricChanges.emplace_back(*oldIter, oldMetric);
+        csrDirty_ = true;
+        if (oldLink.getMetricFromNode(nodeName) > oldMetric) {
+          increasedMetricLinks.push_back(*oldIter);
+        } else {
+          additiveChange = true;
+        }
+      }
     }
 
     if (newLink.getOverloadFromNode(nodeName) !=
@@ -656,6 +832,16 @@ LinkState::updateAdjacencyDatabase(
           newLink.getOverloadFromNode(nodeName),
           holdUpTtl,
           holdDownTtl);
+      trackLinkHolds(*oldIter);
+      nonMetricTopoChange |= topoChanged;
+      csrDirty_ |= topoChanged;
+      if (topoChanged) {
+        if ((*oldIter)->isUp()) {
+          additiveChange = true;
+        } else {
+          downedLinks.push_back(*oldIter);
+        }
+      }
     }
 
     // Check if adjacency label has changed
@@ -702,8 +888,58 @@ LinkState::updateAdjacencyDatabase(
     ++oldIter;
   }
   if (topoChanged) {
-    spfResults_.clear();
-    kthPathResults_.clear();
+    if (not nonMetricTopoChange and 1 == metricChanges.size()) {
+      // a lone metric change on an existing link cannot partition the
+      // graph; patch the memoized SPF results in place instead of paying
+      // a full Dijkstra per source on the next lookup. Hop-count results
+      // do not depend on link metrics and stay valid untouched
+      auto const& change = metricChanges.front();
+      std::unordered_set<std::string> changedTrees;
+      for (auto& entry : spfResults_) {
+        if (entry.first.second /* useLinkMetric */) {
+          if (patchSpfResult(
+                  entry.second,
+                  entry.first.first,
+                  change.first,
+                  nodeName,
+                  change.second)) {
+            changedTrees.insert(entry.first.first);
+          }
+        }
+      }
+      pruneKthPathResults({change.first}, false, changedTrees);
+    } else if (not additiveChange) {
+      // only capacity was removed: a cached tree that never traversed a
+      // downed link, never transited this (now overloaded) node and, for
+      // metric-aware trees, never used a link whose metric grew is still
+      // valid and stays warm. Metric increases cannot invalidate
+      // hop-count results at all
+      for (auto it = spfResults_.begin(); it != spfResults_.end();) {
+        bool const affected = spfTreeUsesAny(it->second, downedLinks) or
+            (restrictiveNodeOverload and it->first.first != nodeName and
+             spfTreeTransitsNode(it->second, nodeName)) or
+            (it->first.second /* useLinkMetric */ and
+             spfTreeUsesAny(it->second, increasedMetricLinks));
+        if (affected) {
+          if (not it->first.second /* hop-count tree */) {
+            maxHopsResults_.erase(it->first.first);
+          }
+          it = spfResults_.erase(it);
+        } else {
+          ++it;
+        }
+      }
+      auto affectedLinks = downedLinks;
+      affectedLinks.insert(
+          affectedLinks.end(),
+          increasedMetricLinks.begin(),
+          increasedMetricLinks.end());
+      pruneKthPathResults(affectedLinks, restrictiveNodeOverload, {});
+    } else {
+      spfResults_.clear();
+      kthPathResults_.clear();
+      maxHopsResults_.clear();
+    }
   }
   return std::make_pair(topoChanged, routeAttrChanged);
 }
@@ -720,11 +956,65 @@ LinkState::deleteAdjacencyDatabase(const std::string& nodeName) {
   }
   removeNode(nodeName);
   adjacencyDatabases_.erase(search);
+  ++generation_;
+  if (adjDbSnapshot_) {
+    snapshotDirtyNodes_.insert(nodeName);
+  }
   spfResults_.clear();
   kthPathResults_.clear();
+  maxHopsResults_.clear();
   return true;
 }
 
+void
+LinkState::setLinkScenarioOverload(
+    const std::shared_ptr<Link>& link, bool overload) {
+  // both directions with no holds - we don't support simplex overloads
+  // and the scenario must not leave held values behind when restored
+  link->setOverloadFromNode(link->firstNodeName(), overload, 0, 0);
+  link->setOverloadFromNode(link->secondNodeName(), overload, 0, 0);
+  // memoized results computed before the flip are wrong for the scenario
+  // (and scenario results are wrong for the restored state)
+  spfResults_.clear();
+  kthPathResults_.clear();
+  maxHopsResults_.clear();
+  csrDirty_ = true;
+}
+
+std::shared_ptr<LinkState::AdjacencyDbSnapshot const>
+LinkState::getAdjacencyDbSnapshot() {
+  if (adjDbSnapshot_ and snapshotDirtyNodes_.empty()) {
+    return adjDbSnapshot_;
+  }
+
+  auto snapshot = std::make_shared<AdjacencyDbSnapshot>();
+  snapshot->generation = generation_;
+  if (adjDbSnapshot_) {
+    // start from the previous cut and re-copy only the mutated nodes; the
+    // untouched per-node databases are shared between the two snapshots
+    snapshot->adjacencyDatabases = adjDbSnapshot_->adjacencyDatabases;
+    for (auto const& nodeName : snapshotDirtyNodes_) {
+      auto it = adjacencyDatabases_.find(nodeName);
+      if (it == adjacencyDatabases_.end()) {
+        snapshot->adjacencyDatabases.erase(nodeName);
+      } else {
+        snapshot->adjacencyDatabases[nodeName] =
+            std::make_shared<thrift::AdjacencyDatabase const>(it->second);
+      }
+    }
+  } else {
+    for (auto const& kv : adjacencyDatabases_) {
+      snapshot->adjacencyDatabases.emplace(
+          kv.first,
+          std::make_shared<thrift::AdjacencyDatabase const>(kv.second));
+    }
+  }
+
+  snapshotDirtyNodes_.clear();
+  adjDbSnapshot_ = std::move(snapshot);
+  return adjDbSnapshot_;
+}
+
 LinkStateMetric
 LinkState::getHopsFromAToB(std::string const& a, std::string const& b) {
   if (a == b) {
@@ -739,10 +1029,15 @@ LinkState::getHopsFromAToB(std::string const& a, std::string const& b) {
 
 LinkStateMetric
 LinkState::getMaxHopsToNode(const std::string& nodeName) {
+  auto entryIter = maxHopsResults_.find(nodeName);
+  if (maxHopsResults_.end() != entryIter) {
+    return entryIter->second;
+  }
   LinkStateMetric max = 0;
   for (auto const& pathsFromNode : getSpfResult(nodeName, false)) {
     max = std::max(max, pathsFromNode.second.metric());
   }
+  maxHopsResults_.emplace(nodeName, max);
   return max;
 }
 
@@ -780,6 +1075,50 @@ LinkState::getKthPaths(
   return entryIter->second;
 }
 
+void
+LinkState::warmSpfResults(
+    std::vector<std::string> const& nodeNames,
+    folly::Executor* executor,
+    bool useLinkMetric) {
+  std::vector<std::string const*> toCompute;
+  std::unordered_set<std::string> seen;
+  for (auto const& nodeName : nodeNames) {
+    if (not spfResults_.count({nodeName, useLinkMetric}) and
+        seen.emplace(nodeName).second) {
+      toCompute.push_back(&nodeName);
+    }
+  }
+  if (toCompute.size() <= 1 or nullptr == executor) {
+    for (auto const* nodeName : toCompute) {
+      getSpfResult(*nodeName, useLinkMetric);
+    }
+    return;
+  }
+
+  // intern the sources and build the CSR adjacency serially; after this
+  // each runSpf() only reads shared state and fills an independent result
+  for (auto const* nodeName : toCompute) {
+    nodeId(*nodeName);
+  }
+  if (csrDirty_) {
+    rebuildCsrAdjacency();
+  }
+  std::vector<folly::Future<SpfResult>> spfFutures;
+  spfFutures.reserve(toCompute.size());
+  for (auto const* nodeName : toCompute) {
+    spfFutures.emplace_back(
+        folly::via(executor, [this, nodeName, useLinkMetric]() {
+          return runSpf(*nodeName, useLinkMetric);
+        }));
+  }
+  auto spfTries = folly::collectAll(std::move(spfFutures)).get();
+  for (size_t i = 0; i < toCompute.size(); ++i) {
+    spfResults_.emplace(
+        std::make_pair(*toCompute[i], useLinkMetric),
+        std::move(spfTries[i].value()));
+  }
+}
+
 LinkState::SpfResult const&
 LinkState::getSpfResult(const std::string& thisNodeName, bool useLinkMetric) {
   std::pair<std::string, bool> key{thisNodeName, useLinkMetric};
@@ -791,6 +1130,257 @@ LinkState::getSpfResult(const std::string& thisNodeName, bool useLinkMetric) {
   return entryIter->second;
 }
 
+/**
+ * Patch the SPF result of src in place after the metric of the directed
+ * edge fromNode -> toNode changed from oldMetric to its current value.
+ *
+ * Classic dynamic shortest-path maintenance: unsettle toNode and its
+ * subtree in the shortest-path DAG (the only nodes whose distance or
+ * path set can be affected), seed a Dijkstra queue from the settled
+ * boundary and re-run the relaxation. Settled nodes are pulled back in
+ * only when a re-settled neighbor offers a strictly better path or an
+ * equal-cost path whose next-hop contribution changed, so unaffected
+ * regions of the graph are never touched.
+ *
+ * Returns false when the change provably left the result untouched.
+ */
+bool
+LinkState::patchSpfResult(
+    SpfResult& result,
+    const std::string& src,
+    std::shared_ptr<Link> const& link,
+    const std::string& fromNode,
+    LinkStateMetric oldMetric) {
+  auto const& toNode = link->getOtherNodeName(fromNode);
+  auto const newMetric = link->getMetricFromNode(fromNode);
+  auto const fromIter = result.find(fromNode);
+  auto const toIter = result.find(toNode);
+  if (fromIter == result.end() or toIter == result.end()) {
+    // the changed edge is not reachable from src and cannot carry or
+    // create any shortest path
+    return false;
+  }
+  if (isNodeOverloaded(fromNode) and fromNode != src) {
+    // no transit traffic through fromNode, so no shortest path uses the
+    // directed edge either way
+    return false;
+  }
+  auto const dFrom = fromIter->second.metric();
+  auto const dTo = toIter->second.metric();
+  if (newMetric > oldMetric and dFrom + oldMetric != dTo) {
+    // the edge was on no shortest path towards toNode and just got worse
+    return false;
+  }
+  if (newMetric < oldMetric and dFrom + newMetric > dTo) {
+    // the edge is still not competitive at its new metric
+    return false;
+  }
+
+  fb303::fbData->addStatValue("decision.spf_patch_runs", 1, fb303::COUNT);
+  const auto startTime = std::chrono::steady_clock::now();
+
+  // collect the affected region: toNode plus every node with toNode on
+  // some shortest path. pathLinks hold the DAG parents, so build the
+  // child lists once and walk them from toNode
+  std::unordered_map<std::string, std::vector<std::string>> children;
+  for (auto const& kv : result) {
+    for (auto const& pathLink : kv.second.pathLinks()) {
+      children[pathLink.prevNode].push_back(kv.first);
+    }
+  }
+
+  // prior keeps the pre-patch entry of every node we unsettle. It tells
+  // us whether a re-settled node actually changed (unchanged nodes stop
+  // the ripple) and guarantees each node is unsettled at most once
+  std::unordered_map<std::string, NodeSpfResult> prior;
+  std::vector<std::string> unsettled{toNode};
+  prior.emplace(toNode, std::move(toIter->second));
+  result.erase(toIter);
+  for (size_t i = 0; i < unsettled.size(); ++i) {
+    auto const childrenIter = children.find(unsettled[i]);
+    if (childrenIter == children.end()) {
+      continue;
+    }
+    for (auto const& child : childrenIter->second) {
+      auto const resultIter = result.find(child);
+      if (resultIter == result.end()) {
+        continue;
+      }
+      prior.emplace(child, std::move(resultIter->second));
+      result.erase(resultIter);
+      unsettled.push_back(child);
+    }
+  }
+
+  DijkstraQ q;
+
+  // relax into an unsettled node from all of its currently settled
+  // neighbors; mirrors the relax step of runSpf
+  auto const seedFromSettled = [&](std::string const& name) {
+    for (auto const& l : linksFromNode(name)) {
+      if (not l->isUp()) {
+        continue;
+      }
+      auto const& neighbor = l->getOtherNodeName(name);
+      auto const settled = result.find(neighbor);
+      if (settled == result.end() or
+          (isNodeOverloaded(neighbor) and neighbor != src)) {
+        continue;
+      }
+      auto const d = settled->second.metric() + l->getMetricFromNode(neighbor);
+      auto node = q.get(name);
+      if (not node) {
+        q.insertNode(name, d);
+        node = q.get(name);
+      }
+      if (node->result.metric() >= d) {
+        if (node->result.metric() > d) {
+          node->result.reset(d);
+          q.reMake();
+        }
+        node->result.addPath(l, neighbor);
+        if (neighbor == src) {
+          // a direct shortest-path neighbor of the source is its own
+          // next hop. Unlike runSpf we cannot rely on the source being
+          // relaxed first here, so apply the rule explicitly
+          node->result.addNextHop(name);
+        } else {
+          node->result.addNextHops(settled->second.nextHops());
+        }
+      }
+    }
+  };
+
+  for (auto const& name : unsettled) {
+    seedFromSettled(name);
+  }
+
+  uint64_t loop = 0;
+  std::unordered_set<std::string> cascadeSeeded;
+  while (auto node = q.extractMin()) {
+    ++loop;
+    auto emplaceRc = result.emplace(node->nodeName, std::move(node->result));
+    CHECK(emplaceRc.second);
+
+    auto const& settledName = emplaceRc.first->first;
+    auto const settledMetric = emplaceRc.first->second.metric();
+    auto const& settledNextHops = emplaceRc.first->second.nextHops();
+
+    // an unsettled node that re-settled exactly as before cannot disturb
+    // its settled neighbors
+    auto const priorIter = prior.find(settledName);
+    bool const changed = priorIter == prior.end() or
+        priorIter->second.metric() != settledMetric or
+        priorIter->second.nextHops() != settledNextHops;
+
+    if (isNodeOverloaded(settledName) and settledName != src) {
+      continue;
+    }
+    cascadeSeeded.clear();
+    for (const auto& l : linksFromNode(settledName)) {
+      if (not l->isUp()) {
+        continue;
+      }
+      auto const& otherNodeName = l->getOtherNodeName(settledName);
+      auto const d = settledMetric + l->getMetricFromNode(settledName);
+      auto const otherIter = result.find(otherNodeName);
+      if (otherIter != result.end()) {
+        // settled neighbor: unsettle it if we now offer a strictly
+        // better path, or an equal-cost one with a changed contribution
+        if ((d < otherIter->second.metric() or
+             (changed and d == otherIter->second.metric())) and
+            prior.find(otherNodeName) == prior.end()) {
+          prior.emplace(otherNodeName, std::move(otherIter->second));
+          result.erase(otherIter);
+          seedFromSettled(otherNodeName);
+          cascadeSeeded.insert(otherNodeName);
+        }
+        continue;
+      }
+      if (cascadeSeeded.count(otherNodeName)) {
+        // the seeding above already accounted for every link from us
+        continue;
+      }
+      auto otherNode = q.get(otherNodeName);
+      if (not otherNode) {
+        q.insertNode(otherNodeName, d);
+        otherNode = q.get(otherNodeName);
+      }
+      if (otherNode->result.metric() >= d) {
+        if (otherNode->result.metric() > d) {
+          otherNode->result.reset(d);
+          q.reMake();
+        }
+        otherNode->result.addPath(l, settledName);
+        otherNode->result.addNextHops(settledNextHops);
+        if (otherNode->result.nextHops().empty()) {
+          otherNode->result.addNextHop(otherNodeName);
+        }
+      }
+    }
+  }
+  VLOG(3) << "SPF patch loop count: " << loop;
+  auto deltaTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - startTime);
+  fb303::fbData->addStatValue(
+      "decision.spf_patch_ms", deltaTime.count(), fb303::AVG);
+  return true;
+}
+
+void
+LinkState::pruneKthPathResults(
+    std::vector<std::shared_ptr<Link>> const& affectedLinks,
+    bool invalidateConstrained,
+    std::unordered_set<std::string> const& changedTrees) {
+  // visit each (src, dest) group with k ascending so a group's ignore
+  // set accumulates the links of its surviving lower-k results; once one
+  // k is dropped all higher ones follow, since they were traced with its
+  // paths excluded
+  std::vector<std::tuple<std::string, std::string, size_t>> keys;
+  keys.reserve(kthPathResults_.size());
+  for (auto const& kv : kthPathResults_) {
+    keys.push_back(kv.first);
+  }
+  std::sort(keys.begin(), keys.end());
+
+  LinkSet ignore;
+  bool valid = false;
+  std::string const* groupSrc{nullptr};
+  std::string const* groupDest{nullptr};
+  for (auto const& key : keys) {
+    auto const& src = std::get<0>(key);
+    auto const& dest = std::get<1>(key);
+    auto const k = std::get<2>(key);
+    if (not groupSrc or *groupSrc != src or *groupDest != dest) {
+      groupSrc = &src;
+      groupDest = &dest;
+      ignore.clear();
+      // the k = 1 trace is a pure function of the cached unconstrained
+      // tree: valid iff that tree is still cached and unchanged
+      valid = spfResults_.count({src, true /* useLinkMetric */}) and
+          not changedTrees.count(src);
+    }
+    if (valid and k > 1) {
+      // the constrained run for this k saw the current graph minus
+      // ignore; it is unchanged only if every affected link was excluded
+      valid = not invalidateConstrained;
+      for (auto const& link : affectedLinks) {
+        valid = valid and ignore.count(link);
+      }
+    }
+    auto const entryIter = kthPathResults_.find(key);
+    if (not valid) {
+      kthPathResults_.erase(entryIter);
+      continue;
+    }
+    for (auto const& path : entryIter->second) {
+      for (auto const& link : path) {
+        ignore.insert(link);
+      }
+    }
+  }
+}
+
 /**
  * Compute shortest-path routes from perspective of nodeName;
  */
@@ -804,21 +1394,31 @@ LinkState::runSpf(
   fb303::fbData->addStatValue("decision.spf_runs", 1, fb303::COUNT);
   const auto startTime = std::chrono::steady_clock::now();
 
-  DijkstraQ q;
-  q.insertNode(thisNodeName, 0);
+  // resolve the source id up front so the flat queue and settled bitmap
+  // cover every node known to the id table (every stored link carries ids
+  // below idCount, and the table cannot grow during the run)
+  auto const srcId = nodeId(thisNodeName);
+  if (csrDirty_) {
+    rebuildCsrAdjacency();
+  }
+  auto const idCount = nodeNames_.size();
+  std::vector<bool> settled(idCount, false);
+
+  DijkstraQById q(idCount);
+  q.insertNode(srcId, nodeNames_[srcId], 0);
   uint64_t loop = 0;
   while (auto node = q.extractMin()) {
     ++loop;
     // we've found this node's shortest paths. record it
     auto emplaceRc = result.emplace(node->nodeName, std::move(node->result));
     CHECK(emplaceRc.second);
+    settled[node->nodeId] = true;
 
     auto const& recordedNodeName = emplaceRc.first->first;
     auto const recordedNodeMetric = emplaceRc.first->second.metric();
     auto const& recordedNodeNextHops = emplaceRc.first->second.nextHops();
 
-    if (isNodeOverloaded(recordedNodeName) &&
-        recordedNodeName != thisNodeName) {
+    if (isNodeOverloaded(recordedNodeName) && node->nodeId != srcId) {
       // no transit traffic through this node. we've recorded the nexthops to
       // this node, but will not consider any of it's adjancecies as offering
       // lower cost paths towards further away nodes. This effectively drains
@@ -830,34 +1430,38 @@ LinkState::runSpf(
     // already have a lower cost path from thisNodeName
     //
     // this is the "relax" step in the Dijkstra Algorithm pseudocode in CLRS
-    for (const auto& link : linksFromNode(recordedNodeName)) {
-      auto& otherNodeName = link->getOtherNodeName(recordedNodeName);
-      if (!link->isUp() or result.count(otherNodeName) or
-          linksToIgnore.count(link)) {
+    auto const edgesEnd = csrEdges_.cbegin() + csrOffsets_[node->nodeId + 1];
+    for (auto edge = csrEdges_.cbegin() + csrOffsets_[node->nodeId];
+         edge != edgesEnd;
+         ++edge) {
+      if (not edge->up or settled[edge->otherNodeId] or
+          linksToIgnore.count(edge->link)) {
         continue;
       }
-      auto metric =
-          useLinkMetric ? link->getMetricFromNode(recordedNodeName) : 1;
-      auto otherNode = q.get(otherNodeName);
+      auto metric = useLinkMetric ? edge->metricFromNode : 1;
+      auto otherNode = q.get(edge->otherNodeId);
       if (!otherNode) {
-        q.insertNode(otherNodeName, recordedNodeMetric + metric);
-        otherNode = q.get(otherNodeName);
+        q.insertNode(
+            edge->otherNodeId,
+            nodeNames_[edge->otherNodeId],
+            recordedNodeMetric + metric);
+        otherNode = q.get(edge->otherNodeId);
       }
       if (otherNode->result.metric() >= recordedNodeMetric + metric) {
         // recordedNodeName is either along an alternate shortest path towards
-        // otherNodeName or is along a new shorter path. In either case,
-        // otherNodeName should use recordedNodeName's nextHops until it finds
+        // the other node or is along a new shorter path. In either case, the
+        // other node should use recordedNodeName's nextHops until it finds
         // some shorter path
         if (otherNode->result.metric() > recordedNodeMetric + metric) {
           // if this is strictly better, forget about any other paths
           otherNode->result.reset(recordedNodeMetric + metric);
           q.reMake();
         }
-        otherNode->result.addPath(link, recordedNodeName);
+        otherNode->result.addPath(edge->link, recordedNodeName);
         otherNode->result.addNextHops(recordedNodeNextHops);
         if (otherNode->result.nextHops().empty()) {
           // directly connected node
-          otherNode->result.addNextHop(otherNodeName);
+          otherNode->result.addNextHop(otherNode->nodeName);
         }
       }
     }
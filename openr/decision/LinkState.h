@@ -8,12 +8,15 @@
 #pragma once
 
 #include <algorithm>
+#include <deque>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include <folly/Executor.h>
+
 #include <openr/if/gen-cpp2/Lsdb_types.h>
 #include <openr/if/gen-cpp2/Network_types.h>
 
@@ -95,6 +98,9 @@ class Link {
 
  private:
   const std::string n1_, n2_, if1_, if2_;
+  // dense node ids of n1_/n2_, assigned by LinkState::addLink. They let
+  // the SPF hot loop look up link direction without string comparison
+  uint32_t id1_{0}, id2_{0};
   HoldableValue<LinkStateMetric> metric1_{1}, metric2_{1};
   HoldableValue<bool> overload1_{false}, overload2_{false};
   int32_t adjLabel1_{0}, adjLabel2_{0};
@@ -119,6 +125,22 @@ class Link {
 
   const std::string& getOtherNodeName(const std::string& nodeName) const;
 
+  // associate the endpoints with their dense node ids; ids are given for
+  // the name-ordered endpoints (firstNodeName/secondNodeName)
+  void setNodeIds(uint32_t firstNodeId, uint32_t secondNodeId);
+
+  // id-based accessors for the SPF hot loop. The passed id must be one
+  // of the two endpoint ids
+  uint32_t
+  getOtherNodeId(uint32_t nodeId) const {
+    return nodeId == id1_ ? id2_ : id1_;
+  }
+
+  LinkStateMetric
+  getMetricFromNodeId(uint32_t nodeId) const {
+    return nodeId == id1_ ? metric1_.value() : metric2_.value();
+  }
+
   const std::string& firstNodeName() const;
 
   const std::string& secondNodeName() const;
@@ -257,6 +279,15 @@ class LinkState {
   SpfResult const& getSpfResult(
       const std::string& nodeName, bool useLinkMetric = true);
 
+  // Computes and caches SPF results for the given source nodes; sources
+  // already cached are skipped. When an executor is given the independent
+  // Dijkstra runs fan out across it, so the wall time tracks the largest
+  // computation instead of the sum
+  void warmSpfResults(
+      std::vector<std::string> const& nodeNames,
+      folly::Executor* executor,
+      bool useLinkMetric = true);
+
  private:
   // memoization structure for getSpfResult()
   std::unordered_map<
@@ -283,6 +314,13 @@ class LinkState {
       std::vector<LinkState::Path>>
       kthPathResults_;
 
+  // memoization structure for getMaxHopsToNode(), invalidated with the same
+  // granularity as the hop-count entries of spfResults_. Ordered-FIB hold
+  // computation queries the same nodes repeatedly within one convergence
+  // event and the max is an O(nodes) scan of the SPF result per query
+  std::unordered_map<std::string /* nodeName */, LinkStateMetric>
+      maxHopsResults_;
+
  public:
   bool decrementHolds();
 
@@ -299,6 +337,14 @@ class LinkState {
   // return true if this has caused any change in graph
   bool deleteAdjacencyDatabase(const std::string& nodeName);
 
+  // simulate (or undo) a fail-stop of the given link for a what-if route
+  // build: both directions flip overloaded with no holds, so isUp()
+  // reflects the scenario immediately. The stored adjacency databases are
+  // untouched and the generation is not bumped - the caller must restore
+  // the link before any real state is read again
+  void setLinkScenarioOverload(
+      const std::shared_ptr<Link>& link, bool overload);
+
   // returns hop count from a to b,
   // if nodes b is not reachable from a, returns getMaxHopsToNode(b)
   LinkStateMetric getHopsFromAToB(std::string const& a, std::string const& b);
@@ -324,6 +370,11 @@ class LinkState {
     return allLinks_.size();
   }
 
+  const LinkSet&
+  allLinks() const {
+    return allLinks_;
+  }
+
   size_t
   numNodes() const {
     return linkMap_.size();
@@ -337,6 +388,30 @@ class LinkState {
     return adjacencyDatabases_;
   }
 
+  // Generation-stamped immutable view of the adjacency databases. Unlike
+  // getAdjacencyDatabases(), the returned snapshot stays valid across
+  // later mutations of this LinkState, so readers off the owning thread
+  // can work against a coherent topology. Per-node databases are held by
+  // shared_ptr and reused between snapshots; cutting a new one deep-copies
+  // only the nodes stored or deleted since the previous cut
+  struct AdjacencyDbSnapshot {
+    int64_t generation{0};
+    std::unordered_map<
+        std::string /* nodeName */,
+        std::shared_ptr<thrift::AdjacencyDatabase const>>
+        adjacencyDatabases;
+  };
+
+  std::shared_ptr<AdjacencyDbSnapshot const> getAdjacencyDbSnapshot();
+
+  // current topology generation, bumped every time a node's adjacency
+  // database is stored or deleted. Two snapshots with equal generation
+  // are views of identical topology
+  int64_t
+  getGeneration() const {
+    return generation_;
+  }
+
   // check if path A is part of path B.
   // Example:
   // path A: a->b->c
@@ -370,18 +445,61 @@ class LinkState {
       SpfResult const& result,
       LinkSet const& linksToIgnore);
 
+  // recursion helper for the above: memoizes the sub-path (or proven
+  // dead end) per intermediate node for one fixed linksToIgnore set, so
+  // shared DAG branches are traced once instead of once per diamond
+  std::optional<Path> traceOnePath(
+      std::string const& src,
+      std::string const& dest,
+      SpfResult const& result,
+      LinkSet const& linksToIgnore,
+      std::unordered_map<std::string, std::optional<Path>>& subPathMemo);
+
+  // drop the memoized k-path results invalidated by a topology change.
+  // An entry survives if the source's unconstrained SPF tree is still
+  // cached unchanged (changedTrees lists patched-in-place sources that
+  // did change) and, for k > 1, every affected link was already excluded
+  // from its constrained SPF run by a surviving lower-k result. With
+  // invalidateConstrained set (node overload changes), constrained runs
+  // cannot be validated at all and only k == 1 entries may survive
+  void pruneKthPathResults(
+      std::vector<std::shared_ptr<Link>> const& affectedLinks,
+      bool invalidateConstrained,
+      std::unordered_set<std::string> const& changedTrees);
+
   void addLink(std::shared_ptr<Link> link);
 
   void removeLink(std::shared_ptr<Link> link);
 
   void removeNode(const std::string& nodeName);
 
+  // keep linksWithHolds_ in sync with the link's hold state after any
+  // mutation that can start or clear a hold on it
+  void trackLinkHolds(std::shared_ptr<Link> const& link);
+
   bool updateNodeOverloaded(
       const std::string& nodeName,
       bool isOverloaded,
       LinkStateMetric holdUpTtl,
       LinkStateMetric holdDownTtl);
 
+  // Patch a cached SPF result in place after a metric change on one
+  // directed half of an existing link (dynamic shortest-path maintenance
+  // in the style of Ramalingam-Reps). Only the nodes whose distance or
+  // path set can actually change are unsettled and re-run through the
+  // Dijkstra relaxation, so the cost is proportional to the affected
+  // subtree of the shortest-path DAG instead of the whole graph. Must
+  // only be called for changes that leave the set of usable links
+  // untouched; link up/down or overload changes still require a full
+  // recomputation. Returns false when the change provably left the
+  // result untouched
+  bool patchSpfResult(
+      SpfResult& result,
+      const std::string& src,
+      std::shared_ptr<Link> const& link,
+      const std::string& fromNode,
+      LinkStateMetric oldMetric);
+
   // run Dijkstra's Shortest Path First algorithm on the link state graph
   SpfResult runSpf(
       const std::string& src, /* the source node for the SPF run */
@@ -402,6 +520,33 @@ class LinkState {
   std::vector<std::shared_ptr<Link>> orderedLinksFromNode(
       const std::string& nodeName) const;
 
+  // return the dense id for given node name, assigning the next free one
+  // on first sight. Ids only grow and are never recycled; nodeNames_
+  // keeps the reverse mapping with stable references
+  uint32_t nodeId(const std::string& nodeName);
+
+  std::unordered_map<std::string /* nodeName */, uint32_t> nodeIds_;
+  std::deque<std::string> nodeNames_;
+
+  // compressed-sparse-row copy of the adjacency used by runSpf: the edges
+  // of node id i occupy csrEdges_[csrOffsets_[i], csrOffsets_[i + 1])
+  // with neighbor id, up/down state and directional metric inline, so the
+  // relaxation loop streams contiguous memory instead of walking an
+  // unordered set of shared_ptrs. Rebuilt lazily on the next SPF run
+  // after any change to nodes, links, metrics or holds
+  struct CsrEdge {
+    uint32_t otherNodeId;
+    bool up;
+    LinkStateMetric metricFromNode;
+    std::shared_ptr<Link> link;
+  };
+
+  void rebuildCsrAdjacency();
+
+  std::vector<CsrEdge> csrEdges_;
+  std::vector<size_t> csrOffsets_;
+  bool csrDirty_{true};
+
   // this stores the same link object accessible from either nodeName
   std::unordered_map<std::string /* nodeName */, LinkSet> linkMap_;
 
@@ -411,10 +556,24 @@ class LinkState {
   std::unordered_map<std::string /* nodeName */, HoldableValue<bool>>
       nodeOverloads_;
 
+  // links and node overloads carrying an active hold, maintained at every
+  // hold mutation so hasHolds() is O(1) and decrementHolds() only visits
+  // entries that actually hold instead of scanning the whole graph
+  LinkSet linksWithHolds_;
+  std::unordered_set<std::string /* nodeName */> heldNodeOverloads_;
+
   // the latest AdjacencyDatabase we've received from each node
   std::unordered_map<std::string, thrift::AdjacencyDatabase>
       adjacencyDatabases_;
 
+  // stamp of the current topology; see getGeneration()
+  int64_t generation_{0};
+
+  // last cut snapshot plus the nodes mutated since it was cut, so the
+  // next getAdjacencyDbSnapshot() call re-copies just those entries
+  std::shared_ptr<AdjacencyDbSnapshot const> adjDbSnapshot_{nullptr};
+  std::unordered_set<std::string> snapshotDirtyNodes_;
+
 }; // class LinkState
 
 // Classes needed for running Dijkstra
@@ -482,6 +641,81 @@ class DijkstraQ {
     std::make_heap(heap_.begin(), heap_.end(), DijkstraQNodeGreater);
   }
 };
+
+/// Integer-id variant of DijkstraQ used by the SPF hot loop: node lookup is
+// a flat vector indexed by the dense ids LinkState assigns at addLink time,
+// so relaxing an edge does no string hashing. Queue nodes are pool
+// allocated from a slab sized for the whole run up front, so the run does
+// not touch the heap per node. Ties in the heap still break on node names
+// to keep the settle order (and with it path and next-hop ordering)
+// identical to the name-keyed queue.
+class DijkstraQNodeById {
+ public:
+  DijkstraQNodeById(uint32_t id, const std::string& n, LinkStateMetric m)
+      : nodeId(id), nodeName(n), result(m) {}
+  const uint32_t nodeId;
+  const std::string& nodeName;
+  LinkState::NodeSpfResult result;
+};
+
+class DijkstraQById {
+ private:
+  // slab_ hands out the queue nodes; heap_ and idToNode_ point into it.
+  // At most one node per id is ever inserted, so reserving idCount slots
+  // guarantees the slab never reallocates under outstanding pointers
+  std::vector<DijkstraQNodeById> slab_;
+  std::vector<DijkstraQNodeById*> heap_;
+  std::vector<DijkstraQNodeById*> idToNode_;
+
+  struct {
+    bool
+    operator()(
+        DijkstraQNodeById const* a, DijkstraQNodeById const* b) const {
+      if (a->result.metric() != b->result.metric()) {
+        return a->result.metric() > b->result.metric();
+      }
+      return a->nodeName > b->nodeName;
+    }
+  } DijkstraQNodeGreater;
+
+ public:
+  explicit DijkstraQById(size_t idCount) : idToNode_(idCount, nullptr) {
+    slab_.reserve(idCount);
+    heap_.reserve(idCount);
+  }
+
+  void
+  insertNode(uint32_t nodeId, const std::string& nodeName, LinkStateMetric d) {
+    CHECK_LT(slab_.size(), slab_.capacity());
+    slab_.emplace_back(nodeId, nodeName, d);
+    idToNode_[nodeId] = &slab_.back();
+    heap_.push_back(&slab_.back());
+    std::push_heap(heap_.begin(), heap_.end(), DijkstraQNodeGreater);
+  }
+
+  DijkstraQNodeById*
+  get(uint32_t nodeId) {
+    return idToNode_[nodeId];
+  }
+
+  DijkstraQNodeById*
+  extractMin() {
+    if (heap_.empty()) {
+      return nullptr;
+    }
+    auto* min = heap_.at(0);
+    CHECK(idToNode_[min->nodeId]);
+    idToNode_[min->nodeId] = nullptr;
+    std::pop_heap(heap_.begin(), heap_.end(), DijkstraQNodeGreater);
+    heap_.pop_back();
+    return min;
+  }
+
+  void
+  reMake() {
+    std::make_heap(heap_.begin(), heap_.end(), DijkstraQNodeGreater);
+  }
+};
 } // namespace openr
 
 namespace std {
@@ -11,15 +11,17 @@
 
 namespace openr {
 
-void
+bool
 PrefixState::deleteLoopbackPrefix(
     thrift::IpPrefix const& prefix, const std::string& nodeName) {
+  bool deleted{false};
   auto addrSize = prefix.prefixAddress.addr.size();
   if (addrSize == folly::IPAddressV4::byteCount() &&
       folly::IPAddressV4::bitCount() == prefix.prefixLength) {
     if (nodeHostLoopbacksV4_.find(nodeName) != nodeHostLoopbacksV4_.end() &&
         prefix.prefixAddress == nodeHostLoopbacksV4_.at(nodeName)) {
       nodeHostLoopbacksV4_.erase(nodeName);
+      deleted = true;
     }
   }
   if (addrSize == folly::IPAddressV6::byteCount() &&
@@ -27,81 +29,132 @@ PrefixState::deleteLoopbackPrefix(
     if (nodeHostLoopbacksV6_.find(nodeName) != nodeHostLoopbacksV6_.end() &&
         nodeHostLoopbacksV6_.at(nodeName) == prefix.prefixAddress) {
       nodeHostLoopbacksV6_.erase(nodeName);
+      deleted = true;
     }
   }
+  return deleted;
 }
 
 bool
-PrefixState::updatePrefixDatabase(thrift::PrefixDatabase const& prefixDb) {
-  auto const& nodeName = prefixDb.thisNodeName;
-
-  // Get old and new set of prefixes - NOTE explicit copy
-  const std::set<thrift::IpPrefix> oldPrefixSet = nodeToPrefixes_[nodeName];
+PrefixState::updatePrefix(
+    std::string const& nodeName, thrift::PrefixEntry const& prefixEntry) {
+  auto& nodeList = prefixes_[prefixEntry.prefix];
+  auto nodePrefixIt = nodeList.find(nodeName);
 
-  // update the entry
-  auto& newPrefixSet = nodeToPrefixes_[nodeName];
-  newPrefixSet.clear();
-  for (const auto& prefixEntry : prefixDb.prefixEntries) {
-    newPrefixSet.emplace(prefixEntry.prefix);
+  // Add or Update prefix
+  if (nodePrefixIt == nodeList.end()) {
+    VLOG(1) << "Prefix " << toString(prefixEntry.prefix)
+            << " has been advertised by node " << nodeName;
+    if (nodeList.empty()) {
+      prefixTrie_.insert(prefixEntry.prefix);
+    }
+    nodeList.emplace(nodeName, prefixEntry);
+    nodeToPrefixes_[nodeName].emplace(prefixEntry.prefix);
+  } else if (nodePrefixIt->second != prefixEntry) {
+    VLOG(1) << "Prefix " << toString(prefixEntry.prefix)
+            << " has been updated by node " << nodeName;
+    nodeList[nodeName] = prefixEntry;
+  } else {
+    // This prefix has no change. Skip rest of code!
+    return false;
   }
+  changedPrefixes_.emplace(prefixEntry.prefix);
 
-  // Boolean to indicate update in prefix entry
-  bool isUpdated{false};
-
-  // Remove old prefixes first
-  for (const auto& prefix : oldPrefixSet) {
-    if (newPrefixSet.count(prefix)) {
-      continue;
+  // Keep track of loopback addresses (v4 / v6) for each node
+  if (thrift::PrefixType::LOOPBACK == prefixEntry.type) {
+    bool loopbackChanged{false};
+    auto addrSize = prefixEntry.prefix.prefixAddress.addr.size();
+    if (addrSize == folly::IPAddressV4::byteCount() &&
+        folly::IPAddressV4::bitCount() == prefixEntry.prefix.prefixLength) {
+      auto& loopback = nodeHostLoopbacksV4_[nodeName];
+      if (loopback != prefixEntry.prefix.prefixAddress) {
+        loopback = prefixEntry.prefix.prefixAddress;
+        loopbackChanged = true;
+      }
     }
-    VLOG(1) << "Prefix " << toString(prefix) << " has been withdrawn by "
-            << nodeName;
-    auto& nodeList = prefixes_.at(prefix);
-    nodeList.erase(nodeName);
-    isUpdated = true;
-    if (nodeList.empty()) {
-      prefixes_.erase(prefix);
+    if (addrSize == folly::IPAddressV6::byteCount() &&
+        folly::IPAddressV6::bitCount() == prefixEntry.prefix.prefixLength) {
+      auto& loopback = nodeHostLoopbacksV6_[nodeName];
+      if (loopback != prefixEntry.prefix.prefixAddress) {
+        loopback = prefixEntry.prefix.prefixAddress;
+        loopbackChanged = true;
+      }
+    }
+    // the node's loopback feeds BGP route nexthops for everything it
+    // advertises
+    if (loopbackChanged) {
+      for (auto const& prefix : nodeToPrefixes_[nodeName]) {
+        changedPrefixes_.emplace(prefix);
+      }
     }
-    deleteLoopbackPrefix(prefix, nodeName);
   }
-  for (const auto& prefixEntry : prefixDb.prefixEntries) {
-    auto& nodeList = prefixes_[prefixEntry.prefix];
-    auto nodePrefixIt = nodeList.find(nodeName);
+  return true;
+}
 
-    // Add or Update prefix
-    if (nodePrefixIt == nodeList.end()) {
-      VLOG(1) << "Prefix " << toString(prefixEntry.prefix)
-              << " has been advertised by node " << nodeName;
-      nodeList.emplace(nodeName, prefixEntry);
-      isUpdated = true;
-    } else if (nodePrefixIt->second != prefixEntry) {
-      VLOG(1) << "Prefix " << toString(prefixEntry.prefix)
-              << " has been updated by node " << nodeName;
-      nodeList[nodeName] = prefixEntry;
-      isUpdated = true;
-    } else {
-      // This prefix has no change. Skip rest of code!
-      continue;
+bool
+PrefixState::withdrawPrefix(
+    std::string const& nodeName, thrift::IpPrefix const& prefix) {
+  auto prefixIt = prefixes_.find(prefix);
+  if (prefixIt == prefixes_.end() or not prefixIt->second.count(nodeName)) {
+    return false;
+  }
+  VLOG(1) << "Prefix " << toString(prefix) << " has been withdrawn by "
+          << nodeName;
+  auto& nodeList = prefixIt->second;
+  nodeList.erase(nodeName);
+  if (nodeList.empty()) {
+    prefixes_.erase(prefixIt);
+    prefixTrie_.erase(prefix);
+  }
+  changedPrefixes_.emplace(prefix);
+  bool const loopbackDeleted = deleteLoopbackPrefix(prefix, nodeName);
+  auto nodeToPrefixesIt = nodeToPrefixes_.find(nodeName);
+  nodeToPrefixesIt->second.erase(prefix);
+  if (nodeToPrefixesIt->second.empty()) {
+    nodeToPrefixes_.erase(nodeToPrefixesIt);
+  } else if (loopbackDeleted) {
+    // losing the loopback invalidates BGP route nexthops for everything the
+    // node still advertises
+    for (auto const& nodePrefix : nodeToPrefixesIt->second) {
+      changedPrefixes_.emplace(nodePrefix);
     }
+  }
+  return true;
+}
 
-    // Keep track of loopback addresses (v4 / v6) for each node
-    if (thrift::PrefixType::LOOPBACK == prefixEntry.type) {
-      auto addrSize = prefixEntry.prefix.prefixAddress.addr.size();
-      if (addrSize == folly::IPAddressV4::byteCount() &&
-          folly::IPAddressV4::bitCount() == prefixEntry.prefix.prefixLength) {
-        nodeHostLoopbacksV4_[nodeName] = prefixEntry.prefix.prefixAddress;
-      }
-      if (addrSize == folly::IPAddressV6::byteCount() &&
-          folly::IPAddressV6::bitCount() == prefixEntry.prefix.prefixLength) {
-        nodeHostLoopbacksV6_[nodeName] = prefixEntry.prefix.prefixAddress;
+std::unordered_set<thrift::IpPrefix>
+PrefixState::updatePrefixDatabase(thrift::PrefixDatabase const& prefixDb) {
+  auto const& nodeName = prefixDb.thisNodeName;
+
+  std::set<thrift::IpPrefix> newPrefixSet;
+  for (const auto& prefixEntry : prefixDb.prefixEntries) {
+    newPrefixSet.emplace(prefixEntry.prefix);
+  }
+
+  // Collect withdrawn prefixes first since withdrawPrefix() mutates the
+  // per-node set we'd otherwise be iterating
+  std::vector<thrift::IpPrefix> toWithdraw;
+  auto nodeToPrefixesIt = nodeToPrefixes_.find(nodeName);
+  if (nodeToPrefixesIt != nodeToPrefixes_.end()) {
+    for (const auto& prefix : nodeToPrefixesIt->second) {
+      if (not newPrefixSet.count(prefix)) {
+        toWithdraw.emplace_back(prefix);
       }
     }
   }
 
-  if (newPrefixSet.empty()) {
-    nodeToPrefixes_.erase(nodeName);
+  for (const auto& prefix : toWithdraw) {
+    withdrawPrefix(nodeName, prefix);
+  }
+  for (const auto& prefixEntry : prefixDb.prefixEntries) {
+    updatePrefix(nodeName, prefixEntry);
   }
 
-  return isUpdated;
+  // hand the dirty set (including any loopback fan-out recorded by the
+  // delta entry points) back to the caller and start a fresh accumulation
+  std::unordered_set<thrift::IpPrefix> changed;
+  changed.swap(changedPrefixes_);
+  return changed;
 }
 
 std::unordered_map<std::string /* nodeName */, thrift::PrefixDatabase>
@@ -7,15 +7,19 @@
 
 #pragma once
 
+#include <optional>
 #include <set>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <openr/common/NetworkUtil.h>
+#include <openr/common/PrefixTrie.h>
 #include <openr/if/gen-cpp2/Lsdb_types.h>
 #include <openr/if/gen-cpp2/Network_types.h>
 
 namespace openr {
+
 class PrefixState {
  public:
   std::unordered_map<
@@ -25,12 +29,50 @@ class PrefixState {
     return prefixes_;
   }
 
-  // update loopback prefix deletes
-  void deleteLoopbackPrefix(
+  // update loopback prefix deletes. Returns true if a tracked loopback
+  // was removed
+  bool deleteLoopbackPrefix(
       thrift::IpPrefix const& prefix, const std::string& nodename);
 
-  // returns true if the prefixDb changed
-  bool updatePrefixDatabase(thrift::PrefixDatabase const& prefixDb);
+  // returns the exact set of prefixes whose routes may have changed
+  // (added / withdrawn / attribute change, including loopback fan-out),
+  // draining the accumulator fed by updatePrefix() / withdrawPrefix().
+  // An empty set means the prefixDb caused no change
+  std::unordered_set<thrift::IpPrefix> updatePrefixDatabase(
+      thrift::PrefixDatabase const& prefixDb);
+
+  // delta-update entry points. Processing cost is proportional to the one
+  // prefix touched, not to the node's full advertised set. Both return true
+  // if state changed
+  bool updatePrefix(
+      std::string const& nodeName, thrift::PrefixEntry const& prefixEntry);
+  bool withdrawPrefix(
+      std::string const& nodeName, thrift::IpPrefix const& prefix);
+
+  // aggregation queries backed by the radix trie
+  std::vector<thrift::IpPrefix>
+  getCoveredPrefixes(thrift::IpPrefix const& prefix) const {
+    return prefixTrie_.getCoveredPrefixes(prefix);
+  }
+
+  std::optional<thrift::IpPrefix>
+  getLongestMatch(thrift::IpPrefix const& prefix) const {
+    return prefixTrie_.getLongestMatch(prefix);
+  }
+
+  // prefixes whose advertisements changed since the last
+  // clearChangedPrefixes() or updatePrefixDatabase() call. A node's
+  // host-loopback change marks all of that node's prefixes since loopbacks
+  // feed BGP route nexthops
+  std::unordered_set<thrift::IpPrefix> const&
+  getChangedPrefixes() const {
+    return changedPrefixes_;
+  }
+
+  void
+  clearChangedPrefixes() {
+    changedPrefixes_.clear();
+  }
 
   std::unordered_map<std::string /* nodeName */, thrift::PrefixDatabase>
   getPrefixDatabases() const;
@@ -56,6 +98,12 @@ class PrefixState {
       thrift::IpPrefix,
       std::unordered_map<std::string, thrift::PrefixEntry>>
       prefixes_;
+  // radix-trie index over keys of prefixes_, kept in sync by
+  // updatePrefix / withdrawPrefix
+  PrefixTrie prefixTrie_;
+  // prefixes touched since the last clearChangedPrefixes(), feeding native
+  // delta route computation downstream
+  std::unordered_set<thrift::IpPrefix> changedPrefixes_;
   std::unordered_map<std::string, std::set<thrift::IpPrefix>> nodeToPrefixes_;
   std::unordered_map<std::string, thrift::BinaryAddress> nodeHostLoopbacksV4_;
   std::unordered_map<std::string, thrift::BinaryAddress> nodeHostLoopbacksV6_;
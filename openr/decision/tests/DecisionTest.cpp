@@ -434,8 +434,8 @@ TEST(ShortestPathTest, UnreachableNodes) {
   EXPECT_FALSE(spfSolver.updateAdjacencyDatabase(adjacencyDb1).first);
   EXPECT_FALSE(spfSolver.updateAdjacencyDatabase(adjacencyDb2).first);
 
-  EXPECT_TRUE(spfSolver.updatePrefixDatabase(prefixDb1));
-  EXPECT_TRUE(spfSolver.updatePrefixDatabase(prefixDb2));
+  EXPECT_FALSE(spfSolver.updatePrefixDatabase(prefixDb1).empty());
+  EXPECT_FALSE(spfSolver.updatePrefixDatabase(prefixDb2).empty());
 
   unordered_map<
       pair<string /* node name */, string /* ip prefix */>,
@@ -471,8 +471,8 @@ TEST(ShortestPathTest, MissingNeighborAdjacencyDb) {
   //
 
   EXPECT_FALSE(spfSolver.updateAdjacencyDatabase(adjacencyDb1).first);
-  EXPECT_TRUE(spfSolver.updatePrefixDatabase(prefixDb1));
-  EXPECT_TRUE(spfSolver.updatePrefixDatabase(prefixDb2));
+  EXPECT_FALSE(spfSolver.updatePrefixDatabase(prefixDb1).empty());
+  EXPECT_FALSE(spfSolver.updatePrefixDatabase(prefixDb2).empty());
 
   auto routeDb = spfSolver.buildRouteDb("1");
   ASSERT_TRUE(routeDb.has_value());
@@ -502,8 +502,8 @@ TEST(ShortestPathTest, EmptyNeighborAdjacencyDb) {
 
   EXPECT_FALSE(spfSolver.updateAdjacencyDatabase(adjacencyDb1).first);
   EXPECT_FALSE(spfSolver.updateAdjacencyDatabase(adjacencyDb2).first);
-  EXPECT_TRUE(spfSolver.updatePrefixDatabase(prefixDb1));
-  EXPECT_TRUE(spfSolver.updatePrefixDatabase(prefixDb2));
+  EXPECT_FALSE(spfSolver.updatePrefixDatabase(prefixDb1).empty());
+  EXPECT_FALSE(spfSolver.updatePrefixDatabase(prefixDb2).empty());
 
   // dump routes for both nodes, expect no routing entries
 
@@ -558,8 +558,8 @@ TEST(SpfSolver, AdjacencyUpdate) {
     EXPECT_TRUE(res.first);
     EXPECT_TRUE(res.second);
   }
-  EXPECT_TRUE(spfSolver.updatePrefixDatabase(prefixDb1));
-  EXPECT_TRUE(spfSolver.updatePrefixDatabase(prefixDb2));
+  EXPECT_FALSE(spfSolver.updatePrefixDatabase(prefixDb1).empty());
+  EXPECT_FALSE(spfSolver.updatePrefixDatabase(prefixDb2).empty());
 
   //
   // dump routes for both nodes, expect 4 route entries (1 unicast, 3 label) on
@@ -669,6 +669,78 @@ TEST(SpfSolver, AdjacencyUpdate) {
   }
 }
 
+//
+// Verify the speculative failure-precompute helpers on a 1-2-3 triangle:
+// scenario candidates rank our own links first, a what-if build routes
+// around the failed link without disturbing the real state, and an
+// adjacency update that reduces to exactly one link loss is recognized
+// and matches the precomputed scenario
+//
+TEST(SpfSolver, FailurePrecompute) {
+  std::string nodeName("1");
+  SpfSolver spfSolver(
+      nodeName, false /* disable v4 */, false /* disable LFA */);
+
+  auto adjacencyDb1 = createAdjDb("1", {adj12, adj13}, 1);
+  auto adjacencyDb2 = createAdjDb("2", {adj21, adj23}, 2);
+  auto adjacencyDb3 = createAdjDb("3", {adj31, adj32}, 3);
+  spfSolver.updateAdjacencyDatabase(adjacencyDb1);
+  spfSolver.updateAdjacencyDatabase(adjacencyDb2);
+  spfSolver.updateAdjacencyDatabase(adjacencyDb3);
+  EXPECT_FALSE(spfSolver.updatePrefixDatabase(prefixDb1).empty());
+  EXPECT_FALSE(spfSolver.updatePrefixDatabase(prefixDb2).empty());
+  EXPECT_FALSE(spfSolver.updatePrefixDatabase(prefixDb3).empty());
+
+  const std::string linkKey12{"1%1/2<->2%2/1"};
+  const std::string linkKey13{"1%1/3<->3%3/1"};
+
+  // the two links attached to us rank ahead of the 2-3 link
+  EXPECT_THAT(
+      spfSolver.getFailureScenarioLinks(nodeName, 2),
+      UnorderedElementsAre(linkKey12, linkKey13));
+  EXPECT_EQ(3, spfSolver.getFailureScenarioLinks(nodeName, 8).size());
+
+  const auto generation = spfSolver.getTopologyGeneration();
+  const auto baselineRouteDb = spfSolver.buildRouteDb(nodeName);
+  ASSERT_TRUE(baselineRouteDb.has_value());
+
+  // what-if build with link 1-2 failed: node 2 is reached through node 3
+  auto scenarioRouteDb =
+      spfSolver.buildRouteDbExcludingLink(nodeName, linkKey12);
+  ASSERT_TRUE(scenarioRouteDb.has_value());
+  RouteMap scenarioRoutes;
+  fillRouteMap(nodeName, scenarioRoutes, scenarioRouteDb.value());
+  EXPECT_EQ(
+      scenarioRoutes[make_pair(nodeName, toString(addr2))],
+      NextHops({createNextHopFromAdj(adj13, false, 20)}));
+
+  // the scenario build left the real topology untouched
+  EXPECT_EQ(generation, spfSolver.getTopologyGeneration());
+  EXPECT_EQ(baselineRouteDb, spfSolver.buildRouteDb(nodeName));
+
+  // node 2 re-advertising without adj21 is exactly the 1-2 link failing;
+  // any other difference in the update disqualifies the shortcut
+  auto adjacencyDb2Down = createAdjDb("2", {adj23}, 2);
+  EXPECT_EQ(linkKey12, spfSolver.detectSingleLinkDown(adjacencyDb2Down));
+  EXPECT_EQ(
+      std::nullopt, spfSolver.detectSingleLinkDown(createAdjDb("2", {}, 2)));
+  EXPECT_EQ(
+      std::nullopt,
+      spfSolver.detectSingleLinkDown(createAdjDb("2", {adj23}, 20)));
+  EXPECT_EQ(std::nullopt, spfSolver.detectSingleLinkDown(adjacencyDb2));
+
+  // apply the failure for real: the scenario build is the exact answer
+  EXPECT_TRUE(spfSolver.updateAdjacencyDatabase(adjacencyDb2Down).first);
+  auto postFailureRouteDb = spfSolver.buildRouteDb(nodeName);
+  ASSERT_TRUE(postFailureRouteDb.has_value());
+  for (auto* routeDb :
+       {&scenarioRouteDb.value(), &postFailureRouteDb.value()}) {
+    std::sort(routeDb->unicastRoutes.begin(), routeDb->unicastRoutes.end());
+    std::sort(routeDb->mplsRoutes.begin(), routeDb->mplsRoutes.end());
+  }
+  EXPECT_EQ(scenarioRouteDb, postFailureRouteDb);
+}
+
 //
 // Node-1 connects to 2 but 2 doesn't report bi-directionality
 // Node-2 and Node-3 are bi-directionally connected
@@ -754,8 +826,8 @@ TEST(BGPRedistribution, BasicOperation) {
       mv1,
       std::nullopt));
 
-  EXPECT_TRUE(spfSolver.updatePrefixDatabase(prefixDb1WithBGP));
-  EXPECT_TRUE(spfSolver.updatePrefixDatabase(prefixDb2WithBGP));
+  EXPECT_FALSE(spfSolver.updatePrefixDatabase(prefixDb1WithBGP).empty());
+  EXPECT_FALSE(spfSolver.updatePrefixDatabase(prefixDb2WithBGP).empty());
 
   auto routeDb = spfSolver.buildRouteDb("2");
   thrift::UnicastRoute route1(
@@ -782,7 +854,7 @@ TEST(BGPRedistribution, BasicOperation) {
       false,
       mv2,
       std::nullopt));
-  EXPECT_TRUE(spfSolver.updatePrefixDatabase(prefixDb2WithBGP));
+  EXPECT_FALSE(spfSolver.updatePrefixDatabase(prefixDb2WithBGP).empty());
   routeDb = spfSolver.buildRouteDb("1");
   EXPECT_THAT(routeDb.value().unicastRoutes, testing::SizeIs(1));
 
@@ -793,7 +865,7 @@ TEST(BGPRedistribution, BasicOperation) {
       .value()
       .metrics[numMetrics - 1]
       .metric.front()--;
-  EXPECT_TRUE(spfSolver.updatePrefixDatabase(prefixDb2WithBGP));
+  EXPECT_FALSE(spfSolver.updatePrefixDatabase(prefixDb2WithBGP).empty());
   routeDb = spfSolver.buildRouteDb("2");
   EXPECT_THAT(routeDb.value().unicastRoutes, testing::SizeIs(2));
   EXPECT_THAT(routeDb.value().unicastRoutes, testing::Contains(route1));
@@ -804,7 +876,7 @@ TEST(BGPRedistribution, BasicOperation) {
       .value()
       .metrics[numMetrics - 1]
       .metric.front() += 2;
-  EXPECT_TRUE(spfSolver.updatePrefixDatabase(prefixDb2WithBGP));
+  EXPECT_FALSE(spfSolver.updatePrefixDatabase(prefixDb2WithBGP).empty());
 
   thrift::UnicastRoute route2(
       FRAGILE,
@@ -831,8 +903,8 @@ TEST(BGPRedistribution, BasicOperation) {
       .value()
       .metrics[numMetrics - 1]
       .isBestPathTieBreaker = true;
-  EXPECT_TRUE(spfSolver.updatePrefixDatabase(prefixDb1WithBGP));
-  EXPECT_TRUE(spfSolver.updatePrefixDatabase(prefixDb2WithBGP));
+  EXPECT_FALSE(spfSolver.updatePrefixDatabase(prefixDb1WithBGP).empty());
+  EXPECT_FALSE(spfSolver.updatePrefixDatabase(prefixDb2WithBGP).empty());
 
   // 1 and 2 will not program BGP route
   EXPECT_THAT(
@@ -937,8 +1009,8 @@ TEST(BGPRedistribution, IgpMetric) {
       createPrefixDb("2", {createPrefixEntry(addr2), bgpPrefix2});
   auto prefixDb3WithBgp =
       createPrefixDb("3", {createPrefixEntry(addr3), bgpPrefix3});
-  EXPECT_TRUE(spfSolver.updatePrefixDatabase(prefixDb2WithBgp));
-  EXPECT_TRUE(spfSolver.updatePrefixDatabase(prefixDb3WithBgp));
+  EXPECT_FALSE(spfSolver.updatePrefixDatabase(prefixDb2WithBgp).empty());
+  EXPECT_FALSE(spfSolver.updatePrefixDatabase(prefixDb3WithBgp).empty());
 
   //
   // Step-1 prefix1 -> {node2, node3}
@@ -1062,9 +1134,9 @@ TEST_P(ConnectivityTest, GraphConnectedOrPartitioned) {
       std::make_pair(!partitioned, true),
       spfSolver.updateAdjacencyDatabase(adjacencyDb3));
 
-  EXPECT_TRUE(spfSolver.updatePrefixDatabase(prefixDb1));
-  EXPECT_TRUE(spfSolver.updatePrefixDatabase(prefixDb2));
-  EXPECT_TRUE(spfSolver.updatePrefixDatabase(prefixDb3));
+  EXPECT_FALSE(spfSolver.updatePrefixDatabase(prefixDb1).empty());
+  EXPECT_FALSE(spfSolver.updatePrefixDatabase(prefixDb2).empty());
+  EXPECT_FALSE(spfSolver.updatePrefixDatabase(prefixDb3).empty());
 
   // route from 1 to 3
   auto routeDb = spfSolver.buildRouteDb("1");
@@ -1110,9 +1182,9 @@ TEST(ConnectivityTest, OverloadNodeTest) {
   // Make node-2 overloaded
   adjacencyDb2.isOverloaded = true;
 
-  EXPECT_TRUE(spfSolver.updatePrefixDatabase(prefixDb1));
-  EXPECT_TRUE(spfSolver.updatePrefixDatabase(prefixDb2));
-  EXPECT_TRUE(spfSolver.updatePrefixDatabase(prefixDb3));
+  EXPECT_FALSE(spfSolver.updatePrefixDatabase(prefixDb1).empty());
+  EXPECT_FALSE(spfSolver.updatePrefixDatabase(prefixDb2).empty());
+  EXPECT_FALSE(spfSolver.updatePrefixDatabase(prefixDb3).empty());
 
   EXPECT_FALSE(spfSolver.updateAdjacencyDatabase(adjacencyDb1).first);
   EXPECT_TRUE(spfSolver.updateAdjacencyDatabase(adjacencyDb2).first);
@@ -1199,9 +1271,9 @@ TEST(ConnectivityTest, CompatibilityNodeTest) {
   auto adjacencyDb2 = createAdjDb("2", {adj21_old_1, adj23}, 2);
   auto adjacencyDb3 = createAdjDb("3", {adj32, adj31_old}, 3);
 
-  EXPECT_TRUE(spfSolver.updatePrefixDatabase(prefixDb1));
-  EXPECT_TRUE(spfSolver.updatePrefixDatabase(prefixDb2));
-  EXPECT_TRUE(spfSolver.updatePrefixDatabase(prefixDb3));
+  EXPECT_FALSE(spfSolver.updatePrefixDatabase(prefixDb1).empty());
+  EXPECT_FALSE(spfSolver.updatePrefixDatabase(prefixDb2).empty());
+  EXPECT_FALSE(spfSolver.updatePrefixDatabase(prefixDb3).empty());
 
   EXPECT_FALSE(spfSolver.updateAdjacencyDatabase(adjacencyDb2).first);
   EXPECT_TRUE(spfSolver.updateAdjacencyDatabase(adjacencyDb3).first);
@@ -1349,38 +1421,38 @@ class SimpleRingMeshTopologyFixture
     auto bgp3 = v4Enabled ? bgpAddr3V4 : bgpAddr3;
     auto bgp4 = v4Enabled ? bgpAddr4V4 : bgpAddr4;
 
-    EXPECT_TRUE(spfSolver->updatePrefixDatabase(
+    EXPECT_FALSE(spfSolver->updatePrefixDatabase(
         useKsp2Ed
             ? createPrefixDbWithKspfAlgo(
                   pdb1,
                   prefixType,
                   createNewBgpRoute ? std::make_optional<thrift::IpPrefix>(bgp1)
                                     : std::nullopt)
-            : pdb1));
-    EXPECT_TRUE(spfSolver->updatePrefixDatabase(
+            : pdb1).empty());
+    EXPECT_FALSE(spfSolver->updatePrefixDatabase(
         useKsp2Ed
             ? createPrefixDbWithKspfAlgo(
                   pdb2,
                   prefixType,
                   createNewBgpRoute ? std::make_optional<thrift::IpPrefix>(bgp2)
                                     : std::nullopt)
-            : pdb2));
-    EXPECT_TRUE(spfSolver->updatePrefixDatabase(
+            : pdb2).empty());
+    EXPECT_FALSE(spfSolver->updatePrefixDatabase(
         useKsp2Ed
             ? createPrefixDbWithKspfAlgo(
                   pdb3,
                   prefixType,
                   createNewBgpRoute ? std::make_optional<thrift::IpPrefix>(bgp3)
                                     : std::nullopt)
-            : pdb3));
-    EXPECT_TRUE(spfSolver->updatePrefixDatabase(
+            : pdb3).empty());
+    EXPECT_FALSE(spfSolver->updatePrefixDatabase(
         useKsp2Ed
             ? createPrefixDbWithKspfAlgo(
                   pdb4,
                   prefixType,
                   createNewBgpRoute ? std::make_optional<thrift::IpPrefix>(bgp4)
                                     : std::nullopt)
-            : pdb4));
+            : pdb4).empty());
   }
 
   thrift::AdjacencyDatabase adjacencyDb1, adjacencyDb2, adjacencyDb3,
@@ -1528,38 +1600,38 @@ class SimpleRingTopologyFixture
     auto bgp3 = v4Enabled ? bgpAddr3V4 : bgpAddr3;
     auto bgp4 = v4Enabled ? bgpAddr4V4 : bgpAddr4;
 
-    EXPECT_TRUE(spfSolver->updatePrefixDatabase(
+    EXPECT_FALSE(spfSolver->updatePrefixDatabase(
         useKsp2Ed
             ? createPrefixDbWithKspfAlgo(
                   pdb1,
                   prefixType,
                   createNewBgpRoute ? std::make_optional<thrift::IpPrefix>(bgp1)
                                     : std::nullopt)
-            : pdb1));
-    EXPECT_TRUE(spfSolver->updatePrefixDatabase(
+            : pdb1).empty());
+    EXPECT_FALSE(spfSolver->updatePrefixDatabase(
         useKsp2Ed
             ? createPrefixDbWithKspfAlgo(
                   pdb2,
                   prefixType,
                   createNewBgpRoute ? std::make_optional<thrift::IpPrefix>(bgp2)
                                     : std::nullopt)
-            : pdb2));
-    EXPECT_TRUE(spfSolver->updatePrefixDatabase(
+            : pdb2).empty());
+    EXPECT_FALSE(spfSolver->updatePrefixDatabase(
         useKsp2Ed
             ? createPrefixDbWithKspfAlgo(
                   pdb3,
                   prefixType,
                   createNewBgpRoute ? std::make_optional<thrift::IpPrefix>(bgp3)
                                     : std::nullopt)
-            : pdb3));
-    EXPECT_TRUE(spfSolver->updatePrefixDatabase(
+            : pdb3).empty());
+    EXPECT_FALSE(spfSolver->updatePrefixDatabase(
         useKsp2Ed
             ? createPrefixDbWithKspfAlgo(
                   pdb4,
                   prefixType,
                   createNewBgpRoute ? std::make_optional<thrift::IpPrefix>(bgp4)
                                     : std::nullopt)
-            : pdb4));
+            : pdb4).empty());
   }
 
   thrift::AdjacencyDatabase adjacencyDb1, adjacencyDb2, adjacencyDb3,
@@ -2418,8 +2490,8 @@ TEST_P(SimpleRingTopologyFixture, AttachedNodesTest) {
       "1", {createPrefixEntry(addr1), createPrefixEntry(defaultRoute)});
   auto prefixDb4 = createPrefixDb(
       "4", {createPrefixEntry(addr4), createPrefixEntry(defaultRoute)});
-  EXPECT_TRUE(spfSolver->updatePrefixDatabase(prefixDb1));
-  EXPECT_TRUE(spfSolver->updatePrefixDatabase(prefixDb4));
+  EXPECT_FALSE(spfSolver->updatePrefixDatabase(prefixDb1).empty());
+  EXPECT_FALSE(spfSolver->updatePrefixDatabase(prefixDb4).empty());
 
   auto routeMap = getRouteMap(*spfSolver, {"1", "2", "3", "4"});
 
@@ -2841,18 +2913,18 @@ class ParallelAdjRingTopologyFixture
 
     // Prefix db's
 
-    EXPECT_TRUE(spfSolver->updatePrefixDatabase(
+    EXPECT_FALSE(spfSolver->updatePrefixDatabase(
         useKsp2Ed ? createPrefixDbWithKspfAlgo(prefixDb1, prefixType)
-                  : prefixDb1));
-    EXPECT_TRUE(spfSolver->updatePrefixDatabase(
+                  : prefixDb1).empty());
+    EXPECT_FALSE(spfSolver->updatePrefixDatabase(
         useKsp2Ed ? createPrefixDbWithKspfAlgo(prefixDb2, prefixType)
-                  : prefixDb2));
-    EXPECT_TRUE(spfSolver->updatePrefixDatabase(
+                  : prefixDb2).empty());
+    EXPECT_FALSE(spfSolver->updatePrefixDatabase(
         useKsp2Ed ? createPrefixDbWithKspfAlgo(prefixDb3, prefixType)
-                  : prefixDb3));
-    EXPECT_TRUE(spfSolver->updatePrefixDatabase(
+                  : prefixDb3).empty());
+    EXPECT_FALSE(spfSolver->updatePrefixDatabase(
         useKsp2Ed ? createPrefixDbWithKspfAlgo(prefixDb4, prefixType)
-                  : prefixDb4));
+                  : prefixDb4).empty());
   }
 
   thrift::Adjacency adj12_1, adj12_2, adj12_3, adj13_1, adj21_1, adj21_2,
@@ -3550,7 +3622,7 @@ TEST(DecisionTest, Ip2MplsRoutes) {
           thrift::PrefixType::LOOPBACK,
           {},
           thrift::PrefixForwardingType::SR_MPLS)});
-  EXPECT_TRUE(spfSolver->updatePrefixDatabase(prefixDb1_));
+  EXPECT_FALSE(spfSolver->updatePrefixDatabase(prefixDb1_).empty());
   const auto prefixDb2_ = createPrefixDb(
       "2",
       {createPrefixEntry(
@@ -3558,7 +3630,7 @@ TEST(DecisionTest, Ip2MplsRoutes) {
           thrift::PrefixType::LOOPBACK,
           {},
           thrift::PrefixForwardingType::SR_MPLS)});
-  EXPECT_TRUE(spfSolver->updatePrefixDatabase(prefixDb2_));
+  EXPECT_FALSE(spfSolver->updatePrefixDatabase(prefixDb2_).empty());
   const auto prefixDb3_ = createPrefixDb(
       "3",
       {createPrefixEntry(
@@ -3566,7 +3638,7 @@ TEST(DecisionTest, Ip2MplsRoutes) {
           thrift::PrefixType::LOOPBACK,
           {},
           thrift::PrefixForwardingType::SR_MPLS)});
-  EXPECT_TRUE(spfSolver->updatePrefixDatabase(prefixDb3_));
+  EXPECT_FALSE(spfSolver->updatePrefixDatabase(prefixDb3_).empty());
   const auto prefixDb4_ = createPrefixDb(
       "4",
       {createPrefixEntry(
@@ -3574,7 +3646,7 @@ TEST(DecisionTest, Ip2MplsRoutes) {
           thrift::PrefixType::LOOPBACK,
           {},
           thrift::PrefixForwardingType::SR_MPLS)});
-  EXPECT_TRUE(spfSolver->updatePrefixDatabase(prefixDb4_));
+  EXPECT_FALSE(spfSolver->updatePrefixDatabase(prefixDb4_).empty());
   const auto prefixDb5_ = createPrefixDb(
       "5",
       {createPrefixEntry(
@@ -3582,7 +3654,7 @@ TEST(DecisionTest, Ip2MplsRoutes) {
           thrift::PrefixType::LOOPBACK,
           {},
           thrift::PrefixForwardingType::SR_MPLS)});
-  EXPECT_TRUE(spfSolver->updatePrefixDatabase(prefixDb5_));
+  EXPECT_FALSE(spfSolver->updatePrefixDatabase(prefixDb5_).empty());
 
   // Some actions
   auto const labelPush1 = createMplsAction(
@@ -5292,6 +5364,34 @@ TEST_F(DecisionTestFixture, PerPrefixKeyExpiry) {
   EXPECT_EQ(addr5, routeDbDelta.unicastRoutesToDelete.at(0));
 }
 
+TEST(DecisionDebounceController, AdaptsToRecomputeCost) {
+  openr::detail::DecisionDebounceController controller(
+      std::chrono::milliseconds(10), std::chrono::milliseconds(250));
+
+  // nothing measured yet - converge as fast as configured
+  EXPECT_EQ(std::chrono::milliseconds(10), controller.initialBackoff());
+  EXPECT_EQ(std::chrono::milliseconds(250), controller.maxBackoff());
+
+  // expensive recomputation widens the window towards the measured cost
+  for (int i = 0; i < 20; ++i) {
+    controller.reportRouteBuildDuration(std::chrono::milliseconds(100));
+  }
+  EXPECT_GE(controller.initialBackoff(), std::chrono::milliseconds(90));
+  EXPECT_LE(controller.initialBackoff(), std::chrono::milliseconds(250));
+
+  // but never beyond the configured maximum
+  for (int i = 0; i < 20; ++i) {
+    controller.reportRouteBuildDuration(std::chrono::milliseconds(10000));
+  }
+  EXPECT_EQ(std::chrono::milliseconds(250), controller.initialBackoff());
+
+  // and cheap recomputation shrinks it back down to the configured minimum
+  for (int i = 0; i < 50; ++i) {
+    controller.reportRouteBuildDuration(std::chrono::milliseconds(0));
+  }
+  EXPECT_EQ(std::chrono::milliseconds(10), controller.initialBackoff());
+}
+
 int
 main(int argc, char* argv[]) {
   // Parse command line flags
@@ -8,6 +8,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
 #include <openr/common/NetworkUtil.h>
 #include <openr/common/Util.h>
 #include <openr/decision/LinkState.h>
@@ -193,6 +195,101 @@ TEST(LinkStateTest, BasicOperation) {
   EXPECT_THAT(state.linksFromNode(n3), UnorderedElementsAre(Pointee(l2)));
 }
 
+TEST(LinkStateTest, AdjacencyDbSnapshot) {
+  std::string n1 = "node1";
+  std::string n2 = "node2";
+  auto adj12 =
+      openr::createAdjacency(n2, "if2", "if1", "fe80::2", "10.0.0.2", 1, 1, 1);
+  auto adj21 =
+      openr::createAdjacency(n1, "if1", "if2", "fe80::1", "10.0.0.1", 1, 1, 1);
+
+  openr::LinkState state;
+  state.updateAdjacencyDatabase(openr::createAdjDb(n1, {adj12}, 1), 0, 0);
+  state.updateAdjacencyDatabase(openr::createAdjDb(n2, {adj21}, 2), 0, 0);
+
+  // repeated cuts without mutation share one snapshot
+  auto snap1 = state.getAdjacencyDbSnapshot();
+  EXPECT_EQ(snap1, state.getAdjacencyDbSnapshot());
+  EXPECT_EQ(state.getGeneration(), snap1->generation);
+  EXPECT_EQ(2, snap1->adjacencyDatabases.size());
+
+  // a mutation bumps the generation and yields a new snapshot, but the
+  // untouched node's database is shared with the previous cut
+  adj12.metric = 2;
+  state.updateAdjacencyDatabase(openr::createAdjDb(n1, {adj12}, 1), 0, 0);
+  auto snap2 = state.getAdjacencyDbSnapshot();
+  EXPECT_NE(snap1, snap2);
+  EXPECT_LT(snap1->generation, snap2->generation);
+  EXPECT_NE(
+      snap1->adjacencyDatabases.at(n1), snap2->adjacencyDatabases.at(n1));
+  EXPECT_EQ(
+      snap1->adjacencyDatabases.at(n2), snap2->adjacencyDatabases.at(n2));
+  EXPECT_EQ(2, snap2->adjacencyDatabases.at(n1)->adjacencies.at(0).metric);
+
+  // old snapshot keeps its view of the topology
+  EXPECT_EQ(1, snap1->adjacencyDatabases.at(n1)->adjacencies.at(0).metric);
+
+  // deletion drops the node from the next cut only
+  EXPECT_TRUE(state.deleteAdjacencyDatabase(n2));
+  auto snap3 = state.getAdjacencyDbSnapshot();
+  EXPECT_EQ(0, snap3->adjacencyDatabases.count(n2));
+  EXPECT_EQ(1, snap2->adjacencyDatabases.count(n2));
+}
+
+TEST(LinkStateTest, HoldTracking) {
+  std::string n1 = "node1";
+  std::string n2 = "node2";
+  auto adj12 =
+      openr::createAdjacency(n2, "if2", "if1", "fe80::2", "10.0.0.2", 1, 1, 1);
+  auto adj21 =
+      openr::createAdjacency(n1, "if1", "if2", "fe80::1", "10.0.0.1", 1, 1, 1);
+
+  openr::LinkState state;
+  EXPECT_FALSE(state.hasHolds());
+  EXPECT_FALSE(
+      state.updateAdjacencyDatabase(openr::createAdjDb(n1, {adj12}, 1), 2, 2)
+          .first);
+  EXPECT_FALSE(state.hasHolds());
+
+  // the link coming up is held for the hold-up ttl
+  EXPECT_FALSE(
+      state.updateAdjacencyDatabase(openr::createAdjDb(n2, {adj21}, 2), 2, 2)
+          .first);
+  EXPECT_TRUE(state.hasHolds());
+  EXPECT_FALSE(state.decrementHolds());
+  EXPECT_TRUE(state.hasHolds());
+  EXPECT_TRUE(state.decrementHolds());
+  EXPECT_FALSE(state.hasHolds());
+  EXPECT_FALSE(state.decrementHolds());
+
+  // a metric increase is held for the hold-down ttl
+  adj12.metric = 5;
+  EXPECT_FALSE(
+      state.updateAdjacencyDatabase(openr::createAdjDb(n1, {adj12}, 1), 1, 2)
+          .first);
+  EXPECT_TRUE(state.hasHolds());
+  EXPECT_FALSE(state.decrementHolds());
+  EXPECT_TRUE(state.decrementHolds());
+  EXPECT_FALSE(state.hasHolds());
+
+  // node overload holds are tracked too
+  auto adjDb1 = openr::createAdjDb(n1, {adj12}, 1);
+  adjDb1.isOverloaded = true;
+  EXPECT_FALSE(state.updateAdjacencyDatabase(adjDb1, 1, 1).first);
+  EXPECT_TRUE(state.hasHolds());
+  EXPECT_TRUE(state.decrementHolds());
+  EXPECT_FALSE(state.hasHolds());
+
+  // removing a held link drops its hold with it
+  adj12.metric = 10;
+  adjDb1 = openr::createAdjDb(n1, {adj12}, 1);
+  adjDb1.isOverloaded = true;
+  EXPECT_FALSE(state.updateAdjacencyDatabase(adjDb1, 1, 2).first);
+  EXPECT_TRUE(state.hasHolds());
+  EXPECT_TRUE(state.deleteAdjacencyDatabase(n2));
+  EXPECT_FALSE(state.hasHolds());
+}
+
 TEST(LinkStateTest, pathAInPathB) {
   auto l1 = std::make_shared<openr::Link>("1", "1/2", "2", "2/1");
   auto l2 = std::make_shared<openr::Link>("2", "2/3", "3", "3/2");
@@ -309,6 +406,246 @@ TEST(LinkStateTest, getKthPaths) {
   }
 }
 
+namespace {
+
+// adjacency between integer-named nodes with a directional metric
+openr::thrift::Adjacency
+intAdj(int node, int otherNode, int32_t metric) {
+  return openr::createAdjacency(
+      std::to_string(otherNode),
+      std::to_string(node) + "/" + std::to_string(otherNode),
+      std::to_string(otherNode) + "/" + std::to_string(node),
+      "fe80::1",
+      "192.168.0.1",
+      metric,
+      (node << 16) + otherNode);
+}
+
+// compare the memoized results in cached against a fresh LinkState built
+// from the same updates, whose empty cache forces full Dijkstra runs
+void
+expectCachedSpfMatchesFresh(
+    openr::LinkState& cached,
+    std::vector<openr::thrift::AdjacencyDatabase> const& updates,
+    std::vector<std::string> const& nodes) {
+  openr::LinkState fresh;
+  for (auto const& adjDb : updates) {
+    fresh.updateAdjacencyDatabase(adjDb, 0, 0);
+  }
+  for (auto const& src : nodes) {
+    for (bool useLinkMetric : {true, false}) {
+      auto const& a = cached.getSpfResult(src, useLinkMetric);
+      auto const& b = fresh.getSpfResult(src, useLinkMetric);
+      EXPECT_EQ(a.size(), b.size());
+      for (auto const& kv : b) {
+        ASSERT_EQ(1, a.count(kv.first));
+        auto const& aRes = a.at(kv.first);
+        EXPECT_EQ(aRes.metric(), kv.second.metric())
+            << src << " -> " << kv.first;
+        EXPECT_EQ(aRes.nextHops(), kv.second.nextHops())
+            << src << " -> " << kv.first;
+
+        // compare path links as unordered sets of (link, previous node)
+        std::vector<std::pair<std::string, std::string>> aPaths, bPaths;
+        for (auto const& pathLink : aRes.pathLinks()) {
+          aPaths.emplace_back(pathLink.link->toString(), pathLink.prevNode);
+        }
+        for (auto const& pathLink : kv.second.pathLinks()) {
+          bPaths.emplace_back(pathLink.link->toString(), pathLink.prevNode);
+        }
+        std::sort(aPaths.begin(), aPaths.end());
+        std::sort(bPaths.begin(), bPaths.end());
+        EXPECT_EQ(aPaths, bPaths) << src << " -> " << kv.first;
+      }
+    }
+  }
+}
+
+} // namespace
+
+TEST(LinkStateTest, SpfResultPatching) {
+  // single link metric changes patch memoized SPF results in place;
+  // verify they match full recomputation over the new topology exactly
+  //
+  //      10       10       10
+  //   1------2--------4--------5
+  //   |               |
+  //   +---------------+
+  //     10 (1-3)   20 (3-4)
+  //          3
+  auto const adj = &intAdj;
+  std::vector<std::string> const nodes{"1", "2", "3", "4", "5"};
+  std::vector<openr::thrift::AdjacencyDatabase> updates{
+      openr::createAdjDb("1", {adj(1, 2, 10), adj(1, 3, 10)}, 1),
+      openr::createAdjDb("2", {adj(2, 1, 10), adj(2, 4, 10)}, 2),
+      openr::createAdjDb("3", {adj(3, 1, 10), adj(3, 4, 20)}, 3),
+      openr::createAdjDb(
+          "4", {adj(4, 2, 10), adj(4, 3, 20), adj(4, 5, 10)}, 4),
+      openr::createAdjDb("5", {adj(5, 4, 10)}, 5)};
+
+  auto const expectSameSpf = [&](openr::LinkState& patched) {
+    expectCachedSpfMatchesFresh(patched, updates, nodes);
+  };
+
+  openr::LinkState patched;
+  for (auto const& adjDb : updates) {
+    patched.updateAdjacencyDatabase(adjDb, 0, 0);
+  }
+  // warm the memoization for every source
+  for (auto const& src : nodes) {
+    patched.getSpfResult(src);
+    patched.getSpfResult(src, false);
+  }
+
+  auto const applyUpdate = [&](openr::thrift::AdjacencyDatabase adjDb) {
+    EXPECT_TRUE(patched.updateAdjacencyDatabase(adjDb, 0, 0).first);
+    updates.push_back(std::move(adjDb));
+    expectSameSpf(patched);
+  };
+
+  // decrease 3->4 to an equal-cost path: 4 becomes ECMP from node 1
+  applyUpdate(openr::createAdjDb("3", {adj(3, 1, 10), adj(3, 4, 10)}, 3));
+
+  // decrease the reverse direction 4->3: shortens paths towards 3
+  applyUpdate(openr::createAdjDb(
+      "4", {adj(4, 2, 10), adj(4, 3, 10), adj(4, 5, 10)}, 4));
+
+  // increase 2->4: node 1 loses the path via 2, node 2 gains ECMP to 4
+  applyUpdate(openr::createAdjDb("2", {adj(2, 1, 10), adj(2, 4, 30)}, 2));
+
+  // increase 1->2 on a link used only for the direct adjacency
+  applyUpdate(openr::createAdjDb("1", {adj(1, 2, 11), adj(1, 3, 10)}, 1));
+
+  // decrease 1->2 back; exercises the not-competitive early-out for
+  // sources whose trees never use the edge
+  applyUpdate(openr::createAdjDb("1", {adj(1, 2, 10), adj(1, 3, 10)}, 1));
+}
+
+TEST(LinkStateTest, SpfCacheInvalidation) {
+  // capacity-removing changes (links down, metric increases, node
+  // overloads) only drop the cached SPF trees that depended on the
+  // affected resource; verify surviving and recomputed results alike
+  // match full recomputation. Topology as in SpfResultPatching
+  auto const adj = &intAdj;
+  std::vector<std::string> const nodes{"1", "2", "3", "4", "5"};
+  std::vector<openr::thrift::AdjacencyDatabase> updates{
+      openr::createAdjDb("1", {adj(1, 2, 10), adj(1, 3, 10)}, 1),
+      openr::createAdjDb("2", {adj(2, 1, 10), adj(2, 4, 10)}, 2),
+      openr::createAdjDb("3", {adj(3, 1, 10), adj(3, 4, 20)}, 3),
+      openr::createAdjDb(
+          "4", {adj(4, 2, 10), adj(4, 3, 20), adj(4, 5, 10)}, 4),
+      openr::createAdjDb("5", {adj(5, 4, 10)}, 5)};
+
+  openr::LinkState linkState;
+  for (auto const& adjDb : updates) {
+    linkState.updateAdjacencyDatabase(adjDb, 0, 0);
+  }
+  auto const warmCache = [&]() {
+    for (auto const& src : nodes) {
+      linkState.getSpfResult(src);
+      linkState.getSpfResult(src, false);
+      for (auto const& dest : nodes) {
+        linkState.getKthPaths(src, dest, 1);
+        linkState.getKthPaths(src, dest, 2);
+      }
+    }
+  };
+
+  // equal-cost ties may be broken differently by a surviving k-path
+  // result and a fresh computation, so compare path costs, not links
+  auto const pathCosts = [](std::vector<openr::LinkState::Path> const& paths,
+                            std::string const& src) {
+    std::vector<openr::LinkStateMetric> costs;
+    for (auto const& path : paths) {
+      openr::LinkStateMetric cost = 0;
+      std::string cur = src;
+      for (auto const& link : path) {
+        cost += link->getMetricFromNode(cur);
+        cur = link->getOtherNodeName(cur);
+      }
+      costs.push_back(cost);
+    }
+    std::sort(costs.begin(), costs.end());
+    return costs;
+  };
+
+  auto const applyUpdate = [&](openr::thrift::AdjacencyDatabase adjDb) {
+    warmCache();
+    EXPECT_TRUE(linkState.updateAdjacencyDatabase(adjDb, 0, 0).first);
+    updates.push_back(std::move(adjDb));
+    expectCachedSpfMatchesFresh(linkState, updates, nodes);
+
+    openr::LinkState fresh;
+    for (auto const& db : updates) {
+      fresh.updateAdjacencyDatabase(db, 0, 0);
+    }
+    for (auto const& src : nodes) {
+      for (auto const& dest : nodes) {
+        for (size_t k = 1; k <= 2; ++k) {
+          auto const& a = linkState.getKthPaths(src, dest, k);
+          auto const& b = fresh.getKthPaths(src, dest, k);
+          ASSERT_EQ(a.size(), b.size())
+              << src << " -> " << dest << " k " << k;
+          EXPECT_EQ(pathCosts(a, src), pathCosts(b, src))
+              << src << " -> " << dest << " k " << k;
+        }
+      }
+    }
+  };
+
+  // two metric increases in one update: too many for in-place patching,
+  // but hop-count trees and metric trees avoiding both links stay warm
+  applyUpdate(openr::createAdjDb(
+      "4", {adj(4, 2, 15), adj(4, 3, 20), adj(4, 5, 15)}, 4));
+
+  // node 5 withdraws its adjacency: link 4-5 goes down, only trees that
+  // traversed it are recomputed
+  applyUpdate(openr::createAdjDb("5", {}, 5));
+
+  // overload node 3: trees transiting 3 change, those merely reaching it
+  // (and 3's own tree) stay warm
+  {
+    auto adjDb = openr::createAdjDb("3", {adj(3, 1, 10), adj(3, 4, 20)}, 3);
+    adjDb.isOverloaded = true;
+    applyUpdate(adjDb);
+  }
+
+  // additive change: the link to 5 comes back, whole cache is flushed
+  applyUpdate(openr::createAdjDb("5", {adj(5, 4, 10)}, 5));
+}
+
+TEST(LinkStateTest, WarmSpfResults) {
+  auto const adj = &intAdj;
+  std::vector<openr::thrift::AdjacencyDatabase> adjDbs = {
+      openr::createAdjDb("1", {adj(1, 2, 10), adj(1, 3, 10)}, 1),
+      openr::createAdjDb("2", {adj(2, 1, 10), adj(2, 4, 10)}, 2),
+      openr::createAdjDb("3", {adj(3, 1, 10), adj(3, 4, 20)}, 3),
+      openr::createAdjDb("4", {adj(4, 2, 10), adj(4, 3, 20), adj(4, 5, 10)}, 4),
+      openr::createAdjDb("5", {adj(5, 4, 10)}, 5),
+  };
+  openr::LinkState warmed, lazy;
+  for (auto const& adjDb : adjDbs) {
+    warmed.updateAdjacencyDatabase(adjDb, 0, 0);
+    lazy.updateAdjacencyDatabase(adjDb, 0, 0);
+  }
+
+  std::vector<std::string> const nodes{"1", "2", "3", "4", "5"};
+  folly::CPUThreadPoolExecutor pool{4};
+  // duplicates and already-cached sources are tolerated
+  warmed.warmSpfResults({"1", "1", "2"}, &pool);
+  warmed.warmSpfResults(nodes, &pool);
+
+  for (auto const& node : nodes) {
+    auto const& a = warmed.getSpfResult(node);
+    auto const& b = lazy.getSpfResult(node);
+    ASSERT_EQ(a.size(), b.size());
+    for (auto const& [otherNode, result] : a) {
+      EXPECT_EQ(result.metric(), b.at(otherNode).metric());
+      EXPECT_EQ(result.nextHops(), b.at(otherNode).nextHops());
+    }
+  }
+}
+
 TEST(LinkStateTest, getHopCounts) {
   {
     // box
@@ -32,7 +32,7 @@ class PrefixStateTestFixture : public ::testing::Test {
     for (size_t i = 0; i < numNodes; ++i) {
       std::string nodeName = std::to_string(i);
       prefixDbs_[nodeName] = createPrefixDbForNode(nodeName, i);
-      EXPECT_TRUE(state_.updatePrefixDatabase(prefixDbs_[nodeName]));
+      EXPECT_FALSE(state_.updatePrefixDatabase(prefixDbs_[nodeName]).empty());
     }
   }
 
@@ -53,30 +53,141 @@ class PrefixStateTestFixture : public ::testing::Test {
 TEST_F(PrefixStateTestFixture, basicOperation) {
   EXPECT_EQ(state_.getPrefixDatabases(), prefixDbs_);
   auto const dbEntry = *prefixDbs_.begin();
-  EXPECT_FALSE(state_.updatePrefixDatabase(dbEntry.second));
+  EXPECT_TRUE(state_.updatePrefixDatabase(dbEntry.second).empty());
 
   auto prefixDb1Updated = dbEntry.second;
   prefixDb1Updated.prefixEntries.at(0).type = thrift::PrefixType::BREEZE;
-  EXPECT_TRUE(state_.updatePrefixDatabase(prefixDb1Updated));
-  EXPECT_FALSE(state_.updatePrefixDatabase(prefixDb1Updated));
+  EXPECT_FALSE(state_.updatePrefixDatabase(prefixDb1Updated).empty());
+  EXPECT_TRUE(state_.updatePrefixDatabase(prefixDb1Updated).empty());
   EXPECT_EQ(prefixDb1Updated, state_.getPrefixDatabases().at(dbEntry.first));
 
   prefixDb1Updated.prefixEntries.at(0).forwardingType =
       thrift::PrefixForwardingType::SR_MPLS;
-  EXPECT_TRUE(state_.updatePrefixDatabase(prefixDb1Updated));
-  EXPECT_FALSE(state_.updatePrefixDatabase(prefixDb1Updated));
+  EXPECT_FALSE(state_.updatePrefixDatabase(prefixDb1Updated).empty());
+  EXPECT_TRUE(state_.updatePrefixDatabase(prefixDb1Updated).empty());
   EXPECT_EQ(prefixDb1Updated, state_.getPrefixDatabases().at(dbEntry.first));
 
   thrift::PrefixDatabase emptyPrefixDb;
   emptyPrefixDb.thisNodeName = dbEntry.first;
-  EXPECT_TRUE(state_.updatePrefixDatabase(emptyPrefixDb));
+  EXPECT_FALSE(state_.updatePrefixDatabase(emptyPrefixDb).empty());
   auto modifiedPrefixDbs = prefixDbs_;
   modifiedPrefixDbs.erase(dbEntry.first);
   EXPECT_NE(prefixDbs_, modifiedPrefixDbs);
   EXPECT_EQ(state_.getPrefixDatabases(), modifiedPrefixDbs);
   emptyPrefixDb.thisNodeName = dbEntry.first;
-  EXPECT_FALSE(state_.updatePrefixDatabase(emptyPrefixDb));
-  EXPECT_TRUE(state_.updatePrefixDatabase(dbEntry.second));
+  EXPECT_TRUE(state_.updatePrefixDatabase(emptyPrefixDb).empty());
+  EXPECT_FALSE(state_.updatePrefixDatabase(dbEntry.second).empty());
+}
+
+TEST_F(PrefixStateTestFixture, deltaUpdateAndWithdraw) {
+  auto const prefix = toIpPrefix("10.1.0.0/16");
+  auto entry = createPrefixEntry(prefix);
+
+  EXPECT_TRUE(state_.updatePrefix("0", entry));
+  EXPECT_FALSE(state_.updatePrefix("0", entry));
+  EXPECT_EQ(1, state_.prefixes().at(prefix).count("0"));
+
+  entry.type = thrift::PrefixType::BREEZE;
+  EXPECT_TRUE(state_.updatePrefix("0", entry));
+  EXPECT_FALSE(state_.updatePrefix("0", entry));
+  EXPECT_EQ(entry, state_.prefixes().at(prefix).at("0"));
+
+  // two advertisers, prefix lives until the last one withdraws
+  EXPECT_TRUE(state_.updatePrefix("1", entry));
+  EXPECT_TRUE(state_.withdrawPrefix("0", prefix));
+  EXPECT_FALSE(state_.withdrawPrefix("0", prefix));
+  EXPECT_EQ(1, state_.prefixes().count(prefix));
+  EXPECT_TRUE(state_.withdrawPrefix("1", prefix));
+  EXPECT_EQ(0, state_.prefixes().count(prefix));
+
+  // delta updates must stay consistent with full-db updates
+  EXPECT_EQ(state_.getPrefixDatabases(), prefixDbs_);
+}
+
+TEST_F(PrefixStateTestFixture, changedPrefixTracking) {
+  state_.clearChangedPrefixes();
+  EXPECT_TRUE(state_.getChangedPrefixes().empty());
+
+  auto const prefix = toIpPrefix("10.1.0.0/16");
+  EXPECT_TRUE(state_.updatePrefix("0", createPrefixEntry(prefix)));
+  EXPECT_THAT(
+      state_.getChangedPrefixes(), testing::UnorderedElementsAre(prefix));
+  state_.clearChangedPrefixes();
+
+  // no-op updates leave the tracking empty
+  EXPECT_FALSE(state_.updatePrefix("0", createPrefixEntry(prefix)));
+  EXPECT_TRUE(state_.getChangedPrefixes().empty());
+
+  // a host-loopback change fans out to all of the node's prefixes since
+  // loopbacks feed BGP route nexthops
+  auto const loopback = toIpPrefix("10.2.0.1/32");
+  EXPECT_TRUE(state_.updatePrefix("0", createPrefixEntry(loopback)));
+  EXPECT_THAT(
+      state_.getChangedPrefixes(), testing::IsSupersetOf({prefix, loopback}));
+  state_.clearChangedPrefixes();
+
+  EXPECT_TRUE(state_.withdrawPrefix("0", loopback));
+  EXPECT_THAT(
+      state_.getChangedPrefixes(), testing::IsSupersetOf({prefix, loopback}));
+
+  // the batch API returns the exact dirty set and drains the accumulator
+  state_.clearChangedPrefixes();
+  auto const batchPrefix = toIpPrefix("10.3.0.0/16");
+  auto changed = state_.updatePrefixDatabase(
+      createPrefixDb("batch", {createPrefixEntry(batchPrefix)}));
+  EXPECT_THAT(changed, testing::UnorderedElementsAre(batchPrefix));
+  EXPECT_TRUE(state_.getChangedPrefixes().empty());
+}
+
+TEST_F(PrefixStateTestFixture, trieAggregationQueries) {
+  for (auto const& prefixStr :
+       {"10.1.0.0/16", "10.1.1.0/24", "10.1.1.128/25", "10.2.0.0/16"}) {
+    EXPECT_TRUE(
+        state_.updatePrefix("0", createPrefixEntry(toIpPrefix(prefixStr))));
+  }
+
+  EXPECT_THAT(
+      state_.getCoveredPrefixes(toIpPrefix("10.1.0.0/16")),
+      testing::UnorderedElementsAre(
+          toIpPrefix("10.1.0.0/16"),
+          toIpPrefix("10.1.1.0/24"),
+          toIpPrefix("10.1.1.128/25")));
+  EXPECT_THAT(
+      state_.getCoveredPrefixes(toIpPrefix("10.0.0.0/8")),
+      testing::UnorderedElementsAre(
+          toIpPrefix("10.0.0.0/32"),
+          toIpPrefix("10.0.0.1/32"),
+          toIpPrefix("10.1.0.0/16"),
+          toIpPrefix("10.1.1.0/24"),
+          toIpPrefix("10.1.1.128/25"),
+          toIpPrefix("10.2.0.0/16")));
+  EXPECT_TRUE(state_.getCoveredPrefixes(toIpPrefix("11.0.0.0/8")).empty());
+
+  EXPECT_EQ(
+      toIpPrefix("10.1.1.128/25"),
+      state_.getLongestMatch(toIpPrefix("10.1.1.129/32")).value());
+  EXPECT_EQ(
+      toIpPrefix("10.1.1.0/24"),
+      state_.getLongestMatch(toIpPrefix("10.1.1.1/32")).value());
+  // exact match counts
+  EXPECT_EQ(
+      toIpPrefix("10.2.0.0/16"),
+      state_.getLongestMatch(toIpPrefix("10.2.0.0/16")).value());
+  EXPECT_FALSE(state_.getLongestMatch(toIpPrefix("11.0.0.0/8")).has_value());
+
+  // withdrawing drops the prefix from the index
+  EXPECT_TRUE(state_.withdrawPrefix("0", toIpPrefix("10.1.1.128/25")));
+  EXPECT_EQ(
+      toIpPrefix("10.1.1.0/24"),
+      state_.getLongestMatch(toIpPrefix("10.1.1.129/32")).value());
+
+  // v4 and v6 tries must not alias
+  EXPECT_TRUE(state_.getCoveredPrefixes(toIpPrefix("fc00::/7")).empty());
+  EXPECT_THAT(
+      state_.getCoveredPrefixes(toIpPrefix("::/0")),
+      testing::UnorderedElementsAre(
+          toIpPrefix("::ffff:10.0.0.0/128"),
+          toIpPrefix("::ffff:10.0.0.1/128")));
 }
 
 class GetLoopbackViasTest : public PrefixStateTestFixture,
@@ -139,7 +250,7 @@ TEST_F(PrefixStateTestFixture, getNodeHostLoopbacksV4) {
 
   thrift::PrefixDatabase emptyPrefixDb;
   emptyPrefixDb.thisNodeName = "0";
-  EXPECT_TRUE(state_.updatePrefixDatabase(emptyPrefixDb));
+  EXPECT_FALSE(state_.updatePrefixDatabase(emptyPrefixDb).empty());
   EXPECT_THAT(
       state_.getNodeHostLoopbacksV4(), testing::UnorderedElementsAre(pair2));
 }
@@ -155,7 +266,7 @@ TEST_F(PrefixStateTestFixture, getNodeHostLoopbacksV6) {
 
   thrift::PrefixDatabase emptyPrefixDb;
   emptyPrefixDb.thisNodeName = "0";
-  EXPECT_TRUE(state_.updatePrefixDatabase(emptyPrefixDb));
+  EXPECT_FALSE(state_.updatePrefixDatabase(emptyPrefixDb).empty());
   EXPECT_THAT(
       state_.getNodeHostLoopbacksV6(), testing::UnorderedElementsAre(pair2));
 }
@@ -196,12 +307,12 @@ TEST_P(LoopbackTestWithParam, AddRemoveLoopbackV4orV6) {
   thrift::PrefixDatabase emptyPrefixDb;
   emptyPrefixDb.thisNodeName = "0";
   emptyPrefixDb.prefixEntries = {node0LB, p1};
-  EXPECT_TRUE(state_.updatePrefixDatabase(emptyPrefixDb));
+  EXPECT_FALSE(state_.updatePrefixDatabase(emptyPrefixDb).empty());
 
   // withdraw loopback and p1, announcing p2, expect no loopback is there
   // anymore
   emptyPrefixDb.prefixEntries = {p2};
-  EXPECT_TRUE(state_.updatePrefixDatabase(emptyPrefixDb));
+  EXPECT_FALSE(state_.updatePrefixDatabase(emptyPrefixDb).empty());
   if (isV4) {
     EXPECT_THAT(
         state_.getNodeHostLoopbacksV4(), testing::UnorderedElementsAre(pair2));
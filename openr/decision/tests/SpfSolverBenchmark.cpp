@@ -0,0 +1,262 @@
+/**
+ * Copyright (c) 2014-present, Facebook, Inc.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <sys/resource.h>
+
+#include <random>
+#include <set>
+
+#include <fb303/ServiceData.h>
+#include <folly/Benchmark.h>
+#include <folly/Format.h>
+#include <folly/init/Init.h>
+
+#include <openr/common/Util.h>
+#include <openr/decision/Decision.h>
+
+/**
+ * Defines a benchmark that allows users to record customized counter during
+ * benchmarking and passes a parameter to another one. This is common for
+ * benchmarks that need a "problem size" in addition to "number of iterations".
+ */
+#define BENCHMARK_COUNTERS_PARAM(name, counters, param_name, ...)      \
+  BENCHMARK_IMPL_COUNTERS(                                             \
+      FB_CONCATENATE(name, FB_CONCATENATE(_, param_name)),             \
+      FOLLY_PP_STRINGIZE(name) "(" FOLLY_PP_STRINGIZE(param_name) ")", \
+      counters,                                                        \
+      iters,                                                           \
+      unsigned,                                                        \
+      iters) {                                                         \
+    name(counters, iters, ##__VA_ARGS__);                              \
+  }
+
+namespace {
+
+// fixed seed so random topologies are reproducible across runs
+const uint32_t kRandomSeed{7};
+// neighbors added per node in the random topology class
+const int kRandomDegree{4};
+// fat-tree dimensions: spines, and fabric/rack switches per pod
+const int kNumOfSsws = 8;
+const int kNumOfFswsPerPod = 4;
+const int kNumOfRswsPerPod = 8;
+
+// symmetric adjacency list: per node, (neighbor, metric) pairs
+using AdjacencyLists = std::vector<std::vector<std::pair<int, int>>>;
+
+std::string
+getIfName(const int id, const int otherId) {
+  // Naming convention of ifName: "if_<my-id>_<neighbor-id>"
+  return folly::sformat("if_{}_{}", id, otherId);
+}
+
+long
+getPeakRssKb() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+void
+addEdge(AdjacencyLists& adjLists, const int a, const int b, const int metric) {
+  adjLists[a].emplace_back(b, metric);
+  adjLists[b].emplace_back(a, metric);
+}
+
+// Ring topology: node i connects to nodes (i +/- 1) mod n
+AdjacencyLists
+createRingTopo(const int n) {
+  AdjacencyLists adjLists(n);
+  for (int i = 0; i < n; ++i) {
+    addEdge(adjLists, i, (i + 1) % n, 10);
+  }
+  return adjLists;
+}
+
+// Random topology: a ring for connectivity plus kRandomDegree random
+// neighbors per node, from a fixed seed. Edges are deduplicated so no node
+// pair carries parallel links
+AdjacencyLists
+createRandomTopo(const int n) {
+  AdjacencyLists adjLists(n);
+  std::mt19937 rng(kRandomSeed);
+  std::set<std::pair<int, int>> edges;
+  auto const tryAddEdge = [&](int a, int b) {
+    if (a == b) {
+      return;
+    }
+    if (edges.emplace(std::min(a, b), std::max(a, b)).second) {
+      addEdge(adjLists, a, b, 10);
+    }
+  };
+  for (int i = 0; i < n; ++i) {
+    tryAddEdge(i, (i + 1) % n);
+    for (int d = 0; d < kRandomDegree; ++d) {
+      tryAddEdge(i, rng() % n);
+    }
+  }
+  return adjLists;
+}
+
+// Fat-tree topology: kNumOfSsws spines, pods of kNumOfFswsPerPod fabric
+// switches and kNumOfRswsPerPod rack switches. Every fsw connects to every
+// spine, every rsw to every fsw in its pod. Pod count is derived from the
+// requested node count
+AdjacencyLists
+createFatTreeTopo(const int numOfGivenNodes) {
+  const int podSize = kNumOfFswsPerPod + kNumOfRswsPerPod;
+  const int numOfPods = std::max(1, (numOfGivenNodes - kNumOfSsws) / podSize);
+  const int n = kNumOfSsws + numOfPods * podSize;
+  AdjacencyLists adjLists(n);
+  for (int podId = 0; podId < numOfPods; ++podId) {
+    const int podBase = kNumOfSsws + podId * podSize;
+    for (int fswId = 0; fswId < kNumOfFswsPerPod; ++fswId) {
+      const int fsw = podBase + fswId;
+      for (int ssw = 0; ssw < kNumOfSsws; ++ssw) {
+        addEdge(adjLists, fsw, ssw, 10);
+      }
+      for (int rswId = 0; rswId < kNumOfRswsPerPod; ++rswId) {
+        addEdge(adjLists, fsw, podBase + kNumOfFswsPerPod + rswId, 10);
+      }
+    }
+  }
+  return adjLists;
+}
+
+} // namespace
+
+namespace openr {
+
+namespace {
+
+thrift::AdjacencyDatabase
+createAdjDbForNode(
+    const int nodeId, std::vector<std::pair<int, int>> const& neighbors) {
+  std::vector<thrift::Adjacency> adjs;
+  for (auto const& [otherId, metric] : neighbors) {
+    adjs.emplace_back(createThriftAdjacency(
+        folly::sformat("{}", otherId),
+        getIfName(nodeId, otherId),
+        folly::sformat("fe80::{:x}", otherId),
+        folly::sformat("10.0.{}.{}", otherId >> 8, otherId & 0xff),
+        metric,
+        100001 + otherId /* adjacency-label */,
+        false /* overload-bit */,
+        metric * 100 /* rtt */,
+        10000 /* timestamp */,
+        1 /* weight */,
+        getIfName(otherId, nodeId)));
+  }
+  return createAdjDb(folly::sformat("{}", nodeId), adjs, 0);
+}
+
+/**
+ * Feed a generated topology through SpfSolver::updateAdjacencyDatabase and
+ * buildRouteDb, flipping one link metric per iteration to defeat the SPF
+ * caches the way ongoing churn does. Reports per-iteration adjacency update
+ * and route build times plus peak RSS as user counters.
+ */
+void
+runTopologyBenchmark(
+    folly::UserCounters& counters, uint32_t iters, AdjacencyLists adjLists) {
+  folly::BenchmarkSuspender suspender;
+
+  const int n = adjLists.size();
+  SpfSolver spfSolver(
+      "0",
+      false /* enableV4 */,
+      false /* computeLfaPaths */);
+
+  std::vector<thrift::AdjacencyDatabase> adjDbs;
+  adjDbs.reserve(n);
+  for (int i = 0; i < n; ++i) {
+    adjDbs.emplace_back(createAdjDbForNode(i, adjLists[i]));
+    spfSolver.updateAdjacencyDatabase(adjDbs.back());
+  }
+  for (int i = 0; i < n; ++i) {
+    auto const nodeName = folly::sformat("{}", i);
+    spfSolver.updatePrefixDatabase(createPrefixDb(
+        nodeName, {createPrefixEntry(toIpPrefix(folly::sformat(
+                      "fc00:{:x}::1/128", i)))}));
+  }
+
+  uint64_t adjUpdateUsecs{0}, routeBuildUsecs{0};
+  suspender.dismiss(); // Start measuring benchmark time
+
+  for (uint32_t i = 0; i < iters; ++i) {
+    // flip one link metric so caches can't serve the run wholesale
+    auto& adjDb = adjDbs[i % n];
+    adjDb.adjacencies.front().metric ^= 1;
+
+    auto start = std::chrono::steady_clock::now();
+    spfSolver.updateAdjacencyDatabase(adjDb);
+    auto mid = std::chrono::steady_clock::now();
+    auto routeDb = spfSolver.buildRouteDb("0");
+    auto end = std::chrono::steady_clock::now();
+    CHECK(routeDb.has_value());
+
+    adjUpdateUsecs += std::chrono::duration_cast<std::chrono::microseconds>(
+                          mid - start)
+                          .count();
+    routeBuildUsecs +=
+        std::chrono::duration_cast<std::chrono::microseconds>(end - mid)
+            .count();
+  }
+
+  suspender.rehire(); // Stop measuring time again
+
+  const uint32_t divisor = iters == 0 ? 1 : iters;
+  counters["adj_update_us"] = adjUpdateUsecs / divisor;
+  counters["route_build_us"] = routeBuildUsecs / divisor;
+  // cumulative SPF time as recorded by the solver itself
+  if (facebook::fb303::fbData->hasCounter("decision.spf_ms.avg.60")) {
+    counters["spf_ms_avg"] =
+        facebook::fb303::fbData->getCounter("decision.spf_ms.avg.60");
+  }
+  counters["peak_rss_kb"] = getPeakRssKb();
+}
+
+void
+BM_SpfSolverRing(folly::UserCounters& counters, uint32_t iters, int n) {
+  runTopologyBenchmark(counters, iters, createRingTopo(n));
+}
+
+void
+BM_SpfSolverRandom(folly::UserCounters& counters, uint32_t iters, int n) {
+  runTopologyBenchmark(counters, iters, createRandomTopo(n));
+}
+
+void
+BM_SpfSolverFatTree(folly::UserCounters& counters, uint32_t iters, int n) {
+  runTopologyBenchmark(counters, iters, createFatTreeTopo(n));
+}
+
+} // namespace
+
+// The integer parameter is the number of nodes in the topology
+BENCHMARK_COUNTERS_PARAM(BM_SpfSolverRing, counters, 100, 100);
+BENCHMARK_COUNTERS_PARAM(BM_SpfSolverRing, counters, 1000, 1000);
+BENCHMARK_COUNTERS_PARAM(BM_SpfSolverRing, counters, 10000, 10000);
+
+BENCHMARK_COUNTERS_PARAM(BM_SpfSolverRandom, counters, 100, 100);
+BENCHMARK_COUNTERS_PARAM(BM_SpfSolverRandom, counters, 1000, 1000);
+BENCHMARK_COUNTERS_PARAM(BM_SpfSolverRandom, counters, 10000, 10000);
+
+// The parameter is the requested node count; the actual count is rounded
+// to whole pods
+BENCHMARK_COUNTERS_PARAM(BM_SpfSolverFatTree, counters, 100, 100);
+BENCHMARK_COUNTERS_PARAM(BM_SpfSolverFatTree, counters, 1000, 1000);
+BENCHMARK_COUNTERS_PARAM(BM_SpfSolverFatTree, counters, 10000, 10000);
+
+} // namespace openr
+
+int
+main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -79,6 +79,36 @@ Dual::Dual(
     info_.feasibleDistance = 0;
     info_.nexthop = nodeId;
   }
+
+  // seed the feasible-successor table for the neighbors known so far
+  for (const auto& kv : localDistances_) {
+    updateNeighborDistance(kv.first);
+  }
+}
+
+void
+Dual::updateNeighborDistance(const std::string& neighbor) {
+  const auto ldIter = localDistances_.find(neighbor);
+  if (ldIter == localDistances_.end()) {
+    return;
+  }
+  int64_t rd = std::numeric_limits<int64_t>::max();
+  const auto infoIter = info_.neighborInfos.find(neighbor);
+  if (infoIter != info_.neighborInfos.end()) {
+    rd = infoIter->second.reportDistance;
+  }
+  const int64_t d = addDistances(ldIter->second, rd);
+  const auto cacheIter = neighborDistances_.find(neighbor);
+  if (cacheIter != neighborDistances_.end()) {
+    if (cacheIter->second == d) {
+      return;
+    }
+    sortedDistances_.erase(sortedDistances_.find(cacheIter->second));
+    cacheIter->second = d;
+  } else {
+    neighborDistances_.emplace(neighbor, d);
+  }
+  sortedDistances_.emplace(d);
 }
 
 int64_t
@@ -87,13 +117,8 @@ Dual::getMinDistance() {
     // I'm the root
     return 0;
   }
-  int64_t dmin = std::numeric_limits<int64_t>::max();
-  for (const auto& kv : localDistances_) {
-    const auto& ld = kv.second;
-    const auto& rd = info_.neighborInfos[kv.first].reportDistance;
-    dmin = std::min(dmin, addDistances(ld, rd));
-  }
-  return dmin;
+  return sortedDistances_.empty() ? std::numeric_limits<int64_t>::max()
+                                  : *sortedDistances_.begin();
 }
 
 bool
@@ -121,25 +146,14 @@ Dual::routeAffected() {
     return false;
   }
 
-  std::unordered_set<std::string> nexthops;
-  for (const auto& kv : localDistances_) {
-    const auto& neighbor = kv.first;
-    const auto& ld = kv.second;
-    const auto& rd = info_.neighborInfos[neighbor].reportDistance;
-    int64_t d = addDistances(ld, rd);
-    if (d == dmin) {
-      nexthops.emplace(neighbor);
-    }
-  }
-
   // nexthop MUST has value, if it's none, it will be handled in
   // above "distance changed" or "no valid route found" cases
   CHECK(info_.nexthop.has_value());
-  if (nexthops.count(*info_.nexthop) == 0) {
-    // nextHop changed
-    auto oldnh = info_.nexthop.has_value() ? *info_.nexthop : "none";
-    VLOG(2) << rootId << "::" << nodeId << ": nexthop changed " << oldnh
-            << " -> " << folly::join(",", nexthops);
+  const auto nhIter = neighborDistances_.find(*info_.nexthop);
+  if (nhIter == neighborDistances_.end() or nhIter->second != dmin) {
+    // nextHop no longer on a minimum-distance path
+    VLOG(2) << rootId << "::" << nodeId << ": nexthop changed "
+            << *info_.nexthop;
     return true;
   }
   return false;
@@ -157,7 +171,8 @@ Dual::meetFeasibleCondition(std::string& nexthop, int64_t& distance) {
       continue;
     }
     const auto& rd = info_.neighborInfos[neighbor].reportDistance;
-    if (rd < info_.feasibleDistance and addDistances(ld, rd) == dmin) {
+    if (rd < info_.feasibleDistance and
+        neighborDistances_.at(neighbor) == dmin) {
       VLOG(2) << rootId << "::" << nodeId << ": meet FC: " << neighbor << ", "
               << rd << ", " << dmin;
       nexthop = neighbor;
@@ -420,6 +435,7 @@ Dual::peerUp(
   // update local-distance
   localDistances_[neighbor] = cost;
   info_.neighborInfos.emplace(neighbor, NeighborInfo());
+  updateNeighborDistance(neighbor);
 
   if (info_.sm.state == DualState::PASSIVE) {
     // passive
@@ -479,6 +495,7 @@ Dual::peerDown(
   localDistances_[neighbor] = std::numeric_limits<int64_t>::max();
   info_.neighborInfos[neighbor].reportDistance =
       std::numeric_limits<int64_t>::max();
+  updateNeighborDistance(neighbor);
   DualEvent event = DualEvent::INCREASE_D;
 
   if (info_.sm.state == DualState::PASSIVE) {
@@ -511,6 +528,7 @@ Dual::peerCostChange(
                                                      : DualEvent::OTHERS;
   // update local-distance
   localDistances_[neighbor] = cost;
+  updateNeighborDistance(neighbor);
 
   if (info_.sm.state == DualState::PASSIVE) {
     // passive
@@ -543,6 +561,7 @@ Dual::processUpdate(
 
   // update report-distance
   info_.neighborInfos[neighbor].reportDistance = rd;
+  updateNeighborDistance(neighbor);
 
   if (localDistances_.count(neighbor) == 0) {
     // received UPDATE before having local info_ (LINK-UP), done here
@@ -609,6 +628,7 @@ Dual::processQuery(
 
   // update report-distance
   info_.neighborInfos[neighbor].reportDistance = rd;
+  updateNeighborDistance(neighbor);
   info_.cornet.emplace(neighbor);
   DualEvent event = DualEvent::OTHERS;
   if (info_.nexthop.has_value() and *info_.nexthop == neighbor) {
@@ -658,6 +678,7 @@ Dual::processReply(
   // update report-distance and expect-reply flag
   info_.neighborInfos[neighbor].reportDistance = reportDistance;
   info_.neighborInfos[neighbor].expectReply = false;
+  updateNeighborDistance(neighbor);
 
   bool lastReply = true;
   for (const auto& kv : info_.neighborInfos) {
@@ -675,17 +696,14 @@ Dual::processReply(
   // Therefore, I'm free to pick the optimal solution
   info_.sm.processEvent(DualEvent::LAST_REPLY, true);
 
-  int64_t d;
-  int64_t dmin = std::numeric_limits<int64_t>::max();
+  int64_t dmin = getMinDistance();
   std::optional<std::string> newNh{std::nullopt};
-  for (const auto& kv : localDistances_) {
-    const auto& nb = kv.first;
-    const auto& ld = kv.second;
-    const auto& rd = info_.neighborInfos[nb].reportDistance;
-    d = addDistances(ld, rd);
-    if (d < dmin) {
-      dmin = d;
-      newNh = nb;
+  if (dmin != std::numeric_limits<int64_t>::max()) {
+    for (const auto& kv : neighborDistances_) {
+      if (kv.second == dmin) {
+        newNh = kv.first;
+        break;
+      }
     }
   }
   bool sameRd = dmin == info_.reportDistance;
@@ -9,6 +9,7 @@
 
 #include <functional>
 #include <limits>
+#include <set>
 #include <stack>
 #include <unordered_map>
 
@@ -271,6 +272,11 @@ class Dual {
   // check if a neighbor is up or not
   bool neighborUp(const std::string& neighbor);
 
+  // recompute the cached distance (local-distance + report-distance) of one
+  // neighbor, keeping the sorted distance multiset in sync. MUST be called
+  // after any mutation of the neighbor's local- or report-distance
+  void updateNeighborDistance(const std::string& neighbor);
+
   // clear counters to zero for a given neighbor
   void clearCounters(const std::string& neighbor) noexcept;
 
@@ -280,6 +286,13 @@ class Dual {
   // local neighbor distances
   std::unordered_map<std::string, int64_t> localDistances_;
 
+  // feasible-successor table: cached distance towards root via each
+  // neighbor, plus the same values in sorted order. Single-neighbor events
+  // (an UPDATE, one link-cost change) adjust one entry instead of
+  // rescanning every neighbor for the minimum distance
+  std::unordered_map<std::string, int64_t> neighborDistances_;
+  std::multiset<int64_t> sortedDistances_;
+
   // dual messages counters map<neighbor: dual-counters>
   std::map<std::string, thrift::DualPerRootCounters> counters_;
 
@@ -7,11 +7,18 @@
 
 #include "Fib.h"
 
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <deque>
+#include <thread>
+
 #include <fb303/ServiceData.h>
 #include <fbzmq/service/if/gen-cpp2/Monitor_types.h>
 #include <fbzmq/service/logging/LogSample.h>
 #include <fbzmq/zmq/Zmq.h>
 #include <folly/MapUtil.h>
+#include <folly/futures/Future.h>
 #include <thrift/lib/cpp/protocol/TProtocolTypes.h>
 #include <thrift/lib/cpp/transport/THeader.h>
 #include <thrift/lib/cpp2/async/HeaderClientChannel.h>
@@ -19,11 +26,208 @@
 #include <openr/common/Constants.h>
 #include <openr/common/NetworkUtil.h>
 #include <openr/common/Util.h>
+#include <openr/platform/NetlinkFibHandler.h>
+#include <openr/telemetry/Telemetry.h>
 
 namespace fb303 = facebook::fb303;
 
 namespace openr {
 
+namespace {
+
+// config-store key under which the warm-restart route snapshot lives
+const std::string kFibRouteDbKey{"fib-route-db"};
+
+// failed programming attempts a single route may accumulate before the
+// per-route retry path gives up and promotes to an enforced full fib sync
+constexpr uint32_t kMaxPerRouteRetries{3};
+
+// Bounded in-flight window shared by all route-programming phases of one
+// updateRoutes/sync pass. Unicast and mpls chunks enter the same window,
+// so both tables pipeline together on the agent channel and complete under
+// a single drain() join instead of one table waiting out the other.
+// Completions are awaited in issue order; the first failure stops further
+// issuance and is rethrown by drain() once everything in flight has
+// settled - chunks already programmed stay programmed and the caller's
+// recovery sync picks up from there
+struct ChunkWindow {
+  ChunkWindow(folly::EventBase& evb, size_t windowSize)
+      : evb(evb), windowSize(std::max<size_t>(1, windowSize)) {}
+
+  folly::EventBase& evb;
+  size_t const windowSize;
+  std::deque<
+      std::pair<folly::Future<folly::Unit>, std::chrono::steady_clock::time_point>>
+      inFlight;
+  folly::exception_wrapper failure;
+
+  void
+  awaitOldest() {
+    auto entry = std::move(inFlight.front());
+    inFlight.pop_front();
+    try {
+      // drives the client event base, dispatching any queued sends
+      std::move(entry.first).getVia(&evb);
+      fb303::fbData->addStatValue("fib.route_program_chunks", 1, fb303::COUNT);
+      TelemetrySampler::instance().record(
+          "fib.program_ack_latency_ms",
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              std::chrono::steady_clock::now() - entry.second)
+              .count());
+      VLOG(1) << "Programmed route chunk (" << inFlight.size()
+              << " still in flight)";
+    } catch (const std::exception&) {
+      if (not failure) {
+        failure = folly::exception_wrapper(std::current_exception());
+      }
+    }
+  }
+
+  void
+  drain() {
+    while (not inFlight.empty()) {
+      awaitOldest();
+    }
+    if (failure) {
+      failure.throw_exception();
+    }
+  }
+};
+
+// Hand the given routes to program() as a pipeline of bounded chunks
+// through the shared window. Chunking bounds the size of any single thrift
+// call so the agent never spends multiple seconds inside one RPC during
+// bulk programming and can service keep-alive checks between chunks.
+// program(chunk) must return the call's future. Does not drain the window
+// - the caller joins all phases with window.drain() at the end
+template <class RouteT, class ProgramFnT>
+void
+programInChunks(
+    ChunkWindow& window,
+    const std::vector<RouteT>& routes,
+    size_t chunkSize,
+    ProgramFnT program) {
+  chunkSize = std::max<size_t>(1, chunkSize);
+  for (size_t start = 0; start < routes.size() and not window.failure;
+       start += chunkSize) {
+    auto const end = std::min(routes.size(), start + chunkSize);
+    std::vector<RouteT> chunk(routes.begin() + start, routes.begin() + end);
+    // issue the call on the client event base - the channel is not safe to
+    // touch from other threads. The send goes out next time the evb is
+    // driven, which happens while awaiting the oldest in-flight chunk
+    // program is captured by value - the deferred call may run after this
+    // phase has returned, while a later phase drives the event base
+    window.inFlight.emplace_back(
+        folly::via(&window.evb)
+            .thenValue(
+                [program, chunk = std::move(chunk)](folly::Unit) mutable {
+                  return program(std::move(chunk));
+                }),
+        std::chrono::steady_clock::now());
+    if (window.inFlight.size() >= window.windowSize) {
+      window.awaitOldest();
+    }
+  }
+}
+
+} // namespace
+
+SeqlockRouteDb::~SeqlockRouteDb() {
+  if (auto* hdr = header_.load(std::memory_order_relaxed)) {
+    ::munmap(hdr, sizeof(Header) + capacity_);
+  }
+  for (auto const& mapping : retiredMappings_) {
+    ::munmap(mapping.first, mapping.second);
+  }
+}
+
+SeqlockRouteDb::Header*
+SeqlockRouteDb::grow(size_t length) {
+  // generous doubling keeps remapping - and the retired mappings each
+  // remap leaves behind for late readers - rare
+  size_t newCapacity = std::max<size_t>(2 * capacity_, 1 << 16);
+  while (newCapacity < length) {
+    newCapacity *= 2;
+  }
+
+  void* addr = ::mmap(
+      nullptr,
+      sizeof(Header) + newCapacity,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS,
+      -1,
+      0);
+  CHECK(addr != MAP_FAILED) << "Failed to mmap route-db snapshot buffer";
+
+  if (auto* oldHdr = header_.load(std::memory_order_relaxed)) {
+    retiredMappings_.emplace_back(oldHdr, sizeof(Header) + capacity_);
+  }
+  capacity_ = newCapacity;
+  auto* newHdr = new (addr) Header();
+  newHdr->capacity = newCapacity;
+  return newHdr;
+}
+
+void
+SeqlockRouteDb::write(const thrift::RouteDatabase& routeDb) {
+  apache::thrift::CompactSerializer serializer;
+  std::string payload;
+  serializer.serialize(routeDb, &payload);
+
+  auto* hdr = header_.load(std::memory_order_relaxed);
+  if (hdr == nullptr or payload.size() > capacity_) {
+    // fill the larger mapping completely before publishing it, so
+    // readers only ever observe fully written snapshots. A reader
+    // racing the swap still sees a consistent (one generation stale)
+    // snapshot in the retired mapping
+    auto* newHdr = grow(payload.size());
+    ::memcpy(newHdr + 1, payload.data(), payload.size());
+    newHdr->length = payload.size();
+    newHdr->seq.store(2, std::memory_order_release);
+    header_.store(newHdr, std::memory_order_release);
+    return;
+  }
+
+  // in-place seqlock write: bump the generation to odd, mutate the
+  // payload, bump back to even. Readers that overlapped retry
+  const auto seq = hdr->seq.load(std::memory_order_relaxed);
+  hdr->seq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  ::memcpy(hdr + 1, payload.data(), payload.size());
+  hdr->length = payload.size();
+  hdr->seq.store(seq + 2, std::memory_order_release);
+}
+
+bool
+SeqlockRouteDb::read(thrift::RouteDatabase& routeDb) const {
+  std::string payload;
+  while (true) {
+    auto* hdr = header_.load(std::memory_order_acquire);
+    if (hdr == nullptr) {
+      return false; // nothing published yet
+    }
+    const auto seqBefore = hdr->seq.load(std::memory_order_acquire);
+    if (seqBefore == 0 or seqBefore % 2 != 0) {
+      // write in flight; writes are short, so just yield and retry
+      std::this_thread::yield();
+      continue;
+    }
+    // a torn length read is caught by the generation recheck below; the
+    // clamp merely keeps the speculative copy inside the mapping
+    const auto length = std::min<uint64_t>(hdr->length, hdr->capacity);
+    payload.assign(reinterpret_cast<const char*>(hdr + 1), length);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (hdr->seq.load(std::memory_order_relaxed) == seqBefore) {
+      break;
+    }
+    std::this_thread::yield();
+  }
+
+  apache::thrift::CompactSerializer serializer;
+  serializer.deserialize(payload, routeDb);
+  return true;
+}
+
 Fib::Fib(
     std::shared_ptr<const Config> config,
     int32_t thriftPort,
@@ -32,12 +236,16 @@ Fib::Fib(
     messaging::RQueue<thrift::InterfaceDatabase> interfaceUpdatesQueue,
     const MonitorSubmitUrl& monitorSubmitUrl,
     KvStore* kvStore,
-    fbzmq::Context& zmqContext)
+    fbzmq::Context& zmqContext,
+    std::shared_ptr<NetlinkFibHandler> fibHandler,
+    PersistentStore* configStore)
     : myNodeName_(config->getConfig().node_name),
       thriftPort_(thriftPort),
+      fibHandler_(std::move(fibHandler)),
       expBackoff_(
           std::chrono::milliseconds(8), std::chrono::milliseconds(4096)),
-      kvStore_(kvStore) {
+      kvStore_(kvStore),
+      configStore_(configStore) {
   auto tConfig = config->getConfig();
 
   dryrun_ = config->getConfig().dryrun_ref().value_or(false);
@@ -45,12 +253,47 @@ Fib::Fib(
       config->getConfig().enable_segment_routing_ref().value_or(false);
   enableOrderedFib_ =
       config->getConfig().enable_ordered_fib_programming_ref().value_or(false);
+  enableFibSyncDiff_ =
+      config->getConfig().enable_fib_sync_diff_ref().value_or(false);
+  routeProgramChunkSize_ =
+      config->getConfig().fib_route_program_chunk_size_ref().value_or(
+          Constants::kFibRouteProgramChunkSize);
+  routeProgramWindowSize_ =
+      config->getConfig().fib_route_program_window_size_ref().value_or(1);
+
+  // allocate the perf ring up front so steady-state logging never grows it
+  perfDb_.reserve(Constants::kPerfBufferSize);
+
+  // warm restart: seed route state from the snapshot the previous
+  // incarnation persisted at shutdown. Nothing is programmed here - these
+  // routes are already in the dataplane; seeding makes the first Decision
+  // update and the agent sync reconcile by diff instead of withdrawing
+  // and reprogramming everything
+  if (configStore_) {
+    auto maybeRouteDb =
+        configStore_->loadThriftObj<thrift::RouteDatabase>(kFibRouteDbKey)
+            .get();
+    if (maybeRouteDb.hasValue()) {
+      for (auto& route : maybeRouteDb->unicastRoutes) {
+        routeState_.unicastRoutes.emplace(
+            route.dest, compactUnicastRoute(route));
+      }
+      for (auto& route : maybeRouteDb->mplsRoutes) {
+        routeState_.mplsRoutes.emplace(route.topLabel, std::move(route));
+      }
+      LOG(INFO) << "Warm restart: restored "
+                << routeState_.unicastRoutes.size() << " unicast and "
+                << routeState_.mplsRoutes.size()
+                << " mpls routes from config-store";
+    }
+  }
 
   syncRoutesTimer_ = folly::AsyncTimeout::make(*getEvb(), [this]() noexcept {
     if (routeState_.hasRoutesFromDecision) {
       if (syncRouteDb()) {
         hasSyncedFib_ = true;
         expBackoff_.reportSuccess();
+        signalOrderedFibProgrammed();
       } else {
         // Apply exponential backoff and schedule next run
         expBackoff_.reportError();
@@ -64,6 +307,14 @@ Fib::Fib(
   // On startup we do require routedb_sync so explicitly set the counter to 0
   fb303::fbData->setCounter("fib.synced", 0);
 
+  retryRoutesTimer_ = folly::AsyncTimeout::make(*getEvb(), [this]() noexcept {
+    retryFailedRoutes();
+  });
+
+  // publish the first route-db snapshot (warm-restart content or empty)
+  // before the event base - and hence any reader - starts
+  refreshRouteDbSnapshot();
+
   if (enableOrderedFib_) {
     // check non-empty module ptr
     CHECK(kvStore_);
@@ -91,8 +342,9 @@ Fib::Fib(
     keepAliveTimer_->scheduleTimeout(Constants::kKeepAliveCheckInterval);
   });
 
-  // Only schedule health checker in non dry run mode
-  if (not dryrun_) {
+  // Only schedule health checker in non dry run mode. In direct-netlink
+  // mode the "agent" is the in-process handler, there is nothing to ping
+  if (not dryrun_ and not fibHandler_) {
     keepAliveTimer_->scheduleTimeout(Constants::kKeepAliveCheckInterval);
   }
 
@@ -126,8 +378,8 @@ Fib::Fib(
     }
   });
 
-  zmqMonitorClient_ =
-      std::make_unique<fbzmq::ZmqMonitorClient>(zmqContext, monitorSubmitUrl);
+  eventLogger_ = std::make_unique<EventLogger>(
+      std::make_shared<fbzmq::ZmqMonitorClient>(zmqContext, monitorSubmitUrl));
 
   // Initialize stats keys
   fb303::fbData->addStatExportType("fib.convergence_time_ms", fb303::AVG);
@@ -144,6 +396,31 @@ Fib::Fib(
   fb303::fbData->addStatExportType("fib.thrift.failure.sync_fib", fb303::COUNT);
 }
 
+void
+Fib::stop() {
+  // warm restart: snapshot the programmed routes for the next incarnation.
+  // config-store is created before us and stopped after us in main(), so
+  // the write is safe this late in the shutdown sequence
+  if (configStore_) {
+    thrift::RouteDatabase routeDb;
+    getEvb()->runImmediatelyOrRunInEventBaseThreadAndWait([&]() {
+      routeDb.thisNodeName = myNodeName_;
+      for (const auto& route : routeState_.unicastRoutes) {
+        routeDb.unicastRoutes.emplace_back(
+            route.second.toThrift(route.first));
+      }
+      for (const auto& route : routeState_.mplsRoutes) {
+        routeDb.mplsRoutes.emplace_back(route.second);
+      }
+    });
+    configStore_->storeThriftObj(kFibRouteDbKey, routeDb).get();
+    LOG(INFO) << "Warm restart: persisted " << routeDb.unicastRoutes.size()
+              << " unicast and " << routeDb.mplsRoutes.size()
+              << " mpls routes to config-store";
+  }
+  OpenrEventBase::stop();
+}
+
 std::optional<thrift::IpPrefix>
 Fib::longestPrefixMatch(
     const folly::CIDRNetwork& inputPrefix,
@@ -168,20 +445,145 @@ Fib::longestPrefixMatch(
   return matchedPrefix;
 }
 
+std::unique_ptr<thrift::RouteDatabase>
+Fib::readRouteDbSnapshot() {
+  // served from the seqlocked snapshot on the caller's thread: dumps
+  // never hop onto - or stall - the Fib thread
+  auto routeDb = std::make_unique<thrift::RouteDatabase>();
+  if (not routeDbSnapshot_.read(*routeDb)) {
+    // defensive: the constructor publishes before any reader can exist
+    routeDb->thisNodeName = myNodeName_;
+  }
+  return routeDb;
+}
+
 folly::SemiFuture<std::unique_ptr<thrift::RouteDatabase>>
 Fib::getRouteDb() {
-  folly::Promise<std::unique_ptr<thrift::RouteDatabase>> p;
+  return folly::makeSemiFuture(readRouteDbSnapshot());
+}
+
+#if FOLLY_HAS_COROUTINES
+folly::coro::Task<std::unique_ptr<thrift::RouteDatabase>>
+Fib::getRouteDbCoro() {
+  co_return readRouteDbSnapshot();
+}
+#endif
+
+void
+Fib::refreshRouteDbSnapshot() {
+  thrift::RouteDatabase routeDb;
+  routeDb.thisNodeName = myNodeName_;
+  for (const auto& route : routeState_.unicastRoutes) {
+    routeDb.unicastRoutes.emplace_back(route.second.toThrift(route.first));
+  }
+  for (const auto& route : routeState_.mplsRoutes) {
+    routeDb.mplsRoutes.emplace_back(route.second);
+  }
+  routeDbSnapshot_.write(routeDb);
+}
+
+folly::SemiFuture<std::unique_ptr<thrift::RouteDatabasePage>>
+Fib::getRouteDbPaginated(std::string cursor, int32_t maxRoutes) {
+  // Decode the cursor up-front so a malformed one fails the call instead
+  // of poisoning the dump. Format: "prefix:<ip/len>" while paging through
+  // unicast routes, "label:<label>" once those are exhausted
+  bool unicastPhase{true};
+  std::optional<thrift::IpPrefix> lastPrefix;
+  std::optional<uint32_t> lastLabel;
+  try {
+    if (cursor.empty()) {
+      // start of a new dump
+    } else if (folly::StringPiece(cursor).startsWith("prefix:")) {
+      lastPrefix = toIpPrefix(cursor.substr(7));
+    } else if (folly::StringPiece(cursor).startsWith("label:")) {
+      unicastPhase = false;
+      if (cursor.size() > 6) {
+        lastLabel = folly::to<uint32_t>(cursor.substr(6));
+      }
+    } else {
+      throw std::invalid_argument("Unknown cursor phase");
+    }
+  } catch (std::exception const& e) {
+    return folly::makeSemiFuture<std::unique_ptr<thrift::RouteDatabasePage>>(
+        std::invalid_argument(
+            folly::sformat("Malformed route dump cursor: {}", cursor)));
+  }
+
+  folly::Promise<std::unique_ptr<thrift::RouteDatabasePage>> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([p = std::move(p), this]() mutable {
-    thrift::RouteDatabase routeDb;
-    routeDb.thisNodeName = myNodeName_;
-    for (const auto& route : routeState_.unicastRoutes) {
-      routeDb.unicastRoutes.emplace_back(route.second);
+  runInEventBaseThread([p = std::move(p),
+                        unicastPhase,
+                        lastPrefix = std::move(lastPrefix),
+                        lastLabel,
+                        maxRoutes,
+                        this]() mutable {
+    const size_t pageSize = maxRoutes > 0 ? static_cast<size_t>(maxRoutes)
+                                          : Constants::kRouteDumpPageSize;
+    thrift::RouteDatabasePage page;
+    page.thisNodeName = myNodeName_;
+
+    bool moreUnicast{false};
+    if (unicastPhase) {
+      // bounded selection of the pageSize smallest keys past the cursor:
+      // one pass over the table with an O(pageSize) working set, so page
+      // memory stays flat no matter how large the table is
+      std::set<thrift::IpPrefix> pageKeys;
+      for (const auto& route : routeState_.unicastRoutes) {
+        if (lastPrefix.has_value() and not(lastPrefix.value() < route.first)) {
+          continue;
+        }
+        if (pageKeys.size() < pageSize) {
+          pageKeys.insert(route.first);
+        } else if (route.first < *pageKeys.rbegin()) {
+          pageKeys.erase(std::prev(pageKeys.end()));
+          pageKeys.insert(route.first);
+          moreUnicast = true;
+        } else {
+          moreUnicast = true;
+        }
+      }
+      for (const auto& prefix : pageKeys) {
+        page.unicastRoutes.emplace_back(
+            routeState_.unicastRoutes.at(prefix).toThrift(prefix));
+      }
+      if (moreUnicast) {
+        page.nextCursor_ref() =
+            folly::sformat("prefix:{}", toString(*pageKeys.rbegin()));
+        p.setValue(std::make_unique<thrift::RouteDatabasePage>(
+            std::move(page)));
+        return;
+      }
     }
+
+    // unicast table exhausted - fill the rest of the page with mpls routes
+    bool moreMpls{false};
+    std::set<uint32_t> pageLabels;
+    const size_t mplsBudget = pageSize - page.unicastRoutes.size();
     for (const auto& route : routeState_.mplsRoutes) {
-      routeDb.mplsRoutes.emplace_back(route.second);
+      if (lastLabel.has_value() and route.first <= lastLabel.value()) {
+        continue;
+      }
+      if (pageLabels.size() < mplsBudget) {
+        pageLabels.insert(route.first);
+      } else if (not pageLabels.empty() and route.first < *pageLabels.rbegin()) {
+        pageLabels.erase(std::prev(pageLabels.end()));
+        pageLabels.insert(route.first);
+        moreMpls = true;
+      } else {
+        moreMpls = true;
+      }
+    }
+    for (const auto& label : pageLabels) {
+      page.mplsRoutes.emplace_back(routeState_.mplsRoutes.at(label));
     }
-    p.setValue(std::make_unique<thrift::RouteDatabase>(std::move(routeDb)));
+    if (moreMpls) {
+      // an empty payload resumes from the start of the mpls phase (the
+      // unicast routes may have consumed the entire page)
+      page.nextCursor_ref() = pageLabels.empty()
+          ? std::string("label:")
+          : folly::sformat("label:{}", *pageLabels.rbegin());
+    }
+    p.setValue(std::make_unique<thrift::RouteDatabasePage>(std::move(page)));
   });
   return sf;
 }
@@ -224,18 +626,19 @@ std::vector<thrift::UnicastRoute>
 Fib::getUnicastRoutesFiltered(std::vector<std::string> prefixes) {
   // return and send the vector<thrift::UnicastRoute>
   std::vector<thrift::UnicastRoute> retRouteVec;
-  // the matched prefix after longest prefix matching and avoid duplicates
-  std::set<thrift::IpPrefix> matchPrefixSet;
 
   // if the params is empty, return all routes
   if (prefixes.empty()) {
     for (const auto& routes : routeState_.unicastRoutes) {
-      retRouteVec.emplace_back(routes.second);
+      retRouteVec.emplace_back(routes.second.toThrift(routes.first));
     }
     return retRouteVec;
   }
 
-  // longest prefix matching for each input string
+  // batch-normalize the query strings into binary prefixes up front so
+  // matching can run as one sorted pass over the trie index
+  std::vector<thrift::IpPrefix> queryPrefixes;
+  queryPrefixes.reserve(prefixes.size());
   for (const auto& prefixStr : prefixes) {
     // try to convert the string prefix into CIDRNetwork
     const auto maybePrefix =
@@ -244,19 +647,15 @@ Fib::getUnicastRoutesFiltered(std::vector<std::string> prefixes) {
       LOG(ERROR) << "Invalid IP address as prefix: " << prefixStr;
       return retRouteVec;
     }
-    const auto inputPrefix = maybePrefix.value();
-
-    // do longest prefix match, add the matched prefix to the result set
-    const auto& matchedPrefix =
-        Fib::longestPrefixMatch(inputPrefix, routeState_.unicastRoutes);
-    if (matchedPrefix.has_value()) {
-      matchPrefixSet.insert(matchedPrefix.value());
-    }
+    queryPrefixes.emplace_back(toIpPrefix(maybePrefix.value()));
   }
 
-  // get the routes from the prefix set
-  for (const auto& prefix : matchPrefixSet) {
-    retRouteVec.emplace_back(routeState_.unicastRoutes.at(prefix));
+  // longest prefix match the whole batch against the trie index; matched
+  // prefixes come back deduplicated
+  for (const auto& prefix : routeState_.unicastRouteTrie.getLongestMatches(
+           std::move(queryPrefixes))) {
+    retRouteVec.emplace_back(
+        routeState_.unicastRoutes.at(prefix).toThrift(prefix));
   }
 
   return retRouteVec;
@@ -291,6 +690,48 @@ Fib::getMplsRoutesFiltered(std::vector<int32_t> labels) {
   return retRouteVec;
 }
 
+thrift::UnicastRoute
+Fib::CompactUnicastRoute::toThrift(const thrift::IpPrefix& dest) const {
+  thrift::UnicastRoute route;
+  route.dest = dest;
+  route.nextHops = *nextHops;
+  if (adminDistance.has_value()) {
+    route.adminDistance_ref() = adminDistance.value();
+  }
+  if (prefixType.has_value()) {
+    route.prefixType_ref() = prefixType.value();
+  }
+  if (data.has_value()) {
+    route.data_ref() = data.value();
+  }
+  if (bestNexthop.has_value()) {
+    route.bestNexthop_ref() = bestNexthop.value();
+  }
+  return route;
+}
+
+Fib::NextHopSetPtr
+Fib::internNextHops(NextHopSet nextHops) {
+  auto& cached = nextHopSetCache_[nextHops];
+  if (auto existing = cached.lock()) {
+    return existing;
+  }
+  auto interned = std::make_shared<const NextHopSet>(std::move(nextHops));
+  cached = interned;
+  return interned;
+}
+
+Fib::CompactUnicastRoute
+Fib::compactUnicastRoute(const thrift::UnicastRoute& route) {
+  CompactUnicastRoute compact;
+  compact.nextHops = internNextHops(route.nextHops);
+  compact.adminDistance = castToStd(route.adminDistance_ref());
+  compact.prefixType = castToStd(route.prefixType_ref());
+  compact.data = castToStd(route.data_ref());
+  compact.bestNexthop = castToStd(route.bestNexthop_ref());
+  return compact;
+}
+
 void
 Fib::processRouteUpdates(thrift::RouteDatabaseDelta&& routeDelta) {
   routeState_.hasRoutesFromDecision = true;
@@ -314,7 +755,8 @@ Fib::processRouteUpdates(thrift::RouteDatabaseDelta&& routeDelta) {
 
   // Add/Update unicast routes to update
   for (const auto& route : routeDelta.unicastRoutesToUpdate) {
-    routeState_.unicastRoutes[route.dest] = route;
+    routeState_.unicastRoutes[route.dest] = compactUnicastRoute(route);
+    routeState_.unicastRouteTrie.insert(route.dest);
     routeState_.dirtyPrefixes.erase(route.dest);
   }
 
@@ -327,6 +769,7 @@ Fib::processRouteUpdates(thrift::RouteDatabaseDelta&& routeDelta) {
   // Delete unicast routes
   for (const auto& dest : routeDelta.unicastRoutesToDelete) {
     routeState_.unicastRoutes.erase(dest);
+    routeState_.unicastRouteTrie.erase(dest);
     routeState_.dirtyPrefixes.erase(dest);
   }
 
@@ -336,8 +779,21 @@ Fib::processRouteUpdates(thrift::RouteDatabaseDelta&& routeDelta) {
     routeState_.dirtyLabels.erase(topLabel);
   }
 
+  // Sweep interned next-hop sets no longer referenced by any route. The
+  // cache is bounded by the number of distinct ECMP groups, so a full
+  // pass per route-db update is cheap
+  for (auto it = nextHopSetCache_.begin(); it != nextHopSetCache_.end();) {
+    it = it->second.expired() ? nextHopSetCache_.erase(it) : std::next(it);
+  }
+
   // Add some counters
   fb303::fbData->addStatValue("fib.process_route_db", 1, fb303::COUNT);
+
+  // republish the operational-dump snapshot with the table changes folded
+  // in. Deltas are already debounced by Decision, so one rebuild per
+  // processed delta is the steady-state cost of reader-free dumps
+  refreshRouteDbSnapshot();
+
   // Send request to agent
   updateRoutes(routeDelta);
 }
@@ -379,11 +835,12 @@ Fib::processInterfaceDb(thrift::InterfaceDatabase&& interfaceDb) {
   // Compute unicast route changes
   //
   for (auto const& kv : routeState_.unicastRoutes) {
+    auto const& dest = kv.first;
     auto const& route = kv.second;
 
     // Find valid nexthops for route
     std::vector<thrift::NextHopThrift> validNextHops;
-    for (auto const& nextHop : route.nextHops) {
+    for (auto const& nextHop : *route.nextHops) {
       const auto ifName = nextHop.address.ifName_ref();
       if (not ifName.has_value() ||
           (folly::get_default(interfaceStatusDb_, *ifName, false))) {
@@ -392,34 +849,34 @@ Fib::processInterfaceDb(thrift::InterfaceDatabase&& interfaceDb) {
     } // end for ... kv.second
 
     // Find previous best nexthops
-    auto prevBestNextHops = getBestNextHopsUnicast(route.nextHops);
+    auto prevBestNextHops = getBestNextHopsUnicast(*route.nextHops);
 
     // Find new valid best nexthops
     auto validBestNextHops = getBestNextHopsUnicast(validNextHops);
 
     // Remove route if no valid nexthops
     if (not validBestNextHops.size()) {
-      VLOG(1) << "Removing prefix " << toString(route.dest)
+      VLOG(1) << "Removing prefix " << toString(dest)
               << " because of no valid nextHops.";
-      routeDbDelta.unicastRoutesToDelete.emplace_back(route.dest);
-      routeState_.dirtyPrefixes.emplace(route.dest); // Mark prefix as dirty
+      routeDbDelta.unicastRoutesToDelete.emplace_back(dest);
+      routeState_.dirtyPrefixes.emplace(dest); // Mark prefix as dirty
       continue; // Skip rest
     }
 
     if (validBestNextHops != prevBestNextHops) {
       // Nexthop group shrink
-      VLOG(1) << "bestPaths group resize for prefix: " << toString(route.dest)
+      VLOG(1) << "bestPaths group resize for prefix: " << toString(dest)
               << ", old: " << prevBestNextHops.size()
               << ", new: " << validBestNextHops.size();
       thrift::UnicastRoute newRoute;
-      newRoute.dest = route.dest;
+      newRoute.dest = dest;
       newRoute.nextHops = std::move(validBestNextHops);
       routeDbDelta.unicastRoutesToUpdate.emplace_back(std::move(newRoute));
-      routeState_.dirtyPrefixes.emplace(route.dest); // Mark prefix as dirty
-    } else if (routeState_.dirtyPrefixes.count(route.dest)) {
+      routeState_.dirtyPrefixes.emplace(dest); // Mark prefix as dirty
+    } else if (routeState_.dirtyPrefixes.count(dest)) {
       // Nexthop group restore - previously best
-      routeDbDelta.unicastRoutesToUpdate.emplace_back(route);
-      routeState_.dirtyPrefixes.erase(route.dest); // Remove from dirty list
+      routeDbDelta.unicastRoutesToUpdate.emplace_back(route.toThrift(dest));
+      routeState_.dirtyPrefixes.erase(dest); // Remove from dirty list
     }
   } // end for ... routeDb_.unicastRoutes
 
@@ -479,12 +936,97 @@ thrift::PerfDatabase
 Fib::dumpPerfDb() const {
   thrift::PerfDatabase perfDb;
   perfDb.thisNodeName = myNodeName_;
-  for (auto const& perf : perfDb_) {
-    perfDb.eventInfo.emplace_back(perf);
+  // replay the ring from the oldest entry so events come out in insertion
+  // order regardless of how often the buffer has wrapped
+  auto const start =
+      perfDb_.size() < Constants::kPerfBufferSize ? 0 : perfDbNextIndex_;
+  for (size_t i = 0; i < perfDb_.size(); ++i) {
+    perfDb.eventInfo.emplace_back(perfDb_[(start + i) % perfDb_.size()]);
+  }
+  // append the process-wide binary trace as one more event chain; this
+  // is the only place its records get converted back to thrift
+  auto trace = perftrace::dumpPerfTrace();
+  if (not trace.events.empty()) {
+    perfDb.eventInfo.emplace_back(std::move(trace));
+  }
+  if (numConvergenceLatencySamples_ > 0) {
+    perfDb.convergenceLatencyP50Ms_ref() = estimateConvergencePercentile(50);
+    perfDb.convergenceLatencyP95Ms_ref() = estimateConvergencePercentile(95);
+    perfDb.convergenceLatencyP99Ms_ref() = estimateConvergencePercentile(99);
   }
   return perfDb;
 }
 
+int64_t
+Fib::estimateConvergencePercentile(uint32_t percentile) const {
+  CHECK_GT(numConvergenceLatencySamples_, 0);
+  // ceil of percentile% of the sample count, at least rank one
+  auto const rank = std::max<uint64_t>(
+      1, (percentile * numConvergenceLatencySamples_ + 99) / 100);
+  uint64_t seen{0};
+  for (size_t bucket = 0; bucket < convergenceLatencyBuckets_.size();
+       ++bucket) {
+    seen += convergenceLatencyBuckets_[bucket];
+    if (seen >= rank) {
+      return (bucket + 1) * Constants::kPerfHistogramBucketWidth.count();
+    }
+  }
+  // not reachable - bucket counts always sum up to the sample count
+  return convergenceLatencyBuckets_.size() *
+      Constants::kPerfHistogramBucketWidth.count();
+}
+
+folly::Future<folly::Unit>
+Fib::addUnicastRoutesToAgent(std::vector<thrift::UnicastRoute> routes) {
+  if (fibHandler_) {
+    return fibHandler_
+        ->semifuture_addUnicastRoutes(
+            kFibId_,
+            std::make_unique<std::vector<thrift::UnicastRoute>>(
+                std::move(routes)))
+        .via(&evb_);
+  }
+  return client_->future_addUnicastRoutes(kFibId_, routes);
+}
+
+folly::Future<folly::Unit>
+Fib::deleteUnicastRoutesFromAgent(std::vector<thrift::IpPrefix> prefixes) {
+  if (fibHandler_) {
+    return fibHandler_
+        ->semifuture_deleteUnicastRoutes(
+            kFibId_,
+            std::make_unique<std::vector<thrift::IpPrefix>>(
+                std::move(prefixes)))
+        .via(&evb_);
+  }
+  return client_->future_deleteUnicastRoutes(kFibId_, prefixes);
+}
+
+folly::Future<folly::Unit>
+Fib::addMplsRoutesToAgent(std::vector<thrift::MplsRoute> routes) {
+  if (fibHandler_) {
+    return fibHandler_
+        ->semifuture_addMplsRoutes(
+            kFibId_,
+            std::make_unique<std::vector<thrift::MplsRoute>>(
+                std::move(routes)))
+        .via(&evb_);
+  }
+  return client_->future_addMplsRoutes(kFibId_, routes);
+}
+
+folly::Future<folly::Unit>
+Fib::deleteMplsRoutesFromAgent(std::vector<int32_t> topLabels) {
+  if (fibHandler_) {
+    return fibHandler_
+        ->semifuture_deleteMplsRoutes(
+            kFibId_,
+            std::make_unique<std::vector<int32_t>>(std::move(topLabels)))
+        .via(&evb_);
+  }
+  return client_->future_deleteMplsRoutes(kFibId_, topLabels);
+}
+
 void
 Fib::updateRoutes(const thrift::RouteDatabaseDelta& routeDbDelta) {
   LOG(INFO) << "Processing route add/update for "
@@ -538,6 +1080,7 @@ Fib::updateRoutes(const thrift::RouteDatabaseDelta& routeDbDelta) {
     // Do not program routes in case of dryrun
     LOG(INFO) << "Skipping programing of routes in dryrun ... ";
     logPerfEvents(castToStd(routeDbDelta.perfEvents_ref()));
+    signalOrderedFibProgrammed();
     return;
   }
 
@@ -560,35 +1103,92 @@ Fib::updateRoutes(const thrift::RouteDatabaseDelta& routeDbDelta) {
   // Make thrift calls to do real programming
   try {
     uint32_t numOfRouteUpdates = 0;
-    createFibClient(evb_, socket_, client_, thriftPort_);
+    if (not fibHandler_) {
+      createFibClient(evb_, socket_, client_, thriftPort_);
+      setAgentCloseCallback();
+    }
+    ChunkWindow window(evb_, routeProgramWindowSize_);
     if (routeDbDelta.unicastRoutesToDelete.size()) {
       numOfRouteUpdates += routeDbDelta.unicastRoutesToDelete.size();
-      client_->sync_deleteUnicastRoutes(
-          kFibId_, routeDbDelta.unicastRoutesToDelete);
+      programInChunks(
+          window,
+          routeDbDelta.unicastRoutesToDelete,
+          routeProgramChunkSize_,
+          [this](std::vector<thrift::IpPrefix> chunk) {
+            return deleteUnicastRoutesFromAgent(std::move(chunk));
+          });
     }
     if (patchedUnicastRoutesToUpdate.size()) {
       numOfRouteUpdates += patchedUnicastRoutesToUpdate.size();
-      client_->sync_addUnicastRoutes(kFibId_, patchedUnicastRoutesToUpdate);
+      programInChunks(
+          window,
+          patchedUnicastRoutesToUpdate,
+          routeProgramChunkSize_,
+          [this](std::vector<thrift::UnicastRoute> chunk) {
+            return addUnicastRoutesToAgent(std::move(chunk));
+          });
     }
     if (enableSegmentRouting_ && routeDbDelta.mplsRoutesToDelete.size()) {
       numOfRouteUpdates += routeDbDelta.mplsRoutesToDelete.size();
-      client_->sync_deleteMplsRoutes(kFibId_, routeDbDelta.mplsRoutesToDelete);
+      programInChunks(
+          window,
+          routeDbDelta.mplsRoutesToDelete,
+          routeProgramChunkSize_,
+          [this](std::vector<int32_t> chunk) {
+            return deleteMplsRoutesFromAgent(std::move(chunk));
+          });
     }
     if (enableSegmentRouting_ && mplsRoutesToUpdate.size()) {
       numOfRouteUpdates += mplsRoutesToUpdate.size();
-      client_->sync_addMplsRoutes(kFibId_, mplsRoutesToUpdate);
+      programInChunks(
+          window,
+          mplsRoutesToUpdate,
+          routeProgramChunkSize_,
+          [this](std::vector<thrift::MplsRoute> chunk) {
+            return addMplsRoutesToAgent(std::move(chunk));
+          });
     }
+    window.drain();
     fb303::fbData->addStatValue(
         "fib.num_of_route_updates", numOfRouteUpdates, fb303::SUM);
     routeState_.dirtyRouteDb = false;
+    // routes in this delta are now programmed; drop any pending retry
+    if (not retryPrefixes_.empty() or not retryLabels_.empty()) {
+      for (auto const& prefix : routeDbDelta.unicastRoutesToDelete) {
+        retryPrefixes_.erase(prefix);
+      }
+      for (auto const& route : patchedUnicastRoutesToUpdate) {
+        retryPrefixes_.erase(route.dest);
+      }
+      for (auto const& topLabel : routeDbDelta.mplsRoutesToDelete) {
+        retryLabels_.erase(topLabel);
+      }
+      for (auto const& route : mplsRoutesToUpdate) {
+        retryLabels_.erase(route.topLabel);
+      }
+    }
     logPerfEvents(castToStd(routeDbDelta.perfEvents_ref()));
+    signalOrderedFibProgrammed();
     LOG(INFO) << "Done processing route add/update";
   } catch (const std::exception& e) {
     fb303::fbData->addStatValue(
         "fib.thrift.failure.add_del_route", 1, fb303::COUNT);
     client_.reset();
-    routeState_.dirtyRouteDb = true;
-    syncRouteDbDebounced(); // Schedule future full sync of route DB
+    // Track the attempted routes for individual retry instead of
+    // re-programming the whole table on the global backoff
+    std::vector<thrift::IpPrefix> failedPrefixes =
+        routeDbDelta.unicastRoutesToDelete;
+    for (auto const& route : patchedUnicastRoutesToUpdate) {
+      failedPrefixes.emplace_back(route.dest);
+    }
+    std::vector<int32_t> failedLabels;
+    if (enableSegmentRouting_) {
+      failedLabels = routeDbDelta.mplsRoutesToDelete;
+      for (auto const& route : mplsRoutesToUpdate) {
+        failedLabels.emplace_back(route.topLabel);
+      }
+    }
+    markRoutesForRetry(failedPrefixes, failedLabels);
     LOG(ERROR) << "Failed to make thrift call to FibAgent. Error: "
                << folly::exceptionStr(e);
   }
@@ -599,8 +1199,13 @@ Fib::syncRouteDb() {
   LOG(INFO) << "Syncing latest routeDb with fib-agent with "
             << routeState_.unicastRoutes.size() << " routes";
 
-  const auto& unicastRoutes =
-      createUnicastRoutesWithBestNextHopsMap(routeState_.unicastRoutes);
+  // Expand the compact internal routes into thrift routes to be programmed
+  std::vector<thrift::UnicastRoute> unicastRoutes;
+  unicastRoutes.reserve(routeState_.unicastRoutes.size());
+  for (auto const& kv : routeState_.unicastRoutes) {
+    unicastRoutes.emplace_back(createUnicastRoute(
+        kv.first, getBestNextHopsUnicast(*kv.second.nextHops)));
+  }
   const auto& mplsRoutes =
       createMplsRoutesWithBestNextHopsMap(routeState_.mplsRoutes);
 
@@ -629,20 +1234,52 @@ Fib::syncRouteDb() {
   }
 
   try {
-    createFibClient(evb_, socket_, client_, thriftPort_);
+    if (not fibHandler_) {
+      createFibClient(evb_, socket_, client_, thriftPort_);
+      setAgentCloseCallback();
+    }
     fb303::fbData->addStatValue("fib.sync_fib_calls", 1, fb303::COUNT);
 
-    // Sync unicast routes
-    client_->sync_syncFib(kFibId_, unicastRoutes);
-    routeState_.dirtyPrefixes.clear();
-
-    // Sync mpls routes
-    if (enableSegmentRouting_) {
-      client_->sync_syncMplsFib(kFibId_, mplsRoutes);
+    if (enableFibSyncDiff_ and syncRouteDbByDiff(unicastRoutes, mplsRoutes)) {
+      // programmed only the delta against the agent's read-back table
+      routeState_.dirtyPrefixes.clear();
+      routeState_.dirtyLabels.clear();
+    } else {
+      // Sync unicast routes
+      if (fibHandler_) {
+        fibHandler_
+            ->semifuture_syncFib(
+                kFibId_,
+                std::make_unique<std::vector<thrift::UnicastRoute>>(
+                    unicastRoutes))
+            .get();
+      } else {
+        client_->sync_syncFib(kFibId_, unicastRoutes);
+      }
+      routeState_.dirtyPrefixes.clear();
+
+      // Sync mpls routes
+      if (enableSegmentRouting_) {
+        if (fibHandler_) {
+          fibHandler_
+              ->semifuture_syncMplsFib(
+                  kFibId_,
+                  std::make_unique<std::vector<thrift::MplsRoute>>(mplsRoutes))
+              .get();
+        } else {
+          client_->sync_syncMplsFib(kFibId_, mplsRoutes);
+        }
+      }
+      routeState_.dirtyLabels.clear();
     }
-    routeState_.dirtyLabels.clear();
 
     routeState_.dirtyRouteDb = false;
+    // a full sync reconciles every tracked divergence
+    retryPrefixes_.clear();
+    retryLabels_.clear();
+    if (retryRoutesTimer_->isScheduled()) {
+      retryRoutesTimer_->cancelTimeout();
+    }
     LOG(INFO) << "Done syncing latest routeDb with fib-agent";
     return true;
   } catch (std::exception const& e) {
@@ -655,6 +1292,113 @@ Fib::syncRouteDb() {
   }
 }
 
+bool
+Fib::syncRouteDbByDiff(
+    const std::vector<thrift::UnicastRoute>& unicastRoutes,
+    const std::vector<thrift::MplsRoute>& mplsRoutes) {
+  // Read back what the agent currently has programmed for us
+  thrift::RouteDatabase agentRouteDb;
+  agentRouteDb.thisNodeName = myNodeName_;
+  try {
+    if (fibHandler_) {
+      agentRouteDb.unicastRoutes =
+          std::move(*fibHandler_->semifuture_getRouteTableByClient(kFibId_)
+                         .get());
+      if (enableSegmentRouting_) {
+        agentRouteDb.mplsRoutes = std::move(
+            *fibHandler_->semifuture_getMplsRouteTableByClient(kFibId_).get());
+      }
+    } else {
+      client_->sync_getRouteTableByClient(agentRouteDb.unicastRoutes, kFibId_);
+      if (enableSegmentRouting_) {
+        client_->sync_getMplsRouteTableByClient(
+            agentRouteDb.mplsRoutes, kFibId_);
+      }
+    }
+  } catch (std::exception const& e) {
+    LOG(WARNING) << "Failed to read back routes from FibAgent, falling back "
+                 << "to full fib sync. Error: " << folly::exceptionStr(e);
+    return false;
+  }
+
+  thrift::RouteDatabase desiredRouteDb;
+  desiredRouteDb.thisNodeName = myNodeName_;
+  desiredRouteDb.unicastRoutes = unicastRoutes;
+  desiredRouteDb.mplsRoutes = mplsRoutes;
+
+  // normalize nexthop ordering so identical routes compare equal, then sort
+  // the tables as findDeltaRoutes() expects
+  for (auto* routeDb : {&agentRouteDb, &desiredRouteDb}) {
+    for (auto& route : routeDb->unicastRoutes) {
+      std::sort(route.nextHops.begin(), route.nextHops.end());
+    }
+    for (auto& route : routeDb->mplsRoutes) {
+      std::sort(route.nextHops.begin(), route.nextHops.end());
+    }
+    std::sort(routeDb->unicastRoutes.begin(), routeDb->unicastRoutes.end());
+    std::sort(routeDb->mplsRoutes.begin(), routeDb->mplsRoutes.end());
+  }
+
+  auto const routeDbDelta = findDeltaRoutes(desiredRouteDb, agentRouteDb);
+  LOG(INFO) << "Diff sync with fib-agent: "
+            << routeDbDelta.unicastRoutesToUpdate.size() << " unicast and "
+            << routeDbDelta.mplsRoutesToUpdate.size()
+            << " mpls routes to add/update, "
+            << routeDbDelta.unicastRoutesToDelete.size() << " unicast and "
+            << routeDbDelta.mplsRoutesToDelete.size()
+            << " mpls routes to delete; "
+            << agentRouteDb.unicastRoutes.size() +
+            agentRouteDb.mplsRoutes.size()
+            << " agent routes read back";
+
+  uint32_t numOfRouteUpdates = 0;
+  ChunkWindow window(evb_, routeProgramWindowSize_);
+  if (routeDbDelta.unicastRoutesToDelete.size()) {
+    numOfRouteUpdates += routeDbDelta.unicastRoutesToDelete.size();
+    programInChunks(
+        window,
+        routeDbDelta.unicastRoutesToDelete,
+        routeProgramChunkSize_,
+        [this](std::vector<thrift::IpPrefix> chunk) {
+          return deleteUnicastRoutesFromAgent(std::move(chunk));
+        });
+  }
+  if (routeDbDelta.unicastRoutesToUpdate.size()) {
+    numOfRouteUpdates += routeDbDelta.unicastRoutesToUpdate.size();
+    programInChunks(
+        window,
+        routeDbDelta.unicastRoutesToUpdate,
+        routeProgramChunkSize_,
+        [this](std::vector<thrift::UnicastRoute> chunk) {
+          return addUnicastRoutesToAgent(std::move(chunk));
+        });
+  }
+  if (enableSegmentRouting_ && routeDbDelta.mplsRoutesToDelete.size()) {
+    numOfRouteUpdates += routeDbDelta.mplsRoutesToDelete.size();
+    programInChunks(
+        window,
+        routeDbDelta.mplsRoutesToDelete,
+        routeProgramChunkSize_,
+        [this](std::vector<int32_t> chunk) {
+          return deleteMplsRoutesFromAgent(std::move(chunk));
+        });
+  }
+  if (enableSegmentRouting_ && routeDbDelta.mplsRoutesToUpdate.size()) {
+    numOfRouteUpdates += routeDbDelta.mplsRoutesToUpdate.size();
+    programInChunks(
+        window,
+        routeDbDelta.mplsRoutesToUpdate,
+        routeProgramChunkSize_,
+        [this](std::vector<thrift::MplsRoute> chunk) {
+          return addMplsRoutesToAgent(std::move(chunk));
+        });
+  }
+  window.drain();
+  fb303::fbData->addStatValue(
+      "fib.num_of_route_updates", numOfRouteUpdates, fb303::SUM);
+  return true;
+}
+
 void
 Fib::syncRouteDbDebounced() {
   if (!syncRoutesTimer_->isScheduled()) {
@@ -663,9 +1407,202 @@ Fib::syncRouteDbDebounced() {
   }
 }
 
+void
+Fib::markRoutesForRetry(
+    const std::vector<thrift::IpPrefix>& prefixes,
+    const std::vector<int32_t>& labels) {
+  bool promoteToFullSync{false};
+  for (auto const& prefix : prefixes) {
+    auto& retryState = retryPrefixes_[prefix];
+    retryState.backoff.reportError();
+    promoteToFullSync |= ++retryState.numFailures > kMaxPerRouteRetries;
+  }
+  for (auto const& topLabel : labels) {
+    auto& retryState = retryLabels_[topLabel];
+    retryState.backoff.reportError();
+    promoteToFullSync |= ++retryState.numFailures > kMaxPerRouteRetries;
+  }
+
+  if (promoteToFullSync) {
+    // Some route keeps failing in isolation - the divergence is beyond
+    // what a targeted retry can explain, reconcile the whole table
+    LOG(WARNING) << "Route(s) exceeded per-route retry budget of "
+                 << kMaxPerRouteRetries
+                 << " attempts. Promoting to full fib sync ...";
+    fb303::fbData->addStatValue(
+        "fib.route_retry_promotions", 1, fb303::COUNT);
+    retryPrefixes_.clear();
+    retryLabels_.clear();
+    routeState_.dirtyRouteDb = true;
+    syncRouteDbDebounced();
+    return;
+  }
+  scheduleRetryRoutesTimer();
+}
+
+void
+Fib::retryFailedRoutes() {
+  if (syncRoutesTimer_->isScheduled() or routeState_.dirtyRouteDb) {
+    // a full sync is pending and covers every tracked route
+    return;
+  }
+
+  // Re-program the due routes from current routeState_ - a route updated
+  // since the failure is retried with its latest nexthops, a route since
+  // deleted is retried as a delete
+  std::vector<thrift::IpPrefix> attemptedPrefixes;
+  std::vector<int32_t> attemptedLabels;
+  std::vector<thrift::UnicastRoute> unicastRoutesToUpdate;
+  std::vector<thrift::IpPrefix> unicastRoutesToDelete;
+  std::vector<thrift::MplsRoute> mplsRoutesToUpdate;
+  std::vector<int32_t> mplsRoutesToDelete;
+  for (auto const& kv : retryPrefixes_) {
+    if (not kv.second.backoff.canTryNow()) {
+      continue;
+    }
+    attemptedPrefixes.emplace_back(kv.first);
+    auto it = routeState_.unicastRoutes.find(kv.first);
+    if (it == routeState_.unicastRoutes.end()) {
+      unicastRoutesToDelete.emplace_back(kv.first);
+    } else {
+      unicastRoutesToUpdate.emplace_back(createUnicastRoute(
+          kv.first, getBestNextHopsUnicast(*it->second.nextHops)));
+    }
+  }
+  for (auto const& kv : retryLabels_) {
+    if (not kv.second.backoff.canTryNow()) {
+      continue;
+    }
+    attemptedLabels.emplace_back(kv.first);
+    auto it = routeState_.mplsRoutes.find(kv.first);
+    if (it == routeState_.mplsRoutes.end()) {
+      mplsRoutesToDelete.emplace_back(kv.first);
+    } else {
+      mplsRoutesToUpdate.emplace_back(it->second);
+    }
+  }
+  mplsRoutesToUpdate = createMplsRoutesWithBestNextHops(mplsRoutesToUpdate);
+
+  if (attemptedPrefixes.empty() and attemptedLabels.empty()) {
+    // woke up before any backoff elapsed; re-arm for the earliest one
+    scheduleRetryRoutesTimer();
+    return;
+  }
+
+  LOG(INFO) << "Retrying " << attemptedPrefixes.size() << " unicast and "
+            << attemptedLabels.size() << " mpls routes that failed to program";
+  try {
+    if (not fibHandler_) {
+      createFibClient(evb_, socket_, client_, thriftPort_);
+      setAgentCloseCallback();
+    }
+    ChunkWindow window(evb_, routeProgramWindowSize_);
+    if (unicastRoutesToDelete.size()) {
+      programInChunks(
+          window,
+          unicastRoutesToDelete,
+          routeProgramChunkSize_,
+          [this](std::vector<thrift::IpPrefix> chunk) {
+            return deleteUnicastRoutesFromAgent(std::move(chunk));
+          });
+    }
+    if (unicastRoutesToUpdate.size()) {
+      programInChunks(
+          window,
+          unicastRoutesToUpdate,
+          routeProgramChunkSize_,
+          [this](std::vector<thrift::UnicastRoute> chunk) {
+            return addUnicastRoutesToAgent(std::move(chunk));
+          });
+    }
+    if (enableSegmentRouting_ && mplsRoutesToDelete.size()) {
+      programInChunks(
+          window,
+          mplsRoutesToDelete,
+          routeProgramChunkSize_,
+          [this](std::vector<int32_t> chunk) {
+            return deleteMplsRoutesFromAgent(std::move(chunk));
+          });
+    }
+    if (enableSegmentRouting_ && mplsRoutesToUpdate.size()) {
+      programInChunks(
+          window,
+          mplsRoutesToUpdate,
+          routeProgramChunkSize_,
+          [this](std::vector<thrift::MplsRoute> chunk) {
+            return addMplsRoutesToAgent(std::move(chunk));
+          });
+    }
+    window.drain();
+    fb303::fbData->addStatValue(
+        "fib.num_of_route_retries",
+        attemptedPrefixes.size() + attemptedLabels.size(),
+        fb303::SUM);
+    for (auto const& prefix : attemptedPrefixes) {
+      retryPrefixes_.erase(prefix);
+    }
+    for (auto const& topLabel : attemptedLabels) {
+      retryLabels_.erase(topLabel);
+    }
+    LOG(INFO) << "Done retrying failed routes";
+    // re-arm for routes whose backoff had not elapsed yet
+    scheduleRetryRoutesTimer();
+  } catch (const std::exception& e) {
+    fb303::fbData->addStatValue(
+        "fib.thrift.failure.add_del_route", 1, fb303::COUNT);
+    client_.reset();
+    markRoutesForRetry(attemptedPrefixes, attemptedLabels);
+    LOG(ERROR) << "Failed to make thrift call to FibAgent. Error: "
+               << folly::exceptionStr(e);
+  }
+}
+
+void
+Fib::scheduleRetryRoutesTimer() {
+  if (retryPrefixes_.empty() and retryLabels_.empty()) {
+    return;
+  }
+  auto timeout = std::chrono::milliseconds::max();
+  for (auto const& kv : retryPrefixes_) {
+    timeout = std::min(timeout, kv.second.backoff.getTimeRemainingUntilRetry());
+  }
+  for (auto const& kv : retryLabels_) {
+    timeout = std::min(timeout, kv.second.backoff.getTimeRemainingUntilRetry());
+  }
+  // scheduleTimeout replaces any armed timeout, so the timer always
+  // tracks the earliest due retry
+  retryRoutesTimer_->scheduleTimeout(timeout);
+}
+
+void
+Fib::AgentCloseCallback::channelClosed() {
+  // Runs on the client event base, which is only ever driven on the Fib
+  // thread, so touching Fib state here is safe. Leave the dead client in
+  // place - createFibClient() tears it down on next use
+  LOG(WARNING) << "Connection to FibAgent closed. "
+               << "Performing full route DB sync ...";
+  fb303::fbData->addStatValue(
+      "fib.thrift.failure.connection_closed", 1, fb303::COUNT);
+  fib_.routeState_.dirtyRouteDb = true;
+  fib_.syncRouteDbDebounced();
+}
+
+void
+Fib::setAgentCloseCallback() {
+  auto* channel =
+      dynamic_cast<apache::thrift::ClientChannel*>(client_->getChannel());
+  CHECK(channel);
+  channel->setCloseCallback(&agentCloseCallback_);
+}
+
 void
 Fib::keepAliveCheck() {
+  // Drive the client event base without blocking so a pending socket-close
+  // event fires agentCloseCallback_ right away - the RPC below is then a
+  // pure liveness heartbeat for connections that look healthy
+  evb_.loopOnce(EVLOOP_NONBLOCK);
   createFibClient(evb_, socket_, client_, thriftPort_);
+  setAgentCloseCallback();
   int64_t aliveSince = client_->sync_aliveSince();
   // Check if FIB has restarted or not
   if (aliveSince != latestAliveSince_) {
@@ -729,15 +1666,50 @@ Fib::updateGlobalCounters() {
       "fib.num_dirty_prefixes", routeState_.dirtyPrefixes.size());
   fb303::fbData->setCounter(
       "fib.num_dirty_labels", routeState_.dirtyLabels.size());
+  fb303::fbData->setCounter(
+      "fib.num_routes_pending_retry",
+      retryPrefixes_.size() + retryLabels_.size());
 
   // Count the number of bgp routes
   int64_t bgpCounter = 0;
   for (const auto& route : routeState_.unicastRoutes) {
-    if (route.second.bestNexthop_ref().has_value()) {
+    if (route.second.bestNexthop.has_value()) {
       bgpCounter++;
     }
   }
   fb303::fbData->setCounter("fib.num_routes.BGP", bgpCounter);
+  fb303::fbData->setCounter(
+      "fib.num_nexthop_groups", nextHopSetCache_.size());
+
+  // approximate heap bytes held by the route database, so OOMs can be
+  // attributed per module without heap dumps. Interned next-hop sets are
+  // counted once each, not per referencing route
+  int64_t routeDbBytes = routeState_.unicastRoutes.size() *
+      (sizeof(thrift::IpPrefix) + sizeof(CompactUnicastRoute));
+  for (const auto& kv : routeState_.mplsRoutes) {
+    routeDbBytes += sizeof(kv.second) +
+        kv.second.nextHops.size() * sizeof(thrift::NextHopThrift);
+  }
+  for (const auto& kv : nextHopSetCache_) {
+    // cache key plus the shared interned copy
+    routeDbBytes +=
+        2 * kv.first.size() * sizeof(thrift::NextHopThrift) + sizeof(kv);
+  }
+  fb303::fbData->setCounter("fib.route_db.approx_bytes", routeDbBytes);
+}
+
+void
+Fib::signalOrderedFibProgrammed() {
+  if (not enableOrderedFib_) {
+    return;
+  }
+  std::string ackKey;
+  composeNodeKey(ackKey, Constants::kFibAckMarker, myNodeName_);
+  kvStoreClient_->persistKey(
+      ackKey,
+      std::to_string(++orderedFibAckSeq_),
+      Constants::kTtlInfInterval,
+      openr::thrift::KvStore_constants::kDefaultArea());
 }
 
 void
@@ -775,8 +1747,10 @@ Fib::logPerfEvents(std::optional<thrift::PerfEvents> perfEvents) {
           "fib.local_route_program_time_ms",
           localDuration->count(),
           fb303::AVG);
+      std::string fibTimeKey;
+      composeNodeKey(fibTimeKey, Constants::kFibTimeMarker, myNodeName_);
       kvStoreClient_->persistKey(
-          Constants::kFibTimeMarker.toString() + myNodeName_,
+          fibTimeKey,
           std::to_string(fb303::fbData->getCounters().at(
               "fib.local_route_program_time_ms.avg.60")),
           Constants::kTtlInfInterval,
@@ -801,11 +1775,20 @@ Fib::logPerfEvents(std::optional<thrift::PerfEvents> perfEvents) {
     VLOG(2) << "  " << str;
   }
 
-  // Add new entry to perf DB and purge extra entries
-  perfDb_.push_back(std::move(perfEvents).value());
-  while (perfDb_.size() >= Constants::kPerfBufferSize) {
-    perfDb_.pop_front();
+  // Add new entry to perf DB, overwriting the oldest once the ring is full
+  if (perfDb_.size() < Constants::kPerfBufferSize) {
+    perfDb_.emplace_back(std::move(perfEvents).value());
+  } else {
+    perfDb_[perfDbNextIndex_] = std::move(perfEvents).value();
   }
+  perfDbNextIndex_ = (perfDbNextIndex_ + 1) % Constants::kPerfBufferSize;
+
+  // Fold the publication -> programmed latency into the streaming histogram
+  auto const bucket = std::min<size_t>(
+      convergenceLatencyBuckets_.size() - 1,
+      totalDuration / Constants::kPerfHistogramBucketWidth);
+  ++convergenceLatencyBuckets_[bucket];
+  ++numConvergenceLatencySamples_;
 
   // Export convergence duration counter
   fb303::fbData->addStatValue(
@@ -817,7 +1800,7 @@ Fib::logPerfEvents(std::optional<thrift::PerfEvents> perfEvents) {
   sample.addString("node_name", myNodeName_);
   sample.addStringVector("perf_events", eventStrs);
   sample.addInt("duration_ms", totalDuration.count());
-  zmqMonitorClient_->addEventLog(fbzmq::thrift::EventLog(
+  eventLogger_->log(fbzmq::thrift::EventLog(
       apache::thrift::FRAGILE,
       Constants::kEventLogCategory.toString(),
       {sample.toJson()}));
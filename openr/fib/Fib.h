@@ -7,17 +7,28 @@
 
 #pragma once
 
+#include <atomic>
+#include <vector>
+
 #include <boost/serialization/strong_typedef.hpp>
 #include <fbzmq/service/monitor/ZmqMonitorClient.h>
 #include <fbzmq/zmq/Zmq.h>
 #include <folly/io/async/AsyncSocket.h>
 #include <folly/io/async/AsyncTimeout.h>
 #include <folly/io/async/EventBase.h>
+#if FOLLY_HAS_COROUTINES
+#include <folly/experimental/coro/Task.h>
+#endif
+#include <thrift/lib/cpp2/async/ClientChannel.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 
+#include <openr/common/Constants.h>
+#include <openr/common/EventLogger.h>
 #include <openr/common/ExponentialBackoff.h>
 #include <openr/common/OpenrEventBase.h>
+#include <openr/common/PrefixTrie.h>
 #include <openr/common/Util.h>
+#include <openr/config-store/PersistentStore.h>
 #include <openr/config/Config.h>
 #include <openr/if/gen-cpp2/FibService.h>
 #include <openr/if/gen-cpp2/Fib_types.h>
@@ -28,6 +39,56 @@
 
 namespace openr {
 
+class NetlinkFibHandler;
+
+/**
+ * Seqlock-protected buffer holding the serialized route database.
+ *
+ * The Fib thread is the only writer; any thread may copy out a consistent
+ * snapshot without a hop onto the Fib thread and without ever blocking
+ * it - a reader simply retries the (rare) copy that overlapped a write.
+ * The mapping holds a flat header + payload layout with no pointers, so
+ * the same region could back a file mapping shared with external tools.
+ */
+class SeqlockRouteDb {
+ public:
+  SeqlockRouteDb() = default;
+  ~SeqlockRouteDb();
+
+  // disable copying
+  SeqlockRouteDb(SeqlockRouteDb const&) = delete;
+  SeqlockRouteDb& operator=(SeqlockRouteDb const&) = delete;
+
+  // serialize and publish a new route database. Writer (Fib) thread only
+  void write(const thrift::RouteDatabase& routeDb);
+
+  // copy out and deserialize the latest published route database.
+  // Returns false when nothing has been published yet
+  bool read(thrift::RouteDatabase& routeDb) const;
+
+ private:
+  // mapping layout: this header followed by the serialized payload
+  struct Header {
+    // seqlock generation: odd while a write is in flight, 0 before the
+    // first publication
+    std::atomic<uint64_t> seq{0};
+    // payload capacity of this mapping; immutable once published and
+    // used by readers to bound a (retried anyway) torn length read
+    uint64_t capacity{0};
+    // payload bytes valid past the header
+    uint64_t length{0};
+  };
+
+  // allocate a mapping large enough for `length` payload bytes and
+  // retire the current one. The retired mapping stays mapped until
+  // destruction since a late reader may still be copying from it
+  Header* grow(size_t length);
+
+  std::atomic<Header*> header_{nullptr};
+  size_t capacity_{0}; // payload capacity of the current mapping
+  std::vector<std::pair<void*, size_t>> retiredMappings_;
+};
+
 /**
  * Proxy agent to program computed routes using platform dependent agent (e.g.
  * FBOSS in case of Wedge Platform).
@@ -57,7 +118,15 @@ class Fib final : public OpenrEventBase {
       messaging::RQueue<thrift::InterfaceDatabase> interfaceUpdatesQueue,
       const MonitorSubmitUrl& monitorSubmitUrl,
       KvStore* kvStore,
-      fbzmq::Context& zmqContext);
+      fbzmq::Context& zmqContext,
+      std::shared_ptr<NetlinkFibHandler> fibHandler = nullptr,
+      PersistentStore* configStore = nullptr);
+
+  /**
+   * Warm restart: persist the programmed route snapshot for the next
+   * incarnation before going down. Overridden from OpenrEventBase
+   */
+  void stop() override;
 
   /**
    * Utility function to create thrift client connection to SwitchAgent. Can
@@ -87,6 +156,26 @@ class Fib final : public OpenrEventBase {
    */
   folly::SemiFuture<std::unique_ptr<thrift::RouteDatabase>> getRouteDb();
 
+#if FOLLY_HAS_COROUTINES
+  /**
+   * Coroutine-native variant of getRouteDb(). The seqlocked snapshot is
+   * readable from any thread, so the whole call is one coroutine frame -
+   * no promise/future pair is allocated.
+   */
+  folly::coro::Task<std::unique_ptr<thrift::RouteDatabase>> getRouteDbCoro();
+#endif
+
+  /**
+   * Retrieve one bounded page of the route database, starting after the
+   * given cursor (empty cursor starts a new dump). At most maxRoutes
+   * routes are expanded from the compact internal representation per
+   * call, so dump memory stays flat regardless of table size. The page
+   * carries the cursor for the next call; it is unset once the dump is
+   * complete. Throws std::invalid_argument on a malformed cursor.
+   */
+  folly::SemiFuture<std::unique_ptr<thrift::RouteDatabasePage>>
+  getRouteDbPaginated(std::string cursor, int32_t maxRoutes);
+
   /**
    * Retrieve unicast routes for specified prefixes or IP. Returns all if
    * no prefix is specified in filter list.
@@ -111,6 +200,41 @@ class Fib final : public OpenrEventBase {
   Fib(const Fib&) = delete;
   Fib& operator=(const Fib&) = delete;
 
+  // Shared immutable next-hop set. ECMP gives many routes an identical
+  // next-hop vector, so equal sets are interned and shared across all
+  // routes using them instead of every route holding its own copy
+  using NextHopSet = std::vector<thrift::NextHopThrift>;
+  using NextHopSetPtr = std::shared_ptr<const NextHopSet>;
+
+  /**
+   * Compact internal unicast route. The destination lives in the map key
+   * and the next-hop set is interned; the rarely-set redistribution/bgp
+   * attributes are carried verbatim. Expanded back into a full
+   * thrift::UnicastRoute only at the API boundaries
+   */
+  struct CompactUnicastRoute {
+    NextHopSetPtr nextHops;
+    std::optional<thrift::AdminDistance> adminDistance;
+    std::optional<thrift::PrefixType> prefixType;
+    std::optional<std::string> data;
+    std::optional<thrift::NextHopThrift> bestNexthop;
+
+    thrift::UnicastRoute toThrift(const thrift::IpPrefix& dest) const;
+  };
+
+  /**
+   * Return the interned copy of the given next-hop set, creating one on
+   * first use. Expired entries are swept in processRouteUpdates once the
+   * last route referencing them is gone
+   */
+  NextHopSetPtr internNextHops(NextHopSet nextHops);
+
+  /**
+   * Build the compact internal representation of the given thrift route,
+   * interning its next-hop set
+   */
+  CompactUnicastRoute compactUnicastRoute(const thrift::UnicastRoute& route);
+
   /**
    * Process new route updates received from Decision module
    */
@@ -127,6 +251,13 @@ class Fib final : public OpenrEventBase {
    */
   thrift::PerfDatabase dumpPerfDb() const;
 
+  /**
+   * Approximate convergence-latency percentile (0-100) from the streaming
+   * histogram, reported as the upper bound of the bucket holding the
+   * requested rank. Must not be called before the first sample is recorded
+   */
+  int64_t estimateConvergencePercentile(uint32_t percentile) const;
+
   /**
    * Retrieve unicast routes with specified filters
    */
@@ -142,7 +273,7 @@ class Fib final : public OpenrEventBase {
   /**
    * Trigger add/del routes thrift calls
    * on success no action needed
-   * on failure invokes syncRouteDbDebounced
+   * on failure marks the attempted routes for individual retry with backoff
    */
   void updateRoutes(const thrift::RouteDatabaseDelta& routeDbDelta);
 
@@ -153,31 +284,134 @@ class Fib final : public OpenrEventBase {
    */
   bool syncRouteDb();
 
+  /**
+   * Read back the agent's current route table and program only the
+   * difference against the given desired routes, leaving already-correct
+   * routes untouched. Returns false if the read-back failed and the caller
+   * should fall back to a full syncFib; programming failures propagate as
+   * thrift exceptions just like updateRoutes
+   */
+  bool syncRouteDbByDiff(
+      const std::vector<thrift::UnicastRoute>& unicastRoutes,
+      const std::vector<thrift::MplsRoute>& mplsRoutes);
+
+  /**
+   * Route-programming primitives towards the agent. Dispatch to the
+   * in-process netlink fib handler when direct-netlink mode is enabled,
+   * bypassing thrift serialization and the agent socket, and to the thrift
+   * client otherwise (createFibClient() must have been called first)
+   */
+  folly::Future<folly::Unit> addUnicastRoutesToAgent(
+      std::vector<thrift::UnicastRoute> routes);
+  folly::Future<folly::Unit> deleteUnicastRoutesFromAgent(
+      std::vector<thrift::IpPrefix> prefixes);
+  folly::Future<folly::Unit> addMplsRoutesToAgent(
+      std::vector<thrift::MplsRoute> routes);
+  folly::Future<folly::Unit> deleteMplsRoutesFromAgent(
+      std::vector<int32_t> topLabels);
+
   /**
    * Asynchrounsly schedules the syncRouteDb call and returns immediately. All
    * APIs should call this function to sync-routes.
    */
   void syncRouteDbDebounced();
 
+  /**
+   * Record a failed programming attempt for each given prefix/label and
+   * arm retryRoutesTimer_ for the earliest due retry. A route that keeps
+   * failing past its retry budget indicates divergence no targeted retry
+   * can explain, so the whole retry set is promoted to an enforced full
+   * fib sync instead
+   */
+  void markRoutesForRetry(
+      const std::vector<thrift::IpPrefix>& prefixes,
+      const std::vector<int32_t>& labels);
+
+  /**
+   * Re-program only the failed routes whose individual backoff has
+   * elapsed, against the current routeState_ (a route updated or deleted
+   * since the failure is retried with its current contents). Invoked from
+   * retryRoutesTimer_
+   */
+  void retryFailedRoutes();
+
+  /**
+   * Arm retryRoutesTimer_ for the earliest retry among tracked routes.
+   * No-op when nothing is pending retry
+   */
+  void scheduleRetryRoutesTimer();
+
+  /**
+   * Rebuild the seqlocked route-db snapshot from routeState_ and publish
+   * it. Invoked wherever the route table mutates (and once from the
+   * constructor, before any concurrent reader can exist)
+   */
+  void refreshRouteDbSnapshot();
+
+  /**
+   * Expand the current seqlocked snapshot into a route database. Shared
+   * by getRouteDb() and its coroutine variant; safe from any thread.
+   */
+  std::unique_ptr<thrift::RouteDatabase> readRouteDbSnapshot();
+
   /**
    * Get aliveSince from FibService, and check if Fib restarts
    * If so, push syncFib to FibService
    */
   void keepAliveCheck();
 
+  /**
+   * Register agentCloseCallback_ on the thrift channel towards the agent.
+   * Must be invoked after every createFibClient() call so reconnects keep
+   * the connection-level liveness notification armed
+   */
+  void setAgentCloseCallback();
+
+  /**
+   * Notified by the thrift channel as soon as the agent connection drops.
+   * Marks the route DB dirty and schedules an immediate resync, instead of
+   * leaving the blackhole in place until the next keep-alive poll notices
+   * the dead socket
+   */
+  class AgentCloseCallback final : public apache::thrift::CloseCallback {
+   public:
+    explicit AgentCloseCallback(Fib& fib) : fib_(fib) {}
+
+    void channelClosed() override;
+
+   private:
+    Fib& fib_;
+  };
+
   // set flat counter/stats
   void updateGlobalCounters();
 
   // log perf events
   void logPerfEvents(std::optional<thrift::PerfEvents> perfEvents);
 
+  /**
+   * Advertise an in-band completion signal after routes are programmed.
+   * Decision instances across the network release their ordered-fib holds
+   * as soon as every node has acked, instead of waiting out the worst-case
+   * fib-programming timer. No-op unless ordered fib programming is enabled.
+   */
+  void signalOrderedFibProgrammed();
+
   // Prefix to available nexthop information. Also store perf information of
   // received route-db if provided.
   struct RouteState {
-    // Non modified copy of Unicast and MPLS routes received from Decision
-    std::unordered_map<thrift::IpPrefix, thrift::UnicastRoute> unicastRoutes;
+    // Unicast and MPLS routes received from Decision. Unicast routes are
+    // held in the compact representation - dest as the key, next-hop set
+    // interned - since that table dominates memory at scale; the mpls
+    // table stays small (one label per node plus adjacencies)
+    std::unordered_map<thrift::IpPrefix, CompactUnicastRoute> unicastRoutes;
     std::unordered_map<uint32_t, thrift::MplsRoute> mplsRoutes;
 
+    // radix-trie index over keys of unicastRoutes, kept in sync by
+    // processRouteUpdates. Backs longest-prefix-match lookups for the
+    // filtered dump APIs in O(address bits) instead of a table scan
+    PrefixTrie unicastRouteTrie;
+
     // indicates we've received a decision route publication and therefore have
     // routes to sync. will not synce routes with system until this is set
     bool hasRoutesFromDecision{false};
@@ -200,8 +434,44 @@ class Fib final : public OpenrEventBase {
   };
   RouteState routeState_;
 
+  // Per-route retry state for routes whose last programming attempt
+  // failed. Each failed route backs off individually so one rejected
+  // route (e.g. a transient invalid-nexthop race) is retried alone
+  // instead of repeatedly re-programming the entire table
+  struct RouteRetryState {
+    ExponentialBackoff<std::chrono::milliseconds> backoff{
+        std::chrono::milliseconds(8), std::chrono::milliseconds(4096)};
+    uint32_t numFailures{0};
+  };
+  std::unordered_map<thrift::IpPrefix, RouteRetryState> retryPrefixes_;
+  std::unordered_map<uint32_t, RouteRetryState> retryLabels_;
+
+  // interned next-hop sets, keyed by value and holding weak references so
+  // interning never keeps a set alive after the last route using it is
+  // erased. Expired entries are swept in processRouteUpdates
+  std::map<NextHopSet, std::weak_ptr<const NextHopSet>> nextHopSetCache_;
+
   // Events to capture and indicate performance of protocol convergence.
-  std::deque<thrift::PerfEvents> perfDb_;
+  // Fixed-size ring: once kPerfBufferSize events are buffered a new event
+  // overwrites the oldest one in place, so the steady state allocates
+  // nothing on the perf-logging path
+  std::vector<thrift::PerfEvents> perfDb_;
+
+  // ring slot the next perf event is written to; points at the oldest
+  // entry once the buffer has wrapped
+  size_t perfDbNextIndex_{0};
+
+  // streaming histogram over publication -> programmed latency of every
+  // perf event, updated in O(1). One bucket per kPerfHistogramBucketWidth
+  // up to kConvergenceMaxDuration, with the last bucket absorbing slower
+  // outliers; approximate percentiles are derived on demand in dumpPerfDb
+  std::array<
+      uint64_t,
+      Constants::kConvergenceMaxDuration /
+              Constants::kPerfHistogramBucketWidth +
+          1>
+      convergenceLatencyBuckets_{};
+  uint64_t numConvergenceLatencySamples_{0};
 
   // Create timestamp of recently logged perf event
   int64_t recentPerfEventCreateTs_{0};
@@ -225,27 +495,63 @@ class Fib final : public OpenrEventBase {
   // indicates that we should publish fib programming time to kvstore
   bool enableOrderedFib_{false};
 
+  // program full syncs as a delta against the agent's read-back route table
+  bool enableFibSyncDiff_{false};
+
+  // maximum number of routes per thrift call towards the agent; bulk
+  // deltas are programmed as a sequence of chunks of this size
+  size_t routeProgramChunkSize_{Constants::kFibRouteProgramChunkSize};
+
+  // number of chunk RPCs kept in flight towards the agent; one preserves
+  // strict call-by-call programming, more pipelines chunks so throughput
+  // is bound by the agent's apply rate rather than per-call round trips
+  size_t routeProgramWindowSize_{1};
+
+  // monotonically increasing value of the programming-completion ack key,
+  // bumped on every successful route programming
+  int64_t orderedFibAckSeq_{0};
+
   apache::thrift::CompactSerializer serializer_;
 
+  // In-process fib handler for direct-netlink mode. When set, route
+  // programming calls go straight into the handler instead of over thrift
+  std::shared_ptr<NetlinkFibHandler> fibHandler_{nullptr};
+
   // Thrift client connection to switch FIB Agent using which we actually
   // manipulate routes.
   folly::EventBase evb_;
   std::shared_ptr<folly::AsyncSocket> socket_{nullptr};
   std::unique_ptr<thrift::FibServiceAsyncClient> client_{nullptr};
 
+  // close-notification hook attached to the client channel above
+  AgentCloseCallback agentCloseCallback_{*this};
+
   // Callback timer to sync routes to switch agent and scheduled on route-sync
   // failure. ExponentialBackoff timer to ease up things if they go wrong
   std::unique_ptr<folly::AsyncTimeout> syncRoutesTimer_{nullptr};
   ExponentialBackoff<std::chrono::milliseconds> expBackoff_;
 
+  // Callback timer driving retryFailedRoutes for routes pending an
+  // individual retry
+  std::unique_ptr<folly::AsyncTimeout> retryRoutesTimer_{nullptr};
+
   // periodically send alive msg to switch agent
   std::unique_ptr<folly::AsyncTimeout> keepAliveTimer_{nullptr};
 
-  // client to interact with monitor
-  std::unique_ptr<fbzmq::ZmqMonitorClient> zmqMonitorClient_;
+  // seqlocked snapshot of the route database, serving getRouteDb() from
+  // any thread with zero Fib-thread involvement
+  SeqlockRouteDb routeDbSnapshot_;
+
+  // async event-log submitter towards the monitor; logging on the fib
+  // thread costs a single bounded enqueue
+  std::unique_ptr<EventLogger> eventLogger_;
 
   // module ptr to refer to KvStore for KvStoreClientInternal usage
   KvStore* kvStore_{nullptr};
+
+  // config-store for the warm-restart route snapshot; may be nullptr, in
+  // which case restarts are cold
+  PersistentStore* configStore_{nullptr};
   std::unique_ptr<KvStoreClientInternal> kvStoreClient_;
 
   // Latest aliveSince heard from FibService. If the next one is different then
@@ -54,6 +54,10 @@ static const long kBitMaskLen = 128;
 static const uint32_t kDeltaSize = 10;
 // Number of nexthops
 const uint8_t kNumOfNexthops = 128;
+// Number of nexthops per route in the delta-programming benchmark. Kept
+// small so the 500k-route data point measures programming throughput
+// rather than nexthop generation
+const uint8_t kNumOfDeltaNexthops = 16;
 
 } // anonymous namespace
 
@@ -264,12 +268,144 @@ BM_Fib(folly::UserCounters& counters, uint32_t iters, unsigned numOfPrefixes) {
   counters["route_install"] = processTimes[2];
 }
 
+/**
+ * Benchmark for delta-apply throughput
+ * 1. Create a fib with the mock agent and wait out the initial sync
+ * 2. Push route deltas of the given size through
+ *    processRouteUpdates -> updateRoutes
+ * 3. Report routes/sec programmed and the per-delta latency distribution
+ *    (push to programmed-by-agent), so chunking/pipelining changes show
+ *    up directly
+ */
+static void
+BM_FibDeltaProgramming(
+    folly::UserCounters& counters, uint32_t iters, unsigned deltaSize) {
+  auto suspender = folly::BenchmarkSuspender();
+  auto fibWrapper = std::make_unique<FibWrapper>();
+
+  // Initial syncFib debounce
+  fibWrapper->mockFibHandler->waitForSyncFib();
+
+  auto prefixes =
+      fibWrapper->prefixGenerator.ipv6PrefixGenerator(deltaSize, kBitMaskLen);
+  std::vector<uint64_t> latenciesUs;
+  latenciesUs.reserve(iters);
+  auto expectedRouteCount = fibWrapper->mockFibHandler->getAddRoutesCount();
+
+  for (uint32_t i = 0; i < iters; i++) {
+    // Build the delta outside the measured window
+    thrift::RouteDatabaseDelta routeDbDelta;
+    routeDbDelta.thisNodeName = "node-1";
+    for (auto const& prefix : prefixes) {
+      routeDbDelta.unicastRoutesToUpdate.emplace_back(createUnicastRoute(
+          prefix,
+          fibWrapper->prefixGenerator.getRandomNextHopsUnicast(
+              kNumOfDeltaNexthops, kVethNameY)));
+    }
+
+    suspender.dismiss(); // Start measuring benchmark time
+    auto const start = std::chrono::steady_clock::now();
+    fibWrapper->routeUpdatesQueue.push(std::move(routeDbDelta));
+    // chunked programming makes several addUnicastRoutes calls per delta,
+    // so wait on the cumulative route count instead of the per-call baton
+    expectedRouteCount += deltaSize;
+    while (fibWrapper->mockFibHandler->getAddRoutesCount() <
+           expectedRouteCount) {
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+    latenciesUs.emplace_back(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count());
+    suspender.rehire(); // Stop measuring time again
+  }
+
+  // Report latency distribution and aggregate programming rate
+  std::sort(latenciesUs.begin(), latenciesUs.end());
+  auto const percentile = [&latenciesUs](size_t pct) {
+    return latenciesUs[std::min(
+        latenciesUs.size() - 1, pct * latenciesUs.size() / 100)];
+  };
+  uint64_t totalUs = 0;
+  for (auto const& latencyUs : latenciesUs) {
+    totalUs += latencyUs;
+  }
+  counters["delta_p50_us"] = percentile(50);
+  counters["delta_p95_us"] = percentile(95);
+  counters["delta_p99_us"] = percentile(99);
+  counters["routes_per_sec"] = totalUs == 0
+      ? 0
+      : 1000000ull * deltaSize * latenciesUs.size() / totalUs;
+}
+
+/**
+ * Benchmark for the diffing cost of a diff-based full sync: time
+ * findDeltaRoutes over a desired and a read-back route database of the
+ * given size that differ in ~1% of the routes
+ */
+static void
+BM_FindDeltaRoutes(
+    folly::UserCounters& counters, uint32_t iters, unsigned numOfRoutes) {
+  auto suspender = folly::BenchmarkSuspender();
+  PrefixGenerator prefixGenerator;
+  auto prefixes =
+      prefixGenerator.ipv6PrefixGenerator(numOfRoutes, kBitMaskLen);
+
+  thrift::RouteDatabase agentRouteDb, desiredRouteDb;
+  for (auto const& prefix : prefixes) {
+    auto route = createUnicastRoute(
+        prefix,
+        prefixGenerator.getRandomNextHopsUnicast(
+            kNumOfDeltaNexthops, kVethNameY));
+    agentRouteDb.unicastRoutes.emplace_back(route);
+    desiredRouteDb.unicastRoutes.emplace_back(std::move(route));
+  }
+  // Churn the nexthops of ~1% of the desired routes
+  size_t const numChanged = std::max<size_t>(1, numOfRoutes / 100);
+  for (size_t index = 0; index < numChanged; index++) {
+    desiredRouteDb.unicastRoutes[index].nextHops =
+        prefixGenerator.getRandomNextHopsUnicast(
+            kNumOfDeltaNexthops, kVethNameY);
+  }
+  // findDeltaRoutes expects sorted route databases
+  for (auto* routeDb : {&agentRouteDb, &desiredRouteDb}) {
+    for (auto& route : routeDb->unicastRoutes) {
+      std::sort(route.nextHops.begin(), route.nextHops.end());
+    }
+    std::sort(routeDb->unicastRoutes.begin(), routeDb->unicastRoutes.end());
+  }
+
+  suspender.dismiss(); // Start measuring benchmark time
+  size_t numDeltaRoutes = 0;
+  for (uint32_t i = 0; i < iters; i++) {
+    auto const routeDbDelta = findDeltaRoutes(desiredRouteDb, agentRouteDb);
+    numDeltaRoutes = routeDbDelta.unicastRoutesToUpdate.size();
+    folly::doNotOptimizeAway(routeDbDelta);
+  }
+  suspender.rehire(); // Stop measuring time again
+
+  counters["num_delta_routes"] = numDeltaRoutes;
+}
+
 // The parameter is the number of prefixes sent to fib
 BENCHMARK_COUNTERS_PARAM(BM_Fib, counters, 10);
 BENCHMARK_COUNTERS_PARAM(BM_Fib, counters, 100);
 BENCHMARK_COUNTERS_PARAM(BM_Fib, counters, 1000);
 BENCHMARK_COUNTERS_PARAM(BM_Fib, counters, 9000);
 
+// The parameter is the size of the route delta pushed per iteration
+BENCHMARK_COUNTERS_PARAM(BM_FibDeltaProgramming, counters, 1);
+BENCHMARK_COUNTERS_PARAM(BM_FibDeltaProgramming, counters, 100);
+BENCHMARK_COUNTERS_PARAM(BM_FibDeltaProgramming, counters, 10000);
+BENCHMARK_COUNTERS_PARAM(BM_FibDeltaProgramming, counters, 100000);
+BENCHMARK_COUNTERS_PARAM(BM_FibDeltaProgramming, counters, 500000);
+
+// The parameter is the size of the route databases being diffed
+BENCHMARK_COUNTERS_PARAM(BM_FindDeltaRoutes, counters, 100);
+BENCHMARK_COUNTERS_PARAM(BM_FindDeltaRoutes, counters, 10000);
+BENCHMARK_COUNTERS_PARAM(BM_FindDeltaRoutes, counters, 100000);
+BENCHMARK_COUNTERS_PARAM(BM_FindDeltaRoutes, counters, 500000);
+
 } // namespace openr
 
 int
@@ -30,6 +30,7 @@
 #include <thrift/lib/cpp2/util/ScopedServerThread.h>
 
 #include <openr/common/NetworkUtil.h>
+#include <openr/config-store/PersistentStoreWrapper.h>
 #include <openr/config/Config.h>
 #include <openr/config/tests/Utils.h>
 #include <openr/fib/Fib.h>
@@ -716,6 +717,62 @@ TEST_F(FibTestFixture, basicAddAndDelete) {
   EXPECT_EQ(mockFibHandler->getDelMplsRoutesCount(), 2);
 }
 
+TEST_F(FibTestFixture, perRouteRetry) {
+  // Make sure fib starts with clean route database
+  std::vector<thrift::UnicastRoute> routes;
+  mockFibHandler->getRouteTableByClient(routes, kFibId);
+  EXPECT_EQ(routes.size(), 0);
+
+  // initial syncFib debounce
+  mockFibHandler->waitForSyncFib();
+  mockFibHandler->waitForSyncMplsFib();
+  const auto fibSyncCount = mockFibHandler->getFibSyncCount();
+
+  // agent rejects the first programming attempt. The failed route must
+  // come back through its own retry, not through a full sync
+  mockFibHandler->failNextAddUnicastRoutes(1);
+
+  thrift::RouteDatabaseDelta routeDbDelta;
+  routeDbDelta.thisNodeName = "node-1";
+  routeDbDelta.unicastRoutesToUpdate = {
+      createUnicastRoute(prefix2, {path1_2_1, path1_2_2})};
+  routeUpdatesQueue.push(routeDbDelta);
+
+  // injected failure throws before the mock records the update, so this
+  // only wakes up once the per-route retry succeeds
+  mockFibHandler->waitForUpdateUnicastRoutes();
+
+  mockFibHandler->getRouteTableByClient(routes, kFibId);
+  EXPECT_EQ(routes.size(), 1);
+  EXPECT_EQ(mockFibHandler->getFibSyncCount(), fibSyncCount);
+}
+
+TEST_F(FibTestFixture, perRouteRetryPromotesToFullSync) {
+  // Make sure fib starts with clean route database
+  std::vector<thrift::UnicastRoute> routes;
+  mockFibHandler->getRouteTableByClient(routes, kFibId);
+  EXPECT_EQ(routes.size(), 0);
+
+  // initial syncFib debounce
+  mockFibHandler->waitForSyncFib();
+  mockFibHandler->waitForSyncMplsFib();
+
+  // fail the initial attempt and every per-route retry. Once the retry
+  // budget is exhausted fib must fall back to an enforced full sync
+  mockFibHandler->failNextAddUnicastRoutes(4);
+
+  thrift::RouteDatabaseDelta routeDbDelta;
+  routeDbDelta.thisNodeName = "node-1";
+  routeDbDelta.unicastRoutesToUpdate = {
+      createUnicastRoute(prefix2, {path1_2_1, path1_2_2})};
+  routeUpdatesQueue.push(routeDbDelta);
+
+  // the promoted full sync reconciles the route
+  mockFibHandler->waitForSyncFib();
+  mockFibHandler->getRouteTableByClient(routes, kFibId);
+  EXPECT_EQ(routes.size(), 1);
+}
+
 TEST_F(FibTestFixture, fibRestart) {
   // Make sure fib starts with clean route database
   std::vector<thrift::UnicastRoute> routes;
@@ -952,6 +1009,63 @@ TEST_F(FibTestFixture, getUnicastRoutesFilteredTest) {
   EXPECT_EQ(notFoundResp.size(), 0);
 }
 
+TEST_F(FibTestFixture, getRouteDbPaginatedTest) {
+  // Make sure fib starts with clean route database
+  std::vector<thrift::UnicastRoute> routes;
+  std::vector<thrift::MplsRoute> mplsRoutes;
+  mockFibHandler->getRouteTableByClient(routes, kFibId);
+  mockFibHandler->getMplsRouteTableByClient(mplsRoutes, kFibId);
+  EXPECT_EQ(routes.size(), 0);
+  EXPECT_EQ(mplsRoutes.size(), 0);
+
+  // initial syncFib debounce
+  mockFibHandler->waitForSyncFib();
+  mockFibHandler->waitForSyncMplsFib();
+
+  // add 3 unicast and 2 mpls routes
+  thrift::RouteDatabaseDelta routeDbDelta;
+  routeDbDelta.thisNodeName = "node-1";
+  routeDbDelta.unicastRoutesToUpdate = {
+      createUnicastRoute(prefix1, {path1_2_1}),
+      createUnicastRoute(prefix2, {path1_2_2}),
+      createUnicastRoute(prefix3, {path1_3_1})};
+  routeDbDelta.mplsRoutesToUpdate = {
+      createMplsRoute(label1, {mpls_path1_2_1}),
+      createMplsRoute(label2, {mpls_path1_2_2})};
+  routeUpdatesQueue.push(routeDbDelta);
+  mockFibHandler->waitForUpdateUnicastRoutes();
+  mockFibHandler->waitForUpdateMplsRoutes();
+
+  // walk the dump two routes at a time and collect the pages
+  size_t numUnicast{0}, numMpls{0}, numPages{0};
+  std::set<thrift::IpPrefix> seenPrefixes;
+  std::string cursor;
+  while (true) {
+    auto page = fib->getRouteDbPaginated(cursor, 2).get();
+    ASSERT_TRUE(page);
+    EXPECT_EQ("node-1", page->thisNodeName);
+    EXPECT_LE(page->unicastRoutes.size() + page->mplsRoutes.size(), 2);
+    numUnicast += page->unicastRoutes.size();
+    numMpls += page->mplsRoutes.size();
+    numPages++;
+    for (const auto& route : page->unicastRoutes) {
+      EXPECT_TRUE(seenPrefixes.insert(route.dest).second);
+    }
+    if (not page->nextCursor_ref().has_value()) {
+      break;
+    }
+    cursor = page->nextCursor_ref().value();
+  }
+  EXPECT_EQ(3, numUnicast);
+  EXPECT_EQ(2, numMpls);
+  EXPECT_EQ(3, numPages);
+
+  // malformed cursor must fail the call, not restart the dump
+  EXPECT_THROW(
+      fib->getRouteDbPaginated("bogus:cursor", 2).get(),
+      std::invalid_argument);
+}
+
 TEST_F(FibTestFixture, longestPrefixMatchTest) {
   std::unordered_map<thrift::IpPrefix, thrift::UnicastRoute> unicastRoutes;
   const auto& dbPrefix1 = toIpPrefix("192.168.0.0/16");
@@ -1062,6 +1176,92 @@ TEST_F(FibTestFixture, doNotInstall) {
   EXPECT_EQ(routes.size(), 2);
 }
 
+TEST(FibWarmRestart, RestoreRouteSnapshot) {
+  fbzmq::Context context;
+  const auto tid = std::hash<std::thread::id>()(std::this_thread::get_id());
+  PersistentStoreWrapper store(context, tid);
+  store.run();
+
+  // dryrun fib - no agent needed; warm restart only touches route state
+  auto tConfig = getBasicOpenrConfig(
+      "node-1",
+      true, /* enableV4 */
+      true, /* enableSegmentRouting */
+      false, /* orderedFibProgramming */
+      true /* dryrun */);
+  auto config = make_shared<Config>(tConfig);
+
+  // first incarnation: learn one route from Decision, then stop - the
+  // snapshot is persisted on the way down
+  {
+    messaging::ReplicateQueue<thrift::RouteDatabaseDelta> routeUpdatesQueue;
+    messaging::ReplicateQueue<thrift::InterfaceDatabase>
+        interfaceUpdatesQueue;
+    auto fib = std::make_shared<Fib>(
+        config,
+        -1, /* thrift port */
+        std::chrono::seconds(2), /* coldStartDuration */
+        routeUpdatesQueue.getReader(),
+        interfaceUpdatesQueue.getReader(),
+        MonitorSubmitUrl{"inproc://monitor-sub-warm"},
+        nullptr, /* KvStore module ptr */
+        context,
+        nullptr, /* fibHandler */
+        store.operator->());
+    std::thread fibThread([&fib]() { fib->run(); });
+    fib->waitUntilRunning();
+
+    thrift::RouteDatabaseDelta routeDbDelta;
+    routeDbDelta.thisNodeName = "node-1";
+    routeDbDelta.unicastRoutesToUpdate = {
+        createUnicastRoute(prefix1, {path1_2_1, path1_2_2})};
+    routeUpdatesQueue.push(routeDbDelta);
+
+    // wait for fib to absorb the update
+    while (fib->getRouteDb().get()->unicastRoutes.size() != 1) {
+      /* sleep override */
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    routeUpdatesQueue.close();
+    interfaceUpdatesQueue.close();
+    fib->stop();
+    fib->waitUntilStopped();
+    fibThread.join();
+  }
+
+  // second incarnation comes up with the snapshot restored before any
+  // Decision update arrives
+  {
+    messaging::ReplicateQueue<thrift::RouteDatabaseDelta> routeUpdatesQueue;
+    messaging::ReplicateQueue<thrift::InterfaceDatabase>
+        interfaceUpdatesQueue;
+    auto fib = std::make_shared<Fib>(
+        config,
+        -1, /* thrift port */
+        std::chrono::seconds(2), /* coldStartDuration */
+        routeUpdatesQueue.getReader(),
+        interfaceUpdatesQueue.getReader(),
+        MonitorSubmitUrl{"inproc://monitor-sub-warm"},
+        nullptr, /* KvStore module ptr */
+        context,
+        nullptr, /* fibHandler */
+        store.operator->());
+    std::thread fibThread([&fib]() { fib->run(); });
+    fib->waitUntilRunning();
+
+    auto routeDb = fib->getRouteDb().get();
+    ASSERT_EQ(1, routeDb->unicastRoutes.size());
+    EXPECT_EQ(prefix1, routeDb->unicastRoutes.at(0).dest);
+
+    routeUpdatesQueue.close();
+    interfaceUpdatesQueue.close();
+    fib->stop();
+    fib->waitUntilStopped();
+    fibThread.join();
+  }
+}
+
 int
 main(int argc, char* argv[]) {
   // Parse command line flags
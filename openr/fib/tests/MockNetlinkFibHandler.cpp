@@ -70,6 +70,10 @@ MockNetlinkFibHandler::deleteUnicastRoute(
 void
 MockNetlinkFibHandler::addUnicastRoutes(
     int16_t, std::unique_ptr<std::vector<openr::thrift::UnicastRoute>> routes) {
+  if (addUnicastRoutesFaults_ > 0) {
+    --addUnicastRoutesFaults_;
+    throw std::runtime_error("Injected addUnicastRoutes failure");
+  }
   SYNCHRONIZED(unicastRouteDb_) {
     for (auto const& route : *routes) {
       auto prefix = std::make_pair(
@@ -257,6 +261,11 @@ MockNetlinkFibHandler::waitForSyncMplsFib() {
   syncMplsFibBaton_.reset();
 }
 
+void
+MockNetlinkFibHandler::failNextAddUnicastRoutes(size_t numCalls) {
+  addUnicastRoutesFaults_ = numCalls;
+}
+
 void
 MockNetlinkFibHandler::stop() {
   SYNCHRONIZED(unicastRouteDb_) {
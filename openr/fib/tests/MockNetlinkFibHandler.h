@@ -124,6 +124,12 @@ class MockNetlinkFibHandler final : public thrift::FibServiceSvIf {
 
   void restart();
 
+  /**
+   * Make the next numCalls addUnicastRoutes calls throw, mimicking an
+   * agent rejecting the programming request
+   */
+  void failNextAddUnicastRoutes(size_t numCalls);
+
  private:
   // Time when service started, in number of seconds, since epoch
   folly::Synchronized<int64_t> startTime_{0};
@@ -136,6 +142,9 @@ class MockNetlinkFibHandler final : public thrift::FibServiceSvIf {
       std::unordered_map<int32_t, std::vector<thrift::NextHopThrift>>>
       mplsRouteDb_;
 
+  // Remaining addUnicastRoutes calls to fail for fault injection
+  std::atomic<size_t> addUnicastRoutesFaults_{0};
+
   // Stats
   std::atomic<size_t> fibSyncCount_{0};
   std::atomic<size_t> addRoutesCount_{0};
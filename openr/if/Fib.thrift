@@ -22,6 +22,20 @@ struct RouteDatabase {
   5: list<Network.MplsRoute> mplsRoutes
 }
 
+/**
+ * One bounded page of the route database. Returned by the paginated and
+ * streamed dump APIs so a full-table dump never materializes more than a
+ * page worth of thrift routes at a time.
+ */
+struct RouteDatabasePage {
+  1: string thisNodeName
+  2: list<Network.UnicastRoute> unicastRoutes
+  3: list<Network.MplsRoute> mplsRoutes
+  // opaque cursor to pass into the next call to resume the dump. Unset
+  // once the dump is complete
+  4: optional string nextCursor
+}
+
 struct RouteDatabaseDelta {
   1: string thisNodeName
   2: list<Network.UnicastRoute> unicastRoutesToUpdate
@@ -35,4 +49,11 @@ struct RouteDatabaseDelta {
 struct PerfDatabase {
   1: string thisNodeName
   2: list<Lsdb.PerfEvents> eventInfo
+  # approximate percentiles of publication -> programmed convergence latency
+  # in milliseconds, derived from a streaming histogram over every event seen
+  # since process start (not just the buffered ones). Unset until the first
+  # event is recorded
+  3: optional i64 convergenceLatencyP50Ms
+  4: optional i64 convergenceLatencyP95Ms
+  5: optional i64 convergenceLatencyP99Ms
 }
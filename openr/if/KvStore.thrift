@@ -51,6 +51,31 @@ enum Command {
   FLOOD_TOPO_SET = 11, // set or unset flooding-topo child
 }
 
+// one hop of an opt-in flood-path trace. Timestamps are system-clock
+// nanoseconds since epoch on the hop's node: ingress is taken when the
+// carrying update is merged, egress when it is re-flooded, so their
+// difference exposes local processing and queueing delay while egress to
+// the next hop's ingress exposes per-link latency (modulo clock skew)
+struct FloodTraceHop {
+  1: string nodeId
+  2: i64 ingressTimeNs
+  // zero until the update is re-flooded past this node
+  3: i64 egressTimeNs
+}
+
+// hop-by-hop trace carried alongside a sampled key while its update
+// floods through the fabric (see KeySetParams.hopTraces)
+struct FloodPathTrace {
+  1: list<FloodTraceHop> hops
+}
+
+// a trace harvested at one node: the key it was sampled on and the hops
+// accumulated up to and including that node (see getKvStoreFloodTraces)
+struct FloodTraceRecord {
+  1: string key
+  2: FloodPathTrace trace
+}
+
 struct KeySetParams {
   // NOTE: the struct is denormalized on purpose,
   // it may happen so we repeat originatorId
@@ -73,6 +98,20 @@ struct KeySetParams {
   // optional attribute to indicate timestamp when request is sent. This is
   // system timestamp in milliseconds since epoch
   7: optional i64 timestamp_ms
+
+  // optional flood-path traces for sampled keys in keyVals, keyed by key.
+  // Every node on the flood path appends its hop (up to a length cap) and
+  // retains a copy for harvest. Only present when flood-path tracing is
+  // enabled (see KvstoreConfig.flood_trace_sample_rate)
+  8: optional map<string, FloodPathTrace> hopTraces
+
+  // optional sequencing over the pipelined thrift flood path: senderId
+  // names the directly connected sending node and floodSeqNum its
+  // per-peer, per-area send counter. The receiver uses the pair to apply
+  // publications in send order when RPCs within the pipeline window are
+  // dispatched out of order (see KvStoreDb::mergeOrderedPublication)
+  9: optional string senderId
+  10: optional i64 floodSeqNum
 }
 
 struct KeyGetParams {
@@ -87,6 +126,41 @@ struct KeyDumpParams {
   //  1) If NOT empty, ONLY respond with keyVals on which hash differs;
   //  2) Otherwise, respond with flooding element to signal DB change;
   2: optional KeyVals keyValHashes
+
+  // optional per-bucket hashes of the sender's hash-tree index over its
+  // key-vals. When present, responder may skip buckets whose hashes match
+  // its own so full-sync cost is proportional to the divergence instead of
+  // the database size.
+  4: optional map<i32, i64>
+    (cpp.type = "std::unordered_map<int32_t, int64_t>") keyValHashTreeBuckets
+
+  // optional root digest of the sender's hash-tree index. Sent as a cheap
+  // in-sync probe ahead of per-key hashes: a responder whose own root
+  // matches confirms equality without dumping anything, and the sender
+  // only falls back to a full per-key hash dump on digest mismatch
+  5: optional i64 keyValsRootHash
+
+  // when set, the responder may return a large full-sync reply as a
+  // zstd frame in Publication.compressedPayload instead of plain thrift.
+  // Older responders ignore this field and reply uncompressed
+  6: optional bool acceptCompressedPayload
+
+  // optional cursor for incremental dumps: only key-vals updated after
+  // this per-area sequence (see Publication.updateSeq) are returned, plus
+  // keys expired since then. A cursor older than the responder's retained
+  // expiration history yields a full dump. Clients polling multiple areas
+  // keep one cursor per area
+  7: optional i64 sinceSeq
+
+  // optional range-dump window over the responder's lexicographically
+  // sorted key space: only keys strictly greater than startKey are
+  // considered (exclusive resume cursor; absent means start from the
+  // lowest key) and at most maxKeys entries are returned. The responder
+  // sets Publication.nextKey when the window filled before the key space
+  // was exhausted; clients paginate by feeding it back as startKey.
+  // maxKeys <= 0 means unbounded
+  8: optional string startKey
+  9: optional i32 maxKeys
 }
 
 // Peer's publication and command socket URLs
@@ -123,11 +197,20 @@ struct PeerDelParams {
   1: list<string> peerNames
 }
 
+// per-area peer update section, see PeerUpdateRequest.areaUpdates
+struct AreaPeerUpdate {
+  1: optional PeerAddParams peerAddParams
+  2: optional PeerDelParams peerDelParams
+}
+
 // peer updateRequest
 struct PeerUpdateRequest {
   1: string area = kDefaultArea
   2: optional PeerAddParams peerAddParams
   3: optional PeerDelParams peerDelParams
+  # peer changes for several areas batched into one request, keyed by
+  # area. when set, the single-area fields above are ignored
+  4: optional map<string, AreaPeerUpdate> areaUpdates
 }
 
 // set/unset flood-topo child
@@ -163,6 +246,20 @@ typedef map<string, SptInfo>
   (cpp.type = "std::unordered_map<std::string, openr::thrift::SptInfo>")
   SptInfoMap
 
+// flood traffic sent towards one flood peer (SPT edge)
+struct FloodEdgeCounters {
+  // publications flooded over this edge
+  1: i64 publicationsSent
+  // key-vals carried by those publications
+  2: i64 keyValsSent
+}
+
+// map<peer-name: edge-counters>
+typedef map<string, FloodEdgeCounters>
+  (cpp.type =
+    "std::unordered_map<std::string, openr::thrift::FloodEdgeCounters>")
+  FloodEdgeCountersMap
+
 // all spanning tree(s) information
 struct SptInfos {
   // map<root-id: SptInfo>
@@ -173,6 +270,8 @@ struct SptInfos {
   3: optional string floodRootId
   // current flooding peers
   4: PeerNames floodPeers
+  // per flood-edge traffic accounting since the store started
+  5: optional FloodEdgeCountersMap floodEdgeCounters
 }
 
 
@@ -223,4 +322,34 @@ struct Publication {
 
   // area to which this publication belogs
   7: optional string area;
+
+  // responder's hash-tree root digest, set on replies to digest-probe
+  // full-sync requests so the requester can tell an in-sync confirmation
+  // apart from a mismatch that needs the per-key hash fallback
+  8: optional i64 keyValsRootHash;
+
+  // zstd-compressed serialized Publication, set in place of all other
+  // fields on large full-sync replies when the requester advertised
+  // KeyDumpParams.acceptCompressedPayload
+  9: optional binary compressedPayload;
+
+  // responder's current update sequence for the area, set on all dump
+  // replies (full or incremental). The client stores it as the cursor
+  // for its next incremental poll or post-disconnect tail re-sync
+  10: optional i64 updateSeq;
+
+  // resume cursor for range dumps, set when KeyDumpParams.maxKeys
+  // truncated the reply. Pass it back as KeyDumpParams.startKey to fetch
+  // the next page; absent when the requested range was exhausted
+  11: optional string nextKey;
+
+  // set (true) on an otherwise empty publication emitted once KvStore
+  // completed its initial full-sync with all configured peers across all
+  // areas. Consumers holding back cold-start work (e.g. Decision's first
+  // SPF run) may act on it instead of waiting out their cold-start timer
+  12: optional bool initialSyncComplete;
+
+  // flood-path traces for sampled keys in keyVals, carried between merge
+  // and re-flood (see KeySetParams.hopTraces)
+  13: optional map<string, FloodPathTrace> hopTraces;
 }
@@ -102,6 +102,31 @@ struct Adjacency {
   11: string otherIfName = ""
 }
 
+// compact wire form of Adjacency: node and interface names are indexes
+// into AdjacencyDatabase.stringTable so strings repeated across the
+// adjacency list (interface names, scoping ifNames of link-local
+// nexthops) are encoded once, and nexthop addresses are carried as raw
+// bytes. Integral fields ride the compact protocol's varints. On large
+// adjacency databases this cuts the serialized size several-fold, which
+// matters since those values are re-flooded fabric-wide on every change
+struct CompactAdjacency {
+  1: i32 otherNodeNameIdx
+  2: i32 ifNameIdx
+  // -1 when Adjacency.otherIfName is empty
+  3: i32 otherIfNameIdx
+  4: binary nextHopV6Addr
+  // index of BinaryAddress.ifName; -1 when unset
+  5: i32 nextHopV6IfNameIdx
+  6: binary nextHopV4Addr
+  7: i32 nextHopV4IfNameIdx
+  8: i32 metric
+  9: i32 adjLabel
+  10: bool isOverloaded
+  11: i32 rtt
+  12: i64 timestamp
+  13: i64 weight
+}
+
 // full link state information of a single router
 // announced under keys starting with "adjacencies:"
 struct AdjacencyDatabase {
@@ -124,6 +149,14 @@ struct AdjacencyDatabase {
 
   // openr area on which adjacency is formed
   6: optional string area
+
+  // compact encoding of `adjacencies` (see CompactAdjacency). When these
+  // fields are set the `adjacencies` list is left empty on the wire and
+  // decoders must rebuild it before use. Only emitted when
+  // LinkMonitorConfig.enable_compact_adjacency_db is set, which requires
+  // every node in the area to understand this encoding
+  7: optional list<string> stringTable
+  8: optional list<CompactAdjacency> compactAdjacencies
 }
 
 //
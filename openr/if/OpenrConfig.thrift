@@ -30,6 +30,31 @@ struct KvstoreConfig {
   # flood optimization
   8: optional bool enable_flood_optimization
   9: optional bool is_flood_root
+
+  # micro-batching window for flooding. Publications arriving within the
+  # window are coalesced into one publication per flood peer, with
+  # superseded versions of the same key merged before transmission
+  10: optional i32 flood_coalesce_window_ms
+
+  # run each area's KvStoreDb on its own event-base thread so flood storms
+  # in one area do not head-of-line block sync traffic in others
+  11: optional bool enable_parallel_areas
+
+  # periodically snapshot each area's key-vals to the persistent config
+  # store so a restarted node warms up from disk and only syncs deltas
+  # from peers. Disabled when unset
+  12: optional i32 snapshot_interval_s
+
+  # key prefixes whose updates are flooded immediately, bypassing the
+  # rate-limiter and coalescing buffer, so e.g. "adj:" updates do not
+  # queue behind bulk "prefix:" re-advertisements during churn
+  13: optional list<string> flood_priority_key_prefixes
+
+  # flood-path tracing: one in this many keys (elected deterministically
+  # on the key, so every node traces the same subset) carries per-hop
+  # ingress/egress timestamps while flooding, harvested per node via the
+  # getKvStoreFloodTraces ctrl API. Disabled when unset or zero
+  14: optional i32 flood_trace_sample_rate
 }
 
 struct LinkMonitorConfig {
@@ -39,6 +64,13 @@ struct LinkMonitorConfig {
   4: list<string> include_interface_regexes = []
   5: list<string> exclude_interface_regexes = []
   6: list<string> redistribute_interface_regexes = []
+
+  # Advertise the adjacency database in its compact encoding (string
+  # tables for repeated node/interface names, raw-byte nexthops - see
+  # Lsdb.CompactAdjacency), shrinking the bytes flooded per adjacency
+  # change. Decoders always accept both forms; only enable once every
+  # node in the fleet has been upgraded to understand the compact one
+  7: bool enable_compact_adjacency_db = false
 }
 
 struct SparkConfig {
@@ -50,6 +82,44 @@ struct SparkConfig {
   4: i32 keepalive_time_s = 2
   5: i32 hold_time_s = 10
   6: i32 graceful_restart_time_s = 30
+
+  # Adaptive keepalive: when enabled, the heartbeat interval and the hold
+  # time advertised to each neighbor scale with the measured RTT of the
+  # link - tight on low-RTT links for fast failure detection, relaxed up
+  # to the static times above on high-RTT or lossy links. The floors
+  # below bound how tight the adaptation may go.
+  7: bool enable_adaptive_keepalive = 0
+  8: i32 min_keepalive_time_ms = 25
+  9: i32 min_hold_time_ms = 75
+}
+
+/*
+ * Per-thread scheduling knobs, applied when the named module thread is
+ * spawned. Lets latency-critical threads (e.g. Spark heartbeats) be pinned
+ * and prioritized ahead of bulk work on shared-CPU devices.
+ */
+struct ThreadConfig {
+  # thread name as spawned by Main.cpp, e.g. "Spark", "KvStore"
+  1: string thread_name
+  # cpus the thread may run on; empty list leaves affinity untouched
+  2: list<i32> cpu_affinity = []
+  # scheduling policy: "other" (default), "rr" or "fifo". Realtime
+  # policies use sched_priority (1-99)
+  3: string sched_policy = "other"
+  4: i32 sched_priority = 1
+  # nice level, only meaningful with the "other" policy
+  5: i32 nice_level = 0
+  # NUMA node to prefer for the thread's memory (set_mempolicy), pairing
+  # the module's heap with the cpus above on multi-socket boxes; -1
+  # leaves the kernel's default policy untouched
+  6: i32 numa_node = -1
+  # give the thread its own jemalloc arena so the module's allocations
+  # (e.g. the KvStore or Decision hash maps) stop interleaving with the
+  # rest of the process and, with numa_node set, fault on the local
+  # socket. Ignored with a warning when not running under jemalloc.
+  # Hugepage backing for the arenas comes from jemalloc's process-wide
+  # thp option (MALLOC_CONF=thp:always)
+  7: bool dedicated_malloc_arena = false
 }
 
 struct WatchdogConfig {
@@ -58,6 +128,14 @@ struct WatchdogConfig {
   3: i32 max_memory_mb = 800
 }
 
+struct TelemetryConfig {
+  # seconds between histogram exports through the telemetry sink
+  1: i32 export_interval_s = 60
+  # samples kept per metric between exports; bounds both the memory and
+  # the per-event instrumentation cost of a metric
+  2: i32 reservoir_size = 256
+}
+
 enum PrefixForwardingType {
   IP = 0
   SR_MPLS = 1
@@ -94,6 +172,15 @@ struct PrefixAllocationConfig {
   6: optional i32 allocate_prefix_len
 }
 
+struct PrefixAggregationConfig {
+  # shortest aggregate the coalescing pass may form, per address family.
+  # Contiguous sibling prefixes merge into their common supernet only
+  # while the result stays at least this long, bounding how far a summary
+  # may overreach the constituent address space
+  1: i32 min_supernet_length_v4 = 24
+  2: i32 min_supernet_length_v6 = 48
+}
+
 /**
  * NOTE: interfaces and nodes can be explicit or unix regex
  * 1) Config specifying interfaces:
@@ -164,6 +251,46 @@ struct OpenrConfig {
   # fib
   22: optional bool enable_ordered_fib_programming
   23: i32 fib_port
+  # on full fib sync, read back the agent's route table and program only the
+  # difference instead of replaying the entire table
+  24: optional bool enable_fib_sync_diff
+  # maximum number of routes per thrift call towards the fib agent; bigger
+  # deltas are programmed as a sequence of bounded chunks
+  25: optional i32 fib_route_program_chunk_size
+  # number of route-programming chunk calls kept in flight towards the fib
+  # agent; 1 (default) programs strictly call by call
+  26: optional i32 fib_route_program_window_size
+  # program routes through an in-process netlink fib handler instead of the
+  # thrift client towards the local fib agent (standalone deployments);
+  # requires enable_netlink_fib_handler
+  27: optional bool enable_fib_direct_netlink
+  # feed link/address events from the in-process netlink socket straight
+  # into link-monitor, bypassing the platform publisher socket and the
+  # periodic thrift interface sync; requires the in-process netlink stack
+  28: optional bool enable_link_monitor_direct_netlink
+  # per-thread cpu affinity, scheduling policy and nice level, applied at
+  # thread spawn; threads without an entry keep the inherited defaults
+  29: optional list<ThreadConfig> thread_configs
+  # sampled hot-path telemetry (flood latency, spf duration, programming
+  # ack latency) exported as pre-aggregated histograms
+  30: optional bool enable_telemetry
+  31: optional TelemetryConfig telemetry_config
+  # coalesce contiguous/covered advertised prefixes into summaries before
+  # advertisement, shrinking the fabric-wide prefix count every downstream
+  # stage (flood, PrefixState, SPF route build, FIB) scales with
+  32: optional bool enable_prefix_aggregation
+  33: optional PrefixAggregationConfig prefix_aggregation_config
+  # when set, capture module input streams (publications entering
+  # Decision, platform events entering link-monitor) as compact binary
+  # logs under this directory for offline replay and profiling (see
+  # openr/common/ReplayLog.h)
+  34: optional string event_capture_dir
+  # precompute route databases for the most likely single-link failure
+  # scenarios while the decision compute thread is otherwise idle, so the
+  # reaction to such a failure is a cache lookup instead of a fresh SPF
+  # run. failure_precompute_top_k bounds how many scenarios are kept warm
+  35: optional bool enable_failure_precompute
+  36: optional i32 failure_precompute_top_k
 
   # bgp
   100: optional bool enable_bgp_peering
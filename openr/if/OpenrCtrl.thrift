@@ -31,6 +31,15 @@ struct StaticRoutes {
   1: map<i32,list<Network.NextHopThrift>> mplsRoutes;
 }
 
+/**
+ * Delta of the node's counter map since the previous push on a counters
+ * subscription stream. Counters whose value did not change are omitted.
+ */
+struct CounterUpdate {
+  1: map<string, i64> changedCounters
+  2: list<string> removedCounters
+}
+
 
 /**
  * Thrift service - exposes RPC APIs for interaction with all of Open/R's
@@ -115,6 +124,16 @@ service OpenrCtrl extends fb303_core.BaseService {
   Fib.RouteDatabase getRouteDb()
     throws (1: OpenrError error)
 
+  /**
+   * Paginated variant of getRouteDb. Returns at most maxRoutes routes per
+   * call (a default page size is used when maxRoutes <= 0) together with
+   * an opaque cursor for the next call. Pass an empty cursor to start a
+   * dump; the returned cursor is unset once the dump is complete. Unlike
+   * getRouteDb, server memory stays flat for arbitrarily large tables.
+   */
+  Fib.RouteDatabasePage getRouteDbPaginated(1: string cursor, 2: i32 maxRoutes)
+    throws (1: OpenrError error)
+
   /**
    * Get route database from decision module. Since Decision has global
    * topology information, any node can be retrieved.
@@ -237,6 +256,15 @@ service OpenrCtrl extends fb303_core.BaseService {
     2: string area =  KvStore.kDefaultArea
   ) throws (1: OpenrError error)
 
+  /**
+   * Harvest flood-path traces recorded at this node for sampled keys and
+   * clear the retained buffer. Always empty unless flood-path tracing is
+   * enabled (see KvstoreConfig.flood_trace_sample_rate)
+   */
+  list<KvStore.FloodTraceRecord> getKvStoreFloodTraces(
+    1: string area = KvStore.kDefaultArea
+  ) throws (1: OpenrError error)
+
   /**
    * Set/Update key-values in KvStore.
    */
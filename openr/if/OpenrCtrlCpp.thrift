@@ -8,6 +8,7 @@
 namespace cpp2 openr.thrift
 namespace py3 openr.thrift
 
+include "openr/if/Fib.thrift"
 include "openr/if/KvStore.thrift"
 include "openr/if/OpenrCtrl.thrift"
 
@@ -21,6 +22,37 @@ service OpenrCtrlCpp extends OpenrCtrl.OpenrCtrl {
    */
   stream<KvStore.Publication> subscribeKvStore()
 
+  /**
+   * Subscribe KvStore updates with server side filtering. Only key-vals
+   * matching the given key prefixes or originator IDs (see KeyDumpParams)
+   * and areas are streamed back. Empty filters match everything. Filtering
+   * happens before stream serialization, so unsubscribed content costs the
+   * server neither CPU nor egress.
+   */
+  stream<KvStore.Publication> subscribeKvStoreFiltered(
+    1: KvStore.KeyDumpParams filter,
+    2: set<string> areas,
+  )
+
+  /**
+   * Subscribe counter updates. The server snapshots and diffs the counter
+   * map once per push interval and fans the same delta out to every
+   * subscriber, so scrape cost no longer scales with client count. The
+   * effective cadence is the smallest interval requested across active
+   * subscriptions (clamped to >= 1s). Subscribers attaching while other
+   * subscriptions are active should fetch a baseline via getCounters()
+   * first; otherwise the first push carries the full map.
+   */
+  stream<OpenrCtrl.CounterUpdate> subscribeCounters(1: i64 intervalMs)
+
+  /**
+   * Stream the full route database in bounded pages (see
+   * getRouteDbPaginated), expanded page-by-page from the compact internal
+   * representation. Server memory stays flat during the dump regardless
+   * of table size. The stream completes after the last page.
+   */
+  stream<Fib.RouteDatabasePage> streamRouteDb(1: i32 maxChunkSize)
+
   /**
    * Retrieve KvStore snapshot and as well subscribe subsequent updates. This
    * is useful for mirroring copy of KvStore on remote node for monitoring or
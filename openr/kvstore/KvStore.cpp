@@ -7,23 +7,59 @@
 
 #include "KvStore.h"
 
+#include <iterator>
+#include <limits>
+
 #include <fb303/ServiceData.h>
 #include <fbzmq/service/logging/LogSample.h>
 #include <fbzmq/zmq/Zmq.h>
 #include <folly/Format.h>
 #include <folly/GLog.h>
+#include <folly/compression/Compression.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/hash/Hash.h>
 #include <folly/Random.h>
 #include <folly/String.h>
+#if FOLLY_HAS_COROUTINES
+#include <folly/experimental/coro/Invoke.h>
+#endif
 
 #include <openr/common/Constants.h>
+#include <openr/common/ThriftUtil.h>
 #include <openr/common/Util.h>
+#include <openr/config-store/PersistentStore.h>
 #include <openr/if/gen-cpp2/OpenrCtrl_types.h>
+#include <openr/telemetry/Telemetry.h>
 
 using namespace std::chrono;
 
 namespace fb303 = facebook::fb303;
 
 namespace {
+// per-area key under which warm-boot db snapshots are persisted
+const std::string kDbSnapshotKeyPrefix{"kvstore-snapshot:"};
+
+// below this store size a hash-dump snapshot rebuild is cheaper serial
+// than spread over the worker pool
+constexpr size_t kParallelHashDumpMinKeys{8192};
+
+// patch the previous hash-dump snapshot in place instead of rebuilding it
+// when no more than 1/N-th of the store mutated since it was built
+constexpr size_t kIncrementalHashDumpMaxDirtyFraction{4};
+
+// flood-path tracing bounds: hops recorded per trace and traces retained
+// per area for harvest before the oldest fall off
+constexpr size_t kFloodTraceMaxHops{16};
+constexpr size_t kFloodTraceMaxHarvested{256};
+
+// system-clock nanoseconds since epoch for flood-path trace timestamps
+int64_t
+getUnixTimeStampNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
 std::optional<openr::KvStoreFilters>
 getKvStoreFilters(std::shared_ptr<const openr::Config> config) {
   std::optional<openr::KvStoreFilters> kvFilters{std::nullopt};
@@ -53,6 +89,226 @@ getKvStoreFilters(std::shared_ptr<const openr::Config> config) {
 
 namespace openr {
 
+StringAtom
+StringAtomTable::intern(std::string const& str) {
+  // amortized lazy cleanup: periodically drop atoms whose last outside
+  // reference is gone
+  if (++internsSinceCleanup_ >= kCleanupInterval) {
+    internsSinceCleanup_ = 0;
+    for (auto it = atoms_.begin(); it != atoms_.end();) {
+      it = it->second.expired() ? atoms_.erase(it) : std::next(it);
+    }
+  }
+
+  auto& weakAtom = atoms_[str];
+  if (auto atom = weakAtom.lock()) {
+    return atom;
+  }
+  auto atom = std::make_shared<const std::string>(str);
+  weakAtom = atom;
+  return atom;
+}
+
+TtlCountdownWheel::TtlCountdownWheel()
+    : startTime_(std::chrono::steady_clock::now()) {}
+
+int64_t
+TtlCountdownWheel::tickOf(std::chrono::steady_clock::time_point tp) const {
+  auto deltaMs =
+      std::chrono::duration_cast<std::chrono::milliseconds>(tp - startTime_)
+          .count();
+  deltaMs = std::max<int64_t>(deltaMs, 0);
+  // round up so an entry never expires before its slot is processed
+  return (deltaMs + kTickInterval.count() - 1) / kTickInterval.count();
+}
+
+void
+TtlCountdownWheel::schedule(StringAtom const& key, WheelEntry& wheelEntry) {
+  // wheel horizon in ticks: 256^4
+  constexpr int64_t kHorizon = static_cast<int64_t>(kSlotsPerLevel) *
+      kSlotsPerLevel * kSlotsPerLevel * kSlotsPerLevel;
+
+  // never place entries into the past nor beyond the wheel horizon; far
+  // out entries park on the outermost level and are re-placed when their
+  // slot cascades
+  int64_t expiryTick = tickOf(wheelEntry.entry.expiryTime);
+  expiryTick =
+      std::min(std::max(expiryTick, currentTick_ + 1), currentTick_ + kHorizon);
+
+  const int64_t delta = expiryTick - currentTick_;
+  size_t level{0};
+  int64_t span{static_cast<int64_t>(kSlotsPerLevel)};
+  while (delta > span) {
+    ++level;
+    span *= kSlotsPerLevel;
+  }
+  const int64_t slotWidth = span / static_cast<int64_t>(kSlotsPerLevel);
+  wheelEntry.level = level;
+  wheelEntry.slot =
+      static_cast<size_t>((expiryTick / slotWidth) % kSlotsPerLevel);
+  auto& slotList = slots_[level][wheelEntry.slot];
+  wheelEntry.slotIt = slotList.insert(slotList.end(), key);
+}
+
+void
+TtlCountdownWheel::insertOrUpdate(TtlCountdownQueueEntry entry) {
+  // fast-forward an empty wheel so a long idle period does not force a
+  // tick-by-tick catch-up on the next advance()
+  if (entries_.empty()) {
+    currentTick_ = tickOf(std::chrono::steady_clock::now());
+  }
+
+  auto it = entries_.find(entry.key);
+  if (it != entries_.end()) {
+    // cancel previous incarnation of this key's entry
+    slots_[it->second.level][it->second.slot].erase(it->second.slotIt);
+    it->second.entry = std::move(entry);
+  } else {
+    WheelEntry wheelEntry;
+    auto key = entry.key;
+    wheelEntry.entry = std::move(entry);
+    std::tie(it, std::ignore) = entries_.emplace(key, std::move(wheelEntry));
+  }
+  schedule(it->first, it->second);
+}
+
+std::optional<TtlCountdownQueueEntry>
+TtlCountdownWheel::get(StringAtom const& key) const {
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return std::nullopt;
+  }
+  return it->second.entry;
+}
+
+std::vector<TtlCountdownQueueEntry>
+TtlCountdownWheel::advance(std::chrono::steady_clock::time_point now) {
+  std::vector<TtlCountdownQueueEntry> expired;
+  const int64_t nowTick = tickOf(now);
+  while (currentTick_ < nowTick) {
+    if (entries_.empty()) {
+      currentTick_ = nowTick;
+      break;
+    }
+    ++currentTick_;
+
+    // drain level-0 slot for this tick
+    auto& slotList = slots_[0][currentTick_ % kSlotsPerLevel];
+    for (auto it = slotList.begin(); it != slotList.end();) {
+      auto entryIt = entries_.find(*it);
+      DCHECK(entryIt != entries_.end());
+      if (entryIt->second.entry.expiryTime <= now) {
+        expired.emplace_back(std::move(entryIt->second.entry));
+        it = slotList.erase(it);
+        entries_.erase(entryIt);
+      } else {
+        // entry was parked beyond the wheel horizon; re-place it relative
+        // to the new cursor position
+        it = slotList.erase(it);
+        schedule(entryIt->first, entryIt->second);
+      }
+    }
+
+    // cascade outer levels into inner ones whenever an inner wheel wraps
+    int64_t slotWidth = kSlotsPerLevel;
+    for (size_t level = 1;
+         level < kNumLevels and currentTick_ % slotWidth == 0;
+         ++level, slotWidth *= kSlotsPerLevel) {
+      auto& cascadeList =
+          slots_[level][(currentTick_ / slotWidth) % kSlotsPerLevel];
+      while (not cascadeList.empty()) {
+        auto key = cascadeList.front();
+        cascadeList.pop_front();
+        auto entryIt = entries_.find(key);
+        DCHECK(entryIt != entries_.end());
+        schedule(entryIt->first, entryIt->second);
+      }
+    }
+  }
+  return expired;
+}
+
+std::optional<std::chrono::steady_clock::time_point>
+TtlCountdownWheel::nextWakeup() const {
+  if (entries_.empty()) {
+    return std::nullopt;
+  }
+  // scan level-0 for the next occupied slot within one wheel rotation; fall
+  // back to a full rotation which forces outer levels to cascade inwards
+  for (int64_t tick = currentTick_ + 1;
+       tick <= currentTick_ + static_cast<int64_t>(kSlotsPerLevel);
+       ++tick) {
+    if (not slots_[0][tick % kSlotsPerLevel].empty()) {
+      return startTime_ + tick * kTickInterval;
+    }
+  }
+  return startTime_ +
+      (currentTick_ + static_cast<int64_t>(kSlotsPerLevel)) * kTickInterval;
+}
+
+void
+KvStoreHashTree::update(
+    std::string const& key,
+    std::optional<int64_t> oldHash,
+    std::optional<int64_t> newHash) {
+  const auto idx = bucketIndex(key);
+  auto& bucket = buckets_[idx];
+
+  // XOR out the bucket's old contribution towards root, fold the entry
+  // mutation into the bucket and XOR the new contribution back in
+  rootHash_ ^= folly::hash::hash_combine(idx, bucket);
+  if (oldHash.has_value()) {
+    bucket ^= entryHash(key, oldHash.value());
+  }
+  if (newHash.has_value()) {
+    bucket ^= entryHash(key, newHash.value());
+  }
+  rootHash_ ^= folly::hash::hash_combine(idx, bucket);
+}
+
+int64_t
+KvStoreHashTree::rootHash() const {
+  return rootHash_;
+}
+
+std::unordered_map<int32_t, int64_t>
+KvStoreHashTree::bucketHashes() const {
+  std::unordered_map<int32_t, int64_t> hashes;
+  for (int32_t idx = 0; idx < kNumBuckets; ++idx) {
+    if (buckets_[idx] != 0) {
+      hashes.emplace(idx, buckets_[idx]);
+    }
+  }
+  return hashes;
+}
+
+std::unordered_set<int32_t>
+KvStoreHashTree::diffBuckets(
+    std::unordered_map<int32_t, int64_t> const& peerBucketHashes) const {
+  std::unordered_set<int32_t> divergedBuckets;
+  for (int32_t idx = 0; idx < kNumBuckets; ++idx) {
+    int64_t peerHash{0};
+    auto it = peerBucketHashes.find(idx);
+    if (it != peerBucketHashes.end()) {
+      peerHash = it->second;
+    }
+    if (buckets_[idx] != peerHash) {
+      divergedBuckets.emplace(idx);
+    }
+  }
+  return divergedBuckets;
+}
+
+int32_t
+KvStoreHashTree::bucketIndex(std::string const& key) {
+  return static_cast<int32_t>(std::hash<std::string>()(key) % kNumBuckets);
+}
+
+int64_t
+KvStoreHashTree::entryHash(std::string const& key, int64_t valueHash) {
+  return static_cast<int64_t>(folly::hash::hash_combine(key, valueHash));
+}
+
 KvStoreFilters::KvStoreFilters(
     std::vector<std::string> const& keyPrefix,
     std::set<std::string> const& nodeIds)
@@ -75,6 +331,20 @@ KvStoreFilters::keyMatch(
   return false;
 }
 
+bool
+KvStoreFilters::keyPrefixMatch(std::string const& key) const {
+  if (keyPrefixList_.empty()) {
+    return true;
+  }
+  return keyPrefixObjList_.keyMatch(key);
+}
+
+bool
+KvStoreFilters::isPlainPrefixMatch() const {
+  return originatorIds_.empty() and not keyPrefixList_.empty() and
+      keyPrefixObjList_.isLiteralOnly();
+}
+
 std::vector<std::string>
 KvStoreFilters::getKeyPrefixes() const {
   return keyPrefixList_;
@@ -111,7 +381,8 @@ KvStore::KvStore(
     // initializer for mutable state
     std::unordered_map<std::string, thrift::PeerSpec> peers,
     int zmqHwm,
-    bool enableKvStoreThrift)
+    bool enableKvStoreThrift,
+    PersistentStore* configStore)
     : kvParams_(
           config->getNodeName(),
           kvStoreUpdatesQueue,
@@ -136,6 +407,53 @@ KvStore::KvStore(
   zmqMonitorClient_ =
       std::make_shared<fbzmq::ZmqMonitorClient>(zmqContext, monitorSubmitUrl);
   kvParams_.zmqMonitorClient = zmqMonitorClient_;
+  kvParams_.eventLogger = std::make_shared<EventLogger>(zmqMonitorClient_);
+
+  if (auto floodCoalesceWindow =
+          config->getKvStoreConfig().flood_coalesce_window_ms_ref()) {
+    kvParams_.floodCoalesceWindow =
+        std::chrono::milliseconds(*floodCoalesceWindow);
+  }
+
+  if (auto traceSampleRate =
+          config->getKvStoreConfig().flood_trace_sample_rate_ref()) {
+    if (*traceSampleRate > 0) {
+      kvParams_.floodTraceSampleRate = static_cast<uint32_t>(*traceSampleRate);
+    }
+  }
+
+  if (auto priorityPrefixes =
+          config->getKvStoreConfig().flood_priority_key_prefixes_ref()) {
+    kvParams_.floodPriorityFilters = KvStoreFilters(
+        std::vector<std::string>(
+            priorityPrefixes->begin(), priorityPrefixes->end()),
+        std::set<std::string>{} /* no originator-id filters */);
+  }
+
+  // worker pool for parallel hash-dump snapshot rebuilds, shared across
+  // all areas (each area only rebuilds from its own event base)
+  kvParams_.hashDumpExecutor = std::make_shared<folly::CPUThreadPoolExecutor>(
+      2 /* threads */,
+      std::make_shared<folly::NamedThreadFactory>("KvStoreHashDump"));
+
+  // once every area finishes its initial full-sync, publish a flagged
+  // (otherwise empty) publication so downstream modules (e.g. Decision)
+  // can end their cold-start hold early instead of waiting out a timer
+  kvParams_.initialSyncDoneCallback = [this](std::string const& area) {
+    LOG(INFO) << "Initial full-sync completed for area " << area;
+    if (numAreasInitialSynced_.fetch_add(1) + 1 == areas_.size()) {
+      thrift::Publication signalPub;
+      signalPub.initialSyncComplete_ref() = true;
+      kvParams_.kvStoreUpdatesQueue.push(std::move(signalPub));
+    }
+  };
+
+  // warm-boot snapshots need both a store to persist into and an interval
+  kvParams_.configStore = configStore;
+  if (auto snapshotInterval =
+          config->getKvStoreConfig().snapshot_interval_s_ref()) {
+    kvParams_.snapshotInterval = std::chrono::seconds(*snapshotInterval);
+  }
 
   // Schedule periodic timer for counters submission
   counterUpdateTimer_ = folly::AsyncTimeout::make(*getEvb(), [this]() noexcept {
@@ -191,40 +509,115 @@ KvStore::KvStore(
     }
   });
 
+  // spin up one worker event base per area if parallel area processing is
+  // enabled. With a single area there is nothing to parallelize
+  if (config->getKvStoreConfig().enable_parallel_areas_ref().value_or(false) and
+      areas_.size() > 1) {
+    for (auto const& area : areas_) {
+      auto evb = std::make_unique<OpenrEventBase>();
+      areaEvbThreads_.emplace_back([evbPtr = evb.get(), area]() noexcept {
+        LOG(INFO) << "Starting KvStoreDb thread for area " << area;
+        evbPtr->run();
+        LOG(INFO) << "KvStoreDb thread for area " << area << " got stopped";
+      });
+      evb->waitUntilRunning();
+      areaEvbs_.emplace(area, std::move(evb));
+    }
+  }
+
   // create KvStoreDb instances
   for (auto const& area : areas_) {
-    kvStoreDb_.emplace(
-        std::piecewise_construct,
-        std::forward_as_tuple(area),
-        std::forward_as_tuple(
-            this,
-            kvParams_,
-            area,
-            fbzmq::Socket<ZMQ_ROUTER, fbzmq::ZMQ_CLIENT>(
-                zmqContext,
-                fbzmq::IdentityString{
-                    createPeerSyncId(config->getNodeName(), area)},
-                folly::none,
-                fbzmq::NonblockingFlag{true}),
-            config->getKvStoreConfig().is_flood_root_ref().value_or(false),
-            config->getNodeName(),
-            peers));
+    auto areaEvbIt = areaEvbs_.find(area);
+    OpenrEventBase* dbEvb =
+        areaEvbIt == areaEvbs_.end() ? this : areaEvbIt->second.get();
+
+    auto createKvStoreDb = [&]() {
+      kvStoreDb_.emplace(
+          std::piecewise_construct,
+          std::forward_as_tuple(area),
+          std::forward_as_tuple(
+              dbEvb,
+              kvParams_,
+              area,
+              fbzmq::Socket<ZMQ_ROUTER, fbzmq::ZMQ_CLIENT>(
+                  zmqContext,
+                  fbzmq::IdentityString{
+                      createPeerSyncId(config->getNodeName(), area)},
+                  folly::none,
+                  fbzmq::NonblockingFlag{true}),
+              config->getKvStoreConfig().is_flood_root_ref().value_or(false),
+              config->getNodeName(),
+              peers));
+    };
+
+    if (areaEvbIt == areaEvbs_.end()) {
+      createKvStoreDb();
+    } else {
+      // construct the instance on its owning thread so sockets and timers
+      // attach to the right event base. Construction is sequential, hence
+      // kvStoreDb_ is never mutated concurrently and is read-only once all
+      // instances exist
+      folly::Promise<folly::Unit> p;
+      auto sf = p.getSemiFuture();
+      areaEvbIt->second->runInEventBaseThread([&]() mutable {
+        createKvStoreDb();
+        p.setValue();
+      });
+      std::move(sf).get();
+    }
   }
 }
 
-// static, public
+void
+KvStore::stop() {
+  // stop and join per-area workers before stopping self
+  for (auto& areaEvb : areaEvbs_) {
+    areaEvb.second->stop();
+    areaEvb.second->waitUntilStopped();
+  }
+  for (auto& thread : areaEvbThreads_) {
+    thread.join();
+  }
+  OpenrEventBase::stop();
+}
+
+void
+KvStore::runInAreaThread(
+    std::string const& area, folly::EventBase::Func callback) {
+  auto it = areaEvbs_.find(area);
+  if (it == areaEvbs_.end()) {
+    runInEventBaseThread(std::move(callback));
+  } else {
+    it->second->runInEventBaseThread(std::move(callback));
+  }
+}
+
+namespace {
+
+// Shared implementation of KvStore::mergeKeyValues(). When `keyVals` is
+// passed by non-const reference (rvalue overload) winning values are moved
+// into the store instead of copied, sparing one value-blob allocation per
+// updated key - full syncs merge the whole dump with a single copy per key
+// (the flooded delta) and the received publication's heap is released in one
+// shot when it goes out of scope. Templated on the store container so the
+// F14-backed KvStoreDb database and plain std::unordered_map callers (e.g.
+// the multi-instance dump helpers) share one implementation.
+template <typename StoreT, typename KeyValsT>
 std::unordered_map<std::string, thrift::Value>
-KvStore::mergeKeyValues(
-    std::unordered_map<std::string, thrift::Value>& kvStore,
-    std::unordered_map<std::string, thrift::Value> const& keyVals,
+mergeKeyValuesImpl(
+    StoreT& kvStore,
+    KeyValsT&& keyVals,
     std::optional<KvStoreFilters> const& filters) {
+  constexpr bool kMoveValues =
+      not std::is_const_v<std::remove_reference_t<KeyValsT>>;
+
   // the publication to build if we update our KV store
   std::unordered_map<std::string, thrift::Value> kvUpdates;
 
   // Counters for logging
   uint32_t ttlUpdateCnt{0}, valUpdateCnt{0};
 
-  for (const auto& [key, value] : keyVals) {
+  for (auto&& [key, value] : keyVals) {
     if (filters.has_value() && not filters->keyMatch(key, value)) {
       VLOG(4) << "key: " << key << " not adding from " << value.originatorId;
       continue;
@@ -316,8 +709,9 @@ KvStore::mergeKeyValues(
             << (kvStoreIt != kvStore.end() ? kvStoreIt->second.ttl : 0)
             << " -> " << value.ttl;
 
-    // grab the new value (this will copy, intended)
-    thrift::Value newValue = value;
+    // announce the update. Grabbed before the value is possibly handed over
+    // to the store below
+    kvUpdates.emplace(key, value);
 
     if (updateAllNeeded) {
       ++valUpdateCnt;
@@ -329,6 +723,15 @@ KvStore::mergeKeyValues(
       // update everything for such key
       //
       CHECK(value.value_ref().has_value());
+
+      // grab the new value (copy unless the caller handed over ownership)
+      thrift::Value newValue;
+      if constexpr (kMoveValues) {
+        newValue = std::move(value);
+      } else {
+        newValue = value;
+      }
+
       if (kvStoreIt == kvStore.end()) {
         // create new entry
         std::tie(kvStoreIt, std::ignore) = kvStore.emplace(
@@ -339,10 +742,13 @@ KvStore::mergeKeyValues(
         // update the entry in place, the old value will be destructed
         kvStoreIt->second = std::move(newValue);
       }
-      // update hash if it's not there
+      // update hash if it's not there. Use the stored entry - `value` may
+      // have been consumed above
       if (not kvStoreIt->second.hash_ref().has_value()) {
-        kvStoreIt->second.hash_ref() =
-            generateHash(value.version, value.originatorId, value.value_ref());
+        kvStoreIt->second.hash_ref() = generateHash(
+            kvStoreIt->second.version,
+            kvStoreIt->second.originatorId,
+            kvStoreIt->second.value_ref());
       }
     } else if (updateTtlNeeded) {
       ++ttlUpdateCnt;
@@ -355,9 +761,6 @@ KvStore::mergeKeyValues(
       kvStoreIt->second.ttl = value.ttl;
       kvStoreIt->second.ttlVersion = value.ttlVersion;
     }
-
-    // announce the update
-    kvUpdates.emplace(key, value);
   }
 
   VLOG(4) << "(mergeKeyValues) updating " << kvUpdates.size()
@@ -366,6 +769,44 @@ KvStore::mergeKeyValues(
   return kvUpdates;
 }
 
+} // namespace
+
+// static, public
+std::unordered_map<std::string, thrift::Value>
+KvStore::mergeKeyValues(
+    std::unordered_map<std::string, thrift::Value>& kvStore,
+    std::unordered_map<std::string, thrift::Value> const& keyVals,
+    std::optional<KvStoreFilters> const& filters) {
+  return mergeKeyValuesImpl(kvStore, keyVals, filters);
+}
+
+// static, public
+std::unordered_map<std::string, thrift::Value>
+KvStore::mergeKeyValues(
+    std::unordered_map<std::string, thrift::Value>& kvStore,
+    std::unordered_map<std::string, thrift::Value>&& keyVals,
+    std::optional<KvStoreFilters> const& filters) {
+  return mergeKeyValuesImpl(kvStore, std::move(keyVals), filters);
+}
+
+// static, public
+std::unordered_map<std::string, thrift::Value>
+KvStore::mergeKeyValues(
+    KvStoreDatabase& kvStore,
+    std::unordered_map<std::string, thrift::Value> const& keyVals,
+    std::optional<KvStoreFilters> const& filters) {
+  return mergeKeyValuesImpl(kvStore, keyVals, filters);
+}
+
+// static, public
+std::unordered_map<std::string, thrift::Value>
+KvStore::mergeKeyValues(
+    KvStoreDatabase& kvStore,
+    std::unordered_map<std::string, thrift::Value>&& keyVals,
+    std::optional<KvStoreFilters> const& filters) {
+  return mergeKeyValuesImpl(kvStore, std::move(keyVals), filters);
+}
+
 /**
  * Compare two values to find out which value is better
  */
@@ -489,7 +930,21 @@ KvStore::processRequestMsg(
   VLOG(2) << "Request received for area " << area;
   try {
     auto& kvStoreDb = kvStoreDb_.at(area);
-    auto response = kvStoreDb.processRequestMsgHelper(requestId, thriftRequest);
+    folly::Expected<fbzmq::Message, fbzmq::Error> response =
+        folly::makeUnexpected(fbzmq::Error());
+    auto areaEvbIt = areaEvbs_.find(area);
+    if (areaEvbIt == areaEvbs_.end()) {
+      response = kvStoreDb.processRequestMsgHelper(requestId, thriftRequest);
+    } else {
+      // process on the area's owning thread; reply is still sent from this
+      // thread which owns globalCmdSock
+      folly::Promise<folly::Expected<fbzmq::Message, fbzmq::Error>> p;
+      auto sf = p.getSemiFuture();
+      areaEvbIt->second->runInEventBaseThread([&]() mutable {
+        p.setValue(kvStoreDb.processRequestMsgHelper(requestId, thriftRequest));
+      });
+      response = std::move(sf).get();
+    }
     if (response.hasValue()) {
       fb303::fbData->addStatValue(
           "kvstore.peers.bytes_sent", response->size(), fb303::SUM);
@@ -510,13 +965,63 @@ KvStore::getKvStoreUpdatesReader() {
 
 void
 KvStore::processPeerUpdates(thrift::PeerUpdateRequest&& req) {
-  // Req can contain peerAdd/peerDel simultaneously
-  if (req.peerAddParams_ref().has_value()) {
-    addUpdateKvStorePeers(req.peerAddParams_ref().value(), req.area).get();
+  std::vector<folly::SemiFuture<folly::Unit>> futures;
+
+  if (req.areaUpdates_ref().has_value()) {
+    // Batched request - kick off every area's section in one pass
+    for (auto& update : req.areaUpdates_ref().value()) {
+      if (update.second.peerAddParams_ref().has_value()) {
+        futures.emplace_back(addUpdateKvStorePeers(
+            std::move(update.second.peerAddParams_ref().value()),
+            update.first));
+      }
+      if (update.second.peerDelParams_ref().has_value()) {
+        futures.emplace_back(deleteKvStorePeers(
+            std::move(update.second.peerDelParams_ref().value()),
+            update.first));
+      }
+    }
+  } else {
+    // Req can contain peerAdd/peerDel simultaneously
+    if (req.peerAddParams_ref().has_value()) {
+      futures.emplace_back(
+          addUpdateKvStorePeers(req.peerAddParams_ref().value(), req.area));
+    }
+    if (req.peerDelParams_ref().has_value()) {
+      futures.emplace_back(
+          deleteKvStorePeers(req.peerDelParams_ref().value(), req.area));
+    }
   }
-  if (req.peerDelParams_ref().has_value()) {
-    deleteKvStorePeers(req.peerDelParams_ref().value(), req.area).get();
+
+  // Log failures asynchronously instead of awaiting each area in turn. The
+  // per-area work itself is already dispatched at this point
+  folly::collectAll(std::move(futures))
+      .via(getEvb())
+      .thenValue([](std::vector<folly::Try<folly::Unit>>&& results) {
+        for (auto& result : results) {
+          if (result.hasException()) {
+            LOG(ERROR) << "Failed to process peer update. Exception: "
+                       << folly::exceptionStr(result.exception());
+          }
+        }
+      });
+}
+
+std::unique_ptr<thrift::Publication>
+KvStore::getKvStoreKeyValsImpl(
+    thrift::KeyGetParams const& keyGetParams, std::string const& area) {
+  VLOG(3) << "Get key requested for AREA: " << area;
+
+  if (!kvStoreDb_.count(area)) {
+    throw thrift::OpenrError(folly::sformat("Invalid area: {}", area));
   }
+  fb303::fbData->addStatValue("kvstore.cmd_key_get", 1, fb303::COUNT);
+
+  auto& kvStoreDb = kvStoreDb_.at(area);
+  auto thriftPub = kvStoreDb.getKeyVals(keyGetParams.keys);
+  kvStoreDb.updatePublicationTtl(thriftPub);
+
+  return std::make_unique<thrift::Publication>(std::move(thriftPub));
 }
 
 folly::SemiFuture<std::unique_ptr<thrift::Publication>>
@@ -524,105 +1029,161 @@ KvStore::getKvStoreKeyVals(
     thrift::KeyGetParams keyGetParams, std::string area) {
   folly::Promise<std::unique_ptr<thrift::Publication>> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this,
-                        p = std::move(p),
-                        keyGetParams = std::move(keyGetParams),
-                        area]() mutable {
-    VLOG(3) << "Get key requested for AREA: " << area;
-
-    if (!kvStoreDb_.count(area)) {
-      p.setException(
-          thrift::OpenrError(folly::sformat("Invalid area: {}", area)));
-    } else {
-      fb303::fbData->addStatValue("kvstore.cmd_key_get", 1, fb303::COUNT);
-
-      auto& kvStoreDb = kvStoreDb_.at(area);
-      auto thriftPub = kvStoreDb.getKeyVals(keyGetParams.keys);
-      kvStoreDb.updatePublicationTtl(thriftPub);
-
-      p.setValue(std::make_unique<thrift::Publication>(std::move(thriftPub)));
-    }
-  });
+  runInAreaThread(
+      area,
+      [this,
+       p = std::move(p),
+       keyGetParams = std::move(keyGetParams),
+       area]() mutable {
+        p.setWith([&]() { return getKvStoreKeyValsImpl(keyGetParams, area); });
+      });
   return sf;
 }
 
+#if FOLLY_HAS_COROUTINES
+folly::coro::Task<std::unique_ptr<thrift::Publication>>
+KvStore::getKvStoreKeyValsCoro(
+    thrift::KeyGetParams keyGetParams, std::string area) {
+  // hop onto the area's event base as a plain coroutine frame; areaEvbs_
+  // is immutable once the constructor returns, so it is safe to read here
+  auto it = areaEvbs_.find(area);
+  auto* evb = it == areaEvbs_.end() ? getEvb() : it->second->getEvb();
+  co_return co_await folly::coro::co_invoke(
+      [this, keyGetParams = std::move(keyGetParams), area = std::move(area)]()
+          -> folly::coro::Task<std::unique_ptr<thrift::Publication>> {
+        co_return getKvStoreKeyValsImpl(keyGetParams, area);
+      })
+      .scheduleOn(evb);
+}
+#endif
+
 folly::SemiFuture<std::unique_ptr<thrift::Publication>>
 KvStore::dumpKvStoreKeys(
     thrift::KeyDumpParams keyDumpParams, std::string area) {
   folly::Promise<std::unique_ptr<thrift::Publication>> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this,
-                        p = std::move(p),
-                        keyDumpParams = std::move(keyDumpParams),
-                        area]() mutable {
-    VLOG(3) << "Dump all keys requested for AREA: " << area;
-
-    if (!kvStoreDb_.count(area)) {
-      p.setException(
-          thrift::OpenrError(folly::sformat("Invalid area: {}", area)));
-    } else {
-      fb303::fbData->addStatValue("kvstore.cmd_key_dump", 1, fb303::COUNT);
-
-      auto& kvStoreDb = kvStoreDb_.at(area);
-      std::vector<std::string> keyPrefixList;
-      folly::split(",", keyDumpParams.prefix, keyPrefixList, true);
-      const auto keyPrefixMatch =
-          KvStoreFilters(keyPrefixList, keyDumpParams.originatorIds);
-      auto thriftPub = kvStoreDb.dumpAllWithFilters(keyPrefixMatch);
-      if (keyDumpParams.keyValHashes_ref().has_value()) {
-        thriftPub = kvStoreDb.dumpDifference(
-            thriftPub.keyVals, keyDumpParams.keyValHashes_ref().value());
-      }
-      kvStoreDb.updatePublicationTtl(thriftPub);
-      // I'm the initiator, set flood-root-id
-      fromStdOptional(thriftPub.floodRootId_ref(), kvStoreDb.getSptRootId());
-
-      if (keyDumpParams.keyValHashes_ref().has_value() and
-          keyDumpParams.prefix.empty()) {
-        // This usually comes from neighbor nodes
-        size_t numMissingKeys = 0;
-        if (thriftPub.tobeUpdatedKeys_ref().has_value()) {
-          numMissingKeys = thriftPub.tobeUpdatedKeys_ref()->size();
+  runInAreaThread(
+      area,
+      [this,
+       p = std::move(p),
+       keyDumpParams = std::move(keyDumpParams),
+       area]() mutable {
+        VLOG(3) << "Dump all keys requested for AREA: " << area;
+
+        if (!kvStoreDb_.count(area)) {
+          p.setException(
+              thrift::OpenrError(folly::sformat("Invalid area: {}", area)));
+        } else {
+          fb303::fbData->addStatValue("kvstore.cmd_key_dump", 1, fb303::COUNT);
+
+          auto& kvStoreDb = kvStoreDb_.at(area);
+          std::vector<std::string> keyPrefixList;
+          folly::split(",", keyDumpParams.prefix, keyPrefixList, true);
+          const auto keyPrefixMatch =
+              KvStoreFilters(keyPrefixList, keyDumpParams.originatorIds);
+          // ttls are fixed up inline while dumping; dumpDifference below
+          // only selects a subset so no second ttl pass is needed
+          auto thriftPub = kvStoreDb.dumpAllWithFilters(
+              keyPrefixMatch,
+              true /* ttl */,
+              keyDumpParams.startKey_ref().to_optional(),
+              keyDumpParams.maxKeys_ref().to_optional());
+          kvStoreDb.pruneUnchangedHashTreeBuckets(thriftPub, keyDumpParams);
+          if (keyDumpParams.keyValHashes_ref().has_value()) {
+            // dumpDifference builds a fresh publication - carry the range
+            // cursor of the dump over to it
+            const auto nextKey = thriftPub.nextKey_ref().to_optional();
+            thriftPub = kvStoreDb.dumpDifference(
+                thriftPub.keyVals, keyDumpParams.keyValHashes_ref().value());
+            fromStdOptional(thriftPub.nextKey_ref(), nextKey);
+          }
+          if (auto sinceSeq = keyDumpParams.sinceSeq_ref()) {
+            // Incremental dump - only return content newer than the
+            // client's cursor and stamp the new cursor
+            kvStoreDb.filterPublicationBySeq(thriftPub, *sinceSeq);
+          } else {
+            // stamp the current cursor so the client can come back for
+            // just the tail after a short disconnect
+            thriftPub.updateSeq_ref() = kvStoreDb.getUpdateSeq();
+          }
+          // I'm the initiator, set flood-root-id
+          fromStdOptional(
+              thriftPub.floodRootId_ref(), kvStoreDb.getSptRootId());
+
+          if (keyDumpParams.keyValHashes_ref().has_value() and
+              keyDumpParams.prefix.empty()) {
+            // This usually comes from neighbor nodes
+            size_t numMissingKeys = 0;
+            if (thriftPub.tobeUpdatedKeys_ref().has_value()) {
+              numMissingKeys = thriftPub.tobeUpdatedKeys_ref()->size();
+            }
+            LOG(INFO) << "Processed full-sync request with "
+                      << keyDumpParams.keyValHashes_ref().value().size()
+                      << " keyValHashes item(s). Sending "
+                      << thriftPub.keyVals.size() << " key-vals and "
+                      << numMissingKeys << " missing keys";
+          }
+          p.setValue(
+              std::make_unique<thrift::Publication>(std::move(thriftPub)));
         }
-        LOG(INFO) << "Processed full-sync request with "
-                  << keyDumpParams.keyValHashes_ref().value().size()
-                  << " keyValHashes item(s). Sending "
-                  << thriftPub.keyVals.size() << " key-vals and "
-                  << numMissingKeys << " missing keys";
-      }
-      p.setValue(std::make_unique<thrift::Publication>(std::move(thriftPub)));
-    }
-  });
+      });
   return sf;
 }
 
 folly::SemiFuture<std::unique_ptr<thrift::Publication>>
 KvStore::dumpKvStoreHashes(
     thrift::KeyDumpParams keyDumpParams, std::string area) {
+  // unfiltered hash dumps (the full-sync fallback and the common case)
+  // are served from the per-area copy-on-write snapshot: only the
+  // snapshot grab runs on the area thread; the per-client copy happens
+  // wherever the returned semifuture is consumed
+  if (keyDumpParams.prefix.empty()) {
+    folly::Promise<std::shared_ptr<const thrift::Publication>> p;
+    auto sf = p.getSemiFuture();
+    runInAreaThread(area, [this, p = std::move(p), area]() mutable {
+      VLOG(3) << "Dump all hashes requested for AREA: " << area;
+
+      if (!kvStoreDb_.count(area)) {
+        p.setException(
+            thrift::OpenrError(folly::sformat("Invalid area: {}", area)));
+      } else {
+        fb303::fbData->addStatValue("kvstore.cmd_hash_dump", 1, fb303::COUNT);
+        p.setValue(kvStoreDb_.at(area).getHashDumpSnapshot());
+      }
+    });
+    return std::move(sf).deferValue(
+        [](std::shared_ptr<const thrift::Publication>&& snapshot) {
+          return std::make_unique<thrift::Publication>(*snapshot);
+        });
+  }
+
   folly::Promise<std::unique_ptr<thrift::Publication>> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this,
-                        p = std::move(p),
-                        keyDumpParams = std::move(keyDumpParams),
-                        area]() mutable {
-    VLOG(3) << "Dump all hashes requested for AREA: " << area;
-
-    if (!kvStoreDb_.count(area)) {
-      p.setException(
-          thrift::OpenrError(folly::sformat("Invalid area: {}", area)));
-    } else {
-      fb303::fbData->addStatValue("kvstore.cmd_hash_dump", 1, fb303::COUNT);
-
-      auto& kvStoreDb = kvStoreDb_.at(area);
-      std::set<std::string> originator{};
-      std::vector<std::string> keyPrefixList{};
-      folly::split(",", keyDumpParams.prefix, keyPrefixList, true);
-      KvStoreFilters kvFilters{keyPrefixList, originator};
-      auto thriftPub = kvStoreDb.dumpHashWithFilters(kvFilters);
-      kvStoreDb.updatePublicationTtl(thriftPub);
-      p.setValue(std::make_unique<thrift::Publication>(std::move(thriftPub)));
-    }
-  });
+  runInAreaThread(
+      area,
+      [this,
+       p = std::move(p),
+       keyDumpParams = std::move(keyDumpParams),
+       area]() mutable {
+        VLOG(3) << "Dump all hashes requested for AREA: " << area;
+
+        if (!kvStoreDb_.count(area)) {
+          p.setException(
+              thrift::OpenrError(folly::sformat("Invalid area: {}", area)));
+        } else {
+          fb303::fbData->addStatValue("kvstore.cmd_hash_dump", 1, fb303::COUNT);
+
+          auto& kvStoreDb = kvStoreDb_.at(area);
+          std::set<std::string> originator{};
+          std::vector<std::string> keyPrefixList{};
+          folly::split(",", keyDumpParams.prefix, keyPrefixList, true);
+          KvStoreFilters kvFilters{keyPrefixList, originator};
+          auto thriftPub = kvStoreDb.dumpHashWithFilters(kvFilters);
+          kvStoreDb.updatePublicationTtl(thriftPub);
+          p.setValue(
+              std::make_unique<thrift::Publication>(std::move(thriftPub)));
+        }
+      });
   return sf;
 }
 
@@ -631,49 +1192,64 @@ KvStore::setKvStoreKeyVals(
     thrift::KeySetParams keySetParams, std::string area) {
   folly::Promise<folly::Unit> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this,
-                        p = std::move(p),
-                        keySetParams = std::move(keySetParams),
-                        area]() mutable {
-    VLOG(3) << "Set key requested for AREA: " << area;
-
-    if (!kvStoreDb_.count(area)) {
-      p.setException(
-          thrift::OpenrError(folly::sformat("Invalid area: {}", area)));
-    } else {
-      // Update statistics
-      fb303::fbData->addStatValue("kvstore.cmd_key_set", 1, fb303::COUNT);
-      if (keySetParams.timestamp_ms_ref().has_value()) {
-        auto floodMs =
-            getUnixTimeStampMs() - keySetParams.timestamp_ms_ref().value();
-        if (floodMs > 0) {
-          fb303::fbData->addStatValue(
-              "kvstore.flood_duration_ms", floodMs, fb303::AVG);
-        }
-      }
+  runInAreaThread(
+      area,
+      [this,
+       p = std::move(p),
+       keySetParams = std::move(keySetParams),
+       area]() mutable {
+        VLOG(3) << "Set key requested for AREA: " << area;
+
+        if (!kvStoreDb_.count(area)) {
+          p.setException(
+              thrift::OpenrError(folly::sformat("Invalid area: {}", area)));
+        } else {
+          // Update statistics
+          fb303::fbData->addStatValue("kvstore.cmd_key_set", 1, fb303::COUNT);
+          if (keySetParams.timestamp_ms_ref().has_value()) {
+            auto floodMs =
+                getUnixTimeStampMs() - keySetParams.timestamp_ms_ref().value();
+            if (floodMs > 0) {
+              fb303::fbData->addStatValue(
+                  "kvstore.flood_duration_ms", floodMs, fb303::AVG);
+            }
+          }
 
-      // Update hash for key-values
-      auto& kvStoreDb = kvStoreDb_.at(area);
-      for (auto& kv : keySetParams.keyVals) {
-        auto& value = kv.second;
-        if (value.value_ref().has_value()) {
-          value.hash_ref() = generateHash(
-              value.version, value.originatorId, value.value_ref());
-        }
-      }
+          // Update hash for key-values
+          auto& kvStoreDb = kvStoreDb_.at(area);
+          for (auto& kv : keySetParams.keyVals) {
+            auto& value = kv.second;
+            if (value.value_ref().has_value()) {
+              value.hash_ref() = generateHash(
+                  value.version, value.originatorId, value.value_ref());
+            }
+          }
 
-      // Create publication and merge it with local KvStore
-      thrift::Publication rcvdPublication;
-      rcvdPublication.keyVals = std::move(keySetParams.keyVals);
-      rcvdPublication.nodeIds_ref().move_from(keySetParams.nodeIds_ref());
-      rcvdPublication.floodRootId_ref().move_from(
-          keySetParams.floodRootId_ref());
-      kvStoreDb.mergePublication(rcvdPublication);
+          // Create publication and merge it with local KvStore
+          thrift::Publication rcvdPublication;
+          rcvdPublication.keyVals = std::move(keySetParams.keyVals);
+          rcvdPublication.nodeIds_ref().move_from(keySetParams.nodeIds_ref());
+          rcvdPublication.floodRootId_ref().move_from(
+              keySetParams.floodRootId_ref());
+          rcvdPublication.hopTraces_ref().move_from(
+              keySetParams.hopTraces_ref());
+
+          // pipelined floods carry per-sender sequencing - apply those in
+          // send order via the reordering buffer
+          if (keySetParams.senderId_ref().has_value() and
+              keySetParams.floodSeqNum_ref().has_value()) {
+            kvStoreDb.mergeOrderedPublication(
+                keySetParams.senderId_ref().value(),
+                keySetParams.floodSeqNum_ref().value(),
+                std::move(rcvdPublication));
+          } else {
+            kvStoreDb.mergePublication(rcvdPublication);
+          }
 
-      // ready to return
-      p.setValue();
-    }
-  });
+          // ready to return
+          p.setValue();
+        }
+      });
   return sf;
 }
 
@@ -693,7 +1269,7 @@ folly::SemiFuture<std::unique_ptr<thrift::PeersMap>>
 KvStore::getKvStorePeers(std::string area) {
   folly::Promise<std::unique_ptr<thrift::PeersMap>> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this, p = std::move(p), area]() mutable {
+  runInAreaThread(area, [this, p = std::move(p), area]() mutable {
     VLOG(2) << "Peer dump requested for AREA: " << area;
 
     if (!kvStoreDb_.count(area)) {
@@ -714,25 +1290,27 @@ KvStore::addUpdateKvStorePeers(
     thrift::PeerAddParams peerAddParams, std::string area) {
   folly::Promise<folly::Unit> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this,
-                        p = std::move(p),
-                        peerAddParams = std::move(peerAddParams),
-                        area]() mutable {
-    VLOG(2) << "Peer addition requested for AREA: " << area;
-
-    if (!kvStoreDb_.count(area)) {
-      p.setException(
-          thrift::OpenrError(folly::sformat("Invalid area: {}", area)));
-    } else if (peerAddParams.peers.empty()) {
-      p.setException(thrift::OpenrError(
-          "Empty peerNames from peer-add request, ignoring"));
-    } else {
-      fb303::fbData->addStatValue("kvstore.cmd_peer_add", 1, fb303::COUNT);
-      auto& kvStoreDb = kvStoreDb_.at(area);
-      kvStoreDb.addPeers(peerAddParams.peers);
-      p.setValue();
-    }
-  });
+  runInAreaThread(
+      area,
+      [this,
+       p = std::move(p),
+       peerAddParams = std::move(peerAddParams),
+       area]() mutable {
+        VLOG(2) << "Peer addition requested for AREA: " << area;
+
+        if (!kvStoreDb_.count(area)) {
+          p.setException(
+              thrift::OpenrError(folly::sformat("Invalid area: {}", area)));
+        } else if (peerAddParams.peers.empty()) {
+          p.setException(thrift::OpenrError(
+              "Empty peerNames from peer-add request, ignoring"));
+        } else {
+          fb303::fbData->addStatValue("kvstore.cmd_peer_add", 1, fb303::COUNT);
+          auto& kvStoreDb = kvStoreDb_.at(area);
+          kvStoreDb.addPeers(peerAddParams.peers);
+          p.setValue();
+        }
+      });
   return sf;
 }
 
@@ -741,25 +1319,27 @@ KvStore::deleteKvStorePeers(
     thrift::PeerDelParams peerDelParams, std::string area) {
   folly::Promise<folly::Unit> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this,
-                        p = std::move(p),
-                        peerDelParams = std::move(peerDelParams),
-                        area]() mutable {
-    VLOG(2) << "Peer deletion requested for AREA: " << area;
-
-    if (!kvStoreDb_.count(area)) {
-      p.setException(
-          thrift::OpenrError(folly::sformat("Invalid area: {}", area)));
-    } else if (peerDelParams.peerNames.empty()) {
-      p.setException(thrift::OpenrError(
-          "Empty peerNames from peer-del request, ignoring"));
-    } else {
-      fb303::fbData->addStatValue("kvstore.cmd_per_del", 1, fb303::COUNT);
-      auto& kvStoreDb = kvStoreDb_.at(area);
-      kvStoreDb.delPeers(peerDelParams.peerNames);
-      p.setValue();
-    }
-  });
+  runInAreaThread(
+      area,
+      [this,
+       p = std::move(p),
+       peerDelParams = std::move(peerDelParams),
+       area]() mutable {
+        VLOG(2) << "Peer deletion requested for AREA: " << area;
+
+        if (!kvStoreDb_.count(area)) {
+          p.setException(
+              thrift::OpenrError(folly::sformat("Invalid area: {}", area)));
+        } else if (peerDelParams.peerNames.empty()) {
+          p.setException(thrift::OpenrError(
+              "Empty peerNames from peer-del request, ignoring"));
+        } else {
+          fb303::fbData->addStatValue("kvstore.cmd_per_del", 1, fb303::COUNT);
+          auto& kvStoreDb = kvStoreDb_.at(area);
+          kvStoreDb.delPeers(peerDelParams.peerNames);
+          p.setValue();
+        }
+      });
   return sf;
 }
 
@@ -767,7 +1347,7 @@ folly::SemiFuture<std::unique_ptr<thrift::SptInfos>>
 KvStore::getSpanningTreeInfos(std::string area) {
   folly::Promise<std::unique_ptr<thrift::SptInfos>> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this, p = std::move(p), area]() mutable {
+  runInAreaThread(area, [this, p = std::move(p), area]() mutable {
     VLOG(3) << "FLOOD_TOPO_GET command requested for AREA: " << area;
 
     if (!kvStoreDb_.count(area)) {
@@ -782,55 +1362,77 @@ KvStore::getSpanningTreeInfos(std::string area) {
   return sf;
 }
 
-folly::SemiFuture<folly::Unit>
-KvStore::updateFloodTopologyChild(
-    thrift::FloodTopoSetParams floodTopoSetParams, std::string area) {
-  folly::Promise<folly::Unit> p;
+folly::SemiFuture<std::unique_ptr<std::vector<thrift::FloodTraceRecord>>>
+KvStore::getFloodTraces(std::string area) {
+  folly::Promise<std::unique_ptr<std::vector<thrift::FloodTraceRecord>>> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this,
-                        p = std::move(p),
-                        floodTopoSetParams = std::move(floodTopoSetParams),
-                        area]() mutable {
-    VLOG(2) << "FLOOD_TOPO_SET command requested for AREA: " << area;
+  runInAreaThread(area, [this, p = std::move(p), area]() mutable {
+    VLOG(3) << "Flood-path trace harvest requested for AREA: " << area;
 
     if (!kvStoreDb_.count(area)) {
       p.setException(
           thrift::OpenrError(folly::sformat("Invalid area: {}", area)));
     } else {
-      auto& kvStoreDb = kvStoreDb_.at(area);
-      kvStoreDb.processFloodTopoSet(std::move(floodTopoSetParams));
-      p.setValue();
+      p.setValue(std::make_unique<std::vector<thrift::FloodTraceRecord>>(
+          kvStoreDb_.at(area).harvestFloodTraces()));
     }
   });
   return sf;
 }
 
+folly::SemiFuture<folly::Unit>
+KvStore::updateFloodTopologyChild(
+    thrift::FloodTopoSetParams floodTopoSetParams, std::string area) {
+  folly::Promise<folly::Unit> p;
+  auto sf = p.getSemiFuture();
+  runInAreaThread(
+      area,
+      [this,
+       p = std::move(p),
+       floodTopoSetParams = std::move(floodTopoSetParams),
+       area]() mutable {
+        VLOG(2) << "FLOOD_TOPO_SET command requested for AREA: " << area;
+
+        if (!kvStoreDb_.count(area)) {
+          p.setException(
+              thrift::OpenrError(folly::sformat("Invalid area: {}", area)));
+        } else {
+          auto& kvStoreDb = kvStoreDb_.at(area);
+          kvStoreDb.processFloodTopoSet(std::move(floodTopoSetParams));
+          p.setValue();
+        }
+      });
+  return sf;
+}
+
 folly::SemiFuture<folly::Unit>
 KvStore::processKvStoreDualMessage(
     thrift::DualMessages dualMessages, std::string area) {
   folly::Promise<folly::Unit> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this,
-                        p = std::move(p),
-                        dualMessages = std::move(dualMessages),
-                        area]() mutable {
-    VLOG(2) << "DUAL messages received for AREA: " << area;
-
-    if (!kvStoreDb_.count(area)) {
-      p.setException(
-          thrift::OpenrError(folly::sformat("Invalid area: {}", area)));
-    } else if (dualMessages.messages.empty()) {
-      LOG(ERROR) << "Empty DUAL msg receved";
-      p.setValue();
-    } else {
-      fb303::fbData->addStatValue(
-          "kvstore.received_dual_messages", 1, fb303::COUNT);
+  runInAreaThread(
+      area,
+      [this,
+       p = std::move(p),
+       dualMessages = std::move(dualMessages),
+       area]() mutable {
+        VLOG(2) << "DUAL messages received for AREA: " << area;
+
+        if (!kvStoreDb_.count(area)) {
+          p.setException(
+              thrift::OpenrError(folly::sformat("Invalid area: {}", area)));
+        } else if (dualMessages.messages.empty()) {
+          LOG(ERROR) << "Empty DUAL msg receved";
+          p.setValue();
+        } else {
+          fb303::fbData->addStatValue(
+              "kvstore.received_dual_messages", 1, fb303::COUNT);
 
-      auto& kvStoreDb = kvStoreDb_.at(area);
-      kvStoreDb.processDualMessages(std::move(dualMessages));
-      p.setValue();
-    }
-  });
+          auto& kvStoreDb = kvStoreDb_.at(area);
+          kvStoreDb.processDualMessages(std::move(dualMessages));
+          p.setValue();
+        }
+      });
   return sf;
 }
 
@@ -847,7 +1449,18 @@ std::map<std::string, int64_t>
 KvStore::getGlobalCounters() const {
   std::map<std::string, int64_t> flatCounters;
   for (auto& kvDb : kvStoreDb_) {
-    auto kvDbCounters = kvDb.second.getCounters();
+    std::map<std::string, int64_t> kvDbCounters;
+    auto areaEvbIt = areaEvbs_.find(kvDb.first);
+    if (areaEvbIt == areaEvbs_.end()) {
+      kvDbCounters = kvDb.second.getCounters();
+    } else {
+      // counters must be read on the area's owning thread
+      folly::Promise<std::map<std::string, int64_t>> p;
+      auto sf = p.getSemiFuture();
+      areaEvbIt->second->runInEventBaseThread(
+          [&]() mutable { p.setValue(kvDb.second.getCounters()); });
+      kvDbCounters = std::move(sf).get();
+    }
     // add up counters for same key from all kvStoreDb instances
     flatCounters = std::accumulate(
         kvDbCounters.begin(),
@@ -972,9 +1585,13 @@ KvStoreDb::KvStoreDb(
     floodLimiter_ = std::make_unique<folly::BasicTokenBucket<>>(
         kvParams_.floodRate->flood_msg_per_sec,
         kvParams_.floodRate->flood_msg_burst_size);
+  }
+  // pending publication timer serves both the rate limiter and the
+  // coalescing window
+  if (kvParams_.floodRate or kvParams_.floodCoalesceWindow.has_value()) {
     pendingPublicationTimer_ =
         folly::AsyncTimeout::make(*evb_->getEvb(), [this]() noexcept {
-          if (!floodLimiter_->consume(1)) {
+          if (floodLimiter_ and !floodLimiter_->consume(1)) {
             pendingPublicationTimer_->scheduleTimeout(
                 Constants::kFloodPendingPublication);
             return;
@@ -983,6 +1600,27 @@ KvStoreDb::KvStoreDb(
         });
   }
 
+  // outgoing dual messages are aggregated per neighbor and flushed once per
+  // event-loop iteration so message bursts don't pay per-message overhead
+  dualMessagesTimer_ =
+      folly::AsyncTimeout::make(*evb_->getEvb(), [this]() noexcept {
+        flushPendingDualMessages();
+      });
+
+  // periodically re-elect our flood parent among loop-free equal-cost
+  // candidates; the root itself never has a parent so it has nothing
+  // to rebalance
+  if (kvParams_.enableFloodOptimization and not isFloodRoot) {
+    floodTopoRebalanceTimer_ =
+        folly::AsyncTimeout::make(*evb_->getEvb(), [this]() noexcept {
+          rebalanceFloodTopo();
+          floodTopoRebalanceTimer_->scheduleTimeout(
+              Constants::kFloodTopoRebalanceInterval);
+        });
+    floodTopoRebalanceTimer_->scheduleTimeout(
+        Constants::kFloodTopoRebalanceInterval);
+  }
+
   LOG(INFO) << "Starting kvstore DB instance for node " << nodeId << " area "
             << area;
 
@@ -1000,6 +1638,24 @@ KvStoreDb::KvStoreDb(
   ttlCountdownTimer_ = folly::AsyncTimeout::make(
       *evb_->getEvb(), [this]() noexcept { cleanupTtlCountdownQueue(); });
 
+  // Timer to drain batched hot-path stats into fb303; armed lazily by
+  // bumpStat() so an idle store never wakes up for stats
+  statsDrainTimer_ = folly::AsyncTimeout::make(
+      *evb_->getEvb(), [this]() noexcept { drainHotPathStats(); });
+
+  // Warm boot from the last persisted snapshot (if any) and keep
+  // snapshotting periodically so a restart starts near-current and only
+  // syncs deltas from peers
+  if (kvParams_.configStore and kvParams_.snapshotInterval.has_value()) {
+    loadDbSnapshot();
+    dbSnapshotTimer_ =
+        folly::AsyncTimeout::make(*evb_->getEvb(), [this]() noexcept {
+          saveDbSnapshot();
+          dbSnapshotTimer_->scheduleTimeout(kvParams_.snapshotInterval.value());
+        });
+    dbSnapshotTimer_->scheduleTimeout(kvParams_.snapshotInterval.value());
+  }
+
   // Initialize stats keys
   fb303::fbData->addStatExportType("kvstore.cmd_hash_dump", fb303::COUNT);
   fb303::fbData->addStatExportType("kvstore.cmd_key_dump", fb303::COUNT);
@@ -1008,9 +1664,16 @@ KvStoreDb::KvStoreDb(
   fb303::fbData->addStatExportType("kvstore.cmd_peer_add", fb303::COUNT);
   fb303::fbData->addStatExportType("kvstore.cmd_peer_dump", fb303::COUNT);
   fb303::fbData->addStatExportType("kvstore.cmd_per_del", fb303::COUNT);
+  fb303::fbData->addStatExportType(
+      "kvstore.duplicate_flood_suppress", fb303::COUNT);
   fb303::fbData->addStatExportType("kvstore.expired_key_vals", fb303::SUM);
   fb303::fbData->addStatExportType("kvstore.flood_duration_ms", fb303::AVG);
+  fb303::fbData->addStatExportType(
+      "kvstore.flood_topo_rebalance", fb303::COUNT);
+  fb303::fbData->addStatExportType(
+      "kvstore.full_sync_compression_bytes_saved", fb303::SUM);
   fb303::fbData->addStatExportType("kvstore.full_sync_duration_ms", fb303::AVG);
+  fb303::fbData->addStatExportType("kvstore.incremental_resync", fb303::COUNT);
   fb303::fbData->addStatExportType("kvstore.looped_publications", fb303::COUNT);
   fb303::fbData->addStatExportType("kvstore.peers.bytes_received", fb303::SUM);
   fb303::fbData->addStatExportType("kvstore.peers.bytes_received", fb303::SUM);
@@ -1040,20 +1703,24 @@ KvStoreDb::updateTtlCountdownQueue(const thrift::Publication& publication) {
       TtlCountdownQueueEntry queueEntry;
       queueEntry.expiryTime = std::chrono::steady_clock::now() +
           std::chrono::milliseconds(value.ttl);
-      queueEntry.key = key;
+      queueEntry.key = atomTable_.intern(key);
       queueEntry.version = value.version;
       queueEntry.ttlVersion = value.ttlVersion;
-      queueEntry.originatorId = value.originatorId;
-
-      if ((ttlCountdownQueue_.empty() or
-           (queueEntry.expiryTime <= ttlCountdownQueue_.top().expiryTime)) and
-          ttlCountdownTimer_) {
-        // Reschedule the shorter timeout
-        ttlCountdownTimer_->scheduleTimeout(
-            std::chrono::milliseconds(value.ttl));
-      }
+      queueEntry.originatorId = atomTable_.intern(value.originatorId);
 
-      ttlCountdownQueue_.push(std::move(queueEntry));
+      // refresh reuses the key's wheel entry; stale incarnations are
+      // cancelled instead of lingering on the wheel
+      ttlCountdownWheel_.insertOrUpdate(std::move(queueEntry));
+    }
+  }
+
+  // (re)arm the countdown timer for the next wheel wakeup
+  if (ttlCountdownTimer_) {
+    if (auto wakeup = ttlCountdownWheel_.nextWakeup()) {
+      ttlCountdownTimer_->scheduleTimeout(std::max(
+          std::chrono::milliseconds(0),
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              wakeup.value() - std::chrono::steady_clock::now())));
     }
   }
 }
@@ -1079,15 +1746,91 @@ KvStoreDb::getKeyVals(std::vector<std::string> const& keys) {
 // dump the entries of my KV store whose keys match the given prefix
 // if prefix is the empty string, the full KV store is dumped
 thrift::Publication
-KvStoreDb::dumpAllWithFilters(KvStoreFilters const& kvFilters) const {
+KvStoreDb::dumpAllWithFilters(
+    KvStoreFilters const& kvFilters,
+    bool updateTtl /* false */,
+    std::optional<std::string> const& startKey /* std::nullopt */,
+    std::optional<int32_t> maxKeys /* std::nullopt */) {
   thrift::Publication thriftPub;
   thriftPub.area_ref() = area_;
+  const auto timeNow = std::chrono::steady_clock::now();
+
+  // copy one store entry into the publication. On large dumps consult the
+  // countdown wheel while we touch the entry anyway: expired values are
+  // dropped before the deep copy below and the wire ttl of the rest is
+  // fixed up in the same pass, sparing callers the second string-keyed
+  // pass of updatePublicationTtl. Keys with infinite ttl are never on the
+  // wheel and copy as-is
+  const auto copyEntry = [&](std::string const& key,
+                             thrift::Value const& storedValue) {
+    if (updateTtl and storedValue.ttl != Constants::kTtlInfinity) {
+      const auto qE = ttlCountdownWheel_.get(atomTable_.intern(key));
+      if (qE.has_value() and storedValue.version == qE->version and
+          storedValue.originatorId == *qE->originatorId and
+          storedValue.ttlVersion == qE->ttlVersion) {
+        const auto timeLeft =
+            duration_cast<milliseconds>(qE->expiryTime - timeNow);
+        if (timeLeft <= kvParams_.ttlDecr) {
+          return;
+        }
+        auto& value = thriftPub.keyVals[key];
+        value = storedValue;
+        value.ttl = timeLeft.count() - kvParams_.ttlDecr.count();
+        return;
+      }
+    }
+    thriftPub.keyVals[key] = storedValue;
+  };
+
+  // range-partitioned dump: walk the sorted key index from the cursor
+  // (exclusive) in lexicographic order and stop once the page is full.
+  // The filters still apply to every key in the window. A page that
+  // fills before the key space runs out carries the resume cursor in
+  // nextKey so partial consumers never pay full-store costs
+  if (startKey.has_value() or maxKeys.has_value()) {
+    const size_t pageSize =
+        (maxKeys.has_value() and *maxKeys > 0)
+        ? static_cast<size_t>(*maxKeys)
+        : std::numeric_limits<size_t>::max();
+    auto it = startKey.has_value() ? sortedKeys_.upper_bound(*startKey)
+                                   : sortedKeys_.begin();
+    for (; it != sortedKeys_.end() and thriftPub.keyVals.size() < pageSize;
+         ++it) {
+      const auto kvIt = kvStore_.find(**it);
+      DCHECK(kvIt != kvStore_.end());
+      if (kvFilters.keyMatch(kvIt->first, kvIt->second)) {
+        copyEntry(kvIt->first, kvIt->second);
+      }
+    }
+    if (it != sortedKeys_.end()) {
+      // the page filled with keys left over - at least one key was
+      // walked, so the cursor (last walked key) is well defined
+      thriftPub.nextKey_ref() = **std::prev(it);
+    }
+    return thriftPub;
+  }
+
+  // a filter made of literal key prefixes selects contiguous ranges of
+  // the sorted key index - scan just those instead of walking and
+  // pattern-matching the full table
+  if (kvFilters.isPlainPrefixMatch()) {
+    for (auto const& prefix : kvFilters.getKeyPrefixes()) {
+      for (auto it = sortedKeys_.lower_bound(prefix);
+           it != sortedKeys_.end() and
+           folly::StringPiece(**it).startsWith(prefix);
+           ++it) {
+        const auto kvIt = kvStore_.find(**it);
+        DCHECK(kvIt != kvStore_.end());
+        copyEntry(kvIt->first, kvIt->second);
+      }
+    }
+    return thriftPub;
+  }
 
   for (auto const& kv : kvStore_) {
-    if (not kvFilters.keyMatch(kv.first, kv.second)) {
-      continue;
+    if (kvFilters.keyMatch(kv.first, kv.second)) {
+      copyEntry(kv.first, kv.second);
     }
-    thriftPub.keyVals[kv.first] = kv.second;
   }
   return thriftPub;
 }
@@ -1098,21 +1841,208 @@ thrift::Publication
 KvStoreDb::dumpHashWithFilters(KvStoreFilters const& kvFilters) const {
   thrift::Publication thriftPub;
   thriftPub.area_ref() = area_;
+
+  // emit the hash-only flavor of one store entry
+  const auto copyHash = [&](std::string const& key,
+                            thrift::Value const& storedValue) {
+    DCHECK(storedValue.hash_ref().has_value());
+    auto& value = thriftPub.keyVals[key];
+    value.version = storedValue.version;
+    value.originatorId = storedValue.originatorId;
+    value.hash_ref().copy_from(storedValue.hash_ref());
+    value.ttl = storedValue.ttl;
+    value.ttlVersion = storedValue.ttlVersion;
+  };
+
+  // literal-prefix filters are served by range scans over the sorted key
+  // index, same as in dumpAllWithFilters()
+  if (kvFilters.isPlainPrefixMatch()) {
+    for (auto const& prefix : kvFilters.getKeyPrefixes()) {
+      for (auto it = sortedKeys_.lower_bound(prefix);
+           it != sortedKeys_.end() and
+           folly::StringPiece(**it).startsWith(prefix);
+           ++it) {
+        const auto kvIt = kvStore_.find(**it);
+        DCHECK(kvIt != kvStore_.end());
+        copyHash(kvIt->first, kvIt->second);
+      }
+    }
+    return thriftPub;
+  }
+
   for (auto const& kv : kvStore_) {
-    if (not kvFilters.keyMatch(kv.first, kv.second)) {
-      continue;
+    if (kvFilters.keyMatch(kv.first, kv.second)) {
+      copyHash(kv.first, kv.second);
     }
-    DCHECK(kv.second.hash_ref().has_value());
-    auto& value = thriftPub.keyVals[kv.first];
-    value.version = kv.second.version;
-    value.originatorId = kv.second.originatorId;
-    value.hash_ref().copy_from(kv.second.hash_ref());
-    value.ttl = kv.second.ttl;
-    value.ttlVersion = kv.second.ttlVersion;
   }
   return thriftPub;
 }
 
+// build (or serve the cached) full hash dump of the store. See header for
+// the snapshot contract
+std::shared_ptr<const thrift::Publication>
+KvStoreDb::getHashDumpSnapshot() {
+  if (hashDumpSnapshot_) {
+    return hashDumpSnapshot_;
+  }
+
+  const auto timeNow = std::chrono::steady_clock::now();
+  using HashKeyVals = std::unordered_map<std::string, thrift::Value>;
+
+  // hash-only copy of the store entry behind the given (canonical) key
+  // atom, with the remaining-ttl fixup applied in the same pass. Returns
+  // std::nullopt if the value would expire in flight and hence should be
+  // dropped from the snapshot
+  const auto dumpEntry =
+      [this, timeNow](StringAtom const& key) -> std::optional<thrift::Value> {
+    const auto kvIt = kvStore_.find(*key);
+    DCHECK(kvIt != kvStore_.end());
+    const auto& stored = kvIt->second;
+    DCHECK(stored.hash_ref().has_value());
+
+    thrift::Value value;
+    value.version = stored.version;
+    value.originatorId = stored.originatorId;
+    value.hash_ref().copy_from(stored.hash_ref());
+    value.ttl = stored.ttl;
+    value.ttlVersion = stored.ttlVersion;
+    if (stored.ttl != Constants::kTtlInfinity) {
+      // index atoms are canonical, so the wheel can be probed without
+      // going through the (not thread-safe) atom table
+      const auto qE = ttlCountdownWheel_.get(key);
+      if (qE.has_value() and stored.version == qE->version and
+          stored.originatorId == *qE->originatorId and
+          stored.ttlVersion == qE->ttlVersion) {
+        const auto timeLeft =
+            duration_cast<milliseconds>(qE->expiryTime - timeNow);
+        if (timeLeft <= kvParams_.ttlDecr) {
+          return std::nullopt;
+        }
+        value.ttl = timeLeft.count() - kvParams_.ttlDecr.count();
+      }
+    }
+    return value;
+  };
+
+  // copy the entries whose keys fall into the given range of the sorted
+  // index. Reads only; safe on workers while this thread blocks on them
+  // below, keeping the store immutable for the duration
+  const auto dumpRange = [&dumpEntry](auto rangeBegin, auto rangeEnd) {
+    HashKeyVals keyVals;
+    for (auto it = rangeBegin; it != rangeEnd; ++it) {
+      if (auto value = dumpEntry(*it)) {
+        keyVals.emplace(**it, std::move(value).value());
+      }
+    }
+    return keyVals;
+  };
+
+  auto snapshot = std::make_shared<thrift::Publication>();
+  snapshot->area_ref() = area_;
+
+  const size_t storeSize = kvStore_.size();
+  if (hashDumpBase_ and
+      hashDumpDirtyKeys_.size() * kIncrementalHashDumpMaxDirtyFraction <=
+          storeSize) {
+    // only a small slice of the store mutated since the last build: start
+    // from a copy of it and recompute just the dirtied keys. The static
+    // bulk of the store is carried over verbatim, so back-to-back syncs
+    // under hot-key churn pay for the churn, not for the whole database
+    auto keyVals = hashDumpBase_->keyVals;
+    for (const auto& key : hashDumpDirtyKeys_) {
+      keyVals.erase(key);
+      const auto sortedIt = sortedKeys_.find(key);
+      if (sortedIt == sortedKeys_.end()) {
+        continue; // expired or deleted since the base was built
+      }
+      if (auto value = dumpEntry(*sortedIt)) {
+        keyVals.emplace(key, std::move(value).value());
+      }
+    }
+    snapshot->keyVals = std::move(keyVals);
+  } else if (
+      not kvParams_.hashDumpExecutor or storeSize < kParallelHashDumpMinKeys) {
+    snapshot->keyVals = dumpRange(sortedKeys_.cbegin(), sortedKeys_.cend());
+  } else {
+    // partition the sorted index into contiguous ranges, one per worker
+    const size_t numRanges = kvParams_.hashDumpExecutor->numThreads();
+    std::vector<folly::Future<HashKeyVals>> ranges;
+    auto rangeBegin = sortedKeys_.cbegin();
+    for (size_t i = 0; i < numRanges; ++i) {
+      auto rangeEnd = rangeBegin;
+      std::advance(
+          rangeEnd,
+          storeSize / numRanges + (i < storeSize % numRanges ? 1 : 0));
+      ranges.emplace_back(folly::via(
+          kvParams_.hashDumpExecutor.get(),
+          [&dumpRange, rangeBegin, rangeEnd]() {
+            return dumpRange(rangeBegin, rangeEnd);
+          }));
+      rangeBegin = rangeEnd;
+    }
+    snapshot->keyVals.reserve(storeSize);
+    for (auto& rangeKeyVals : folly::collectAll(std::move(ranges)).get()) {
+      auto partial = std::move(rangeKeyVals).value();
+      while (not partial.empty()) {
+        snapshot->keyVals.insert(partial.extract(partial.begin()));
+      }
+    }
+  }
+
+  hashDumpDirtyKeys_.clear();
+  hashDumpSnapshot_ = std::move(snapshot);
+  hashDumpBase_ = hashDumpSnapshot_;
+  return hashDumpSnapshot_;
+}
+
+// see header for the contract; must be called for every mutated key
+void
+KvStoreDb::invalidateHashDumpSnapshot(std::string const& key) {
+  hashDumpSnapshot_.reset();
+  if (hashDumpBase_) {
+    hashDumpDirtyKeys_.insert(key);
+  }
+}
+
+// prune keys falling into hash-tree buckets on which peer agrees with us.
+// Peer's per-bucket hashes are carried in KeyDumpParams; buckets whose
+// hashes match hold identical key-vals on both sides and can be skipped
+// entirely during full-sync
+void
+KvStoreDb::pruneUnchangedHashTreeBuckets(
+    thrift::Publication& thriftPub, thrift::KeyDumpParams& params) const {
+  if (not params.keyValHashTreeBuckets_ref().has_value()) {
+    return;
+  }
+
+  const auto divergedBuckets =
+      hashTree_.diffBuckets(params.keyValHashTreeBuckets_ref().value());
+  size_t prunedKeyCnt{0};
+  for (auto it = thriftPub.keyVals.begin(); it != thriftPub.keyVals.end();) {
+    if (divergedBuckets.count(KvStoreHashTree::bucketIndex(it->first))) {
+      ++it;
+    } else {
+      it = thriftPub.keyVals.erase(it);
+      ++prunedKeyCnt;
+    }
+  }
+
+  // restrict peer-provided hashes to diverged buckets as well so the
+  // dumpDifference() that follows only looks at diverging keys
+  if (auto keyValHashes = params.keyValHashes_ref()) {
+    for (auto it = keyValHashes->begin(); it != keyValHashes->end();) {
+      if (divergedBuckets.count(KvStoreHashTree::bucketIndex(it->first))) {
+        ++it;
+      } else {
+        it = keyValHashes->erase(it);
+      }
+    }
+  }
+
+  VLOG(2) << "Hash-tree pruned " << prunedKeyCnt << " key(s), "
+          << divergedBuckets.size() << " bucket(s) diverged";
+}
+
 // dump the keys on which hashes differ from given keyVals
 // thriftPub.keyVals: better keys or keys exist only in MY-KEY-VAL
 // thriftPub.tobeUpdatedKeys: better keys or keys exist only in REQ-KEY-VAL
@@ -1164,11 +2094,58 @@ KvStoreDb::dumpDifference(
   return thriftPub;
 }
 
+void
+KvStoreDb::filterPublicationBySeq(
+    thrift::Publication& thriftPub, int64_t sinceSeq) {
+  // Stamp the current sequence as the client's next cursor
+  thriftPub.updateSeq_ref() = updateSeq_;
+
+  // A cursor older than the retained expiration history cannot be served
+  // incrementally - leave the full dump untouched
+  if (sinceSeq < tombstoneHorizonSeq_) {
+    return;
+  }
+
+  // Drop key-vals unchanged since the cursor. Keys without bookkeeping
+  // (e.g. cursor from a previous incarnation) are conservatively kept
+  for (auto it = thriftPub.keyVals.begin(); it != thriftPub.keyVals.end();) {
+    auto seqIt = keyUpdateSeq_.find(it->first);
+    if (seqIt != keyUpdateSeq_.end() and seqIt->second <= sinceSeq) {
+      it = thriftPub.keyVals.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  // Report keys expired after the cursor
+  for (auto const& [seq, key] : tombstones_) {
+    if (seq > sinceSeq and kvStore_.count(key) == 0) {
+      thriftPub.expiredKeys.emplace_back(key);
+    }
+  }
+}
+
+void
+KvStoreDb::recordKeyUpdates(
+    std::unordered_map<std::string, thrift::Value> const& keyVals) {
+  for (auto const& kv : keyVals) {
+    keyUpdateSeq_[kv.first] = ++updateSeq_;
+  }
+}
+
 void
 KvStoreDb::requestThriftPeerSync() {
   // minimal timeout for next run
   auto timeout = std::chrono::milliseconds(Constants::kMaxBackoff);
 
+  // full-syncs already in flight count against the parallel-sync limit
+  size_t numInFlightSync{0};
+  for (auto const& kv : thriftPeers_) {
+    if (kv.second.state == KvStorePeerState::SYNCING) {
+      ++numInFlightSync;
+    }
+  }
+
   // Scan over thriftPeers to promote IDLE peers to SYNCING
   for (auto& kv : thriftPeers_) {
     auto& peerName = kv.first; // std::string
@@ -1187,7 +2164,12 @@ KvStoreDb::requestThriftPeerSync() {
       continue;
     }
 
-    // create thrift client and do backoff if can't go through
+    // create thrift client and do backoff if can't go through. Session
+    // establishment is deliberately NOT held back by the sync limit
+    // below: connects are asynchronous, so sessions of peers awaiting a
+    // sync slot are set up in the background while earlier syncs
+    // transfer, and a freed slot starts its sync on an already-connected
+    // session instead of paying connection setup first
     if (not thriftPeer.client) {
       try {
         LOG(INFO) << "Creating kvstore thrift client with addr: "
@@ -1213,6 +2195,16 @@ KvStoreDb::requestThriftPeerSync() {
       }
     }
 
+    // bound the number of concurrent initial full-syncs. The limit
+    // starts small and doubles with every completed sync (mirroring the
+    // ZMQ full-sync path), so a cold start against many peers ramps up
+    // instead of requesting the full database from everyone at once.
+    // Held-back peers are picked up the moment an in-flight sync
+    // completes (see processThriftSyncSuccess/Failure)
+    if (numInFlightSync >= parallelSyncLimit_) {
+      continue;
+    }
+
     // state transition
     KvStorePeerState oldState = thriftPeer.state;
     thriftPeer.state = getNextState(oldState, KvStorePeerEvent::PEER_ADD);
@@ -1226,22 +2218,40 @@ KvStoreDb::requestThriftPeerSync() {
       params.prefix = keyPrefix;
       params.originatorIds = kvParams_.filters.value().getOrigniatorIdList();
     }
-    KvStoreFilters kvFilters(
-        std::vector<std::string>{}, /* keyPrefixList */
-        std::set<std::string>{} /* originator */);
-    params.keyValHashes_ref() =
-        std::move(dumpHashWithFilters(kvFilters).keyVals);
+    if (thriftPeer.lastSyncSeq.has_value() and
+        std::chrono::steady_clock::now() - thriftPeer.lastSyncTime <=
+            Constants::kPeerResyncGraceWindow) {
+      // the peer bounced back shortly after a successful sync: request
+      // just the tail since our cursor instead of the full database (and
+      // skip the per-key hash exchange altogether). The responder falls
+      // back to a full dump on its own when the cursor predates its
+      // retained expiration history
+      params.sinceSeq_ref() = *thriftPeer.lastSyncSeq;
+      fb303::fbData->addStatValue(
+          "kvstore.incremental_resync", 1, fb303::COUNT);
+    } else {
+      // hash dumps come from the COW snapshot - syncing several peers in
+      // one round shares a single (parallel) rebuild
+      params.keyValHashes_ref() = getHashDumpSnapshot()->keyVals;
+      // share our hash-tree view so peer can prune buckets we agree on
+      params.keyValHashTreeBuckets_ref() = hashTree_.bucketHashes();
+    }
 
     // send request over thrift client and attach callback
+    auto startTime = std::chrono::steady_clock::now();
     auto sf = thriftPeer.client->semifuture_getKvStoreKeyValsFilteredArea(
         params, area_);
     std::move(sf)
         .via(evb_->getEvb())
-        .thenValue([this, peerName](thrift::Publication&& pub) {
+        .thenValue([this, peerName, startTime](thrift::Publication&& pub) {
           LOG(INFO) << "Initial full-dump received from: " << peerName
                     << ", received: " << pub.keyVals.size() << " key-vals";
 
           processThriftSyncSuccess(peerName, std::move(pub));
+          logSyncEvent(
+              peerName,
+              std::chrono::duration_cast<std::chrono::milliseconds>(
+                  std::chrono::steady_clock::now() - startTime));
         })
         .thenError([this, peerName](const folly::exception_wrapper& ew) {
           LOG(WARNING) << "Failed to do a full-dump with: " << peerName
@@ -1250,6 +2260,16 @@ KvStoreDb::requestThriftPeerSync() {
           fb303::fbData->addStatValue("kvstore.full_dump_failure");
           processThriftSyncFailure(peerName);
         });
+    ++numInFlightSync;
+  }
+
+  // schedule another round for IDLE peers still held back by backoff
+  for (auto const& kv : thriftPeers_) {
+    if (kv.second.state == KvStorePeerState::IDLE and
+        not thriftSyncTimer_->isScheduled()) {
+      thriftSyncTimer_->scheduleTimeout(timeout);
+      break;
+    }
   }
 }
 
@@ -1261,7 +2281,53 @@ KvStoreDb::requestThriftPeerSync() {
 void
 KvStoreDb::processThriftSyncSuccess(
     std::string const& peerName, thrift::Publication&& pub) {
-  CHECK(false) << "Not implemented";
+  auto peerIter = thriftPeers_.find(peerName);
+  if (peerIter == thriftPeers_.end()) {
+    // peer got removed while the full-dump was in flight
+    LOG(INFO) << "Ignoring full-dump response from removed peer: " << peerName;
+    return;
+  }
+  auto& peer = peerIter->second;
+
+  // merge the full-dump in. mergePublication() floods the learnt delta
+  // to the rest of the flood peers and streams tobeUpdatedKeys back to
+  // the sender(3-way full-sync)
+  const auto kvUpdateCnt = mergePublication(pub, peerName);
+  LOG(INFO) << "Full-sync with " << peerName << " completed. Updated "
+            << kvUpdateCnt << " key-vals.";
+  fb303::fbData->addStatValue(
+      "kvstore.thrift.num_full_sync_success", 1, fb303::COUNT);
+
+  // state transition SYNCING -> INITIALIZED
+  KvStorePeerState oldState = peer.state;
+  peer.state = getNextState(oldState, KvStorePeerEvent::SYNC_RESP_RCVD);
+  logStateTransition(peerName, oldState, peer.state);
+  peer.expBackoff.reportSuccess();
+
+  // remember the peer's sequence cursor; a quick reconnect after a
+  // session bounce replays just the tail since here instead of a full
+  // dump. The tail may repeat key-vals we already saw flooded - the
+  // merge dedups those - but stays tiny next to the whole database
+  peer.lastSyncSeq = pub.updateSeq_ref().to_optional();
+  peer.lastSyncTime = std::chrono::steady_clock::now();
+
+  // a full-dump landed: double the parallel sync limit like the ZMQ
+  // full-sync path does, under the same assumption that subsequent
+  // responses carry mostly deltas
+  parallelSyncLimit_ = std::min(
+      2 * parallelSyncLimit_, Constants::kMaxFullSyncPendingCountThreshold);
+
+  // pick up IDLE peers, if any
+  for (auto const& kv : thriftPeers_) {
+    if (kv.second.state == KvStorePeerState::IDLE and
+        not thriftSyncTimer_->isScheduled()) {
+      thriftSyncTimer_->scheduleTimeout(std::chrono::milliseconds(0));
+      break;
+    }
+  }
+
+  // this may have been the last outstanding initial full-sync
+  checkInitialSyncDone();
 }
 
 // This function will process the exception hit during full-dump:
@@ -1269,7 +2335,49 @@ KvStoreDb::processThriftSyncSuccess(
 //  2) Schedule syncTimer to pick IDLE peer up if NOT scheduled;
 void
 KvStoreDb::processThriftSyncFailure(std::string const& peerName) {
-  CHECK(false) << "Not implemented";
+  auto peerIter = thriftPeers_.find(peerName);
+  if (peerIter == thriftPeers_.end()) {
+    return;
+  }
+  auto& peer = peerIter->second;
+
+  // destruct the client so next attempt reconnects from scratch and
+  // apply exponential backoff before retrying
+  peer.client.reset();
+  peer.expBackoff.reportError();
+  fb303::fbData->addStatValue(
+      "kvstore.thrift.num_full_sync_failure", 1, fb303::COUNT);
+
+  // state transition SYNCING -> IDLE
+  KvStorePeerState oldState = peer.state;
+  peer.state = getNextState(oldState, KvStorePeerEvent::THRIFT_API_ERROR);
+  logStateTransition(peerName, oldState, peer.state);
+
+  // reschedule right away: the failure freed a sync slot that another
+  // IDLE peer may use immediately. The failed peer itself stays held
+  // back by its per-peer backoff check
+  if (not thriftSyncTimer_->isScheduled()) {
+    thriftSyncTimer_->scheduleTimeout(std::chrono::milliseconds(0));
+  }
+}
+
+void
+KvStoreDb::checkInitialSyncDone() {
+  if (initialSyncDone_ or not kvParams_.initialSyncDoneCallback) {
+    return;
+  }
+  // ZMQ full-sync pipeline drained?
+  if (not peersToSyncWith_.empty() or not latestSentPeerSync_.empty()) {
+    return;
+  }
+  // every thrift peer got its initial full-dump?
+  for (auto const& kv : thriftPeers_) {
+    if (kv.second.state != KvStorePeerState::INITIALIZED) {
+      return;
+    }
+  }
+  initialSyncDone_ = true;
+  kvParams_.initialSyncDoneCallback(area_);
 }
 
 void
@@ -1335,6 +2443,121 @@ KvStoreDb::addThriftPeers(
                  << ". Exception: " << folly::exceptionStr(e);
     }
   }
+
+  // kick off initial full-sync for the newly added peers
+  if (thriftSyncTimer_ and not thriftSyncTimer_->isScheduled()) {
+    thriftSyncTimer_->scheduleTimeout(std::chrono::milliseconds(0));
+  }
+}
+
+void
+KvStoreDb::floodToThriftPeer(
+    const std::string& peerName, thrift::KeySetParams&& params) {
+  auto peerIter = thriftPeers_.find(peerName);
+  if (peerIter == thriftPeers_.end()) {
+    return;
+  }
+  peerIter->second.pendingFloods.emplace_back(std::move(params));
+  drainPeerFloodQueue(peerName);
+}
+
+// Issue queued flood RPCs towards `peerName` until the in-flight window
+// is full. Completions re-enter here to refill the window, so up to
+// kMaxFloodInFlightPerPeer publications overlap one round-trip instead
+// of one RPC per RTT. Responses may complete out of order within the
+// window; receiver-side merge is version-ordered and idempotent, so a
+// late-arriving older publication can never regress a key.
+//
+// Each RPC additionally consumes from the peer's token bucket, whose rate
+// is adapted by AIMD on observed completion latency (see adjustFloodRate).
+// A WAN peer thereby throttles itself while intra-rack peers keep running
+// at full rate
+void
+KvStoreDb::drainPeerFloodQueue(const std::string& peerName) {
+  auto peerIter = thriftPeers_.find(peerName);
+  if (peerIter == thriftPeers_.end() or not peerIter->second.client) {
+    return;
+  }
+  auto& peer = peerIter->second;
+  while (peer.inFlightFloods < Constants::kMaxFloodInFlightPerPeer and
+         not peer.pendingFloods.empty()) {
+    if (not peer.floodBucket.consume(
+            1.0, peer.floodRate, Constants::kPeerFloodBurstSize)) {
+      // out of tokens - resume draining once the bucket has refilled one
+      if (not peer.floodDrainTimer) {
+        peer.floodDrainTimer = folly::AsyncTimeout::make(
+            *evb_->getEvb(),
+            [this, peerName]() noexcept { drainPeerFloodQueue(peerName); });
+      }
+      if (not peer.floodDrainTimer->isScheduled()) {
+        peer.floodDrainTimer->scheduleTimeout(
+            std::chrono::milliseconds(std::max<int64_t>(
+                1, static_cast<int64_t>(1000.0 / peer.floodRate))));
+      }
+      return;
+    }
+    auto params = std::move(peer.pendingFloods.front());
+    peer.pendingFloods.pop_front();
+    ++peer.inFlightFloods;
+
+    // stamp pipeline sequencing so the receiver can restore send order
+    // when RPCs within the window are dispatched out of order
+    params.senderId_ref() = kvParams_.nodeId;
+    params.floodSeqNum_ref() = ++peer.nextFloodSeqNum;
+
+    bumpStat(hotPathStats_.sentPublications, 1);
+    bumpStat(hotPathStats_.sentKeyVals, params.keyVals.size());
+
+    auto const sentTs = std::chrono::steady_clock::now();
+    auto sf = peer.client->semifuture_setKvStoreKeyVals(params, area_);
+    std::move(sf)
+        .via(evb_->getEvb())
+        .thenValue([this, peerName, sentTs](folly::Unit&&) {
+          const auto latency =
+              std::chrono::duration_cast<std::chrono::milliseconds>(
+                  std::chrono::steady_clock::now() - sentTs);
+          TelemetrySampler::instance().record(
+              "kvstore.flood_latency_ms", latency.count());
+          auto it = thriftPeers_.find(peerName);
+          if (it != thriftPeers_.end()) {
+            adjustFloodRate(
+                it->second, latency <= Constants::kPeerFloodLatencyTarget);
+            --it->second.inFlightFloods;
+            drainPeerFloodQueue(peerName);
+          }
+        })
+        .thenError([this, peerName](const folly::exception_wrapper& ew) {
+          LOG(WARNING) << "Failed to flood publication to: " << peerName
+                       << ". Exception: " << ew.what();
+
+          fb303::fbData->addStatValue(
+              "kvstore.thrift_flood_failure", 1, fb303::COUNT);
+          auto it = thriftPeers_.find(peerName);
+          if (it != thriftPeers_.end()) {
+            adjustFloodRate(it->second, false /* timely */);
+            --it->second.inFlightFloods;
+            drainPeerFloodQueue(peerName);
+          }
+        });
+  }
+}
+
+// AIMD adjustment of a peer's flood rate: every timely ack earns a small
+// additive raise, a late ack or failed RPC halves the rate. The rate is
+// clamped to [kPeerFloodRateMin, kPeerFloodRateMax] so a flapping peer can
+// not shut flooding off entirely and a healthy one is never capped below
+// line rate
+void
+KvStoreDb::adjustFloodRate(KvStorePeer& peer, bool timely) {
+  if (timely) {
+    peer.floodRate = std::min(
+        peer.floodRate + Constants::kPeerFloodRateAdditiveStep,
+        Constants::kPeerFloodRateMax);
+  } else {
+    peer.floodRate = std::max(
+        peer.floodRate * Constants::kPeerFloodRateDecayFactor,
+        Constants::kPeerFloodRateMin);
+  }
 }
 
 // add new peers to subscribe to
@@ -1433,20 +2656,24 @@ KvStoreDb::addPeers(
           // chosing new nexthop if need.
           unsetChildAll(peerName);
         }
-      }
-
-      // Enqueue for full-sync requests
-      LOG(INFO) << "Enqueuing full-sync request for peer " << peerName;
-      peersToSyncWith_.emplace(
-          peerName,
-          ExponentialBackoff<std::chrono::milliseconds>(
-              Constants::kInitialBackoff, Constants::kMaxBackoff));
+      }
+
+      // Enqueue for full-sync requests. With thrift communication enabled
+      // full-sync is driven by the thrift peer state-machine instead, so
+      // skip the ZMQ sync queue to avoid double-syncing
+      if (not kvParams_.enableKvStoreThrift) {
+        LOG(INFO) << "Enqueuing full-sync request for peer " << peerName;
+        peersToSyncWith_.emplace(
+            peerName,
+            ExponentialBackoff<std::chrono::milliseconds>(
+                Constants::kInitialBackoff, Constants::kMaxBackoff));
+      }
     } catch (std::exception const& e) {
       LOG(ERROR) << "Error connecting to: `" << peerName
                  << "` reason: " << folly::exceptionStr(e);
     }
   }
-  if (not fullSyncTimer_->isScheduled()) {
+  if (not peersToSyncWith_.empty() and not fullSyncTimer_->isScheduled()) {
     fullSyncTimer_->scheduleTimeout(std::chrono::milliseconds(0));
   }
 
@@ -1464,22 +2691,122 @@ folly::Expected<size_t, fbzmq::Error>
 KvStoreDb::sendMessageToPeer(
     const std::string& peerSocketId, const thrift::KvStoreRequest& request) {
   auto msg = fbzmq::Message::fromThriftObj(request, serializer_).value();
-  fb303::fbData->addStatValue(
-      "kvstore.peers.bytes_sent", msg.size(), fb303::SUM);
+  bumpStat(hotPathStats_.peerBytesSent, msg.size());
   return peerSyncSock_.sendMultiple(
       fbzmq::Message::from(peerSocketId).value(), fbzmq::Message(), msg);
 }
 
+// Send same request to many peers, serializing only once
+void
+KvStoreDb::floodMessageToPeers(
+    const std::vector<std::string>& peerSocketIds,
+    const thrift::KvStoreRequest& request) {
+  folly::IOBufQueue queue{folly::IOBufQueue::cacheChainLength()};
+  serializer_.serialize(request, &queue);
+  auto serializedRequest = queue.move();
+
+  for (const auto& peerSocketId : peerSocketIds) {
+    // clone() shares the underlying data buffers refcounted; no payload
+    // bytes are copied per peer
+    auto maybeMsg = fbzmq::Message::wrapBuffer(serializedRequest->clone());
+    if (maybeMsg.hasError()) {
+      LOG(ERROR) << "Failed wrapping serialized request: "
+                 << maybeMsg.error();
+      continue;
+    }
+    auto msg = std::move(maybeMsg).value();
+    bumpStat(hotPathStats_.peerBytesSent, msg.size());
+    auto const ret = peerSyncSock_.sendMultiple(
+        fbzmq::Message::from(peerSocketId).value(), fbzmq::Message(), msg);
+    if (ret.hasError()) {
+      // this could be pretty common on initial connection setup
+      LOG(ERROR) << "Failed to flood publication to peer with id "
+                 << peerSocketId << ", error: " << ret.error();
+      collectSendFailureStats(ret.error(), peerSocketId);
+    }
+  }
+}
+
+// bump a batched hot-path stat and arm the drain timer so fb303 exports
+// lag by at most Constants::kStatsDrainInterval
+void
+KvStoreDb::bumpStat(std::atomic<int64_t>& stat, int64_t value) {
+  stat.fetch_add(value, std::memory_order_relaxed);
+  if (statsDrainTimer_ and not statsDrainTimer_->isScheduled()) {
+    statsDrainTimer_->scheduleTimeout(Constants::kStatsDrainInterval);
+  }
+}
+
+void
+KvStoreDb::drainHotPathStats() const {
+  auto const drain = [](std::atomic<int64_t>& stat,
+                        const std::string& key,
+                        fb303::ExportType type) {
+    if (auto const value = stat.exchange(0, std::memory_order_relaxed)) {
+      fb303::fbData->addStatValue(key, value, type);
+    }
+  };
+  drain(
+      hotPathStats_.receivedPublications,
+      "kvstore.received_publications",
+      fb303::COUNT);
+  drain(
+      hotPathStats_.receivedKeyVals, "kvstore.received_key_vals", fb303::SUM);
+  drain(
+      hotPathStats_.receivedRedundantPublications,
+      "kvstore.received_redundant_publications",
+      fb303::COUNT);
+  drain(
+      hotPathStats_.loopedPublications,
+      "kvstore.looped_publications",
+      fb303::COUNT);
+  drain(hotPathStats_.updatedKeyVals, "kvstore.updated_key_vals", fb303::SUM);
+  drain(
+      hotPathStats_.sentPublications,
+      "kvstore.sent_publications",
+      fb303::COUNT);
+  drain(hotPathStats_.sentKeyVals, "kvstore.sent_key_vals", fb303::SUM);
+  drain(
+      hotPathStats_.suppressedDuplicateFloods,
+      "kvstore.duplicate_flood_suppress",
+      fb303::COUNT);
+  drain(hotPathStats_.peerBytesSent, "kvstore.peers.bytes_sent", fb303::SUM);
+  drain(
+      hotPathStats_.peerBytesReceived,
+      "kvstore.peers.bytes_received",
+      fb303::SUM);
+}
+
 std::map<std::string, int64_t>
 KvStoreDb::getCounters() const {
+  // flush batched hot-path stats so fb303 exports are current
+  drainHotPathStats();
+
   std::map<std::string, int64_t> counters;
 
   // Add some more flat counters
   counters["kvstore.num_keys"] = kvStore_.size();
   counters["kvstore.num_peers"] = peers_.size();
+
+  // approximate heap bytes held by the key-value database; scanned per
+  // counter submission so the figure cannot drift from reality
+  int64_t kvStoreBytes = 0;
+  for (auto const& kv : kvStore_) {
+    kvStoreBytes += sizeof(kv.second) + kv.first.size() +
+        kv.second.originatorId.size() +
+        (kv.second.value_ref().has_value() ? kv.second.value_ref()->size()
+                                           : 0);
+  }
+  counters["kvstore.approx_bytes"] = kvStoreBytes;
   // Add up pending and in-flight full sync
-  counters["kvstore.pending_full_sync"] =
+  size_t pendingFullSync =
       peersToSyncWith_.size() + latestSentPeerSync_.size();
+  for (auto const& kv : thriftPeers_) {
+    if (kv.second.state != KvStorePeerState::INITIALIZED) {
+      ++pendingFullSync;
+    }
+  }
+  counters["kvstore.pending_full_sync"] = pendingFullSync;
   return counters;
 }
 
@@ -1501,6 +2828,11 @@ KvStoreDb::delThriftPeers(std::vector<std::string> const& peers) {
     // destruct existing thrift client
     peerIter->second.client.reset();
     thriftPeers_.erase(peerIter);
+
+    // apply anything parked in the peer's reorder buffer and drop the
+    // sequencing state; a re-added peer starts a fresh sequence
+    flushFloodReorderBuffer(peerName);
+    floodReorderStates_.erase(peerName);
   }
 }
 
@@ -1539,6 +2871,17 @@ KvStoreDb::delPeers(std::vector<std::string> const& peers) {
     if (latestSentPeerSync_.count(peerCmdSocketId)) {
       latestSentPeerSync_.erase(peerCmdSocketId);
     }
+    floodEdgeCounters_.erase(peerName);
+    // retire any rebalanced flood parent that just went away; DUAL will
+    // hand us a new nexthop via processNexthopChange() if needed
+    for (auto overrideIt = floodParentOverride_.begin();
+         overrideIt != floodParentOverride_.end();) {
+      if (overrideIt->second == peerName) {
+        overrideIt = floodParentOverride_.erase(overrideIt);
+      } else {
+        ++overrideIt;
+      }
+    }
     peers_.erase(it);
   }
 
@@ -1549,6 +2892,10 @@ KvStoreDb::delPeers(std::vector<std::string> const& peers) {
       DualNode::peerDown(peer);
     }
   }
+
+  // a removed peer may have been the last one we were waiting on for
+  // the initial full-sync
+  checkInitialSyncDone();
 }
 
 // Get full KEY_DUMP from peersToSyncWith_
@@ -1583,11 +2930,21 @@ KvStoreDb::requestFullSyncFromPeers() {
       params.prefix = keyPrefix;
       params.originatorIds = kvParams_.filters.value().getOrigniatorIdList();
     }
-    std::set<std::string> originator{};
-    std::vector<std::string> keyPrefixList{};
-    KvStoreFilters kvFilters{keyPrefixList, originator};
-    params.keyValHashes_ref() =
-        std::move(dumpHashWithFilters(kvFilters).keyVals);
+    if (peersNeedingHashDump_.erase(peerName)) {
+      // digest probe mismatched; fall back to the per-key hash exchange.
+      // Hash dumps come from the COW snapshot - syncing several peers in
+      // one round shares a single (parallel) rebuild
+      params.keyValHashes_ref() = getHashDumpSnapshot()->keyVals;
+      // share our hash-tree view so peer can prune buckets we agree on
+      params.keyValHashTreeBuckets_ref() = hashTree_.bucketHashes();
+    } else {
+      // probe with our hash-tree root digest first. In-sync peers (the
+      // common case on a stable fabric) confirm equality with a few
+      // bytes instead of a per-key hash dump of the whole database
+      params.keyValsRootHash_ref() = hashTree_.rootHash();
+    }
+    // let the responder zstd-compress a large reply for the wire
+    params.acceptCompressedPayload_ref() = true;
 
     dumpRequest.cmd = thrift::Command::KEY_DUMP;
     dumpRequest.keyDumpParams_ref() = params;
@@ -1661,25 +3018,33 @@ void
 KvStoreDb::updatePublicationTtl(
     thrift::Publication& thriftPub, bool removeAboutToExpire) {
   auto timeNow = std::chrono::steady_clock::now();
-  for (const auto& qE : ttlCountdownQueue_) {
-    // Find key and ensure we are taking time from right entry from queue
-    auto kv = thriftPub.keyVals.find(qE.key);
-    if (kv == thriftPub.keyVals.end() or kv->second.version != qE.version or
-        kv->second.originatorId != qE.originatorId or
-        kv->second.ttlVersion != qE.ttlVersion) {
+  for (auto kv = thriftPub.keyVals.begin(); kv != thriftPub.keyVals.end();) {
+    // keys with infinite ttl are never on the countdown wheel; skip the
+    // intern/wheel lookups for them
+    if (kv->second.ttl == Constants::kTtlInfinity) {
+      ++kv;
+      continue;
+    }
+
+    // Lookup wheel entry and ensure we are taking time from right incarnation
+    const auto qE = ttlCountdownWheel_.get(atomTable_.intern(kv->first));
+    if (not qE.has_value() or kv->second.version != qE->version or
+        kv->second.originatorId != *qE->originatorId or
+        kv->second.ttlVersion != qE->ttlVersion) {
+      ++kv;
       continue;
     }
 
     // Compute timeLeft and do sanity check on it
-    auto timeLeft = duration_cast<milliseconds>(qE.expiryTime - timeNow);
+    auto timeLeft = duration_cast<milliseconds>(qE->expiryTime - timeNow);
     if (timeLeft <= kvParams_.ttlDecr) {
-      thriftPub.keyVals.erase(kv);
+      kv = thriftPub.keyVals.erase(kv);
       continue;
     }
 
     // filter key from publication if time left is below ttl threshold
     if (removeAboutToExpire and timeLeft < Constants::kTtlThreshold) {
-      thriftPub.keyVals.erase(kv);
+      kv = thriftPub.keyVals.erase(kv);
       continue;
     }
 
@@ -1687,6 +3052,7 @@ KvStoreDb::updatePublicationTtl(
     // deterministically whenever it is exchanged between KvStores. This will
     // avoid looping of updates between stores.
     kv->second.ttl = timeLeft.count() - kvParams_.ttlDecr.count();
+    ++kv;
   }
 }
 
@@ -1739,6 +3105,7 @@ KvStoreDb::processRequestMsgHelper(
     rcvdPublication.nodeIds_ref().move_from(ketSetParamsVal.nodeIds_ref());
     rcvdPublication.floodRootId_ref().move_from(
         ketSetParamsVal.floodRootId_ref());
+    rcvdPublication.hopTraces_ref().move_from(ketSetParamsVal.hopTraces_ref());
     mergePublication(rcvdPublication);
 
     // respond to the client
@@ -1757,18 +3124,74 @@ KvStoreDb::processRequestMsgHelper(
     auto& keyDumpParamsVal = thriftReq.keyDumpParams_ref().value();
     fb303::fbData->addStatValue("kvstore.cmd_key_dump", 1, fb303::COUNT);
 
+    // digest pre-check: a request carrying the peer's hash-tree root but
+    // no per-key hashes is a cheap in-sync probe. Answer with our own
+    // root only; the dump/difference work below runs solely on the
+    // per-key hash fallback round that follows a digest mismatch
+    if (keyDumpParamsVal.keyValsRootHash_ref().has_value() and
+        not keyDumpParamsVal.keyValHashes_ref().has_value()) {
+      thrift::Publication digestPub;
+      digestPub.keyValsRootHash_ref() = hashTree_.rootHash();
+      if (*keyDumpParamsVal.keyValsRootHash_ref() == hashTree_.rootHash()) {
+        fb303::fbData->addStatValue(
+            "kvstore.full_sync_digest_match", 1, fb303::COUNT);
+      } else {
+        fb303::fbData->addStatValue(
+            "kvstore.full_sync_digest_mismatch", 1, fb303::COUNT);
+      }
+      return fbzmq::Message::fromThriftObj(digestPub, serializer_);
+    }
+
     std::vector<std::string> keyPrefixList;
     folly::split(",", keyDumpParamsVal.prefix, keyPrefixList, true);
     const auto keyPrefixMatch =
         KvStoreFilters(keyPrefixList, keyDumpParamsVal.originatorIds);
-    auto thriftPub = dumpAllWithFilters(keyPrefixMatch);
+    // ttls are fixed up inline while dumping; dumpDifference below only
+    // selects a subset so no second ttl pass is needed
+    auto thriftPub = dumpAllWithFilters(
+        keyPrefixMatch,
+        true /* ttl */,
+        keyDumpParamsVal.startKey_ref().to_optional(),
+        keyDumpParamsVal.maxKeys_ref().to_optional());
+    pruneUnchangedHashTreeBuckets(thriftPub, keyDumpParamsVal);
     if (auto keyValHashes = keyDumpParamsVal.keyValHashes_ref()) {
+      // dumpDifference builds a fresh publication - carry the range
+      // cursor of the dump over to it
+      const auto nextKey = thriftPub.nextKey_ref().to_optional();
       thriftPub = dumpDifference(thriftPub.keyVals, *keyValHashes);
+      fromStdOptional(thriftPub.nextKey_ref(), nextKey);
     }
-    updatePublicationTtl(thriftPub);
     // I'm the initiator, set flood-root-id
     fromStdOptional(thriftPub.floodRootId_ref(), DualNode::getSptRootId());
 
+    // Stream oversized full-sync responses back as bounded KEY_SET chunks
+    // so neither side serializes or merges the whole database in one
+    // message. The KEY_DUMP reply keeps the final chunk along with
+    // tobeUpdatedKeys so the requester's sync completion bookkeeping is
+    // untouched. Chunks ride our sync channel towards the requester, hence
+    // this only kicks in when the requester is also our peer (the normal,
+    // symmetric-peering case); otherwise fall back to one big response
+    if (keyDumpParamsVal.keyValHashes_ref().has_value() and
+        thriftPub.keyVals.size() > Constants::kMaxFullSyncChunkKeyCnt) {
+      // the requester's sync-socket id embeds its node name
+      const auto requesterName =
+          requestId.substr(0, requestId.find("::TCP::SYNC::"));
+      auto peerIt = peers_.find(requesterName);
+      if (peerIt != peers_.end()) {
+        std::unordered_map<std::string, thrift::Value> overflow;
+        while (thriftPub.keyVals.size() > Constants::kMaxFullSyncChunkKeyCnt) {
+          auto it = thriftPub.keyVals.begin();
+          overflow.emplace(it->first, std::move(it->second));
+          thriftPub.keyVals.erase(it);
+        }
+        LOG(INFO) << "Streaming " << overflow.size()
+                  << " key-vals of full-sync response to peer "
+                  << requesterName << " in chunks of "
+                  << Constants::kMaxFullSyncChunkKeyCnt;
+        streamKeyValsToPeer(peerIt->second.second, std::move(overflow));
+      }
+    }
+
     if (keyDumpParamsVal.keyValHashes_ref() and
         keyDumpParamsVal.prefix.empty()) {
       // This usually comes from neighbor nodes
@@ -1781,6 +3204,30 @@ KvStoreDb::processRequestMsgHelper(
                 << " keyValHashes item(s). Sending " << thriftPub.keyVals.size()
                 << " key-vals and " << numMissingKeys << " missing keys";
     }
+
+    // Full syncs between WAN-separated areas move highly repetitive
+    // thrift (keys share long prefixes, values share node names) that
+    // zstd shrinks by roughly an order of magnitude for little CPU.
+    // Compress sizeable replies when the requester advertised support
+    if (keyDumpParamsVal.acceptCompressedPayload_ref().value_or(false)) {
+      const auto plainPub = writeThriftObj(thriftPub, serializer_);
+      const auto plainSize = plainPub->computeChainDataLength();
+      if (plainSize > Constants::kFullSyncCompressionThreshold) {
+        auto compressed = folly::io::getCodec(folly::io::CodecType::ZSTD)
+                              ->compress(plainPub.get());
+        const auto compressedSize = compressed->computeChainDataLength();
+        if (compressedSize < plainSize) {
+          fb303::fbData->addStatValue(
+              "kvstore.full_sync_compression_bytes_saved",
+              plainSize - compressedSize,
+              fb303::SUM);
+          thrift::Publication compressedPub;
+          compressedPub.compressedPayload_ref() =
+              compressed->moveToFbString().toStdString();
+          return fbzmq::Message::fromThriftObj(compressedPub, serializer_);
+        }
+      }
+    }
     return fbzmq::Message::fromThriftObj(thriftPub, serializer_);
   }
   case thrift::Command::DUAL: {
@@ -1846,6 +3293,9 @@ KvStoreDb::processFloodTopoGet() noexcept {
     floodRootId = sptInfos.floodRootId_ref().value();
   }
   sptInfos.floodPeers = getFloodPeers(floodRootId);
+
+  // set per flood-edge traffic counters
+  sptInfos.floodEdgeCounters_ref() = floodEdgeCounters_;
   return sptInfos;
 }
 
@@ -1942,6 +3392,17 @@ KvStoreDb::processNexthopChange(
   LOG(INFO) << "dual nexthop change: root-id (" << rootId << ") " << oldNhStr
             << " -> " << newNhStr;
 
+  // a nexthop change invalidates any rebalanced flood-parent choice for
+  // this root; detach from it and fall back to the DUAL-elected parent
+  // until the next rebalancing pass
+  auto overrideIt = floodParentOverride_.find(rootId);
+  if (overrideIt != floodParentOverride_.end()) {
+    if (peers_.count(overrideIt->second)) {
+      unsetChild(rootId, overrideIt->second);
+    }
+    floodParentOverride_.erase(overrideIt);
+  }
+
   // set new parent if any
   if (newNh.has_value()) {
     // peers_ MUST have this new parent
@@ -1980,11 +3441,98 @@ KvStoreDb::processNexthopChange(
   }
 }
 
+void
+KvStoreDb::rebalanceFloodTopo() noexcept {
+  const auto rootId = DualNode::getSptRootId();
+  if (not rootId.has_value() or *rootId == kvParams_.nodeId) {
+    return;
+  }
+  const auto info = DualNode::getInfo(*rootId);
+  if (not info.has_value() or info->sm.state != DualState::PASSIVE or
+      not info->nexthop.has_value()) {
+    // only rebalance a settled SPT; an active computation will elect a
+    // fresh nexthop anyway (and clear any override via nexthop-change)
+    return;
+  }
+
+  // gather loop-free equal-cost parent candidates: feasible successors
+  // whose distance-through equals our current distance (link cost is
+  // always 1 as we use hop-count as metric). Attaching to any of them
+  // keeps the flood topology an SPT of the same depth
+  std::vector<std::string> candidates;
+  for (const auto& kv : info->neighborInfos) {
+    const auto& neighbor = kv.first;
+    if (kv.second.reportDistance >= info->feasibleDistance or
+        kv.second.reportDistance + 1 != info->distance) {
+      continue;
+    }
+    const auto peerIt = peers_.find(neighbor);
+    if (peerIt == peers_.end() or
+        not peerIt->second.first.supportFloodOptimization) {
+      continue;
+    }
+    candidates.emplace_back(neighbor);
+  }
+
+  const auto overrideIt = floodParentOverride_.find(*rootId);
+  const std::string currentParent = overrideIt != floodParentOverride_.end()
+      ? overrideIt->second
+      : *info->nexthop;
+  if (candidates.size() < 2) {
+    // nothing to spread over. If an override is still active its parent
+    // must have dropped out of the candidate set; nexthop-change or
+    // peer-down cleanup will have detached us already
+    return;
+  }
+
+  // rendezvous-hash (my node-id, candidate): every child picks its
+  // parent independently yet deterministically, so children split
+  // ~uniformly across the candidates instead of all converging on the
+  // DUAL-elected nexthop and overloading root-adjacent nodes
+  std::string target;
+  size_t targetScore{0};
+  for (const auto& candidate : candidates) {
+    const auto score = folly::Hash()(kvParams_.nodeId, candidate);
+    if (target.empty() or score > targetScore or
+        (score == targetScore and candidate < target)) {
+      target = candidate;
+      targetScore = score;
+    }
+  }
+  if (target == currentParent) {
+    return;
+  }
+
+  LOG(INFO) << *rootId << ": rebalancing flood parent " << currentParent
+            << " -> " << target;
+  // attach to the new parent before detaching from the old one so we are
+  // never parentless on the flood topology
+  setChild(*rootId, target);
+  if (peers_.count(currentParent)) {
+    unsetChild(*rootId, currentParent);
+  }
+  if (target == *info->nexthop) {
+    floodParentOverride_.erase(*rootId);
+  } else {
+    floodParentOverride_[*rootId] = target;
+  }
+  fb303::fbData->addStatValue("kvstore.flood_topo_rebalance", 1, fb303::COUNT);
+
+  // mirror processNexthopChange(): full-sync with the new parent closes
+  // any window where an update was flooded before we attached to it
+  peersToSyncWith_.emplace(
+      target,
+      ExponentialBackoff<std::chrono::milliseconds>(
+          Constants::kInitialBackoff, Constants::kMaxBackoff));
+  if (not fullSyncTimer_->isScheduled()) {
+    fullSyncTimer_->scheduleTimeout(std::chrono::milliseconds(0));
+  }
+}
+
 void
 KvStoreDb::processSyncResponse(
     const std::string& requestId, fbzmq::Message&& syncPubMsg) noexcept {
-  fb303::fbData->addStatValue(
-      "kvstore.peers.bytes_received", syncPubMsg.size(), fb303::SUM);
+  bumpStat(hotPathStats_.peerBytesReceived, syncPubMsg.size());
 
   // syncPubMsg can be of two types
   // 1. ack to SET_KEY ("OK" or "ERR")
@@ -2010,7 +3558,48 @@ KvStoreDb::processSyncResponse(
     return;
   }
 
-  const auto& syncPub = maybeSyncPub.value();
+  auto& syncPub = maybeSyncPub.value();
+
+  // a compressed reply carries the real publication as a zstd frame;
+  // inflate it before any further processing
+  if (syncPub.compressedPayload_ref().has_value()) {
+    try {
+      const auto wrapped = folly::IOBuf::wrapBufferAsValue(
+          folly::StringPiece(*syncPub.compressedPayload_ref()));
+      syncPub = readThriftObj<thrift::Publication>(
+          *folly::io::getCodec(folly::io::CodecType::ZSTD)
+               ->uncompress(&wrapped),
+          serializer_);
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Failed to inflate full-sync response from " << requestId
+                 << ". Exception: " << folly::exceptionStr(e);
+      return;
+    }
+  }
+
+  // reply to a digest probe: either an in-sync confirmation or a
+  // mismatch that needs the per-key hash fallback round
+  if (syncPub.keyValsRootHash_ref().has_value() and syncPub.keyVals.empty() and
+      not syncPub.tobeUpdatedKeys_ref().has_value()) {
+    if (*syncPub.keyValsRootHash_ref() == hashTree_.rootHash()) {
+      VLOG(1) << "Digest probe confirmed in-sync with " << requestId;
+    } else {
+      // peerCmdSocketId embeds the peer's node name
+      const auto peerName = requestId.substr(0, requestId.find("::"));
+      VLOG(1) << "Digest probe mismatched with " << peerName
+              << "; scheduling per-key hash full-sync";
+      if (peers_.count(peerName)) {
+        peersNeedingHashDump_.emplace(peerName);
+        peersToSyncWith_.emplace(
+            peerName,
+            ExponentialBackoff<std::chrono::milliseconds>(
+                Constants::kInitialBackoff, Constants::kMaxBackoff));
+      }
+    }
+    // fall through to the common bookkeeping below; there are no
+    // key-vals to merge in a digest reply
+  }
+
   const size_t kvUpdateCnt = mergePublication(syncPub, requestId);
   size_t numMissingKeys = 0;
   if (syncPub.tobeUpdatedKeys_ref().has_value()) {
@@ -2046,6 +3635,9 @@ KvStoreDb::processSyncResponse(
   } else {
     fullSyncTimer_->cancelTimeout();
   }
+
+  // this may have been the last outstanding initial full-sync
+  checkInitialSyncDone();
 }
 
 // send sync request from one neighbor randomly
@@ -2208,41 +3800,49 @@ KvStoreDb::cleanupTtlCountdownQueue() {
   std::vector<std::string> expiredKeys;
   auto now = std::chrono::steady_clock::now();
 
-  // Iterate through ttlCountdownQueue_ until the top expires in the future
-  while (not ttlCountdownQueue_.empty()) {
-    auto top = ttlCountdownQueue_.top();
-    if (top.expiryTime > now) {
-      // Nothing in queue worth evicting
-      break;
-    }
-    auto it = kvStore_.find(top.key);
+  // Advance the timing wheel and evict keys whose entries fired
+  for (const auto& top : ttlCountdownWheel_.advance(now)) {
+    auto it = kvStore_.find(*top.key);
     if (it != kvStore_.end() and it->second.version == top.version and
-        it->second.originatorId == top.originatorId and
+        it->second.originatorId == *top.originatorId and
         it->second.ttlVersion == top.ttlVersion) {
-      expiredKeys.emplace_back(top.key);
+      expiredKeys.emplace_back(*top.key);
       LOG(WARNING)
           << "Delete expired (key, version, originatorId, ttlVersion, ttl, "
           << "node, area) "
           << folly::sformat(
                  "({}, {}, {}, {}, {}, {}, {})",
-                 top.key,
+                 *top.key,
                  it->second.version,
                  it->second.originatorId,
                  it->second.ttlVersion,
                  it->second.ttl,
                  kvParams_.nodeId,
                  area_);
-      logKvEvent("KEY_EXPIRE", top.key);
+      logKvEvent("KEY_EXPIRE", *top.key);
+      hashTree_.update(
+          *top.key, it->second.hash_ref().to_optional(), std::nullopt);
       kvStore_.erase(it);
+      sortedKeys_.erase(top.key);
+      invalidateHashDumpSnapshot(*top.key);
+
+      // Keep a bounded tombstone so incremental dump clients learn about
+      // the expiration; advance the horizon when old ones get discarded
+      keyUpdateSeq_.erase(*top.key);
+      tombstones_.emplace_back(++updateSeq_, *top.key);
+      while (tombstones_.size() > kMaxTombstones) {
+        tombstoneHorizonSeq_ = tombstones_.front().first;
+        tombstones_.pop_front();
+      }
     }
-    ttlCountdownQueue_.pop();
   }
 
-  // Reschedule based on most recent timeout
-  if (not ttlCountdownQueue_.empty()) {
-    ttlCountdownTimer_->scheduleTimeout(
+  // Reschedule for the next wheel wakeup
+  if (auto wakeup = ttlCountdownWheel_.nextWakeup()) {
+    ttlCountdownTimer_->scheduleTimeout(std::max(
+        std::chrono::milliseconds(0),
         std::chrono::duration_cast<std::chrono::milliseconds>(
-            ttlCountdownQueue_.top().expiryTime - now));
+            wakeup.value() - now)));
   }
 
   if (expiredKeys.empty()) {
@@ -2256,6 +3856,63 @@ KvStoreDb::cleanupTtlCountdownQueue() {
   floodPublication(std::move(expiredKeysPub));
 }
 
+void
+KvStoreDb::loadDbSnapshot() {
+  auto maybeSnapshot = kvParams_.configStore
+                           ->loadThriftObj<thrift::Publication>(
+                               kDbSnapshotKeyPrefix + area_)
+                           .get();
+  if (maybeSnapshot.hasError()) {
+    LOG(INFO) << "No db snapshot found on disk for area " << area_
+              << ". Cold booting";
+    return;
+  }
+
+  // Merge snapshot into (empty) kvStore_ and fold the result into the
+  // hash-tree index and ttl countdown wheel. Do NOT flood - peers either
+  // have this data already or will receive it via full-sync
+  auto& snapshot = maybeSnapshot.value();
+  thrift::Publication snapshotPub;
+  snapshotPub.keyVals = KvStore::mergeKeyValues(
+      kvStore_, std::move(snapshot.keyVals), kvParams_.filters);
+  recordKeyUpdates(snapshotPub.keyVals);
+  for (auto const& kv : snapshotPub.keyVals) {
+    auto it = kvStore_.find(kv.first);
+    DCHECK(it != kvStore_.end());
+    hashTree_.update(
+        kv.first, std::nullopt, it->second.hash_ref().to_optional());
+    sortedKeys_.insert(atomTable_.intern(kv.first));
+    invalidateHashDumpSnapshot(kv.first);
+  }
+  snapshotPub.area_ref() = area_;
+  updateTtlCountdownQueue(snapshotPub);
+
+  LOG(INFO) << "Warm booting with " << snapshotPub.keyVals.size()
+            << " key-vals from db snapshot for area " << area_;
+
+  // let local subscribers (e.g. Decision) warm up as well
+  if (not snapshotPub.keyVals.empty()) {
+    kvParams_.kvStoreUpdatesQueue.push(std::move(snapshotPub));
+  }
+}
+
+void
+KvStoreDb::saveDbSnapshot() {
+  // dump everything with remaining ttls so a future load resumes the
+  // countdown instead of granting keys a fresh lease
+  std::vector<std::string> keyPrefixList{};
+  std::set<std::string> originator{};
+  KvStoreFilters kvFilters{keyPrefixList, originator};
+  auto snapshot = dumpAllWithFilters(kvFilters, true /* ttl */);
+  snapshot.area_ref() = area_;
+
+  VLOG(1) << "Persisting db snapshot with " << snapshot.keyVals.size()
+          << " key-vals for area " << area_;
+  kvParams_.configStore
+      ->storeThriftObj(kDbSnapshotKeyPrefix + area_, snapshot)
+      .get();
+}
+
 void
 KvStoreDb::bufferPublication(thrift::Publication&& publication) {
   fb303::fbData->addStatValue("kvstore.rate_limit_suppress", 1, fb303::COUNT);
@@ -2272,6 +3929,13 @@ KvStoreDb::bufferPublication(thrift::Publication&& publication) {
   for (auto const& key : publication.expiredKeys) {
     publicationBuffer_[floodRootId].emplace(key);
   }
+  // park flood-path traces until the buffered keys flush; the wait in the
+  // buffer is part of the latency the trace is meant to expose
+  if (publication.hopTraces_ref().has_value()) {
+    for (auto& kv : *publication.hopTraces_ref()) {
+      pendingFloodTraces_.insert_or_assign(kv.first, std::move(kv.second));
+    }
+  }
 }
 
 void
@@ -2296,6 +3960,17 @@ KvStoreDb::floodBufferedUpdates() {
       auto kvStoreIt = kvStore_.find(key);
       if (kvStoreIt != kvStore_.end()) {
         publication.keyVals.emplace(make_pair(key, kvStoreIt->second));
+        // re-attach the flood-path trace parked when the key was buffered
+        auto traceIt = pendingFloodTraces_.find(key);
+        if (traceIt != pendingFloodTraces_.end()) {
+          if (not publication.hopTraces_ref().has_value()) {
+            publication.hopTraces_ref() =
+                std::map<std::string, thrift::FloodPathTrace>{};
+          }
+          publication.hopTraces_ref()->insert_or_assign(
+              key, std::move(traceIt->second));
+          pendingFloodTraces_.erase(traceIt);
+        }
       } else {
         publication.expiredKeys.emplace_back(key);
       }
@@ -2304,6 +3979,7 @@ KvStoreDb::floodBufferedUpdates() {
   }
 
   publicationBuffer_.clear();
+  pendingFloodTraces_.clear();
 
   for (auto& pub : publications) {
     // when sending out merged publication, we maintain orginal-root-id
@@ -2334,32 +4010,79 @@ KvStoreDb::finalizeFullSync(
   VLOG(1) << "finalizeFullSync back to: " << senderId
           << " with keys: " << folly::join(",", keys);
 
-  thrift::KvStoreRequest updateRequest;
-  thrift::KeySetParams params;
+  streamKeyValsToPeer(senderId, std::move(updates.keyVals));
+}
 
-  params.keyVals = std::move(updates.keyVals);
-  params.solicitResponse = false;
-  // I'm the initiator, set flood-root-id
-  fromStdOptional(params.floodRootId_ref(), DualNode::getSptRootId());
-  params.timestamp_ms_ref() = getUnixTimeStampMs();
+void
+KvStoreDb::streamKeyValsToPeer(
+    const std::string& peerId,
+    std::unordered_map<std::string, thrift::Value>&& keyVals) {
+  std::unordered_map<std::string, thrift::Value> chunk;
+  auto sendChunk = [this, &peerId, &chunk]() {
+    thrift::KeySetParams params;
+
+    params.keyVals = std::move(chunk);
+    params.solicitResponse = false;
+    // I'm the initiator, set flood-root-id
+    fromStdOptional(params.floodRootId_ref(), DualNode::getSptRootId());
+    params.timestamp_ms_ref() = getUnixTimeStampMs();
+
+    VLOG(1) << "sending " << params.keyVals.size() << " key-vals to "
+            << peerId;
+
+    // prefer the thrift session when this peer has a live one. Chunks
+    // share the bounded in-flight flood window towards the peer
+    if (kvParams_.enableKvStoreThrift) {
+      auto thriftPeerIt = thriftPeers_.find(peerId);
+      if (thriftPeerIt != thriftPeers_.end() and thriftPeerIt->second.client) {
+        floodToThriftPeer(peerId, std::move(params));
+        chunk.clear();
+        return;
+      }
+    }
 
-  updateRequest.cmd = thrift::Command::KEY_SET;
-  updateRequest.keySetParams_ref() = params;
-  updateRequest.area_ref() = area_;
+    thrift::KvStoreRequest updateRequest;
+    updateRequest.cmd = thrift::Command::KEY_SET;
+    updateRequest.keySetParams_ref() = std::move(params);
+    updateRequest.area_ref() = area_;
 
-  VLOG(1) << "sending finalizeFullSync back to " << senderId;
-  auto const ret = sendMessageToPeer(senderId, updateRequest);
-  if (ret.hasError()) {
-    // this could fail when senderId goes offline
-    LOG(ERROR) << "Failed to send finalizeFullSync to " << senderId
-               << " using id " << senderId << ", error: " << ret.error();
-    collectSendFailureStats(ret.error(), senderId);
+    auto const ret = sendMessageToPeer(peerId, updateRequest);
+    if (ret.hasError()) {
+      // this could fail when peerId goes offline
+      LOG(ERROR) << "Failed to send key-vals to " << peerId << " using id "
+                 << peerId << ", error: " << ret.error();
+      collectSendFailureStats(ret.error(), peerId);
+    }
+    chunk.clear();
+  };
+
+  for (auto& kv : keyVals) {
+    chunk.emplace(kv.first, std::move(kv.second));
+    if (chunk.size() >= Constants::kMaxFullSyncChunkKeyCnt) {
+      sendChunk();
+    }
+  }
+  if (not chunk.empty()) {
+    sendChunk();
   }
 }
 
 std::unordered_set<std::string>
 KvStoreDb::getFloodPeers(const std::optional<std::string>& rootId) {
   auto sptPeers = DualNode::getSptPeers(rootId);
+  // swap in the rebalanced flood parent (if any) for the DUAL nexthop;
+  // children attached to us are unaffected
+  if (rootId.has_value() and not sptPeers.empty()) {
+    auto overrideIt = floodParentOverride_.find(*rootId);
+    if (overrideIt != floodParentOverride_.end() and
+        peers_.count(overrideIt->second)) {
+      const auto info = DualNode::getInfo(*rootId);
+      if (info.has_value() and info->nexthop.has_value()) {
+        sptPeers.erase(*info->nexthop);
+      }
+      sptPeers.emplace(overrideIt->second);
+    }
+  }
   bool floodToAll = false;
   if (not kvParams_.enableFloodOptimization or sptPeers.empty()) {
     // fall back to naive flooding if feature not enabled or can not find
@@ -2392,6 +4115,59 @@ KvStoreDb::collectSendFailureStats(
 void
 KvStoreDb::floodPublication(
     thrift::Publication&& publication, bool rateLimit, bool setFloodRoot) {
+  // peel off priority keys (e.g. "adj:") and flood them right away so they
+  // never queue behind bulk re-advertisements held back by the rate-limiter
+  // or the coalescing buffer below
+  if (rateLimit and kvParams_.floodPriorityFilters.has_value() and
+      publication.keyVals.size()) {
+    thrift::Publication priorityPub;
+    for (auto it = publication.keyVals.begin();
+         it != publication.keyVals.end();) {
+      if (kvParams_.floodPriorityFilters->keyMatch(it->first, it->second)) {
+        // a flood-path trace follows its key into the priority publication
+        if (publication.hopTraces_ref().has_value()) {
+          auto traceIt = publication.hopTraces_ref()->find(it->first);
+          if (traceIt != publication.hopTraces_ref()->end()) {
+            if (not priorityPub.hopTraces_ref().has_value()) {
+              priorityPub.hopTraces_ref() =
+                  std::map<std::string, thrift::FloodPathTrace>{};
+            }
+            priorityPub.hopTraces_ref()->insert_or_assign(
+                it->first, std::move(traceIt->second));
+            publication.hopTraces_ref()->erase(traceIt);
+          }
+        }
+        priorityPub.keyVals.emplace(it->first, std::move(it->second));
+        it = publication.keyVals.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    if (priorityPub.keyVals.size()) {
+      fb303::fbData->addStatValue(
+          "kvstore.flood_priority_keys",
+          priorityPub.keyVals.size(),
+          fb303::SUM);
+      priorityPub.nodeIds_ref().copy_from(publication.nodeIds_ref());
+      priorityPub.floodRootId_ref().copy_from(publication.floodRootId_ref());
+      sendFloodPublication(std::move(priorityPub), setFloodRoot);
+      if (publication.keyVals.empty() and publication.expiredKeys.empty()) {
+        return;
+      }
+    }
+  }
+  // coalesce publications within the micro-batching window if configured.
+  // Keys are folded into publicationBuffer_ where superseded versions of
+  // the same key collapse into the latest value at flush time, saving one
+  // serialization and socket write per peer per suppressed publication
+  if (rateLimit and kvParams_.floodCoalesceWindow.has_value()) {
+    bufferPublication(std::move(publication));
+    if (not pendingPublicationTimer_->isScheduled()) {
+      pendingPublicationTimer_->scheduleTimeout(
+          kvParams_.floodCoalesceWindow.value());
+    }
+    return;
+  }
   // rate limit if configured
   if (floodLimiter_ && rateLimit && !floodLimiter_->consume(1)) {
     bufferPublication(std::move(publication));
@@ -2404,6 +4180,13 @@ KvStoreDb::floodPublication(
     bufferPublication(std::move(publication));
     return floodBufferedUpdates();
   }
+
+  sendFloodPublication(std::move(publication), setFloodRoot);
+}
+
+void
+KvStoreDb::sendFloodPublication(
+    thrift::Publication&& publication, bool setFloodRoot) {
   // Update ttl on keys we are trying to advertise. Also remove keys which
   // are about to expire.
   updatePublicationTtl(publication, true);
@@ -2428,6 +4211,12 @@ KvStoreDb::floodPublication(
   // Flood publication on local PUB queue
   kvParams_.kvStoreUpdatesQueue.push(publication);
 
+  // Evict suppression state of expired keys so a later re-advertisement
+  // starting over at version 1 is not mistaken for a duplicate
+  for (auto const& key : publication.expiredKeys) {
+    recentFloods_.erase(key);
+  }
+
   //
   // Create request and send only keyValue updates to all neighbors
   //
@@ -2435,11 +4224,59 @@ KvStoreDb::floodPublication(
     return;
   }
 
+  // Drop key-vals whose exact (version, originatorId, ttlVersion) we have
+  // flooded before, e.g. the same update delivered to us by two flood
+  // peers. Suppressing here avoids re-serializing and re-flooding no-op
+  // updates towards every neighbor
+  if (recentFloods_.size() > Constants::kFloodDupCacheMaxSize) {
+    recentFloods_.clear();
+  }
+  for (auto it = publication.keyVals.begin();
+       it != publication.keyVals.end();) {
+    auto const& value = it->second;
+    auto& flooded = recentFloods_[it->first];
+    if (flooded.version == value.version and
+        flooded.ttlVersion == value.ttlVersion and
+        flooded.originatorId == value.originatorId) {
+      bumpStat(hotPathStats_.suppressedDuplicateFloods, 1);
+      it = publication.keyVals.erase(it);
+    } else {
+      flooded.version = value.version;
+      flooded.ttlVersion = value.ttlVersion;
+      flooded.originatorId = value.originatorId;
+      ++it;
+    }
+  }
+  if (publication.keyVals.empty()) {
+    return;
+  }
+
   if (setFloodRoot and not senderId.has_value()) {
     // I'm the initiator, set flood-root-id
     fromStdOptional(publication.floodRootId_ref(), DualNode::getSptRootId());
   }
 
+  // stamp egress time on this node's hop of each carried flood-path trace
+  // and drop traces whose key did not survive the pruning above
+  if (publication.hopTraces_ref().has_value()) {
+    const int64_t egressTimeNs = getUnixTimeStampNs();
+    auto& hopTraces = *publication.hopTraces_ref();
+    for (auto it = hopTraces.begin(); it != hopTraces.end();) {
+      if (not publication.keyVals.count(it->first)) {
+        it = hopTraces.erase(it);
+        continue;
+      }
+      auto& hops = it->second.hops;
+      if (hops.size() and hops.back().nodeId == kvParams_.nodeId) {
+        hops.back().egressTimeNs = egressTimeNs;
+      }
+      ++it;
+    }
+    if (hopTraces.empty()) {
+      publication.hopTraces_ref().reset();
+    }
+  }
+
   thrift::KvStoreRequest floodRequest;
   thrift::KeySetParams params;
 
@@ -2448,6 +4285,7 @@ KvStoreDb::floodPublication(
   params.nodeIds_ref().copy_from(publication.nodeIds_ref());
   params.floodRootId_ref().copy_from(publication.floodRootId_ref());
   params.timestamp_ms_ref() = getUnixTimeStampMs();
+  params.hopTraces_ref().copy_from(publication.hopTraces_ref());
 
   floodRequest.cmd = thrift::Command::KEY_SET;
   floodRequest.keySetParams_ref() = params;
@@ -2458,6 +4296,7 @@ KvStoreDb::floodPublication(
     floodRootId = params.floodRootId_ref().value();
   }
   const auto& floodPeers = getFloodPeers(floodRootId);
+  std::vector<std::string> peerSocketIds;
   for (const auto& peer : floodPeers) {
     if (senderId.has_value() && senderId.value() == peer) {
       // Do not flood towards senderId from whom we received this publication
@@ -2467,31 +4306,165 @@ KvStoreDb::floodPublication(
             << (senderId.has_value() ? senderId.value() : "N/A")
             << ", to: " << peer << ", via: " << kvParams_.nodeId;
 
-    fb303::fbData->addStatValue("kvstore.sent_publications", 1, fb303::COUNT);
-    fb303::fbData->addStatValue(
-        "kvstore.sent_key_vals", publication.keyVals.size(), fb303::SUM);
+    // per-edge accounting feeding the flood-topo load view
+    auto& edgeCounters = floodEdgeCounters_[peer];
+    edgeCounters.publicationsSent += 1;
+    edgeCounters.keyValsSent += publication.keyVals.size();
+
+    // prefer the pipelined thrift sender when this peer has a live
+    // thrift session; stats are bumped when the RPC is issued
+    if (kvParams_.enableKvStoreThrift) {
+      auto thriftPeerIt = thriftPeers_.find(peer);
+      if (thriftPeerIt != thriftPeers_.end() and thriftPeerIt->second.client) {
+        floodToThriftPeer(peer, thrift::KeySetParams(params));
+        continue;
+      }
+    }
 
-    // Send flood request
-    auto const& peerCmdSocketId = peers_.at(peer).second;
-    auto const ret = sendMessageToPeer(peerCmdSocketId, floodRequest);
-    if (ret.hasError()) {
-      // this could be pretty common on initial connection setup
-      LOG(ERROR) << "Failed to flood publication to peer " << peer
-                 << " using id " << peerCmdSocketId
-                 << ", error: " << ret.error();
-      collectSendFailureStats(ret.error(), peerCmdSocketId);
+    bumpStat(hotPathStats_.sentPublications, 1);
+    bumpStat(hotPathStats_.sentKeyVals, publication.keyVals.size());
+    peerSocketIds.emplace_back(peers_.at(peer).second);
+  }
+
+  // Flood request to all selected peers sharing one serialized buffer
+  if (not peerSocketIds.empty()) {
+    floodMessageToPeers(peerSocketIds, floodRequest);
+  }
+}
+
+bool
+KvStoreDb::isTraceSampledKey(std::string const& key) const {
+  return kvParams_.floodTraceSampleRate.has_value() and
+      folly::hash::fnv64(key) % kvParams_.floodTraceSampleRate.value() == 0;
+}
+
+void
+KvStoreDb::appendFloodTraceHops(
+    thrift::Publication const& rcvdPublication,
+    thrift::Publication& deltaPublication) {
+  const int64_t ingressTimeNs = getUnixTimeStampNs();
+  for (auto const& kv : deltaPublication.keyVals) {
+    auto const& key = kv.first;
+    if (not isTraceSampledKey(key)) {
+      continue;
+    }
+    // continue the trace the update arrived with, or start one when the
+    // sampled key enters the fabric here (local set, no trace yet)
+    thrift::FloodPathTrace trace;
+    if (rcvdPublication.hopTraces_ref().has_value()) {
+      auto it = rcvdPublication.hopTraces_ref()->find(key);
+      if (it != rcvdPublication.hopTraces_ref()->end()) {
+        trace = it->second;
+      }
+    }
+    if (trace.hops.size() < kFloodTraceMaxHops) {
+      thrift::FloodTraceHop hop;
+      hop.nodeId = kvParams_.nodeId;
+      hop.ingressTimeNs = ingressTimeNs;
+      hop.egressTimeNs = 0; // stamped when the delta is re-flooded
+      trace.hops.emplace_back(std::move(hop));
+    }
+    // retain a copy for harvest. The local hop's egress is not known yet
+    // and reads zero in harvested records
+    thrift::FloodTraceRecord record;
+    record.key = key;
+    record.trace = trace;
+    harvestedFloodTraces_.emplace_back(std::move(record));
+    while (harvestedFloodTraces_.size() > kFloodTraceMaxHarvested) {
+      harvestedFloodTraces_.pop_front();
+    }
+    if (not deltaPublication.hopTraces_ref().has_value()) {
+      deltaPublication.hopTraces_ref() =
+          std::map<std::string, thrift::FloodPathTrace>{};
+    }
+    deltaPublication.hopTraces_ref()->insert_or_assign(key, std::move(trace));
+  }
+}
+
+std::vector<thrift::FloodTraceRecord>
+KvStoreDb::harvestFloodTraces() {
+  std::vector<thrift::FloodTraceRecord> records(
+      std::make_move_iterator(harvestedFloodTraces_.begin()),
+      std::make_move_iterator(harvestedFloodTraces_.end()));
+  harvestedFloodTraces_.clear();
+  return records;
+}
+
+void
+KvStoreDb::mergeOrderedPublication(
+    std::string const& floodSenderId,
+    int64_t floodSeqNum,
+    thrift::Publication&& rcvdPublication) {
+  auto& state = floodReorderStates_[floodSenderId];
+
+  if (floodSeqNum < state.nextSeqNum) {
+    // sender restarted its sequence (new session) - start over from here
+    state.buffered.clear();
+    state.nextSeqNum = floodSeqNum;
+  }
+
+  if (floodSeqNum > state.nextSeqNum) {
+    // gap towards this sender - park the publication until it fills.
+    // Should the gap never fill (the missing RPC failed), the flush
+    // timeout applies what we have in sequence order; merge stays
+    // version-ordered, so flushing early is safe
+    fb303::fbData->addStatValue("kvstore.flood_reordered", 1, fb303::COUNT);
+    state.buffered.emplace(floodSeqNum, std::move(rcvdPublication));
+    if (state.buffered.size() > Constants::kFloodReorderBufferSize) {
+      flushFloodReorderBuffer(floodSenderId);
+      return;
     }
+    if (not state.flushTimer) {
+      state.flushTimer = folly::AsyncTimeout::make(
+          *evb_->getEvb(), [this, floodSenderId]() noexcept {
+            flushFloodReorderBuffer(floodSenderId);
+          });
+    }
+    if (not state.flushTimer->isScheduled()) {
+      state.flushTimer->scheduleTimeout(Constants::kFloodReorderFlushTimeout);
+    }
+    return;
+  }
+
+  // in order - apply, then drain directly following buffered publications
+  mergePublication(rcvdPublication);
+  state.nextSeqNum = floodSeqNum + 1;
+  auto it = state.buffered.begin();
+  while (it != state.buffered.end() and it->first == state.nextSeqNum) {
+    mergePublication(it->second);
+    state.nextSeqNum = it->first + 1;
+    it = state.buffered.erase(it);
+  }
+  if (state.buffered.empty() and state.flushTimer) {
+    state.flushTimer->cancelTimeout();
+  }
+}
+
+void
+KvStoreDb::flushFloodReorderBuffer(std::string const& floodSenderId) {
+  auto stateIt = floodReorderStates_.find(floodSenderId);
+  if (stateIt == floodReorderStates_.end() or
+      stateIt->second.buffered.empty()) {
+    return;
+  }
+
+  auto& state = stateIt->second;
+  fb303::fbData->addStatValue(
+      "kvstore.flood_reorder_flushed", 1, fb303::COUNT);
+  for (auto& [seqNum, publication] : state.buffered) {
+    mergePublication(publication);
+    state.nextSeqNum = seqNum + 1;
   }
+  state.buffered.clear();
 }
 
 size_t
 KvStoreDb::mergePublication(
-    const thrift::Publication& rcvdPublication,
+    thrift::Publication& rcvdPublication,
     std::optional<std::string> senderId) {
   // Add counters
-  fb303::fbData->addStatValue("kvstore.received_publications", 1, fb303::COUNT);
-  fb303::fbData->addStatValue(
-      "kvstore.received_key_vals", rcvdPublication.keyVals.size(), fb303::SUM);
+  bumpStat(hotPathStats_.receivedPublications, 1);
+  bumpStat(hotPathStats_.receivedKeyVals, rcvdPublication.keyVals.size());
 
   const bool needFinalizeFullSync = senderId.has_value() and
       rcvdPublication.tobeUpdatedKeys_ref().has_value() and
@@ -2507,21 +4480,48 @@ KvStoreDb::mergePublication(
   if (nodeIds.has_value() and
       std::find(nodeIds->begin(), nodeIds->end(), kvParams_.nodeId) !=
           nodeIds->end()) {
-    fb303::fbData->addStatValue("kvstore.looped_publications", 1, fb303::COUNT);
+    bumpStat(hotPathStats_.loopedPublications, 1);
     return 0;
   }
 
-  // Generate delta with local KvStore
+  // Snapshot pre-merge value hashes for incoming keys so the hash-tree
+  // index can be updated incrementally once the delta is known
+  std::unordered_map<std::string, std::optional<int64_t>> oldValueHashes;
+  for (auto const& kv : rcvdPublication.keyVals) {
+    std::optional<int64_t> oldHash;
+    auto it = kvStore_.find(kv.first);
+    if (it != kvStore_.end()) {
+      oldHash = it->second.hash_ref().to_optional();
+    }
+    oldValueHashes.emplace(kv.first, oldHash);
+  }
+
+  // Generate delta with local KvStore. The received key-vals are consumed -
+  // winning values move into kvStore_ without another blob copy and the
+  // publication's remaining heap is released wholesale by the caller
   thrift::Publication deltaPublication;
   deltaPublication.keyVals = KvStore::mergeKeyValues(
-      kvStore_, rcvdPublication.keyVals, kvParams_.filters);
+      kvStore_, std::move(rcvdPublication.keyVals), kvParams_.filters);
+  recordKeyUpdates(deltaPublication.keyVals);
+
+  // Fold applied updates into the hash-tree index and the sorted key
+  // index (insertion of an already-indexed key is a no-op)
+  for (auto const& kv : deltaPublication.keyVals) {
+    auto it = kvStore_.find(kv.first);
+    DCHECK(it != kvStore_.end());
+    hashTree_.update(
+        kv.first,
+        oldValueHashes.at(kv.first),
+        it->second.hash_ref().to_optional());
+    sortedKeys_.insert(atomTable_.intern(kv.first));
+    invalidateHashDumpSnapshot(kv.first);
+  }
   deltaPublication.floodRootId_ref().copy_from(
       rcvdPublication.floodRootId_ref());
   deltaPublication.area_ref() = area_;
 
   const size_t kvUpdateCnt = deltaPublication.keyVals.size();
-  fb303::fbData->addStatValue(
-      "kvstore.updated_key_vals", kvUpdateCnt, fb303::SUM);
+  bumpStat(hotPathStats_.updatedKeyVals, kvUpdateCnt);
 
   // Populate nodeIds and our nodeId_ to the end
   if (rcvdPublication.nodeIds_ref().has_value()) {
@@ -2531,13 +4531,18 @@ KvStoreDb::mergePublication(
   // Update ttl values of keys
   updateTtlCountdownQueue(deltaPublication);
 
+  // opt-in flood-path tracing: sampled keys in the delta carry per-hop
+  // ingress/egress timestamps onward
+  if (kvParams_.floodTraceSampleRate.has_value()) {
+    appendFloodTraceHops(rcvdPublication, deltaPublication);
+  }
+
   if (not deltaPublication.keyVals.empty()) {
     // Flood change to all of our neighbors/subscribers
     floodPublication(std::move(deltaPublication));
   } else {
     // Keep track of received publications which din't update any field
-    fb303::fbData->addStatValue(
-        "kvstore.received_redundant_publications", 1, fb303::COUNT);
+    bumpStat(hotPathStats_.receivedRedundantPublications, 1);
   }
 
   // response to senderId with tobeUpdatedKeys + Vals
@@ -2562,7 +4567,7 @@ KvStoreDb::logSyncEvent(
   fbzmq::thrift::EventLog eventLog;
   eventLog.category = Constants::kEventLogCategory.toString();
   eventLog.samples = {sample.toJson()};
-  kvParams_.zmqMonitorClient->addEventLog(std::move(eventLog));
+  kvParams_.eventLogger->log(std::move(eventLog));
 }
 
 void
@@ -2576,7 +4581,7 @@ KvStoreDb::logKvEvent(const std::string& event, const std::string& key) {
   fbzmq::thrift::EventLog eventLog;
   eventLog.category = Constants::kEventLogCategory.toString();
   eventLog.samples = {sample.toJson()};
-  kvParams_.zmqMonitorClient->addEventLog(std::move(eventLog));
+  kvParams_.eventLogger->log(std::move(eventLog));
 }
 
 bool
@@ -2586,6 +4591,39 @@ KvStoreDb::sendDualMessages(
     LOG(ERROR) << "fail to send dual messages to " << neighbor << ", not exist";
     return false;
   }
+  // append onto whatever this tick already queued for the neighbor; all
+  // payloads originate locally so the srcId is the same across them
+  auto& pending = dualMessagesBuffer_[neighbor];
+  pending.srcId = msgs.srcId;
+  pending.messages.insert(
+      pending.messages.end(), msgs.messages.begin(), msgs.messages.end());
+  if (not dualMessagesTimer_->isScheduled()) {
+    dualMessagesTimer_->scheduleTimeout(std::chrono::milliseconds(0));
+  }
+  return true;
+}
+
+void
+KvStoreDb::flushPendingDualMessages() noexcept {
+  std::unordered_map<std::string, thrift::DualMessages> toSend;
+  toSend.swap(dualMessagesBuffer_);
+  for (auto& kv : toSend) {
+    if (kv.second.messages.empty()) {
+      continue;
+    }
+    sendDualMessagesToPeer(kv.first, kv.second);
+  }
+}
+
+bool
+KvStoreDb::sendDualMessagesToPeer(
+    const std::string& neighbor, const thrift::DualMessages& msgs) noexcept {
+  if (peers_.count(neighbor) == 0) {
+    // peer went away between enqueue and flush; dual will be told via
+    // peerDown and clean up after itself
+    LOG(ERROR) << "fail to send dual messages to " << neighbor << ", not exist";
+    return false;
+  }
   const auto& neighborCmdSocketId = peers_.at(neighbor).second;
   thrift::KvStoreRequest dualRequest;
   dualRequest.cmd = thrift::Command::DUAL;
@@ -7,23 +7,36 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <deque>
+#include <functional>
+#include <list>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <thread>
+#include <unordered_set>
 
-#include <boost/heap/priority_queue.hpp>
 #include <boost/serialization/strong_typedef.hpp>
 #include <fbzmq/service/monitor/ZmqMonitorClient.h>
 #include <fbzmq/zmq/Zmq.h>
 #include <folly/Optional.h>
 #include <folly/TokenBucket.h>
+#include <folly/container/F14Map.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/futures/Future.h>
 #include <folly/io/IOBuf.h>
 #include <folly/io/async/AsyncTimeout.h>
+#if FOLLY_HAS_COROUTINES
+#include <folly/experimental/coro/Task.h>
+#endif
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 
 #include <openr/common/Constants.h>
+#include <openr/common/EventLogger.h>
 #include <openr/common/ExponentialBackoff.h>
 #include <openr/common/OpenrClient.h>
 #include <openr/common/OpenrEventBase.h>
@@ -39,6 +52,8 @@
 
 namespace openr {
 
+class PersistentStore;
+
 //
 // Define KvStorePeerState to maintain peer's state transition
 // during peer coming UP/DOWN for initial sync.
@@ -61,23 +76,188 @@ enum class KvStorePeerEvent {
   THRIFT_API_ERROR = 4,
 };
 
+// Interned immutable string. Atoms obtained from the same StringAtomTable
+// are canonical: equal strings share one allocation and compare by pointer
+using StringAtom = std::shared_ptr<const std::string>;
+
+//
+// Interning pool (atom table) for strings that repeat heavily across the
+// store, e.g. key names and originator node-ids. Interning collapses the
+// many duplicate copies kept in per-key bookkeeping structures into one
+// allocation per distinct string.
+//
+class StringAtomTable {
+ public:
+  // return the canonical atom for given string, creating one if needed
+  StringAtom intern(std::string const& str);
+
+  // number of tracked atoms (expired ones are collected lazily)
+  size_t
+  size() const {
+    return atoms_.size();
+  }
+
+ private:
+  // drop atoms whose last outside reference is gone once per this many
+  // intern() calls
+  static constexpr size_t kCleanupInterval{1024};
+
+  std::unordered_map<std::string, std::weak_ptr<const std::string>> atoms_;
+  size_t internsSinceCleanup_{0};
+};
+
+// orders key atoms by the key text they point at. Transparent so ranges
+// can be probed with plain strings without interning them first
+struct StringAtomLess {
+  using is_transparent = void;
+
+  bool
+  operator()(StringAtom const& lhs, StringAtom const& rhs) const {
+    return *lhs < *rhs;
+  }
+  bool
+  operator()(StringAtom const& lhs, std::string const& rhs) const {
+    return *lhs < rhs;
+  }
+  bool
+  operator()(std::string const& lhs, StringAtom const& rhs) const {
+    return lhs < *rhs;
+  }
+};
+
+// container backing the per-area key-value database. F14's flat probing
+// table iterates contiguously and carries none of the per-node heap
+// overhead std::unordered_map pays at the 100k+ key scale. No code holds
+// references into the store across mutations, so the value relocation on
+// rehash/erase that comes with the flat layout is safe here
+using KvStoreDatabase = folly::F14FastMap<std::string, thrift::Value>;
+
 struct TtlCountdownQueueEntry {
   std::chrono::steady_clock::time_point expiryTime;
-  std::string key;
+  StringAtom key;
   int64_t version{0};
   int64_t ttlVersion{0};
-  std::string originatorId;
+  StringAtom originatorId;
+};
+
+//
+// Hierarchical timing wheel tracking TTL expiry of kvstore keys. Each key
+// holds exactly one entry which is reused across TTL refreshes, giving O(1)
+// insert/cancel without the heap churn and dead entries a priority queue
+// accumulates under periodic TTL refreshes.
+//
+class TtlCountdownWheel {
+ public:
+  // wheel geometry: 4 levels of 256 slots. Level-0 slots are one tick wide
+  // and each level up covers 256x the span of the previous one
+  static constexpr size_t kNumLevels{4};
+  static constexpr size_t kSlotsPerLevel{256};
+  static constexpr std::chrono::milliseconds kTickInterval{64};
+
+  TtlCountdownWheel();
+
+  // insert or refresh the entry for entry.key. Any previous entry for the
+  // same key is cancelled in O(1). Key atoms must come from one atom table
+  // so that identical keys share a canonical pointer
+  void insertOrUpdate(TtlCountdownQueueEntry entry);
+
+  // return the current entry for given key if any
+  std::optional<TtlCountdownQueueEntry> get(StringAtom const& key) const;
+
+  // pop and return all entries expiring at or before the given time point
+  std::vector<TtlCountdownQueueEntry> advance(
+      std::chrono::steady_clock::time_point now);
+
+  // next time point advance() should be driven; std::nullopt if empty
+  std::optional<std::chrono::steady_clock::time_point> nextWakeup() const;
+
   bool
-  operator>(TtlCountdownQueueEntry other) const {
-    return expiryTime > other.expiryTime;
+  empty() const {
+    return entries_.empty();
+  }
+
+  size_t
+  size() const {
+    return entries_.size();
   }
+
+ private:
+  using SlotList = std::list<StringAtom>;
+
+  struct WheelEntry {
+    TtlCountdownQueueEntry entry;
+    size_t level{0};
+    size_t slot{0};
+    SlotList::iterator slotIt;
+  };
+
+  // absolute tick number for given time point (rounded up so entries never
+  // fire before their slot is processed)
+  int64_t tickOf(std::chrono::steady_clock::time_point tp) const;
+
+  // place an entry on the wheel relative to the current cursor position
+  void schedule(StringAtom const& key, WheelEntry& wheelEntry);
+
+  // reference point for tick arithmetic
+  const std::chrono::steady_clock::time_point startTime_;
+
+  // last processed absolute tick (wheel cursor)
+  int64_t currentTick_{0};
+
+  // slot lists per level holding key atoms of resident entries
+  std::array<std::array<SlotList, kSlotsPerLevel>, kNumLevels> slots_;
+
+  // per-key wheel entries; keyed by canonical atom (pointer hash/compare)
+  // and holding the slot position for O(1) cancellation
+  std::unordered_map<StringAtom, WheelEntry> entries_;
 };
 
-using TtlCountdownQueue = boost::heap::priority_queue<
-    TtlCountdownQueueEntry,
-    // Always returns smallest first
-    boost::heap::compare<std::greater<TtlCountdownQueueEntry>>,
-    boost::heap::stable<true>>;
+//
+// Incrementally maintained hash-tree (Merkle style) index over the key-vals
+// of a KvStoreDb. Keys are hashed into a fixed set of leaf buckets and each
+// bucket folds the hashes of the entries it holds; the root summarises all
+// buckets. During full-sync, peers exchange the per-bucket hashes so the
+// responder only has to consider keys in buckets that actually diverge,
+// making sync cost proportional to the delta instead of the database size.
+//
+class KvStoreHashTree {
+ public:
+  // number of leaf buckets. Keys are distributed over buckets by key-hash.
+  static constexpr int32_t kNumBuckets{1024};
+
+  // fold a single key-val mutation into the tree. oldHash must be provided
+  // if the key existed before the mutation, newHash if it exists after.
+  // (key-add => no oldHash, key-expiry => no newHash)
+  void update(
+      std::string const& key,
+      std::optional<int64_t> oldHash,
+      std::optional<int64_t> newHash);
+
+  // hash summarising the whole database
+  int64_t rootHash() const;
+
+  // per-bucket hashes. Empty buckets are omitted
+  std::unordered_map<int32_t, int64_t> bucketHashes() const;
+
+  // compare peer's bucket hashes against ours and return ids of buckets
+  // whose contents diverge
+  std::unordered_set<int32_t> diffBuckets(
+      std::unordered_map<int32_t, int64_t> const& peerBucketHashes) const;
+
+  // leaf bucket a given key falls into
+  static int32_t bucketIndex(std::string const& key);
+
+ private:
+  // hash contribution of a single <key, value-hash> entry
+  static int64_t entryHash(std::string const& key, int64_t valueHash);
+
+  // XOR-folded entry hashes per leaf bucket. XOR folding allows O(1)
+  // incremental add/remove of entries
+  std::array<int64_t, kNumBuckets> buckets_{};
+
+  // folded bucket hashes, maintained incrementally with buckets_
+  int64_t rootHash_{0};
+};
 
 class KvStoreFilters {
  public:
@@ -90,6 +270,15 @@ class KvStoreFilters {
   // Check if key matches the filters
   bool keyMatch(std::string const& key, thrift::Value const& value) const;
 
+  // Check if key matches the key-prefix filters only. Used for keys that no
+  // longer carry a value (e.g. expired keys). Empty prefix list matches all
+  bool keyPrefixMatch(std::string const& key) const;
+
+  // true when the filter is a non-empty list of plain literal key prefixes
+  // with no originator-id filter, i.e. the matching keys form a union of
+  // contiguous ranges in lexicographic key order
+  bool isPlainPrefixMatch() const;
+
   // return comma separeated string prefix
   std::vector<std::string> getKeyPrefixes() const;
 
@@ -133,11 +322,33 @@ struct KvStoreParams {
   std::optional<KvStoreFilters> filters;
   // Kvstore flooding rate
   std::optional<thrift::KvstoreFloodRate> floodRate;
+  // micro-batching window to coalesce outbound publications
+  std::optional<std::chrono::milliseconds> floodCoalesceWindow{std::nullopt};
+  // keys matching these filters are flooded ahead of buffered bulk traffic
+  std::optional<KvStoreFilters> floodPriorityFilters{std::nullopt};
+  // flood-path tracing: one in this many keys (elected deterministically
+  // on the key, so every node traces the same subset) carries per-hop
+  // ingress/egress timestamps while flooding. Disabled when unset
+  std::optional<uint32_t> floodTraceSampleRate{std::nullopt};
   // TTL decrement factor
   std::chrono::milliseconds ttlDecr{Constants::kTtlDecrement};
   bool enableFloodOptimization{false};
   bool isFloodRoot{false};
   std::shared_ptr<fbzmq::ZmqMonitorClient> zmqMonitorClient{nullptr};
+  // async event-log submitter wrapping zmqMonitorClient; logging on the
+  // kvstore threads costs a single bounded enqueue
+  std::shared_ptr<EventLogger> eventLogger{nullptr};
+  // persistent store for warm-boot db snapshots; nullptr disables them
+  PersistentStore* configStore{nullptr};
+  // how often to snapshot the db to configStore
+  std::optional<std::chrono::seconds> snapshotInterval{std::nullopt};
+  // worker pool shared by all areas for parallel hash-dump snapshot
+  // rebuilds; nullptr falls back to serial rebuilds
+  std::shared_ptr<folly::CPUThreadPoolExecutor> hashDumpExecutor{nullptr};
+  // invoked (at most once per area, from the area's event base) when the
+  // area completes its initial full-sync with all configured peers
+  std::function<void(std::string const& area)> initialSyncDoneCallback{
+      nullptr};
 
   KvStoreParams(
       std::string nodeid,
@@ -199,26 +410,97 @@ class KvStoreDb : public DualNode {
 
   // dump the entries of my KV store whose keys match the given prefix
   // if prefix is the empty sting, the full KV store is dumped
-  thrift::Publication dumpAllWithFilters(KvStoreFilters const& kvFilters) const;
+  // updateTtl: apply the wire ttl fix-up (remaining time minus decrement)
+  // inline while copying, sparing large dump responses the second
+  // string-keyed pass of updatePublicationTtl and the deep copy of
+  // values that are dropped as expired.
+  // Filters made of literal key prefixes are served by range scans over
+  // the sorted key index instead of a full-table walk.
+  // startKey/maxKeys: optional range-dump window (see thrift
+  // KeyDumpParams). Keys strictly greater than startKey are walked in
+  // sorted order and the dump stops after maxKeys entries, stamping the
+  // resume cursor into Publication.nextKey when keys remain
+  thrift::Publication dumpAllWithFilters(
+      KvStoreFilters const& kvFilters,
+      bool updateTtl = false,
+      std::optional<std::string> const& startKey = std::nullopt,
+      std::optional<int32_t> maxKeys = std::nullopt);
 
   // dump the hashes of my KV store whose keys match the given prefix
-  // if prefix is the empty sting, the full hash store is dumped
+  // if prefix is the empty sting, the full hash store is dumped.
+  // Literal-prefix filters take the same range-scan fast path as
+  // dumpAllWithFilters()
   thrift::Publication dumpHashWithFilters(
       KvStoreFilters const& kvFilters) const;
 
+  // full (unfiltered) hash dump of the store as a copy-on-write snapshot.
+  // The snapshot is invalidated whenever the store mutates and rebuilt
+  // lazily on the next call; repeated dumps between store changes (e.g.
+  // syncing several peers) share one snapshot. When only a small slice of
+  // the store changed since the last build, the rebuild patches the
+  // previous snapshot in place - recomputing just the mutated keys and
+  // carrying the near-static bulk over untouched - so steady churn of a
+  // few hot keys (adjacencies) no longer costs a full-store rescan per
+  // sync. Rebuilds from scratch are partitioned over contiguous ranges of
+  // the sorted key index on kvParams_.hashDumpExecutor so they take a
+  // fraction of the serial scan. TTLs carry the remaining time, minus the
+  // decrement, as of the rebuild that last touched the key
+  std::shared_ptr<const thrift::Publication> getHashDumpSnapshot();
+
+  // drop the served hash dump snapshot and mark the key as mutated since
+  // the retained base snapshot was built, so the next getHashDumpSnapshot()
+  // call can patch the base instead of rebuilding from scratch. Must be
+  // called for every key a store mutation touches
+  void invalidateHashDumpSnapshot(std::string const& key);
+
+  // current per-area update sequence; dump responses carry it as the
+  // client's cursor for incremental re-syncs after short disconnects
+  int64_t
+  getUpdateSeq() const {
+    return updateSeq_;
+  }
+
+  // prune keys from a full-dump publication (and from the peer provided
+  // keyValHashes if any) which fall into hash-tree buckets that match the
+  // peer's view. no-op if peer did not supply its bucket hashes
+  void pruneUnchangedHashTreeBuckets(
+      thrift::Publication& thriftPub, thrift::KeyDumpParams& params) const;
+
   // dump the keys on which hashes differ from given keyVals
   thrift::Publication dumpDifference(
       std::unordered_map<std::string, thrift::Value> const& myKeyVal,
       std::unordered_map<std::string, thrift::Value> const& reqKeyVal) const;
 
+  // narrow a full-dump publication down to key-vals updated after the
+  // given cursor and keys expired since then, and stamp the current
+  // sequence as the new cursor. A cursor older than the retained
+  // expiration history leaves the full dump untouched
+  void filterPublicationBySeq(
+      thrift::Publication& thriftPub, int64_t sinceSeq);
+
   // Merge received publication with local store and publish out the delta.
   // If senderId is set, will build <key:value> map from kvStore_ and
-  // rcvdPublication.tobeUpdatedKeys and send back to senderId to update it
+  // rcvdPublication.tobeUpdatedKeys and send back to senderId to update it.
+  // NOTE: consumes rcvdPublication.keyVals - winning values are moved into
+  // the store, so the publication must not be read for values afterwards
   // @return: Number of KV updates applied
   size_t mergePublication(
-      thrift::Publication const& rcvdPublication,
+      thrift::Publication& rcvdPublication,
       std::optional<std::string> senderId = std::nullopt);
 
+  // Sequenced flavor of mergePublication for pipelined thrift floods.
+  // Publications from one direct sender carry a per-peer send counter;
+  // an in-order publication is merged right away (followed by any
+  // directly following buffered ones), while one arriving ahead of a gap
+  // is parked until the gap fills, the buffer overflows or a short flush
+  // timeout fires. Merging stays version-ordered and idempotent, so the
+  // buffer only avoids transient old-over-new races within the sender's
+  // pipeline window - flushing early is always safe
+  void mergeOrderedPublication(
+      std::string const& floodSenderId,
+      int64_t floodSeqNum,
+      thrift::Publication&& rcvdPublication);
+
   // update Time to expire filed in Publication
   // removeAboutToExpire: knob to remove keys which are about to expire
   // and hence do not want to include them. Constants::kTtlThreshold
@@ -232,6 +514,15 @@ class KvStoreDb : public DualNode {
   void addThriftPeers(
       std::unordered_map<std::string, thrift::PeerSpec> const& peers);
 
+  // queue a publication for flooding towards a thrift peer and kick the
+  // pipelined sender
+  void floodToThriftPeer(
+      const std::string& peerName, thrift::KeySetParams&& params);
+
+  // issue queued flood RPCs towards the peer until its in-flight window
+  // is full, its token bucket runs dry or the queue is empty
+  void drainPeerFloodQueue(const std::string& peerName);
+
   // delete some peers we are subscribed to
   void delPeers(std::vector<std::string> const& peers);
 
@@ -248,6 +539,11 @@ class KvStoreDb : public DualNode {
   // get current snapshot of SPT(s) information
   thrift::SptInfos processFloodTopoGet() noexcept;
 
+  // drain the bounded buffer of flood-path traces recorded at this node
+  // for sampled keys. Always empty unless tracing is enabled (see
+  // KvStoreParams::floodTraceSampleRate)
+  std::vector<thrift::FloodTraceRecord> harvestFloodTraces();
+
   // util function for state transition
   static KvStorePeerState getNextState(
       std::optional<KvStorePeerState> const& currState,
@@ -277,11 +573,26 @@ class KvStoreDb : public DualNode {
   // util function to process when exception encountered
   void processThriftSyncFailure(std::string const& peerName);
 
-  // send dual messages over syncSock
+  // check whether the initial full-sync with all configured peers has
+  // completed and, the first time it has, report it upwards via
+  // kvParams_.initialSyncDoneCallback. Invoked whenever a full-sync
+  // finishes or a pending peer goes away
+  void checkInitialSyncDone();
+
+  // buffer dual messages for neighbor; the actual wire send happens once
+  // per event-loop iteration via flushPendingDualMessages() so bursts (e.g.
+  // root failover) collapse into one payload per neighbor
   bool sendDualMessages(
       const std::string& neighbor,
       const thrift::DualMessages& msgs) noexcept override;
 
+  // send a single aggregated dual-messages payload over syncSock
+  bool sendDualMessagesToPeer(
+      const std::string& neighbor, const thrift::DualMessages& msgs) noexcept;
+
+  // send out dual messages accumulated in dualMessagesBuffer_
+  void flushPendingDualMessages() noexcept;
+
   // send topology-set command to peer, peer will set/unset me as child
   // rootId: action will applied on given rootId
   // peerName: peer name
@@ -311,6 +622,11 @@ class KvStoreDb : public DualNode {
       const std::optional<std::string>& oldNh,
       const std::optional<std::string>& newNh) noexcept override;
 
+  // periodic flood-topology rebalancing pass: re-elect our flood parent
+  // among loop-free equal-cost candidates so children spread across the
+  // area instead of all attaching to the DUAL-elected nexthop
+  void rebalanceFloodTopo() noexcept;
+
   // get flooding peers for a given spt-root-id
   // if rootId is none => flood to all physical peers
   // else only flood to formed SPT-peers for rootId
@@ -337,6 +653,18 @@ class KvStoreDb : public DualNode {
   // periodically count down and purge expired keys from CountdownQueue
   void cleanupTtlCountdownQueue();
 
+  // record applied key-val updates in the per-key sequence bookkeeping
+  // backing the incremental dump API
+  void recordKeyUpdates(
+      std::unordered_map<std::string, thrift::Value> const& keyVals);
+
+  // load warm-boot snapshot from configStore at startup and merge it into
+  // kvStore_ so only deltas need to be synced from peers
+  void loadDbSnapshot();
+
+  // persist current key-vals (with remaining ttls) to configStore
+  void saveDbSnapshot();
+
   // Function to flood publication to neighbors
   // publication => data element to flood
   // rateLimit => if 'false', publication will not be rate limited
@@ -346,12 +674,43 @@ class KvStoreDb : public DualNode {
       bool rateLimit = true,
       bool setFloodRoot = true);
 
+  // send a publication to flood peers right away, bypassing the
+  // rate-limiter and coalescing buffer. Tail half of floodPublication,
+  // also used to preempt buffered bulk traffic with priority keys
+  void sendFloodPublication(
+      thrift::Publication&& publication, bool setFloodRoot);
+
+  // merge whatever is parked in a sender's reorder buffer in sequence
+  // order and advance the expected sequence past it. Invoked on buffer
+  // overflow and from the flush timeout
+  void flushFloodReorderBuffer(std::string const& floodSenderId);
+
+  // true for keys elected into the flood-path trace sample. Deterministic
+  // on the key so every node traces the same subset without coordination
+  bool isTraceSampledKey(std::string const& key) const;
+
+  // flood-path tracing hook on the merge path: extend traces arriving
+  // with the received publication by this node's hop (ingress stamped
+  // now, egress filled when the delta is re-flooded), start fresh traces
+  // for sampled keys entering the fabric here, and retain a copy of each
+  // for harvest
+  void appendFloodTraceHops(
+      thrift::Publication const& rcvdPublication,
+      thrift::Publication& deltaPublication);
+
   // perform last step as a 3-way full-sync request
   // full-sync initiator sends back key-val to senderId (where we made
   // full-sync request to) who need to update those keys
   void finalizeFullSync(
       const std::vector<std::string>& keys, const std::string& senderId);
 
+  // stream key-vals to a peer as a sequence of KEY_SET requests, each
+  // carrying at most Constants::kMaxFullSyncChunkKeyCnt entries, so large
+  // syncs never materialize as one monolithic message
+  void streamKeyValsToPeer(
+      const std::string& peerId,
+      std::unordered_map<std::string, thrift::Value>&& keyVals);
+
   // process received KV_DUMP from one of our neighbor
   void processSyncResponse(
       const std::string& requestId, fbzmq::Message&& syncPubMsg) noexcept;
@@ -370,6 +729,12 @@ class KvStoreDb : public DualNode {
   // Submit events to monitor
   void logKvEvent(const std::string& event, const std::string& key);
 
+  // bump a batched hot-path stat and arm the drain timer
+  void bumpStat(std::atomic<int64_t>& stat, int64_t value);
+
+  // drain batched hot-path stats into fb303
+  void drainHotPathStats() const;
+
   // buffer publications blocked by the rate limiter
   void bufferPublication(thrift::Publication&& publication);
 
@@ -380,6 +745,13 @@ class KvStoreDb : public DualNode {
   folly::Expected<size_t, fbzmq::Error> sendMessageToPeer(
       const std::string& peerSocketId, const thrift::KvStoreRequest& request);
 
+  // Send same request to a set of peers. The request is serialized exactly
+  // once into an IOBuf chain whose refcounted buffers are shared across all
+  // peer transmissions (no per-peer serialization or payload copy)
+  void floodMessageToPeers(
+      const std::vector<std::string>& peerSocketIds,
+      const thrift::KvStoreRequest& request);
+
   //
   // Private variables
   //
@@ -424,8 +796,86 @@ class KvStoreDb : public DualNode {
 
     // thrift client for this peer
     std::unique_ptr<thrift::OpenrCtrlCppAsyncClient> client{nullptr};
+
+    // publications waiting for a free slot in the flood window
+    std::deque<thrift::KeySetParams> pendingFloods;
+
+    // number of flood RPCs currently in flight towards this peer,
+    // bounded by Constants::kMaxFloodInFlightPerPeer
+    size_t inFlightFloods{0};
+
+    // per-peer send counter stamped on pipelined flood RPCs so the
+    // receiver can restore send order within the window
+    int64_t nextFloodSeqNum{0};
+
+    // adaptive flood rate towards this peer (publications/sec), moved
+    // between Constants::kPeerFloodRateMin/Max by AIMD on observed flood
+    // RPC latency. Starts at max so fast peers are never capped; a slow
+    // peer backs itself off within a few acks
+    double floodRate{Constants::kPeerFloodRateMax};
+
+    // token bucket enforcing floodRate; the rate is supplied per consume()
+    // call so AIMD adjustments take effect immediately
+    folly::BasicDynamicTokenBucket<> floodBucket{};
+
+    // lazily created timeout to resume draining pendingFloods once
+    // floodBucket refills
+    std::unique_ptr<folly::AsyncTimeout> floodDrainTimer{nullptr};
+
+    // cursor (the peer's update sequence) from the last successful sync
+    // response and when it arrived. A peer bouncing back within
+    // Constants::kPeerResyncGraceWindow is asked for just the tail since
+    // the cursor instead of a full-database dump
+    std::optional<int64_t> lastSyncSeq{std::nullopt};
+    std::chrono::steady_clock::time_point lastSyncTime{};
   };
 
+  // AIMD update of the peer's adaptive flood rate after an ack (timely or
+  // late) or a failed flood RPC
+  void adjustFloodRate(KvStorePeer& peer, bool timely);
+
+  // Batched hot-path stat accounting. Flood and merge code bumps these
+  // relaxed atomics instead of calling into fb303 per publication; they
+  // are drained into fb303 whenever counters are read
+  struct HotPathStats {
+    std::atomic<int64_t> receivedPublications{0};
+    std::atomic<int64_t> receivedKeyVals{0};
+    std::atomic<int64_t> receivedRedundantPublications{0};
+    std::atomic<int64_t> loopedPublications{0};
+    std::atomic<int64_t> updatedKeyVals{0};
+    std::atomic<int64_t> sentPublications{0};
+    std::atomic<int64_t> sentKeyVals{0};
+    std::atomic<int64_t> suppressedDuplicateFloods{0};
+    std::atomic<int64_t> peerBytesSent{0};
+    std::atomic<int64_t> peerBytesReceived{0};
+  };
+  mutable HotPathStats hotPathStats_;
+
+  // last flooded (version, originatorId, ttlVersion) per key, consulted
+  // in sendFloodPublication so identical updates delivered again (e.g.
+  // by a second flood peer) are dropped before serialization. Entries of
+  // expired keys are evicted; the whole cache resets when oversized
+  struct FloodedVersion {
+    int64_t version{0};
+    int64_t ttlVersion{0};
+    std::string originatorId;
+  };
+  std::unordered_map<std::string, FloodedVersion> recentFloods_;
+
+  // flood traffic sent towards each flood peer (SPT edge), exported via
+  // processFloodTopoGet() so per-edge flood load is observable
+  std::unordered_map<std::string, thrift::FloodEdgeCounters>
+      floodEdgeCounters_;
+
+  // flood parent elected by rebalanceFloodTopo() when it differs from
+  // the DUAL nexthop, keyed by root-id. Consulted in getFloodPeers() and
+  // dropped whenever the nexthop changes or the parent peer goes away
+  std::unordered_map<std::string /* root-id */, std::string /* peer */>
+      floodParentOverride_;
+
+  // timer driving periodic flood-topology rebalancing
+  std::unique_ptr<folly::AsyncTimeout> floodTopoRebalanceTimer_{nullptr};
+
   // Peers collection for KvStore to sync with
   std::unordered_map<std::string, KvStorePeer> thriftPeers_;
 
@@ -443,6 +893,14 @@ class KvStoreDb : public DualNode {
   std::unordered_map<std::string, ExponentialBackoff<std::chrono::milliseconds>>
       peersToSyncWith_{};
 
+  // peers whose digest probe mismatched; their next full-sync request
+  // carries the per-key hash dump instead of the root-digest probe
+  std::unordered_set<std::string> peersNeedingHashDump_{};
+
+  // latched once the initial full-sync with all configured peers is done
+  // and reported; later (periodic or peer-up) syncs don't re-report
+  bool initialSyncDone_{false};
+
   // Callback timer to get full KEY_DUMP from peersToSyncWith_
   std::unique_ptr<folly::AsyncTimeout> fullSyncTimer_;
 
@@ -450,14 +908,55 @@ class KvStoreDb : public DualNode {
   apache::thrift::CompactSerializer serializer_;
 
   // store keys mapped to (version, originatoId, value)
-  std::unordered_map<std::string, thrift::Value> kvStore_;
-
-  // TTL count down queue
-  TtlCountdownQueue ttlCountdownQueue_;
+  KvStoreDatabase kvStore_;
+
+  // keys of kvStore_ in lexicographic order, held as atoms interned
+  // through atomTable_ so the index shares key storage with the other
+  // per-key bookkeeping. Serves prefix-filtered dumps as range scans
+  std::set<StringAtom, StringAtomLess> sortedKeys_;
+
+  // cached full hash dump, shared out by getHashDumpSnapshot() and reset
+  // on every store mutation
+  std::shared_ptr<const thrift::Publication> hashDumpSnapshot_{nullptr};
+
+  // last built hash dump, retained across invalidations as the base for
+  // incremental rebuilds, plus the keys mutated since it was built. The
+  // near-static bulk of the store is carried over from the base verbatim;
+  // only the dirty keys get recomputed
+  std::shared_ptr<const thrift::Publication> hashDumpBase_{nullptr};
+  std::unordered_set<std::string> hashDumpDirtyKeys_;
+
+  // hash-tree index over kvStore_, maintained incrementally on mutations
+  // and used for anti-entropy during full-sync
+  KvStoreHashTree hashTree_{};
+
+  // interning pool for key names and originator node-ids referenced from
+  // per-key bookkeeping structures (e.g. the TTL countdown wheel)
+  StringAtomTable atomTable_{};
+
+  // Monotonic sequence of applied key-val updates, backing the
+  // incremental dump API. keyUpdateSeq_ records the sequence at which
+  // each live key last changed; tombstones_ keeps recently expired keys
+  // so incremental clients learn about deletions. Cursors older than
+  // tombstoneHorizonSeq_ (newest discarded tombstone) get a full dump
+  int64_t updateSeq_{0};
+  std::unordered_map<std::string, int64_t> keyUpdateSeq_;
+  std::deque<std::pair<int64_t, std::string>> tombstones_;
+  int64_t tombstoneHorizonSeq_{0};
+  static constexpr size_t kMaxTombstones{16384};
+
+  // TTL count down timing wheel
+  TtlCountdownWheel ttlCountdownWheel_;
 
   // TTL count down timer
   std::unique_ptr<folly::AsyncTimeout> ttlCountdownTimer_;
 
+  // timer to periodically snapshot the db for warm boot
+  std::unique_ptr<folly::AsyncTimeout> dbSnapshotTimer_{nullptr};
+
+  // timer to drain batched hot-path stats into fb303
+  std::unique_ptr<folly::AsyncTimeout> statsDrainTimer_{nullptr};
+
   // Map of latest peer sync up request send to each peer
   // this is used to measure full-dump sync time between this node and each of
   // its peers
@@ -490,9 +989,37 @@ class KvStoreDb : public DualNode {
       unordered_map<std::optional<std::string>, std::unordered_set<std::string>>
           publicationBuffer_{};
 
-  // max parallel syncs allowed. It's initialized with '2' and doubles
-  // up to a max value of kMaxFullSyncPendingCountThresholdfor each full sync
-  // response received
+  // flood-path traces of keys parked in publicationBuffer_, re-attached
+  // to the rebuilt publications when the buffer flushes
+  std::unordered_map<std::string, thrift::FloodPathTrace> pendingFloodTraces_;
+
+  // bounded buffer of traces recorded at this node for sampled keys,
+  // drained by harvestFloodTraces(). Oldest entries fall off when full
+  std::deque<thrift::FloodTraceRecord> harvestedFloodTraces_;
+
+  // receive-side reordering state for pipelined floods, keyed by direct
+  // sender. nextSeqNum is the next expected per-sender send counter;
+  // publications ahead of a gap wait in `buffered` (ordered by sequence)
+  // until the gap fills, the buffer overflows or flushTimer fires
+  struct FloodReorderState {
+    int64_t nextSeqNum{1};
+    std::map<int64_t, thrift::Publication> buffered;
+    std::unique_ptr<folly::AsyncTimeout> flushTimer{nullptr};
+  };
+  std::unordered_map<std::string, FloodReorderState> floodReorderStates_;
+
+  // timer to flush pending dual messages
+  std::unique_ptr<folly::AsyncTimeout> dualMessagesTimer_{nullptr};
+
+  // outgoing dual messages aggregated per neighbor within a tick
+  // map<neighbor: messages>
+  std::unordered_map<std::string, thrift::DualMessages> dualMessagesBuffer_{};
+
+  // max parallel syncs allowed, shared by the ZMQ and thrift full-sync
+  // paths. It's initialized with '2' and doubles up to a max value of
+  // kMaxFullSyncPendingCountThreshold for each full sync response received.
+  // Thrift peer sessions beyond the limit are still connected eagerly so
+  // held-back syncs start on established sessions when a slot frees up
   size_t parallelSyncLimit_{2};
 
   // event loop
@@ -527,7 +1054,9 @@ class KvStore final : public OpenrEventBase {
       std::unordered_map<std::string, thrift::PeerSpec> peers,
       // ZMQ high water mark
       int zmqHwm = Constants::kHighWaterMark,
-      bool enableKvStoreThrift = false);
+      bool enableKvStoreThrift = false,
+      // persistent store for warm-boot db snapshots (optional)
+      PersistentStore* configStore = nullptr);
 
   // process the key-values publication, and attempt to
   // merge it in existing map (first argument)
@@ -537,6 +1066,26 @@ class KvStore final : public OpenrEventBase {
       std::unordered_map<std::string, thrift::Value> const& update,
       std::optional<KvStoreFilters> const& filters = std::nullopt);
 
+  // same as above but consumes `update`: winning values are moved into the
+  // store instead of copied. Use when the caller owns the publication and
+  // discards it after the merge (e.g. full-sync responses)
+  static std::unordered_map<std::string, thrift::Value> mergeKeyValues(
+      std::unordered_map<std::string, thrift::Value>& kvStore,
+      std::unordered_map<std::string, thrift::Value>&& update,
+      std::optional<KvStoreFilters> const& filters = std::nullopt);
+
+  // flavors of the above for the F14-backed database container KvStoreDb
+  // keeps its key-vals in
+  static std::unordered_map<std::string, thrift::Value> mergeKeyValues(
+      KvStoreDatabase& kvStore,
+      std::unordered_map<std::string, thrift::Value> const& update,
+      std::optional<KvStoreFilters> const& filters = std::nullopt);
+
+  static std::unordered_map<std::string, thrift::Value> mergeKeyValues(
+      KvStoreDatabase& kvStore,
+      std::unordered_map<std::string, thrift::Value>&& update,
+      std::optional<KvStoreFilters> const& filters = std::nullopt);
+
   // compare two thrift::Values to figure out which value is better to
   // use, it will compare following attributes in order
   // <version>, <orginatorId>, <value>, <ttl-version>
@@ -554,6 +1103,16 @@ class KvStore final : public OpenrEventBase {
       thrift::KeyGetParams keyGetParams,
       std::string area = openr::thrift::KvStore_constants::kDefaultArea());
 
+#if FOLLY_HAS_COROUTINES
+  // coroutine-native variant of getKvStoreKeyVals(): the hop onto the
+  // area's event base is a single coroutine frame instead of a
+  // promise/future pair plus per-continuation callback state
+  folly::coro::Task<std::unique_ptr<thrift::Publication>>
+  getKvStoreKeyValsCoro(
+      thrift::KeyGetParams keyGetParams,
+      std::string area = openr::thrift::KvStore_constants::kDefaultArea());
+#endif
+
   folly::SemiFuture<folly::Unit> setKvStoreKeyVals(
       thrift::KeySetParams keySetParams,
       std::string area = openr::thrift::KvStore_constants::kDefaultArea());
@@ -580,6 +1139,11 @@ class KvStore final : public OpenrEventBase {
   folly::SemiFuture<std::unique_ptr<thrift::SptInfos>> getSpanningTreeInfos(
       std::string area = openr::thrift::KvStore_constants::kDefaultArea());
 
+  // harvest (and clear) flood-path traces recorded for sampled keys
+  folly::SemiFuture<std::unique_ptr<std::vector<thrift::FloodTraceRecord>>>
+  getFloodTraces(
+      std::string area = openr::thrift::KvStore_constants::kDefaultArea());
+
   folly::SemiFuture<folly::Unit> updateFloodTopologyChild(
       thrift::FloodTopoSetParams floodTopoSetParams,
       std::string area = openr::thrift::KvStore_constants::kDefaultArea());
@@ -593,6 +1157,9 @@ class KvStore final : public OpenrEventBase {
   // API to get reader for kvStoreUpdatesQueue
   messaging::RQueue<thrift::Publication> getKvStoreUpdatesReader();
 
+  // stop per-area worker threads (if any) before stopping self
+  void stop() override;
+
  private:
   // disable copying
   KvStore(KvStore const&) = delete;
@@ -616,6 +1183,18 @@ class KvStore final : public OpenrEventBase {
 
   void processPeerUpdates(thrift::PeerUpdateRequest&& req);
 
+  // body shared by getKvStoreKeyVals() and its coroutine variant; must
+  // run on the event base owning the area's KvStoreDb. Throws
+  // thrift::OpenrError on an unknown area
+  std::unique_ptr<thrift::Publication> getKvStoreKeyValsImpl(
+      thrift::KeyGetParams const& keyGetParams, std::string const& area);
+
+  // run callback on the event base owning given area's KvStoreDb. This is
+  // the KvStore event base unless parallel areas are enabled, in which
+  // case each area has a dedicated worker event base/thread
+  void runInAreaThread(
+      std::string const& area, folly::EventBase::Func callback);
+
   std::map<std::string, int64_t> getGlobalCounters() const;
 
   //
@@ -631,9 +1210,21 @@ class KvStore final : public OpenrEventBase {
   // kvstore parameters common to all kvstoreDB
   KvStoreParams kvParams_;
 
+  // number of areas that completed their initial full-sync; atomic since
+  // areas may report from their own event-base threads when parallel
+  // area processing is enabled
+  std::atomic<size_t> numAreasInitialSynced_{0};
+
   // map of area IDs and instance of KvStoreDb
   std::unordered_map<std::string /* area ID */, KvStoreDb> kvStoreDb_{};
 
+  // per-area worker event bases and their threads when parallel area
+  // processing is enabled. Each KvStoreDb is constructed on - and only
+  // ever touched from - its owning event base thread
+  std::unordered_map<std::string /* area ID */, std::unique_ptr<OpenrEventBase>>
+      areaEvbs_{};
+  std::vector<std::thread> areaEvbThreads_{};
+
   // the serializer/deserializer helper we'll be using
   apache::thrift::CompactSerializer serializer_;
 
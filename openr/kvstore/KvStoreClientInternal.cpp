@@ -12,6 +12,7 @@
 
 #include <folly/SharedMutex.h>
 #include <folly/String.h>
+#include <folly/hash/Hash.h>
 
 namespace openr {
 
@@ -56,6 +57,8 @@ KvStoreClientInternal::~KvStoreClientInternal() {
   eventBase_->getEvb()->runImmediatelyOrRunInEventBaseThreadAndWait([this]() {
     // destory your timers
     LOG(INFO) << "Destroy timers inside KvStoreClientInternal...";
+    advertisePendingKeysThrottled_.reset();
+    advertiseTtlUpdatesThrottled_.reset();
     advertiseKeyValsTimer_.reset();
     ttlTimer_.reset();
     checkPersistKeyTimer_.reset();
@@ -90,6 +93,17 @@ KvStoreClientInternal::initTimers() {
   ttlTimer_ = folly::AsyncTimeout::make(
       *eventBase_->getEvb(), [this]() noexcept { advertiseTtlUpdates(); });
 
+  // Create throttled advertisers so every mutation path batches pending
+  // keys per area into one KeySetParams submission
+  advertisePendingKeysThrottled_ = std::make_unique<fbzmq::ZmqThrottle>(
+      eventBase_->getEvb(),
+      Constants::kKvClientThrottleTimeout,
+      [this]() noexcept { advertisePendingKeys(); });
+  advertiseTtlUpdatesThrottled_ = std::make_unique<fbzmq::ZmqThrottle>(
+      eventBase_->getEvb(),
+      Constants::kKvClientThrottleTimeout,
+      [this]() noexcept { advertiseTtlUpdates(); });
+
   // Create check persistKey timer
   if (checkPersistKeyPeriod_.has_value()) {
     checkPersistKeyTimer_ = folly::AsyncTimeout::make(
@@ -238,8 +252,9 @@ KvStoreClientInternal::persistKey(
     keysToAdvertise.insert(key);
   }
 
-  // Best effort to advertise pending keys
-  advertisePendingKeys();
+  // Advertise pending keys in batch; a burst of persistKey calls within
+  // the throttle window goes out as one submission per area
+  advertisePendingKeysThrottled_->operator()();
 
   scheduleTtlUpdates(
       key,
@@ -357,12 +372,25 @@ KvStoreClientInternal::scheduleTtlUpdates(
   CHECK(not ttlThriftValue.value_ref().has_value());
 
   // renew before Ttl expires about every ttl/3, i.e., try twice
-  // use ExponentialBackoff to track remaining time
+  // use ExponentialBackoff to track remaining time.
+  // Apply deterministic per-key jitter (up to +/- 10% of the refresh
+  // period, derived from hash of key and node-id) so keys persisted at
+  // the same instant - e.g. fabric-wide after a rollout restart - do not
+  // refresh in lock-step storms every ttl/4. Refreshes landing on the
+  // same tick are still batched into one publication per area by
+  // advertiseTtlUpdates
+  const int64_t refreshPeriod = ttl / 4;
+  const int64_t jitterRange = refreshPeriod / 10;
+  int64_t jitter{0};
+  if (jitterRange > 0) {
+    const auto keyHash = folly::hash::hash_combine(key, nodeId_);
+    jitter = static_cast<int64_t>(keyHash % (2 * jitterRange)) - jitterRange;
+  }
   keyTtlBackoffs[key] = std::make_pair(
       ttlThriftValue,
       ExponentialBackoff<std::chrono::milliseconds>(
-          std::chrono::milliseconds(ttl / 4),
-          std::chrono::milliseconds(ttl / 4 + 1)));
+          std::chrono::milliseconds(refreshPeriod + jitter),
+          std::chrono::milliseconds(refreshPeriod + jitter + 1)));
 
   // Delay first ttl advertisement by (ttl / 4). We have just advertised key or
   // update and would like to avoid sending unncessary immediate ttl update
@@ -370,7 +398,7 @@ KvStoreClientInternal::scheduleTtlUpdates(
     keyTtlBackoffs.at(key).second.reportError();
   }
 
-  advertiseTtlUpdates();
+  advertiseTtlUpdatesThrottled_->operator()();
 }
 
 void
@@ -619,11 +647,24 @@ KvStoreClientInternal::processPublication(
     // Update if our version is old
     bool valueChange = false;
     if (currentValue.version < rcvdValue.version) {
-      // Bump-up version number
-      currentValue.originatorId = nodeId_;
-      currentValue.version = rcvdValue.version + 1;
-      currentValue.ttlVersion = 0;
-      valueChange = true;
+      if (rcvdValue.originatorId == nodeId_ and
+          currentValue.value_ref() == rcvdValue.value_ref()) {
+        // The higher-versioned value IS ours - e.g. our pre-restart
+        // advertisement coming back via a peer full-sync. The store already
+        // holds the correct value, so adopt its version instead of bumping
+        // past it; a bump here would ripple a no-op update through every
+        // node's mergeKeyValues
+        currentValue.version = rcvdValue.version;
+        if (sk != keyTtlBackoffs.end()) {
+          sk->second.first.version = rcvdValue.version;
+        }
+      } else {
+        // Bump-up version number
+        currentValue.originatorId = nodeId_;
+        currentValue.version = rcvdValue.version + 1;
+        currentValue.ttlVersion = 0;
+        valueChange = true;
+      }
     }
 
     // version is same but originator id is different. Then we need to
@@ -668,7 +709,7 @@ KvStoreClientInternal::processPublication(
     }
   } // for
 
-  advertisePendingKeys();
+  advertisePendingKeysThrottled_->operator()();
 
   if (publication.expiredKeys.size()) {
     processExpiredKeys(publication);
@@ -11,6 +11,7 @@
 #include <string>
 #include <unordered_map>
 
+#include <fbzmq/async/ZmqThrottle.h>
 #include <folly/Function.h>
 #include <folly/Optional.h>
 #include <folly/SocketAddress.h>
@@ -293,6 +294,12 @@ class KvStoreClientInternal {
   // Timer to advertise ttl updates for key-vals
   std::unique_ptr<folly::AsyncTimeout> ttlTimer_;
 
+  // Throttled advertisement of pending keys and ttl updates. All mutation
+  // paths funnel through these so a burst of persistKey calls coalesces
+  // into a single KeySetParams submission per area
+  std::unique_ptr<fbzmq::ZmqThrottle> advertisePendingKeysThrottled_;
+  std::unique_ptr<fbzmq::ZmqThrottle> advertiseTtlUpdatesThrottled_;
+
   // prefix key filter to apply for key updates
   KvStoreFilters keyPrefixFilter_{{}, {}};
 
@@ -5,7 +5,10 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <folly/synchronization/Baton.h>
+
 #include <openr/common/OpenrClient.h>
+#include <openr/common/OpenrClientPool.h>
 #include <openr/if/gen-cpp2/KvStore_types.h>
 #include <openr/kvstore/KvStore.h>
 
@@ -52,6 +55,7 @@ dumpAllWithPrefixMultipleAndParse(
     std::optional<int> maybeIpTos /* std::nullopt */,
     const folly::SocketAddress& bindAddr /* folly::AsyncSocket::anyAddress()*/,
     const std::string& area /* thrift::KvStore_constants::kDefaultArea() */) {
+  std::unordered_map<std::string, ThriftType> parsed;
   auto val = dumpAllWithThriftClientFromMultiple(
       sockAddrs,
       keyPrefix,
@@ -59,11 +63,21 @@ dumpAllWithPrefixMultipleAndParse(
       processTimeout,
       maybeIpTos,
       bindAddr,
-      area);
+      area,
+      [&parsed](
+          std::unordered_map<std::string, thrift::Value> const& keyVals) {
+        // parse values incrementally as each peer's response lands, so
+        // decode cost overlaps the wait for the remaining peers. Only
+        // key-vals accepted by the merge arrive here, hence each key is
+        // typically parsed exactly once
+        for (auto const& kv : keyVals) {
+          parsed[kv.first] = parseThriftValue<ThriftType>(kv.second);
+        }
+      });
   if (not val.first) {
     return std::make_pair(std::nullopt, val.second);
   }
-  return std::make_pair(parseThriftValues<ThriftType>(*val.first), val.second);
+  return std::make_pair(std::move(parsed), val.second);
 }
 
 // static method to dump KvStore key-val over multiple instances
@@ -77,8 +91,16 @@ dumpAllWithThriftClientFromMultiple(
     std::chrono::milliseconds processTimeout,
     std::optional<int> maybeIpTos /* std::nullopt */,
     const folly::SocketAddress& bindAddr /* folly::AsyncSocket::anyAddress()*/,
-    const std::string& area /* thrift::KvStore_constants::kDefaultArea() */) {
-  folly::EventBase evb;
+    const std::string& area /* thrift::KvStore_constants::kDefaultArea() */,
+    folly::Function<void(
+        std::unordered_map<std::string, thrift::Value> const&)>
+        mergedKeyValsCb /* nullptr */) {
+  // Connections are borrowed from the process-wide client pool and handed
+  // back when the dump completes, so repeated invocations against the same
+  // seed nodes (periodic tooling) skip connection setup entirely
+  auto& pool = OpenrClientPool::instance();
+  auto& evb = pool.getEventBase();
+  std::vector<OpenrClientPool::Lease> leases;
   std::vector<folly::SemiFuture<thrift::Publication>> calls;
   std::unordered_map<std::string, thrift::Value> merged;
   std::vector<fbzmq::SocketUrl> unreachedUrls;
@@ -90,22 +112,16 @@ dumpAllWithThriftClientFromMultiple(
 
   auto startTime = std::chrono::steady_clock::now();
   for (auto const& sockAddr : sockAddrs) {
-    std::unique_ptr<thrift::OpenrCtrlCppAsyncClient> client{nullptr};
+    OpenrClientPool::Lease lease;
     try {
-      client = getOpenrCtrlPlainTextClient(
-          evb,
-          folly::IPAddress(sockAddr.getAddressStr()),
-          sockAddr.getPort(),
-          connectTimeout,
-          processTimeout,
-          bindAddr,
-          maybeIpTos);
+      lease = pool.getClient(
+          sockAddr, connectTimeout, processTimeout, maybeIpTos, bindAddr);
     } catch (const std::exception& ex) {
       LOG(ERROR) << "Failed to connect to Open/R instance at address of: "
                  << sockAddr.getAddressStr()
                  << ". Exception: " << folly::exceptionStr(ex);
     }
-    if (!client) {
+    if (!lease) {
       unreachedUrls.push_back(fbzmq::SocketUrl{sockAddr.getAddressStr()});
       continue;
     }
@@ -113,13 +129,17 @@ dumpAllWithThriftClientFromMultiple(
     VLOG(3) << "Successfully connected to Open/R with addr: "
             << sockAddr.getAddressStr();
 
+    // issue the request on the pool's event base the client is bound to.
     // Keep getKvStoreKeyValsFiltered() for backward compatibility purpose
-    if (area == thrift::KvStore_constants::kDefaultArea()) {
-      calls.emplace_back(client->semifuture_getKvStoreKeyValsFiltered(params));
-    } else {
-      calls.emplace_back(
-          client->semifuture_getKvStoreKeyValsFilteredArea(params, area));
-    }
+    evb.runImmediatelyOrRunInEventBaseThreadAndWait([&]() {
+      if (area == thrift::KvStore_constants::kDefaultArea()) {
+        calls.emplace_back(lease->semifuture_getKvStoreKeyValsFiltered(params));
+      } else {
+        calls.emplace_back(
+            lease->semifuture_getKvStoreKeyValsFilteredArea(params, area));
+      }
+    });
+    leases.emplace_back(std::move(lease));
   }
 
   // can't connect to ANY single Open/R instance
@@ -127,13 +147,16 @@ dumpAllWithThriftClientFromMultiple(
     return std::make_pair(std::nullopt, unreachedUrls);
   }
 
-  folly::collectAll(calls).via(&evb).thenValue(
-      [&](std::vector<folly::Try<openr::thrift::Publication>>&& results) {
-        LOG(INFO) << "Merge values received from Open/R instances"
-                  << ", results size: " << results.size();
-
-        // loop semifuture collection to merge all values
-        for (auto& result : results) {
+  // merge each response into the result as it arrives instead of holding
+  // every publication until the slowest peer has answered. This keeps one
+  // response worth of memory alive at a time and lets callers consume the
+  // accepted key-vals incrementally via mergedKeyValsCb
+  folly::Baton<> allDone;
+  size_t completedCalls{0};
+  for (size_t i = 0; i < calls.size(); ++i) {
+    std::move(calls.at(i))
+        .via(&evb)
+        .thenTry([&, i](folly::Try<openr::thrift::Publication>&& result) {
           VLOG(3) << "hasException: " << result.hasException()
                   << ", hasValue: " << result.hasValue();
 
@@ -142,16 +165,28 @@ dumpAllWithThriftClientFromMultiple(
           if (result.hasException()) {
             LOG(WARNING) << "Exception happened: "
                          << folly::exceptionStr(result.exception());
+            // the channel may be left in an undefined state - do not
+            // return this connection to the pool
+            leases.at(i).markBroken();
           } else if (result.hasValue()) {
             VLOG(3) << "KvStore publication received";
-            KvStore::mergeKeyValues(merged, result.value().keyVals);
+            auto updates =
+                KvStore::mergeKeyValues(merged, result.value().keyVals);
+            if (mergedKeyValsCb and not updates.empty()) {
+              mergedKeyValsCb(updates);
+            }
           }
-        }
-        evb.terminateLoopSoon();
-      });
+          if (++completedCalls == calls.size()) {
+            LOG(INFO) << "Merged values received from " << completedCalls
+                      << " Open/R instance(s)";
+            allDone.post();
+          }
+        });
+  }
 
-  // magic happens here
-  evb.loopForever();
+  // wait for all responses; healthy connections go back to the pool when
+  // the leases unwind below
+  allDone.wait();
 
   // record time used to fetch from all Open/R instances
   const auto elapsedTime =
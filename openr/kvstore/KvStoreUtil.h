@@ -8,6 +8,7 @@
 #pragma once
 
 #include <fbzmq/zmq/Zmq.h>
+#include <folly/Function.h>
 #include <folly/io/async/AsyncSocket.h>
 #include <openr/common/Constants.h>
 #include <openr/if/gen-cpp2/KvStore_constants.h>
@@ -71,6 +72,10 @@ dumpAllWithPrefixMultipleAndParse(
  * @param connectTimeout - timeout value set on connecting
  * @param processTimeout - timeout value set on porcessing
  * @param bindAddr - source addr for binding purpose. Default will be ANY
+ * @param mergedKeyValsCb - if set, invoked on the calling thread with the
+ *  key-vals accepted into the merged map as each peer's response arrives,
+ *  so callers can process data incrementally instead of waiting for the
+ *  slowest peer
  *
  * @return first member of the pair is key-value map obtained by merging data
  * from all stores. Null value if failed connecting and obtaining snapshot
@@ -88,7 +93,10 @@ dumpAllWithThriftClientFromMultiple(
     std::chrono::milliseconds processTimeout = Constants::kServiceProcTimeout,
     std::optional<int> maybeIpTos = std::nullopt,
     const folly::SocketAddress& bindAddr = folly::AsyncSocket::anyAddress(),
-    const std::string& area = thrift::KvStore_constants::kDefaultArea());
+    const std::string& area = thrift::KvStore_constants::kDefaultArea(),
+    folly::Function<void(
+        std::unordered_map<std::string, thrift::Value> const&)>
+        mergedKeyValsCb = nullptr);
 
 } // namespace openr
 
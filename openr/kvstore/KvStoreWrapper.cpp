@@ -27,7 +27,8 @@ KvStoreWrapper::KvStoreWrapper(
     std::unordered_map<std::string, thrift::PeerSpec> peers,
     std::optional<messaging::RQueue<thrift::PeerUpdateRequest>>
         peerUpdatesQueue,
-    bool enableKvStoreThrift)
+    bool enableKvStoreThrift,
+    PersistentStore* configStore)
     : nodeId(config->getNodeName()),
       globalCmdUrl(folly::sformat("inproc://{}-kvstore-global-cmd", nodeId)),
       monitorSubmitUrl(folly::sformat("inproc://{}-monitor-submit", nodeId)),
@@ -47,7 +48,8 @@ KvStoreWrapper::KvStoreWrapper(
       std::nullopt /* ip-tos */,
       peers,
       Constants::kHighWaterMark,
-      enableKvStoreThrift_);
+      enableKvStoreThrift_,
+      configStore);
 }
 
 void
@@ -156,6 +158,28 @@ KvStoreWrapper::dumpAll(
   return pub.keyVals;
 }
 
+thrift::Publication
+KvStoreWrapper::dumpIncremental(int64_t sinceSeq, std::string area) {
+  // Prepare KeyDumpParams
+  thrift::KeyDumpParams params;
+  params.sinceSeq_ref() = sinceSeq;
+
+  return *(kvStore_->dumpKvStoreKeys(std::move(params), area).get());
+}
+
+thrift::Publication
+KvStoreWrapper::dumpRange(
+    std::optional<std::string> startKey, int32_t maxKeys, std::string area) {
+  // Prepare KeyDumpParams
+  thrift::KeyDumpParams params;
+  if (startKey.has_value()) {
+    params.startKey_ref() = startKey.value();
+  }
+  params.maxKeys_ref() = maxKeys;
+
+  return *(kvStore_->dumpKvStoreKeys(std::move(params), area).get());
+}
+
 std::unordered_map<std::string /* key */, thrift::Value>
 KvStoreWrapper::dumpHashes(std::string const& prefix, std::string area) {
   // Prepare KeyDumpParams
@@ -179,12 +203,19 @@ KvStoreWrapper::syncKeyVals(
 
 thrift::Publication
 KvStoreWrapper::recvPublication() {
-  auto maybePublication = kvStoreUpdatesQueueReader_.get(); // perform read
-  if (maybePublication.hasError()) {
-    throw std::runtime_error(std::string("recvPublication failed"));
+  while (true) {
+    auto maybePublication = kvStoreUpdatesQueueReader_.get(); // perform read
+    if (maybePublication.hasError()) {
+      throw std::runtime_error(std::string("recvPublication failed"));
+    }
+    auto pub = maybePublication.value();
+    if (pub.initialSyncComplete_ref().value_or(false)) {
+      // control-plane signal for cold-start consumers (e.g. Decision),
+      // not a data publication; skip it
+      continue;
+    }
+    return pub;
   }
-  auto pub = maybePublication.value();
-  return pub;
 }
 
 thrift::SptInfos
@@ -193,6 +224,11 @@ KvStoreWrapper::getFloodTopo(std::string area) {
   return sptInfos;
 }
 
+std::vector<thrift::FloodTraceRecord>
+KvStoreWrapper::getFloodTraces(std::string area) {
+  return *(kvStore_->getFloodTraces(area).get());
+}
+
 bool
 KvStoreWrapper::addPeer(
     std::string peerName, thrift::PeerSpec spec, std::string area) {
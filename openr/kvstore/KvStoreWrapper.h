@@ -35,7 +35,8 @@ class KvStoreWrapper {
       std::unordered_map<std::string, thrift::PeerSpec> peers,
       std::optional<messaging::RQueue<thrift::PeerUpdateRequest>>
           peerUpdatesQueue = std::nullopt,
-      bool enableKvStoreThrift = false);
+      bool enableKvStoreThrift = false,
+      PersistentStore* configStore = nullptr);
 
   ~KvStoreWrapper() {
     stop();
@@ -104,6 +105,26 @@ class KvStoreWrapper {
       std::optional<KvStoreFilters> filters = std::nullopt,
       std::string area = openr::thrift::KvStore_constants::kDefaultArea());
 
+  /**
+   * API to get incremental dump from KvStore: only key-vals updated after
+   * the given cursor plus keys expired since then. The returned publication
+   * carries the new cursor in updateSeq
+   */
+  thrift::Publication dumpIncremental(
+      int64_t sinceSeq,
+      std::string area = openr::thrift::KvStore_constants::kDefaultArea());
+
+  /**
+   * API to get a range dump from KvStore: at most maxKeys key-vals in
+   * lexicographic key order, starting strictly after startKey. The
+   * returned publication carries the cursor of a truncated page in
+   * nextKey; feed it back as startKey to fetch the next page
+   */
+  thrift::Publication dumpRange(
+      std::optional<std::string> startKey,
+      int32_t maxKeys,
+      std::string area = openr::thrift::KvStore_constants::kDefaultArea());
+
   /**
    * API to get dump hashes from KvStore.
    * if we pass a prefix, only return keys that match it
@@ -130,6 +151,12 @@ class KvStoreWrapper {
   thrift::SptInfos getFloodTopo(
       std::string area = openr::thrift::KvStore_constants::kDefaultArea());
 
+  /*
+   * Harvest (and clear) flood-path traces recorded for sampled keys
+   */
+  std::vector<thrift::FloodTraceRecord> getFloodTraces(
+      std::string area = openr::thrift::KvStore_constants::kDefaultArea());
+
   /**
    * APIs to manage (add/remove) KvStore peers. Returns true on success else
    * returns false.
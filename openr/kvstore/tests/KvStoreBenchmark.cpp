@@ -180,6 +180,46 @@ floodingUpdate(
   CHECK_EQ(numOfUpdateKeys, pub.keyVals.size());
 }
 
+/**
+ * Merge an update whose keys miss the store at the given percentage:
+ * missing keys take the insert path of mergeKeyValues() while the rest
+ * update existing entries with a newer version
+ */
+void
+updateKvStoreWithMissRatio(
+    const uint32_t numOfUpdateKeys,
+    const uint32_t missPct,
+    uint64_t& version,
+    std::unordered_map<std::string, thrift::Value>& kvStore) {
+  auto suspender = folly::BenchmarkSuspender();
+  std::unordered_map<std::string, thrift::Value> update;
+  auto kvIt = kvStore.begin();
+  for (uint32_t idx = 0; idx < numOfUpdateKeys; idx++) {
+    std::string key;
+    if (folly::Random::rand32() % 100 < missPct) {
+      // merge will not find this key and insert it
+      key = genRandomStr(kSizeOfKey);
+    } else {
+      key = kvIt->first;
+      ++kvIt;
+    }
+    thrift::Value thriftValue(
+        apache::thrift::FRAGILE,
+        version, /* version */
+        "kvStore", /* node id */
+        genRandomStr(kSizeOfValue),
+        3600, /* ttl */
+        0 /* ttl version */,
+        0 /* hash */);
+    update.emplace(key, std::move(thriftValue));
+  }
+  version++;
+  suspender.dismiss(); // Start measuring benchmark time
+
+  // Merge update with kvStore
+  KvStore::mergeKeyValues(kvStore, update);
+}
+
 /**
  * Benchmark for mergeKeyValues():
  * 1. Generate (key, value) pairs, and put them into kvStore
@@ -220,6 +260,123 @@ BM_KvStoreMergeKeyValues(
   }
 }
 
+/**
+ * Benchmark for mergeKeyValues() with a controlled hit/miss ratio of the
+ * update against the store
+ */
+static void
+BM_KvStoreMergeKeyValuesMissRatio(
+    uint32_t iters,
+    uint32_t numOfKeysInStore,
+    size_t numOfUpdateKeys,
+    uint32_t missPct) {
+  CHECK_LE(numOfUpdateKeys, numOfKeysInStore);
+  auto suspender = folly::BenchmarkSuspender();
+  std::unordered_map<std::string, thrift::Value> kvStore;
+
+  uint64_t version = 1;
+  for (uint32_t idx = 0; idx < numOfKeysInStore; idx++) {
+    thrift::Value thriftValue(
+        apache::thrift::FRAGILE,
+        version, /* version */
+        "kvStore", /* node id */
+        genRandomStr(kSizeOfValue),
+        3600, /* ttl */
+        0 /* ttl version */,
+        0 /* hash */);
+    kvStore.emplace(genRandomStr(kSizeOfKey), std::move(thriftValue));
+  }
+
+  // Version starts with 2 since keys aleady in kvStore have a version of 1
+  version++;
+  suspender.dismiss(); // Start measuring benchmark time
+  for (uint32_t i = 0; i < iters; i++) {
+    updateKvStoreWithMissRatio(numOfUpdateKeys, missPct, version, kvStore);
+  }
+}
+
+/**
+ * Benchmark for compareValues() over a mix of tie-breaking outcomes:
+ * differing versions, originators, values and ttl-versions
+ */
+static void
+BM_KvStoreCompareValues(uint32_t iters, size_t numOfPairs) {
+  auto suspender = folly::BenchmarkSuspender();
+  std::vector<std::pair<thrift::Value, thrift::Value>> valuePairs;
+  valuePairs.reserve(numOfPairs);
+  for (uint32_t idx = 0; idx < numOfPairs; idx++) {
+    thrift::Value v1(
+        apache::thrift::FRAGILE,
+        1 + folly::Random::rand32() % 2, /* version */
+        idx % 2 ? "kvStoreA" : "kvStoreB", /* node id */
+        genRandomStr(kSizeOfValue),
+        3600, /* ttl */
+        folly::Random::rand32() % 2 /* ttl version */,
+        0 /* hash */);
+    auto v2 = v1;
+    if (idx % 3 == 0) {
+      v2.value_ref() = genRandomStr(kSizeOfValue);
+    }
+    valuePairs.emplace_back(std::move(v1), std::move(v2));
+  }
+  suspender.dismiss(); // Start measuring benchmark time
+
+  for (uint32_t i = 0; i < iters; i++) {
+    for (auto const& valuePair : valuePairs) {
+      folly::doNotOptimizeAway(
+          KvStore::compareValues(valuePair.first, valuePair.second));
+    }
+  }
+}
+
+/**
+ * Benchmark for dumpDifference() (via a full-sync style request carrying
+ * keyValHashes):
+ * 1. Start kvStore and set (key, value)s into it
+ * 2. Take the hash dump and diverge the given percentage of hashes
+ * 3. Benchmark the time to compute the differing key-vals
+ */
+static void
+BM_KvStoreDumpDifference(
+    uint32_t iters, size_t numOfKeysInStore, uint32_t divergedPct) {
+  auto suspender = folly::BenchmarkSuspender();
+  auto kvStoreTestFixture = std::make_unique<KvStoreTestFixture>();
+  const std::unordered_map<std::string, thrift::PeerSpec> emptyPeers;
+
+  auto kvStore = kvStoreTestFixture->createKvStore("kvStore", emptyPeers);
+  kvStore->run();
+
+  std::vector<std::pair<std::string, thrift::Value>> keyVals;
+  keyVals.reserve(numOfKeysInStore);
+  for (uint32_t idx = 0; idx < numOfKeysInStore; idx++) {
+    thrift::Value thriftVal(
+        apache::thrift::FRAGILE,
+        1 /* version */,
+        "kvStore" /* originatorId */,
+        genRandomStr(kSizeOfValue) /* value */,
+        Constants::kTtlInfinity /* ttl */,
+        0 /* ttl version */,
+        0 /* hash */);
+    thriftVal.hash_ref() = generateHash(
+        thriftVal.version, thriftVal.originatorId, thriftVal.value_ref());
+    keyVals.emplace_back(genRandomStr(kSizeOfKey), std::move(thriftVal));
+  }
+  kvStore->setKeys(keyVals);
+
+  // diverge the requested percentage of the peer's hashes
+  auto peerHashes = kvStore->dumpHashes();
+  for (auto& kv : peerHashes) {
+    if (folly::Random::rand32() % 100 < divergedPct) {
+      kv.second.hash_ref() = folly::Random::rand64();
+    }
+  }
+  suspender.dismiss(); // Start measuring benchmark time
+
+  for (uint32_t i = 0; i < iters; i++) {
+    kvStore->syncKeyVals(peerHashes);
+  }
+}
+
 /**
  * Benchmark for a full dump:
  * 1. Start kvStore
@@ -300,6 +457,32 @@ BENCHMARK_NAMED_PARAM(BM_KvStoreMergeKeyValues, 10000_10, 10000, 10);
 BENCHMARK_NAMED_PARAM(BM_KvStoreMergeKeyValues, 10000_100, 10000, 100);
 BENCHMARK_NAMED_PARAM(BM_KvStoreMergeKeyValues, 10000_1000, 10000, 1000);
 BENCHMARK_NAMED_PARAM(BM_KvStoreMergeKeyValues, 10000_10000, 10000, 10000);
+BENCHMARK_NAMED_PARAM(BM_KvStoreMergeKeyValues, 100000_100, 100000, 100);
+BENCHMARK_NAMED_PARAM(BM_KvStoreMergeKeyValues, 100000_10000, 100000, 10000);
+BENCHMARK_NAMED_PARAM(BM_KvStoreMergeKeyValues, 1000000_100, 1000000, 100);
+BENCHMARK_NAMED_PARAM(
+    BM_KvStoreMergeKeyValues, 1000000_10000, 1000000, 10000);
+
+// The third integer parameter is the percentage of update keys missing
+// from the store
+BENCHMARK_NAMED_PARAM(
+    BM_KvStoreMergeKeyValuesMissRatio, 10000_1000_0, 10000, 1000, 0);
+BENCHMARK_NAMED_PARAM(
+    BM_KvStoreMergeKeyValuesMissRatio, 10000_1000_50, 10000, 1000, 50);
+BENCHMARK_NAMED_PARAM(
+    BM_KvStoreMergeKeyValuesMissRatio, 10000_1000_100, 10000, 1000, 100);
+BENCHMARK_NAMED_PARAM(
+    BM_KvStoreMergeKeyValuesMissRatio, 100000_10000_50, 100000, 10000, 50);
+
+// The parameter is the number of value pairs compared per iteration
+BENCHMARK_PARAM(BM_KvStoreCompareValues, 1000);
+
+// The first integer parameter is number of keyVals in store
+// The second integer parameter is the percentage of diverged hashes
+BENCHMARK_NAMED_PARAM(BM_KvStoreDumpDifference, 1000_1, 1000, 1);
+BENCHMARK_NAMED_PARAM(BM_KvStoreDumpDifference, 1000_50, 1000, 50);
+BENCHMARK_NAMED_PARAM(BM_KvStoreDumpDifference, 10000_1, 10000, 1);
+BENCHMARK_NAMED_PARAM(BM_KvStoreDumpDifference, 10000_50, 10000, 50);
 
 // The parameter is number of keyVals already in store
 BENCHMARK_PARAM(BM_KvStoreDumpAll, 10);
@@ -677,6 +677,89 @@ TEST(KvStoreClientInternal, PersistKeyTest) {
   evbThread.join();
 }
 
+/**
+ * Test client adopts the store's version when its own persisted value shows
+ * up with a higher version (e.g. the pre-restart advertisement coming back
+ * via a peer full-sync) instead of bumping past it. A bump must still happen
+ * when another originator claims the key.
+ */
+TEST(KvStoreClientInternal, PersistKeyAdoptOwnHigherVersion) {
+  fbzmq::Context context;
+  folly::Baton waitBaton;
+  const std::string nodeId{"test_store"};
+  const std::string testKey{"test_key"};
+  const std::string testValue{"test_value"};
+
+  auto config = std::make_shared<Config>(getBasicOpenrConfig(nodeId));
+  auto store = std::make_shared<KvStoreWrapper>(
+      context, config, std::unordered_map<std::string, thrift::PeerSpec>{});
+  store->run();
+
+  // Create another OpenrEventBase instance for looping clients
+  OpenrEventBase evb;
+
+  // Create and initialize kvstore-client
+  auto client1 = std::make_shared<KvStoreClientInternal>(
+      &evb, nodeId, store->getKvStore(), 1000ms);
+
+  // persist the key; client owns it with version 1
+  evb.scheduleTimeout(std::chrono::milliseconds(0), [&]() noexcept {
+    client1->persistKey(testKey, testValue);
+  });
+
+  // inject the same value under our own originator-id with a higher
+  // version, as a full-sync with a peer would after a restart
+  evb.scheduleTimeout(std::chrono::milliseconds(100), [&]() noexcept {
+    auto keyVal = createThriftValue(
+        5, nodeId, testValue, 100000 /* ttl in msec */, 0, 0 /* hash */);
+    store->setKey(testKey, keyVal);
+  });
+
+  // client must adopt version 5 silently - no re-advertisement with 6
+  evb.scheduleTimeout(std::chrono::milliseconds(400), [&]() noexcept {
+    auto maybeVal = client1->getKey(testKey);
+    ASSERT_TRUE(maybeVal.has_value());
+    EXPECT_EQ(5, maybeVal->version);
+    EXPECT_EQ(nodeId, maybeVal->originatorId);
+    EXPECT_EQ(testValue, maybeVal->value_ref());
+  });
+
+  // a foreign originator claiming the key must still get overridden
+  evb.scheduleTimeout(std::chrono::milliseconds(500), [&]() noexcept {
+    auto keyVal = createThriftValue(
+        7, "other_store", testValue, 100000 /* ttl in msec */, 0, 0 /* hash */);
+    store->setKey(testKey, keyVal);
+  });
+
+  evb.scheduleTimeout(std::chrono::milliseconds(800), [&]() noexcept {
+    auto maybeVal = client1->getKey(testKey);
+    ASSERT_TRUE(maybeVal.has_value());
+    EXPECT_EQ(8, maybeVal->version);
+    EXPECT_EQ(nodeId, maybeVal->originatorId);
+
+    // Synchronization primitive
+    waitBaton.post();
+  });
+
+  // Start the event loop and wait until it is finished execution.
+  std::thread evbThread([&]() { evb.run(); });
+  evb.waitUntilRunning();
+
+  // Synchronization primitive
+  waitBaton.wait();
+
+  // Stop store
+  LOG(INFO) << "Stopping store";
+  store->closeQueue();
+  client1.reset();
+  store->stop();
+  store.reset();
+
+  evb.stop();
+  evb.waitUntilStopped();
+  evbThread.join();
+}
+
 /**
  * Test ttl change with persist key while keeping value and version same
  * - Set key with ttl 1s
@@ -23,6 +23,7 @@
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 
 #include <openr/common/Util.h>
+#include <openr/config-store/PersistentStoreWrapper.h>
 #include <openr/config/Config.h>
 #include <openr/config/tests/Utils.h>
 #include <openr/if/gen-cpp2/KvStore_types.h>
@@ -103,14 +104,20 @@ class KvStoreTestFixture : public ::testing::TestWithParam<bool> {
       std::string nodeId,
       std::unordered_map<std::string, thrift::PeerSpec> peers,
       thrift::KvstoreConfig kvStoreConf = getTestKvConf(),
-      const std::vector<thrift::AreaConfig>& areas = {}) {
+      const std::vector<thrift::AreaConfig>& areas = {},
+      PersistentStore* configStore = nullptr) {
     auto tConfig = getBasicOpenrConfig(nodeId);
     tConfig.kvstore_config = kvStoreConf;
     tConfig.areas = areas;
     config_ = std::make_shared<Config>(tConfig);
 
-    stores_.emplace_back(
-        std::make_unique<KvStoreWrapper>(context, config_, peers));
+    stores_.emplace_back(std::make_unique<KvStoreWrapper>(
+        context,
+        config_,
+        peers,
+        std::nullopt /* peerUpdatesQueue */,
+        false /* enableKvStoreThrift */,
+        configStore));
     return stores_.back().get();
   }
 
@@ -554,8 +561,169 @@ TEST(KvStore, compareValuesTest) {
   }
 }
 
+//
+// Test incremental hash-tree index maintenance and bucket diffing
+//
+TEST(KvStore, HashTreeIndexTest) {
+  KvStoreHashTree myTree, peerTree;
+
+  // empty trees agree on everything
+  EXPECT_EQ(myTree.rootHash(), peerTree.rootHash());
+  EXPECT_TRUE(myTree.diffBuckets(peerTree.bucketHashes()).empty());
+
+  // add same entry on both sides => still in sync
+  myTree.update("key1", std::nullopt, 100);
+  peerTree.update("key1", std::nullopt, 100);
+  EXPECT_EQ(myTree.rootHash(), peerTree.rootHash());
+  EXPECT_TRUE(myTree.diffBuckets(peerTree.bucketHashes()).empty());
+
+  // local-only update => exactly one bucket diverges
+  myTree.update("key2", std::nullopt, 200);
+  EXPECT_NE(myTree.rootHash(), peerTree.rootHash());
+  auto divergedBuckets = myTree.diffBuckets(peerTree.bucketHashes());
+  EXPECT_EQ(1, divergedBuckets.size());
+  EXPECT_EQ(1, divergedBuckets.count(KvStoreHashTree::bucketIndex("key2")));
+
+  // peer catches up => back in sync
+  peerTree.update("key2", std::nullopt, 200);
+  EXPECT_EQ(myTree.rootHash(), peerTree.rootHash());
+  EXPECT_TRUE(myTree.diffBuckets(peerTree.bucketHashes()).empty());
+
+  // value update followed by removal returns to the original state
+  const auto rootHashBefore = myTree.rootHash();
+  myTree.update("key3", std::nullopt, 300);
+  myTree.update("key3", 300, 301);
+  myTree.update("key3", 301, std::nullopt);
+  EXPECT_EQ(rootHashBefore, myTree.rootHash());
+}
+
+//
+// Test string interning pool: canonical atoms and lazy collection
+//
+TEST(KvStore, StringAtomTableTest) {
+  StringAtomTable atomTable;
+
+  // identical strings intern to the very same atom (pointer equality)
+  auto atom1 = atomTable.intern("node1");
+  auto atom2 = atomTable.intern("node1");
+  auto atom3 = atomTable.intern("node2");
+  EXPECT_EQ(atom1.get(), atom2.get());
+  EXPECT_NE(atom1.get(), atom3.get());
+  EXPECT_EQ("node1", *atom1);
+  EXPECT_EQ(2, atomTable.size());
+
+  // dropping all references makes the atom collectable; a re-intern after
+  // that yields a fresh allocation
+  atom3.reset();
+  auto atom4 = atomTable.intern("node2");
+  EXPECT_EQ("node2", *atom4);
+}
+
+//
+// Test TTL countdown timing wheel: per-key entry reuse and expiry ordering
+//
+TEST(KvStore, TtlCountdownWheelTest) {
+  StringAtomTable atomTable;
+  TtlCountdownWheel wheel;
+  const auto now = std::chrono::steady_clock::now();
+
+  auto makeEntry = [&](const std::string& key,
+                       std::chrono::milliseconds ttl,
+                       int64_t ttlVersion = 0) {
+    TtlCountdownQueueEntry entry;
+    entry.expiryTime = now + ttl;
+    entry.key = atomTable.intern(key);
+    entry.version = 1;
+    entry.ttlVersion = ttlVersion;
+    entry.originatorId = atomTable.intern("node1");
+    return entry;
+  };
+
+  EXPECT_TRUE(wheel.empty());
+  EXPECT_FALSE(wheel.nextWakeup().has_value());
+
+  // insert two keys with short and long TTLs
+  wheel.insertOrUpdate(makeEntry("key1", std::chrono::seconds(1)));
+  wheel.insertOrUpdate(makeEntry("key2", std::chrono::hours(1)));
+  EXPECT_EQ(2, wheel.size());
+  EXPECT_TRUE(wheel.nextWakeup().has_value());
+
+  // TTL refresh reuses the key's entry instead of adding a new one
+  wheel.insertOrUpdate(makeEntry("key1", std::chrono::seconds(5), 1));
+  EXPECT_EQ(2, wheel.size());
+  auto entry = wheel.get(atomTable.intern("key1"));
+  ASSERT_TRUE(entry.has_value());
+  EXPECT_EQ(1, entry->ttlVersion);
+
+  // nothing expires ahead of time
+  EXPECT_TRUE(wheel.advance(now).empty());
+  EXPECT_EQ(2, wheel.size());
+
+  // key1 expires within 10s, key2 does not
+  auto expired = wheel.advance(now + std::chrono::seconds(10));
+  ASSERT_EQ(1, expired.size());
+  EXPECT_EQ("key1", *expired.at(0).key);
+  EXPECT_EQ(1, expired.at(0).ttlVersion);
+  EXPECT_FALSE(wheel.get(atomTable.intern("key1")).has_value());
+
+  // key2 eventually expires through outer-level cascading
+  expired = wheel.advance(now + std::chrono::hours(2));
+  ASSERT_EQ(1, expired.size());
+  EXPECT_EQ("key2", *expired.at(0).key);
+  EXPECT_TRUE(wheel.empty());
+}
+
 //
 // Test counter reporting
+/**
+ * Verify warm-boot db snapshots. A store with snapshotting enabled persists
+ * its key-vals to the config-store; a freshly created store pointed at the
+ * same config-store boots with those key-vals without any peer sync.
+ */
+TEST_F(KvStoreTestFixture, DbSnapshotWarmBoot) {
+  fbzmq::Context storeContext;
+  const auto tid = std::hash<std::thread::id>()(std::this_thread::get_id());
+  PersistentStoreWrapper configStore(storeContext, tid);
+  PersistentStore* configStorePtr = configStore.operator->();
+  configStore.run();
+  // clear any stale snapshot from a previous run of this test
+  configStore->erase("kvstore-snapshot:0").get();
+
+  auto kvConf = getTestKvConf();
+  kvConf.snapshot_interval_s_ref() = 1;
+
+  const std::unordered_map<std::string, thrift::PeerSpec> emptyPeers;
+  auto store1 = createKvStore(
+      "store1", emptyPeers, kvConf, {} /* areas */, configStorePtr);
+  store1->run();
+
+  thrift::Value thriftVal = createThriftValue(
+      1 /* version */,
+      "store1" /* originatorId */,
+      std::string("value1") /* value */,
+      Constants::kTtlInfinity /* ttl */,
+      0 /* ttl version */,
+      0 /* hash */);
+  thriftVal.hash_ref() = generateHash(
+      thriftVal.version, thriftVal.originatorId, thriftVal.value_ref());
+  EXPECT_TRUE(store1->setKey("test-key", thriftVal));
+
+  // wait for the periodic snapshot to hit the config-store
+  /* sleep override */
+  std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+
+  // a brand new store warm boots from the snapshot without any peers
+  auto store2 = createKvStore(
+      "store2", emptyPeers, kvConf, {} /* areas */, configStorePtr);
+  store2->run();
+
+  auto maybeVal = store2->getKey("test-key");
+  ASSERT_TRUE(maybeVal.has_value());
+  EXPECT_EQ(1, maybeVal->version);
+  EXPECT_EQ("store1", maybeVal->originatorId);
+  EXPECT_EQ("value1", maybeVal->value_ref().value());
+}
+
 //
 TEST_F(KvStoreTestFixture, CounterReport) {
   const std::unordered_map<std::string, thrift::PeerSpec> emptyPeers;
@@ -1379,6 +1547,9 @@ TEST_F(KvStoreTestFixture, DualTest) {
       EXPECT_EQ(sptInfos.floodPeers.size(), 2);
       EXPECT_EQ(sptInfos.floodPeers.count("n0"), 1);
       EXPECT_EQ(sptInfos.floodPeers.count("n1"), 1);
+
+      // per-edge flood traffic counters are exported alongside the topo
+      EXPECT_TRUE(sptInfos.floodEdgeCounters_ref().has_value());
     }
 
     // validate r1
@@ -2357,6 +2528,144 @@ TEST_F(KvStoreTestFixture, DumpDifference) {
   }
 }
 
+/**
+ * Verify the incremental (cursor based) dump API: a dump presenting a
+ * cursor only returns key-vals updated after it and stamps a new cursor.
+ */
+TEST_F(KvStoreTestFixture, DumpIncremental) {
+  LOG(INFO) << "Starting store under test";
+
+  // set up the store that we'll be testing
+  const std::unordered_map<std::string, thrift::PeerSpec> emptyPeers;
+  auto myStore = createKvStore("test-node", emptyPeers);
+  myStore->run();
+
+  for (int i = 0; i < 3; ++i) {
+    const auto key = folly::sformat("test-key-{}", i);
+    thrift::Value thriftVal(
+        apache::thrift::FRAGILE,
+        1 /* version */,
+        "gotham_city" /* originatorId */,
+        folly::sformat("test-value-{}", i),
+        Constants::kTtlInfinity /* ttl */,
+        0 /* ttl version */,
+        0 /* hash */);
+    myStore->setKey(key, thriftVal);
+  }
+
+  // 0. Dump with cursor 0 returns everything plus the current cursor
+  auto fullPub = myStore->dumpIncremental(0);
+  EXPECT_EQ(3, fullPub.keyVals.size());
+  ASSERT_TRUE(fullPub.updateSeq_ref().has_value());
+  const auto cursor = fullPub.updateSeq_ref().value();
+
+  // 1. Nothing changed - incremental dump is empty but re-stamps cursor
+  auto emptyPub = myStore->dumpIncremental(cursor);
+  EXPECT_EQ(0, emptyPub.keyVals.size());
+  EXPECT_EQ(cursor, emptyPub.updateSeq_ref().value());
+
+  // 2. Update one key - only it comes back, with an advanced cursor
+  thrift::Value newThriftVal(
+      apache::thrift::FRAGILE,
+      2 /* version */,
+      "gotham_city" /* originatorId */,
+      std::string("why-so-serious"),
+      Constants::kTtlInfinity /* ttl */,
+      0 /* ttl version */,
+      0 /* hash */);
+  myStore->setKey("test-key-1", newThriftVal);
+
+  auto deltaPub = myStore->dumpIncremental(cursor);
+  EXPECT_EQ(1, deltaPub.keyVals.size());
+  EXPECT_EQ(1, deltaPub.keyVals.count("test-key-1"));
+  EXPECT_LT(cursor, deltaPub.updateSeq_ref().value());
+}
+
+/**
+ * Verify the range (paginated) dump API: bounded pages walk the key space
+ * in lexicographic order and chain via the nextKey resume cursor.
+ */
+TEST_F(KvStoreTestFixture, DumpRange) {
+  LOG(INFO) << "Starting store under test";
+
+  // set up the store that we'll be testing
+  const std::unordered_map<std::string, thrift::PeerSpec> emptyPeers;
+  auto myStore = createKvStore("test-node", emptyPeers);
+  myStore->run();
+
+  for (int i = 0; i < 5; ++i) {
+    const auto key = folly::sformat("test-key-{}", i);
+    thrift::Value thriftVal(
+        apache::thrift::FRAGILE,
+        1 /* version */,
+        "gotham_city" /* originatorId */,
+        folly::sformat("test-value-{}", i),
+        Constants::kTtlInfinity /* ttl */,
+        0 /* ttl version */,
+        0 /* hash */);
+    myStore->setKey(key, thriftVal);
+  }
+
+  // page through the store two keys at a time; pages arrive in key order
+  // and chain via nextKey until the key space is exhausted
+  std::unordered_map<std::string, thrift::Value> collected;
+  std::optional<std::string> cursor{std::nullopt};
+  size_t pageCnt{0};
+  while (true) {
+    auto page = myStore->dumpRange(cursor, 2 /* maxKeys */);
+    ++pageCnt;
+    EXPECT_LE(page.keyVals.size(), 2);
+    collected.insert(page.keyVals.begin(), page.keyVals.end());
+    if (not page.nextKey_ref().has_value()) {
+      break;
+    }
+    cursor = page.nextKey_ref().value();
+  }
+  EXPECT_EQ(3, pageCnt);
+  EXPECT_EQ(5, collected.size());
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(1, collected.count(folly::sformat("test-key-{}", i)));
+  }
+
+  // a cursor past the last key yields an empty, cursor-less page
+  auto tailPub = myStore->dumpRange(std::string("test-key-4"), 2);
+  EXPECT_EQ(0, tailPub.keyVals.size());
+  EXPECT_FALSE(tailPub.nextKey_ref().has_value());
+}
+
+/**
+ * Two stores peer with each other; once their initial full-syncs settle
+ * each store emits an initialSyncComplete-flagged publication on its
+ * updates queue for cold-start consumers (e.g. Decision).
+ */
+TEST_F(KvStoreTestFixture, InitialSyncSignal) {
+  const std::unordered_map<std::string, thrift::PeerSpec> emptyPeers;
+  auto store0 = createKvStore("store0", emptyPeers);
+  auto store1 = createKvStore("store1", emptyPeers);
+  store0->run();
+  store1->run();
+
+  // grab raw readers; KvStoreWrapper::recvPublication() filters the
+  // control-plane signal out on purpose
+  auto reader0 = store0->getReader();
+  auto reader1 = store1->getReader();
+
+  EXPECT_TRUE(store0->addPeer(store1->nodeId, store1->getPeerSpec()));
+  EXPECT_TRUE(store1->addPeer(store0->nodeId, store0->getPeerSpec()));
+
+  auto awaitSyncSignal = [](messaging::RQueue<thrift::Publication>& reader) {
+    while (true) {
+      auto maybePub = reader.get();
+      ASSERT_TRUE(maybePub.hasValue());
+      if (maybePub.value().initialSyncComplete_ref().value_or(false)) {
+        break;
+      }
+    }
+  };
+  awaitSyncSignal(reader0);
+  awaitSyncSignal(reader1);
+}
+
 /**
  * Start single testable store, and set key values with oneway method. Verify
  * content of KvStore by querying it.
@@ -2821,6 +3130,211 @@ TEST_F(KvStoreTestFixture, FullSync) {
   EXPECT_EQ(v4->value_ref().value(), "b");
 }
 
+/**
+ * Verify that a full-sync whose response exceeds the per-message chunk
+ * limit is streamed in bounded KEY_SET chunks and still converges. Seed
+ * one store with more keys than Constants::kMaxFullSyncChunkKeyCnt, peer
+ * an empty store with it and expect the whole database to arrive.
+ */
+TEST_F(KvStoreTestFixture, ChunkedFullSync) {
+  const std::unordered_map<std::string, thrift::PeerSpec> emptyPeers;
+  const size_t numKeys = Constants::kMaxFullSyncChunkKeyCnt + 100;
+  auto storeA = createKvStore("storeA", emptyPeers);
+  auto storeB = createKvStore("storeB", emptyPeers);
+  storeA->run();
+  storeB->run();
+
+  // seed storeB with more key-vals than fit in a single sync message
+  std::vector<std::pair<std::string, thrift::Value>> keyVals;
+  keyVals.reserve(numKeys);
+  for (size_t i = 0; i < numKeys; ++i) {
+    thrift::Value val = createThriftValue(
+        1 /* version */,
+        "storeB" /* originatorId */,
+        folly::sformat("value-{}", i) /* value */,
+        Constants::kTtlInfinity /* ttl */,
+        0 /* ttl version */,
+        0 /* hash */);
+    val.hash_ref() =
+        generateHash(val.version, val.originatorId, val.value_ref());
+    keyVals.emplace_back(folly::sformat("test-key-{}", i), val);
+  }
+  EXPECT_TRUE(storeB->setKeys(keyVals));
+
+  // peer the stores both ways (chunks ride the responder's sync channel
+  // towards its peer), let A full-sync from B and wait for chunks to land
+  storeB->addPeer("storeA", storeA->getPeerSpec());
+  storeA->addPeer("storeB", storeB->getPeerSpec());
+  /* sleep override */
+  std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+
+  auto dumpA = storeA->dumpAll();
+  EXPECT_EQ(numKeys, dumpA.size());
+  for (size_t i = 0; i < numKeys; i += 1000) {
+    auto val = storeA->getKey(folly::sformat("test-key-{}", i));
+    ASSERT_TRUE(val.has_value());
+    EXPECT_EQ(folly::sformat("value-{}", i), val->value_ref().value());
+  }
+}
+
+/**
+ * Verify flood priority classes. With a large coalescing window and "adj:"
+ * configured as priority prefix, an adj: key must flood to the peer right
+ * away while a prefix: key stays buffered until the window elapses.
+ */
+TEST_F(KvStoreTestFixture, FloodPriorityClasses) {
+  const std::unordered_map<std::string, thrift::PeerSpec> emptyPeers;
+
+  auto kvConf = getTestKvConf();
+  kvConf.flood_coalesce_window_ms_ref() = 2000;
+  kvConf.flood_priority_key_prefixes_ref() =
+      std::vector<std::string>{Constants::kAdjDbMarker.str()};
+  auto storeA = createKvStore("storeA", emptyPeers, kvConf);
+  auto storeB = createKvStore("storeB", emptyPeers);
+  storeA->run();
+  storeB->run();
+  EXPECT_TRUE(storeA->addPeer("storeB", storeB->getPeerSpec()));
+
+  auto makeValue = [](const std::string& value) {
+    thrift::Value val = createThriftValue(
+        1 /* version */,
+        "storeA" /* originatorId */,
+        value,
+        Constants::kTtlInfinity /* ttl */,
+        0 /* ttl version */,
+        0 /* hash */);
+    val.hash_ref() =
+        generateHash(val.version, val.originatorId, val.value_ref());
+    return val;
+  };
+
+  // bulk key goes in first, priority key second. The adj: key must still
+  // overtake the buffered prefix: key on the wire
+  EXPECT_TRUE(storeA->setKey("prefix:bulk-key", makeValue("bulk-value")));
+  EXPECT_TRUE(storeA->setKey("adj:node-1", makeValue("adj-value")));
+
+  // give the flood a moment to land; well within the coalescing window
+  /* sleep override */
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  EXPECT_TRUE(storeB->getKey("adj:node-1").has_value());
+  EXPECT_FALSE(storeB->getKey("prefix:bulk-key").has_value());
+
+  // once the window elapses the buffered bulk key floods as well
+  /* sleep override */
+  std::this_thread::sleep_for(std::chrono::milliseconds(2300));
+  auto bulkVal = storeB->getKey("prefix:bulk-key");
+  ASSERT_TRUE(bulkVal.has_value());
+  EXPECT_EQ("bulk-value", bulkVal->value_ref().value());
+}
+
+/**
+ * Verify opt-in flood-path tracing. With a sample rate of 1 every key is
+ * traced: a key set on storeA must arrive at storeB carrying storeA's hop,
+ * and both stores must retain harvestable trace records.
+ */
+TEST_F(KvStoreTestFixture, FloodPathTracing) {
+  const std::unordered_map<std::string, thrift::PeerSpec> emptyPeers;
+
+  auto kvConf = getTestKvConf();
+  kvConf.flood_trace_sample_rate_ref() = 1;
+  auto storeA = createKvStore("storeA", emptyPeers, kvConf);
+  auto storeB = createKvStore("storeB", emptyPeers, kvConf);
+  storeA->run();
+  storeB->run();
+  EXPECT_TRUE(storeA->addPeer("storeB", storeB->getPeerSpec()));
+
+  thrift::Value val = createThriftValue(
+      1 /* version */,
+      "storeA" /* originatorId */,
+      std::string("traced-value") /* value */,
+      Constants::kTtlInfinity /* ttl */,
+      0 /* ttl version */,
+      0 /* hash */);
+  val.hash_ref() = generateHash(val.version, val.originatorId, val.value_ref());
+  EXPECT_TRUE(storeA->setKey("traced-key", val));
+
+  // let the update flood to storeB
+  /* sleep override */
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  ASSERT_TRUE(storeB->getKey("traced-key").has_value());
+
+  // storeA recorded itself as the trace origin. Its harvested copy was
+  // taken at merge time, before the egress timestamp was stamped
+  auto tracesA = storeA->getFloodTraces();
+  ASSERT_EQ(1, tracesA.size());
+  EXPECT_EQ("traced-key", tracesA.at(0).key);
+  ASSERT_EQ(1, tracesA.at(0).trace.hops.size());
+  EXPECT_EQ("storeA", tracesA.at(0).trace.hops.at(0).nodeId);
+  EXPECT_LT(0, tracesA.at(0).trace.hops.at(0).ingressTimeNs);
+
+  // storeB's record carries storeA's full hop (egress stamped at flood
+  // time) followed by its own
+  auto tracesB = storeB->getFloodTraces();
+  ASSERT_EQ(1, tracesB.size());
+  EXPECT_EQ("traced-key", tracesB.at(0).key);
+  auto const& hops = tracesB.at(0).trace.hops;
+  ASSERT_EQ(2, hops.size());
+  EXPECT_EQ("storeA", hops.at(0).nodeId);
+  EXPECT_LE(hops.at(0).ingressTimeNs, hops.at(0).egressTimeNs);
+  EXPECT_EQ("storeB", hops.at(1).nodeId);
+  EXPECT_LE(hops.at(0).egressTimeNs, hops.at(1).ingressTimeNs);
+
+  // harvest drains the buffer
+  EXPECT_TRUE(storeA->getFloodTraces().empty());
+  EXPECT_TRUE(storeB->getFloodTraces().empty());
+}
+
+/**
+ * Verify the receive-side reordering buffer for sequenced thrift floods.
+ * Publications carrying (senderId, floodSeqNum) that arrive ahead of their
+ * predecessors are parked until the gap closes (or the flush timer fires)
+ * so merges apply in send order.
+ */
+TEST_F(KvStoreTestFixture, FloodReorderBuffer) {
+  const std::unordered_map<std::string, thrift::PeerSpec> emptyPeers;
+
+  auto store = createKvStore("storeA", emptyPeers);
+  store->run();
+
+  auto makeParams = [](std::string const& key, int64_t seqNum) {
+    thrift::Value val = createThriftValue(
+        1 /* version */,
+        "storeB" /* originatorId */,
+        std::string("value-") + key /* value */,
+        Constants::kTtlInfinity /* ttl */,
+        0 /* ttl version */,
+        0 /* hash */);
+    val.hash_ref() =
+        generateHash(val.version, val.originatorId, val.value_ref());
+    thrift::KeySetParams params;
+    params.keyVals.emplace(key, std::move(val));
+    params.senderId_ref() = "storeB";
+    params.floodSeqNum_ref() = seqNum;
+    return params;
+  };
+
+  const auto area = thrift::KvStore_constants::kDefaultArea();
+  auto* kvStore = store->getKvStore();
+
+  // seq 2 arrives before seq 1: it must be parked, not merged
+  kvStore->setKvStoreKeyVals(makeParams("reorder-key-2", 2), area).get();
+  EXPECT_FALSE(store->getKey("reorder-key-2").has_value());
+
+  // seq 1 closes the gap: both publications apply, in order
+  kvStore->setKvStoreKeyVals(makeParams("reorder-key-1", 1), area).get();
+  EXPECT_TRUE(store->getKey("reorder-key-1").has_value());
+  EXPECT_TRUE(store->getKey("reorder-key-2").has_value());
+
+  // seq 4 leaves a gap (seq 3 never arrives): the flush timer applies the
+  // parked publication rather than holding it indefinitely
+  kvStore->setKvStoreKeyVals(makeParams("reorder-key-4", 4), area).get();
+  EXPECT_FALSE(store->getKey("reorder-key-4").has_value());
+  /* sleep override */
+  std::this_thread::sleep_for(
+      Constants::kFloodReorderFlushTimeout + std::chrono::milliseconds(100));
+  EXPECT_TRUE(store->getKey("reorder-key-4").has_value());
+}
+
 /* Kvstore tests related to area */
 
 /* Verify flooding is containted within an area. Add a key in one area and
@@ -142,6 +142,70 @@ TEST_F(KvStoreThriftTestFixture, thriftClientConnection) {
   EXPECT_EQ(expPeer2_2, store2->getPeers());
 }
 
+//
+// Verify initial full-sync happens over the thrift channel:
+//
+// 1) spin up 2 kvStores and 2 corresponding thrift servers;
+// 2) inject different key-vals into each store BEFORE peering;
+// 3) add peers for both stores and wait for stores to learn each
+//    other's key-vals purely via thrift full-sync + flooding;
+//
+TEST_F(KvStoreThriftTestFixture, initialThriftSync) {
+  const std::string node1{"node-1"};
+  const std::string node2{"node-2"};
+
+  // spin up kvStore instances through kvStoreWrapper
+  auto store1 = createKvStore(node1);
+  auto store2 = createKvStore(node2);
+  store1->run();
+  store2->run();
+
+  // spin up OpenrThriftServer
+  auto thriftServer1 = createThriftServer(node1, store1);
+  auto thriftServer2 = createThriftServer(node2, store2);
+  thriftServer1->run();
+  thriftServer2->run();
+
+  // inject key-vals into each store before any peering happens
+  const std::string key1{"test-key-1"};
+  const std::string key2{"test-key-2"};
+  auto thriftVal1 = createThriftValue(
+      1 /* version */, node1 /* originatorId */, std::string("test-value-1"));
+  auto thriftVal2 = createThriftValue(
+      1 /* version */, node2 /* originatorId */, std::string("test-value-2"));
+  EXPECT_TRUE(store1->setKey(key1, thriftVal1));
+  EXPECT_TRUE(store2->setKey(key2, thriftVal2));
+
+  // build peerSpec for thrift client connection
+  auto peerSpec1 = createPeerSpec(
+      "inproc://dummy-spec-1",
+      localhost_,
+      thriftServer2->getOpenrCtrlThriftPort());
+  auto peerSpec2 = createPeerSpec(
+      "inproc://dummy-spec-2",
+      localhost_,
+      thriftServer1->getOpenrCtrlThriftPort());
+  EXPECT_TRUE(store1->addPeer(store2->nodeId, peerSpec1));
+  EXPECT_TRUE(store2->addPeer(store1->nodeId, peerSpec2));
+
+  // stores should learn each other's key-vals via thrift full-sync
+  while (not store1->getKey(key2).has_value() or
+         not store2->getKey(key1).has_value()) {
+    /* sleep override */
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+
+  EXPECT_EQ(thriftVal2.value_ref(), store1->getKey(key2).value().value_ref());
+  EXPECT_EQ(thriftVal1.value_ref(), store2->getKey(key1).value().value_ref());
+
+  // no full-sync should be pending on either side anymore
+  while (store1->getCounters().at("kvstore.pending_full_sync") != 0 or
+         store2->getCounters().at("kvstore.pending_full_sync") != 0) {
+    /* sleep override */
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+}
+
 TEST(KvStore, StateTransitionTest) {
   {
     // IDLE => SYNCING
@@ -0,0 +1,244 @@
+/**
+ * Copyright (c) 2014-present, Facebook, Inc.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <iostream>
+#include <map>
+
+#include <folly/Format.h>
+#include <folly/MemoryMapping.h>
+#include <folly/init/Init.h>
+#include <folly/io/Cursor.h>
+#include <folly/io/IOBuf.h>
+
+#include <openr/config-store/PersistentStore.h>
+#include <openr/if/gen-cpp2/KvStore_constants.h>
+#include <openr/kvstore/KvStore.h>
+
+DEFINE_string(snapshot_a, "", "Persistent-store file holding the snapshot");
+DEFINE_string(
+    snapshot_b,
+    "",
+    "Optional second persistent-store file to diff against; without it "
+    "only snapshot_a is summarized");
+DEFINE_string(
+    area, "", "Area whose snapshot to inspect (defaults to the default area)");
+DEFINE_int32(
+    max_keys_reported,
+    50,
+    "Maximum number of divergent keys printed per category");
+
+namespace {
+
+// must match the key prefix KvStore persists warm-boot snapshots under
+const std::string kDbSnapshotKeyPrefix{"kvstore-snapshot:"};
+
+/**
+ * Replay a persistent-store file into its final key -> payload map. The
+ * file is mmap'd and records are decoded in place, so inspection never
+ * copies the file through a read buffer - the same access pattern the
+ * store itself uses at load. A corrupted record discards the log tail,
+ * matching the store's own recovery behavior
+ */
+std::unordered_map<std::string, std::string>
+loadStoreDatabase(const std::string& filePath) {
+  folly::MemoryMapping mapping(filePath.c_str());
+  const auto range = mapping.range();
+  auto ioBuf = folly::IOBuf::wrapBuffer(range.data(), range.size());
+  const auto fileData = folly::StringPiece(
+      reinterpret_cast<const char*>(ioBuf->data()), ioBuf->length());
+
+  bool withChecksum{false};
+  folly::StringPiece marker;
+  if (fileData.startsWith(kTlvCrcFormatMarker)) {
+    withChecksum = true;
+    marker = kTlvCrcFormatMarker;
+  } else if (fileData.startsWith(kTlvFormatMarker)) {
+    marker = kTlvFormatMarker;
+  } else {
+    throw std::runtime_error(folly::sformat(
+        "'{}' is not a Tlv-format persistent-store file", filePath));
+  }
+
+  std::unordered_map<std::string, std::string> database;
+  folly::io::Cursor cursor(ioBuf.get());
+  cursor.readFixedString(marker.size());
+  while (true) {
+    auto optionalObject =
+        openr::PersistentStore::decodePersistentObject(cursor, withChecksum);
+    if (optionalObject.hasError()) {
+      LOG(WARNING) << "Corrupted record in '" << filePath
+                   << "': " << optionalObject.error()
+                   << ". Ignoring the log tail";
+      break;
+    }
+    if (not optionalObject->has_value()) {
+      break;
+    }
+    auto& pObject = optionalObject->value();
+    if (pObject.type == openr::ActionType::ADD) {
+      database[pObject.key] = pObject.data.value_or("");
+    } else {
+      database.erase(pObject.key);
+    }
+  }
+  return database;
+}
+
+openr::thrift::Publication
+loadSnapshot(const std::string& filePath, const std::string& area) {
+  auto database = loadStoreDatabase(filePath);
+  auto it = database.find(kDbSnapshotKeyPrefix + area);
+  if (it == database.end()) {
+    std::string available;
+    for (auto const& kv : database) {
+      if (kv.first.compare(
+              0, kDbSnapshotKeyPrefix.size(), kDbSnapshotKeyPrefix) == 0) {
+        available += " " + kv.first.substr(kDbSnapshotKeyPrefix.size());
+      }
+    }
+    throw std::runtime_error(folly::sformat(
+        "No snapshot for area '{}' in '{}'. Areas with snapshots:{}",
+        area,
+        filePath,
+        available.empty() ? " none" : available));
+  }
+  apache::thrift::CompactSerializer serializer;
+  const auto buf =
+      folly::IOBuf::wrapBufferAsValue(folly::StringPiece(it->second));
+  return openr::readThriftObj<openr::thrift::Publication>(buf, serializer);
+}
+
+void
+printSnapshotSummary(
+    const openr::thrift::Publication& snapshot, const std::string& name) {
+  std::map<std::string, uint64_t> keysPerOriginator;
+  uint64_t valueBytes{0};
+  for (auto const& kv : snapshot.keyVals) {
+    ++keysPerOriginator[kv.second.originatorId];
+    if (kv.second.value_ref().has_value()) {
+      valueBytes += kv.second.value_ref()->size();
+    }
+  }
+  std::cout << name << ": " << snapshot.keyVals.size() << " keys, "
+            << valueBytes << " value bytes" << std::endl;
+  for (auto const& kv : keysPerOriginator) {
+    std::cout << "  originator " << kv.first << ": " << kv.second << " keys"
+              << std::endl;
+  }
+}
+
+std::string
+describeValue(const openr::thrift::Value& value) {
+  return folly::sformat(
+      "version={} originator={} ttlVersion={}",
+      value.version,
+      value.originatorId,
+      value.ttlVersion);
+}
+
+void
+printKeys(
+    const std::string& category,
+    const std::vector<std::string>& keys,
+    const openr::thrift::Publication& snapshotA,
+    const openr::thrift::Publication& snapshotB) {
+  std::cout << category << ": " << keys.size() << " keys" << std::endl;
+  int32_t printed{0};
+  for (auto const& key : keys) {
+    if (printed++ >= FLAGS_max_keys_reported) {
+      std::cout << "  ... " << keys.size() - FLAGS_max_keys_reported << " more"
+                << std::endl;
+      break;
+    }
+    std::cout << "  " << key;
+    auto itA = snapshotA.keyVals.find(key);
+    auto itB = snapshotB.keyVals.find(key);
+    if (itA != snapshotA.keyVals.end()) {
+      std::cout << " | A: " << describeValue(itA->second);
+    }
+    if (itB != snapshotB.keyVals.end()) {
+      std::cout << " | B: " << describeValue(itB->second);
+    }
+    std::cout << std::endl;
+  }
+}
+
+} // namespace
+
+int
+main(int argc, char** argv) {
+  // Initialize all params
+  folly::init(&argc, &argv);
+
+  if (FLAGS_snapshot_a.empty()) {
+    LOG(ERROR) << "--snapshot_a is required";
+    return 2;
+  }
+  const auto area = FLAGS_area.empty()
+      ? openr::thrift::KvStore_constants::kDefaultArea()
+      : FLAGS_area;
+
+  const auto snapshotA = loadSnapshot(FLAGS_snapshot_a, area);
+  printSnapshotSummary(snapshotA, FLAGS_snapshot_a);
+  if (FLAGS_snapshot_b.empty()) {
+    return 0;
+  }
+
+  const auto snapshotB = loadSnapshot(FLAGS_snapshot_b, area);
+  printSnapshotSummary(snapshotB, FLAGS_snapshot_b);
+
+  // Per-key comparison with KvStore's own resolution order (version,
+  // originator, value hash, ttl version), so "newer" here means exactly
+  // what the flooding protocol would conclude. Identical keys cost one
+  // lookup and compare; only divergent keys are materialized
+  std::vector<std::string> onlyInA;
+  std::vector<std::string> onlyInB;
+  std::vector<std::string> newerInA;
+  std::vector<std::string> newerInB;
+  std::vector<std::string> conflicting;
+  for (auto const& kv : snapshotA.keyVals) {
+    auto it = snapshotB.keyVals.find(kv.first);
+    if (it == snapshotB.keyVals.end()) {
+      onlyInA.emplace_back(kv.first);
+      continue;
+    }
+    switch (openr::KvStore::compareValues(kv.second, it->second)) {
+    case 1:
+      newerInA.emplace_back(kv.first);
+      break;
+    case -1:
+      newerInB.emplace_back(kv.first);
+      break;
+    case 0:
+      break;
+    default:
+      // values differ but neither hash nor value allows ordering them
+      conflicting.emplace_back(kv.first);
+      break;
+    }
+  }
+  for (auto const& kv : snapshotB.keyVals) {
+    if (not snapshotA.keyVals.count(kv.first)) {
+      onlyInB.emplace_back(kv.first);
+    }
+  }
+
+  const auto numDivergent = onlyInA.size() + onlyInB.size() + newerInA.size() +
+      newerInB.size() + conflicting.size();
+  std::cout << std::endl
+            << "Divergence: " << numDivergent << " of "
+            << snapshotA.keyVals.size() + onlyInB.size() << " keys"
+            << std::endl;
+  printKeys("Only in A", onlyInA, snapshotA, snapshotB);
+  printKeys("Only in B", onlyInB, snapshotA, snapshotB);
+  printKeys("Newer in A", newerInA, snapshotA, snapshotB);
+  printKeys("Newer in B", newerInB, snapshotA, snapshotB);
+  printKeys("Conflicting (unorderable)", conflicting, snapshotA, snapshotB);
+
+  // scripting-friendly: exit 0 only when the snapshots agree
+  return numDivergent == 0 ? 0 : 1;
+}
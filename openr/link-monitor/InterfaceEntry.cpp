@@ -6,6 +6,9 @@
  */
 
 #include "InterfaceEntry.h"
+
+#include <cmath>
+
 #include <folly/gen/Base.h>
 #include <openr/common/NetworkUtil.h>
 #include <openr/common/Util.h>
@@ -32,15 +35,36 @@ InterfaceEntry::updateAttrs(int ifIndex, bool isUp, uint64_t weight) {
   isUpdated |= std::exchange(isUp_, isUp) != isUp;
   isUpdated |= std::exchange(weight_, weight) != weight;
 
+  // Remember when the interface came up for micro-flap classification
+  if (not wasUp and isUp) {
+    lastUpTime_ = std::chrono::steady_clock::now();
+  }
+
   // Look for specific case of interface state transition to DOWN
   if (wasUp != isUp and wasUp) {
     // Penalize backoff on transitioning to DOWN state
     backoff_.reportError();
+
+    // Accrue damping penalty. A micro-flap (up for less than the micro-flap
+    // window, typical of failing optics) carries a heavier penalty than a
+    // sustained down event
+    decayPenalty();
+    const auto upDuration = std::chrono::steady_clock::now() - lastUpTime_;
+    dampPenalty_ += upDuration < Constants::kLinkMicroFlapWindow
+        ? Constants::kLinkFlapMicroFlapPenalty
+        : Constants::kLinkFlapDownPenalty;
+    if (dampPenalty_ >= Constants::kLinkFlapSuppressThreshold) {
+      dampSuppressed_ = true;
+      LOG(WARNING) << "Damping interface " << ifName_ << " with penalty "
+                   << static_cast<int64_t>(dampPenalty_);
+    }
   }
 
   // Look for active to down transition
-  if (wasActive and not isUp) {
-    // Schedule immediate timeout for fast propagation of link-down event
+  if (wasActive and not isUp and not updateTimeout_.isScheduled()) {
+    // Schedule immediate timeout for fast propagation of link-down event.
+    // An already armed timer is left alone so a burst of down events
+    // cannot keep pushing the deadline back - they ride the pending fire
     updateTimeout_.scheduleTimeout(Constants::kLinkImmediateTimeout);
   }
 
@@ -57,6 +81,17 @@ InterfaceEntry::isActive() {
     return false;
   }
 
+  // Release damping suppression once the penalty has decayed below the
+  // reuse threshold
+  decayPenalty();
+  if (dampSuppressed_ and dampPenalty_ <= Constants::kLinkFlapReuseThreshold) {
+    dampSuppressed_ = false;
+    LOG(INFO) << "Reusing damped interface " << ifName_;
+  }
+  if (dampSuppressed_) {
+    return false;
+  }
+
   const auto lastErrorTime = backoff_.getLastErrorTime();
   const auto now = std::chrono::steady_clock::now();
   if (now - lastErrorTime > backoff_.getMaxBackoff()) {
@@ -67,7 +102,41 @@ InterfaceEntry::isActive() {
 
 std::chrono::milliseconds
 InterfaceEntry::getBackoffDuration() const {
-  return backoff_.getTimeRemainingUntilRetry();
+  auto backoffDuration = backoff_.getTimeRemainingUntilRetry();
+
+  if (dampSuppressed_ and
+      dampPenalty_ > Constants::kLinkFlapReuseThreshold) {
+    // Time for the penalty to decay down to the reuse threshold, counted
+    // from the last decay point
+    const auto decayDuration = std::chrono::milliseconds(static_cast<int64_t>(
+        Constants::kLinkFlapDampingHalfLife.count() *
+        std::log2(dampPenalty_ / Constants::kLinkFlapReuseThreshold)));
+    const auto reuseDuration =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            (lastPenaltyTime_ + decayDuration) -
+            std::chrono::steady_clock::now());
+    backoffDuration = std::max(
+        backoffDuration, std::max(reuseDuration, std::chrono::milliseconds(0)));
+  }
+
+  return backoffDuration;
+}
+
+void
+InterfaceEntry::decayPenalty() {
+  const auto now = std::chrono::steady_clock::now();
+  if (dampPenalty_ > 0) {
+    const auto elapsed =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            now - lastPenaltyTime_);
+    dampPenalty_ *= std::exp2(
+        -static_cast<double>(elapsed.count()) /
+        Constants::kLinkFlapDampingHalfLife.count());
+    if (dampPenalty_ < 1) {
+      dampPenalty_ = 0;
+    }
+  }
+  lastPenaltyTime_ = now;
 }
 
 bool
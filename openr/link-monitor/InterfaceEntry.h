@@ -43,11 +43,13 @@ class InterfaceEntry final {
   // Update addresses
   bool updateAddr(folly::CIDRNetwork const& ipNetwork, bool isValid);
 
-  // Is interface active. Interface is active only when it is in UP state and
-  // it's not backed off
+  // Is interface active. Interface is active only when it is in UP state,
+  // it's not backed off and it's not suppressed by flap damping
   bool isActive();
 
-  // Get backoff time
+  // Get backoff time. Accounts for both the exponential backoff and, when
+  // the interface is suppressed, the time for the damping penalty to decay
+  // below the reuse threshold
   std::chrono::milliseconds getBackoffDuration() const;
 
   // Used to check for updates if doing a re-sync
@@ -111,6 +113,10 @@ class InterfaceEntry final {
   thrift::InterfaceInfo getInterfaceInfo() const;
 
  private:
+  // Decay the accumulated damping penalty towards zero. Must be invoked
+  // before every read or update of dampPenalty_
+  void decayPenalty();
+
   // Attributes
   std::string const ifName_;
   int ifIndex_{0};
@@ -121,6 +127,15 @@ class InterfaceEntry final {
   // Backoff variables
   ExponentialBackoff<std::chrono::milliseconds> backoff_;
 
+  // Flap damping state. Penalty accumulates on down transitions (by severity
+  // class, see Constants) and decays exponentially. While suppressed the
+  // interface stays inactive until the penalty falls below the reuse
+  // threshold
+  double dampPenalty_{0};
+  bool dampSuppressed_{false};
+  std::chrono::steady_clock::time_point lastPenaltyTime_;
+  std::chrono::steady_clock::time_point lastUpTime_;
+
   // Update callback
   fbzmq::ZmqThrottle& updateCallback_;
   fbzmq::ZmqTimeout& updateTimeout_;
@@ -8,6 +8,8 @@
 #include "LinkMonitor.h"
 
 #include <functional>
+#include <map>
+#include <set>
 
 #include <fb303/ServiceData.h>
 #include <fbzmq/service/if/gen-cpp2/Monitor_types.h>
@@ -66,6 +68,61 @@ printLinkMonitorState(openr::thrift::LinkMonitorState const& state) {
 
 namespace openr {
 
+std::vector<thrift::SparkNeighborEvent>
+prioritizeNeighborEvents(std::vector<thrift::SparkNeighborEvent> events) {
+  if (events.size() <= 1) {
+    return events;
+  }
+
+  auto const eventKey = [](thrift::SparkNeighborEvent const& event) {
+    return std::make_pair(event.ifName, event.neighbor.nodeName);
+  };
+
+  // remember the newest RTT measurement per adjacency so older ones in the
+  // batch can be dropped
+  std::map<std::pair<std::string, std::string>, size_t> lastRttEventIdx;
+  // adjacencies with a DOWN/RESTARTING event jump the line wholesale
+  std::set<std::pair<std::string, std::string>> urgentKeys;
+  for (size_t i = 0; i < events.size(); ++i) {
+    switch (events[i].eventType) {
+    case thrift::SparkNeighborEventType::NEIGHBOR_RTT_CHANGE:
+      lastRttEventIdx[eventKey(events[i])] = i;
+      break;
+    case thrift::SparkNeighborEventType::NEIGHBOR_DOWN:
+    case thrift::SparkNeighborEventType::NEIGHBOR_RESTARTING:
+      urgentKeys.emplace(eventKey(events[i]));
+      break;
+    default:
+      break;
+    }
+  }
+  if (urgentKeys.empty() and lastRttEventIdx.empty()) {
+    return events;
+  }
+
+  // pass 0 emits events of urgent adjacencies, pass 1 the rest; within a
+  // pass original order is kept, so no single adjacency is ever reordered
+  std::vector<thrift::SparkNeighborEvent> prioritized;
+  prioritized.reserve(events.size());
+  for (int pass = 0; pass < 2; ++pass) {
+    for (size_t i = 0; i < events.size(); ++i) {
+      auto const key = eventKey(events[i]);
+      if ((pass == 0) != (urgentKeys.count(key) > 0)) {
+        continue;
+      }
+      if (events[i].eventType ==
+              thrift::SparkNeighborEventType::NEIGHBOR_RTT_CHANGE and
+          lastRttEventIdx.at(key) != i) {
+        fb303::fbData->addStatValue(
+            "link_monitor.rtt_changes_coalesced", 1, fb303::COUNT);
+        continue;
+      }
+      prioritized.emplace_back(std::move(events[i]));
+    }
+  }
+  return prioritized;
+}
+
 //
 // LinkMonitor code
 //
@@ -84,7 +141,8 @@ LinkMonitor::LinkMonitor(
     bool assumeDrained,
     messaging::ReplicateQueue<thrift::PrefixUpdateRequest>& prefixUpdatesQueue,
     PlatformPublisherUrl const& platformPubUrl,
-    std::chrono::seconds adjHoldTime)
+    std::chrono::seconds adjHoldTime,
+    fbnl::NetlinkProtocolSocket* nlSock)
     : nodeId_(config->getNodeName()),
       platformThriftPort_(platformThriftPort),
       staticPrefixes_(staticPrefixes),
@@ -96,20 +154,21 @@ LinkMonitor::LinkMonitor(
       prefixForwardingAlgorithm_(
           config->getConfig().prefix_forwarding_algorithm),
       useRttMetric_(config->getLinkMonitorConfig().use_rtt_metric),
+      enableCompactAdjDb_(
+          config->getLinkMonitorConfig().enable_compact_adjacency_db),
       linkflapInitBackoff_(std::chrono::milliseconds(
           config->getLinkMonitorConfig().linkflap_initial_backoff_ms)),
       linkflapMaxBackoff_(std::chrono::milliseconds(
           config->getLinkMonitorConfig().linkflap_max_backoff_ms)),
       ttlKeyInKvStore_(config->getKvStoreKeyTtl()),
-      includeItfRegexes_(config->getIncludeItfRegexes()),
-      excludeItfRegexes_(config->getExcludeItfRegexes()),
-      redistributeItfRegexes_(config->getRedistributeItfRegexes()),
+      config_(config),
       areas_(config->getAreaIds()),
       interfaceUpdatesQueue_(intfUpdatesQueue),
       prefixUpdatesQueue_(prefixUpdatesQueue),
       peerUpdatesQueue_(peerUpdatesQueue),
       nlEventSub_(
           zmqContext, folly::none, folly::none, fbzmq::NonblockingFlag{true}),
+      nlSock_(nlSock),
       expBackoff_(Constants::kInitialBackoff, Constants::kMaxBackoff),
       configStore_(configStore) {
   // Check non-empty module ptr
@@ -144,8 +203,13 @@ LinkMonitor::LinkMonitor(
       getEvb(), [this]() noexcept { advertiseIfaceAddr(); });
 
   LOG(INFO) << "Loading link-monitor state";
-  zmqMonitorClient_ =
-      std::make_unique<fbzmq::ZmqMonitorClient>(zmqContext, monitorSubmitUrl);
+  eventLogger_ = std::make_unique<EventLogger>(
+      std::make_shared<fbzmq::ZmqMonitorClient>(zmqContext, monitorSubmitUrl));
+
+  if (const auto captureDir = config->getEventCaptureDir()) {
+    replayLogWriter_ = std::make_unique<ReplayLogWriter>(
+        folly::sformat("{}/link-monitor-events.bin", *captureDir));
+  }
 
   // Create config-store client
   auto state =
@@ -207,12 +271,17 @@ LinkMonitor::LinkMonitor(
   // Add fiber to process the neighbor events
   addFiberTask([q = std::move(neighborUpdatesQueue), this]() mutable noexcept {
     while (true) {
-      auto maybeEvent = q.get();
-      if (maybeEvent.hasError()) {
+      // drain the whole backlog so DOWN/RESTARTING events can bypass
+      // queued informational chatter from other neighbors
+      auto maybeEvents = q.getAll();
+      if (maybeEvents.hasError()) {
         LOG(INFO) << "Terminating neighbor update processing fiber";
         break;
       }
-      processNeighborEvent(std::move(maybeEvent).value());
+      for (auto& event : prioritizeNeighborEvents(
+               std::move(maybeEvents).value())) {
+        processNeighborEvent(std::move(event));
+      }
     }
   });
 
@@ -225,14 +294,46 @@ LinkMonitor::LinkMonitor(
   fb303::fbData->addStatExportType(
       "link_monitor.advertise_adjacencies", fb303::SUM);
   fb303::fbData->addStatExportType("link_monitor.advertise_links", fb303::SUM);
+  fb303::fbData->addStatExportType(
+      "link_monitor.rtt_changes_coalesced", fb303::COUNT);
 }
 
 void
 LinkMonitor::prepare() noexcept {
-  //
-  // Prepare all sockets
-  //
+  // Subscribe to link/addr events - directly on the in-process netlink
+  // socket when available, otherwise over the platform publisher
+  if (nlSock_) {
+    subscribeNetlinkEvents();
+  } else {
+    subscribePlatformEvents();
+  }
+
+  // Schedule periodic timer for InterfaceDb re-sync from Netlink Platform
+  interfaceDbSyncTimer_ = fbzmq::ZmqTimeout::make(getEvb(), [this]() noexcept {
+    auto success = syncInterfaces();
+    if (success) {
+      VLOG(2) << "InterfaceDb Sync is successful";
+      expBackoff_.reportSuccess();
+      interfaceDbSyncTimer_->scheduleTimeout(
+          Constants::kPlatformSyncInterval, true /* isPeriodic */);
+    } else {
+      fb303::fbData->addStatValue(
+          "link_monitor.thrift.failure.getAllLinks", 1, fb303::SUM);
+      // Apply exponential backoff and schedule next run
+      expBackoff_.reportError();
+      interfaceDbSyncTimer_->scheduleTimeout(
+          expBackoff_.getTimeRemainingUntilRetry());
+      LOG(ERROR)
+          << "InterfaceDb Sync failed, apply exponential backoff and retry in "
+          << expBackoff_.getTimeRemainingUntilRetry().count() << " ms";
+    }
+  });
+  // schedule immediate with small timeout
+  interfaceDbSyncTimer_->scheduleTimeout(std::chrono::milliseconds(100));
+}
 
+void
+LinkMonitor::subscribePlatformEvents() {
   // Subscribe to link/addr events published by NetlinkAgent
   VLOG(2) << "Connect to PlatformPublisher to subscribe NetlinkEvent on "
           << platformPubUrl_;
@@ -282,6 +383,12 @@ LinkMonitor::prepare() noexcept {
             static_cast<uint16_t>(eventType),
             eventHeader.read<uint16_t>().value());
 
+        // record the raw event stream before any processing so a capture
+        // replays exactly what production saw
+        if (replayLogWriter_) {
+          replayLogWriter_->appendPlatformEvent(eventMsg.value());
+        }
+
         switch (eventType) {
         case thrift::PlatformEventType::LINK_EVENT: {
           VLOG(3) << "Received Link Event from Platform....";
@@ -329,29 +436,68 @@ LinkMonitor::prepare() noexcept {
                      << ", eventType: " << static_cast<uint16_t>(eventType);
         }
       });
+}
 
-  // Schedule periodic timer for InterfaceDb re-sync from Netlink Platform
-  interfaceDbSyncTimer_ = fbzmq::ZmqTimeout::make(getEvb(), [this]() noexcept {
-    auto success = syncInterfaces();
-    if (success) {
-      VLOG(2) << "InterfaceDb Sync is successful";
-      expBackoff_.reportSuccess();
-      interfaceDbSyncTimer_->scheduleTimeout(
-          Constants::kPlatformSyncInterval, true /* isPeriodic */);
-    } else {
-      fb303::fbData->addStatValue(
-          "link_monitor.thrift.failure.getAllLinks", 1, fb303::SUM);
-      // Apply exponential backoff and schedule next run
-      expBackoff_.reportError();
-      interfaceDbSyncTimer_->scheduleTimeout(
-          expBackoff_.getTimeRemainingUntilRetry());
-      LOG(ERROR)
-          << "InterfaceDb Sync failed, apply exponential backoff and retry in "
-          << expBackoff_.getTimeRemainingUntilRetry().count() << " ms";
+void
+LinkMonitor::subscribeNetlinkEvents() {
+  // Initialize interface index to name mapping. Must happen before the
+  // callbacks below are armed - afterwards the map is only touched from
+  // the netlink socket's event thread
+  try {
+    for (auto& link : nlSock_->getAllLinks().get()) {
+      nlIfIndexToName_[link.getIfIndex()] = link.getLinkName();
     }
+  } catch (std::exception const& e) {
+    LOG(ERROR) << "Failed to initialize ifIndex to name mapping. Error: "
+               << folly::exceptionStr(e);
+  }
+
+  // Attach callback for link events
+  nlSock_->setLinkEventCB([this](fbnl::Link link, bool /* ignore */) {
+    // Cache interface index name mapping. Runs in netlink event thread
+    nlIfIndexToName_[link.getIfIndex()] = link.getLinkName();
+    VLOG(3) << "Received Link Event from netlink: " << link.str();
+
+    getEvb()->runInEventBaseThread(
+        [this, link = std::move(link)]() mutable noexcept {
+          auto interfaceEntry = getOrCreateInterfaceEntry(link.getLinkName());
+          if (interfaceEntry) {
+            const bool wasUp = interfaceEntry->isUp();
+            interfaceEntry->updateAttrs(
+                link.getIfIndex(), link.isUp(), Constants::kDefaultAdjWeight);
+            logLinkEvent(
+                interfaceEntry->getIfName(),
+                wasUp,
+                interfaceEntry->isUp(),
+                interfaceEntry->getBackoffDuration());
+          }
+        });
+  });
+
+  // Attach callback for address events
+  nlSock_->setAddrEventCB([this](fbnl::IfAddress addr, bool /* ignore */) {
+    // Resolve interface name. Runs in netlink event thread
+    auto it = nlIfIndexToName_.find(addr.getIfIndex());
+    if (it == nlIfIndexToName_.end()) {
+      LOG(ERROR) << "Address event for unknown interface " << addr.str();
+      return;
+    }
+    if (not addr.getPrefix().has_value()) {
+      LOG(ERROR) << "Address event with empty address " << addr.str();
+      return;
+    }
+    VLOG(3) << "Received Address Event from netlink: " << addr.str();
+
+    getEvb()->runInEventBaseThread([this,
+                                    ifName = it->second,
+                                    network = addr.getPrefix().value(),
+                                    isValid = addr.isValid()]() noexcept {
+      auto interfaceEntry = getOrCreateInterfaceEntry(ifName);
+      if (interfaceEntry) {
+        interfaceEntry->updateAddr(network, isValid);
+      }
+    });
   });
-  // schedule immediate with small timeout
-  interfaceDbSyncTimer_->scheduleTimeout(std::chrono::milliseconds(100));
 }
 
 void
@@ -420,8 +566,8 @@ LinkMonitor::neighborUpEvent(const thrift::SparkNeighborEvent& event) {
   // be overridden by KvStoreClientInternal, thus no need to explicitly remove
   // it 2) does not change: the existing connection to a neighbor is retained
   thrift::PeerSpec peerSpec;
-  peerSpec.cmdUrl = repUrl;
-  peerSpec.peerAddr = peerAddr;
+  peerSpec.cmdUrl = std::move(repUrl);
+  peerSpec.peerAddr = std::move(peerAddr);
   peerSpec.ctrlPort = openrCtrlThriftPort;
   peerSpec.supportFloodOptimization = event.supportFloodOptimization;
   adjacencies_[adjId] =
@@ -523,13 +669,11 @@ LinkMonitor::getPeersFromAdjacencies(
   return peers;
 }
 
-void
-LinkMonitor::advertiseKvStorePeers(
+std::optional<thrift::AreaPeerUpdate>
+LinkMonitor::buildKvStorePeerUpdate(
     const std::string& area,
     const std::unordered_map<std::string, thrift::PeerSpec>& upPeers) {
-  // Prepare peer update request
-  thrift::PeerUpdateRequest req;
-  req.area = area;
+  thrift::AreaPeerUpdate update;
 
   // Get old and new peer list. Also update local state
   const auto oldPeers = std::move(peers_[area]);
@@ -550,7 +694,7 @@ LinkMonitor::advertiseKvStorePeers(
   if (toDelPeers.size() > 0) {
     thrift::PeerDelParams params;
     params.peerNames = std::move(toDelPeers);
-    req.peerDelParams_ref() = std::move(params);
+    update.peerDelParams_ref() = std::move(params);
   }
 
   // Get list of peers to add
@@ -588,22 +732,58 @@ LinkMonitor::advertiseKvStorePeers(
   if (toAddPeers.size() > 0) {
     thrift::PeerAddParams params;
     params.peers = std::move(toAddPeers);
-    req.peerAddParams_ref() = std::move(params);
+    update.peerAddParams_ref() = std::move(params);
   }
 
-  if (req.peerDelParams_ref().has_value() ||
-      req.peerAddParams_ref().has_value()) {
-    peerUpdatesQueue_.push(std::move(req));
+  if (update.peerDelParams_ref().has_value() ||
+      update.peerAddParams_ref().has_value()) {
+    return update;
   }
+  return std::nullopt;
 }
 
 void
 LinkMonitor::advertiseKvStorePeers(
+    const std::string& area,
     const std::unordered_map<std::string, thrift::PeerSpec>& upPeers) {
-  // Get old and new peer list. Also update local state
+  auto update = buildKvStorePeerUpdate(area, upPeers);
+  if (not update.has_value()) {
+    return;
+  }
+
+  // Prepare peer update request
+  thrift::PeerUpdateRequest req;
+  req.area = area;
+  if (update.value().peerAddParams_ref().has_value()) {
+    req.peerAddParams_ref() =
+        std::move(update.value().peerAddParams_ref().value());
+  }
+  if (update.value().peerDelParams_ref().has_value()) {
+    req.peerDelParams_ref() =
+        std::move(update.value().peerDelParams_ref().value());
+  }
+  peerUpdatesQueue_.push(std::move(req));
+}
+
+void
+LinkMonitor::advertiseKvStorePeers(
+    const std::unordered_map<std::string, thrift::PeerSpec>& upPeers) {
+  // Batch peer changes of all areas into a single request so KvStore
+  // applies them in one pass instead of being poked once per area
+  std::map<std::string, thrift::AreaPeerUpdate> areaUpdates;
   for (const auto& area : areas_) {
-    advertiseKvStorePeers(area, upPeers);
+    auto update = buildKvStorePeerUpdate(area, upPeers);
+    if (update.has_value()) {
+      areaUpdates.emplace(area, std::move(update).value());
+    }
   }
+
+  if (areaUpdates.empty()) {
+    return;
+  }
+  thrift::PeerUpdateRequest req;
+  req.areaUpdates_ref() = std::move(areaUpdates);
+  peerUpdatesQueue_.push(std::move(req));
 }
 
 void
@@ -616,6 +796,7 @@ LinkMonitor::advertiseAdjacencies(const std::string& area) {
   adjDb.isOverloaded = state_.isOverloaded;
   adjDb.nodeLabel = enableSegmentRouting_ ? state_.nodeLabel : 0;
   adjDb.area_ref() = area;
+  adjDb.adjacencies.reserve(adjacencies_.size());
   for (const auto& adjKv : adjacencies_) {
     // 'second.second' is the adj object for this peer
     // must match the area
@@ -642,6 +823,27 @@ LinkMonitor::advertiseAdjacencies(const std::string& area) {
     adjDb.adjacencies.emplace_back(std::move(adj));
   }
 
+  // Config is most likely to have changed. Update it in `ConfigStore`
+  configStore_->storeThriftObj(kConfigKey, state_); // not awaiting on result
+
+  // Cancel throttle timeout if scheduled
+  if (advertiseAdjacenciesThrottled_->isActive()) {
+    advertiseAdjacenciesThrottled_->cancel();
+  }
+
+  // Skip the fabric-wide re-flood when the database content is unchanged.
+  // The comparison happens before perf events are attached - their
+  // timestamps differ on every build and would otherwise defeat the
+  // value-level dedup in persistKey(), turning every no-op neighbor event
+  // into a full re-flood of all adjacencies
+  auto advIt = advertisedAdjDbs_.find(area);
+  if (advIt != advertisedAdjDbs_.end() and advIt->second == adjDb) {
+    VLOG(1) << "Adjacency database for area: " << area
+            << " is unchanged. Skipping advertisement.";
+    return;
+  }
+  advertisedAdjDbs_[area] = adjDb;
+
   // Add perf information if enabled
   if (enablePerfMeasurement_) {
     thrift::PerfEvents perfEvents;
@@ -653,20 +855,20 @@ LinkMonitor::advertiseAdjacencies(const std::string& area) {
 
   LOG(INFO) << "Updating adjacency database in KvStore with "
             << adjDb.adjacencies.size() << " entries in area: " << area;
-  const auto keyName = Constants::kAdjDbMarker.toString() + nodeId_;
+
+  // the compact encoding is applied on the outgoing copy only, after the
+  // value-level dedup above compared the expanded forms
+  if (enableCompactAdjDb_) {
+    compactAdjacencyDb(adjDb);
+  }
+
+  std::string keyName;
+  composeNodeKey(keyName, Constants::kAdjDbMarker, nodeId_);
   std::string adjDbStr = fbzmq::util::writeThriftObjStr(adjDb, serializer_);
   kvStoreClient_->persistKey(keyName, adjDbStr, ttlKeyInKvStore_, area);
   fb303::fbData->addStatValue(
       "link_monitor.advertise_adjacencies", 1, fb303::SUM);
 
-  // Config is most likely to have changed. Update it in `ConfigStore`
-  configStore_->storeThriftObj(kConfigKey, state_); // not awaiting on result
-
-  // Cancel throttle timeout if scheduled
-  if (advertiseAdjacenciesThrottled_->isActive()) {
-    advertiseAdjacenciesThrottled_->cancel();
-  }
-
   // Update some flat counters
   fb303::fbData->setCounter("link_monitor.adjacencies", adjacencies_.size());
   for (const auto& kv : adjacencies_) {
@@ -687,6 +889,21 @@ LinkMonitor::advertiseAdjacencies() {
 
 void
 LinkMonitor::advertiseIfaceAddr() {
+  // coalesce: if we advertised just now, let further events accumulate and
+  // go out as one net update when the window closes. The timer stays armed
+  // so no wakeup is lost
+  const auto now = std::chrono::steady_clock::now();
+  const auto sinceLastAdvertise =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          now - lastIfaceAdvertiseTime_);
+  if (sinceLastAdvertise < Constants::kLinkCoalesceTimeout) {
+    advertiseIfaceAddrTimer_->scheduleTimeout(
+        Constants::kLinkCoalesceTimeout - sinceLastAdvertise);
+    VLOG(2) << "advertiseIfaceAddr deferred into coalescing window";
+    return;
+  }
+  lastIfaceAdvertiseTime_ = now;
+
   auto retryTime = getRetryTimeOnUnstableInterfaces();
 
   advertiseInterfaces();
@@ -710,6 +927,10 @@ void
 LinkMonitor::advertiseInterfaces() {
   fb303::fbData->addStatValue("link_monitor.advertise_links", 1, fb303::SUM);
 
+  // Snapshot regexes once per advertisement; config may swap them at runtime
+  const auto includeItfRegexes = config_->getIncludeItfRegexes();
+  const auto excludeItfRegexes = config_->getExcludeItfRegexes();
+
   // Create interface database
   thrift::InterfaceDatabase ifDb;
   ifDb.thisNodeName = nodeId_;
@@ -718,7 +939,7 @@ LinkMonitor::advertiseInterfaces() {
     auto& interface = kv.second;
     // Perform regex match
     if (not checkIncludeExcludeRegex(
-            ifName, includeItfRegexes_, excludeItfRegexes_)) {
+            ifName, includeItfRegexes, excludeItfRegexes)) {
       continue;
     }
     // Get interface info and override active status
@@ -751,6 +972,7 @@ LinkMonitor::advertiseRedistAddrs() {
   }
 
   // Add redistribute addresses
+  const auto redistributeItfRegexes = config_->getRedistributeItfRegexes();
   for (auto& kv : interfaces_) {
     auto& interface = kv.second;
     // Ignore in-active interfaces
@@ -758,7 +980,7 @@ LinkMonitor::advertiseRedistAddrs() {
       continue;
     }
     // Perform regex match
-    if (not matchRegexSet(interface.getIfName(), redistributeItfRegexes_)) {
+    if (not matchRegexSet(interface.getIfName(), redistributeItfRegexes)) {
       continue;
     }
     // Add all prefixes of this interface
@@ -769,6 +991,15 @@ LinkMonitor::advertiseRedistAddrs() {
     }
   }
 
+  // Skip the round if the prefix set is unchanged - no point in churning
+  // the PrefixManager queue with identical sync requests
+  if (advertisedRedistPrefixes_.has_value() and
+      prefixes == advertisedRedistPrefixes_.value()) {
+    VLOG(2) << "Redistribution prefixes are unchanged. Skipping advertisement.";
+    return;
+  }
+  advertisedRedistPrefixes_ = prefixes;
+
   LOG_IF(INFO, prefixes.empty()) << "Advertising empty LOOPBACK addresses.";
   // Advertise via prefix manager client
   thrift::PrefixUpdateRequest request;
@@ -787,6 +1018,11 @@ LinkMonitor::getRetryTimeOnUnstableInterfaces() {
     if (interface.isActive()) {
       continue;
     }
+    // a port that is down has nothing to re-advertise once its backoff
+    // clears; only UP-but-unstable (flapping) ports warrant a retry
+    if (not interface.isUp()) {
+      continue;
+    }
 
     const auto& curRemainMs = interface.getBackoffDuration();
     if (curRemainMs.count() > 0) {
@@ -803,8 +1039,10 @@ InterfaceEntry* FOLLY_NULLABLE
 LinkMonitor::getOrCreateInterfaceEntry(const std::string& ifName) {
   // Return null if ifName doesn't quality regex match criteria
   if (not checkIncludeExcludeRegex(
-          ifName, includeItfRegexes_, excludeItfRegexes_) and
-      not matchRegexSet(ifName, redistributeItfRegexes_)) {
+          ifName,
+          config_->getIncludeItfRegexes(),
+          config_->getExcludeItfRegexes()) and
+      not matchRegexSet(ifName, config_->getRedistributeItfRegexes())) {
     return nullptr;
   }
 
@@ -860,17 +1098,56 @@ LinkMonitor::createNetlinkSystemHandlerClient() {
       std::make_unique<thrift::SystemServiceAsyncClient>(std::move(channel));
 }
 
+std::vector<thrift::Link>
+LinkMonitor::getAllLinksFromNetlink() {
+  CHECK(nlSock_);
+
+  // Send requests for links and their addresses in parallel
+  auto nlLinks = nlSock_->getAllLinks();
+  auto nlAddrs = nlSock_->getAllIfAddresses();
+
+  // Create links
+  std::unordered_map<int, thrift::Link> linkMap;
+  for (auto& nlLink : std::move(nlLinks).get()) {
+    thrift::Link link;
+    link.ifName = nlLink.getLinkName();
+    link.ifIndex = nlLink.getIfIndex();
+    link.isUp = nlLink.isUp();
+    linkMap.emplace(nlLink.getIfIndex(), std::move(link));
+  }
+
+  // Add addresses
+  for (auto& nlAddr : std::move(nlAddrs).get()) {
+    auto it = linkMap.find(nlAddr.getIfIndex());
+    if (it != linkMap.end() and nlAddr.getPrefix().has_value()) {
+      it->second.networks.emplace_back(toIpPrefix(nlAddr.getPrefix().value()));
+    }
+  }
+
+  // Convert to list and return
+  std::vector<thrift::Link> links;
+  for (auto& kv : linkMap) {
+    links.emplace_back(std::move(kv.second));
+  }
+  return links;
+}
+
 bool
 LinkMonitor::syncInterfaces() {
   VLOG(1) << "Syncing Interface DB from Netlink Platform";
 
   //
-  // Retrieve latest link snapshot from SystemService
+  // Retrieve latest link snapshot from SystemService, or straight from the
+  // netlink socket in direct mode
   //
   std::vector<thrift::Link> links;
   try {
-    createNetlinkSystemHandlerClient();
-    client_->sync_getAllLinks(links);
+    if (nlSock_) {
+      links = getAllLinksFromNetlink();
+    } else {
+      createNetlinkSystemHandlerClient();
+      client_->sync_getAllLinks(links);
+    }
   } catch (const std::exception& e) {
     client_.reset();
     LOG(ERROR) << "Failed to sync LinkDb from NetlinkSystemHandler. Error: "
@@ -1243,7 +1520,7 @@ LinkMonitor::logNeighborEvent(thrift::SparkNeighborEvent const& event) {
   sample.addString("area", event.area);
   sample.addInt("rtt_us", event.rttUs);
 
-  zmqMonitorClient_->addEventLog(fbzmq::thrift::EventLog(
+  eventLogger_->log(fbzmq::thrift::EventLog(
       apache::thrift::FRAGILE,
       Constants::kEventLogCategory.toString(),
       {sample.toJson()}));
@@ -1268,7 +1545,7 @@ LinkMonitor::logLinkEvent(
   sample.addString("interface", iface);
   sample.addInt("backoff_ms", backoffTime.count());
 
-  zmqMonitorClient_->addEventLog(fbzmq::thrift::EventLog(
+  eventLogger_->log(fbzmq::thrift::EventLog(
       apache::thrift::FRAGILE,
       Constants::kEventLogCategory.toString(),
       {sample.toJson()}));
@@ -1289,7 +1566,7 @@ LinkMonitor::logPeerEvent(
   sample.addString("peer_name", peerName);
   sample.addString("cmd_url", peerSpec.cmdUrl);
 
-  zmqMonitorClient_->addEventLog(fbzmq::thrift::EventLog(
+  eventLogger_->log(fbzmq::thrift::EventLog(
       apache::thrift::FRAGILE,
       Constants::kEventLogCategory.toString(),
       {sample.toJson()}));
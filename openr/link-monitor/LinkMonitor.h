@@ -11,6 +11,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <boost/serialization/strong_typedef.hpp>
 #include <fbzmq/async/ZmqThrottle.h>
@@ -30,7 +31,9 @@
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 
 #include <openr/allocators/RangeAllocator.h>
+#include <openr/common/EventLogger.h>
 #include <openr/common/OpenrEventBase.h>
+#include <openr/common/ReplayLog.h>
 #include <openr/config-store/PersistentStore.h>
 #include <openr/if/gen-cpp2/Fib_types.h>
 #include <openr/if/gen-cpp2/KvStore_types.h>
@@ -42,6 +45,7 @@
 #include <openr/kvstore/KvStoreClientInternal.h>
 #include <openr/link-monitor/InterfaceEntry.h>
 #include <openr/messaging/ReplicateQueue.h>
+#include <openr/nl/NetlinkProtocolSocket.h>
 #include <openr/spark/Spark.h>
 
 namespace openr {
@@ -60,12 +64,25 @@ struct AdjacencyValue {
       thrift::Adjacency adj,
       bool restarting = false,
       std::string areaId = openr::thrift::KvStore_constants::kDefaultArea())
-      : peerSpec(spec),
-        adjacency(adj),
+      : peerSpec(std::move(spec)),
+        adjacency(std::move(adj)),
         isRestarting(restarting),
-        area(areaId) {}
+        area(std::move(areaId)) {}
 };
 
+/**
+ * Reorder and compact a drained batch of Spark neighbor events before
+ * processing:
+ *  - neighbors with a DOWN/RESTARTING event in the batch have their whole
+ *    event subsequence moved ahead of other neighbors' events, so failure
+ *    handling never queues behind informational chatter;
+ *  - RTT_CHANGE events superseded by a newer measurement for the same
+ *    adjacency are dropped (only the latest RTT matters).
+ * The relative order of events for any single adjacency is preserved.
+ */
+std::vector<thrift::SparkNeighborEvent> prioritizeNeighborEvents(
+    std::vector<thrift::SparkNeighborEvent> events);
+
 //
 // This class is responsible for reacting to neighbor
 // up and down events. The reaction constitutes of starting
@@ -103,7 +120,11 @@ class LinkMonitor final : public OpenrEventBase {
       // URL for platform publisher
       PlatformPublisherUrl const& platformPubUrl,
       // how long to wait before initial adjacency advertisement
-      std::chrono::seconds adjHoldTime);
+      std::chrono::seconds adjHoldTime,
+      // if set, subscribe to link/address events directly on the in-process
+      // netlink socket instead of the platform publisher and sync interfaces
+      // without the thrift system handler hop
+      fbnl::NetlinkProtocolSocket* nlSock = nullptr);
 
   ~LinkMonitor() override = default;
 
@@ -177,6 +198,15 @@ class LinkMonitor final : public OpenrEventBase {
   // client_ is used for periodical full sync
   void prepare() noexcept;
 
+  // Subscribe to link/addr events published by the platform publisher over
+  // nlEventSub_. used by prepare()
+  void subscribePlatformEvents();
+
+  // Subscribe to link/addr events directly on the in-process netlink
+  // socket (nlSock_), bypassing the publisher socket and thrift
+  // serialization on the link event path. used by prepare()
+  void subscribeNetlinkEvents();
+
   // Used for initial interface discovery and periodic sync with system handler
   // return true if sync is successful
   bool syncInterfaces();
@@ -186,6 +216,11 @@ class LinkMonitor final : public OpenrEventBase {
   // port. used by syncInterfaces()
   void createNetlinkSystemHandlerClient();
 
+  // Query links with their addresses straight from the in-process netlink
+  // socket. Direct-netlink counterpart of SystemService::getAllLinks. Can
+  // throw on netlink failures. used by syncInterfaces()
+  std::vector<thrift::Link> getAllLinksFromNetlink();
+
   // Get or create InterfaceEntry object.
   // Returns nullptr if ifName doesn't qualify regex match
   // used in syncInterfaces() and LINK/ADDRESS EVENT
@@ -229,10 +264,18 @@ class LinkMonitor final : public OpenrEventBase {
       const std::string& area,
       const std::unordered_map<std::string, thrift::PeerSpec>& upPeers = {});
 
-  // advertise to all areas
+  // advertise to all areas. peer changes of all areas are batched into a
+  // single request so KvStore applies them in one pass
   void advertiseKvStorePeers(
       const std::unordered_map<std::string, thrift::PeerSpec>& upPeers = {});
 
+  // compute the peer delta for one area and update peers_ accordingly.
+  // returns std::nullopt when there is nothing to add or delete.
+  // used by both advertiseKvStorePeers() flavors
+  std::optional<thrift::AreaPeerUpdate> buildKvStorePeerUpdate(
+      const std::string& area,
+      const std::unordered_map<std::string, thrift::PeerSpec>& upPeers);
+
   // peer events
   void logPeerEvent(
       const std::string& event,
@@ -301,15 +344,16 @@ class LinkMonitor final : public OpenrEventBase {
   thrift::PrefixForwardingAlgorithm prefixForwardingAlgorithm_;
   // Use spark measured RTT to neighbor as link metric
   bool useRttMetric_{false};
+  // advertise adjacency db in its compact wire encoding
+  bool enableCompactAdjDb_{false};
   // link flap back offs
   std::chrono::milliseconds linkflapInitBackoff_;
   std::chrono::milliseconds linkflapMaxBackoff_;
   // TTL for a key in the key value store
   std::chrono::milliseconds ttlKeyInKvStore_;
-  // interface regexes
-  std::shared_ptr<const re2::RE2::Set> includeItfRegexes_;
-  std::shared_ptr<const re2::RE2::Set> excludeItfRegexes_;
-  std::shared_ptr<const re2::RE2::Set> redistributeItfRegexes_;
+  // config object; interface regexes are consulted through it at use time
+  // so that dynamic config updates take effect without a restart
+  std::shared_ptr<const Config> config_;
   // area ids
   std::unordered_set<std::string> areas_{};
 
@@ -336,6 +380,16 @@ class LinkMonitor final : public OpenrEventBase {
   // Used to subscribe to netlink events from PlatformPublisher
   fbzmq::Socket<ZMQ_SUB, fbzmq::ZMQ_CLIENT> nlEventSub_;
 
+  // In-process netlink socket for direct link/address event subscription.
+  // When set the platform publisher subscription above stays unused and
+  // interface sync bypasses the thrift system handler
+  fbnl::NetlinkProtocolSocket* nlSock_{nullptr};
+
+  // interface index to name mapping for resolving direct address events.
+  // only accessed from the netlink socket's event thread (after the initial
+  // fill in prepare(), which happens before callbacks are registered)
+  std::unordered_map<int, std::string> nlIfIndexToName_;
+
   // used for communicating over thrift/zmq sockets
   apache::thrift::CompactSerializer serializer_;
 
@@ -345,6 +399,16 @@ class LinkMonitor final : public OpenrEventBase {
   // (we use the "min" interface) for tcp connection
   std::unordered_map<AdjacencyKey, AdjacencyValue> adjacencies_;
 
+  // last adjacency database advertised into KvStore per area, without
+  // perf-events. used to suppress no-op re-advertisements
+  std::unordered_map<std::string /* area */, thrift::AdjacencyDatabase>
+      advertisedAdjDbs_;
+
+  // last redistribution prefix set advertised towards PrefixManager. used
+  // to suppress no-op sync requests. std::nullopt until the first
+  // advertisement so the initial (possibly empty) sync always goes out
+  std::optional<std::vector<thrift::PrefixEntry>> advertisedRedistPrefixes_;
+
   // Previously announced KvStore peers
   std::unordered_map<
       std::string /* area */,
@@ -363,6 +427,11 @@ class LinkMonitor final : public OpenrEventBase {
   // Timer for processing interfaces which are in backoff states
   std::unique_ptr<fbzmq::ZmqTimeout> advertiseIfaceAddrTimer_;
 
+  // When the last interface advertisement went out. Requests landing
+  // within kLinkCoalesceTimeout of it are accumulated and emitted as one
+  // net update when the window closes
+  std::chrono::steady_clock::time_point lastIfaceAdvertiseTime_{};
+
   // Timer for resyncing InterfaceDb from netlink
   std::unique_ptr<fbzmq::ZmqTimeout> interfaceDbSyncTimer_;
   ExponentialBackoff<std::chrono::milliseconds> expBackoff_;
@@ -380,8 +449,13 @@ class LinkMonitor final : public OpenrEventBase {
   std::unordered_map<std::string /* area */, RangeAllocator<int32_t>>
       rangeAllocator_;
 
-  // client to interact with ZmqMonitor
-  std::unique_ptr<fbzmq::ZmqMonitorClient> zmqMonitorClient_;
+  // async event-log submitter towards ZmqMonitor; logging on the
+  // link-monitor thread costs a single bounded enqueue
+  std::unique_ptr<EventLogger> eventLogger_;
+
+  // capture of incoming platform events for offline replay, only set
+  // when event_capture_dir is configured
+  std::unique_ptr<ReplayLogWriter> replayLogWriter_{nullptr};
 
   // client to interact with ConfigStore
   PersistentStore* configStore_{nullptr};
@@ -1903,6 +1903,49 @@ TEST(LinkMonitor, getPeersFromAdjacencies) {
       1, LinkMonitor::getPeersFromAdjacencies(adjacencies, "plane").size());
 }
 
+TEST(LinkMonitor, PrioritizeNeighborEvents) {
+  const auto up2 = createNeighborEvent(
+      thrift::SparkNeighborEventType::NEIGHBOR_UP, "iface_2_1", nb2, 100, 1);
+  const auto rtt2a = createNeighborEvent(
+      thrift::SparkNeighborEventType::NEIGHBOR_RTT_CHANGE,
+      "iface_2_1",
+      nb2,
+      200,
+      1);
+  const auto rtt2b = createNeighborEvent(
+      thrift::SparkNeighborEventType::NEIGHBOR_RTT_CHANGE,
+      "iface_2_1",
+      nb2,
+      300,
+      1);
+  const auto up3 = createNeighborEvent(
+      thrift::SparkNeighborEventType::NEIGHBOR_UP, "iface_3_1", nb3, 100, 2);
+  const auto down3 = createNeighborEvent(
+      thrift::SparkNeighborEventType::NEIGHBOR_DOWN, "iface_3_1", nb3, 100, 2);
+
+  // batches without urgent events or stale RTT changes pass through as-is
+  {
+    auto events = prioritizeNeighborEvents({up2, rtt2a, up3});
+    std::vector<thrift::SparkNeighborEvent> expected{up2, rtt2a, up3};
+    EXPECT_EQ(expected, events);
+  }
+
+  // node-3's DOWN bypasses node-2's RTT chatter; superseded RTT dropped
+  {
+    auto events = prioritizeNeighborEvents({rtt2a, rtt2b, down3});
+    std::vector<thrift::SparkNeighborEvent> expected{down3, rtt2b};
+    EXPECT_EQ(expected, events);
+  }
+
+  // events for an urgent neighbor keep their own relative order: the DOWN
+  // must not be processed ahead of the preceding UP for the same neighbor
+  {
+    auto events = prioritizeNeighborEvents({rtt2a, up3, down3});
+    std::vector<thrift::SparkNeighborEvent> expected{up3, down3, rtt2a};
+    EXPECT_EQ(expected, events);
+  }
+}
+
 TEST_F(LinkMonitorTestFixture, AreaTest) {
   SetUp({openr::thrift::KvStore_constants::kDefaultArea(), "pod", "plane"});
 
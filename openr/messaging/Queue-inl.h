@@ -16,29 +16,113 @@ RQueue<ValueType>::RQueue(std::shared_ptr<RWQueue<ValueType>> queue)
   assert(queue_);
 }
 
+template <typename ValueType>
+RQueue<ValueType>::RQueue(
+    std::shared_ptr<RWQueue<std::shared_ptr<const ValueType>>> queue)
+    : sharedQueue_(std::move(queue)) {
+  assert(sharedQueue_);
+}
+
+template <typename ValueType>
+ValueType
+RQueue<ValueType>::detachSharedElement(
+    std::shared_ptr<const ValueType>&& val) {
+  if (val.use_count() == 1) {
+    // We're the sole owner - steal the instance instead of copying. The
+    // const_cast is safe as elements are created mutable by the writer
+    return std::move(const_cast<ValueType&>(*val));
+  }
+  return *val; // Copy shared instance
+}
+
 template <typename ValueType>
 folly::Expected<ValueType, QueueError>
 RQueue<ValueType>::get() {
-  return queue_->get();
+  if (queue_) {
+    return queue_->get();
+  }
+  auto maybeVal = sharedQueue_->get();
+  if (maybeVal.hasError()) {
+    return folly::makeUnexpected(maybeVal.error());
+  }
+  return detachSharedElement(std::move(maybeVal).value());
+}
+
+template <typename ValueType>
+folly::Expected<std::vector<ValueType>, QueueError>
+RQueue<ValueType>::getAll() {
+  if (queue_) {
+    return queue_->getAll();
+  }
+  auto maybeVals = sharedQueue_->getAll();
+  if (maybeVals.hasError()) {
+    return folly::makeUnexpected(maybeVals.error());
+  }
+  std::vector<ValueType> vals;
+  vals.reserve(maybeVals->size());
+  for (auto& val : maybeVals.value()) {
+    vals.emplace_back(detachSharedElement(std::move(val)));
+  }
+  return vals;
 }
 
 #if FOLLY_HAS_COROUTINES
 template <typename ValueType>
 folly::coro::Task<folly::Expected<ValueType, QueueError>>
 RQueue<ValueType>::getCoro() {
-  auto val = co_await queue_->getCoro();
-  co_return val;
+  if (queue_) {
+    auto val = co_await queue_->getCoro();
+    co_return val;
+  }
+  auto maybeVal = co_await sharedQueue_->getCoro();
+  if (maybeVal.hasError()) {
+    co_return folly::makeUnexpected(maybeVal.error());
+  }
+  co_return detachSharedElement(std::move(maybeVal).value());
+}
+
+template <typename ValueType>
+folly::coro::Task<folly::Expected<std::vector<ValueType>, QueueError>>
+RQueue<ValueType>::getAllCoro() {
+  if (queue_) {
+    auto vals = co_await queue_->getAllCoro();
+    co_return vals;
+  }
+  auto maybeVals = co_await sharedQueue_->getAllCoro();
+  if (maybeVals.hasError()) {
+    co_return folly::makeUnexpected(maybeVals.error());
+  }
+  std::vector<ValueType> vals;
+  vals.reserve(maybeVals->size());
+  for (auto& val : maybeVals.value()) {
+    vals.emplace_back(detachSharedElement(std::move(val)));
+  }
+  co_return vals;
 }
 #endif
 
 template <typename ValueType>
 size_t
 RQueue<ValueType>::size() {
-  return queue_->size();
+  return queue_ ? queue_->size() : sharedQueue_->size();
 }
 
 template <typename ValueType>
-RWQueue<ValueType>::RWQueue() {}
+RWQueue<ValueType>::RWQueue(std::string name)
+    : name_(std::move(name)), instrumented_(not name_.empty()) {}
+
+template <typename ValueType>
+RWQueue<ValueType>::RWQueue(
+    size_t capacity, QueueFullPolicy policy, size_t lowWatermark,
+    std::string name)
+    : name_(std::move(name)),
+      instrumented_(not name_.empty()),
+      capacity_(capacity),
+      fullPolicy_(policy),
+      lowWatermark_(lowWatermark ? lowWatermark : capacity / 2) {
+  assert(capacity_ > 0);
+  assert(lowWatermark_ < capacity_);
+}
 
 template <typename ValueType>
 RWQueue<ValueType>::~RWQueue() {
@@ -49,22 +133,65 @@ template <typename ValueType>
 template <typename ValueTypeT>
 bool
 RWQueue<ValueType>::push(ValueTypeT&& val) {
-  std::lock_guard<std::mutex> l(lock_);
-
   // If queue is closed, don't enqueue
-  if (closed_) {
+  if (closed_.load(std::memory_order_acquire)) {
     return false;
   }
 
-  if (pendingReads_.size()) {
-    // Unblock a pending read
-    auto& pendingRead = pendingReads_.front().get();
-    pendingRead.data = std::forward<ValueTypeT>(val);
-    pendingRead.baton.post();
-    pendingReads_.pop_front();
-  } else {
-    // Add data into the queue
-    queue_.emplace_back(std::forward<ValueTypeT>(val));
+  // Enforce capacity for bounded queue
+  if (capacity_) {
+    if (fullPolicy_ == QueueFullPolicy::LOSSY) {
+      if (suppressed_.load(std::memory_order_relaxed)) {
+        if (queue_.size() > lowWatermark_) {
+          // Keep dropping until queue drains to its low watermark
+          droppedCount_.fetch_add(1, std::memory_order_relaxed);
+          if (instrumented_) {
+            facebook::fb303::fbData->addStatValue(
+                "messaging.queue." + name_ + ".drops",
+                1,
+                facebook::fb303::SUM);
+          }
+          return false;
+        }
+        suppressed_.store(false, std::memory_order_relaxed);
+      } else if (queue_.size() >= capacity_) {
+        suppressed_.store(true, std::memory_order_relaxed);
+        droppedCount_.fetch_add(1, std::memory_order_relaxed);
+        if (instrumented_) {
+          facebook::fb303::fbData->addStatValue(
+              "messaging.queue." + name_ + ".drops", 1, facebook::fb303::SUM);
+        }
+        return false;
+      }
+    } else if (not waitForCapacity()) {
+      return false; // Queue got closed while waiting
+    }
+  }
+
+  // Lock-free fast path - add data into the queue
+  queue_.enqueue(std::forward<ValueTypeT>(val));
+  if (instrumented_) {
+    recordEnqueueSample();
+  }
+
+  // Pairs with the fence in getAnyImpl(). Either we observe the waiting
+  // reader and unblock it below, or the reader observes our enqueue before
+  // parking itself. Both can't miss each other (store-buffering pattern)
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  if (pendingReadCount_.load(std::memory_order_relaxed)) {
+    // Unblock pending reads
+    std::lock_guard<std::mutex> l(lock_);
+    serveWaitingReadsLocked();
+  }
+
+  if (closed_.load(std::memory_order_acquire)) {
+    // Queue got closed while we were enqueuing and close() may have missed
+    // our element. Honor close semantics - discard pending data
+    std::lock_guard<std::mutex> l(lock_);
+    while (queue_.try_dequeue()) {
+    }
+    return false;
   }
 
   return true;
@@ -95,6 +222,28 @@ RWQueue<ValueType>::get() {
   return folly::makeUnexpected(QueueError::QUEUE_CLOSED);
 }
 
+template <typename ValueType>
+folly::Expected<std::vector<ValueType>, QueueError>
+RWQueue<ValueType>::getAll() {
+  // Block for the first element
+  auto first = get();
+  if (first.hasError()) {
+    return folly::makeUnexpected(first.error());
+  }
+
+  // Drain everything else pending, without further blocking
+  std::vector<ValueType> vals;
+  vals.emplace_back(std::move(first).value());
+  while (auto data = queue_.try_dequeue()) {
+    vals.emplace_back(std::move(*data));
+    if (instrumented_) {
+      recordDequeueSample();
+    }
+  }
+  maybeUnblockWriters();
+  return vals;
+}
+
 #if FOLLY_HAS_COROUTINES
 template <typename ValueType>
 folly::coro::Task<folly::Expected<ValueType, QueueError>>
@@ -118,68 +267,263 @@ RWQueue<ValueType>::getCoro() {
   }
   co_return folly::makeUnexpected(QueueError::QUEUE_CLOSED);
 }
+
+template <typename ValueType>
+folly::coro::Task<folly::Expected<std::vector<ValueType>, QueueError>>
+RWQueue<ValueType>::getAllCoro() {
+  // Suspend for the first element
+  auto first = co_await getCoro();
+  if (first.hasError()) {
+    co_return folly::makeUnexpected(first.error());
+  }
+
+  // Drain everything else pending, without further suspension
+  std::vector<ValueType> vals;
+  vals.emplace_back(std::move(first).value());
+  while (auto data = queue_.try_dequeue()) {
+    vals.emplace_back(std::move(*data));
+    if (instrumented_) {
+      recordDequeueSample();
+    }
+  }
+  maybeUnblockWriters();
+  co_return vals;
+}
 #endif
 
 template <typename ValueType>
 bool
 RWQueue<ValueType>::getAnyImpl(PendingRead& pendingRead) {
-  std::lock_guard<std::mutex> l(lock_);
-
   // If queue is closed, return immediately
-  if (closed_) {
+  if (closed_.load(std::memory_order_acquire)) {
     return false;
   }
 
-  // Perform immediate read if data is available
-  if (queue_.size()) {
-    pendingRead.data = std::move(queue_.front());
-    queue_.pop_front();
+  // Lock-free fast path - perform immediate read if data is available
+  if (auto data = queue_.try_dequeue()) {
+    pendingRead.data = std::move(*data);
+    if (instrumented_) {
+      recordDequeueSample();
+    }
+    maybeUnblockWriters();
     return true;
   }
 
   // Else enqueue read request
+  std::lock_guard<std::mutex> l(lock_);
+  if (closed_.load(std::memory_order_acquire)) {
+    return false;
+  }
   pendingReads_.emplace_back(pendingRead);
+  pendingReadCount_.store(pendingReads_.size(), std::memory_order_relaxed);
+
+  // Pairs with the fence in push(). Re-check for data enqueued while we were
+  // registering ourselves, so a concurrent push that missed our registration
+  // can't leave us parked on a non-empty queue
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  serveWaitingReadsLocked();
   return true;
 }
 
+template <typename ValueType>
+void
+RWQueue<ValueType>::serveWaitingReadsLocked() {
+  while (pendingReads_.size()) {
+    auto data = queue_.try_dequeue();
+    if (not data) {
+      break;
+    }
+    // Unblock a pending read
+    auto& pendingRead = pendingReads_.front().get();
+    pendingRead.data = std::move(*data);
+    pendingRead.baton.post();
+    pendingReads_.pop_front();
+    if (instrumented_) {
+      recordDequeueSample();
+    }
+  }
+  pendingReadCount_.store(pendingReads_.size(), std::memory_order_relaxed);
+
+  // Unblock producers waiting for capacity (lock is already held)
+  if (pendingWriteCount_.load(std::memory_order_relaxed) and
+      queue_.size() <= lowWatermark_) {
+    while (pendingWrites_.size()) {
+      pendingWrites_.front().get().post();
+      pendingWrites_.pop_front();
+    }
+    pendingWriteCount_.store(0, std::memory_order_relaxed);
+  }
+}
+
+template <typename ValueType>
+bool
+RWQueue<ValueType>::waitForCapacity() {
+  while (true) {
+    if (closed_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    if (queue_.size() < capacity_) {
+      return true;
+    }
+
+    // Register ourselves for a wakeup once the queue drains
+    folly::fibers::Baton baton;
+    {
+      std::lock_guard<std::mutex> l(lock_);
+      pendingWrites_.emplace_back(baton);
+      pendingWriteCount_.store(
+          pendingWrites_.size(), std::memory_order_relaxed);
+    }
+
+    // Pairs with the fence in maybeUnblockWriters(). Either the draining
+    // reader observes our registration, or we observe the drain below and
+    // cancel the wait (store-buffering pattern)
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (queue_.size() < capacity_) {
+      // Queue drained while we were registering - cancel the wait
+      std::lock_guard<std::mutex> l(lock_);
+      for (auto it = pendingWrites_.begin(); it != pendingWrites_.end();
+           ++it) {
+        if (&it->get() == &baton) {
+          pendingWrites_.erase(it);
+          break;
+        }
+      }
+      pendingWriteCount_.store(
+          pendingWrites_.size(), std::memory_order_relaxed);
+      continue;
+    }
+
+    if (instrumented_) {
+      facebook::fb303::fbData->addStatValue(
+          "messaging.queue." + name_ + ".stalls", 1, facebook::fb303::SUM);
+    }
+    baton.wait();
+  }
+}
+
+template <typename ValueType>
+void
+RWQueue<ValueType>::recordEnqueueSample() {
+  const auto seq = enqueueCount_.fetch_add(1, std::memory_order_relaxed) + 1;
+  if (seq % kQueueSampleInterval != 0) {
+    return;
+  }
+
+  // Sampled occupancy and its high-water mark
+  const auto sz = queue_.size();
+  facebook::fb303::fbData->addStatValue(
+      "messaging.queue." + name_ + ".size", sz, facebook::fb303::AVG);
+  if (sz > sizeHighWatermark_.load(std::memory_order_relaxed)) {
+    sizeHighWatermark_.store(sz, std::memory_order_relaxed);
+    facebook::fb303::fbData->setCounter(
+        "messaging.queue." + name_ + ".size.hwm", sz);
+  }
+
+  // Plant a latency marker if none is in flight. The dequeue consuming past
+  // this sequence number harvests the enqueue-to-dequeue latency
+  if (markerSeq_.load(std::memory_order_relaxed) == 0) {
+    const auto nowUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                           std::chrono::steady_clock::now().time_since_epoch())
+                           .count();
+    markerTimeUs_.store(nowUs, std::memory_order_relaxed);
+    markerSeq_.store(seq, std::memory_order_release);
+  }
+}
+
+template <typename ValueType>
+void
+RWQueue<ValueType>::recordDequeueSample() {
+  const auto seq = dequeueCount_.fetch_add(1, std::memory_order_relaxed) + 1;
+  auto marker = markerSeq_.load(std::memory_order_acquire);
+  if (marker == 0 or seq < marker) {
+    return;
+  }
+  if (markerSeq_.compare_exchange_strong(
+          marker, 0, std::memory_order_acq_rel)) {
+    const auto nowUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                           std::chrono::steady_clock::now().time_since_epoch())
+                           .count();
+    facebook::fb303::fbData->addStatValue(
+        "messaging.queue." + name_ + ".latency_us",
+        nowUs - markerTimeUs_.load(std::memory_order_relaxed),
+        facebook::fb303::AVG);
+  }
+}
+
+template <typename ValueType>
+void
+RWQueue<ValueType>::maybeUnblockWriters() {
+  if (not capacity_ or fullPolicy_ != QueueFullPolicy::BLOCKING) {
+    return;
+  }
+
+  // Pairs with the fence in waitForCapacity()
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (not pendingWriteCount_.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> l(lock_);
+  if (queue_.size() > lowWatermark_) {
+    return; // Not drained enough yet
+  }
+  while (pendingWrites_.size()) {
+    pendingWrites_.front().get().post();
+    pendingWrites_.pop_front();
+  }
+  pendingWriteCount_.store(0, std::memory_order_relaxed);
+}
+
 template <typename ValueType>
 void
 RWQueue<ValueType>::close() {
   std::lock_guard<std::mutex> l(lock_);
 
-  if (not closed_) {
-    closed_ = true;
-    // Either one of these must be zero
-    assert(pendingReads_.size() == 0 || queue_.size() == 0);
+  if (not closed_.exchange(true)) {
     // Set empy value to all pending reads
     while (pendingReads_.size()) {
       auto& pendingRead = pendingReads_.front().get();
       pendingRead.baton.post();
       pendingReads_.pop_front();
     }
-    queue_.clear();
+    pendingReadCount_.store(0, std::memory_order_relaxed);
+    // Unblock all producers waiting for capacity - they will observe the
+    // closed queue and fail their push
+    while (pendingWrites_.size()) {
+      pendingWrites_.front().get().post();
+      pendingWrites_.pop_front();
+    }
+    pendingWriteCount_.store(0, std::memory_order_relaxed);
+    // Drop pending data
+    while (queue_.try_dequeue()) {
+    }
   }
 }
 
 template <typename ValueType>
 bool
 RWQueue<ValueType>::isClosed() {
-  std::lock_guard<std::mutex> l(lock_);
-  return closed_;
+  return closed_.load(std::memory_order_acquire);
 }
 
 template <typename ValueType>
 size_t
 RWQueue<ValueType>::size() {
-  std::lock_guard<std::mutex> l(lock_);
   return queue_.size();
 }
 
 template <typename ValueType>
 size_t
 RWQueue<ValueType>::numPendingReads() {
-  std::lock_guard<std::mutex> l(lock_);
-  return pendingReads_.size();
+  return pendingReadCount_.load(std::memory_order_relaxed);
+}
+
+template <typename ValueType>
+size_t
+RWQueue<ValueType>::getNumDrops() {
+  return droppedCount_.load(std::memory_order_relaxed);
 }
 
 } // namespace messaging
@@ -8,12 +8,18 @@
 #pragma once
 
 #include <any>
+#include <atomic>
+#include <chrono>
 #include <deque>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <utility>
+#include <vector>
 
+#include <fb303/ServiceData.h>
 #include <folly/Expected.h>
+#include <folly/concurrency/UnboundedQueue.h>
 #include <folly/fibers/Baton.h>
 #if FOLLY_HAS_COROUTINES
 #include <folly/experimental/coro/Task.h>
@@ -26,6 +32,23 @@ enum class QueueError {
   QUEUE_CLOSED,
 };
 
+/**
+ * Behavior of a bounded queue when it is filled up to capacity
+ * LOSSY - push() drops the element and returns false. Pushes keep getting
+ *         dropped until the queue drains below its low watermark
+ * BLOCKING - push() blocks (suspends the fiber) until the queue drains
+ *            below its low watermark, applying backpressure on producers
+ */
+enum class QueueFullPolicy {
+  LOSSY,
+  BLOCKING,
+};
+
+// Sampling interval for queue instrumentation. Every Nth enqueue samples
+// occupancy and plants a latency marker, keeping steady-state overhead to a
+// couple of relaxed atomic operations per element
+constexpr uint64_t kQueueSampleInterval{64};
+
 template <typename ValueType>
 class RWQueue;
 
@@ -36,6 +59,16 @@ template <typename ValueType>
 class RQueue {
  public:
   explicit RQueue(std::shared_ptr<RWQueue<ValueType>> queue);
+
+  /**
+   * Reader over a queue of shared elements. Used by ReplicateQueue, which
+   * replicates one element instance across all readers instead of copying.
+   * The element is materialized (copied) on read; the last reader to
+   * dereference an instance steals it instead of copying.
+   */
+  explicit RQueue(
+      std::shared_ptr<RWQueue<std::shared_ptr<const ValueType>>> queue);
+
   virtual ~RQueue() {}
 
   /**
@@ -44,25 +77,44 @@ class RQueue {
    */
   folly::Expected<ValueType, QueueError> get();
 
+  /**
+   * Blocking read of the entire pending backlog. Returns as soon as at least
+   * one element is available, along with everything else enqueued by then.
+   * Saves a wakeup cycle per element when consumers fall behind a burst.
+   */
+  folly::Expected<std::vector<ValueType>, QueueError> getAll();
+
 #if FOLLY_HAS_COROUTINES
   /**
    * Read methods for co-routines
    */
   folly::coro::Task<folly::Expected<ValueType, QueueError>> getCoro();
+  folly::coro::Task<folly::Expected<std::vector<ValueType>, QueueError>>
+  getAllCoro();
 #endif
 
   // Utility function to retrieve size of pending data in underlying queue
   size_t size();
 
  protected:
-  // We only hold reference of above queue
+  /**
+   * Turn a shared element into an owned one - copy, or steal the instance
+   * if we're the last reader holding it
+   */
+  static ValueType detachSharedElement(std::shared_ptr<const ValueType>&& val);
+
+  // We only hold reference of underlying queue. Exactly one of the two
+  // representations below is set
   std::shared_ptr<RWQueue<ValueType>> queue_{nullptr};
+  std::shared_ptr<RWQueue<std::shared_ptr<const ValueType>>> sharedQueue_{
+      nullptr};
 };
 
 /**
- * Multiple writers and readers. We use lock internally to protect the data.
- * Code in critical path is minimal and ensures that readers/writers will never
- * block each other because of lock.
+ * Multiple writers and readers. Data is passed through a lock-free queue -
+ * in steady state (data available on read, no reader waiting on write)
+ * producers and consumers never serialize on a lock. The lock is only taken
+ * to park/unpark waiting readers and on close.
  *
  * This is polymorphic queue which means, you can push any type of object. There
  * are various get (blocking and async) methods to retrieve typed object.
@@ -73,12 +125,33 @@ class RQueue {
 template <typename ValueType>
 class RWQueue {
  public:
-  RWQueue();
+  /**
+   * Queues constructed with a non-empty name export instrumentation into the
+   * fb303 counter tree under `messaging.queue.<name>.*` - enqueue-to-dequeue
+   * latency, sampled occupancy and its high-water mark, producer stalls and
+   * drops. Anonymous queues skip all instrumentation
+   */
+  explicit RWQueue(std::string name = "");
+
+  /**
+   * Bounded queue. Once `capacity` elements are pending, pushes are dropped
+   * or blocked as per the policy until the queue drains to `lowWatermark`
+   * (defaults to half of capacity). Guards against a stalled consumer
+   * growing the queue without bound
+   */
+  RWQueue(
+      size_t capacity,
+      QueueFullPolicy policy,
+      size_t lowWatermark = 0,
+      std::string name = "");
+
   ~RWQueue();
 
   /**
-   * Non blocking push. Any typed value can be pushed!
-   * Return true/false!!
+   * Push into the queue. Any typed value can be pushed!
+   * Non blocking, except for a bounded queue with BLOCKING policy at
+   * capacity. Returns false if the queue is closed or the element got
+   * dropped because of the LOSSY policy
    */
   template <typename ValueTypeT>
   bool push(ValueTypeT&& val);
@@ -89,11 +162,19 @@ class RWQueue {
    */
   folly::Expected<ValueType, QueueError> get();
 
+  /**
+   * Blocking read of the entire pending backlog. Returns as soon as at least
+   * one element is available, along with everything else enqueued by then.
+   */
+  folly::Expected<std::vector<ValueType>, QueueError> getAll();
+
 #if FOLLY_HAS_COROUTINES
   /**
    * Read methods for co-routines
    */
   folly::coro::Task<folly::Expected<ValueType, QueueError>> getCoro();
+  folly::coro::Task<folly::Expected<std::vector<ValueType>, QueueError>>
+  getAllCoro();
 #endif
 
   /**
@@ -112,6 +193,11 @@ class RWQueue {
    */
   size_t numPendingReads();
 
+  /**
+   * Return number of elements dropped because of the LOSSY full policy
+   */
+  size_t getNumDrops();
+
  private:
   struct PendingRead {
     folly::fibers::Baton baton;
@@ -123,17 +209,72 @@ class RWQueue {
    */
   bool getAnyImpl(PendingRead& pendingRead);
 
-  // Lock to protect below private variables
+  /**
+   * Serve waiting readers with data from the lock-free queue, in their order
+   * of arrival. Must be invoked with lock_ held
+   */
+  void serveWaitingReadsLocked();
+
+  /**
+   * For a bounded queue with BLOCKING policy - wait until the queue drains
+   * below its low watermark. Returns false if queue got closed meanwhile
+   */
+  bool waitForCapacity();
+
+  /**
+   * Unblock producers waiting for capacity once the queue has drained to its
+   * low watermark. Invoked by readers after dequeuing data
+   */
+  void maybeUnblockWriters();
+
+  /**
+   * Instrumentation hooks - sample occupancy and plant/harvest the
+   * enqueue-to-dequeue latency marker. No-ops for anonymous queues
+   */
+  void recordEnqueueSample();
+  void recordDequeueSample();
+
+  // Lock to protect pending reads. Not taken on data enqueue/dequeue
   std::mutex lock_;
 
   // State of queue
-  bool closed_{false};
+  std::atomic<bool> closed_{false};
 
-  // Pending reads - readers are actively waiting for data
+  // Pending reads - readers are actively waiting for data. Protected by
+  // lock_. The atomic count mirrors pendingReads_.size() so that push() can
+  // skip the lock when no reader is waiting
   std::deque<std::reference_wrapper<PendingRead>> pendingReads_;
+  std::atomic<size_t> pendingReadCount_{0};
+
+  // Instrumentation state. Sampled occupancy/latency counters are exported
+  // under `messaging.queue.<name>.*`. The latency marker remembers the
+  // sequence number and enqueue time of one in-flight element at a time;
+  // the dequeue that consumes past it harvests the latency sample
+  const std::string name_;
+  const bool instrumented_{false};
+  std::atomic<uint64_t> enqueueCount_{0};
+  std::atomic<uint64_t> dequeueCount_{0};
+  std::atomic<uint64_t> markerSeq_{0};
+  std::atomic<int64_t> markerTimeUs_{0};
+  std::atomic<size_t> sizeHighWatermark_{0};
+
+  // Bounded queue parameters. capacity_ of 0 indicates unbounded queue
+  const size_t capacity_{0};
+  const QueueFullPolicy fullPolicy_{QueueFullPolicy::LOSSY};
+  const size_t lowWatermark_{0};
+
+  // LOSSY full policy - pushes are suppressed from capacity_ down to
+  // lowWatermark_ (hysteresis), with a count of dropped elements
+  std::atomic<bool> suppressed_{false};
+  std::atomic<size_t> droppedCount_{0};
+
+  // BLOCKING full policy - producers waiting for queue to drain. Protected
+  // by lock_, with the atomic count mirroring pendingWrites_.size()
+  std::deque<std::reference_wrapper<folly::fibers::Baton>> pendingWrites_;
+  std::atomic<size_t> pendingWriteCount_{0};
 
-  // Pending data
-  std::deque<ValueType> queue_;
+  // Pending data - lock-free multi-producer/multi-consumer queue
+  folly::UMPMCQueue<ValueType, false /* MayBlock */> queue_;
 };
 
 } // namespace messaging
@@ -11,7 +11,8 @@ namespace openr {
 namespace messaging {
 
 template <typename ValueType>
-ReplicateQueue<ValueType>::ReplicateQueue() {}
+ReplicateQueue<ValueType>::ReplicateQueue(std::string name)
+    : name_(std::move(name)) {}
 
 template <typename ValueType>
 ReplicateQueue<ValueType>::~ReplicateQueue() {
@@ -22,7 +23,7 @@ template <typename ValueType>
 template <typename ValueTypeT>
 bool
 ReplicateQueue<ValueType>::push(ValueTypeT&& value) {
-  std::vector<std::shared_ptr<RWQueue<ValueType>>> readers;
+  std::vector<ReaderEntry> readers;
 
   // Copy reader information - and cleans up stale reader
   {
@@ -31,8 +32,8 @@ ReplicateQueue<ValueType>::push(ValueTypeT&& value) {
       return false;
     }
     for (auto it = lockedReaders->begin(); it != lockedReaders->end();) {
-      if (it->use_count() == 1) {
-        (*it)->close(); // Close before erasing
+      if (it->queue.use_count() == 1) {
+        it->queue->close(); // Close before erasing
         it = lockedReaders->erase(it);
       } else {
         readers.emplace_back(*it); // NOTE: intentionally copying shared_ptr
@@ -41,13 +42,19 @@ ReplicateQueue<ValueType>::push(ValueTypeT&& value) {
     }
   }
 
-  // Replicate messages
+  // Replicate messages - a single shared instance is handed to every reader,
+  // so the cost here is independent of fan-out. Readers copy (or steal) the
+  // instance on read. Filters are evaluated once here on the producer side -
+  // a filtered-out reader sees neither a copy nor a wakeup
   if (readers.size()) {
-    for (size_t i = 0; i < readers.size() - 1; i++) {
-      readers.at(i)->push(ValueType(value)); // Intended copy
+    std::shared_ptr<const ValueType> sharedValue =
+        std::make_shared<ValueType>(std::forward<ValueTypeT>(value));
+    for (auto& reader : readers) {
+      if (reader.filter and not (*reader.filter)(*sharedValue)) {
+        continue;
+      }
+      reader.queue->push(sharedValue); // Intended pointer copy
     }
-    // Perfect forwarding for last reader
-    readers.back()->push(std::forward<ValueTypeT>(value));
   }
 
   return true;
@@ -59,13 +66,35 @@ ReplicateQueue<ValueType>::push(ValueTypeT&& value) {
  */
 template <typename ValueType>
 RQueue<ValueType>
-ReplicateQueue<ValueType>::getReader() {
+ReplicateQueue<ValueType>::getReader(ReplicationFilter filter) {
+  auto lockedReaders = readers_.wlock();
+  if (closed_) {
+    throw std::runtime_error("queue is closed");
+  }
+  lockedReaders->emplace_back(ReaderEntry{
+      std::make_shared<RWQueue<std::shared_ptr<const ValueType>>>(name_),
+      filter ? std::make_shared<const ReplicationFilter>(std::move(filter))
+             : nullptr});
+  return RQueue<ValueType>(lockedReaders->back().queue);
+}
+
+template <typename ValueType>
+RQueue<ValueType>
+ReplicateQueue<ValueType>::getReader(
+    size_t capacity,
+    QueueFullPolicy policy,
+    size_t lowWatermark,
+    ReplicationFilter filter) {
   auto lockedReaders = readers_.wlock();
   if (closed_) {
     throw std::runtime_error("queue is closed");
   }
-  lockedReaders->emplace_back(std::make_shared<RWQueue<ValueType>>());
-  return RQueue<ValueType>(lockedReaders->back());
+  lockedReaders->emplace_back(ReaderEntry{
+      std::make_shared<RWQueue<std::shared_ptr<const ValueType>>>(
+          capacity, policy, lowWatermark, name_),
+      filter ? std::make_shared<const ReplicationFilter>(std::move(filter))
+             : nullptr});
+  return RQueue<ValueType>(lockedReaders->back().queue);
 }
 
 template <typename ValueType>
@@ -73,8 +102,8 @@ size_t
 ReplicateQueue<ValueType>::getNumReaders() {
   auto lockedReaders = readers_.wlock();
   for (auto it = lockedReaders->begin(); it != lockedReaders->end();) {
-    if (it->use_count() == 1) {
-      (*it)->close(); // Close before erasing
+    if (it->queue.use_count() == 1) {
+      it->queue->close(); // Close before erasing
       it = lockedReaders->erase(it);
     } else {
       ++it;
@@ -83,13 +112,24 @@ ReplicateQueue<ValueType>::getNumReaders() {
   return lockedReaders->size();
 }
 
+template <typename ValueType>
+size_t
+ReplicateQueue<ValueType>::getNumDrops() {
+  size_t drops{0};
+  auto lockedReaders = readers_.rlock();
+  for (auto& reader : *lockedReaders) {
+    drops += reader.queue->getNumDrops();
+  }
+  return drops;
+}
+
 template <typename ValueType>
 void
 ReplicateQueue<ValueType>::close() {
   auto lockedReaders = readers_.wlock();
   closed_ = true;
-  for (auto& queue : *lockedReaders) {
-    queue->close();
+  for (auto& reader : *lockedReaders) {
+    reader.queue->close();
   }
   lockedReaders->clear();
 }
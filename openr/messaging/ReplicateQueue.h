@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include <openr/messaging/Queue.h>
 
 namespace openr {
@@ -14,15 +16,30 @@ namespace messaging {
 
 /**
  * Multiple writers and readers. Each reader gets every written element push by
- * every writer. Writer pays the cost of replicating data to all readers. If no
- * reader exists then all the messages are silently dropped.
+ * every writer. Replication hands a single shared element instance to all
+ * reader queues - the writer's cost is independent of fan-out. Readers
+ * materialize their own copy on read (the last reader steals the shared
+ * instance instead of copying). If no reader exists then all the messages are
+ * silently dropped.
  *
  * Pushed object must be copy constructible.
  */
 template <typename ValueType>
 class ReplicateQueue {
  public:
-  ReplicateQueue();
+  /**
+   * Per-reader replication predicate. Evaluated once on the producer side
+   * for each element - elements for which it returns false are never
+   * replicated to that reader (zero copies, zero wakeups)
+   */
+  using ReplicationFilter = std::function<bool(const ValueType&)>;
+
+  /**
+   * Queues constructed with a non-empty name export per-queue fb303 counters
+   * under `messaging.queue.<name>.*` (aggregated across all readers). See
+   * RWQueue for the exported instrumentation.
+   */
+  explicit ReplicateQueue(std::string name = "");
 
   ~ReplicateQueue();
 
@@ -47,15 +64,34 @@ class ReplicateQueue {
 
   /**
    * Get new reader stream of this queue. Stream will get closed automatically
-   * when reader is destructed.
+   * when reader is destructed. An optional filter restricts which elements
+   * get replicated to this reader.
+   */
+  RQueue<ValueType> getReader(ReplicationFilter filter = nullptr);
+
+  /**
+   * Get new bounded reader stream. Once the reader falls `capacity` elements
+   * behind, writes towards it are dropped (LOSSY) or block the producer
+   * (BLOCKING) until it catches up to the low watermark - a stalled reader
+   * can no longer grow its queue without bound. See RWQueue for watermark
+   * semantics.
    */
-  RQueue<ValueType> getReader();
+  RQueue<ValueType> getReader(
+      size_t capacity,
+      QueueFullPolicy policy,
+      size_t lowWatermark = 0,
+      ReplicationFilter filter = nullptr);
 
   /**
    * Number of replicated streams/readers
    */
   size_t getNumReaders();
 
+  /**
+   * Total number of elements dropped towards lossy bounded readers
+   */
+  size_t getNumDrops();
+
   /**
    * Open the underlying queue. ONLY used for UT purpose.
    */
@@ -70,7 +106,19 @@ class ReplicateQueue {
   void close();
 
  private:
-  folly::Synchronized<std::list<std::shared_ptr<RWQueue<ValueType>>>> readers_;
+  // Name for fb303 instrumentation. Empty name disables instrumentation
+  std::string name_;
+
+  // Queue of shared element instances plus optional replication filter for
+  // one reader. Filter is shared so push() can keep evaluating it safely
+  // after releasing the readers lock
+  struct ReaderEntry {
+    std::shared_ptr<RWQueue<std::shared_ptr<const ValueType>>> queue;
+    std::shared_ptr<const ReplicationFilter> filter{nullptr};
+  };
+
+  // Per-reader queues of the shared element instances
+  folly::Synchronized<std::list<ReaderEntry>> readers_;
   bool closed_{false}; // Protected by above Synchronized lock
 };
 
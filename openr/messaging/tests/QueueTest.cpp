@@ -67,6 +67,91 @@ TEST(RWQueueTest, OrderedPushGet) {
   EXPECT_EQ(0, q.size());
 }
 
+TEST(RWQueueTest, GetAllDrainsBacklog) {
+  RWQueue<std::string> q;
+
+  q.push(std::string("one"));
+  q.push(std::string("two"));
+  q.push(std::string("three"));
+
+  // Entire backlog is drained in one operation
+  auto vals = q.getAll();
+  ASSERT_TRUE(vals.hasValue());
+  EXPECT_EQ(std::vector<std::string>({"one", "two", "three"}), vals.value());
+  EXPECT_EQ(0, q.size());
+
+  // Blocks until at-least one element is available
+  folly::EventBase evb;
+  auto& manager = folly::fibers::getFiberManager(evb);
+  manager.addTask([&q]() mutable {
+    auto vals = q.getAll();
+    ASSERT_TRUE(vals.hasValue());
+    EXPECT_EQ(std::vector<std::string>({"four"}), vals.value());
+  });
+  evb.loopOnce(); // Fiber should get stuck at the read
+  EXPECT_EQ(1, q.numPendingReads());
+  q.push(std::string("four"));
+  evb.loopOnce();
+  EXPECT_EQ(0, q.numPendingReads());
+
+  // Closed queue returns error
+  q.close();
+  EXPECT_EQ(q.getAll().error(), QueueError::QUEUE_CLOSED);
+}
+
+TEST(RWQueueTest, BoundedLossy) {
+  RWQueue<int> q(4 /* capacity */, QueueFullPolicy::LOSSY, 2);
+
+  for (int i = 0; i < 6; ++i) {
+    q.push(i);
+  }
+  EXPECT_EQ(4, q.size());
+  EXPECT_EQ(2, q.getNumDrops());
+
+  // Pushes keep getting dropped until queue drains to its low watermark
+  EXPECT_EQ(0, q.get().value());
+  EXPECT_FALSE(q.push(10));
+  EXPECT_EQ(1, q.get().value());
+  EXPECT_TRUE(q.push(11));
+  EXPECT_EQ(3, q.getNumDrops());
+
+  EXPECT_EQ(2, q.get().value());
+  EXPECT_EQ(3, q.get().value());
+  EXPECT_EQ(11, q.get().value());
+  EXPECT_EQ(0, q.size());
+}
+
+TEST(RWQueueTest, BoundedBlocking) {
+  RWQueue<int> q(2 /* capacity */, QueueFullPolicy::BLOCKING, 1);
+
+  folly::EventBase evb;
+  auto& manager = folly::fibers::getFiberManager(evb);
+  size_t numPushed{0};
+  manager.addTask([&]() mutable {
+    for (int i = 0; i < 4; ++i) {
+      EXPECT_TRUE(q.push(i));
+      ++numPushed;
+    }
+  });
+
+  evb.loopOnce(); // Producer should block after filling up the queue
+  EXPECT_EQ(2, numPushed);
+  EXPECT_EQ(2, q.size());
+
+  // Drain to low watermark - producer resumes and fills up the queue again
+  EXPECT_EQ(0, q.get().value());
+  evb.loopOnce();
+  EXPECT_EQ(3, numPushed);
+
+  EXPECT_EQ(1, q.get().value());
+  evb.loopOnce();
+  EXPECT_EQ(4, numPushed);
+
+  EXPECT_EQ(2, q.get().value());
+  EXPECT_EQ(3, q.get().value());
+  EXPECT_EQ(0, q.size());
+}
+
 TEST(RWQueueTest, ClosedPendingReads) {
   RWQueue<int> q;
 
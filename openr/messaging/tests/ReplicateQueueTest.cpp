@@ -16,6 +16,47 @@
 
 using namespace openr::messaging;
 
+TEST(ReplicateQueueTest, BoundedReader) {
+  ReplicateQueue<int> q;
+  auto r1 = q.getReader();
+  auto r2 = q.getReader(2 /* capacity */, QueueFullPolicy::LOSSY, 1);
+
+  for (int i = 0; i < 4; ++i) {
+    q.push(i);
+  }
+
+  // Unbounded reader sees everything, bounded reader dropped the overflow
+  EXPECT_EQ(4, r1.size());
+  EXPECT_EQ(2, r2.size());
+  EXPECT_EQ(2, q.getNumDrops());
+
+  EXPECT_EQ(0, r2.get().value());
+  EXPECT_EQ(1, r2.get().value());
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(i, r1.get().value());
+  }
+}
+
+TEST(ReplicateQueueTest, FilteredReader) {
+  ReplicateQueue<int> q;
+  auto all = q.getReader();
+  auto evens = q.getReader([](const int& num) { return num % 2 == 0; });
+
+  for (int i = 0; i < 4; ++i) {
+    q.push(i);
+  }
+
+  // Filtered-out elements are never replicated to the filtered reader
+  EXPECT_EQ(4, all.size());
+  EXPECT_EQ(2, evens.size());
+
+  EXPECT_EQ(0, evens.get().value());
+  EXPECT_EQ(2, evens.get().value());
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(i, all.get().value());
+  }
+}
+
 TEST(ReplicateQueueTest, Test) {
   const size_t kNumReaders{16};
   const size_t kTotalWrites{4096};
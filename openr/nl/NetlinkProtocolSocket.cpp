@@ -7,6 +7,8 @@
 
 #include <thread>
 
+#include <linux/filter.h>
+
 #include <fb303/ServiceData.h>
 
 #include <openr/common/Util.h>
@@ -18,11 +20,24 @@ namespace fb303 = facebook::fb303;
 namespace openr::fbnl {
 
 NetlinkProtocolSocket::NetlinkProtocolSocket(
-    folly::EventBase* evb, bool enableIPv6RouteReplaceSemantics)
+    folly::EventBase* evb,
+    bool enableIPv6RouteReplaceSemantics,
+    size_t maxInFlightMsgs,
+    size_t minInFlightMsgs,
+    uint32_t eventGroups)
     : EventHandler(evb),
       evb_(evb),
-      enableIPv6RouteReplaceSemantics_(enableIPv6RouteReplaceSemantics) {
+      enableIPv6RouteReplaceSemantics_(enableIPv6RouteReplaceSemantics),
+      maxInFlightMsgs_(maxInFlightMsgs),
+      minInFlightMsgs_(minInFlightMsgs),
+      eventGroups_(eventGroups) {
   CHECK_NOTNULL(evb_);
+  CHECK_GT(maxInFlightMsgs_, 0) << "In-flight window must be positive";
+  CHECK_GE(maxInFlightMsgs_, minInFlightMsgs_)
+      << "In-flight window must cover the resume threshold";
+
+  // Avoid rehashing of the pending-request map during bulk operations
+  nlSeqNumMap_.reserve(maxInFlightMsgs_);
 
   nlMessageTimer_ = folly::AsyncTimeout::make(*evb_, [this]() noexcept {
     DCHECK(false) << "This shouldn't occur usually. Adding DCHECK to get "
@@ -110,22 +125,31 @@ NetlinkProtocolSocket::init() {
     LOG(FATAL) << "Netlink socket set recv buffer failed.";
   };
 
+  size = kNetlinkSockSendBuf;
+  // increase socket send buffer size to fit batched datagrams
+  if (setsockopt(nlSock_, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size)) < 0) {
+    LOG(FATAL) << "Netlink socket set send buffer failed.";
+  };
+
   // Bind on the source address. We let kernel chose the available port-ID
   struct sockaddr_nl saddr;
   ::memset(&saddr, 0, sizeof(saddr));
   saddr.nl_family = AF_NETLINK;
   saddr.nl_pid = 0; // We let kernel assign the port-ID
   /* We can subscribe to different Netlink mutlicast groups for specific types
-   * of events: link, IPv4/IPv6 address and neighbor. */
-  saddr.nl_groups = RTMGRP_LINK // listen for link events
-      | RTMGRP_IPV4_IFADDR // listen for IPv4 address events
-      | RTMGRP_IPV6_IFADDR // listen for IPv6 address events
-      | RTMGRP_NEIGH; // listen for Neighbor (ARP) events
+   * of events: link, IPv4/IPv6 address and neighbor. The set of groups is
+   * configurable through the constructor, e.g. to avoid Neighbor (ARP/NDP)
+   * event wakeups when nobody consumes them. */
+  saddr.nl_groups = eventGroups_;
 
   if (bind(nlSock_, (struct sockaddr*)&saddr, sizeof(saddr)) != 0) {
     LOG(FATAL) << "Failed to bind netlink socket: " << folly::errnoStr(errno);
   }
 
+  // Drop event notifications we are not interested in before they hit the
+  // socket buffer and wake us up
+  attachEventFilter();
+
   // Retrieve and set pid that we will use for all subsequent messages
   portId_ = saddr.nl_pid;
   LOG(INFO) << "Created netlink socket. fd=" << nlSock_ << ", port=" << portId_;
@@ -142,6 +166,59 @@ NetlinkProtocolSocket::init() {
   sendNetlinkMessage();
 }
 
+void
+NetlinkProtocolSocket::attachEventFilter() noexcept {
+  // Event message types we expect from the subscribed multicast groups. Any
+  // other type showing up with nlmsg_seq=0 is an event nobody will consume
+  std::vector<uint16_t> eventTypes;
+  if (eventGroups_ & RTMGRP_LINK) {
+    eventTypes.insert(eventTypes.end(), {RTM_NEWLINK, RTM_DELLINK});
+  }
+  if (eventGroups_ & (RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR)) {
+    eventTypes.insert(eventTypes.end(), {RTM_NEWADDR, RTM_DELADDR});
+  }
+  if (eventGroups_ & RTMGRP_NEIGH) {
+    eventTypes.insert(eventTypes.end(), {RTM_NEWNEIGH, RTM_DELNEIGH});
+  }
+
+  // Build classic-BPF program. Replies to our own requests carry a non-zero
+  // nlmsg_seq (see nextNlSeqNum_ docs) and always pass. Events (nlmsg_seq=0)
+  // pass only if their type matches one of the subscribed groups.
+  // NOTE: BPF_LD|BPF_ABS loads convert packet data to network byte order,
+  // while netlink header fields are in host byte order. Hence constants are
+  // compared in their htons/htonl form.
+  const uint8_t numTypes = eventTypes.size();
+  std::vector<struct sock_filter> insns;
+  insns.reserve(numTypes + 5);
+  insns.push_back(
+      BPF_STMT(BPF_LD | BPF_W | BPF_ABS, offsetof(struct nlmsghdr, nlmsg_seq)));
+  insns.push_back(BPF_JUMP(
+      BPF_JMP | BPF_JEQ | BPF_K, 0, 0, numTypes + 2 /* jump to accept */));
+  insns.push_back(BPF_STMT(
+      BPF_LD | BPF_H | BPF_ABS, offsetof(struct nlmsghdr, nlmsg_type)));
+  for (uint8_t i = 0; i < numTypes; ++i) {
+    insns.push_back(BPF_JUMP(
+        BPF_JMP | BPF_JEQ | BPF_K,
+        htons(eventTypes.at(i)),
+        numTypes - i /* jump to accept */,
+        0));
+  }
+  insns.push_back(BPF_STMT(BPF_RET | BPF_K, 0)); // drop
+  insns.push_back(BPF_STMT(BPF_RET | BPF_K, 0xffffffff)); // accept
+
+  struct sock_fprog prog;
+  prog.len = insns.size();
+  prog.filter = insns.data();
+  if (setsockopt(nlSock_, SOL_SOCKET, SO_ATTACH_FILTER, &prog, sizeof(prog)) <
+      0) {
+    // Filtering is an optimization - everything the filter would drop is
+    // also discarded in processMessage(). Log and carry on
+    LOG(ERROR) << "Failed to attach filter on netlink socket: "
+               << folly::errnoStr(errno);
+    fbData->addStatValue("netlink.errors", 1, fb303::SUM);
+  }
+}
+
 void
 NetlinkProtocolSocket::handlerReady(uint16_t events) noexcept {
   CHECK_EQ(events, folly::EventHandler::READ);
@@ -209,8 +286,9 @@ NetlinkProtocolSocket::processAck(uint32_t ack, int status) {
 
   // We've successfully completed at-least one message. Send more messages
   // if any pending. Here we add optimization to wait for some more acks and
-  // send pending message in batch of atleast `kMinIovMsg`
-  if (nlSeqNumMap_.empty() or (kMaxIovMsg - nlSeqNumMap_.size() > kMinIovMsg)) {
+  // send pending message in batch of atleast `minInFlightMsgs_`
+  if (nlSeqNumMap_.empty() or
+      (maxInFlightMsgs_ - nlSeqNumMap_.size() > minInFlightMsgs_)) {
     sendNetlinkMessage();
   }
 }
@@ -220,74 +298,86 @@ NetlinkProtocolSocket::sendNetlinkMessage() {
   CHECK(evb_->isInEventBaseThread());
   struct sockaddr_nl nladdr = {
       .nl_family = AF_NETLINK, .nl_pad = 0, .nl_pid = 0, .nl_groups = 0};
-  CHECK_LE(nlSeqNumMap_.size(), kMaxIovMsg)
+  CHECK_LE(nlSeqNumMap_.size(), maxInFlightMsgs_)
       << "We must have capacity to send at-least one message!";
-  uint32_t count{0};
-  const uint32_t iovSize =
-      std::min(msgQueue_.size(), kMaxIovMsg - nlSeqNumMap_.size());
-
-  if (!iovSize) {
-    return;
-  }
-
-  auto iov = std::make_unique<struct iovec[]>(iovSize);
 
-  while (count < iovSize && !msgQueue_.empty()) {
-    auto m = std::move(msgQueue_.front());
-    msgQueue_.pop();
+  // Keep sending datagrams until the queue or the in-flight message budget
+  // is exhausted. Each datagram packs as many messages as fit within
+  // kMaxNlSendPayload bytes - bigger batches risk exceeding the socket send
+  // buffer and getting the whole datagram rejected by the kernel
+  while (!msgQueue_.empty() && nlSeqNumMap_.size() < maxInFlightMsgs_) {
+    uint32_t count{0};
+    uint32_t payloadSize{0};
+    const uint32_t iovSize =
+        std::min(msgQueue_.size(), maxInFlightMsgs_ - nlSeqNumMap_.size());
+    auto iov = std::make_unique<struct iovec[]>(iovSize);
+
+    while (count < iovSize && !msgQueue_.empty()) {
+      // Flush the current datagram if the next message doesn't fit. The
+      // first message always goes out regardless of its size
+      if (count > 0 &&
+          payloadSize + msgQueue_.front()->getDataLength() >
+              kMaxNlSendPayload) {
+        break;
+      }
+      auto m = std::move(msgQueue_.front());
+      msgQueue_.pop();
+
+      struct nlmsghdr* nlmsg_hdr = m->getMessagePtr();
+      iov[count].iov_base = reinterpret_cast<void*>(m->getMessagePtr());
+      iov[count].iov_len = m->getDataLength();
+      payloadSize += m->getDataLength();
+
+      // fill sequence number and PID
+      nlmsg_hdr->nlmsg_pid = portId_;
+      nlmsg_hdr->nlmsg_seq = nextNlSeqNum_++;
+      if (nextNlSeqNum_ == 0) {
+        // wrap around - we start from 1
+        nextNlSeqNum_ = 1;
+      }
 
-    struct nlmsghdr* nlmsg_hdr = m->getMessagePtr();
-    iov[count].iov_base = reinterpret_cast<void*>(m->getMessagePtr());
-    iov[count].iov_len = m->getDataLength();
+      // check if one request per message
+      if ((nlmsg_hdr->nlmsg_flags & NLM_F_MULTI) != 0) {
+        LOG(ERROR) << "Error: multipart netlink message not supported";
+        fbData->addStatValue("netlink.errors", 1, fb303::SUM);
+      }
 
-    // fill sequence number and PID
-    nlmsg_hdr->nlmsg_pid = portId_;
-    nlmsg_hdr->nlmsg_seq = nextNlSeqNum_++;
-    if (nextNlSeqNum_ == 0) {
-      // wrap around - we start from 1
-      nextNlSeqNum_ = 1;
+      // Add seq number -> netlink request mapping
+      auto res = nlSeqNumMap_.insert({nlmsg_hdr->nlmsg_seq, std::move(m)});
+      CHECK(res.second) << "Entry exists for " << nlmsg_hdr->nlmsg_seq;
+      count++;
+      VLOG(2) << "Sending netlink request."
+              << " seq=" << nlmsg_hdr->nlmsg_seq
+              << ", type=" << nlmsg_hdr->nlmsg_type
+              << ", len=" << nlmsg_hdr->nlmsg_len
+              << ", flags=" << nlmsg_hdr->nlmsg_flags;
     }
 
-    // check if one request per message
-    if ((nlmsg_hdr->nlmsg_flags & NLM_F_MULTI) != 0) {
-      LOG(ERROR) << "Error: multipart netlink message not supported";
+    auto outMsg = std::make_unique<struct msghdr>();
+    outMsg->msg_name = &nladdr;
+    outMsg->msg_namelen = sizeof(nladdr);
+    outMsg->msg_iov = &iov[0];
+    outMsg->msg_iovlen = count;
+
+    // `sendmsg` return -1 in case of error else number of bytes sent. `errno`
+    // will be set to an appropriate code in case of error.
+    int bytesSent = sendmsg(nlSock_, outMsg.get(), 0);
+    if (bytesSent < 0) {
+      LOG(ERROR) << "Error sending on netlink socket. Error: "
+                 << folly::errnoStr(std::abs(errno)) << ", errno=" << errno
+                 << ", fd=" << nlSock_
+                 << ", num-messages=" << outMsg->msg_iovlen;
       fbData->addStatValue("netlink.errors", 1, fb303::SUM);
+    } else {
+      fbData->addStatValue("netlink.bytes.tx", bytesSent, fb303::SUM);
     }
+    fbData->addStatValue("netlink.requests", outMsg->msg_iovlen, fb303::SUM);
+    VLOG(2) << "Sent " << outMsg->msg_iovlen << " netlink requests on fd "
+            << nlSock_;
 
-    // Add seq number -> netlink request mapping
-    auto res = nlSeqNumMap_.insert({nlmsg_hdr->nlmsg_seq, std::move(m)});
-    CHECK(res.second) << "Entry exists for " << nlmsg_hdr->nlmsg_seq;
-    count++;
-    VLOG(2) << "Sending netlink request."
-            << " seq=" << nlmsg_hdr->nlmsg_seq
-            << ", type=" << nlmsg_hdr->nlmsg_type
-            << ", len=" << nlmsg_hdr->nlmsg_len
-            << ", flags=" << nlmsg_hdr->nlmsg_flags;
-  }
-
-  auto outMsg = std::make_unique<struct msghdr>();
-  outMsg->msg_name = &nladdr;
-  outMsg->msg_namelen = sizeof(nladdr);
-  outMsg->msg_iov = &iov[0];
-  outMsg->msg_iovlen = count;
-
-  // `sendmsg` return -1 in case of error else number of bytes sent. `errno`
-  // will be set to an appropriate code in case of error.
-  int bytesSent = sendmsg(nlSock_, outMsg.get(), 0);
-  if (bytesSent < 0) {
-    LOG(ERROR) << "Error sending on netlink socket. Error: "
-               << folly::errnoStr(std::abs(errno)) << ", errno=" << errno
-               << ", fd=" << nlSock_ << ", num-messages=" << outMsg->msg_iovlen;
-    fbData->addStatValue("netlink.errors", 1, fb303::SUM);
-  } else {
-    fbData->addStatValue("netlink.bytes.tx", bytesSent, fb303::SUM);
+    // Schedule timer to wait for acks and send next set of messages
+    nlMessageTimer_->scheduleTimeout(kNlRequestAckTimeout);
   }
-  fbData->addStatValue("netlink.requests", outMsg->msg_iovlen, fb303::SUM);
-  VLOG(2) << "Sent " << outMsg->msg_iovlen << " netlink requests on fd "
-          << nlSock_;
-
-  // Schedule timer to wait for acks and send next set of messages
-  nlMessageTimer_->scheduleTimeout(kNlRequestAckTimeout);
 }
 
 void
@@ -430,21 +520,29 @@ NetlinkProtocolSocket::recvNetlinkMessage() {
   // messages buffer
   std::array<char, kMaxNlPayloadSize> recvMsg = {};
 
-  int32_t bytesRead = ::recv(nlSock_, recvMsg.data(), kMaxNlPayloadSize, 0);
-  VLOG(4) << "Message received with size: " << bytesRead;
-
-  if (bytesRead < 0) {
-    if (errno == EINTR || errno == EAGAIN) {
+  // Drain all pending datagrams in one wakeup. During bulk operations the
+  // kernel delivers acks much faster than the event loop turns around, so
+  // consuming them in batch keeps the in-flight window moving
+  while (true) {
+    // The socket is blocking - MSG_DONTWAIT makes the drain terminate with
+    // EAGAIN once the queue is empty
+    int32_t bytesRead =
+        ::recv(nlSock_, recvMsg.data(), kMaxNlPayloadSize, MSG_DONTWAIT);
+    VLOG(4) << "Message received with size: " << bytesRead;
+
+    if (bytesRead < 0) {
+      if (errno == EINTR || errno == EAGAIN) {
+        return;
+      }
+      LOG(ERROR) << "Error in netlink socket receive: " << bytesRead
+                 << " err: " << folly::errnoStr(std::abs(errno));
+      fbData->addStatValue("netlink.errors", 1, fb303::SUM);
       return;
+    } else {
+      fbData->addStatValue("netlink.bytes.rx", bytesRead, fb303::SUM);
     }
-    LOG(ERROR) << "Error in netlink socket receive: " << bytesRead
-               << " err: " << folly::errnoStr(std::abs(errno));
-    fbData->addStatValue("netlink.errors", 1, fb303::SUM);
-    return;
-  } else {
-    fbData->addStatValue("netlink.bytes.rx", bytesRead, fb303::SUM);
+    processMessage(recvMsg, static_cast<uint32_t>(bytesRead));
   }
-  processMessage(recvMsg, static_cast<uint32_t>(bytesRead));
 }
 
 folly::SemiFuture<int>
@@ -504,6 +602,74 @@ NetlinkProtocolSocket::addRoute(const openr::fbnl::Route& route) {
   return future;
 }
 
+std::vector<folly::SemiFuture<int>>
+NetlinkProtocolSocket::addRoutes(const std::vector<openr::fbnl::Route>& routes) {
+  VLOG(1) << "Netlink add routes. count=" << routes.size();
+  std::vector<folly::SemiFuture<int>> futures;
+  futures.reserve(routes.size());
+
+  // Template message holding the encoded attribute chain of the current run
+  // of homogeneous routes. It is local to this batch and never enqueued.
+  std::unique_ptr<NetlinkRouteMessage> tmplMsg;
+  const openr::fbnl::Route* tmplRoute{nullptr};
+
+  for (auto const& route : routes) {
+    const auto family = route.getFamily();
+    const bool isMpls = (family == AF_MPLS);
+    if (family != AF_INET and family != AF_INET6 and not isMpls) {
+      // no template fast-path for other address families
+      futures.emplace_back(addRoute(route));
+      continue;
+    }
+
+    const bool reusable = tmplRoute and
+        (isMpls ? NetlinkRouteMessage::canReuseLabelEncoding(route, *tmplRoute)
+                : NetlinkRouteMessage::canReuseEncoding(route, *tmplRoute));
+    if (not reusable) {
+      // Start a new template run. Encode the shared attribute chain once.
+      if (tmplMsg) {
+        tmplMsg->setReturnStatus(0); // fulfil promise of local message
+      }
+      tmplMsg = std::make_unique<NetlinkRouteMessage>();
+      tmplRoute = nullptr;
+      int status =
+          isMpls ? tmplMsg->addLabelRoute(route) : tmplMsg->addRoute(route);
+      if (status != 0) {
+        // fall back to the regular path which reports the error
+        tmplMsg->setReturnStatus(status);
+        tmplMsg.reset();
+        futures.emplace_back(addRoute(route));
+        continue;
+      }
+      tmplRoute = &route;
+    }
+
+    if (family == AF_INET6 and not enableIPv6RouteReplaceSemantics_) {
+      // Special case for IPv6 route add. We first delete the route and then
+      // add it.
+      // NOTE: We ignore the error for the deleteRoute
+      deleteRoute(route);
+    }
+
+    auto rtmMsg = std::make_unique<NetlinkRouteMessage>();
+    futures.emplace_back(rtmMsg->getSemiFuture());
+    int status = isMpls
+        ? rtmMsg->addLabelRouteFromTemplate(
+              *tmplMsg, route.getMplsLabel().value())
+        : rtmMsg->addRouteFromTemplate(*tmplMsg, route.getDestination());
+    if (status != 0) {
+      rtmMsg->setReturnStatus(status);
+    } else {
+      notifQueue_.putMessage(std::move(rtmMsg));
+    }
+  }
+
+  if (tmplMsg) {
+    tmplMsg->setReturnStatus(0); // fulfil promise of local message
+  }
+  return futures;
+}
+
 folly::SemiFuture<int>
 NetlinkProtocolSocket::deleteRoute(const openr::fbnl::Route& route) {
   VLOG(1) << "Netlink delete route. " << route.str();
@@ -566,6 +732,52 @@ NetlinkProtocolSocket::deleteIfAddress(const openr::fbnl::IfAddress& ifAddr) {
   return future;
 }
 
+std::vector<folly::SemiFuture<int>>
+NetlinkProtocolSocket::addIfAddresses(
+    const std::vector<openr::fbnl::IfAddress>& ifAddrs) {
+  VLOG(1) << "Netlink add interface addresses. count=" << ifAddrs.size();
+  return addOrDeleteIfAddresses(ifAddrs, RTM_NEWADDR);
+}
+
+std::vector<folly::SemiFuture<int>>
+NetlinkProtocolSocket::deleteIfAddresses(
+    const std::vector<openr::fbnl::IfAddress>& ifAddrs) {
+  VLOG(1) << "Netlink delete interface addresses. count=" << ifAddrs.size();
+  return addOrDeleteIfAddresses(ifAddrs, RTM_DELADDR);
+}
+
+std::vector<folly::SemiFuture<int>>
+NetlinkProtocolSocket::addOrDeleteIfAddresses(
+    const std::vector<openr::fbnl::IfAddress>& ifAddrs, int type) {
+  std::vector<folly::SemiFuture<int>> futures;
+  std::vector<std::unique_ptr<NetlinkAddrMessage>> addrMsgs;
+  futures.reserve(ifAddrs.size());
+  addrMsgs.reserve(ifAddrs.size());
+
+  // Encode and validate every message before submitting any. A malformed
+  // address fails the whole batch here, so the kernel never sees a partial
+  // set of address changes from a bad request
+  int status{0};
+  for (auto const& ifAddr : ifAddrs) {
+    auto addrMsg = std::make_unique<NetlinkAddrMessage>();
+    futures.emplace_back(addrMsg->getSemiFuture());
+    if (status == 0) {
+      status = addrMsg->addOrDeleteIfAddress(ifAddr, type);
+    }
+    addrMsgs.emplace_back(std::move(addrMsg));
+  }
+
+  for (auto& addrMsg : addrMsgs) {
+    if (status != 0) {
+      // report the first encoding error on every future of the batch
+      addrMsg->setReturnStatus(status);
+    } else {
+      notifQueue_.putMessage(std::move(addrMsg));
+    }
+  }
+  return futures;
+}
+
 folly::SemiFuture<std::vector<fbnl::Link>>
 NetlinkProtocolSocket::getAllLinks() {
   VLOG(1) << "Netlink get links";
@@ -658,4 +870,64 @@ NetlinkProtocolSocket::getMplsRoutes(uint8_t protocolId) {
   return getRoutes(builder.build());
 }
 
+folly::SemiFuture<int>
+NetlinkProtocolSocket::getRoutes(
+    const fbnl::Route& filter, std::function<void(fbnl::Route)> routeCb) {
+  VLOG(1) << "Netlink get routes (streaming) with filter. " << filter.str();
+  auto routeMsg = std::make_unique<openr::fbnl::NetlinkRouteMessage>();
+  auto future = routeMsg->getSemiFuture();
+
+  // Initialize message fields to get all routes
+  routeMsg->init(RTM_GETROUTE, 0, filter);
+  // Received routes will be handed to the callback instead of being
+  // accumulated in the message object
+  routeMsg->setRouteCallback(std::move(routeCb));
+  notifQueue_.putMessage(std::move(routeMsg));
+
+  return future;
+}
+
+folly::SemiFuture<int>
+NetlinkProtocolSocket::getAllRoutes(std::function<void(fbnl::Route)> routeCb) {
+  fbnl::RouteBuilder builder;
+  builder.setProtocolId(RTPROT_UNSPEC); // Explicitly set protocol to 0
+  builder.setType(RTN_UNSPEC); // Explicitly set type to 0
+  return getRoutes(builder.build(), std::move(routeCb));
+}
+
+folly::SemiFuture<int>
+NetlinkProtocolSocket::getIPv4Routes(
+    uint8_t protocolId, std::function<void(fbnl::Route)> routeCb) {
+  fbnl::RouteBuilder builder;
+  // Set address family to MPLS with default v4 route
+  builder.setDestination({folly::IPAddressV4("0.0.0.0"), 0});
+  // Set protocol ID
+  builder.setProtocolId(protocolId);
+  builder.setType(RTN_UNSPEC); // Explicitly set type to 0
+  return getRoutes(builder.build(), std::move(routeCb));
+}
+
+folly::SemiFuture<int>
+NetlinkProtocolSocket::getIPv6Routes(
+    uint8_t protocolId, std::function<void(fbnl::Route)> routeCb) {
+  fbnl::RouteBuilder builder;
+  // Set address family to MPLS with default v6 route
+  builder.setDestination({folly::IPAddressV6("::"), 0});
+  // Set protocol ID
+  builder.setProtocolId(protocolId);
+  builder.setType(RTN_UNSPEC); // Explicitly set type to 0
+  return getRoutes(builder.build(), std::move(routeCb));
+}
+
+folly::SemiFuture<int>
+NetlinkProtocolSocket::getMplsRoutes(
+    uint8_t protocolId, std::function<void(fbnl::Route)> routeCb) {
+  fbnl::RouteBuilder builder;
+  // Set address family to MPLS with default label
+  builder.setMplsLabel(0);
+  // Set protocol ID
+  builder.setProtocolId(protocolId);
+  return getRoutes(builder.build(), std::move(routeCb));
+}
+
 } // namespace openr::fbnl
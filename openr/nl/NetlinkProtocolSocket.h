@@ -25,11 +25,27 @@ namespace openr::fbnl {
 // Receive socket buffer for netlink socket
 constexpr uint32_t kNetlinkSockRecvBuf{1 * 1024 * 1024};
 
-// Maximum number of in-flight messages. `kMinIovMsg` indicates the soft
-// requirement for sending bufferred messages.
+// Send socket buffer for netlink socket and upper bound on the bytes packed
+// into a single sendmsg datagram. The kernel accepts multiple rtnetlink
+// messages per datagram but rejects datagrams exceeding the socket send
+// buffer, so batches are flushed before reaching it
+constexpr uint32_t kNetlinkSockSendBuf{1 * 1024 * 1024};
+constexpr uint32_t kMaxNlSendPayload{192 * 1024};
+
+// Default maximum number of in-flight messages. `kMinIovMsg` indicates the
+// soft requirement for sending bufferred messages. Both are configurable
+// through the constructor - bulk route programming benefits from a window
+// of thousands to keep the pipe to the kernel full across ack round trips
 constexpr size_t kMaxIovMsg{500};
 constexpr size_t kMinIovMsg{200};
 
+// Default set of netlink multicast groups the event socket subscribes to.
+// Configurable through the constructor - deployments that don't consume a
+// class of events (e.g. neighbor updates) can drop the corresponding group
+// to avoid the per-event wakeups altogether
+constexpr uint32_t kNetlinkDefaultEventGroups = RTMGRP_LINK |
+    RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR | RTMGRP_NEIGH;
+
 // Timeout for an ack from kernel for netlink messages we sent. The response for
 // big request (e.g. adding 5k routes or getting 10k routes) is sent back in
 // multiple parts. If we don't receive any part of below specified timeout, we
@@ -92,7 +108,11 @@ constexpr std::chrono::milliseconds kNlRequestAckTimeout{1000};
 class NetlinkProtocolSocket : public folly::EventHandler {
  public:
   explicit NetlinkProtocolSocket(
-      folly::EventBase* evb, bool enableIPv6RouteReplaceSemantics = false);
+      folly::EventBase* evb,
+      bool enableIPv6RouteReplaceSemantics = false,
+      size_t maxInFlightMsgs = kMaxIovMsg,
+      size_t minInFlightMsgs = kMinIovMsg,
+      uint32_t eventGroups = kNetlinkDefaultEventGroups);
 
   virtual ~NetlinkProtocolSocket();
 
@@ -124,6 +144,19 @@ class NetlinkProtocolSocket : public folly::EventHandler {
    */
   virtual folly::SemiFuture<int> addRoute(const openr::fbnl::Route& route);
 
+  /**
+   * API to add a batch of routes. Consecutive unicast routes sharing the same
+   * attributes and nexthops (differing only in destination prefix) reuse a
+   * pre-encoded message template, cutting per-message build cost for bulk
+   * programming to near-memcpy cost. Mpls label routes get the same treatment
+   * keyed on the top label, which makes contiguous label-block installs (e.g.
+   * per-interface adjacency label ranges) cheap. Semantics of each individual
+   * route add are identical to addRoute(). Returns one future per route, in
+   * order.
+   */
+  virtual std::vector<folly::SemiFuture<int>> addRoutes(
+      const std::vector<openr::fbnl::Route>& routes);
+
   /**
    * Delete route. This API deletes all the paths associated with the route
    * based on key (destination-address or mpls top-label). Supports AF_INET,
@@ -152,6 +185,21 @@ class NetlinkProtocolSocket : public folly::EventHandler {
   virtual folly::SemiFuture<int> deleteIfAddress(
       const openr::fbnl::IfAddress& ifAddr);
 
+  /**
+   * APIs to add/delete a batch of interface addresses. All messages are
+   * encoded and validated upfront before any is submitted - a malformed
+   * address fails the whole batch and nothing hits the kernel, so a bad
+   * request can not leave the interface partially programmed. Valid batches
+   * are enqueued together and go out pipelined within the in-flight window
+   * rather than one round trip per address. Semantics of each individual
+   * operation are identical to addIfAddress()/deleteIfAddress(). Returns one
+   * future per address, in order.
+   */
+  virtual std::vector<folly::SemiFuture<int>> addIfAddresses(
+      const std::vector<openr::fbnl::IfAddress>& ifAddrs);
+  virtual std::vector<folly::SemiFuture<int>> deleteIfAddresses(
+      const std::vector<openr::fbnl::IfAddress>& ifAddrs);
+
   /**
    * API to get interfaces from kernel
    */
@@ -191,6 +239,30 @@ class NetlinkProtocolSocket : public folly::EventHandler {
   virtual folly::SemiFuture<std::vector<fbnl::Route>> getMplsRoutes(
       uint8_t protocolId);
 
+  /**
+   * Streaming variants of the route retrieval APIs above. Instead of
+   * accumulating every route into a vector before fulfilling the future,
+   * `routeCb` is invoked once per received route as the kernel dump is
+   * processed. This keeps memory flat when the routing table is large (e.g.
+   * full internet table). The returned future is fulfilled with the netlink
+   * ack status (0 on success) once the dump completes.
+   *
+   * NOTE: `routeCb` is invoked from the internal event-base thread. The
+   * fulfillment of the returned future synchronizes with all callback
+   * invocations, so state written by the callback may be safely read after
+   * the future completes.
+   */
+  virtual folly::SemiFuture<int> getRoutes(
+      const fbnl::Route& filter, std::function<void(fbnl::Route)> routeCb);
+  virtual folly::SemiFuture<int> getAllRoutes(
+      std::function<void(fbnl::Route)> routeCb);
+  virtual folly::SemiFuture<int> getIPv4Routes(
+      uint8_t protocolId, std::function<void(fbnl::Route)> routeCb);
+  virtual folly::SemiFuture<int> getIPv6Routes(
+      uint8_t protocolId, std::function<void(fbnl::Route)> routeCb);
+  virtual folly::SemiFuture<int> getMplsRoutes(
+      uint8_t protocolId, std::function<void(fbnl::Route)> routeCb);
+
   /**
    * Utility function to accumulate result of multiple requests into one. The
    * result will be 0 if all the futures are successful else it will contains
@@ -220,6 +292,11 @@ class NetlinkProtocolSocket : public folly::EventHandler {
   // Send a message batch to netlink socket from queue_
   void sendNetlinkMessage();
 
+  // Shared implementation of addIfAddresses()/deleteIfAddresses(). `type` is
+  // RTM_NEWADDR or RTM_DELADDR
+  std::vector<folly::SemiFuture<int>> addOrDeleteIfAddresses(
+      const std::vector<openr::fbnl::IfAddress>& ifAddrs, int type);
+
   // Receive messages from netlink socket. Invoke `processMessage` for every
   // message received.
   void recvNetlinkMessage();
@@ -233,6 +310,13 @@ class NetlinkProtocolSocket : public folly::EventHandler {
   // Resume sending messages from queue_ if any pending
   void processAck(uint32_t ack, int status);
 
+  // Attach a classic-BPF program on the netlink socket that drops event
+  // notifications (nlmsg_seq == 0) whose message type doesn't correspond to
+  // any of the subscribed multicast groups. Uninteresting events are dropped
+  // in kernel, before they can wake up the event thread. Replies to our own
+  // requests (nlmsg_seq != 0) always pass the filter.
+  void attachEventFilter() noexcept;
+
   // Event base for serializing read/write requests to netlink socket. Also
   // ensure thread safety of private member variables.
   folly::EventBase* evb_{nullptr};
@@ -248,6 +332,16 @@ class NetlinkProtocolSocket : public folly::EventHandler {
   // Use new IPv6 route replace semantics. See documentation for addRoute(...)
   const bool enableIPv6RouteReplaceSemantics_{false};
 
+  // In-flight ack window. Sending stops once maxInFlightMsgs_ requests
+  // await their ack and resumes when at least minInFlightMsgs_ worth of
+  // capacity has freed up (or the window fully drained)
+  const size_t maxInFlightMsgs_{kMaxIovMsg};
+  const size_t minInFlightMsgs_{kMinIovMsg};
+
+  // Netlink multicast groups to subscribe for event notifications. Also used
+  // to derive the in-kernel event filter. See attachEventFilter()
+  const uint32_t eventGroups_{kNetlinkDefaultEventGroups};
+
   // Netlink socket fd. Created when class is constructed. Re-created on timeout
   // when no response is received for any of our pending requests.
   int nlSock_{-1};
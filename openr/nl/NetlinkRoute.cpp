@@ -52,6 +52,12 @@ NetlinkRouteMessage::rcvdRoute(Route&& route) {
     route.setNextHops(reversedMplsLabelNhs);
   }
 
+  if (routeCb_) {
+    // Streaming consumer - hand over the route instead of buffering it
+    routeCb_(std::move(route));
+    return;
+  }
+
   rcvdRoutes_.emplace_back(std::move(route));
 }
 
@@ -603,7 +609,7 @@ NetlinkRouteMessage::parseMessage(const struct nlmsghdr* nlmsg) {
       for (auto& nh : nextHops) {
         // don't add empty nexthop
         if (nh.getGateway().has_value() || nh.getIfIndex().has_value()) {
-          routeBuilder.addNextHop(nh);
+          routeBuilder.addNextHop(std::move(nh));
         }
       }
     } break;
@@ -613,10 +619,10 @@ NetlinkRouteMessage::parseMessage(const struct nlmsghdr* nlmsg) {
   if (singleNextHopFlag) {
     setMplsAction(nhBuilder, routeEntry->rtm_family);
     // add single nexthop
-    auto nh = nhBuilder.build();
+    auto nh = std::move(nhBuilder).build();
     // don't add empty nexthop
     if (nh.getGateway().has_value() || nh.getIfIndex().has_value()) {
-      routeBuilder.addNextHop(nh);
+      routeBuilder.addNextHop(std::move(nh));
     }
   }
 
@@ -630,7 +636,7 @@ NetlinkRouteMessage::parseMessage(const struct nlmsghdr* nlmsg) {
     }
   }
 
-  auto route = routeBuilder.build();
+  auto route = std::move(routeBuilder).build();
   VLOG(3) << "Netlink parsed route message. " << route.str();
   return route;
 }
@@ -663,8 +669,7 @@ NetlinkRouteMessage::parseNextHops(
       }
     }
     setMplsAction(nhBuilder, family);
-    auto nexthop = nhBuilder.build();
-    nextHops.emplace_back(nexthop);
+    nextHops.emplace_back(std::move(nhBuilder).build());
     nhLen -= NLMSG_ALIGN(nh->rtnh_len);
     nh = RTNH_NEXT(nh);
   } while (RTNH_OK(nh, nhLen));
@@ -706,6 +711,49 @@ NetlinkRouteMessage::addRoute(const Route& route) {
   return addNextHops(route);
 }
 
+bool
+NetlinkRouteMessage::canReuseEncoding(const Route& route, const Route& tmpl) {
+  return route.getFamily() == tmpl.getFamily() and
+      route.getType() == tmpl.getType() and
+      route.getRouteTable() == tmpl.getRouteTable() and
+      route.getProtocolId() == tmpl.getProtocolId() and
+      route.getScope() == tmpl.getScope() and
+      route.getFlags() == tmpl.getFlags() and
+      route.getPriority() == tmpl.getPriority() and
+      route.getNextHops() == tmpl.getNextHops();
+}
+
+int
+NetlinkRouteMessage::addRouteFromTemplate(
+    const NetlinkRouteMessage& tmpl, const folly::CIDRNetwork& dst) {
+  const auto& ip = std::get<0>(dst);
+  const uint32_t len = tmpl.getDataLength();
+  CHECK_LE(len, kMaxNlPayloadSize);
+
+  // copy the encoded template message wholesale. The sequence number is
+  // assigned at send time.
+  ::memcpy(msg.data(), tmpl.msg.data(), len);
+  rtmsg_ = reinterpret_cast<struct rtmsg*>(
+      (char*)msghdr_ + NLMSG_ALIGN(sizeof(struct nlmsghdr)));
+
+  if (rtmsg_->rtm_family != ip.family()) {
+    LOG(ERROR) << "Address family mismatch with route template";
+    return EINVAL;
+  }
+
+  // patch the destination prefix. RTA_DST is the first attribute encoded by
+  // addRoute() and immediately follows the route message header
+  rtmsg_->rtm_dst_len = std::get<1>(dst);
+  auto* rtaDst = reinterpret_cast<struct rtattr*>(
+      (char*)msghdr_ + NLMSG_ALIGN(NLMSG_LENGTH(sizeof(struct rtmsg))));
+  if (rtaDst->rta_type != RTA_DST or RTA_PAYLOAD(rtaDst) != ip.byteCount()) {
+    LOG(ERROR) << "RTA_DST mismatch with route template";
+    return EINVAL;
+  }
+  ::memcpy(RTA_DATA(rtaDst), ip.bytes(), ip.byteCount());
+  return 0;
+}
+
 int
 NetlinkRouteMessage::deleteRoute(const Route& route) {
   auto const& pfix = route.getDestination();
@@ -756,6 +804,55 @@ NetlinkRouteMessage::addLabelRoute(const Route& route) {
   return addNextHops(route);
 }
 
+bool
+NetlinkRouteMessage::canReuseLabelEncoding(
+    const Route& route, const Route& tmpl) {
+  // nexthop equality covers the embedded outgoing label of SWAP paths, so
+  // reuse is restricted to runs whose encodings are byte-identical modulo
+  // the top label (e.g. PHP adjacency label ranges)
+  return route.getFamily() == AF_MPLS and tmpl.getFamily() == AF_MPLS and
+      route.getMplsLabel().has_value() and
+      route.getType() == tmpl.getType() and
+      route.getRouteTable() == tmpl.getRouteTable() and
+      route.getProtocolId() == tmpl.getProtocolId() and
+      route.getScope() == tmpl.getScope() and
+      route.getFlags() == tmpl.getFlags() and
+      route.getPriority() == tmpl.getPriority() and
+      route.getNextHops() == tmpl.getNextHops();
+}
+
+int
+NetlinkRouteMessage::addLabelRouteFromTemplate(
+    const NetlinkRouteMessage& tmpl, uint32_t label) {
+  const uint32_t len = tmpl.getDataLength();
+  CHECK_LE(len, kMaxNlPayloadSize);
+
+  // copy the encoded template message wholesale. The sequence number is
+  // assigned at send time.
+  ::memcpy(msg.data(), tmpl.msg.data(), len);
+  rtmsg_ = reinterpret_cast<struct rtmsg*>(
+      (char*)msghdr_ + NLMSG_ALIGN(sizeof(struct nlmsghdr)));
+
+  if (rtmsg_->rtm_family != AF_MPLS) {
+    LOG(ERROR) << "Address family mismatch with label route template";
+    return EINVAL;
+  }
+
+  // patch the top label. RTA_DST is the first attribute encoded by
+  // addLabelRoute() and immediately follows the route message header
+  auto* rtaDst = reinterpret_cast<struct rtattr*>(
+      (char*)msghdr_ + NLMSG_ALIGN(NLMSG_LENGTH(sizeof(struct rtmsg))));
+  if (rtaDst->rta_type != RTA_DST or
+      RTA_PAYLOAD(rtaDst) != sizeof(struct mpls_label)) {
+    LOG(ERROR) << "RTA_DST mismatch with label route template";
+    return EINVAL;
+  }
+  struct mpls_label mlabel;
+  mlabel.entry = encodeLabel(label, true);
+  ::memcpy(RTA_DATA(rtaDst), &mlabel, sizeof(mpls_label));
+  return 0;
+}
+
 int
 NetlinkRouteMessage::deleteLabelRoute(const Route& route) {
   init(RTM_DELROUTE, 0, route);
@@ -56,6 +56,15 @@ class NetlinkRouteMessage final : public NetlinkMessage {
   // initiallize route message with default params
   void init(int type, uint32_t flags, const Route& route);
 
+  // Set streaming consumer for received routes. When set, routes are handed
+  // to the callback one by one instead of being buffered in rcvdRoutes_ and
+  // routePromise_ is fulfilled with an empty vector. Use getSemiFuture() on
+  // the base class to learn about dump completion.
+  void
+  setRouteCallback(std::function<void(Route)> routeCb) {
+    routeCb_ = std::move(routeCb);
+  }
+
   friend std::ostream&
   operator<<(std::ostream& out, NetlinkRouteMessage const& msg) {
     out << "\nMessage type:     " << msg.msghdr_->nlmsg_type
@@ -78,6 +87,29 @@ class NetlinkRouteMessage final : public NetlinkMessage {
   // delete label route
   int deleteLabelRoute(const Route& route);
 
+  // check whether `route` can share the encoded attribute chain of `tmpl`.
+  // True when the two unicast routes differ at most in destination prefix.
+  static bool canReuseEncoding(const Route& route, const Route& tmpl);
+
+  // Initialize message by copying the fully encoded `tmpl` message and
+  // patching the destination prefix in place. `tmpl` must have been encoded
+  // with addRoute() for a route satisfying canReuseEncoding(). This skips
+  // re-encoding of the attribute chain and reduces message-build cost for
+  // homogeneous route batches to a few memcpys.
+  int addRouteFromTemplate(
+      const NetlinkRouteMessage& tmpl, const folly::CIDRNetwork& dst);
+
+  // same as canReuseEncoding() for label routes: true when the two AF_MPLS
+  // routes differ at most in their top label. SWAP nexthops embed the
+  // outgoing label, so runs of swap routes only match when those agree
+  static bool canReuseLabelEncoding(const Route& route, const Route& tmpl);
+
+  // Initialize message by copying the fully encoded `tmpl` message and
+  // patching the top label in place. `tmpl` must have been encoded with
+  // addLabelRoute() for a route satisfying canReuseLabelEncoding()
+  int addLabelRouteFromTemplate(
+      const NetlinkRouteMessage& tmpl, uint32_t label);
+
   // encode MPLS label, returns in network order
   static uint32_t encodeLabel(uint32_t label, bool bos);
 
@@ -169,6 +201,9 @@ class NetlinkRouteMessage final : public NetlinkMessage {
 
   folly::Promise<std::vector<Route>> routePromise_;
   std::vector<Route> rcvdRoutes_;
+
+  // optional streaming consumer for received routes
+  std::function<void(Route)> routeCb_{nullptr};
 };
 
 /**
@@ -19,6 +19,21 @@ NetlinkSocket::NetlinkSocket(
 
   CHECK(nlSock_ != nullptr) << "Missing NetlinkProtocolSocket";
 
+  // Spawn handler thread. Subscriber callbacks run here, decoupled from the
+  // event loop so a slow subscriber cannot delay cache updates or route
+  // programming.
+  eventThread_ = std::thread([this]() noexcept {
+    std::optional<QueuedEvent> queuedEvent;
+    while (true) {
+      eventQueue_.blockingRead(queuedEvent);
+      if (not queuedEvent.has_value()) {
+        break; // shutdown sentinel
+      }
+      auto& [eventHandler, ifName, event] = queuedEvent.value();
+      eventHandler->handleEvent(ifName, event);
+    }
+  });
+
   // Instantiate local link and neighbor caches
   getAllReachableNeighbors().get();
 
@@ -60,6 +75,34 @@ NetlinkSocket::NetlinkSocket(
 
 NetlinkSocket::~NetlinkSocket() {
   nlSock_.reset();
+
+  // Unblock and join the handler thread. Events already queued are drained
+  // before the sentinel is consumed.
+  eventQueue_.blockingWrite(std::nullopt);
+  eventThread_.join();
+}
+
+void
+NetlinkSocket::dispatchEvent(
+    NetlinkEventType eventType,
+    std::string ifName,
+    EventVariant event) noexcept {
+  if (eventQueue_.write(std::make_optional(
+          std::make_tuple(handler_, std::move(ifName), std::move(event))))) {
+    return;
+  }
+
+  // ring is full - drop the event rather than stalling the event loop
+  const auto count = ++eventDropCount_[eventType];
+  LOG_IF(WARNING, count % 1000 == 1)
+      << "Subscriber event ring full. Dropped " << count
+      << " events of type " << eventType;
+}
+
+uint64_t
+NetlinkSocket::getEventDropCount(NetlinkEventType event) const {
+  CHECK_LT(event, MAX_EVENT_TYPE);
+  return eventDropCount_[event].load();
 }
 
 void
@@ -90,7 +133,7 @@ NetlinkSocket::doHandleLinkEvent(Link link, bool runHandler) noexcept {
   }
   if (handler_ && runHandler && eventFlags_[LINK_EVENT]) {
     EventVariant event = std::move(link);
-    handler_->handleEvent(linkName, event);
+    dispatchEvent(LINK_EVENT, linkName, std::move(event));
   }
 }
 
@@ -121,7 +164,7 @@ NetlinkSocket::doHandleAddrEvent(IfAddress ifAddr, bool runHandler) noexcept {
 
   if (handler_ && runHandler && eventFlags_[ADDR_EVENT]) {
     EventVariant event = std::move(ifAddr);
-    handler_->handleEvent(ifName, event);
+    dispatchEvent(ADDR_EVENT, std::move(ifName), std::move(event));
   }
 }
 
@@ -152,7 +195,7 @@ NetlinkSocket::doHandleNeighborEvent(
   if (handler_ && runHandler && eventFlags_[NEIGH_EVENT]) {
     NeighborBuilder nhBuilder;
     EventVariant event = std::move(neighbor);
-    handler_->handleEvent(ifName, event);
+    dispatchEvent(NEIGH_EVENT, std::move(ifName), std::move(event));
   }
 }
 
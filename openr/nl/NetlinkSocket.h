@@ -7,9 +7,14 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <thread>
+
 #include <fbzmq/async/ZmqEventLoop.h>
 #include <folly/ConcurrentBitSet.h>
 #include <folly/IPAddress.h>
+#include <folly/MPMCQueue.h>
 #include <folly/String.h>
 #include <folly/futures/Future.h>
 #include <openr/nl/NetlinkProtocolSocket.h>
@@ -332,6 +337,15 @@ class NetlinkSocket {
 
   void setEventHandler(EventsHandler* handler);
 
+  /**
+   * Number of events of given type dropped because the subscriber could not
+   * keep up with the event rate. Subscriber callbacks are invoked on a
+   * dedicated handler thread fed through a bounded ring; when the ring is
+   * full, events are dropped instead of stalling cache updates and route
+   * programming on the event loop.
+   */
+  uint64_t getEventDropCount(NetlinkEventType event) const;
+
   void registerNeighborListener(
       std::function<void(const NeighborUpdate& neighborUpdate)> callback);
 
@@ -342,6 +356,18 @@ class NetlinkSocket {
   }
 
  private:
+  // a subscriber event in flight between the event loop and the handler
+  // thread. std::nullopt serves as the shutdown sentinel.
+  using QueuedEvent = std::tuple<EventsHandler*, std::string, EventVariant>;
+
+  // hand event over to the handler thread. Drops the event and bumps the
+  // per-type drop counter when the ring is full, so a slow subscriber never
+  // blocks the event loop.
+  void dispatchEvent(
+      NetlinkEventType eventType,
+      std::string ifName,
+      EventVariant event) noexcept;
+
   void doHandleRouteEvent(
       Route route, bool runHandler, bool updateUnicastRoute) noexcept;
 
@@ -409,6 +435,13 @@ class NetlinkSocket {
   // Indicating to run which event type's handler
   folly::ConcurrentBitSet<MAX_EVENT_TYPE> eventFlags_;
 
+  // Bounded ring between event loop (producer) and handler thread
+  // (consumer) plus per event type overload drop counters
+  static constexpr uint32_t kEventQueueCapacity{8192};
+  folly::MPMCQueue<std::optional<QueuedEvent>> eventQueue_{kEventQueueCapacity};
+  std::thread eventThread_;
+  std::array<std::atomic<uint64_t>, MAX_EVENT_TYPE> eventDropCount_{};
+
   std::unique_ptr<openr::fbnl::NetlinkProtocolSocket> nlSock_{nullptr};
 
   std::mutex neighborListenerMutex_;
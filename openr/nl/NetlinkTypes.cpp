@@ -23,10 +23,15 @@ isNeighborReachable(int state) {
 }
 
 Route
-RouteBuilder::build() const {
+RouteBuilder::build() const& {
   return Route(*this);
 }
 
+Route
+RouteBuilder::build() && {
+  return Route(std::move(*this));
+}
+
 Route
 RouteBuilder::buildMulticastRoute() const {
   if (!routeIfIndex_.has_value() || routeIfIndex_.value() == 0 ||
@@ -217,6 +222,12 @@ RouteBuilder::addNextHop(const NextHop& nextHop) {
   return *this;
 }
 
+RouteBuilder&
+RouteBuilder::addNextHop(NextHop&& nextHop) {
+  nextHops_.emplace(std::move(nextHop));
+  return *this;
+}
+
 const NextHopSet&
 RouteBuilder::getNextHops() const {
   return nextHops_;
@@ -244,6 +255,7 @@ RouteBuilder::reset() {
   routeTable_ = RT_TABLE_MAIN;
   protocolId_ = DEFAULT_PROTOCOL_ID;
   scope_ = RT_SCOPE_UNIVERSE;
+  family_ = AF_UNSPEC;
   isValid_ = false;
   flags_.reset();
   priority_.reset();
@@ -251,7 +263,10 @@ RouteBuilder::reset() {
   mtu_.reset();
   advMss_.reset();
   nextHops_.clear();
+  dst_ = folly::CIDRNetwork{};
+  routeIfIndex_.reset();
   routeIfName_.reset();
+  mplsLabel_.reset();
 }
 
 Route::Route(const RouteBuilder& builder)
@@ -271,6 +286,23 @@ Route::Route(const RouteBuilder& builder)
       routeIfName_(builder.getRouteIfName()),
       mplsLabel_(builder.getMplsLabel()) {}
 
+Route::Route(RouteBuilder&& builder)
+    : type_(builder.type_),
+      routeTable_(builder.routeTable_),
+      protocolId_(builder.protocolId_),
+      scope_(builder.scope_),
+      family_(builder.family_),
+      isValid_(builder.isValid_),
+      flags_(builder.flags_),
+      priority_(builder.priority_),
+      tos_(builder.tos_),
+      mtu_(builder.mtu_),
+      advMss_(builder.advMss_),
+      nextHops_(std::move(builder.nextHops_)),
+      dst_(std::move(builder.dst_)),
+      routeIfName_(std::move(builder.routeIfName_)),
+      mplsLabel_(builder.mplsLabel_) {}
+
 Route::~Route() {}
 
 Route::Route(Route&& other) noexcept {
@@ -487,10 +519,15 @@ Route::setNextHops(const NextHopSet& nextHops) {
 /*=================================NextHop====================================*/
 
 NextHop
-NextHopBuilder::build() const {
+NextHopBuilder::build() const& {
   return NextHop(*this);
 }
 
+NextHop
+NextHopBuilder::build() && {
+  return NextHop(std::move(*this));
+}
+
 void
 NextHopBuilder::reset() {
   ifIndex_.reset();
@@ -585,6 +622,15 @@ NextHop::NextHop(const NextHopBuilder& builder)
       pushLabels_(builder.getPushLabels()),
       family_(builder.getFamily()) {}
 
+NextHop::NextHop(NextHopBuilder&& builder)
+    : ifIndex_(builder.getIfIndex()),
+      gateway_(builder.getGateway()),
+      weight_(builder.getWeight()),
+      labelAction_(builder.getLabelAction()),
+      swapLabel_(builder.getSwapLabel()),
+      pushLabels_(std::move(builder.pushLabels_)),
+      family_(builder.getFamily()) {}
+
 bool
 operator==(const NextHop& lhs, const NextHop& rhs) {
   return lhs.getIfIndex() == rhs.getIfIndex() &&
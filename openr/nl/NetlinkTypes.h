@@ -50,7 +50,12 @@ class NextHopBuilder final {
   NextHopBuilder() {}
   ~NextHopBuilder() {}
 
-  NextHop build() const;
+  NextHop build() const&;
+
+  // rvalue variant relinquishes label storage to the built object instead of
+  // copying it. Invoke as `std::move(builder).build()`. Use reset() before
+  // reusing the builder for the next nexthop.
+  NextHop build() &&;
 
   void reset();
 
@@ -86,6 +91,9 @@ class NextHopBuilder final {
   uint8_t getFamily() const;
 
  private:
+  // allow move-construction of NextHop to steal attribute storage
+  friend class NextHop;
+
   std::optional<int> ifIndex_;
   std::optional<folly::IPAddress> gateway_;
   uint8_t weight_{0}; // default weight is 0
@@ -99,6 +107,7 @@ class NextHopBuilder final {
 class NextHop final {
  public:
   explicit NextHop(const NextHopBuilder& builder);
+  explicit NextHop(NextHopBuilder&& builder);
 
   std::optional<int> getIfIndex() const;
 
@@ -176,7 +185,15 @@ class RouteBuilder {
    * ProtocolId, Destination, Nexthop
    * @throw fbnl::NlException on failed
    */
-  Route build() const;
+  Route build() const&;
+
+  /**
+   * Rvalue variant of build(). Relinquishes the nexthop set and other
+   * attribute storage to the built route instead of copying it. Invoke as
+   * `std::move(builder).build()`. Use reset() before reusing the builder for
+   * the next route.
+   */
+  Route build() &&;
 
   /**
    * Build multicast route
@@ -248,6 +265,8 @@ class RouteBuilder {
 
   RouteBuilder& addNextHop(const NextHop& nextHop);
 
+  RouteBuilder& addNextHop(NextHop&& nextHop);
+
   RouteBuilder& setRouteIfName(const std::string& ifName);
 
   std::optional<std::string> getRouteIfName() const;
@@ -261,9 +280,14 @@ class RouteBuilder {
 
   uint8_t getFamily() const;
 
+  // restore all fields to their defaults so the builder can be reused for
+  // the next route
   void reset();
 
  private:
+  // allow move-construction of Route to steal attribute storage
+  friend class Route;
+
   uint8_t type_{RTN_UNICAST};
   uint8_t routeTable_{RT_TABLE_MAIN};
   uint8_t protocolId_{DEFAULT_PROTOCOL_ID};
@@ -286,6 +310,7 @@ class Route final {
  public:
   Route() {} // Empty constructor
   explicit Route(const RouteBuilder& builder);
+  explicit Route(RouteBuilder&& builder);
   ~Route();
 
   // Copy+Move constructor and assignment operator
@@ -42,6 +42,16 @@ createIfAddress(const int ifIndex, const std::string& addrMask) {
   return builder.build();
 }
 
+fbnl::Neighbor
+createNeighbor(
+    const int ifIndex, const folly::IPAddress& dest, bool isReachable) {
+  fbnl::NeighborBuilder builder;
+  builder.setIfIndex(ifIndex);
+  builder.setDestination(dest);
+  builder.setState(isReachable ? NUD_REACHABLE : NUD_FAILED);
+  return builder.build();
+}
+
 } // namespace utils
 
 folly::SemiFuture<int>
@@ -56,6 +66,17 @@ FakeNetlinkProtocolSocket::addRoute(const fbnl::Route& route) {
   return folly::SemiFuture<int>(0);
 }
 
+std::vector<folly::SemiFuture<int>>
+FakeNetlinkProtocolSocket::addRoutes(const std::vector<fbnl::Route>& routes) {
+  // No message encoding here, so no template fast-path either
+  std::vector<folly::SemiFuture<int>> futures;
+  futures.reserve(routes.size());
+  for (auto const& route : routes) {
+    futures.emplace_back(addRoute(route));
+  }
+  return futures;
+}
+
 folly::SemiFuture<int>
 FakeNetlinkProtocolSocket::deleteRoute(const fbnl::Route& route) {
   // Count number of elements erased
@@ -113,6 +134,16 @@ FakeNetlinkProtocolSocket::getRoutes(const fbnl::Route& filter) {
   return result;
 }
 
+folly::SemiFuture<int>
+FakeNetlinkProtocolSocket::getRoutes(
+    const fbnl::Route& filter, std::function<void(fbnl::Route)> routeCb) {
+  // Reuse the buffering variant and hand routes over one by one
+  for (auto& route : getRoutes(filter).get()) {
+    routeCb(std::move(route));
+  }
+  return folly::SemiFuture<int>(0);
+}
+
 folly::SemiFuture<int>
 FakeNetlinkProtocolSocket::addIfAddress(const fbnl::IfAddress& addr) {
   // Search for addr list of interface index (it must exists)
@@ -140,6 +171,18 @@ FakeNetlinkProtocolSocket::addIfAddress(const fbnl::IfAddress& addr) {
   return folly::SemiFuture<int>(0);
 }
 
+std::vector<folly::SemiFuture<int>>
+FakeNetlinkProtocolSocket::addIfAddresses(
+    const std::vector<fbnl::IfAddress>& ifAddrs) {
+  // No message encoding here, so no upfront batch validation either
+  std::vector<folly::SemiFuture<int>> futures;
+  futures.reserve(ifAddrs.size());
+  for (auto const& ifAddr : ifAddrs) {
+    futures.emplace_back(addIfAddress(ifAddr));
+  }
+  return futures;
+}
+
 folly::SemiFuture<int>
 FakeNetlinkProtocolSocket::deleteIfAddress(const fbnl::IfAddress& addr) {
   // Search for addr list of interface index (it must exists)
@@ -167,6 +210,17 @@ FakeNetlinkProtocolSocket::deleteIfAddress(const fbnl::IfAddress& addr) {
   return folly::SemiFuture<int>(-EADDRNOTAVAIL);
 }
 
+std::vector<folly::SemiFuture<int>>
+FakeNetlinkProtocolSocket::deleteIfAddresses(
+    const std::vector<fbnl::IfAddress>& ifAddrs) {
+  std::vector<folly::SemiFuture<int>> futures;
+  futures.reserve(ifAddrs.size());
+  for (auto const& ifAddr : ifAddrs) {
+    futures.emplace_back(deleteIfAddress(ifAddr));
+  }
+  return futures;
+}
+
 folly::SemiFuture<std::vector<fbnl::IfAddress>>
 FakeNetlinkProtocolSocket::getAllIfAddresses() {
   std::vector<fbnl::IfAddress> addrs;
@@ -201,9 +255,26 @@ FakeNetlinkProtocolSocket::getAllLinks() {
   return folly::SemiFuture<std::vector<fbnl::Link>>(std::move(links));
 }
 
+folly::SemiFuture<int>
+FakeNetlinkProtocolSocket::addNeighbor(const fbnl::Neighbor& neighbor) {
+  // Add or update neighbor
+  neighbors_.insert_or_assign(neighbor.getDestination(), neighbor);
+
+  // Send neighbor event
+  if (neighborEventCB_) {
+    neighborEventCB_(neighbor, true);
+  }
+
+  return folly::SemiFuture<int>(0);
+}
+
 folly::SemiFuture<std::vector<fbnl::Neighbor>>
 FakeNetlinkProtocolSocket::getAllNeighbors() {
-  CHECK(false) << "Not implemented";
+  std::vector<fbnl::Neighbor> neighbors;
+  for (auto& [_, neighbor] : neighbors_) {
+    neighbors.emplace_back(neighbor);
+  }
+  return folly::SemiFuture<std::vector<fbnl::Neighbor>>(std::move(neighbors));
 }
 
 } // namespace openr::fbnl
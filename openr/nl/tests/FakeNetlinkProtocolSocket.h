@@ -28,6 +28,9 @@ fbnl::Link createLink(
 
 fbnl::IfAddress createIfAddress(const int ifIndex, const std::string& addrMask);
 
+fbnl::Neighbor createNeighbor(
+    const int ifIndex, const folly::IPAddress& dest, bool isReachable);
+
 } // namespace utils
 
 /**
@@ -48,17 +51,32 @@ class FakeNetlinkProtocolSocket : public NetlinkProtocolSocket {
    */
   folly::SemiFuture<int> addLink(const fbnl::Link& link);
 
+  /**
+   * API to create/update a neighbor entry for testing purposes. Fires the
+   * registered neighbor event callback the way a kernel notification would
+   */
+  folly::SemiFuture<int> addNeighbor(const fbnl::Neighbor& neighbor);
+
   /**
    * Overrides API of NetlinkProtocolSocket for testing
    */
 
   folly::SemiFuture<int> addRoute(const fbnl::Route& route) override;
+  std::vector<folly::SemiFuture<int>> addRoutes(
+      const std::vector<fbnl::Route>& routes) override;
   folly::SemiFuture<int> deleteRoute(const fbnl::Route& route) override;
   folly::SemiFuture<std::vector<fbnl::Route>> getRoutes(
       const fbnl::Route& filter) override;
+  folly::SemiFuture<int> getRoutes(
+      const fbnl::Route& filter,
+      std::function<void(fbnl::Route)> routeCb) override;
 
   folly::SemiFuture<int> addIfAddress(const fbnl::IfAddress&) override;
+  std::vector<folly::SemiFuture<int>> addIfAddresses(
+      const std::vector<fbnl::IfAddress>& ifAddrs) override;
   folly::SemiFuture<int> deleteIfAddress(const fbnl::IfAddress&) override;
+  std::vector<folly::SemiFuture<int>> deleteIfAddresses(
+      const std::vector<fbnl::IfAddress>& ifAddrs) override;
   folly::SemiFuture<std::vector<fbnl::IfAddress>> getAllIfAddresses() override;
 
   folly::SemiFuture<std::vector<fbnl::Link>> getAllLinks() override;
@@ -80,6 +98,10 @@ class FakeNetlinkProtocolSocket : public NetlinkProtocolSocket {
   // NOTE: using map for ordered entries
   std::map<int, std::list<fbnl::IfAddress>> ifAddrs_;
 
+  // map<destination -> Neighbor>
+  // NOTE: using map for ordered entries
+  std::map<folly::IPAddress, fbnl::Neighbor> neighbors_;
+
   // map<protocolId -> map<prefix/label, Route>
   // NOTE: using map for ordered entries
   std::unordered_map<uint8_t, std::map<folly::CIDRNetwork, fbnl::Route>>
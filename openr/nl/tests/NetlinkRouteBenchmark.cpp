@@ -0,0 +1,292 @@
+/**
+ * Copyright (c) 2014-present, Facebook, Inc.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <sys/resource.h>
+
+#include <fb303/ServiceData.h>
+#include <folly/Benchmark.h>
+#include <folly/Format.h>
+#include <folly/IPAddress.h>
+#include <folly/Subprocess.h>
+#include <folly/init/Init.h>
+#include <folly/io/async/EventBase.h>
+#include <folly/system/Shell.h>
+
+#include <openr/common/NetworkUtil.h>
+#include <openr/common/Util.h>
+#include <openr/nl/NetlinkProtocolSocket.h>
+#include <openr/platform/NetlinkFibHandler.h>
+
+extern "C" {
+#include <net/if.h>
+}
+
+using namespace openr;
+using namespace folly::literals::shell_literals;
+
+using openr::fbnl::NetlinkProtocolSocket;
+
+namespace {
+// Virtual interface pair acting as the outgoing links for synthetic routes
+const std::string kVethNameX("vethBenchX");
+const std::string kVethNameY("vethBenchY");
+
+// Gateway address assigned to vethBenchY, reachable over vethBenchX
+const folly::IPAddress kGatewayV6{"fe80::b01"};
+
+// Protocol-ID for routes programmed via direct NetlinkProtocolSocket path
+const uint8_t kRouteProtoId = 99;
+const uint32_t kRouteProtoIdPriority = 10;
+
+// Client-ID for routes programmed via NetlinkFibHandler thrift path
+const int16_t kFibId{static_cast<int16_t>(openr::thrift::FibClient::OPENR)};
+
+int64_t
+getMaxRssKb() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+} // namespace
+
+namespace openr {
+
+/**
+ * Creates a veth pair and a NetlinkProtocolSocket talking to the real kernel.
+ * Benchmarks program synthetic /64 routes pointing out of the veth. Requires
+ * root privileges - benchmarks are skipped otherwise.
+ */
+class NetlinkRouteFixture {
+ public:
+  NetlinkRouteFixture() {
+    CHECK_EQ(0, getuid()) << "Must run this benchmark as root";
+
+    // Cleanup old interfaces if any
+    auto cmd = "ip link del {} 2>/dev/null"_shellify(kVethNameX.c_str());
+    folly::Subprocess proc(std::move(cmd));
+    proc.wait(); // Ignore result
+
+    // Add veth interface pair
+    cmd = "ip link add {} type veth peer name {}"_shellify(
+        kVethNameX.c_str(), kVethNameY.c_str());
+    folly::Subprocess proc1(std::move(cmd));
+    CHECK_EQ(0, proc1.wait().exitStatus());
+
+    // Assign gateway address and bring up both ends
+    cmd = "ip addr add {}/64 dev {}"_shellify(
+        kGatewayV6.str().c_str(), kVethNameY.c_str());
+    folly::Subprocess proc2(std::move(cmd));
+    CHECK_EQ(0, proc2.wait().exitStatus());
+    for (const auto& ifName : {kVethNameX, kVethNameY}) {
+      cmd = "ip link set dev {} up"_shellify(ifName.c_str());
+      folly::Subprocess proc3(std::move(cmd));
+      CHECK_EQ(0, proc3.wait().exitStatus());
+    }
+
+    // Create netlink protocol socket and start event thread
+    nlSock = std::make_unique<NetlinkProtocolSocket>(&evb);
+    eventThread = std::thread([&]() { evb.loopForever(); });
+    evb.waitUntilRunning();
+
+    // Create thrift handler on top of the same socket
+    fibHandler = std::make_unique<NetlinkFibHandler>(nlSock.get());
+
+    // Find ifIndex of vethBenchX
+    for (const auto& link : nlSock->getAllLinks().get()) {
+      if (link.getLinkName() == kVethNameX) {
+        ifIndexX = link.getIfIndex();
+      }
+    }
+    CHECK_NE(ifIndexX, 0);
+  }
+
+  ~NetlinkRouteFixture() {
+    fibHandler.reset();
+    evb.terminateLoopSoon();
+    eventThread.join();
+    nlSock.reset();
+
+    // Cleanup virtual interfaces. Kernel flushes routes over them
+    auto cmd = "ip link del {} 2>/dev/null"_shellify(kVethNameX.c_str());
+    folly::Subprocess proc(std::move(cmd));
+    proc.wait(); // Ignore result
+  }
+
+  // Build `count` synthetic v6 routes with one gateway nexthop each. All
+  // routes share attributes and nexthops, exercising the addRoutes()
+  // template fast-path just like Fib sync does
+  std::vector<fbnl::Route>
+  buildRoutes(uint32_t count) const {
+    fbnl::NextHopBuilder nhBuilder;
+    nhBuilder.setGateway(kGatewayV6);
+    nhBuilder.setIfIndex(ifIndexX);
+    const auto path = nhBuilder.build();
+
+    std::vector<fbnl::Route> routes;
+    routes.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+      fbnl::RouteBuilder rtBuilder;
+      rtBuilder.setDestination(prefixAt(i));
+      rtBuilder.setProtocolId(kRouteProtoId);
+      rtBuilder.setPriority(kRouteProtoIdPriority);
+      rtBuilder.setFlags(0);
+      rtBuilder.setValid(true);
+      rtBuilder.addNextHop(path);
+      routes.emplace_back(std::move(rtBuilder).build());
+    }
+    return routes;
+  }
+
+  // Same synthetic routes in thrift representation for the handler path
+  std::unique_ptr<std::vector<thrift::UnicastRoute>>
+  buildThriftRoutes(uint32_t count) const {
+    std::vector<thrift::NextHopThrift> paths;
+    paths.emplace_back(
+        createNextHop(toBinaryAddress(kGatewayV6), kVethNameX));
+
+    auto routes = std::make_unique<std::vector<thrift::UnicastRoute>>();
+    routes->reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+      routes->emplace_back(createUnicastRoute(toIpPrefix(prefixAt(i)), paths));
+    }
+    return routes;
+  }
+
+  void
+  addRoutes(const std::vector<fbnl::Route>& routes) {
+    NetlinkProtocolSocket::collectReturnStatus(
+        nlSock->addRoutes(routes), {EEXIST})
+        .get();
+  }
+
+  void
+  deleteRoutes(const std::vector<fbnl::Route>& routes) {
+    std::vector<folly::SemiFuture<int>> futures;
+    futures.reserve(routes.size());
+    for (const auto& route : routes) {
+      futures.emplace_back(nlSock->deleteRoute(route));
+    }
+    NetlinkProtocolSocket::collectReturnStatus(std::move(futures), {ESRCH})
+        .get();
+  }
+
+  folly::EventBase evb;
+  std::unique_ptr<NetlinkProtocolSocket> nlSock;
+  std::unique_ptr<NetlinkFibHandler> fibHandler;
+  std::thread eventThread;
+  uint32_t ifIndexX{0};
+
+ private:
+  static folly::CIDRNetwork
+  prefixAt(uint32_t i) {
+    // 2401:db00:<i>::/64
+    return folly::IPAddress::createNetwork(
+        folly::sformat("2401:db00:{:x}::/64", i));
+  }
+};
+
+/**
+ * Measure sustained route programming throughput of the direct
+ * NetlinkProtocolSocket path. Routes/sec = numRoutes / (time-per-iter / 2)
+ * as each iteration programs and withdraws the full set
+ */
+static void
+BM_NetlinkProtocolSocketRoutes(uint32_t iters, uint32_t numRoutes) {
+  auto suspender = folly::BenchmarkSuspender();
+  auto fixture = std::make_unique<NetlinkRouteFixture>();
+  auto routes = fixture->buildRoutes(numRoutes);
+  suspender.dismiss(); // Start measuring benchmark time
+
+  for (uint32_t i = 0; i < iters; i++) {
+    fixture->addRoutes(routes);
+    fixture->deleteRoutes(routes);
+  }
+
+  suspender.rehire();
+  fixture.reset();
+}
+
+/**
+ * Measure the same programming cycle through the NetlinkFibHandler thrift
+ * path, including thrift <-> netlink route conversions and the shadow-table
+ * bookkeeping
+ */
+static void
+BM_NetlinkFibHandlerRoutes(uint32_t iters, uint32_t numRoutes) {
+  auto suspender = folly::BenchmarkSuspender();
+  auto fixture = std::make_unique<NetlinkRouteFixture>();
+  suspender.dismiss(); // Start measuring benchmark time
+
+  for (uint32_t i = 0; i < iters; i++) {
+    fixture->fibHandler
+        ->semifuture_addUnicastRoutes(
+            kFibId, fixture->buildThriftRoutes(numRoutes))
+        .get();
+    // Withdraw via empty syncFib - deletes all routes of the client
+    fixture->fibHandler
+        ->semifuture_syncFib(
+            kFibId, std::make_unique<std::vector<thrift::UnicastRoute>>())
+        .get();
+  }
+
+  suspender.rehire();
+  fixture.reset();
+}
+
+// The parameter is the number of routes programmed and withdrawn per iter
+BENCHMARK_PARAM(BM_NetlinkProtocolSocketRoutes, 10000);
+BENCHMARK_PARAM(BM_NetlinkProtocolSocketRoutes, 100000);
+BENCHMARK_PARAM(BM_NetlinkProtocolSocketRoutes, 1000000);
+BENCHMARK_PARAM(BM_NetlinkFibHandlerRoutes, 10000);
+BENCHMARK_PARAM(BM_NetlinkFibHandlerRoutes, 100000);
+BENCHMARK_PARAM(BM_NetlinkFibHandlerRoutes, 1000000);
+
+/**
+ * One-shot report of memory overhead per in-flight route and the netlink
+ * request latency counters accumulated over the benchmark runs
+ */
+void
+reportMemoryAndLatency(uint32_t numRoutes) {
+  facebook::fb303::fbData->resetAllData();
+  auto fixture = std::make_unique<NetlinkRouteFixture>();
+
+  const auto rssBeforeKb = getMaxRssKb();
+  auto routes = fixture->buildRoutes(numRoutes);
+  fixture->addRoutes(routes);
+  const auto rssAfterKb = getMaxRssKb();
+  LOG(INFO) << "Programmed " << numRoutes << " routes. maxrss "
+            << rssBeforeKb << "KB -> " << rssAfterKb << "KB, "
+            << (1024.0 * (rssAfterKb - rssBeforeKb) / numRoutes)
+            << " bytes/route";
+
+  fixture->deleteRoutes(routes);
+
+  // Ack latency & request counters maintained by NetlinkProtocolSocket
+  for (auto const& [key, value] : facebook::fb303::fbData->getCounters()) {
+    if (key.find("netlink.requests") != std::string::npos) {
+      LOG(INFO) << "  " << key << " : " << value;
+    }
+  }
+}
+
+} // namespace openr
+
+int
+main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  if (getuid()) {
+    LOG(WARNING) << "Skipping benchmarks. Must run as root";
+    return 0;
+  }
+  folly::runBenchmarks();
+  openr::reportMemoryAndLatency(100000);
+  return 0;
+}
@@ -6,6 +6,7 @@
  */
 
 #include <fbzmq/async/StopEventLoopSignalHandler.h>
+#include <fbzmq/async/ZmqTimeout.h>
 #include <fbzmq/zmq/Zmq.h>
 #include <folly/init/Init.h>
 #include <folly/io/async/EventBase.h>
@@ -35,6 +36,12 @@ DEFINE_bool(
     enable_netlink_system_handler,
     true,
     "If set, netlink system handler will be started");
+DEFINE_int32(
+    fib_audit_interval_s,
+    300,
+    "Interval in seconds between kernel route audits. Each audit streams "
+    "the kernel table and reconciles it against programmed routes. 0 "
+    "disables auditing.");
 
 using openr::NetlinkFibHandler;
 using openr::NetlinkSystemHandler;
@@ -92,10 +99,25 @@ main(int argc, char** argv) {
   }
 
   apache::thrift::ThriftServer linuxFibAgentServer;
+  std::unique_ptr<fbzmq::ZmqTimeout> fibAuditTimer;
   if (FLAGS_enable_netlink_fib_handler) {
     // start FibService thread
     auto fibHandler = std::make_shared<NetlinkFibHandler>(nlSock.get());
 
+    if (FLAGS_fib_audit_interval_s > 0) {
+      // periodically reconcile kernel routes with what the handler believes
+      // it programmed. Timer lives on the netlink event base, so create and
+      // arm it from that thread
+      nlEvb->runInEventBaseThreadAndWait([&fibAuditTimer, &nlEvb, fibHandler] {
+        fibAuditTimer = fbzmq::ZmqTimeout::make(
+            nlEvb.get(),
+            [fibHandler]() noexcept { fibHandler->auditKernelRoutes(); });
+        fibAuditTimer->scheduleTimeout(
+            std::chrono::seconds(FLAGS_fib_audit_interval_s),
+            true /* isPeriodic */);
+      });
+    }
+
     auto fibThriftThread = std::thread([fibHandler, &linuxFibAgentServer]() {
       folly::setThreadName("FibService");
       linuxFibAgentServer.setNWorkerThreads(1);
@@ -115,6 +137,12 @@ main(int argc, char** argv) {
   mainEventLoop.run();
   LOG(INFO) << "Main event loop stopped.";
 
+  if (fibAuditTimer) {
+    // destroy on its event base before the loop is stopped
+    nlEvb->runInEventBaseThreadAndWait(
+        [&fibAuditTimer] { fibAuditTimer.reset(); });
+  }
+
   nlEvb->terminateLoopSoon();
 
   if (FLAGS_enable_netlink_fib_handler) {
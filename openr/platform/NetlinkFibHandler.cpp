@@ -10,11 +10,14 @@
 #include <algorithm>
 #include <functional>
 #include <iterator>
+#include <map>
 #include <thread>
 #include <utility>
 
 #include <folly/Format.h>
+#include <folly/executors/InlineExecutor.h>
 #include <folly/gen/Base.h>
+#include <folly/hash/Hash.h>
 
 #include <openr/common/NetworkUtil.h>
 #include <openr/common/Util.h>
@@ -40,6 +43,19 @@ createSemiFutureWithClientIdError() {
   return std::move(sf);
 }
 
+// true if the protocol id belongs to one of the clients this handler
+// programs routes for
+bool
+isClientProtocol(uint8_t protocolId) {
+  for (auto const& [_, protocol] :
+       thrift::Platform_constants::clientIdtoProtocolId()) {
+    if (protocol == protocolId) {
+      return true;
+    }
+  }
+  return false;
+}
+
 } // namespace
 
 NetlinkFibHandler::NetlinkFibHandler(fbnl::NetlinkProtocolSocket* nlSock)
@@ -51,6 +67,14 @@ NetlinkFibHandler::NetlinkFibHandler(fbnl::NetlinkProtocolSocket* nlSock)
   // NOTE: This will mask off neighbor events publisher. It is okay because as
   // of now no one is using Neighbor Events.
   nlSock_->setNeighborEventCB([this](fbnl::Neighbor neighbor, bool) {
+    // keep the reachability cache current and program any deferred routes
+    // this neighbor unblocks, then fan out to registered listeners
+    const auto destination = neighbor.getDestination();
+    const bool isReachable = neighbor.isReachable();
+    neighborCache_.wlock()->insert_or_assign(destination, isReachable);
+    if (isReachable) {
+      retryUnresolvedRoutes(destination);
+    }
     std::lock_guard<std::mutex> g(listenersMutex_);
     for (auto& listener : listeners_.accessAllThreads()) {
       LOG(INFO) << "Sending notification to bgpD";
@@ -117,6 +141,209 @@ NetlinkFibHandler::collectAllResult(
       });
 }
 
+std::size_t
+NetlinkFibHandler::routeSignature(const fbnl::Route& route) {
+  // combine nexthop hashes commutatively as NextHopSet order is unspecified
+  std::size_t nhDigest{0};
+  for (auto const& nh : route.getNextHops()) {
+    nhDigest += fbnl::NextHopHash()(nh);
+  }
+  return folly::hash::hash_combine(
+      nhDigest,
+      route.getProtocolId(),
+      route.getType(),
+      route.getPriority().value_or(0),
+      route.getFlags().value_or(0));
+}
+
+folly::SemiFuture<int>
+NetlinkFibHandler::recordRouteProgrammed(
+    folly::SemiFuture<int>&& future, const fbnl::Route& route) {
+  return std::move(future).deferValue(
+      [this,
+       dst = route.getDestination(),
+       signature = routeSignature(route)](int retval) {
+        // EEXIST means identical route is already in kernel - also good
+        if (retval == 0 or std::abs(retval) == EEXIST) {
+          programmedRoutes_.wlock()->insert_or_assign(dst, signature);
+        }
+        return retval;
+      });
+}
+
+folly::SemiFuture<folly::Unit>
+NetlinkFibHandler::auditKernelRoutes() {
+  // collect kernel state for client protocols as the streaming dump
+  // progresses. The callback runs on the netlink thread; fulfillment of the
+  // dump future synchronizes with all callback invocations
+  auto kernelRoutes =
+      std::make_shared<std::unordered_map<folly::CIDRNetwork, std::size_t>>();
+  auto future =
+      nlSock_
+          ->getAllRoutes([kernelRoutes](fbnl::Route route) {
+            // shadow table tracks unicast routes only
+            if (route.getFamily() == AF_MPLS) {
+              return;
+            }
+            if (not isClientProtocol(route.getProtocolId())) {
+              return;
+            }
+            kernelRoutes->insert_or_assign(
+                route.getDestination(), routeSignature(route));
+          })
+          // attach the comparison on an inline executor instead of deferring
+          // it, so a caller dropping the returned future (periodic
+          // fire-and-forget audits) does not abandon the work
+          .via(&folly::InlineExecutor::instance())
+          .thenValue([this, kernelRoutes](int err) {
+            if (err != 0) {
+              LOG(ERROR) << "Kernel route audit dump failed with error "
+                         << err;
+              return folly::Unit();
+            }
+            std::vector<folly::CIDRNetwork> divergedPrefixes;
+            std::size_t numKernelOnly{0};
+            std::size_t numVerified{0};
+            {
+              auto programmed = programmedRoutes_.wlock();
+              // kernel routes we never programmed; counted before diverged
+              // entries are erased below so they are not double reported
+              for (auto const& [prefix, _] : *kernelRoutes) {
+                if (not programmed->count(prefix)) {
+                  ++numKernelOnly;
+                }
+              }
+              for (auto it = programmed->begin(); it != programmed->end();) {
+                auto kernelIt = kernelRoutes->find(it->first);
+                if (kernelIt == kernelRoutes->end() or
+                    kernelIt->second != it->second) {
+                  divergedPrefixes.emplace_back(it->first);
+                  it = programmed->erase(it);
+                } else {
+                  ++numVerified;
+                  ++it;
+                }
+              }
+            }
+            for (auto const& prefix : divergedPrefixes) {
+              LOG(WARNING)
+                  << "Route audit: kernel state for "
+                  << folly::IPAddress::networkToString(prefix)
+                  << " diverged from what we programmed. Dropping shadow "
+                  << "entry so the next programming attempt is not skipped";
+            }
+            if (numKernelOnly) {
+              // alarm only - these may be operator installed or predate us,
+              // deleting them here would be more disruptive than the drift
+              LOG(WARNING) << "Route audit: " << numKernelOnly
+                           << " kernel routes in client protocol range have "
+                           << "no shadow entry";
+            }
+            if (divergedPrefixes.empty() and not numKernelOnly) {
+              VLOG(1) << "Route audit: kernel consistent, " << numVerified
+                      << " programmed routes verified";
+            }
+            return folly::Unit();
+          });
+  return std::move(future).semi();
+}
+
+void
+NetlinkFibHandler::initializeNeighborCache() noexcept {
+  if (neighborCacheInitialized_.exchange(true)) {
+    return;
+  }
+  try {
+    auto neighbors = nlSock_->getAllNeighbors().get();
+    auto cache = neighborCache_.wlock();
+    for (auto& neighbor : neighbors) {
+      // emplace only - concurrently received events are fresher than the dump
+      cache->emplace(neighbor.getDestination(), neighbor.isReachable());
+    }
+  } catch (const std::exception& e) {
+    // an empty cache only disables deferral, programming proceeds as before
+    LOG(ERROR) << "Failed to seed neighbor cache: " << folly::exceptionStr(e);
+  }
+}
+
+bool
+NetlinkFibHandler::hasUsableNextHop(const fbnl::Route& route) {
+  bool sawGateway{false};
+  auto cache = neighborCache_.rlock();
+  for (const auto& nh : route.getNextHops()) {
+    const auto gateway = nh.getGateway();
+    if (not gateway.has_value()) {
+      // interface route - nothing to resolve
+      return true;
+    }
+    sawGateway = true;
+    auto it = cache->find(gateway.value());
+    if (it == cache->end() or it->second) {
+      // unknown or reachable gateway
+      return true;
+    }
+  }
+  return not sawGateway;
+}
+
+std::size_t
+NetlinkFibHandler::deferUnresolvedRoutes(std::vector<fbnl::Route>& routes) {
+  // NOTE: may block on the seeding kernel dump on first use; only called
+  // from thrift handler threads, never from the netlink event thread
+  initializeNeighborCache();
+
+  std::vector<fbnl::Route> usable;
+  usable.reserve(routes.size());
+  std::size_t numDeferred{0};
+  auto deferred = unresolvedRoutes_.wlock();
+  for (auto& route : routes) {
+    const auto dst = route.getDestination();
+    if (hasUsableNextHop(route)) {
+      // a programmable update supersedes any deferred copy of the prefix
+      deferred->erase(dst);
+      usable.emplace_back(std::move(route));
+    } else {
+      ++numDeferred;
+      deferred->insert_or_assign(dst, std::move(route));
+    }
+  }
+  routes = std::move(usable);
+  return numDeferred;
+}
+
+void
+NetlinkFibHandler::retryUnresolvedRoutes(const folly::IPAddress& neighbor) {
+  // pull out deferred routes that became programmable
+  std::vector<fbnl::Route> routes;
+  {
+    auto deferred = unresolvedRoutes_.wlock();
+    for (auto it = deferred->begin(); it != deferred->end();) {
+      if (hasUsableNextHop(it->second)) {
+        routes.emplace_back(std::move(it->second));
+        it = deferred->erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  if (routes.empty()) {
+    return;
+  }
+
+  LOG(INFO) << "Neighbor " << neighbor.str() << " resolved. Programming "
+            << routes.size() << " deferred routes";
+  auto futures = nlSock_->addRoutes(routes);
+  for (std::size_t i = 0; i < futures.size(); ++i) {
+    futures[i] = recordRouteProgrammed(std::move(futures[i]), routes[i]);
+  }
+  // fire-and-forget: completions run inline on the netlink thread. Routes
+  // that still fail stay out of the shadow table and get re-programmed by
+  // the next Fib sync
+  folly::collectAll(std::move(futures))
+      .via(&folly::InlineExecutor::instance())
+      .thenValue([](std::vector<folly::Try<int>>&&) {});
+}
+
 folly::SemiFuture<folly::Unit>
 NetlinkFibHandler::semifuture_addUnicastRoute(
     int16_t clientId, std::unique_ptr<thrift::UnicastRoute> route) {
@@ -145,12 +372,43 @@ NetlinkFibHandler::semifuture_addUnicastRoutes(
   LOG(INFO) << "Adding/Updating unicast routes of client "
             << getClientName(clientId) << ", numRoutes=" << routes->size();
 
-  // Add routes and return a collected semifuture
-  std::vector<folly::SemiFuture<int>> result;
-  for (auto& route : *routes) {
-    result.emplace_back(nlSock_->addRoute(buildRoute(route, protocol.value())));
+  // Batch-convert all route objects upfront so consecutive routes with
+  // identical nexthops can share a pre-encoded message template. Routes
+  // whose identical copy is already programmed are skipped - during sync
+  // retries the whole batch can be a no-op.
+  auto builtRoutes = buildRoutes(*routes, protocol.value());
+  std::vector<fbnl::Route> nlRoutes;
+  nlRoutes.reserve(builtRoutes.size());
+  std::size_t numSkipped{0};
+  {
+    auto shadow = programmedRoutes_.rlock();
+    for (auto& nlRoute : builtRoutes) {
+      auto it = shadow->find(nlRoute.getDestination());
+      if (it != shadow->end() and it->second == routeSignature(nlRoute)) {
+        ++numSkipped;
+        continue;
+      }
+      nlRoutes.emplace_back(std::move(nlRoute));
+    }
   }
-  return collectAllResult(std::move(result), {EEXIST});
+  if (numSkipped) {
+    VLOG(1) << "Skipped " << numSkipped << " already programmed routes";
+  }
+
+  // Hold back routes whose every gateway is known-unreachable; they are
+  // programmed from the neighbor event callback once ARP/NDP resolves
+  if (const auto numDeferred = deferUnresolvedRoutes(nlRoutes)) {
+    VLOG(1) << "Deferred " << numDeferred
+            << " routes with unresolved nexthops";
+  }
+
+  // Add routes, record acked ones in the shadow table and return a collected
+  // semifuture
+  auto futures = nlSock_->addRoutes(nlRoutes);
+  for (std::size_t i = 0; i < futures.size(); ++i) {
+    futures[i] = recordRouteProgrammed(std::move(futures[i]), nlRoutes[i]);
+  }
+  return collectAllResult(std::move(futures), {EEXIST});
 }
 
 folly::SemiFuture<folly::Unit>
@@ -166,11 +424,19 @@ NetlinkFibHandler::semifuture_deleteUnicastRoutes(
 
   // Delete routes and return a collected semifuture
   std::vector<folly::SemiFuture<int>> result;
-  for (auto& prefix : *prefixes) {
-    fbnl::RouteBuilder rtBuilder;
-    rtBuilder.setDestination(toIPNetwork(prefix));
-    rtBuilder.setProtocolId(protocol.value());
-    result.emplace_back(nlSock_->deleteRoute(rtBuilder.build()));
+  {
+    auto shadow = programmedRoutes_.wlock();
+    auto deferred = unresolvedRoutes_.wlock();
+    for (auto& prefix : *prefixes) {
+      fbnl::RouteBuilder rtBuilder;
+      rtBuilder.setDestination(toIPNetwork(prefix));
+      rtBuilder.setProtocolId(protocol.value());
+      // conservatively drop the shadow entry regardless of delete outcome
+      // and make sure a deferred copy can't be resurrected later
+      shadow->erase(rtBuilder.getDestination());
+      deferred->erase(rtBuilder.getDestination());
+      result.emplace_back(nlSock_->deleteRoute(rtBuilder.build()));
+    }
   }
   return collectAllResult(std::move(result), {ESRCH});
 }
@@ -186,13 +452,23 @@ NetlinkFibHandler::semifuture_addMplsRoutes(
   LOG(INFO) << "Adding/Updating mpls routes of client "
             << getClientName(clientId) << ", numRoutes=" << routes->size();
 
-  // Add routes and return a collected semifuture
-  std::vector<folly::SemiFuture<int>> result;
+  // Build all route objects upfront and order them by top label. Adjacency
+  // labels are allocated as contiguous per-interface ranges, so sorting
+  // groups the label block of each interface into one run sharing nexthops,
+  // which addRoutes() encodes once and replays per label. Label routes are
+  // independent keys, hence reordering is safe.
+  std::vector<fbnl::Route> nlRoutes;
+  nlRoutes.reserve(routes->size());
   for (auto& route : *routes) {
-    result.emplace_back(
-        nlSock_->addRoute(buildMplsRoute(route, protocol.value())));
+    nlRoutes.emplace_back(buildMplsRoute(route, protocol.value()));
   }
-  return collectAllResult(std::move(result), {EEXIST});
+  std::sort(
+      nlRoutes.begin(), nlRoutes.end(), [](auto const& lhs, auto const& rhs) {
+        return lhs.getMplsLabel() < rhs.getMplsLabel();
+      });
+
+  // Add routes and return a collected semifuture
+  return collectAllResult(nlSock_->addRoutes(nlRoutes), {EEXIST});
 }
 
 folly::SemiFuture<folly::Unit>
@@ -233,36 +509,54 @@ NetlinkFibHandler::semifuture_syncFib(
   std::vector<folly::SemiFuture<int>> result;
 
   // Create set of existing route
-  // NOTE: Synchronous call to retrieve all the routes. We first make both
-  // requests to retrieve IPv4 and IPv6 routes. Subsequently we wait on them
-  // to complete and prepare the map of existing routes
+  // NOTE: Routes are streamed into the map as the kernel dump progresses.
+  // This avoids materializing an intermediate vector of all the routes. We
+  // first make both requests to retrieve IPv4 and IPv6 routes. Subsequently
+  // we wait on them to complete. Callback invocations are serialized on the
+  // netlink event-base thread and synchronize with future completion.
   std::unordered_map<folly::CIDRNetwork, fbnl::Route> existingRoutes;
   {
-    auto v4Routes = nlSock_->getIPv4Routes(protocol.value());
-    auto v6Routes = nlSock_->getIPv6Routes(protocol.value());
-    for (auto& route : std::move(v4Routes).get()) {
+    auto routeCb = [&existingRoutes](fbnl::Route route) {
       const auto prefix = route.getDestination();
       existingRoutes.emplace(prefix, std::move(route));
-    }
-    for (auto& route : std::move(v6Routes).get()) {
-      const auto prefix = route.getDestination();
-      existingRoutes.emplace(prefix, std::move(route));
-    }
+    };
+    auto v4Done = nlSock_->getIPv4Routes(protocol.value(), routeCb);
+    auto v6Done = nlSock_->getIPv6Routes(protocol.value(), routeCb);
+    std::move(v4Done).get();
+    std::move(v6Done).get();
   }
 
-  // Go over the new routes. Add or update
+  // Go over the new routes, batch-converted upfront. Add or update
+  initializeNeighborCache();
   std::unordered_set<folly::CIDRNetwork> newPrefixes;
-  for (auto& route : *unicastRoutes) {
-    const auto network = toIPNetwork(route.dest);
+  for (auto& nlRoute : buildRoutes(*unicastRoutes, protocol.value())) {
+    const auto network = nlRoute.getDestination();
     newPrefixes.insert(network);
-    auto nlRoute = buildRoute(route, protocol.value());
     auto it = existingRoutes.find(network);
     if (it != existingRoutes.end() and it->second == nlRoute) {
       // Existing route is same as the one we're trying to add. SKIP
+      // Record it in the shadow table - the kernel dump confirms it
+      programmedRoutes_.wlock()->insert_or_assign(
+          network, routeSignature(nlRoute));
+      continue;
+    }
+    if (not hasUsableNextHop(nlRoute)) {
+      // defer programming - an unresolved nexthop blackholes the traffic
+      // anyway, and any pre-existing kernel route keeps forwarding
+      unresolvedRoutes_.wlock()->insert_or_assign(network, std::move(nlRoute));
       continue;
     }
     // Add new route or replace existing one
-    result.emplace_back(nlSock_->addRoute(nlRoute));
+    result.emplace_back(
+        recordRouteProgrammed(nlSock_->addRoute(nlRoute), nlRoute));
+  }
+
+  // Drop deferred routes that this sync no longer wants
+  {
+    auto deferred = unresolvedRoutes_.wlock();
+    for (auto it = deferred->begin(); it != deferred->end();) {
+      it = newPrefixes.count(it->first) ? std::next(it) : deferred->erase(it);
+    }
   }
 
   // Go over the old routes to remove stale ones
@@ -272,6 +566,7 @@ NetlinkFibHandler::semifuture_syncFib(
       continue;
     }
     // Delete stale route
+    programmedRoutes_.wlock()->erase(prefix);
     result.emplace_back(nlSock_->deleteRoute(nlRoute));
   }
 
@@ -297,12 +592,17 @@ NetlinkFibHandler::semifuture_syncMplsFib(
   std::vector<folly::SemiFuture<int>> result;
 
   // Create set of existing route
-  // NOTE: Synchronous call to retrieve all the routes
+  // NOTE: Synchronous call to retrieve all the routes. Routes are streamed
+  // into the map as the kernel dump progresses.
   std::unordered_map<int32_t, fbnl::Route> existingRoutes;
-  for (auto& route : nlSock_->getMplsRoutes(protocol.value()).get()) {
-    const auto topLabel = route.getMplsLabel().value();
-    existingRoutes.emplace(topLabel, std::move(route));
-  }
+  nlSock_
+      ->getMplsRoutes(
+          protocol.value(),
+          [&existingRoutes](fbnl::Route route) {
+            const auto topLabel = route.getMplsLabel().value();
+            existingRoutes.emplace(topLabel, std::move(route));
+          })
+      .get();
 
   // Go over the new routes. Add or update
   std::unordered_set<uint32_t> newLabels;
@@ -357,23 +657,24 @@ NetlinkFibHandler::semifuture_getRouteTableByClient(int16_t clientId) {
   CHECK(protocol.has_value());
   LOG(INFO) << "Get unicast routes for client " << getClientName(clientId);
 
-  auto v4Routes = nlSock_->getIPv4Routes(protocol.value());
-  auto v6Routes = nlSock_->getIPv6Routes(protocol.value());
-  return folly::collectAll(std::move(v4Routes), std::move(v6Routes))
-      .deferValue([this](std::tuple<
-                         folly::Try<std::vector<fbnl::Route>>,
-                         folly::Try<std::vector<fbnl::Route>>>&& res) {
-        auto routes = std::make_unique<std::vector<thrift::UnicastRoute>>();
-        for (auto& nlRoutes : {std::get<0>(res), std::get<1>(res)}) {
-          for (auto& nlRoute : nlRoutes.value()) {
-            thrift::UnicastRoute route;
-            route.dest = toIpPrefix(nlRoute.getDestination());
-            route.nextHops = toThriftNextHops(nlRoute.getNextHops());
-            routes->emplace_back(std::move(route));
-          }
-        }
-        return routes;
-      });
+  // Stream received routes straight into their thrift representation. This
+  // avoids buffering the entire fbnl::Route dump in memory.
+  auto routes = std::make_unique<std::vector<thrift::UnicastRoute>>();
+  auto* routesPtr = routes.get();
+  auto routeCb = [this, routesPtr](fbnl::Route nlRoute) {
+    thrift::UnicastRoute route;
+    route.dest = toIpPrefix(nlRoute.getDestination());
+    route.nextHops = toThriftNextHops(nlRoute.getNextHops());
+    routesPtr->emplace_back(std::move(route));
+  };
+  auto v4Done = nlSock_->getIPv4Routes(protocol.value(), routeCb);
+  auto v6Done = nlSock_->getIPv6Routes(protocol.value(), routeCb);
+  return folly::collectAll(std::move(v4Done), std::move(v6Done))
+      .deferValue(
+          [routes = std::move(routes)](
+              std::tuple<folly::Try<int>, folly::Try<int>>&&) mutable {
+            return std::move(routes);
+          });
 }
 
 folly::SemiFuture<std::unique_ptr<std::vector<openr::thrift::MplsRoute>>>
@@ -386,17 +687,21 @@ NetlinkFibHandler::semifuture_getMplsRouteTableByClient(int16_t clientId) {
   CHECK(protocol.has_value());
   LOG(INFO) << "Get mpls routes for client " << getClientName(clientId);
 
-  return nlSock_->getMplsRoutes(protocol.value())
-      .deferValue([this](std::vector<fbnl::Route>&& nlRoutes) {
-        auto routes = std::make_unique<std::vector<thrift::MplsRoute>>();
-        routes->reserve(nlRoutes.size());
-        for (auto& nlRoute : nlRoutes) {
-          thrift::MplsRoute route;
-          route.topLabel = nlRoute.getMplsLabel().value();
-          route.nextHops = toThriftNextHops(nlRoute.getNextHops());
-          routes->emplace_back(std::move(route));
-        }
-        return routes;
+  // Stream received routes straight into their thrift representation. This
+  // avoids buffering the entire fbnl::Route dump in memory.
+  auto routes = std::make_unique<std::vector<thrift::MplsRoute>>();
+  auto* routesPtr = routes.get();
+  return nlSock_
+      ->getMplsRoutes(
+          protocol.value(),
+          [this, routesPtr](fbnl::Route nlRoute) {
+            thrift::MplsRoute route;
+            route.topLabel = nlRoute.getMplsLabel().value();
+            route.nextHops = toThriftNextHops(nlRoute.getNextHops());
+            routesPtr->emplace_back(std::move(route));
+          })
+      .deferValue([routes = std::move(routes)](int /* status */) mutable {
+        return std::move(routes);
       });
 }
 
@@ -410,7 +715,7 @@ NetlinkFibHandler::toThriftNextHops(const fbnl::NextHopSet& nextHops) {
 
     // Add nexthop address
     if (nh.getGateway().has_value()) {
-      nextHop.address = toBinaryAddress(nh.getGateway().value());
+      nextHop.address = toBinaryAddressCached(nh.getGateway().value());
       // Add nexthop interface if any
       if (nh.getIfIndex().has_value()) {
         nextHop.address.ifName_ref() =
@@ -421,7 +726,9 @@ NetlinkFibHandler::toThriftNextHops(const fbnl::NextHopSet& nextHops) {
       // valid but zeroed ipv6 address.
       CHECK(labelAction.has_value());
       CHECK(thrift::MplsActionCode::POP_AND_LOOKUP == labelAction.value());
-      nextHop.address = toBinaryAddress(folly::IPAddressV6("::"));
+      static const auto zeroedV6Addr =
+          toBinaryAddress(folly::IPAddressV6("::"));
+      nextHop.address = zeroedV6Addr;
     }
 
     // Add mpls action
@@ -485,7 +792,7 @@ NetlinkFibHandler::buildNextHop(
     }
     nhBuilder.setGateway(toIPAddress(nh.address));
     buildMplsAction(nhBuilder, nh);
-    rtBuilder.addNextHop(nhBuilder.setWeight(0).build());
+    rtBuilder.addNextHop(std::move(nhBuilder.setWeight(0)).build());
     nhBuilder.reset();
   }
 }
@@ -508,7 +815,71 @@ NetlinkFibHandler::buildRoute(const thrift::UnicastRoute& route, int protocol) {
     buildNextHop(rtBuilder, route.nextHops);
   }
 
-  return rtBuilder.build();
+  return std::move(rtBuilder).build();
+}
+
+std::vector<fbnl::Route>
+NetlinkFibHandler::buildRoutes(
+    const std::vector<thrift::UnicastRoute>& routes, int protocol) {
+  // Resolve every distinct nexthop interface name once upfront. A single
+  // cache miss fills the interface cache for the whole batch and the
+  // conversion loop below never touches the locked cache again.
+  std::unordered_map<std::string, int> ifIndices;
+  for (auto const& route : routes) {
+    for (auto const& nh : route.nextHops) {
+      if (nh.address.ifName_ref() and
+          not ifIndices.count(*nh.address.ifName_ref())) {
+        ifIndices.emplace(
+            *nh.address.ifName_ref(),
+            getIfIndex(*nh.address.ifName_ref()).value());
+      }
+    }
+  }
+
+  // Convert and validate each distinct nexthop list once and share the
+  // built nexthop set across all routes carrying it. ECMP batches carry a
+  // handful of distinct lists across thousands of routes, pairing with the
+  // encoded-message sharing in addRoutes()
+  std::map<std::vector<thrift::NextHopThrift>, fbnl::NextHopSet> nhSets;
+
+  std::vector<fbnl::Route> nlRoutes;
+  nlRoutes.reserve(routes.size());
+  const auto priority = protocolToPriority(protocol);
+  for (auto const& route : routes) {
+    fbnl::RouteBuilder rtBuilder;
+    rtBuilder.setDestination(toIPNetwork(route.dest))
+        .setProtocolId(protocol)
+        .setPriority(priority)
+        .setFlags(0)
+        .setValid(true);
+
+    if (route.nextHops.empty()) {
+      // Empty nexthops is same as DROP (aka RTN_BLACKHOLE)
+      rtBuilder.setType(RTN_BLACKHOLE);
+    } else {
+      auto it = nhSets.find(route.nextHops);
+      if (it == nhSets.end()) {
+        fbnl::NextHopSet nextHops;
+        fbnl::NextHopBuilder nhBuilder;
+        for (auto const& nh : route.nextHops) {
+          if (nh.address.ifName_ref()) {
+            nhBuilder.setIfIndex(ifIndices.at(*nh.address.ifName_ref()));
+          }
+          nhBuilder.setGateway(toIPAddress(nh.address));
+          buildMplsAction(nhBuilder, nh);
+          nextHops.emplace(std::move(nhBuilder.setWeight(0)).build());
+          nhBuilder.reset();
+        }
+        it = nhSets.emplace(route.nextHops, std::move(nextHops)).first;
+      }
+      for (auto const& nh : it->second) {
+        rtBuilder.addNextHop(nh);
+      }
+    }
+
+    nlRoutes.emplace_back(std::move(rtBuilder).build());
+  }
+  return nlRoutes;
 }
 
 fbnl::Route
@@ -530,7 +901,7 @@ NetlinkFibHandler::buildMplsRoute(
     buildNextHop(rtBuilder, mplsRoute.nextHops);
   }
 
-  return rtBuilder.setValid(true).build();
+  return std::move(rtBuilder.setValid(true)).build();
 }
 
 std::optional<int>
@@ -117,6 +117,25 @@ class NetlinkFibHandler : public thrift::FibServiceSvIf {
       std::vector<folly::SemiFuture<int>>&& result,
       std::set<int> errorsToIgnore);
 
+  /**
+   * Audit the kernel routing table against the shadow table of programmed
+   * routes. The kernel is walked via the streaming route dump (memory stays
+   * flat no matter how large the table is) and every prefix we believe
+   * programmed is compared against the kernel's actual state by route
+   * signature. Shadow entries that diverged - prefix missing from kernel or
+   * attributes/nexthops changed underneath us - are dropped so the next
+   * programming attempt for those prefixes is no longer skipped as a no-op.
+   * Kernel routes in our protocol range with no shadow entry are alarmed on
+   * but left untouched; they may be operator installed or predate this
+   * handler.
+   *
+   * Safe to invoke from any thread on a periodic cadence. The returned
+   * future completes once the audit has finished; the audit itself is
+   * chained on the dump future, so dropping the returned future does not
+   * abandon the work.
+   */
+  folly::SemiFuture<folly::Unit> auditKernelRoutes();
+
  protected:
   /**
    * TODO: Migrate BGP++ to stream API for neighbor notifications. Also need to
@@ -160,6 +179,17 @@ class NetlinkFibHandler : public thrift::FibServiceSvIf {
       fbnl::RouteBuilder& rtBuilder,
       const std::vector<thrift::NextHopThrift>& nhop);
 
+  /**
+   * Batched conversion of thrift unicast routes to netlink representation.
+   * Distinct nexthop interface names are resolved to ifIndex once per batch
+   * and each distinct nexthop list is converted and validated once, with the
+   * resulting nexthop set shared across all routes carrying it. The
+   * per-route loop then runs over preresolved data only, free of interface
+   * cache lookups and their lock acquisitions.
+   */
+  std::vector<fbnl::Route> buildRoutes(
+      const std::vector<thrift::UnicastRoute>& routes, int protocol);
+
   /**
    * APIs to convert ifName <-> ifIndex for thrift <-> netlink route conversions
    * Returns `folly::none` if can't find the mapping.
@@ -173,6 +203,21 @@ class NetlinkFibHandler : public thrift::FibServiceSvIf {
   std::optional<int> getIfIndex(const std::string& ifName);
   std::optional<std::string> getIfName(const int ifIndex);
 
+  /**
+   * Compute an order independent digest of a route's attributes and nexthop
+   * set. Two routes for the same prefix with equal signatures program the
+   * same state in kernel.
+   */
+  static std::size_t routeSignature(const fbnl::Route& route);
+
+  /**
+   * Chain shadow-table bookkeeping on an add-route future. The route is
+   * recorded as programmed once the kernel acks it, so identical
+   * re-submissions (e.g. Fib sync retries) can be skipped.
+   */
+  folly::SemiFuture<int> recordRouteProgrammed(
+      folly::SemiFuture<int>&& future, const fbnl::Route& route);
+
   /**
    * Get interface index of loopback interface. Lazily query it from netlink
    * by querying `getAllLinks`
@@ -199,6 +244,51 @@ class NetlinkFibHandler : public thrift::FibServiceSvIf {
   folly::Synchronized<std::unordered_map<std::string, int>> ifNameToIndex_;
   folly::Synchronized<std::unordered_map<int, std::string>> ifIndexToName_;
 
+  /**
+   * Check a route against the neighbor cache. A route is considered
+   * unresolved only when every gateway nexthop has a neighbor entry
+   * explicitly marked unreachable (ARP/NDP incomplete or failed). Unknown
+   * gateways pass - holding those back would block the very traffic that
+   * triggers kernel neighbor resolution.
+   */
+  bool hasUsableNextHop(const fbnl::Route& route);
+
+  /**
+   * Move routes failing hasUsableNextHop() out of `routes` into the
+   * unresolved retry set. Returns the number of deferred routes.
+   */
+  std::size_t deferUnresolvedRoutes(std::vector<fbnl::Route>& routes);
+
+  /**
+   * Program deferred routes that the newly reachable neighbor unblocks.
+   * Invoked from the neighbor event callback on the netlink thread.
+   */
+  void retryUnresolvedRoutes(const folly::IPAddress& neighbor);
+
+  /**
+   * Seed the neighbor cache with a one-time kernel dump. Entries already
+   * written by concurrent neighbor events are left untouched.
+   */
+  void initializeNeighborCache() noexcept;
+
+  // Shadow table of successfully programmed unicast routes
+  // (prefix -> route signature). Entries are added on kernel ack and removed
+  // on route deletion, letting no-op re-submissions be skipped.
+  folly::Synchronized<std::unordered_map<folly::CIDRNetwork, std::size_t>>
+      programmedRoutes_;
+
+  // Neighbor reachability by destination address. Seeded lazily with a
+  // kernel dump and kept current by netlink neighbor events
+  folly::Synchronized<std::unordered_map<folly::IPAddress, bool>>
+      neighborCache_;
+  std::atomic<bool> neighborCacheInitialized_{false};
+
+  // Routes whose programming was deferred because all gateway nexthops
+  // were known-unreachable. Programmed once a gateway resolves; dropped
+  // when the prefix is deleted or no longer wanted by a sync
+  folly::Synchronized<std::unordered_map<folly::CIDRNetwork, fbnl::Route>>
+      unresolvedRoutes_;
+
   // Loopback interface index cache. Initialized to negative number
   std::atomic<int> loopbackIfIndex_{-1};
 
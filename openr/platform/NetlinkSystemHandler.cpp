@@ -105,8 +105,10 @@ NetlinkSystemHandler::addRemoveIfAddresses(
   // Get iface index
   const int ifIndex = getIfIndex(ifName).value();
 
-  // Add netlink requests
-  std::vector<folly::SemiFuture<int>> futures;
+  // Build all address objects upfront and submit them as one pre-validated
+  // batch, so the whole set settles in one netlink round trip
+  std::vector<fbnl::IfAddress> nlAddrs;
+  nlAddrs.reserve(addrs.size());
   for (const auto& addr : addrs) {
     fbnl::IfAddressBuilder builder;
     auto const network = toIPNetwork(addr, false /* applyMask */);
@@ -119,12 +121,10 @@ NetlinkSystemHandler::addRemoveIfAddresses(
     } else {
       builder.setScope(RT_SCOPE_UNIVERSE);
     }
-    if (isAdd) {
-      futures.emplace_back(nlSock_->addIfAddress(builder.build()));
-    } else {
-      futures.emplace_back(nlSock_->deleteIfAddress(builder.build()));
-    }
+    nlAddrs.emplace_back(builder.build());
   }
+  auto futures = isAdd ? nlSock_->addIfAddresses(nlAddrs)
+                       : nlSock_->deleteIfAddresses(nlAddrs);
 
   // Accumulate futures into a single one
   return collectAll(std::move(futures))
@@ -184,9 +184,9 @@ NetlinkSystemHandler::semifuture_syncIfaceAddresses(
 
   auto oldAddrs =
       semifuture_getIfaceAddresses(std::move(iface), family, scope).get();
-  std::vector<folly::SemiFuture<int>> futures;
 
-  // Add new addresses
+  // Collect new addresses to add
+  std::vector<fbnl::IfAddress> addrsToAdd;
   for (auto& newAddr : *newAddrs) {
     // Skip adding existing addresse
     if (std::find(oldAddrs->begin(), oldAddrs->end(), newAddr) !=
@@ -198,10 +198,11 @@ NetlinkSystemHandler::semifuture_syncIfaceAddresses(
     builder.setPrefix(toIPNetwork(newAddr, false /* applyMask */));
     builder.setIfIndex(ifIndex);
     builder.setScope(scope);
-    futures.emplace_back(nlSock_->addIfAddress(builder.build()));
+    addrsToAdd.emplace_back(builder.build());
   }
 
-  // Delete old addresses
+  // Collect old addresses to delete
+  std::vector<fbnl::IfAddress> addrsToDel;
   for (auto& oldAddr : *oldAddrs) {
     // Skip removing new addresse
     if (std::find(newAddrs->begin(), newAddrs->end(), oldAddr) !=
@@ -213,7 +214,13 @@ NetlinkSystemHandler::semifuture_syncIfaceAddresses(
     builder.setPrefix(toIPNetwork(oldAddr, false /* applyMask */));
     builder.setIfIndex(ifIndex);
     builder.setScope(scope);
-    futures.emplace_back(nlSock_->deleteIfAddress(builder.build()));
+    addrsToDel.emplace_back(builder.build());
+  }
+
+  // Submit both sets as pre-validated batches and collect their acks together
+  auto futures = nlSock_->addIfAddresses(addrsToAdd);
+  for (auto& future : nlSock_->deleteIfAddresses(addrsToDel)) {
+    futures.emplace_back(std::move(future));
   }
 
   // Collect all futures
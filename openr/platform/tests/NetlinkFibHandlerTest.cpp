@@ -381,6 +381,100 @@ TEST_P(FibHandlerFixture, UnicastSync) {
   EXPECT_EQ(rts, *routes);
 }
 
+//
+// Routes whose every gateway neighbor is explicitly unreachable are
+// deferred, then programmed once the neighbor resolves
+//
+TEST(NetlinkFibHandler, UnicastDeferUnresolvedNextHops) {
+  const int16_t kClientId = 786;
+  folly::EventBase evb;
+  fbnl::FakeNetlinkProtocolSocket nlSock(&evb);
+  for (size_t i = 0; i < kInterfaces.size(); ++i) {
+    ASSERT_EQ(
+        0,
+        nlSock.addLink(fbnl::utils::createLink(i + 1, kInterfaces.at(i)))
+            .get());
+  }
+  NetlinkFibHandler handler(&nlSock);
+
+  // Mark the route's only gateway as unreachable (failed ARP)
+  thrift::UnicastRoute r1 = createUnicastRoute(0, 1, true /* isV4 */);
+  const folly::IPAddress gateway{"169.254.0.1"};
+  nlSock.addNeighbor(fbnl::utils::createNeighbor(1, gateway, false)).get();
+
+  // Add route - expect it to be deferred, not programmed
+  handler
+      .semifuture_addUnicastRoute(
+          kClientId, std::make_unique<thrift::UnicastRoute>(r1))
+      .get();
+  auto routes = handler.semifuture_getRouteTableByClient(kClientId).get();
+  EXPECT_EQ(0, routes->size());
+
+  // Neighbor resolves - the deferred route gets programmed
+  nlSock.addNeighbor(fbnl::utils::createNeighbor(1, gateway, true)).get();
+  routes = handler.semifuture_getRouteTableByClient(kClientId).get();
+  ASSERT_EQ(1, routes->size());
+  sortNextHops(*routes);
+  EXPECT_EQ(r1, routes->at(0));
+}
+
+//
+// Kernel route audit. Remove a programmed route from the kernel behind the
+// handler's back. Re-adding the identical route is skipped as a no-op since
+// the shadow entry still claims it is programmed. Verify the audit detects
+// the divergence and drops the shadow entry so the next add goes through.
+//
+TEST(NetlinkFibHandler, AuditKernelRoutes) {
+  const int16_t kClientId = 786;
+  folly::EventBase evb;
+  fbnl::FakeNetlinkProtocolSocket nlSock(&evb);
+  for (size_t i = 0; i < kInterfaces.size(); ++i) {
+    ASSERT_EQ(
+        0,
+        nlSock.addLink(fbnl::utils::createLink(i + 1, kInterfaces.at(i)))
+            .get());
+  }
+  NetlinkFibHandler handler(&nlSock);
+
+  // Add a route and verify it is programmed
+  thrift::UnicastRoute r1 = createUnicastRoute(0, 1, true /* isV4 */);
+  handler
+      .semifuture_addUnicastRoute(
+          kClientId, std::make_unique<thrift::UnicastRoute>(r1))
+      .get();
+  auto routes = handler.semifuture_getRouteTableByClient(kClientId).get();
+  EXPECT_EQ(1, routes->size());
+
+  // Audit on consistent state must not disturb anything
+  handler.auditKernelRoutes().get();
+
+  // Delete the route from the kernel directly, bypassing the handler
+  fbnl::RouteBuilder builder;
+  builder.setDestination(folly::IPAddress::createNetwork("192.168.0.1/32"));
+  builder.setProtocolId(99); // OPENR protocol
+  EXPECT_EQ(0, nlSock.deleteRoute(builder.build()).get());
+
+  // Re-adding the identical route is suppressed by the stale shadow entry
+  handler
+      .semifuture_addUnicastRoute(
+          kClientId, std::make_unique<thrift::UnicastRoute>(r1))
+      .get();
+  routes = handler.semifuture_getRouteTableByClient(kClientId).get();
+  EXPECT_EQ(0, routes->size());
+
+  // Audit detects the divergence and drops the shadow entry; the next add
+  // programs the route again
+  handler.auditKernelRoutes().get();
+  handler
+      .semifuture_addUnicastRoute(
+          kClientId, std::make_unique<thrift::UnicastRoute>(r1))
+      .get();
+  routes = handler.semifuture_getRouteTableByClient(kClientId).get();
+  ASSERT_EQ(1, routes->size());
+  sortNextHops(*routes);
+  EXPECT_EQ(r1, routes->at(0));
+}
+
 //
 // Test correctness of multiple client support. Incrementally add and remove
 // route for same prefix1 from client1 and client2. Verify that addition or
@@ -50,6 +50,10 @@ PrefixManager::PrefixManager(
       enablePerfMeasurement_{enablePerfMeasurement},
       ttlKeyInKvStore_(
           std::chrono::milliseconds(config->getKvStoreConfig().key_ttl_ms)),
+      aggregationConfig_(
+          config->isPrefixAggregationEnabled()
+              ? std::make_optional(config->getPrefixAggregationConfig())
+              : std::nullopt),
       areas_{config->getAreaIds()} {
   CHECK(configStore_);
   CHECK(kvStore_);
@@ -92,38 +96,21 @@ PrefixManager::PrefixManager(
         syncKvStore();
       });
 
-  // Schedule fiber to read prefix updates messages
+  // Schedule fiber to read prefix updates messages. Requests that have
+  // accumulated on the queue are drained and applied as one batch with a
+  // single consolidated persistence & KvStore sync, so bursts of thousands
+  // of prefix changes don't re-serialize the prefix db per change
   addFiberTask(
       [q = std::move(prefixUpdateRequestQueue), this]() mutable noexcept {
         while (true) {
-          auto maybeUpdate = q.get(); // perform read
-          VLOG(1) << "Received prefix update request";
-          if (maybeUpdate.hasError()) {
+          auto maybeUpdates = q.getAll(); // perform read
+          if (maybeUpdates.hasError()) {
             LOG(INFO) << "Terminating route delta processing fiber";
             break;
           }
-
-          auto& update = maybeUpdate.value();
-          switch (update.cmd) {
-          case thrift::PrefixUpdateCommand::ADD_PREFIXES:
-            advertisePrefixesImpl(update.prefixes);
-            break;
-          case thrift::PrefixUpdateCommand::WITHDRAW_PREFIXES:
-            withdrawPrefixesImpl(update.prefixes);
-            break;
-          case thrift::PrefixUpdateCommand::WITHDRAW_PREFIXES_BY_TYPE:
-            CHECK(update.type_ref().has_value());
-            withdrawPrefixesByTypeImpl(update.type_ref().value());
-            break;
-          case thrift::PrefixUpdateCommand::SYNC_PREFIXES_BY_TYPE:
-            CHECK(update.type_ref().has_value());
-            syncPrefixesByTypeImpl(update.type_ref().value(), update.prefixes);
-            break;
-          default:
-            LOG(FATAL) << "Unknown command received. "
-                       << static_cast<int>(update.cmd);
-            break;
-          }
+          VLOG(1) << "Received " << maybeUpdates->size()
+                  << " prefix update request(s)";
+          applyPrefixUpdates(maybeUpdates.value());
         }
       });
 
@@ -224,16 +211,128 @@ PrefixManager::updateKvStorePrefixEntry(thrift::PrefixEntry& prefixEntry) {
   return prefixKey;
 }
 
+void
+PrefixManager::computePrefixAggregates(
+    std::unordered_set<thrift::IpPrefix>& suppressed,
+    std::vector<thrift::PrefixEntry>& summaries) const {
+  // working set keyed by network. For a prefix advertised under multiple
+  // types only the lowest type participates, matching the dedup order of
+  // syncKvStore (prefixMap_ is type-ordered)
+  std::map<folly::CIDRNetwork, thrift::PrefixEntry> work;
+  std::unordered_set<thrift::IpPrefix> original;
+  for (auto const& kv : prefixMap_) {
+    for (auto const& kv2 : kv.second) {
+      if (original.insert(kv2.first).second) {
+        work.emplace(toIPNetwork(kv2.first), kv2.second);
+      }
+    }
+  }
+
+  // entries may only coalesce when everything but the prefix itself matches,
+  // else the summary would misrepresent one of its constituents
+  auto const sameAttributes = [](
+      thrift::PrefixEntry const& lhs, thrift::PrefixEntry const& rhs) {
+    auto l = lhs;
+    auto r = rhs;
+    l.prefix = thrift::IpPrefix{};
+    r.prefix = thrift::IpPrefix{};
+    return l == r;
+  };
+
+  auto const minAggregateLength = [this](folly::IPAddress const& addr) {
+    return addr.isV4() ? aggregationConfig_->min_supernet_length_v4
+                       : aggregationConfig_->min_supernet_length_v6;
+  };
+
+  // repeatedly merge attribute-identical sibling pairs into their parent
+  // supernet until none remains above the per-family boundary
+  bool merged{true};
+  while (merged) {
+    merged = false;
+    for (auto it = work.begin(); it != work.end(); ++it) {
+      auto const& [addr, len] = it->first;
+      if (len == 0 or len <= minAggregateLength(addr)) {
+        continue;
+      }
+      // flip the last prefix bit to get the sibling network address
+      std::vector<uint8_t> bytes(addr.bytes(), addr.bytes() + addr.byteCount());
+      bytes[(len - 1) / 8] ^= (0x80 >> ((len - 1) % 8));
+      auto const sibling = folly::IPAddress::fromBinary(
+          folly::ByteRange(bytes.data(), bytes.size()));
+      auto const siblingIt = work.find({sibling, len});
+      if (siblingIt == work.end() or
+          not sameAttributes(it->second, siblingIt->second)) {
+        continue;
+      }
+      folly::CIDRNetwork const parent{addr.mask(len - 1), len - 1};
+      if (work.count(parent)) {
+        // an existing covering entry subsumes both siblings; leave them to
+        // the covered pass below
+        continue;
+      }
+      auto entry = it->second;
+      entry.prefix = toIpPrefix(parent);
+      work.erase(siblingIt);
+      work.erase(it);
+      work.emplace(parent, std::move(entry));
+      // restart the scan - both iterators are invalidated by the erases
+      merged = true;
+      break;
+    }
+  }
+
+  // drop entries fully covered by an attribute-identical shorter prefix.
+  // A covering entry sorts before its covered ones in the ordered map
+  for (auto it = work.begin(); it != work.end();) {
+    bool covered{false};
+    for (auto cit = work.begin(); cit != it; ++cit) {
+      if (cit->first.second < it->first.second and
+          it->first.first.inSubnet(cit->first.first, cit->first.second) and
+          sameAttributes(cit->second, it->second)) {
+        covered = true;
+        break;
+      }
+    }
+    it = covered ? work.erase(it) : std::next(it);
+  }
+
+  suppressed.clear();
+  summaries.clear();
+  for (auto const& prefix : original) {
+    if (not work.count(toIPNetwork(prefix))) {
+      suppressed.emplace(prefix);
+    }
+  }
+  for (auto const& kv : work) {
+    if (not original.count(kv.second.prefix)) {
+      summaries.emplace_back(kv.second);
+    }
+  }
+}
+
 void
 PrefixManager::syncKvStore() {
   std::vector<std::pair<std::string, std::string>> keyVals;
   std::unordered_set<std::string> nowAdvertisingKeys;
   std::unordered_set<thrift::IpPrefix> nowAdvertisingPrefixes;
 
+  // optionally coalesce the db into summaries. Constituents of a summary are
+  // suppressed from advertisement below, with the summary entries advertised
+  // in their place; keys of newly suppressed prefixes are withdrawn via the
+  // regular keysToClear_ machinery
+  std::unordered_set<thrift::IpPrefix> aggregatedAway;
+  std::vector<thrift::PrefixEntry> summaryEntries;
+  if (aggregationConfig_.has_value()) {
+    computePrefixAggregates(aggregatedAway, summaryEntries);
+  }
+
   if (perPrefixKeys_) {
     for (auto& kv : prefixMap_) {
       for (auto& kv2 : kv.second) {
-        if (not nowAdvertisingPrefixes.count(kv2.first)) {
+        if (aggregatedAway.count(kv2.first)) {
+          addPerfEventIfNotExist(
+              addingEvents_[kv.first][kv2.first], "AGGREGATED_INTO_SUMMARY");
+        } else if (not nowAdvertisingPrefixes.count(kv2.first)) {
           addPerfEventIfNotExist(
               addingEvents_[kv.first][kv2.first], "UPDATE_KVSTORE_THROTTLED");
           auto const key = updateKvStorePrefixEntry(kv2.second);
@@ -246,13 +345,23 @@ PrefixManager::syncKvStore() {
         }
       }
     }
+    for (auto& summary : summaryEntries) {
+      addPerfEventIfNotExist(
+          addingEvents_[summary.type][summary.prefix], "AGGREGATED_SUMMARY");
+      auto const key = updateKvStorePrefixEntry(summary);
+      nowAdvertisingKeys.emplace(key);
+      keysToClear_.erase(key);
+    }
   } else {
     thrift::PrefixDatabase prefixDb;
     prefixDb.thisNodeName = nodeId_;
     thrift::PerfEvents* mostRecentEvents = nullptr;
     for (auto& kv : prefixMap_) {
       for (auto& kv2 : kv.second) {
-        if (not nowAdvertisingPrefixes.count(kv2.first)) {
+        if (aggregatedAway.count(kv2.first)) {
+          addPerfEventIfNotExist(
+              addingEvents_[kv.first][kv2.first], "AGGREGATED_INTO_SUMMARY");
+        } else if (not nowAdvertisingPrefixes.count(kv2.first)) {
           addPerfEventIfNotExist(
               addingEvents_[kv.first][kv2.first], "UPDATE_KVSTORE_THROTTLED");
           if (nullptr == mostRecentEvents or
@@ -268,11 +377,14 @@ PrefixManager::syncKvStore() {
         }
       }
     }
+    for (auto& summary : summaryEntries) {
+      prefixDb.prefixEntries.emplace_back(summary);
+    }
     if (enablePerfMeasurement_ and nullptr != mostRecentEvents) {
       prefixDb.perfEvents_ref() = *mostRecentEvents;
     }
-    const auto prefixDbKey =
-        folly::sformat("{}{}", Constants::kPrefixDbMarker.toString(), nodeId_);
+    std::string prefixDbKey;
+    composeNodeKey(prefixDbKey, Constants::kPrefixDbMarker, nodeId_);
     for (const auto& area : areas_) {
       bool const changed = kvStoreClient_->persistKey(
           prefixDbKey,
@@ -422,9 +534,87 @@ PrefixManager::getPrefixesByType(thrift::PrefixType prefixType) {
 }
 
 // helpers for modifying our Prefix Db
+bool
+PrefixManager::applyPrefixUpdates(
+    const std::vector<thrift::PrefixUpdateRequest>& updates) {
+  bool updated{false};
+  for (const auto& update : updates) {
+    switch (update.cmd) {
+    case thrift::PrefixUpdateCommand::ADD_PREFIXES:
+      updated |= addOrUpdatePrefixes(update.prefixes);
+      break;
+    case thrift::PrefixUpdateCommand::WITHDRAW_PREFIXES:
+      updated |= removePrefixes(update.prefixes);
+      break;
+    case thrift::PrefixUpdateCommand::WITHDRAW_PREFIXES_BY_TYPE:
+      CHECK(update.type_ref().has_value());
+      updated |= removePrefixesByType(update.type_ref().value());
+      break;
+    case thrift::PrefixUpdateCommand::SYNC_PREFIXES_BY_TYPE:
+      CHECK(update.type_ref().has_value());
+      updated |=
+          replacePrefixesByType(update.type_ref().value(), update.prefixes);
+      break;
+    default:
+      LOG(FATAL) << "Unknown command received. "
+                 << static_cast<int>(update.cmd);
+      break;
+    }
+  }
+  if (updated) {
+    persistPrefixDb();
+    syncKvStoreThrottled_->operator()();
+  }
+  return updated;
+}
+
 bool
 PrefixManager::advertisePrefixesImpl(
     const std::vector<thrift::PrefixEntry>& prefixEntries) {
+  bool updated = addOrUpdatePrefixes(prefixEntries);
+  if (updated) {
+    persistPrefixDb();
+    syncKvStoreThrottled_->operator()();
+  }
+  return updated;
+}
+
+bool
+PrefixManager::withdrawPrefixesImpl(
+    const std::vector<thrift::PrefixEntry>& prefixes) {
+  bool updated = removePrefixes(prefixes);
+  if (updated) {
+    persistPrefixDb();
+    syncKvStoreThrottled_->operator()();
+  }
+  return updated;
+}
+
+bool
+PrefixManager::syncPrefixesByTypeImpl(
+    thrift::PrefixType type,
+    const std::vector<thrift::PrefixEntry>& prefixEntries) {
+  bool updated = replacePrefixesByType(type, prefixEntries);
+  if (updated) {
+    persistPrefixDb();
+    syncKvStoreThrottled_->operator()();
+  }
+  return updated;
+}
+
+bool
+PrefixManager::withdrawPrefixesByTypeImpl(thrift::PrefixType type) {
+  bool updated = removePrefixesByType(type);
+  if (updated) {
+    persistPrefixDb();
+    syncKvStoreThrottled_->operator()();
+  }
+  return updated;
+}
+
+bool
+PrefixManager::addOrUpdatePrefixes(
+    const std::vector<thrift::PrefixEntry>& prefixEntries) {
   bool updated{false};
   for (const auto& prefixEntry : prefixEntries) {
     auto& prefixes = prefixMap_[prefixEntry.type];
@@ -439,15 +629,11 @@ PrefixManager::advertisePrefixesImpl(
                    << ", client: " << getPrefixTypeName(prefixEntry.type);
     }
   }
-  if (updated) {
-    persistPrefixDb();
-    syncKvStoreThrottled_->operator()();
-  }
   return updated;
 }
 
 bool
-PrefixManager::withdrawPrefixesImpl(
+PrefixManager::removePrefixes(
     const std::vector<thrift::PrefixEntry>& prefixes) {
   // verify prefixes exists
   for (const auto& prefix : prefixes) {
@@ -470,15 +656,11 @@ PrefixManager::withdrawPrefixesImpl(
       addingEvents_.erase(prefix.type);
     }
   }
-  if (!prefixes.empty()) {
-    persistPrefixDb();
-    syncKvStoreThrottled_->operator()();
-  }
   return !prefixes.empty();
 }
 
 bool
-PrefixManager::syncPrefixesByTypeImpl(
+PrefixManager::replacePrefixesByType(
     thrift::PrefixType type,
     const std::vector<thrift::PrefixEntry>& prefixEntries) {
   LOG(INFO) << "Syncing prefixes of type: " << getPrefixTypeName(type);
@@ -497,23 +679,19 @@ PrefixManager::syncPrefixesByTypeImpl(
     toRemove.emplace_back(prefixMap_[type][prefix]);
   }
   bool updated = false;
-  updated |= advertisePrefixesImpl(toAddOrUpdate);
-  updated |= withdrawPrefixesImpl(toRemove);
+  updated |= addOrUpdatePrefixes(toAddOrUpdate);
+  updated |= removePrefixes(toRemove);
   return updated;
 }
 
 bool
-PrefixManager::withdrawPrefixesByTypeImpl(thrift::PrefixType type) {
+PrefixManager::removePrefixesByType(thrift::PrefixType type) {
   bool changed = false;
   auto const search = prefixMap_.find(type);
   if (search != prefixMap_.end()) {
     changed = true;
     prefixMap_.erase(search);
   }
-  if (changed) {
-    persistPrefixDb();
-    syncKvStoreThrottled_->operator()();
-  }
   return changed;
 }
 
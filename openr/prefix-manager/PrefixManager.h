@@ -97,6 +97,26 @@ class PrefixManager final : public OpenrEventBase {
       thrift::PrefixType type,
       const std::vector<thrift::PrefixEntry>& prefixes);
 
+  /*
+   * Batched counterpart for requests read off the update request queue.
+   * Applies all accumulated requests in one pass over the prefix map and
+   * schedules a single consolidated persistence & KvStore sync for the whole
+   * batch, instead of one per request
+   */
+  bool applyPrefixUpdates(
+      const std::vector<thrift::PrefixUpdateRequest>& updates);
+
+  /*
+   * Update prefixMap_ only - no persistence or KvStore sync side-effects.
+   * Building blocks shared by the *Impl methods and the batched request path
+   */
+  bool addOrUpdatePrefixes(const std::vector<thrift::PrefixEntry>& prefixes);
+  bool removePrefixes(const std::vector<thrift::PrefixEntry>& prefixes);
+  bool removePrefixesByType(thrift::PrefixType type);
+  bool replacePrefixesByType(
+      thrift::PrefixType type,
+      const std::vector<thrift::PrefixEntry>& prefixes);
+
   // Update kvstore with both ephemeral and non-ephemeral prefixes
   void syncKvStore();
 
@@ -111,6 +131,16 @@ class PrefixManager final : public OpenrEventBase {
   void addPerfEventIfNotExist(
       thrift::PerfEvents& perfEvents, std::string const& updateEvent);
 
+  // coalesce the current prefix db into summaries before advertisement.
+  // Contiguous sibling prefixes with identical attributes merge into their
+  // common supernet (repeatedly, down to the configured per-family boundary)
+  // and entries covered by an attribute-identical shorter prefix are dropped.
+  // On return `suppressed` holds the original prefixes subsumed by a summary
+  // and `summaries` the synthesized supernet entries to advertise instead
+  void computePrefixAggregates(
+      std::unordered_set<thrift::IpPrefix>& suppressed,
+      std::vector<thrift::PrefixEntry>& summaries) const;
+
   // this node name
   const std::string nodeId_;
 
@@ -136,6 +166,9 @@ class PrefixManager final : public OpenrEventBase {
   // TTL for a key in the key value store
   const std::chrono::milliseconds ttlKeyInKvStore_;
 
+  // aggregation boundaries when prefix aggregation is enabled
+  const std::optional<thrift::PrefixAggregationConfig> aggregationConfig_;
+
   // kvStoreClient for persisting our prefix db
   std::unique_ptr<KvStoreClientInternal> kvStoreClient_{nullptr};
 
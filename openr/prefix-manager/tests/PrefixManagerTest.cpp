@@ -893,6 +893,127 @@ TEST_F(PrefixManagerTestFixture, PrefixWithdrawExpiry) {
   prefixManagerThread2->join();
 }
 
+TEST_F(PrefixManagerTestFixture, PrefixAggregation) {
+  folly::Baton waitBaton;
+  int waitDuration{0};
+
+  kvStoreClient = std::make_unique<KvStoreClientInternal>(
+      &evl, "node-1", kvStoreWrapper->getKvStore());
+
+  auto tConfig = getBasicOpenrConfig("node-2");
+  tConfig.enable_prefix_aggregation_ref() = true;
+  tConfig.prefix_aggregation_config_ref() = thrift::PrefixAggregationConfig{};
+  auto config = std::make_shared<Config>(tConfig);
+  // spin up a new PrefixManager with aggregation enabled
+  auto prefixManager2 = std::make_unique<PrefixManager>(
+      prefixUpdatesQueue.getReader(),
+      config,
+      configStore.get(),
+      kvStoreWrapper->getKvStore(),
+      false /* prefix-mananger perf measurement */,
+      std::chrono::seconds(0));
+
+  auto prefixManagerThread2 = std::make_unique<std::thread>([&]() {
+    LOG(INFO) << "PrefixManager thread starting";
+    prefixManager2->run();
+    LOG(INFO) << "PrefixManager thread finishing";
+  });
+  prefixManager2->waitUntilRunning();
+
+  // two contiguous siblings and one stand-alone prefix
+  const auto sibling1 = toIpPrefix("fc00:cafe:1::/64");
+  const auto sibling2 = toIpPrefix("fc00:cafe:1:1::/64");
+  const auto standalone = toIpPrefix("fc00:babe:1::/64");
+  const auto summary = toIpPrefix("fc00:cafe:1::/63");
+
+  auto makeKey = [](thrift::IpPrefix const& prefix) {
+    return PrefixKey(
+               "node-2",
+               folly::IPAddress::createNetwork(toString(prefix)),
+               thrift::KvStore_constants::kDefaultArea())
+        .getPrefixKey();
+  };
+
+  // advertise all three prefixes
+  evl.scheduleTimeout(
+      std::chrono::milliseconds(waitDuration += 0), [&]() noexcept {
+        prefixManager2
+            ->advertisePrefixes(
+                {createPrefixEntry(sibling1, thrift::PrefixType::DEFAULT),
+                 createPrefixEntry(sibling2, thrift::PrefixType::DEFAULT),
+                 createPrefixEntry(standalone, thrift::PrefixType::DEFAULT)})
+            .get();
+      });
+
+  // the siblings must be advertised as their /63 summary, the stand-alone
+  // prefix as itself; the constituents never show up in kvstore
+  evl.scheduleTimeout(
+      std::chrono::milliseconds(
+          waitDuration += 2 * Constants::kPrefixMgrKvThrottleTimeout.count()),
+      [&]() noexcept {
+        auto maybeSummary = kvStoreClient->getKey(makeKey(summary));
+        ASSERT_TRUE(maybeSummary.has_value());
+        auto db = fbzmq::util::readThriftObjStr<thrift::PrefixDatabase>(
+            maybeSummary.value().value_ref().value(), serializer);
+        ASSERT_EQ(1, db.prefixEntries.size());
+        EXPECT_EQ(summary, db.prefixEntries.at(0).prefix);
+        EXPECT_EQ(thrift::PrefixType::DEFAULT, db.prefixEntries.at(0).type);
+
+        EXPECT_TRUE(kvStoreClient->getKey(makeKey(standalone)).has_value());
+        EXPECT_FALSE(kvStoreClient->getKey(makeKey(sibling1)).has_value());
+        EXPECT_FALSE(kvStoreClient->getKey(makeKey(sibling2)).has_value());
+      });
+
+  // withdraw one sibling - the summary is no longer valid and the remaining
+  // sibling must be advertised as itself again
+  evl.scheduleTimeout(
+      std::chrono::milliseconds(
+          waitDuration += 2 * Constants::kPrefixMgrKvThrottleTimeout.count()),
+      [&]() noexcept {
+        prefixManager2
+            ->withdrawPrefixes(
+                {createPrefixEntry(sibling2, thrift::PrefixType::DEFAULT)})
+            .get();
+      });
+
+  evl.scheduleTimeout(
+      std::chrono::milliseconds(
+          waitDuration += 2 * Constants::kPrefixMgrKvThrottleTimeout.count()),
+      [&]() noexcept {
+        auto maybeValue = kvStoreClient->getKey(makeKey(sibling1));
+        ASSERT_TRUE(maybeValue.has_value());
+        auto db = fbzmq::util::readThriftObjStr<thrift::PrefixDatabase>(
+            maybeValue.value().value_ref().value(), serializer);
+        EXPECT_FALSE(db.deletePrefix);
+
+        // summary key is withdrawn (may still be lingering with
+        // deletePrefix set until its ttl runs out)
+        auto maybeSummary = kvStoreClient->getKey(makeKey(summary));
+        if (maybeSummary.has_value()) {
+          auto summaryDb =
+              fbzmq::util::readThriftObjStr<thrift::PrefixDatabase>(
+                  maybeSummary.value().value_ref().value(), serializer);
+          EXPECT_TRUE(summaryDb.deletePrefix);
+        }
+
+        // Synchronization primitive
+        waitBaton.post();
+      });
+
+  // Start the event loop and wait until it is finished execution.
+  evlThread = std::thread([&]() { evl.run(); });
+  evl.waitUntilRunning();
+
+  // Synchronization primitive
+  waitBaton.wait();
+
+  // cleanup
+  prefixUpdatesQueue.close();
+  kvStoreWrapper->closeQueue();
+  prefixManager2->stop();
+  prefixManagerThread2->join();
+}
+
 TEST_F(PrefixManagerTestFixture, CheckReload) {
   prefixManager->advertisePrefixes({prefixEntry1}).get();
   prefixManager->advertisePrefixes({prefixEntry2}).get();
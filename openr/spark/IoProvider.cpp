@@ -70,6 +70,85 @@ IoProvider::sendmsg(int sockfd, const struct msghdr* msg, int flags) {
   return ::sendmsg(sockfd, msg, flags);
 }
 
+int
+IoProvider::recvmmsg(
+    int sockfd,
+    struct mmsghdr* msgvec,
+    unsigned int vlen,
+    int flags,
+    struct timespec* timeout) {
+  return ::recvmmsg(sockfd, msgvec, vlen, flags, timeout);
+}
+
+int
+IoProvider::sendmmsg(
+    int sockfd, struct mmsghdr* msgvec, unsigned int vlen, int flags) {
+  return ::sendmmsg(sockfd, msgvec, vlen, flags);
+}
+
+namespace {
+
+// extract interface index, hop limit and kernel receive timestamp from
+// the ancillary data of a received message
+std::tuple<int, int, std::chrono::microseconds>
+parseAncillaryData(struct msghdr& msg) {
+  struct cmsghdr* cmsg{nullptr};
+  int ifIndex{-1};
+  int hopLimit{0};
+  std::chrono::microseconds recvTs{0};
+
+  for (cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+    if (cmsg->cmsg_level == IPPROTO_IPV6) {
+      if (cmsg->cmsg_type == IPV6_PKTINFO) {
+        struct in6_pktinfo pktinfo;
+        memcpy(
+            reinterpret_cast<void*>(&pktinfo),
+            CMSG_DATA(cmsg),
+            sizeof(pktinfo));
+        ifIndex = pktinfo.ipi6_ifindex;
+      } else if (cmsg->cmsg_type == IPV6_HOPLIMIT) {
+        memcpy(
+            reinterpret_cast<void*>(&hopLimit),
+            CMSG_DATA(cmsg),
+            sizeof(hopLimit));
+      }
+    }
+    if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_TIMESTAMPNS) {
+      struct timespec ts {
+        0, 0
+      };
+      memcpy(reinterpret_cast<void*>(&ts), CMSG_DATA(cmsg), sizeof(ts));
+
+      // cast to int64_t since ts.tv_sec is 32 bits on some platforms like arm
+      const int64_t usecs =
+          static_cast<int64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+      const std::chrono::microseconds kernelRecvTs(usecs);
+
+      if (VLOG_IS_ON(4)) {
+        const std::chrono::microseconds userRecvTs{
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::system_clock::now().time_since_epoch())};
+        VLOG(4) << "Got kernel-timestamp. It took "
+                << (userRecvTs - kernelRecvTs).count()
+                << " us for the packet to get from kernel to user space";
+      }
+      recvTs = kernelRecvTs;
+    }
+  } // for
+
+  // fall back to a userspace timestamp only when the kernel did not
+  // supply one; the common (timestamped) case pays no clock read per
+  // packet, and RTT math is immune to event-loop delay
+  if (recvTs.count() == 0) {
+    recvTs = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch());
+  }
+
+  return std::make_tuple(ifIndex, hopLimit, recvTs);
+}
+
+} // namespace
+
 std::tuple<
     ssize_t /* size */,
     int /* ifIndex */,
@@ -130,52 +209,12 @@ IoProvider::recvMessage(
     throw std::runtime_error("Message truncated");
   }
 
-  // grab the inIndex we received this packet on and the hopLimit
+  // grab the ifIndex we received this packet on and the hopLimit
   // those are available since we requested them via socket options
-  struct cmsghdr* cmsg{nullptr};
   int ifIndex{-1};
   int hopLimit{0};
-
-  // use user space timestamp if kernel timestamp is not found
-  std::chrono::microseconds recvTs{
-      std::chrono::duration_cast<std::chrono::microseconds>(
-          std::chrono::system_clock::now().time_since_epoch())};
-
-  for (cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
-    if (cmsg->cmsg_level == IPPROTO_IPV6) {
-      if (cmsg->cmsg_type == IPV6_PKTINFO) {
-        struct in6_pktinfo pktinfo;
-        memcpy(
-            reinterpret_cast<void*>(&pktinfo),
-            CMSG_DATA(cmsg),
-            sizeof(pktinfo));
-        ifIndex = pktinfo.ipi6_ifindex;
-      } else if (cmsg->cmsg_type == IPV6_HOPLIMIT) {
-        memcpy(
-            reinterpret_cast<void*>(&hopLimit),
-            CMSG_DATA(cmsg),
-            sizeof(hopLimit));
-      }
-    }
-    if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_TIMESTAMPNS) {
-      struct timespec ts {
-        0, 0
-      };
-      memcpy(reinterpret_cast<void*>(&ts), CMSG_DATA(cmsg), sizeof(ts));
-
-      // cast to int64_t since ts.tv_sec is 32 bits on some platforms like arm
-      const int64_t usecs =
-          static_cast<int64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
-      const std::chrono::microseconds kernelRecvTs(usecs);
-
-      // sanity check
-      DCHECK(recvTs >= kernelRecvTs) << "Time anomaly";
-      VLOG(4) << "Got kernel-timestamp. It took "
-              << (recvTs - kernelRecvTs).count()
-              << " us for the packet to get from kernel to user space";
-      recvTs = kernelRecvTs;
-    }
-  } // for
+  std::chrono::microseconds recvTs{0};
+  std::tie(ifIndex, hopLimit, recvTs) = parseAncillaryData(msg);
 
   // build the source socket address from recvmsg data
   folly::SocketAddress srcAddr{};
@@ -188,6 +227,74 @@ IoProvider::recvMessage(
   return std::make_tuple(bytesRead, ifIndex, srcAddr, hopLimit, recvTs);
 }
 
+const std::vector<IoProvider::RecvdMessage>&
+IoProvider::recvMessages(
+    int fd,
+    unsigned char* buf,
+    int mtu,
+    size_t maxMessages,
+    RecvScratch& scratch,
+    IoProvider* ioProvider) {
+  auto& msgvec = scratch.msgvec;
+  auto& entries = scratch.entries;
+  auto& ctrlBufs = scratch.ctrlBufs;
+  auto& addrStorages = scratch.addrStorages;
+
+  // grow-only; no-ops at steady state
+  msgvec.resize(maxMessages);
+  entries.resize(maxMessages);
+  ctrlBufs.resize(maxMessages);
+  addrStorages.resize(maxMessages);
+
+  // the kernel both reads and writes these headers, so they are
+  // re-initialized on every call - in place, without allocating
+  ::memset(msgvec.data(), 0, maxMessages * sizeof(struct mmsghdr));
+  ::memset(ctrlBufs.data(), 0, maxMessages * sizeof(RecvScratch::CtrlBuf));
+  ::memset(addrStorages.data(), 0, maxMessages * sizeof(sockaddr_storage));
+
+  for (size_t i = 0; i < maxMessages; ++i) {
+    auto& msg = msgvec[i].msg_hdr;
+    entries[i].iov_base = buf + i * mtu;
+    entries[i].iov_len = mtu;
+    msg.msg_iov = &entries[i];
+    msg.msg_iovlen = 1;
+    msg.msg_control = ctrlBufs[i].buf;
+    msg.msg_controllen = sizeof(ctrlBufs[i].buf);
+    msg.msg_name = &addrStorages[i];
+    msg.msg_namelen = sizeof(sockaddr_storage);
+  }
+
+  int numMsgs = ioProvider->recvmmsg(
+      fd, msgvec.data(), maxMessages, MSG_DONTWAIT, nullptr);
+
+  if (numMsgs < 0) {
+    scratch.messages.clear();
+    throw std::runtime_error(folly::sformat(
+        "Failed reading messages on fd {}: {}", fd, folly::errnoStr(errno)));
+  }
+
+  auto& recvdMsgs = scratch.messages;
+  recvdMsgs.clear();
+  recvdMsgs.resize(numMsgs);
+  for (int i = 0; i < numMsgs; ++i) {
+    auto& msg = msgvec[i].msg_hdr;
+    auto& recvdMsg = recvdMsgs[i];
+    if (msg.msg_flags & MSG_TRUNC) {
+      // flag the message instead of throwing so the rest of the batch is
+      // still delivered
+      recvdMsg.truncated = true;
+      continue;
+    }
+    recvdMsg.size = msgvec[i].msg_len;
+    std::tie(recvdMsg.ifIndex, recvdMsg.hopLimit, recvdMsg.recvTs) =
+        parseAncillaryData(msg);
+    // this will throw if sender address was not filled in
+    recvdMsg.srcAddr.setFromSockaddr(
+        reinterpret_cast<struct sockaddr*>(&addrStorages[i]));
+  }
+  return recvdMsgs;
+}
+
 ssize_t
 IoProvider::sendMessage(
     int fd,
@@ -239,4 +346,62 @@ IoProvider::sendMessage(
   return ioProvider->sendmsg(fd, &msg, MSG_DONTWAIT);
 }
 
+int
+IoProvider::sendMessages(
+    int fd,
+    const std::vector<OutboundMessage>& messages,
+    IoProvider* ioProvider) {
+  if (messages.empty()) {
+    return 0;
+  }
+
+  // per-message control buffer, aligned by control message hdr
+  union CtrlBuf {
+    char buf[CMSG_SPACE(sizeof(struct in6_pktinfo))];
+    struct cmsghdr align;
+  };
+
+  size_t const numMsgs = messages.size();
+  std::vector<struct mmsghdr> msgvec(numMsgs);
+  std::vector<struct iovec> entries(numMsgs);
+  std::vector<CtrlBuf> ctrlBufs(numMsgs);
+  std::vector<sockaddr_storage> addrStorages(numMsgs);
+
+  ::memset(msgvec.data(), 0, numMsgs * sizeof(struct mmsghdr));
+  ::memset(ctrlBufs.data(), 0, numMsgs * sizeof(CtrlBuf));
+
+  for (size_t i = 0; i < numMsgs; ++i) {
+    auto const& message = messages[i];
+    auto& msg = msgvec[i].msg_hdr;
+
+    // Set the destination address for the message
+    message.dstAddr.getAddress(&addrStorages[i]);
+    msg.msg_name = reinterpret_cast<void*>(&addrStorages[i]);
+    msg.msg_namelen = message.dstAddr.getActualSize();
+
+    // set the source address and source if index for this message
+    msg.msg_control = ctrlBufs[i].buf;
+    msg.msg_controllen = sizeof(ctrlBufs[i].buf);
+    auto* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = IPPROTO_IPV6;
+    cmsg->cmsg_type = IPV6_PKTINFO;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(struct in6_pktinfo));
+
+    auto pktinfo = (struct in6_pktinfo*)CMSG_DATA(cmsg);
+    pktinfo->ipi6_ifindex = message.ifIndex;
+    ::memcpy(
+        &pktinfo->ipi6_addr,
+        message.srcAddr.bytes(),
+        message.srcAddr.byteCount());
+
+    // the payload is shared with the caller, not copied
+    entries[i].iov_base = const_cast<char*>(message.payload.data());
+    entries[i].iov_len = message.payload.size();
+    msg.msg_iov = &entries[i];
+    msg.msg_iovlen = 1;
+  }
+
+  return ioProvider->sendmmsg(fd, msgvec.data(), numMsgs, MSG_DONTWAIT);
+}
+
 } // namespace openr
@@ -13,8 +13,10 @@
 #include <sys/types.h>
 #include <unistd.h>
 #include <chrono>
+#include <vector>
 
 #include <folly/IPAddress.h>
+#include <folly/Range.h>
 #include <folly/SocketAddress.h>
 
 namespace openr {
@@ -59,6 +61,16 @@ class IoProvider {
 
   virtual ssize_t sendmsg(int sockfd, const struct msghdr* msg, int flags);
 
+  virtual int recvmmsg(
+      int sockfd,
+      struct mmsghdr* msgvec,
+      unsigned int vlen,
+      int flags,
+      struct timespec* timeout);
+
+  virtual int sendmmsg(
+      int sockfd, struct mmsghdr* msgvec, unsigned int vlen, int flags);
+
   virtual int setsockopt(
       int sockfd, int level, int optname, const void* optval, socklen_t optlen);
 
@@ -76,6 +88,49 @@ class IoProvider {
       std::chrono::microseconds /* kernel timestamp */>
   recvMessage(int fd, unsigned char* buf, int len, IoProvider* ioProvider);
 
+  // metadata of one message delivered by recvMessages()
+  struct RecvdMessage {
+    ssize_t size{0};
+    int ifIndex{-1};
+    folly::SocketAddress srcAddr;
+    int hopLimit{0};
+    std::chrono::microseconds recvTs{0};
+    bool truncated{false};
+  };
+
+  // caller-owned scratch space for recvMessages(): the result entries and
+  // the per-message syscall scaffolding, reused across calls so the
+  // steady-state receive path does not allocate
+  struct RecvScratch {
+    // per-message control buffer, aligned by control message hdr
+    union CtrlBuf {
+      char buf[CMSG_SPACE(1024)];
+      struct cmsghdr align;
+    };
+
+    std::vector<RecvdMessage> messages;
+    std::vector<struct mmsghdr> msgvec;
+    std::vector<struct iovec> entries;
+    std::vector<CtrlBuf> ctrlBufs;
+    std::vector<struct sockaddr_storage> addrStorages;
+  };
+
+  /*
+   * Receive up to maxMessages messages on fd with a single recvmmsg
+   * syscall. buf must hold maxMessages * mtu bytes; the i-th message is
+   * written at buf + i * mtu and described by the i-th result entry, in
+   * arrival order. Results live in scratch.messages (also returned for
+   * convenience); once the scratch has grown to maxMessages no further
+   * allocation happens
+   */
+  static const std::vector<RecvdMessage>& recvMessages(
+      int fd,
+      unsigned char* buf,
+      int mtu,
+      size_t maxMessages,
+      RecvScratch& scratch,
+      IoProvider* ioProvider);
+
   /*
    * Send message on fd via given interface to the address provided
    * We supply socket address, which has dst IPv6 and port
@@ -88,6 +143,26 @@ class IoProvider {
       std::string const& packet,
       IoProvider* ioProvider);
 
+  // one message to be sent by sendMessages(). The payload is referenced,
+  // not copied - it must stay alive for the duration of the call, and may
+  // be shared across messages
+  struct OutboundMessage {
+    int ifIndex{-1};
+    folly::IPAddressV6 srcAddr;
+    folly::SocketAddress dstAddr;
+    folly::StringPiece payload;
+  };
+
+  /*
+   * Send all given messages with a single sendmmsg syscall. Returns the
+   * number of messages actually sent (possibly fewer than requested), or
+   * -1 with errno set if nothing could be sent
+   */
+  static int sendMessages(
+      int fd,
+      const std::vector<OutboundMessage>& messages,
+      IoProvider* ioProvider);
+
  private:
   IoProvider(IoProvider const&) = delete;
   IoProvider& operator=(IoProvider const&) = delete;
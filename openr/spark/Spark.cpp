@@ -15,18 +15,21 @@
 #include <fcntl.h>
 #include <algorithm>
 #include <functional>
+#include <thread>
 #include <vector>
 
 #include <fb303/ServiceData.h>
 #include <fbzmq/service/if/gen-cpp2/Monitor_types.h>
 #include <fbzmq/service/logging/LogSample.h>
 #include <fbzmq/zmq/Zmq.h>
+#include <folly/ExceptionWrapper.h>
 #include <folly/GLog.h>
 #include <folly/IPAddress.h>
 #include <folly/MapUtil.h>
 #include <folly/ScopeGuard.h>
 #include <folly/SocketAddress.h>
 #include <folly/String.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/fibers/FiberManagerMap.h>
 #include <folly/futures/Future.h>
 #include <folly/futures/Promise.h>
@@ -48,6 +51,32 @@ namespace {
 //
 const int kMinIpv6Mtu = 1280;
 
+//
+// Maximum number of packets drained with one recvmmsg syscall. Heartbeats
+// from all neighbors on dense boxes arrive in synchronized bursts, so
+// batching amortizes the per-packet syscall and event-loop overhead
+//
+const size_t kRecvBatchSize = 64;
+
+//
+// Deserialize a batch on the parse pool only when it is at least this big;
+// smaller bursts are cheaper to decode inline than to dispatch
+//
+const size_t kMinPktsForParallelParse = 8;
+
+//
+// Number of heartbeats a neighbor should receive within every hold
+// window. Ties adaptive send intervals to the hold times we advertise
+//
+const int64_t kNumHeartbeatsPerHoldTime = 3;
+
+//
+// In adaptive keepalive mode the hold time advertised to a neighbor
+// scales linearly with the latest measured RTT by this factor (e.g. 1ms
+// RTT -> 100ms hold), clamped to the configured bounds
+//
+const int64_t kRttToHoldTimeFactor = 100;
+
 //
 // The acceptable hop limit, assuming we send packets with this TTL
 //
@@ -71,6 +100,50 @@ const int64_t kAbsThreshold = 500;
 // number of restarting packets to send out per interface before I'm going down
 const int kNumRestartingPktSent = 3;
 
+//
+// zigzag varint codec as used by thrift compact protocol for i64 fields,
+// so hello templates can patch individual fields in the serialized bytes
+// without re-serializing the whole packet
+//
+uint64_t
+toZigzag(int64_t val) {
+  return (static_cast<uint64_t>(val) << 1) ^ static_cast<uint64_t>(val >> 63);
+}
+
+int64_t
+fromZigzag(uint64_t val) {
+  return static_cast<int64_t>(val >> 1) ^ -static_cast<int64_t>(val & 1);
+}
+
+size_t
+varintLen(uint64_t val) {
+  size_t len = 1;
+  while (val >= 0x80) {
+    val >>= 7;
+    ++len;
+  }
+  return len;
+}
+
+void
+writeVarint(char* buf, uint64_t val, size_t len) {
+  for (size_t i = 0; i + 1 < len; ++i) {
+    buf[i] = static_cast<char>(0x80 | (val & 0x7f));
+    val >>= 7;
+  }
+  buf[len - 1] = static_cast<char>(val & 0x7f);
+}
+
+// flip every payload bit of a zigzag value's varint encoding. Barring the
+// all-ones top group, the result encodes to the same byte length with
+// every byte differing from the original's
+uint64_t
+flipVarintPayload(uint64_t val) {
+  const size_t len = varintLen(val);
+  const uint64_t mask = len >= 10 ? ~0ull : (1ull << (7 * len)) - 1;
+  return val ^ mask;
+}
+
 //
 // Function to get current timestamp in microseconds using steady clock
 // NOTE: we use non-monotonic clock since kernel time-stamps do not support
@@ -490,6 +563,11 @@ Spark::prepareSocket(std::optional<int> maybeIpTos) noexcept {
 
   LOG(INFO) << "Spark thread attaching socket/events callbacks...";
 
+  // allocate the batched receive buffer up front
+  recvBuf_.resize(kRecvBatchSize * kMinIpv6Mtu);
+  helloPackets_.reserve(kRecvBatchSize);
+  parseErrors_.reserve(kRecvBatchSize);
+
   // Listen for incoming messages on multicast FD
   addSocketFd(mcastFd_, ZMQ_POLLIN, [this](int) noexcept {
     try {
@@ -500,6 +578,16 @@ Spark::prepareSocket(std::optional<int> maybeIpTos) noexcept {
     }
   });
 
+  // send heartbeats on all interfaces with active neighbors as one
+  // batched burst per period, instead of one timer + syscall per interface
+  heartbeatTimer_ = folly::AsyncTimeout::make(*getEvb(), [this]() noexcept {
+    // sendHeartbeatMsgs() re-arms the timer itself - periodically with
+    // the static interval, or with the earliest per-interface deadline
+    // when adaptive keepalive is enabled
+    sendHeartbeatMsgs();
+  });
+  heartbeatTimer_->scheduleTimeout(myHeartbeatTime_);
+
   // update counters every few seconds
   counterUpdateTimer_ = folly::AsyncTimeout::make(*getEvb(), [this]() noexcept {
     updateGlobalCounters();
@@ -509,6 +597,15 @@ Spark::prepareSocket(std::optional<int> maybeIpTos) noexcept {
   counterUpdateTimer_->scheduleTimeout(Constants::kCounterSubmitInterval);
 }
 
+Spark::AreaMatcher::AreaMatcher() {
+  re2::RE2::Options regexOpts;
+  regexOpts.set_case_sensitive(false);
+  neighborRegexSet =
+      std::make_unique<re2::RE2::Set>(regexOpts, re2::RE2::ANCHOR_BOTH);
+  interfaceRegexSet =
+      std::make_unique<re2::RE2::Set>(regexOpts, re2::RE2::ANCHOR_BOTH);
+}
+
 void
 Spark::addAreaRegex(
     const std::string& areaId,
@@ -517,48 +614,36 @@ Spark::addAreaRegex(
   CHECK(not(neighborRegexes.empty() and interfaceRegexes.empty()))
       << "Invalid config. At least one non-empty regexes for neighbor or interface";
 
-  re2::RE2::Options regexOpts;
-  regexOpts.set_case_sensitive(false);
+  const size_t areaIndex = areaMatcher_.areaIds.size();
+  areaMatcher_.areaIds.emplace_back(areaId);
+  areaMatcher_.hasNeighborRegex.push_back(not neighborRegexes.empty());
+  areaMatcher_.hasInterfaceRegex.push_back(not interfaceRegexes.empty());
+
   std::string regexErr;
-  std::shared_ptr<re2::RE2::Set> neighborRegexList{nullptr},
-      interfaceRegexList{nullptr};
 
   // neighbor regex
-  if (not neighborRegexes.empty()) {
-    neighborRegexList =
-        std::make_shared<re2::RE2::Set>(regexOpts, re2::RE2::ANCHOR_BOTH);
-
-    for (const auto& regexStr : neighborRegexes) {
-      if (-1 == neighborRegexList->Add(regexStr, &regexErr)) {
-        LOG(FATAL) << folly::sformat(
-            "Failed to add neighbor regex: {} for area: {}. Error: {}",
-            regexStr,
-            areaId,
-            regexErr);
-      }
+  for (const auto& regexStr : neighborRegexes) {
+    if (-1 == areaMatcher_.neighborRegexSet->Add(regexStr, &regexErr)) {
+      LOG(FATAL) << folly::sformat(
+          "Failed to add neighbor regex: {} for area: {}. Error: {}",
+          regexStr,
+          areaId,
+          regexErr);
     }
-    CHECK(neighborRegexList->Compile()) << "Neighbor regex compilation failed";
+    areaMatcher_.neighborPatternToArea.emplace_back(areaIndex);
   }
 
   // interface regex
-  if (not interfaceRegexes.empty()) {
-    interfaceRegexList =
-        std::make_shared<re2::RE2::Set>(regexOpts, re2::RE2::ANCHOR_BOTH);
-
-    for (const auto& regexStr : interfaceRegexes) {
-      if (-1 == interfaceRegexList->Add(regexStr, &regexErr)) {
-        LOG(FATAL) << folly::sformat(
-            "Failed to add interface regex: {} for area: {}. Error: {}",
-            regexStr,
-            areaId,
-            regexErr);
-      }
+  for (const auto& regexStr : interfaceRegexes) {
+    if (-1 == areaMatcher_.interfaceRegexSet->Add(regexStr, &regexErr)) {
+      LOG(FATAL) << folly::sformat(
+          "Failed to add interface regex: {} for area: {}. Error: {}",
+          regexStr,
+          areaId,
+          regexErr);
     }
-    CHECK(interfaceRegexList->Compile())
-        << "Interface regex compilation failed";
+    areaMatcher_.interfacePatternToArea.emplace_back(areaIndex);
   }
-  areaIdRegexList_.emplace_back(std::make_tuple(
-      areaId, std::move(neighborRegexList), std::move(interfaceRegexList)));
 }
 
 // parse openrConfig to initialize:
@@ -570,14 +655,42 @@ Spark::loadConfig() {
     // global openrConfig_ NOT supported yet. To make regex backward compatible:
     // defaultArea => anything(".*") for backward compatible
     addAreaRegex(thrift::KvStore_constants::kDefaultArea(), {".*"}, {".*"});
+  } else {
+    for (const auto& areaConfig : config_->areas) {
+      addAreaRegex(
+          areaConfig.area_id,
+          areaConfig.neighbor_regexes,
+          areaConfig.interface_regexes);
+    }
+  }
+
+  // compile the combined area automaton exactly once; hello processing
+  // only ever matches against it from here on
+  if (not areaMatcher_.neighborPatternToArea.empty()) {
+    CHECK(areaMatcher_.neighborRegexSet->Compile())
+        << "Neighbor regex compilation failed";
+  }
+  if (not areaMatcher_.interfacePatternToArea.empty()) {
+    CHECK(areaMatcher_.interfaceRegexSet->Compile())
+        << "Interface regex compilation failed";
+  }
+
+  if (not config_) {
     return;
   }
 
-  for (const auto& areaConfig : config_->areas) {
-    addAreaRegex(
-        areaConfig.area_id,
-        areaConfig.neighbor_regexes,
-        areaConfig.interface_regexes);
+  // adaptive keepalive mode and its bounds
+  const auto& sparkConfig = config_->spark_config;
+  enableAdaptiveKeepalive_ = sparkConfig.enable_adaptive_keepalive;
+  myMinKeepaliveTime_ =
+      std::chrono::milliseconds(sparkConfig.min_keepalive_time_ms);
+  myMinHoldTime_ = std::chrono::milliseconds(sparkConfig.min_hold_time_ms);
+  if (enableAdaptiveKeepalive_) {
+    CHECK(myMinHoldTime_ >= kNumHeartbeatsPerHoldTime * myMinKeepaliveTime_)
+        << "Minimum hold time must cover " << kNumHeartbeatsPerHoldTime
+        << " keepalives";
+    CHECK(myMinKeepaliveTime_ > std::chrono::milliseconds(0))
+        << "Minimum keepalive interval must be positive";
   }
 }
 
@@ -623,32 +736,34 @@ Spark::shouldProcessHelloPacket(
                      std::make_tuple(ifName, addr)) %
       Constants::kNumTimeSeries;
 
-  // check our timeseries to see if we want to process anymore right now
-  timeSeriesVector_[index].update(std::chrono::steady_clock::now());
+  // check our timeseries to see if we want to process anymore right now.
+  // Runs once per received packet - the cached coarse clock is plenty
+  // accurate for pps accounting
+  timeSeriesVector_[index].update(getCoarseTime());
   if (timeSeriesVector_[index].count() > Constants::kMaxAllowedPps) {
     // drop the packet
     return false;
   }
   // otherwise, count this packet and process it
-  timeSeriesVector_[index].addValue(std::chrono::steady_clock::now(), 1);
+  timeSeriesVector_[index].addValue(getCoarseTime(), 1);
   return true;
 }
 
 bool
 Spark::parsePacket(
-    thrift::SparkHelloPacket& pkt,
     std::string& ifName,
-    std::chrono::microseconds& recvTime) {
-  // the read buffer
-  uint8_t buf[kMinIpv6Mtu];
-
-  ssize_t bytesRead;
-  int ifIndex;
-  folly::SocketAddress clientAddr;
-  int hopLimit;
+    std::chrono::microseconds& recvTime,
+    IoProvider::RecvdMessage const& recvdMsg) {
+  if (recvdMsg.truncated) {
+    LOG(ERROR) << "Received truncated message. Ignoring the packet.";
+    return false;
+  }
 
-  std::tie(bytesRead, ifIndex, clientAddr, hopLimit, recvTime) =
-      IoProvider::recvMessage(mcastFd_, buf, kMinIpv6Mtu, ioProvider_.get());
+  ssize_t const bytesRead = recvdMsg.size;
+  int const ifIndex = recvdMsg.ifIndex;
+  folly::SocketAddress const& clientAddr = recvdMsg.srcAddr;
+  int const hopLimit = recvdMsg.hopLimit;
+  recvTime = recvdMsg.recvTs;
 
   if (hopLimit < kSparkHopLimit) {
     LOG(ERROR) << "Rejecting packet from " << clientAddr.getAddressStr()
@@ -699,15 +814,6 @@ Spark::parsePacket(
     return false;
   }
 
-  // Copy buffer into string object and parse it into helloPacket.
-  std::string readBuf(reinterpret_cast<const char*>(&buf[0]), bytesRead);
-  try {
-    pkt = fbzmq::util::readThriftObjStr<thrift::SparkHelloPacket>(
-        readBuf, serializer_);
-  } catch (std::exception const& err) {
-    LOG(ERROR) << "Failed parsing hello packet " << folly::exceptionStr(err);
-    return false;
-  }
   return true;
 }
 
@@ -716,12 +822,13 @@ Spark::validateV4AddressSubnet(
     std::string const& ifName, thrift::BinaryAddress neighV4Addr) {
   // validate v4 address subnet
   // make sure v4 address is already specified on neighbor
-  auto const& myV4Network = interfaceDb_.at(ifName).v4Network;
-  auto const& myV4Addr = myV4Network.first;
-  auto const& myV4PrefixLen = myV4Network.second;
+  auto const& interfaceEntry = interfaceDb_.at(ifName);
+  auto const& myV4Addr = interfaceEntry.v4Network.first;
+  auto const& myV4PrefixLen = interfaceEntry.v4Network.second;
 
+  folly::IPAddress neighAddr;
   try {
-    toIPAddress(neighV4Addr);
+    neighAddr = toIPAddress(neighV4Addr);
   } catch (const folly::IPAddressFormatException& ex) {
     LOG(ERROR) << "Neighbor V4 address is not known";
     fb303::fbData->addStatValue(
@@ -729,12 +836,11 @@ Spark::validateV4AddressSubnet(
     return PacketValidationResult::FAILURE;
   }
 
-  // validate subnet of v4 address
-  auto const& neighCidrNetwork =
-      folly::sformat("{}/{}", toString(neighV4Addr), myV4PrefixLen);
-
-  if (!myV4Addr.inSubnet(neighCidrNetwork)) {
-    LOG(ERROR) << "Neighbor V4 address " << toString(neighV4Addr)
+  // validate subnet of v4 address against the subnet derived once at
+  // interface addition, sparing each handshake the round-trip through
+  // "addr/len" text formatting and re-parsing
+  if (neighAddr.mask(myV4PrefixLen) != interfaceEntry.v4Subnet) {
+    LOG(ERROR) << "Neighbor V4 address " << neighAddr.str()
                << " is not in the same subnet with local V4 address "
                << myV4Addr.str() << "/" << +myV4PrefixLen;
     fb303::fbData->addStatValue(
@@ -871,11 +977,33 @@ Spark::sendHandshakeMsg(
   const auto v4Addr = interfaceEntry.v4Network.first;
   const auto v6Addr = interfaceEntry.v6LinkLocalNetwork.first;
 
+  // promise the static hold time, or an RTT-scaled one in adaptive
+  // keepalive mode: low-RTT links get (and can sustain) tight failure
+  // detection, while high-RTT or lossy links keep the relaxed static hold.
+  // RTT is measured from the hello exchange, which precedes negotiation
+  auto holdTime = myHeartbeatHoldTime_;
+  if (enableAdaptiveKeepalive_) {
+    auto& neighbor = sparkNeighbors_.at(ifName).at(neighborName);
+    if (neighbor.rttLatest.count() > 0) {
+      holdTime = std::clamp(
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              neighbor.rttLatest * kRttToHoldTimeFactor),
+          myMinHoldTime_,
+          myHeartbeatHoldTime_);
+    }
+    // never relax a promise once made - the tightest hold ever advertised
+    // caps our send interval (see getHeartbeatInterval)
+    if (neighbor.advertisedHoldTime.count() != 0) {
+      holdTime = std::min(holdTime, neighbor.advertisedHoldTime);
+    }
+    neighbor.advertisedHoldTime = holdTime;
+  }
+
   // build handshake msg
   thrift::SparkHandshakeMsg handshakeMsg;
   handshakeMsg.nodeName = myNodeName_;
   handshakeMsg.isAdjEstablished = isAdjEstablished;
-  handshakeMsg.holdTime = myHeartbeatHoldTime_.count();
+  handshakeMsg.holdTime = holdTime.count();
   handshakeMsg.gracefulRestartTime = myGracefulRestartHoldTime_.count();
   handshakeMsg.transportAddressV6 = toBinaryAddress(v6Addr);
   handshakeMsg.transportAddressV4 = toBinaryAddress(v4Addr);
@@ -914,31 +1042,34 @@ Spark::sendHandshakeMsg(
 }
 
 void
-Spark::sendHeartbeatMsg(std::string const& ifName) {
+Spark::sendHeartbeatMsgs() {
+  // timeout for the next burst; tightened below per interface when
+  // adaptive keepalive is enabled
+  std::chrono::milliseconds nextTimeout = myHeartbeatTime_;
+
   SCOPE_EXIT {
-    // increment seq# after packet has been sent (even if it didnt go out)
+    // always re-arm the shared timer, whichever way we leave
+    heartbeatTimer_->scheduleTimeout(nextTimeout);
+  };
+
+  SCOPE_EXIT {
+    // increment seq# after packets have been sent (even if they didnt go out)
     ++mySeqNum_;
   };
 
   SCOPE_FAIL {
-    LOG(ERROR) << "Failed sending Heartbeat packet on " << ifName;
+    LOG(ERROR) << "Failed sending Heartbeat packets";
   };
 
-  if (ifNameToActiveNeighbors_.find(ifName) == ifNameToActiveNeighbors_.end()) {
-    VLOG(3) << "Interface: " << ifName
-            << " hasn't have any active neighbor yet."
+  if (ifNameToActiveNeighbors_.empty()) {
+    VLOG(3) << "No interface has any active neighbor yet."
             << " Skip sending out heartbeatMsg.";
     return;
   }
 
-  // in some cases, getting link-local address may fail and throw
-  // e.g. when iface has not yet auto-configured it, or iface is removed but
-  // down event has not arrived yet
-  const auto& interfaceEntry = interfaceDb_.at(ifName);
-  const auto ifIndex = interfaceEntry.ifIndex;
-  const auto v6Addr = interfaceEntry.v6LinkLocalNetwork.first;
-
-  // build heartbeat msg
+  // build heartbeat msg and serialize it ONCE - the payload is identical
+  // across interfaces, only ifIndex and source address differ and those
+  // live in the ancillary data
   thrift::SparkHeartbeatMsg heartbeatMsg;
   heartbeatMsg.nodeName = myNodeName_;
   heartbeatMsg.seqNum = mySeqNum_;
@@ -948,28 +1079,82 @@ Spark::sendHeartbeatMsg(std::string const& ifName) {
 
   auto packet = fbzmq::util::writeThriftObjStr(pkt, serializer_);
 
-  // send the pkt
   folly::SocketAddress dstAddr(
       folly::IPAddress(Constants::kSparkMcastAddr.toString()), udpMcastPort_);
 
   if (kMinIpv6Mtu < packet.size()) {
-    LOG(ERROR) << "Handshake packet is too big, can't send it out.";
+    LOG(ERROR) << "Heartbeat packet is too big, can't send it out.";
     return;
   }
 
-  auto bytesSent = IoProvider::sendMessage(
-      mcastFd_, ifIndex, v6Addr.asV6(), dstAddr, packet, ioProvider_.get());
+  // batch one message per interface with active neighbors
+  const auto now = std::chrono::steady_clock::now();
+  std::vector<IoProvider::OutboundMessage> messages;
+  messages.reserve(ifNameToActiveNeighbors_.size());
+  for (const auto& kv : ifNameToActiveNeighbors_) {
+    auto const& ifName = kv.first;
+    auto it = interfaceDb_.find(ifName);
+    if (it == interfaceDb_.end()) {
+      LOG(ERROR) << "Interface " << ifName << " is no longer being tracked";
+      continue;
+    }
+    if (enableAdaptiveKeepalive_) {
+      // interfaces beat at different rates in adaptive mode; skip those
+      // whose beat is not due yet and keep tracking the earliest deadline
+      auto& nextBeat = ifNameToNextHeartbeatTime_[ifName];
+      if (now < nextBeat) {
+        nextTimeout = std::min(
+            nextTimeout,
+            std::chrono::ceil<std::chrono::milliseconds>(nextBeat - now));
+        continue;
+      }
+      const auto interval = getHeartbeatInterval(ifName);
+      nextBeat = now + interval;
+      nextTimeout = std::min(nextTimeout, interval);
+    }
+    IoProvider::OutboundMessage message;
+    message.ifIndex = it->second.ifIndex;
+    message.srcAddr = it->second.v6LinkLocalNetwork.first.asV6();
+    message.dstAddr = dstAddr;
+    message.payload = packet;
+    messages.emplace_back(std::move(message));
+  }
 
-  if ((bytesSent < 0) || (static_cast<size_t>(bytesSent) != packet.size())) {
+  // send the whole burst with a single syscall
+  auto numSent = IoProvider::sendMessages(mcastFd_, messages, ioProvider_.get());
+
+  if (numSent < 0 || static_cast<size_t>(numSent) != messages.size()) {
     VLOG(1) << "Sending multicast to " << dstAddr.getAddressStr() << " on "
-            << ifName << " failed due to error " << folly::errnoStr(errno);
-    return;
+            << (numSent < 0 ? messages.size() : messages.size() - numSent)
+            << " interfaces failed due to error " << folly::errnoStr(errno);
   }
 
   // update counters for number of pkts and total size of pkts sent
+  auto const numPktsSent = numSent < 0 ? 0 : numSent;
+  fb303::fbData->addStatValue(
+      "spark.heartbeat.bytes_sent", numPktsSent * packet.size(), fb303::SUM);
   fb303::fbData->addStatValue(
-      "spark.heartbeat.bytes_sent", packet.size(), fb303::SUM);
-  fb303::fbData->addStatValue("spark.heartbeat.packets_sent", 1, fb303::SUM);
+      "spark.heartbeat.packets_sent", numPktsSent, fb303::SUM);
+}
+
+std::chrono::milliseconds
+Spark::getHeartbeatInterval(std::string const& ifName) {
+  CHECK(enableAdaptiveKeepalive_);
+
+  // keep kNumHeartbeatsPerHoldTime beats inside the tightest hold time we
+  // have promised to any neighbor on this interface. A promise is kept
+  // even if the link RTT later degrades - that only costs extra packets
+  auto interval = myHeartbeatTime_;
+  const auto it = sparkNeighbors_.find(ifName);
+  if (it != sparkNeighbors_.end()) {
+    for (const auto& kv : it->second) {
+      const auto& advertised = kv.second.advertisedHoldTime;
+      if (advertised.count() != 0) {
+        interval = std::min(interval, advertised / kNumHeartbeatsPerHoldTime);
+      }
+    }
+  }
+  return std::max(interval, myMinKeepaliveTime_);
 }
 
 void
@@ -1033,7 +1218,7 @@ Spark::neighborUpWrapper(
   neighbor.negotiateHoldTimer.reset();
 
   // create heartbeat hold timer when promote to "ESTABLISHED"
-  neighbor.heartbeatHoldTimer = folly::AsyncTimeout::make(
+  neighbor.heartbeatHoldTimer = WheelTimeout::make(
       *getEvb(), [this, ifName, neighborName]() noexcept {
         processHeartbeatTimeout(ifName, neighborName);
       });
@@ -1111,6 +1296,8 @@ Spark::processHeartbeatTimeout(
   SCOPE_EXIT {
     allocatedLabels_.erase(neighbor.label);
     ifNeighbors.erase(neighborName);
+    // outgoing hellos no longer reflect this neighbor
+    ++helloContentVersion_;
   };
 
   LOG(INFO) << "Heartbeat timer expired for: " << neighborName
@@ -1163,6 +1350,8 @@ Spark::processGRTimeout(
   SCOPE_EXIT {
     allocatedLabels_.erase(neighbor.label);
     ifNeighbors.erase(neighborName);
+    // outgoing hellos no longer reflect this neighbor
+    ++helloContentVersion_;
   };
 
   LOG(INFO) << "Graceful restart timer expired for: " << neighborName
@@ -1196,7 +1385,7 @@ Spark::processGRMsg(
       neighbor.area);
 
   // start graceful-restart timer
-  neighbor.gracefulRestartHoldTimer = folly::AsyncTimeout::make(
+  neighbor.gracefulRestartHoldTimer = WheelTimeout::make(
       *getEvb(), [this, ifName, neighborName]() noexcept {
         // change the state back to IDLE
         processGRTimeout(ifName, neighborName);
@@ -1254,8 +1443,9 @@ Spark::processHelloMsg(
     // deduce area for neighbor
     // TODO: Spark is yet to support area change due to dynamic configuration.
     //       To avoid running area deducing logic for every single helloMsg,
-    //       ONLY deduce for unknown neighbors.
-    auto area = getNeighborArea(neighborName, ifName, areaIdRegexList_);
+    //       ONLY deduce for unknown neighbors - and even then through the
+    //       memoized resolution cache.
+    auto area = deduceNeighborArea(neighborName, ifName);
     if (not area.has_value()) {
       return;
     }
@@ -1283,6 +1473,10 @@ Spark::processHelloMsg(
     checkNeighborState(neighbor, SparkNeighState::IDLE);
   }
 
+  // anything below - reflected seq#/timestamps, the neighbor set itself -
+  // is baked into outgoing hellos, so their templates go stale here
+  ++helloContentVersion_;
+
   // Up till now, node knows about this neighbor and perform SM check
   auto& neighbor = ifNeighbors.at(neighborName);
 
@@ -1351,7 +1545,7 @@ Spark::processHelloMsg(
 
     // Starts timer to periodically send hankshake msg
     const std::string neighborAreaId = neighbor.area;
-    neighbor.negotiateTimer = folly::AsyncTimeout::make(
+    neighbor.negotiateTimer = WheelTimeout::make(
         *getEvb(), [this, ifName, neighborName, neighborAreaId]() noexcept {
           sendHandshakeMsg(ifName, neighborName, neighborAreaId, false);
           // send out handshake msg periodically to this neighbor
@@ -1367,7 +1561,7 @@ Spark::processHelloMsg(
     neighbor.negotiateTimer->scheduleTimeout(myHandshakeTime_);
 
     // Starts negotiate hold-timer
-    neighbor.negotiateHoldTimer = folly::AsyncTimeout::make(
+    neighbor.negotiateHoldTimer = WheelTimeout::make(
         *getEvb(), [this, ifName, neighborName]() noexcept {
           // prevent to stucking in NEGOTIATE forever
           processNegotiateTimeout(ifName, neighborName);
@@ -1443,7 +1637,7 @@ Spark::processHelloMsg(
         neighbor.area);
 
     // start heartbeat timer again to make sure neighbor is alive
-    neighbor.heartbeatHoldTimer = folly::AsyncTimeout::make(
+    neighbor.heartbeatHoldTimer = WheelTimeout::make(
         *getEvb(), [this, ifName, neighborName]() noexcept {
           processHeartbeatTimeout(ifName, neighborName);
         });
@@ -1534,9 +1728,17 @@ Spark::processHandshakeMsg(
   neighbor.transportAddressV4 = handshakeMsg.transportAddressV4;
   neighbor.transportAddressV6 = handshakeMsg.transportAddressV6;
 
-  // update neighbor holdTime as "NEGOTIATING" process
-  neighbor.heartbeatHoldTime = std::max(
-      std::chrono::milliseconds(handshakeMsg.holdTime), myHeartbeatHoldTime_);
+  // update neighbor holdTime as "NEGOTIATING" process. In adaptive
+  // keepalive mode honor a tighter-than-ours advertised hold time - the
+  // neighbor promises a matching send rate - flooring at the configured
+  // minimum; otherwise keep the conservative max
+  if (enableAdaptiveKeepalive_) {
+    neighbor.heartbeatHoldTime = std::max(
+        std::chrono::milliseconds(handshakeMsg.holdTime), myMinHoldTime_);
+  } else {
+    neighbor.heartbeatHoldTime = std::max(
+        std::chrono::milliseconds(handshakeMsg.holdTime), myHeartbeatHoldTime_);
+  }
   neighbor.gracefulRestartHoldTime = std::max(
       std::chrono::milliseconds(handshakeMsg.gracefulRestartTime),
       myGracefulRestartHoldTime_);
@@ -1638,22 +1840,88 @@ Spark::processHeartbeatMsg(
 
 void
 Spark::processPacket() {
-  // receive and parse pkt
-  thrift::SparkHelloPacket helloPacket;
-  std::string ifName;
-  std::chrono::microseconds myRecvTime;
+  // drain a whole batch of pkts with a single recvmmsg syscall, reusing
+  // the scratch scaffolding across cycles
+  auto const& recvdMsgs = IoProvider::recvMessages(
+      mcastFd_,
+      recvBuf_.data(),
+      kMinIpv6Mtu,
+      kRecvBatchSize,
+      recvScratch_,
+      ioProvider_.get());
+
+  // Speculatively deserialize every slot of the batch before any drop
+  // decision is taken. Each slot is an independent buffer and thrift decode
+  // is pure CPU work, so big batches (heartbeat bursts on dense boxes) are
+  // fanned out across the parse pool; decoding the occasional packet that
+  // later gets dropped is wasted work, but drops are the rare path. All
+  // shared state - interfaceDb_, the rate limiter, the neighbor FSMs - is
+  // only touched afterwards, in arrival order, on this thread. The
+  // per-slot scratch packets are reused across cycles; clear+resize
+  // refreshes them in place without giving back their capacity
+  helloPackets_.clear();
+  helloPackets_.resize(recvdMsgs.size());
+  parseErrors_.clear();
+  parseErrors_.resize(recvdMsgs.size());
+  const auto parseSlot = [&](size_t i) {
+    if (recvdMsgs[i].truncated or recvdMsgs[i].size < 0 or
+        static_cast<size_t>(recvdMsgs[i].size) > kMinIpv6Mtu) {
+      return; // parsePacket() drops these before the pkt is looked at
+    }
+    try {
+      serializer_.deserialize(
+          folly::ByteRange(
+              recvBuf_.data() + i * kMinIpv6Mtu,
+              static_cast<size_t>(recvdMsgs[i].size)),
+          helloPackets_[i]);
+    } catch (std::exception const& err) {
+      parseErrors_[i] = folly::exception_wrapper(std::current_exception(), err);
+    }
+  };
 
-  if (!parsePacket(helloPacket, ifName, myRecvTime)) {
-    return;
+  if (recvdMsgs.size() >= kMinPktsForParallelParse and
+      std::thread::hardware_concurrency() > 1) {
+    if (not pktParsePool_) {
+      pktParsePool_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+          std::min<size_t>(4, std::thread::hardware_concurrency()));
+    }
+    std::vector<folly::Future<folly::Unit>> parseFutures;
+    parseFutures.reserve(recvdMsgs.size());
+    for (size_t i = 0; i < recvdMsgs.size(); ++i) {
+      parseFutures.emplace_back(
+          folly::via(pktParsePool_.get(), [&parseSlot, i]() { parseSlot(i); }));
+    }
+    folly::collectAll(std::move(parseFutures)).get();
+  } else {
+    for (size_t i = 0; i < recvdMsgs.size(); ++i) {
+      parseSlot(i);
+    }
   }
 
-  // Spark specific msg processing
-  if (helloPacket.helloMsg_ref().has_value()) {
-    processHelloMsg(helloPacket.helloMsg_ref().value(), ifName, myRecvTime);
-  } else if (helloPacket.heartbeatMsg_ref().has_value()) {
-    processHeartbeatMsg(helloPacket.heartbeatMsg_ref().value(), ifName);
-  } else if (helloPacket.handshakeMsg_ref().has_value()) {
-    processHandshakeMsg(helloPacket.handshakeMsg_ref().value(), ifName);
+  for (size_t i = 0; i < recvdMsgs.size(); ++i) {
+    // validate pkt
+    std::string ifName;
+    std::chrono::microseconds myRecvTime;
+
+    if (!parsePacket(ifName, myRecvTime, recvdMsgs[i])) {
+      continue;
+    }
+
+    if (parseErrors_[i]) {
+      LOG(ERROR) << "Failed parsing hello packet "
+                 << parseErrors_[i].what().toStdString();
+      continue;
+    }
+
+    // Spark specific msg processing
+    auto& helloPacket = helloPackets_[i];
+    if (helloPacket.helloMsg_ref().has_value()) {
+      processHelloMsg(helloPacket.helloMsg_ref().value(), ifName, myRecvTime);
+    } else if (helloPacket.heartbeatMsg_ref().has_value()) {
+      processHeartbeatMsg(helloPacket.heartbeatMsg_ref().value(), ifName);
+    } else if (helloPacket.handshakeMsg_ref().has_value()) {
+      processHandshakeMsg(helloPacket.handshakeMsg_ref().value(), ifName);
+    }
   }
 }
 
@@ -1681,52 +1949,86 @@ Spark::sendHelloMsg(
   // down event has not arrived yet
   const auto& interfaceEntry = interfaceDb_.at(ifName);
   const auto ifIndex = interfaceEntry.ifIndex;
-  const auto v4Addr = interfaceEntry.v4Network.first;
   const auto v6Addr = interfaceEntry.v6LinkLocalNetwork.first;
-  thrift::OpenrVersion openrVer(kVersion_.version);
-
-  // build the helloMsg from scratch
-  thrift::SparkHelloMsg helloMsg;
-  helloMsg.domainName = myDomainName_;
-  helloMsg.nodeName = myNodeName_;
-  helloMsg.ifName = ifName;
-  helloMsg.seqNum = mySeqNum_;
-  helloMsg.neighborInfos =
-      std::map<std::string, thrift::ReflectedNeighborInfo>{};
-  helloMsg.version = openrVer;
-  helloMsg.solicitResponse = inFastInitState;
-  helloMsg.restarting = restarting;
-  helloMsg.sentTsInUs = getCurrentTimeInUs().count();
-
-  // bake neighborInfo into helloMsg
-  for (const auto& kv : sparkNeighbors_.at(ifName)) {
-    auto const& neighborName = kv.first;
-    auto const& neighbor = kv.second;
-
-    auto& neighborInfo = helloMsg.neighborInfos[neighborName];
-    neighborInfo.seqNum = neighbor.seqNum;
-    neighborInfo.lastNbrMsgSentTsInUs = neighbor.neighborTimestamp.count();
-    neighborInfo.lastMyMsgRcvdTsInUs = neighbor.localTimestamp.count();
-  }
-
-  // fill in helloMsg field
-  thrift::SparkHelloPacket helloPacket;
-  helloPacket.helloMsg_ref() = std::move(helloMsg);
+
+  auto& tmpl = helloTemplates_[ifName];
+  std::string freshPacket;
+  const std::string* packet{nullptr};
+
+  if (tmpl.patchable and tmpl.contentVersion == helloContentVersion_ and
+      tmpl.solicitResponse == inFastInitState and
+      tmpl.restarting == restarting) {
+    // steady state: the hello body is unchanged since the template was
+    // baked. Re-encode just the seq# and the send timestamp in place, as
+    // long as their varints keep the recorded byte lengths
+    const auto seqNumZz = toZigzag(static_cast<int64_t>(mySeqNum_));
+    const auto sentTsZz = toZigzag(getCurrentTimeInUs().count());
+    if (varintLen(seqNumZz) == tmpl.seqNumLen and
+        varintLen(sentTsZz) == tmpl.sentTsLen) {
+      writeVarint(&tmpl.packet[tmpl.seqNumOffset], seqNumZz, tmpl.seqNumLen);
+      writeVarint(&tmpl.packet[tmpl.sentTsOffset], sentTsZz, tmpl.sentTsLen);
+      packet = &tmpl.packet;
+    }
+  }
+
+  if (not packet) {
+    // build the helloMsg from scratch
+    thrift::SparkHelloMsg helloMsg;
+    helloMsg.domainName = myDomainName_;
+    helloMsg.nodeName = myNodeName_;
+    helloMsg.ifName = ifName;
+    helloMsg.seqNum = mySeqNum_;
+    helloMsg.neighborInfos =
+        std::map<std::string, thrift::ReflectedNeighborInfo>{};
+    helloMsg.version = thrift::OpenrVersion(kVersion_.version);
+    helloMsg.solicitResponse = inFastInitState;
+    helloMsg.restarting = restarting;
+
+    // bake neighborInfo into helloMsg
+    for (const auto& kv : sparkNeighbors_.at(ifName)) {
+      auto const& neighborName = kv.first;
+      auto const& neighbor = kv.second;
+
+      auto& neighborInfo = helloMsg.neighborInfos[neighborName];
+      neighborInfo.seqNum = neighbor.seqNum;
+      neighborInfo.lastNbrMsgSentTsInUs = neighbor.neighborTimestamp.count();
+      neighborInfo.lastMyMsgRcvdTsInUs = neighbor.localTimestamp.count();
+    }
+
+    // timestamp as late as possible, after the per-neighbor baking above -
+    // the receiver pairs this with a kernel receive timestamp for RTT math,
+    // so any work done between here and the send call skews the measurement
+    helloMsg.sentTsInUs = getCurrentTimeInUs().count();
+
+    // fill in helloMsg field
+    thrift::SparkHelloPacket helloPacket;
+    helloPacket.helloMsg_ref() = std::move(helloMsg);
+
+    freshPacket = fbzmq::util::writeThriftObjStr(helloPacket, serializer_);
+
+    // arm the template so subsequent transmissions get away with the
+    // in-place patch above
+    bakeHelloTemplate(helloPacket, freshPacket, tmpl);
+    tmpl.contentVersion = helloContentVersion_;
+    tmpl.solicitResponse = inFastInitState;
+    tmpl.restarting = restarting;
+
+    packet = &freshPacket;
+  }
 
   // send the payload
-  auto packet = fbzmq::util::writeThriftObjStr(helloPacket, serializer_);
   folly::SocketAddress dstAddr(
       folly::IPAddress(Constants::kSparkMcastAddr.toString()), udpMcastPort_);
 
-  if (kMinIpv6Mtu < packet.size()) {
+  if (kMinIpv6Mtu < packet->size()) {
     LOG(ERROR) << "Hello packet is too big, cannot sent!";
     return;
   }
 
   auto bytesSent = IoProvider::sendMessage(
-      mcastFd_, ifIndex, v6Addr.asV6(), dstAddr, packet, ioProvider_.get());
+      mcastFd_, ifIndex, v6Addr.asV6(), dstAddr, *packet, ioProvider_.get());
 
-  if ((bytesSent < 0) || (static_cast<size_t>(bytesSent) != packet.size())) {
+  if ((bytesSent < 0) || (static_cast<size_t>(bytesSent) != packet->size())) {
     VLOG(1) << "Sending multicast to " << dstAddr.getAddressStr() << " on "
             << ifName << " failed due to error " << folly::errnoStr(errno);
     return;
@@ -1734,12 +2036,64 @@ Spark::sendHelloMsg(
 
   // update counters for number of pkts and total size of pkts sent
   fb303::fbData->addStatValue(
-      "spark.hello.bytes_sent", packet.size(), fb303::SUM);
+      "spark.hello.bytes_sent", packet->size(), fb303::SUM);
   fb303::fbData->addStatValue("spark.hello.packets_sent", 1, fb303::SUM);
 
   VLOG(4) << "Sent " << bytesSent << " bytes in hello packet";
 }
 
+void
+Spark::bakeHelloTemplate(
+    thrift::SparkHelloPacket& helloPacket,
+    std::string const& packet,
+    HelloTemplate& tmpl) {
+  tmpl.patchable = false;
+
+  auto& helloMsg = helloPacket.helloMsg_ref().value();
+  const auto seqNumZz = toZigzag(helloMsg.seqNum);
+  const auto sentTsZz = toZigzag(helloMsg.sentTsInUs);
+
+  // re-serialize with every payload bit of the two volatile varints
+  // flipped and diff the two buffers: the byte runs that changed are the
+  // fields' encodings. The flipped encodings keep their byte lengths
+  // unless a value's top varint group was all ones - then the sizes or
+  // run lengths below mismatch and the template stays disarmed until the
+  // next transmission
+  helloMsg.seqNum = fromZigzag(flipVarintPayload(seqNumZz));
+  helloMsg.sentTsInUs = fromZigzag(flipVarintPayload(sentTsZz));
+  const auto flipped = fbzmq::util::writeThriftObjStr(helloPacket, serializer_);
+  if (flipped.size() != packet.size()) {
+    return;
+  }
+
+  // collect the contiguous differing runs. Bytes between the two fields
+  // are untouched, so exactly two runs are expected - seq# first,
+  // timestamp second, matching field-id order
+  std::vector<std::pair<size_t, size_t>> runs;
+  for (size_t i = 0; i < packet.size();) {
+    if (packet[i] == flipped[i]) {
+      ++i;
+      continue;
+    }
+    const size_t start = i;
+    while (i < packet.size() and packet[i] != flipped[i]) {
+      ++i;
+    }
+    runs.emplace_back(start, i - start);
+  }
+  if (runs.size() != 2 or runs[0].second != varintLen(seqNumZz) or
+      runs[1].second != varintLen(sentTsZz)) {
+    return;
+  }
+
+  tmpl.packet = packet;
+  tmpl.seqNumOffset = runs[0].first;
+  tmpl.seqNumLen = runs[0].second;
+  tmpl.sentTsOffset = runs[1].first;
+  tmpl.sentTsLen = runs[1].second;
+  tmpl.patchable = true;
+}
+
 void
 Spark::processInterfaceUpdates(thrift::InterfaceDatabase&& ifDb) {
   decltype(interfaceDb_) newInterfaceDb{};
@@ -1845,6 +2199,8 @@ Spark::deleteInterfaceFromDb(const std::set<std::string>& toDel) {
     LOG(INFO) << "Removing " << ifName << " from Spark. "
               << "It is down, declaring all neighbors down";
 
+    helloTemplates_.erase(ifName);
+
     for (const auto& kv : sparkNeighbors_.at(ifName)) {
       auto& neighborName = kv.first;
       auto& neighbor = kv.second;
@@ -1865,7 +2221,6 @@ Spark::deleteInterfaceFromDb(const std::set<std::string>& toDel) {
       neighborDownWrapper(neighbor, ifName, neighborName);
     }
     sparkNeighbors_.erase(ifName);
-    ifNameToHeartbeatTimers_.erase(ifName);
 
     // unsubscribe the socket from mcast group on this interface
     // On error, log and continue
@@ -1880,6 +2235,7 @@ Spark::deleteInterfaceFromDb(const std::set<std::string>& toDel) {
     }
     // cleanup for this interface
     ifNameToHelloTimers_.erase(ifName);
+    ifNameToNextHeartbeatTime_.erase(ifName);
     interfaceDb_.erase(ifName);
   }
 }
@@ -1917,18 +2273,6 @@ Spark::addInterfaceToDb(
       auto result = sparkNeighbors_.emplace(
           ifName, std::unordered_map<std::string, SparkNeighbor>{});
       CHECK(result.second);
-
-      // heartbeatTimers will start as soon as intf is in UP state
-      auto heartbeatTimer =
-          folly::AsyncTimeout::make(*getEvb(), [this, ifName]() noexcept {
-            sendHeartbeatMsg(ifName);
-            // schedule heartbeatTimers periodically as soon as intf is UP
-            ifNameToHeartbeatTimers_.at(ifName)->scheduleTimeout(
-                myHeartbeatTime_);
-          });
-
-      ifNameToHeartbeatTimers_.emplace(ifName, std::move(heartbeatTimer));
-      ifNameToHeartbeatTimers_.at(ifName)->scheduleTimeout(myHeartbeatTime_);
     }
 
     auto rollHelper = [](std::chrono::milliseconds timeDuration) {
@@ -2101,20 +2445,33 @@ std::optional<std::string>
 Spark::getNeighborArea(
     const std::string& peerNodeName,
     const std::string& localIfName,
-    const std::vector<std::tuple<
-        std::string,
-        std::shared_ptr<re2::RE2::Set>,
-        std::shared_ptr<re2::RE2::Set>>>& areaIdRegexList) {
-  std::vector<std::string> candidateAreas{};
+    const AreaMatcher& areaMatcher) {
+  const size_t numAreas = areaMatcher.areaIds.size();
+  std::vector<bool> neighborMatched(numAreas, false);
+  std::vector<bool> interfaceMatched(numAreas, false);
+
+  // one pass over each combined automaton yields the matches for ALL
+  // areas at once
+  std::vector<int> matchedPatterns;
+  if (not areaMatcher.neighborPatternToArea.empty() and
+      areaMatcher.neighborRegexSet->Match(peerNodeName, &matchedPatterns)) {
+    for (const int pattern : matchedPatterns) {
+      neighborMatched[areaMatcher.neighborPatternToArea[pattern]] = true;
+    }
+  }
+  matchedPatterns.clear();
+  if (not areaMatcher.interfacePatternToArea.empty() and
+      areaMatcher.interfaceRegexSet->Match(localIfName, &matchedPatterns)) {
+    for (const int pattern : matchedPatterns) {
+      interfaceMatched[areaMatcher.interfacePatternToArea[pattern]] = true;
+    }
+  }
 
-  // looping through areaIdRegexList
-  for (const auto& t : areaIdRegexList) {
-    const auto& areaId = std::get<0>(t);
-    const auto& neighborRegex = std::get<1>(t);
-    const auto& interfaceRegex = std::get<2>(t);
-    if (neighborRegex and interfaceRegex) {
-      if (matchRegexSet(peerNodeName, neighborRegex) and
-          matchRegexSet(localIfName, interfaceRegex)) {
+  std::vector<std::string> candidateAreas{};
+  for (size_t i = 0; i < numAreas; ++i) {
+    const auto& areaId = areaMatcher.areaIds[i];
+    if (areaMatcher.hasNeighborRegex[i] and areaMatcher.hasInterfaceRegex[i]) {
+      if (neighborMatched[i] and interfaceMatched[i]) {
         VLOG(4) << folly::sformat(
             "Area: {} found for neighbor: {}, interface: {}",
             areaId,
@@ -2122,11 +2479,11 @@ Spark::getNeighborArea(
             localIfName);
         candidateAreas.emplace_back(areaId);
       }
-    } else if (neighborRegex and matchRegexSet(peerNodeName, neighborRegex)) {
+    } else if (areaMatcher.hasNeighborRegex[i] and neighborMatched[i]) {
       VLOG(4) << folly::sformat(
           "Area: {} found for neighbor: {}", areaId, peerNodeName);
       candidateAreas.emplace_back(areaId);
-    } else if (interfaceRegex and matchRegexSet(localIfName, interfaceRegex)) {
+    } else if (areaMatcher.hasInterfaceRegex[i] and interfaceMatched[i]) {
       VLOG(4) << folly::sformat(
           "Area: {} found for interface: {}", areaId, localIfName);
       candidateAreas.emplace_back(areaId);
@@ -2146,4 +2503,26 @@ Spark::getNeighborArea(
   return candidateAreas.back();
 }
 
+std::optional<std::string>
+Spark::deduceNeighborArea(
+    const std::string& peerNodeName, const std::string& ifName) {
+  // key with a '\0' separator, which cannot occur in either name
+  std::string key = peerNodeName;
+  key += '\0';
+  key += ifName;
+
+  auto it = neighborAreaCache_.find(key);
+  if (it != neighborAreaCache_.end()) {
+    return it->second;
+  }
+
+  auto area = getNeighborArea(peerNodeName, ifName, areaMatcher_);
+
+  // negative results are cached too - the regexes cannot change, and this
+  // keeps a misconfigured chatty neighbor from re-running the automaton
+  // (and bumping the error counters) on every hello
+  neighborAreaCache_.set(std::move(key), area);
+  return area;
+}
+
 } // namespace openr
@@ -13,8 +13,10 @@
 #include <boost/serialization/strong_typedef.hpp>
 #include <fbzmq/service/monitor/ZmqMonitorClient.h>
 #include <fbzmq/zmq/Zmq.h>
+#include <folly/ExceptionWrapper.h>
 #include <folly/SocketAddress.h>
 #include <folly/container/EvictingCacheMap.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/fibers/FiberManager.h>
 #include <folly/io/async/AsyncTimeout.h>
 #include <folly/stats/BucketedTimeSeries.h>
@@ -120,7 +122,8 @@ class Spark final : public OpenrEventBase {
         const folly::CIDRNetwork& v6LinkLocalNetwork)
         : ifIndex(ifIndex),
           v4Network(v4Network),
-          v6LinkLocalNetwork(v6LinkLocalNetwork) {}
+          v6LinkLocalNetwork(v6LinkLocalNetwork),
+          v4Subnet(v4Network.first.mask(v4Network.second)) {}
 
     bool
     operator==(const Interface& interface) const {
@@ -133,6 +136,11 @@ class Spark final : public OpenrEventBase {
     int ifIndex{0};
     folly::CIDRNetwork v4Network;
     folly::CIDRNetwork v6LinkLocalNetwork;
+
+    // v4Network's address masked down to its prefix length, derived once
+    // at interface addition so per-handshake subnet validation is a plain
+    // address comparison
+    folly::IPAddress v4Subnet;
   };
 
   // Spark is non-copyable
@@ -156,8 +164,8 @@ class Spark final : public OpenrEventBase {
   bool shouldProcessHelloPacket(
       std::string const& ifName, folly::IPAddress const& addr);
 
-  // process hello packet from a neighbor. we want to see if
-  // the neighbor could be added as adjacent peer.
+  // drain and process a batch of packets from neighbors. we want to see
+  // if the neighbors could be added as adjacent peers.
   void processPacket();
 
   // process helloMsg in Spark context
@@ -174,12 +182,37 @@ class Spark final : public OpenrEventBase {
   void processHandshakeMsg(
       thrift::SparkHandshakeMsg const& handshakeMsg, std::string const& ifName);
 
+  // pre-serialized hello packet for one interface. The hello body only
+  // changes when neighbor state changes, so in steady state sending a
+  // hello patches just the seq# and send-timestamp varints in-place at
+  // their recorded offsets instead of re-serializing the whole packet
+  struct HelloTemplate {
+    std::string packet;
+    size_t seqNumOffset{0};
+    size_t seqNumLen{0};
+    size_t sentTsOffset{0};
+    size_t sentTsLen{0};
+    bool solicitResponse{false};
+    bool restarting{false};
+    uint64_t contentVersion{0};
+    // false when the field offsets could not be pinned down - the packet
+    // is then re-serialized per transmission as before
+    bool patchable{false};
+  };
+
   // util call to send hello msg
   void sendHelloMsg(
       std::string const& ifName,
       bool inFastInitState = false,
       bool restarting = false);
 
+  // locate the seq# and send-timestamp encodings inside the freshly
+  // serialized hello packet and arm the interface's template with them
+  void bakeHelloTemplate(
+      thrift::SparkHelloPacket& helloPacket,
+      std::string const& packet,
+      HelloTemplate& tmpl);
+
   // util call to send handshake msg
   void sendHandshakeMsg(
       std::string const& ifName,
@@ -187,8 +220,16 @@ class Spark final : public OpenrEventBase {
       std::string const& neighborAreaId,
       bool isAdjEstablished);
 
-  // util call to send heartbeat msg
-  void sendHeartbeatMsg(std::string const& ifName);
+  // util call to send one batched burst of heartbeat msgs over all
+  // interfaces with active neighbors. The payload is serialized once and
+  // the burst goes out with a single sendmmsg syscall
+  void sendHeartbeatMsgs();
+
+  // compute the heartbeat sendout interval for an interface. This is the
+  // static config value unless adaptive keepalive is enabled, in which
+  // case the interval tightens so every neighbor on the interface gets
+  // several heartbeats within the hold time we promised it
+  std::chrono::milliseconds getHeartbeatInterval(std::string const& ifName);
 
   // Function processes interface updates from LinkMonitor and appropriately
   // enable/disable neighbor discovery
@@ -221,10 +262,35 @@ class Spark final : public OpenrEventBase {
   // utility method to initialize/reload openr config
   void loadConfig();
 
+  // All areas' neighbor (resp. interface) regexes compiled into ONE
+  // combined RE2::Set, so deducing the area for a neighbor costs a single
+  // automaton pass per dimension instead of one regex-set evaluation per
+  // area. Patterns map back to their area via the *PatternToArea vectors
+  struct AreaMatcher {
+    AreaMatcher();
+
+    // one entry per configured area, in addAreaRegex() call order
+    std::vector<std::string> areaIds;
+
+    // whether the area configures the given dimension. An area with both
+    // dimensions requires both to match; with one, just that one
+    std::vector<bool> hasNeighborRegex;
+    std::vector<bool> hasInterfaceRegex;
+
+    // combined regex sets and pattern-index -> area-index mappings
+    std::unique_ptr<re2::RE2::Set> neighborRegexSet;
+    std::unique_ptr<re2::RE2::Set> interfaceRegexSet;
+    std::vector<size_t> neighborPatternToArea;
+    std::vector<size_t> interfacePatternToArea;
+  };
+
   // utility method to add regex for:
   //
   //  tuple(areaId, neighbor_regex, interface_regex)
   //
+  // into the combined area matcher. The matcher is compiled exactly once,
+  // in loadConfig(), after all areas have been added.
+  //
   // NOTE: by default, use ".*" to match everything.
   void addAreaRegex(
       const std::string& areaId,
@@ -238,23 +304,25 @@ class Spark final : public OpenrEventBase {
   //  1). interface from which helloMsg received;
   //  2). neighbor's nodeName;
   //
-  // against `thrift::AreaConfig` parsed by Spark. It support both
-  // interface and peer node name regexes. Treat multiple/conflict
-  // deduced area as error. Tie-breaking mechanism can be implemented
-  // if needed.
+  // against the compiled `AreaMatcher`. It support both interface and
+  // peer node name regexes. Treat multiple/conflict deduced area as
+  // error. Tie-breaking mechanism can be implemented if needed.
   static std::optional<std::string> getNeighborArea(
       const std::string& peerNodeName,
       const std::string& ifName,
-      const std::vector<std::tuple<
-          std::string,
-          std::shared_ptr<re2::RE2::Set>,
-          std::shared_ptr<re2::RE2::Set>>>& areaIdRegexList);
+      const AreaMatcher& areaMatcher);
 
-  // function to receive and parse received pkt
+  // memoized wrapper around getNeighborArea(). Area regexes are fixed for
+  // the process lifetime, so cached resolutions never go stale
+  std::optional<std::string> deduceNeighborArea(
+      const std::string& peerNodeName, const std::string& ifName);
+
+  // function to validate one received pkt of a batch. Deserialization is
+  // done separately (see processPacket) so it can run off the main thread
   bool parsePacket(
-      thrift::SparkHelloPacket& pkt /* packet( type will be renamed later) */,
       std::string& ifName /* interface */,
-      std::chrono::microseconds& recvTime /* kernel timestamp when recved */);
+      std::chrono::microseconds& recvTime /* kernel timestamp when recved */,
+      IoProvider::RecvdMessage const& recvdMsg /* message metadata */);
 
   // function to validate v4Address with its subnet
   PacketValidationResult validateV4AddressSubnet(
@@ -316,17 +384,20 @@ class Spark final : public OpenrEventBase {
     // neighbor state
     SparkNeighState state;
 
+    // NOTE: per-neighbor timers are wheel-backed (O(1) arm/cancel) since
+    // every received heartbeat re-arms one of them
+
     // timer to periodically send out handshake pkt
-    std::unique_ptr<folly::AsyncTimeout> negotiateTimer{nullptr};
+    std::unique_ptr<WheelTimeout> negotiateTimer{nullptr};
 
     // negotiate stage hold-timer
-    std::unique_ptr<folly::AsyncTimeout> negotiateHoldTimer{nullptr};
+    std::unique_ptr<WheelTimeout> negotiateHoldTimer{nullptr};
 
     // heartbeat hold-timer
-    std::unique_ptr<folly::AsyncTimeout> heartbeatHoldTimer{nullptr};
+    std::unique_ptr<WheelTimeout> heartbeatHoldTimer{nullptr};
 
     // graceful restart hold-timer
-    std::unique_ptr<folly::AsyncTimeout> gracefulRestartHoldTimer{nullptr};
+    std::unique_ptr<WheelTimeout> gracefulRestartHoldTimer{nullptr};
 
     // KvStore related port. Info passed to LinkMonitor for neighborEvent
     int32_t kvStoreCmdPort{0};
@@ -336,6 +407,11 @@ class Spark final : public OpenrEventBase {
     std::chrono::milliseconds heartbeatHoldTime{0};
     std::chrono::milliseconds gracefulRestartHoldTime{0};
 
+    // tightest hold time we have promised this neighbor in a handshake.
+    // Zero until a handshake goes out. In adaptive keepalive mode this
+    // caps our heartbeat interval on the interface from above
+    std::chrono::milliseconds advertisedHoldTime{0};
+
     // v4/v6 network address
     thrift::BinaryAddress transportAddressV4;
     thrift::BinaryAddress transportAddressV6;
@@ -463,6 +539,15 @@ class Spark final : public OpenrEventBase {
   // Spark hold time under graceful-restart mode
   const std::chrono::milliseconds myGracefulRestartHoldTime_{0};
 
+  // Adaptive keepalive mode (see SparkConfig): heartbeat intervals and
+  // advertised hold times scale with measured neighbor RTT, bounded by
+  // [myMinKeepaliveTime_, myHeartbeatTime_] and
+  // [myMinHoldTime_, myHeartbeatHoldTime_] respectively. Set in
+  // loadConfig()
+  bool enableAdaptiveKeepalive_{false};
+  std::chrono::milliseconds myMinKeepaliveTime_{0};
+  std::chrono::milliseconds myMinHoldTime_{0};
+
   // This flag indicates that we will also exchange v4 transportAddress in
   // Spark HelloMessage
   const bool enableV4_{false};
@@ -471,9 +556,36 @@ class Spark final : public OpenrEventBase {
   // NOTE: we increment this on hello sent out of any interfaces
   uint64_t mySeqNum_{1};
 
+  // per-interface pre-serialized hello packets, see HelloTemplate
+  std::unordered_map<std::string, HelloTemplate> helloTemplates_{};
+
+  // bumped whenever anything baked into a hello body changes - neighbor
+  // set or reflected seq#/timestamps - invalidating the hello templates.
+  // Kept global rather than per-interface: stale templates only cost one
+  // re-serialization and invalidations are rare next to heartbeat traffic
+  uint64_t helloContentVersion_{1};
+
   // the multicast socket we use
   int mcastFd_{-1};
 
+  // receive buffer for a whole batch of packets, so a single recvmmsg
+  // syscall drains a burst of hellos/heartbeats per wakeup. Sized in
+  // prepare() to hold kRecvBatchSize packets of kMinIpv6Mtu bytes each
+  std::vector<uint8_t> recvBuf_;
+
+  // scratch reused by every processPacket() cycle - the recvmmsg
+  // scaffolding plus the deserialization targets and their error slots -
+  // so the steady-state per-packet path does not allocate
+  IoProvider::RecvScratch recvScratch_;
+  std::vector<thrift::SparkHelloPacket> helloPackets_;
+  std::vector<folly::exception_wrapper> parseErrors_;
+
+  // lazily created pool used by processPacket() to deserialize big receive
+  // batches in parallel. Only the per-slot thrift decode is fanned out;
+  // neighbor FSM transitions still run in arrival order on the main event
+  // loop, so per-neighbor event ordering is unchanged
+  std::unique_ptr<folly::CPUThreadPoolExecutor> pktParsePool_;
+
   // state transition matrix for Finite-State-Machine
   static const std::vector<std::vector<std::optional<SparkNeighState>>>
       stateMap_;
@@ -500,11 +612,16 @@ class Spark final : public OpenrEventBase {
       std::unique_ptr<folly::AsyncTimeout>>
       ifNameToHelloTimers_{};
 
-  // heartbeat packet send timers for each interface
+  // timer for the periodic batched heartbeat burst over all interfaces
+  std::unique_ptr<folly::AsyncTimeout> heartbeatTimer_{nullptr};
+
+  // next time a heartbeat is due per interface. Only consulted in
+  // adaptive keepalive mode, where interfaces beat at different rates
+  // while still sharing one timer and one sendmmsg burst
   std::unordered_map<
       std::string /* ifName */,
-      std::unique_ptr<folly::AsyncTimeout>>
-      ifNameToHeartbeatTimers_{};
+      std::chrono::steady_clock::time_point>
+      ifNameToNextHeartbeatTime_{};
 
   // number of active neighbors for each interface
   std::unordered_map<
@@ -531,12 +648,14 @@ class Spark final : public OpenrEventBase {
   // global openr config
   std::shared_ptr<const thrift::OpenrConfig> config_{nullptr};
 
-  // areaId -> node name regex parsed from areaConfig
-  std::vector<std::tuple<
-      std::string /* areaId */,
-      std::shared_ptr<re2::RE2::Set> /* neighbor regex */,
-      std::shared_ptr<re2::RE2::Set> /* interface regex */>>
-      areaIdRegexList_{};
+  // area-matching automaton parsed from areaConfig; compiled once in
+  // loadConfig()
+  AreaMatcher areaMatcher_{};
+
+  // bounded cache of per-(neighbor node, local interface) area
+  // resolutions, keyed as "<nodeName>\0<ifName>"
+  folly::EvictingCacheMap<std::string, std::optional<std::string>>
+      neighborAreaCache_{1024};
 
   // Timer for updating and submitting counters periodically
   std::unique_ptr<folly::AsyncTimeout> counterUpdateTimer_{nullptr};
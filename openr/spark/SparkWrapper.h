@@ -95,6 +95,13 @@ class SparkWrapper {
   std::optional<SparkNeighState> getSparkNeighState(
       std::string const& ifName, std::string const& neighborName);
 
+  // access spark's event base, e.g. to sample per-thread counters from
+  // the packet-processing thread in benchmarks
+  OpenrEventBase*
+  getSparkEvb() {
+    return spark_.get();
+  }
+
   static std::pair<folly::IPAddress, folly::IPAddress> getTransportAddrs(
       const thrift::SparkNeighborEvent& event);
 
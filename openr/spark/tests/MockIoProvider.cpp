@@ -169,6 +169,49 @@ MockIoProvider::recvmsg(int sockFd, struct msghdr* msg, int /* flags */) {
   return packet.size();
 }
 
+int
+MockIoProvider::recvmmsg(
+    int sockFd,
+    struct mmsghdr* msgvec,
+    unsigned int vlen,
+    int flags,
+    struct timespec* /* timeout */) {
+  VLOG(4) << "MockIoProvider::recvmmsg called";
+
+  // the real implementation drains the socket queue with one syscall;
+  // here we just keep pulling from the mailbox until it runs dry or the
+  // batch is full
+  unsigned int numMsgs = 0;
+  while (numMsgs < vlen) {
+    auto bytesRead = recvmsg(sockFd, &msgvec[numMsgs].msg_hdr, flags);
+    if (bytesRead < 0) {
+      break;
+    }
+    msgvec[numMsgs].msg_len = bytesRead;
+    ++numMsgs;
+  }
+  return numMsgs == 0 ? -1 : static_cast<int>(numMsgs);
+}
+
+int
+MockIoProvider::sendmmsg(
+    int sockFd, struct mmsghdr* msgvec, unsigned int vlen, int flags) {
+  VLOG(4) << "MockIoProvider::sendmmsg called";
+
+  // the real implementation submits the whole batch with one syscall;
+  // here we just deliver the messages one by one
+  unsigned int numMsgs = 0;
+  while (numMsgs < vlen) {
+    auto bytesSent = sendmsg(sockFd, &msgvec[numMsgs].msg_hdr, flags);
+    if (bytesSent < 0) {
+      break;
+    }
+    msgvec[numMsgs].msg_len = bytesSent;
+    ++numMsgs;
+  }
+  return numMsgs == 0 ? -1 : static_cast<int>(numMsgs);
+}
+
 ssize_t
 MockIoProvider::sendmsg(int sockFd, const struct msghdr* msg, int /* flags */) {
   VLOG(4) << "MockIoProvider::sendmsg called";
@@ -0,0 +1,513 @@
+/**
+ * Copyright (c) 2014-present, Facebook, Inc.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <netinet/in.h>
+
+#include <chrono>
+#include <thread>
+
+#include <fb303/ServiceData.h>
+#include <folly/Benchmark.h>
+#include <folly/IPAddressV6.h>
+#include <folly/init/Init.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+#include <openr/common/Constants.h>
+#include <openr/common/NetworkUtil.h>
+#include <openr/spark/IoProvider.h>
+#include <openr/spark/SparkWrapper.h>
+#include <openr/spark/tests/MockIoProvider.h>
+
+/**
+ * Defines a benchmark that allows users to record customized counter during
+ * benchmarking and passes a parameter to another one. This is common for
+ * benchmarks that need a "problem size" in addition to "number of iterations".
+ */
+#define BENCHMARK_COUNTERS_PARAM(name, counters, param) \
+  BENCHMARK_COUNTERS_NAME_PARAM(name, counters, param, param)
+
+/*
+ * Like BENCHMARK_COUNTERS_PARAM(), but allows a custom name to be specified
+ * for each parameter, rather than using the parameter value.
+ */
+#define BENCHMARK_COUNTERS_NAME_PARAM(name, counters, param_name, ...) \
+  BENCHMARK_IMPL_COUNTERS(                                             \
+      FB_CONCATENATE(name, FB_CONCATENATE(_, param_name)),             \
+      FOLLY_PP_STRINGIZE(name) "(" FOLLY_PP_STRINGIZE(param_name) ")", \
+      counters,                                                        \
+      iters,                                                           \
+      unsigned,                                                        \
+      iters) {                                                         \
+    name(counters, iters, ##__VA_ARGS__);                              \
+  }
+
+using apache::thrift::CompactSerializer;
+
+namespace fb303 = facebook::fb303;
+
+namespace {
+// the interface spark runs on and the interface the benchmark injects
+// synthetic neighbor traffic from
+const std::string kSparkIface{"iface0"};
+const int kSparkIfIndex{1};
+const std::string kInjectorIface{"iface-injector"};
+const int kInjectorIfIndex{2};
+
+const std::string kDomainName{"benchmark_domain"};
+const std::string kNodeName{"node-1"};
+
+const folly::CIDRNetwork kSparkIfaceV4 =
+    folly::IPAddress::createNetwork("10.0.0.1", 8, false /* apply mask */);
+const folly::CIDRNetwork kSparkIfaceV6 =
+    folly::IPAddress::createNetwork("fe80::1/128");
+
+// IPv6 min MTU, big enough for any spark packet
+const size_t kRecvBufSize{1280};
+
+// protocol timers. The benchmark drives every state transition itself by
+// injecting packets, so the timers are only required to not expire while a
+// data point is being taken; the hold times are deliberately generous
+const openr::SparkTimeConfig kTimeConfig{
+    std::chrono::milliseconds(200) /* hello time */,
+    std::chrono::milliseconds(50) /* fast-init hello time */,
+    std::chrono::milliseconds(100) /* handshake time */,
+    std::chrono::milliseconds(100) /* heartbeat time */,
+    std::chrono::milliseconds(30000) /* negotiate hold time */,
+    std::chrono::milliseconds(30000) /* heartbeat hold time */,
+    std::chrono::milliseconds(90000) /* graceful-restart hold time */};
+} // namespace
+
+namespace openr {
+
+/**
+ * Harness that runs one spark instance against a MockIoProvider and speaks
+ * for N synthetic neighbors by injecting crafted hello/handshake/heartbeat
+ * packets from a second, untracked interface. Connectivity is set up both
+ * ways so spark's own transmissions land in the injector's mailbox, where
+ * they are periodically drained and discarded.
+ */
+class SparkScaleWrapper {
+ public:
+  SparkScaleWrapper() {
+    mockIoProvider_ = std::make_shared<MockIoProvider>();
+    mockIoProviderThread_ = std::make_unique<std::thread>([this]() {
+      LOG(INFO) << "Starting mockIoProvider thread.";
+      mockIoProvider_->start();
+      LOG(INFO) << "mockIoProvider thread got stopped.";
+    });
+    mockIoProvider_->waitUntilRunning();
+    mockIoProvider_->addIfNameIfIndex(
+        {{kSparkIface, kSparkIfIndex}, {kInjectorIface, kInjectorIfIndex}});
+    mockIoProvider_->setConnectedPairs(
+        {{kInjectorIface, {{kSparkIface, 0}}},
+         {kSparkIface, {{kInjectorIface, 0}}}});
+
+    spark_ = std::make_unique<SparkWrapper>(
+        kDomainName,
+        kNodeName,
+        std::make_pair(
+            Constants::kOpenrVersion, Constants::kOpenrSupportedVersion),
+        mockIoProvider_,
+        nullptr /* config */,
+        kTimeConfig);
+    spark_->updateInterfaceDb(
+        {{kSparkIface, kSparkIfIndex, kSparkIfaceV4, kSparkIfaceV6}});
+
+    // the injector socket speaks for all synthetic neighbors. Joining the
+    // mcast group binds it to its interface so spark's own transmissions
+    // have a mailbox to land in
+    injectorFd_ = mockIoProvider_->socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+    CHECK_GT(injectorFd_, 0);
+    struct ipv6_mreq mreq;
+    ::memset(&mreq, 0, sizeof(mreq));
+    mreq.ipv6mr_interface = kInjectorIfIndex;
+    CHECK_EQ(
+        0,
+        mockIoProvider_->setsockopt(
+            injectorFd_, IPPROTO_IPV6, IPV6_JOIN_GROUP, &mreq, sizeof(mreq)));
+
+    // wait for spark to bring the interface up - its first fast-init hello
+    // shows up in the injector's mailbox
+    while (drainInjectorMailbox() == 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  ~SparkScaleWrapper() {
+    spark_.reset();
+    mockIoProvider_->stop();
+    mockIoProviderThread_->join();
+  }
+
+  /*
+   * Drive all numNeighbors synthetic neighbors from scratch to ESTABLISHED
+   * with the given pre-built packet sequence and block until spark has
+   * reported NEIGHBOR_UP for each of them
+   */
+  void
+  establishNeighbors(
+      uint32_t numNeighbors, std::vector<std::string> const& packets) {
+    CHECK_EQ(3 * numNeighbors, packets.size());
+    for (size_t index = 0; index < packets.size(); ++index) {
+      injectPacket(index % numNeighbors, packets[index]);
+    }
+
+    uint32_t numUp{0};
+    while (numUp < numNeighbors) {
+      auto maybeEvent =
+          spark_->recvNeighborEvent(std::chrono::milliseconds(60000));
+      CHECK(maybeEvent.hasValue())
+          << "Timed out with " << numUp << "/" << numNeighbors
+          << " neighbors established";
+      if (maybeEvent->eventType ==
+          thrift::SparkNeighborEventType::NEIGHBOR_UP) {
+        ++numUp;
+      }
+    }
+    drainInjectorMailbox();
+  }
+
+  /*
+   * Build the packet sequence establishNeighbors() injects: one wave of
+   * hellos that do not reflect us (IDLE => WARM), one wave that does
+   * (WARM => NEGOTIATE), then one wave of handshakes (NEGOTIATE =>
+   * ESTABLISHED). Built separately so serialization stays outside the
+   * measured window
+   */
+  std::vector<std::string>
+  buildEstablishmentSequence(uint32_t numNeighbors) {
+    std::vector<std::string> packets;
+    packets.reserve(3 * numNeighbors);
+    for (uint32_t index = 0; index < numNeighbors; ++index) {
+      packets.emplace_back(
+          buildHelloPacket(index, false /* reflect us */, 1 /* seqNum */));
+    }
+    for (uint32_t index = 0; index < numNeighbors; ++index) {
+      packets.emplace_back(
+          buildHelloPacket(index, true /* reflect us */, 2 /* seqNum */));
+    }
+    for (uint32_t index = 0; index < numNeighbors; ++index) {
+      packets.emplace_back(buildHandshakePacket(index));
+    }
+    return packets;
+  }
+
+  std::string
+  buildHelloPacket(uint32_t index, bool reflectUs, uint64_t seqNum) {
+    const auto nowInUs = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch());
+
+    thrift::SparkHelloMsg helloMsg;
+    helloMsg.domainName = kDomainName;
+    helloMsg.nodeName = neighborName(index);
+    helloMsg.ifName = folly::sformat("port-{}", index);
+    helloMsg.seqNum = seqNum;
+    helloMsg.version = Constants::kOpenrVersion;
+    helloMsg.solicitResponse = false;
+    helloMsg.restarting = false;
+    helloMsg.sentTsInUs = nowInUs.count();
+    if (reflectUs) {
+      // reflected timestamps only need to be self-consistent:
+      // sent-to-us <= received-by-them <= sent-by-them
+      thrift::ReflectedNeighborInfo reflectedInfo;
+      reflectedInfo.seqNum = 0; // always below spark's own Seq#
+      reflectedInfo.lastNbrMsgSentTsInUs = nowInUs.count() - 1000;
+      reflectedInfo.lastMyMsgRcvdTsInUs = nowInUs.count() - 500;
+      helloMsg.neighborInfos.emplace(kNodeName, std::move(reflectedInfo));
+    }
+
+    thrift::SparkHelloPacket packet;
+    packet.helloMsg_ref() = std::move(helloMsg);
+    return serializePacket(packet);
+  }
+
+  std::string
+  buildHandshakePacket(uint32_t index) {
+    thrift::SparkHandshakeMsg handshakeMsg;
+    handshakeMsg.nodeName = neighborName(index);
+    // claim an established adjacency so spark does not reply with a
+    // handshake of its own per neighbor
+    handshakeMsg.isAdjEstablished = true;
+    handshakeMsg.holdTime = kTimeConfig.myHeartbeatHoldTime.count();
+    handshakeMsg.gracefulRestartTime =
+        kTimeConfig.myGracefulRestartHoldTime.count();
+    handshakeMsg.transportAddressV6 =
+        toBinaryAddress(folly::IPAddress(neighborV6Addr(index)));
+    handshakeMsg.transportAddressV4 =
+        toBinaryAddress(folly::IPAddress(neighborV4Addr(index)));
+    handshakeMsg.openrCtrlThriftPort = 2018;
+    handshakeMsg.kvStoreCmdPort = 10002;
+    handshakeMsg.area = thrift::KvStore_constants::kDefaultArea();
+    handshakeMsg.neighborNodeName_ref() = kNodeName;
+
+    thrift::SparkHelloPacket packet;
+    packet.handshakeMsg_ref() = std::move(handshakeMsg);
+    return serializePacket(packet);
+  }
+
+  std::string
+  buildHeartbeatPacket(uint32_t index, uint64_t seqNum) {
+    thrift::SparkHeartbeatMsg heartbeatMsg;
+    heartbeatMsg.nodeName = neighborName(index);
+    heartbeatMsg.seqNum = seqNum;
+
+    thrift::SparkHelloPacket packet;
+    packet.heartbeatMsg_ref() = std::move(heartbeatMsg);
+    return serializePacket(packet);
+  }
+
+  // inject one pre-serialized packet from the given synthetic neighbor
+  // into spark's interface
+  void
+  injectPacket(uint32_t index, std::string const& packet) {
+    struct msghdr msg;
+    struct iovec entry;
+    union {
+      char buf[CMSG_SPACE(sizeof(struct in6_pktinfo))];
+      struct cmsghdr align;
+    } u;
+    ::memset(&msg, 0, sizeof(msg));
+    ::memset(&u, 0, sizeof(u));
+
+    entry.iov_base = const_cast<char*>(packet.data());
+    entry.iov_len = packet.size();
+    msg.msg_iov = &entry;
+    msg.msg_iovlen = 1;
+    msg.msg_control = u.buf;
+    msg.msg_controllen = sizeof(u.buf);
+
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = IPPROTO_IPV6;
+    cmsg->cmsg_type = IPV6_PKTINFO;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(struct in6_pktinfo));
+    auto pktinfo = reinterpret_cast<struct in6_pktinfo*>(CMSG_DATA(cmsg));
+    pktinfo->ipi6_ifindex = kInjectorIfIndex;
+    const auto srcAddr = neighborV6Addr(index);
+    ::memcpy(&pktinfo->ipi6_addr, srcAddr.bytes(), srcAddr.byteCount());
+
+    CHECK_EQ(
+        packet.size(),
+        mockIoProvider_->sendmsg(injectorFd_, &msg, 0 /* flags */));
+  }
+
+  /*
+   * Discard whatever spark sent towards the injector interface and return
+   * how many packets were dropped. Must be called often enough that the
+   * injector's mailbox does not grow without bound
+   */
+  uint32_t
+  drainInjectorMailbox() {
+    uint32_t drained{0};
+    std::array<char, kRecvBufSize> recvBuf;
+    while (true) {
+      struct msghdr msg;
+      struct iovec entry;
+      sockaddr_storage addrStorage;
+      union {
+        char buf
+            [CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int)) +
+             CMSG_SPACE(sizeof(struct timespec))];
+        struct cmsghdr align;
+      } u;
+      ::memset(&msg, 0, sizeof(msg));
+      entry.iov_base = recvBuf.data();
+      entry.iov_len = recvBuf.size();
+      msg.msg_iov = &entry;
+      msg.msg_iovlen = 1;
+      msg.msg_name = &addrStorage;
+      msg.msg_namelen = sizeof(addrStorage);
+      msg.msg_control = u.buf;
+      msg.msg_controllen = sizeof(u.buf);
+      try {
+        if (mockIoProvider_->recvmsg(injectorFd_, &msg, 0 /* flags */) < 0) {
+          break;
+        }
+      } catch (std::invalid_argument const&) {
+        break; // mailbox is only created upon the first delivery
+      }
+      ++drained;
+    }
+    return drained;
+  }
+
+  // cumulative number of packets spark has accepted off its socket. The
+  // counter materializes with the first packet received
+  uint64_t
+  numPacketsReceived() {
+    const auto counters = fb303::fbData->getCounters();
+    auto it = counters.find("spark.hello_packet_recv.sum");
+    return it == counters.end() ? 0 : it->second;
+  }
+
+  // cumulative number of packets the per-(iface, addr) rate limiter dropped
+  uint64_t
+  numPacketsRateLimited() {
+    const auto counters = fb303::fbData->getCounters();
+    auto it = counters.find("spark.hello_packet_dropped.sum");
+    return it == counters.end() ? 0 : it->second;
+  }
+
+  // CPU time consumed so far by spark's packet-processing thread. Sampled
+  // on the event-base thread itself; excludes the decode offload pool
+  std::chrono::microseconds
+  sparkThreadCpuTime() {
+    struct timespec ts;
+    spark_->getSparkEvb()->getEvb()->runImmediatelyOrRunInEventBaseThreadAndWait(
+        [&ts]() noexcept { clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts); });
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec));
+  }
+
+  static std::string
+  neighborName(uint32_t index) {
+    return folly::sformat("nbr-{}", index);
+  }
+
+  // per-neighbor link-local source address; also the key of the receive
+  // rate-limiter, so every synthetic neighbor gets its own bucket stream
+  static folly::IPAddressV6
+  neighborV6Addr(uint32_t index) {
+    return folly::IPAddressV6(
+        folly::sformat("fe80::{:x}:{:x}", (index >> 16) + 2, index & 0xffff));
+  }
+
+  // per-neighbor v4 address within the spark interface's subnet, so the
+  // handshake passes v4 subnet validation
+  static folly::IPAddressV4
+  neighborV4Addr(uint32_t index) {
+    return folly::IPAddressV4(folly::sformat(
+        "10.{}.{}.{}", (index >> 16) + 1, (index >> 8) & 0xff, index & 0xff));
+  }
+
+  std::unique_ptr<SparkWrapper> spark_;
+
+ private:
+  std::string
+  serializePacket(thrift::SparkHelloPacket const& packet) {
+    std::string result;
+    CompactSerializer::serialize(packet, &result);
+    return result;
+  }
+
+  std::shared_ptr<MockIoProvider> mockIoProvider_;
+  std::unique_ptr<std::thread> mockIoProviderThread_;
+  int injectorFd_{-1};
+};
+
+/**
+ * Benchmark for neighbor discovery at scale:
+ * 1. Start a spark against the MockIoProvider
+ * 2. Inject the full hello/hello/handshake sequence for N synthetic
+ *    neighbors and wait for N NEIGHBOR_UP reports
+ * 3. Report end-to-end establishment latency and the FSM-thread CPU
+ *    spent per neighbor
+ */
+static void
+BM_SparkEstablishNeighbors(
+    folly::UserCounters& counters, uint32_t iters, unsigned numNeighbors) {
+  auto suspender = folly::BenchmarkSuspender();
+
+  uint64_t establishUs{0};
+  uint64_t cpuUs{0};
+  for (uint32_t i = 0; i < iters; ++i) {
+    // every iteration starts from an empty neighbor database
+    auto wrapper = std::make_unique<SparkScaleWrapper>();
+    auto packets = wrapper->buildEstablishmentSequence(numNeighbors);
+
+    auto const cpuStart = wrapper->sparkThreadCpuTime();
+    suspender.dismiss(); // Start measuring benchmark time
+    auto const start = std::chrono::steady_clock::now();
+    wrapper->establishNeighbors(numNeighbors, packets);
+    establishUs += std::chrono::duration_cast<std::chrono::microseconds>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+    suspender.rehire(); // Stop measuring time again
+    cpuUs += (wrapper->sparkThreadCpuTime() - cpuStart).count();
+  }
+
+  auto const numIters = iters == 0 ? 1 : iters;
+  counters["establish_ms"] = establishUs / numIters / 1000;
+  counters["establish_us_per_nbr"] = establishUs / numIters / numNeighbors;
+  counters["fsm_cpu_us_per_nbr"] = cpuUs / numIters / numNeighbors;
+}
+
+/**
+ * Benchmark for steady-state keepalive processing:
+ * 1. Establish N synthetic neighbors outside the measured window
+ * 2. Per iteration inject one heartbeat wave - one packet per neighbor,
+ *    the pattern a full hold interval produces in production - and wait
+ *    until spark has pulled the whole wave off its socket
+ * 3. Report receive-path throughput and FSM-thread CPU per packet. The
+ *    rate limiter is part of the measured path; the rate_limited counter
+ *    shows how much of the load it shed (fast iterations exceed the
+ *    per-bucket pps budget by design)
+ */
+static void
+BM_SparkProcessHeartbeats(
+    folly::UserCounters& counters, uint32_t iters, unsigned numNeighbors) {
+  auto suspender = folly::BenchmarkSuspender();
+
+  auto wrapper = std::make_unique<SparkScaleWrapper>();
+  wrapper->establishNeighbors(
+      numNeighbors, wrapper->buildEstablishmentSequence(numNeighbors));
+
+  std::vector<std::string> packets;
+  packets.reserve(numNeighbors);
+  for (uint32_t index = 0; index < numNeighbors; ++index) {
+    packets.emplace_back(wrapper->buildHeartbeatPacket(index, 3 /* seqNum */));
+  }
+
+  uint64_t pktsProcessed{0};
+  uint64_t elapsedUs{0};
+  auto const cpuStart = wrapper->sparkThreadCpuTime();
+  auto const rateLimitedStart = wrapper->numPacketsRateLimited();
+  for (uint32_t i = 0; i < iters; ++i) {
+    auto const target = wrapper->numPacketsReceived() + numNeighbors;
+    suspender.dismiss(); // Start measuring benchmark time
+    auto const start = std::chrono::steady_clock::now();
+    for (uint32_t index = 0; index < numNeighbors; ++index) {
+      wrapper->injectPacket(index, packets[index]);
+    }
+    while (wrapper->numPacketsReceived() < target) {
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+    elapsedUs += std::chrono::duration_cast<std::chrono::microseconds>(
+                     std::chrono::steady_clock::now() - start)
+                     .count();
+    suspender.rehire(); // Stop measuring time again
+    wrapper->drainInjectorMailbox();
+    pktsProcessed += numNeighbors;
+  }
+  auto const cpuUs = (wrapper->sparkThreadCpuTime() - cpuStart).count();
+
+  counters["pkts_per_sec"] = elapsedUs == 0
+      ? 0
+      : 1000000ull * pktsProcessed / elapsedUs;
+  counters["fsm_cpu_us_per_pkt"] =
+      pktsProcessed == 0 ? 0 : cpuUs / pktsProcessed;
+  counters["rate_limited"] =
+      wrapper->numPacketsRateLimited() - rateLimitedStart;
+}
+
+// The parameter is the number of synthetic neighbors being established
+BENCHMARK_COUNTERS_PARAM(BM_SparkEstablishNeighbors, counters, 100);
+BENCHMARK_COUNTERS_PARAM(BM_SparkEstablishNeighbors, counters, 1000);
+BENCHMARK_COUNTERS_PARAM(BM_SparkEstablishNeighbors, counters, 5000);
+
+// The parameter is the number of heartbeats injected per wave
+BENCHMARK_COUNTERS_PARAM(BM_SparkProcessHeartbeats, counters, 100);
+BENCHMARK_COUNTERS_PARAM(BM_SparkProcessHeartbeats, counters, 1000);
+BENCHMARK_COUNTERS_PARAM(BM_SparkProcessHeartbeats, counters, 5000);
+
+} // namespace openr
+
+int
+main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,169 @@
+/**
+ * Copyright (c) 2014-present, Facebook, Inc.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "Telemetry.h"
+
+#include <algorithm>
+
+#include <fb303/ServiceData.h>
+#include <fbzmq/service/logging/LogSample.h>
+#include <fbzmq/service/monitor/ZmqMonitorClient.h>
+#include <folly/Random.h>
+
+#include <openr/common/Constants.h>
+
+namespace fb303 = facebook::fb303;
+
+namespace openr {
+
+namespace {
+
+// default sink: one TELEMETRY_HISTOGRAM event log per metric towards the
+// monitor, next to the modules' existing event submissions
+class MonitorTelemetrySink final : public TelemetrySink {
+ public:
+  MonitorTelemetrySink(
+      const std::string& nodeName,
+      const MonitorSubmitUrl& monitorSubmitUrl,
+      fbzmq::Context& zmqContext)
+      : nodeName_(nodeName), zmqMonitorClient_(zmqContext, monitorSubmitUrl) {}
+
+  void
+  exportHistogram(
+      const std::string& metric,
+      const TelemetryHistogram& histogram) override {
+    fbzmq::LogSample sample{};
+    sample.addString("event", "TELEMETRY_HISTOGRAM");
+    sample.addString("node_name", nodeName_);
+    sample.addString("metric", metric);
+    sample.addInt("num_events", histogram.numEvents);
+    sample.addInt("num_samples", histogram.numSamples);
+    sample.addInt("min", histogram.min);
+    sample.addInt("max", histogram.max);
+    sample.addInt("avg", histogram.avg);
+    sample.addInt("p50", histogram.p50);
+    sample.addInt("p95", histogram.p95);
+    sample.addInt("p99", histogram.p99);
+
+    fbzmq::thrift::EventLog eventLog;
+    eventLog.category = Constants::kEventLogCategory.toString();
+    eventLog.samples = {sample.toJson()};
+    zmqMonitorClient_.addEventLog(std::move(eventLog));
+  }
+
+ private:
+  const std::string nodeName_;
+  fbzmq::ZmqMonitorClient zmqMonitorClient_;
+};
+
+} // namespace
+
+TelemetrySampler&
+TelemetrySampler::instance() {
+  static TelemetrySampler sampler;
+  return sampler;
+}
+
+void
+TelemetrySampler::record(const std::string& metric, int64_t value) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& reservoir = reservoirs_[metric];
+  const auto numEvents = reservoir.numEvents++;
+  if (reservoir.samples.size() < reservoirSize_) {
+    reservoir.samples.emplace_back(value);
+    return;
+  }
+  // classic algorithm-R: every value seen this interval ends up in the
+  // reservoir with equal probability by overwriting a random slot
+  const auto slot = folly::Random::rand64(numEvents + 1);
+  if (slot < reservoir.samples.size()) {
+    reservoir.samples[slot] = value;
+  }
+}
+
+std::map<std::string, TelemetrySampler::Reservoir>
+TelemetrySampler::snapshotAndReset() {
+  std::map<std::string, Reservoir> snapshot;
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& kv : reservoirs_) {
+    if (kv.second.numEvents == 0) {
+      // idle metric, nothing to export
+      continue;
+    }
+    snapshot.emplace(kv.first, std::move(kv.second));
+    kv.second = Reservoir{};
+  }
+  return snapshot;
+}
+
+void
+TelemetrySampler::setReservoirSize(size_t reservoirSize) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  reservoirSize_ = std::max<size_t>(1, reservoirSize);
+}
+
+TelemetryHistogram
+computeTelemetryHistogram(std::vector<int64_t> samples, uint64_t numEvents) {
+  TelemetryHistogram histogram;
+  histogram.numEvents = numEvents;
+  histogram.numSamples = samples.size();
+  if (samples.empty()) {
+    return histogram;
+  }
+  std::sort(samples.begin(), samples.end());
+  histogram.min = samples.front();
+  histogram.max = samples.back();
+  int64_t sum = 0;
+  for (auto const& value : samples) {
+    sum += value;
+  }
+  histogram.avg = sum / static_cast<int64_t>(samples.size());
+  auto const percentile = [&samples](size_t p) {
+    return samples.at(std::min(samples.size() - 1, samples.size() * p / 100));
+  };
+  histogram.p50 = percentile(50);
+  histogram.p95 = percentile(95);
+  histogram.p99 = percentile(99);
+  return histogram;
+}
+
+Telemetry::Telemetry(
+    std::shared_ptr<const Config> config,
+    const MonitorSubmitUrl& monitorSubmitUrl,
+    fbzmq::Context& zmqContext,
+    std::unique_ptr<TelemetrySink> sink)
+    : myNodeName_(config->getNodeName()), sink_(std::move(sink)) {
+  const auto telemetryConfig = config->getConfig().telemetry_config_ref()
+                                   .value_or(thrift::TelemetryConfig());
+  exportInterval_ = std::chrono::seconds(telemetryConfig.export_interval_s);
+  TelemetrySampler::instance().setReservoirSize(telemetryConfig.reservoir_size);
+
+  if (not sink_) {
+    sink_ = std::make_unique<MonitorTelemetrySink>(
+        myNodeName_, monitorSubmitUrl, zmqContext);
+  }
+
+  exportTimer_ = folly::AsyncTimeout::make(*getEvb(), [this]() noexcept {
+    exportHistograms();
+    exportTimer_->scheduleTimeout(exportInterval_);
+  });
+  exportTimer_->scheduleTimeout(exportInterval_);
+}
+
+void
+Telemetry::exportHistograms() {
+  auto snapshot = TelemetrySampler::instance().snapshotAndReset();
+  for (auto& kv : snapshot) {
+    const auto histogram = computeTelemetryHistogram(
+        std::move(kv.second.samples), kv.second.numEvents);
+    sink_->exportHistogram(kv.first, histogram);
+  }
+  fb303::fbData->addStatValue(
+      "telemetry.exported_histograms", snapshot.size(), fb303::SUM);
+}
+
+} // namespace openr
@@ -0,0 +1,132 @@
+/**
+ * Copyright (c) 2014-present, Facebook, Inc.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <fbzmq/zmq/Zmq.h>
+#include <folly/io/async/AsyncTimeout.h>
+
+#include <openr/common/OpenrEventBase.h>
+#include <openr/common/Types.h>
+#include <openr/config/Config.h>
+
+namespace openr {
+
+/**
+ * Process-wide reservoir sampler for hot-path measurements.
+ *
+ * Modules call record() inline from their hot paths (flood completions,
+ * spf runs, route-programming acks). Each metric keeps a bounded
+ * reservoir holding a uniform random subset of all values seen since
+ * the last export, so per-event cost is O(1) and independent of the
+ * event rate - once the reservoir is full most events only bump a
+ * counter and roll a die. The Telemetry module drains the reservoirs
+ * periodically and ships them as pre-aggregated histograms.
+ */
+class TelemetrySampler final {
+ public:
+  static TelemetrySampler& instance();
+
+  // record one measurement for the given metric
+  void record(const std::string& metric, int64_t value);
+
+  struct Reservoir {
+    // uniform random subset of the values seen; unordered
+    std::vector<int64_t> samples;
+    // number of events observed, including unsampled ones
+    uint64_t numEvents{0};
+  };
+
+  // drain the current reservoirs and start a fresh sampling interval.
+  // Metrics with no events since the previous drain are omitted
+  std::map<std::string, Reservoir> snapshotAndReset();
+
+  // samples kept per metric; bounds both memory and per-event cost
+  void setReservoirSize(size_t reservoirSize);
+
+ private:
+  TelemetrySampler() = default;
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, Reservoir> reservoirs_;
+  size_t reservoirSize_{256};
+};
+
+/**
+ * Pre-aggregated view of one metric's reservoir over one export
+ * interval. Percentiles are estimates derived from the sampled subset
+ */
+struct TelemetryHistogram {
+  uint64_t numEvents{0};
+  uint64_t numSamples{0};
+  int64_t min{0};
+  int64_t max{0};
+  int64_t avg{0};
+  int64_t p50{0};
+  int64_t p95{0};
+  int64_t p99{0};
+};
+
+// aggregate a drained reservoir into histogram form
+TelemetryHistogram computeTelemetryHistogram(
+    std::vector<int64_t> samples, uint64_t numEvents);
+
+/**
+ * Sink the aggregated histograms are exported through. The default
+ * submits event logs to the monitor; deployments can plug in their own
+ * collector
+ */
+class TelemetrySink {
+ public:
+  virtual ~TelemetrySink() = default;
+
+  virtual void exportHistogram(
+      const std::string& metric, const TelemetryHistogram& histogram) = 0;
+};
+
+/**
+ * Periodically drains TelemetrySampler and exports one pre-aggregated
+ * histogram per active metric through the configured sink. Runs as its
+ * own module alongside the monitor; when no sink is given, histograms
+ * are submitted to the monitor as TELEMETRY_HISTOGRAM event logs
+ */
+class Telemetry final : public OpenrEventBase {
+ public:
+  Telemetry(
+      std::shared_ptr<const Config> config,
+      const MonitorSubmitUrl& monitorSubmitUrl,
+      fbzmq::Context& zmqContext,
+      std::unique_ptr<TelemetrySink> sink = nullptr);
+
+  // non-copyable
+  Telemetry(Telemetry const&) = delete;
+  Telemetry& operator=(Telemetry const&) = delete;
+
+ private:
+  // drain the reservoirs and export histograms through the sink
+  void exportHistograms();
+
+  const std::string myNodeName_;
+
+  // seconds between exports
+  std::chrono::seconds exportInterval_{60};
+
+  std::unique_ptr<TelemetrySink> sink_;
+
+  // Timer driving the periodic export
+  std::unique_ptr<folly::AsyncTimeout> exportTimer_{nullptr};
+};
+
+} // namespace openr
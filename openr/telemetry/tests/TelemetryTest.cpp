@@ -0,0 +1,92 @@
+/**
+ * Copyright (c) 2014-present, Facebook, Inc.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+
+#include <folly/init/Init.h>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <openr/telemetry/Telemetry.h>
+
+using namespace openr;
+
+TEST(TelemetrySampler, ReservoirBounds) {
+  auto& sampler = TelemetrySampler::instance();
+  sampler.setReservoirSize(16);
+
+  for (int64_t i = 0; i < 1000; ++i) {
+    sampler.record("test.reservoir_bounds", i);
+  }
+
+  auto snapshot = sampler.snapshotAndReset();
+  auto it = snapshot.find("test.reservoir_bounds");
+  ASSERT_NE(it, snapshot.end());
+  EXPECT_EQ(it->second.numEvents, 1000);
+  // reservoir stays bounded regardless of the event count
+  EXPECT_EQ(it->second.samples.size(), 16);
+  for (auto const& value : it->second.samples) {
+    EXPECT_GE(value, 0);
+    EXPECT_LT(value, 1000);
+  }
+
+  // drained metric is idle and omitted from the next snapshot
+  snapshot = sampler.snapshotAndReset();
+  EXPECT_EQ(snapshot.count("test.reservoir_bounds"), 0);
+}
+
+TEST(TelemetrySampler, KeepsEverySampleBelowReservoirSize) {
+  auto& sampler = TelemetrySampler::instance();
+  sampler.setReservoirSize(64);
+
+  for (int64_t i = 0; i < 10; ++i) {
+    sampler.record("test.small_metric", i);
+  }
+
+  auto snapshot = sampler.snapshotAndReset();
+  auto& reservoir = snapshot.at("test.small_metric");
+  EXPECT_EQ(reservoir.numEvents, 10);
+  ASSERT_EQ(reservoir.samples.size(), 10);
+  std::sort(reservoir.samples.begin(), reservoir.samples.end());
+  for (int64_t i = 0; i < 10; ++i) {
+    EXPECT_EQ(reservoir.samples.at(i), i);
+  }
+}
+
+TEST(Telemetry, ComputeHistogram) {
+  std::vector<int64_t> samples;
+  for (int64_t i = 1; i <= 100; ++i) {
+    samples.emplace_back(i);
+  }
+
+  auto const histogram = computeTelemetryHistogram(std::move(samples), 500);
+  EXPECT_EQ(histogram.numEvents, 500);
+  EXPECT_EQ(histogram.numSamples, 100);
+  EXPECT_EQ(histogram.min, 1);
+  EXPECT_EQ(histogram.max, 100);
+  EXPECT_EQ(histogram.avg, 50);
+  EXPECT_EQ(histogram.p50, 51);
+  EXPECT_EQ(histogram.p95, 96);
+  EXPECT_EQ(histogram.p99, 100);
+
+  // empty reservoir aggregates to an all-zero histogram
+  auto const empty = computeTelemetryHistogram({}, 0);
+  EXPECT_EQ(empty.numSamples, 0);
+  EXPECT_EQ(empty.min, 0);
+  EXPECT_EQ(empty.max, 0);
+}
+
+int
+main(int argc, char* argv[]) {
+  // Parse command line flags
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv);
+  google::InstallFailureSignalHandler();
+
+  // Run the tests
+  return RUN_ALL_TESTS();
+}
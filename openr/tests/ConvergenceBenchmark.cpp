@@ -0,0 +1,258 @@
+/**
+ * Copyright (c) 2014-present, Facebook, Inc.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <sodium.h>
+
+#include <openr/common/NetworkUtil.h>
+#include <openr/common/Util.h>
+#include <openr/tests/OpenrEmulator.h>
+
+using namespace openr;
+
+DEFINE_uint32(num_nodes, 8, "Ring size driven through each scenario");
+DEFINE_uint32(bulk_prefixes, 100, "Prefixes injected in the bulk scenario");
+
+// Regression thresholds. Each scenario fails (non-zero exit for CI) when
+// its measured convergence time exceeds the threshold. Defaults leave
+// generous headroom over observed numbers so only real regressions trip.
+DEFINE_int32(cold_start_threshold_ms, 60000, "Full cold start budget");
+DEFINE_int32(link_flap_threshold_ms, 30000, "Single link flap budget");
+DEFINE_int32(node_failure_threshold_ms, 30000, "Node failure budget");
+DEFINE_int32(bulk_prefix_threshold_ms, 30000, "Bulk prefix injection budget");
+
+namespace {
+
+const std::chrono::seconds kScenarioTimeout(300);
+
+// build a bidirectional ring of FLAGS_num_nodes nodes named "1".."N"
+void
+buildRing(OpenrEmulator& emulator) {
+  for (uint32_t i = 1; i <= FLAGS_num_nodes; ++i) {
+    emulator.addNode(std::to_string(i));
+  }
+  for (uint32_t i = 1; i <= FLAGS_num_nodes; ++i) {
+    emulator.addLink(
+        std::to_string(i),
+        std::to_string(i % FLAGS_num_nodes + 1),
+        std::chrono::milliseconds(10));
+  }
+}
+
+// log the distribution of event-to-FIB-programmed latencies accumulated
+// in each node's fib perf database during the scenario
+void
+reportPerfDistribution(OpenrEmulator& emulator, const std::string& scenario) {
+  std::vector<int64_t> durationsMs;
+  for (const auto& nodeName : emulator.getNodeNames()) {
+    const auto perfDb = emulator.getNode(nodeName)->fibDumpPerfDb();
+    for (const auto& perfEvents : perfDb.eventInfo) {
+      if (perfEvents.events.empty()) {
+        continue;
+      }
+      durationsMs.emplace_back(
+          getTotalPerfEventsDuration(perfEvents).count());
+    }
+  }
+  if (durationsMs.empty()) {
+    LOG(INFO) << scenario << ": no perf events recorded";
+    return;
+  }
+
+  std::sort(durationsMs.begin(), durationsMs.end());
+  LOG(INFO) << scenario << ": event-to-FIB-programmed latency over "
+            << durationsMs.size()
+            << " samples - p50: " << durationsMs[durationsMs.size() / 2]
+            << "ms, p99: " << durationsMs[(durationsMs.size() * 99) / 100]
+            << "ms, max: " << durationsMs.back() << "ms";
+}
+
+// does `node` have a route towards `prefix` that does NOT traverse the
+// given interface
+bool
+routeAvoidsInterface(
+    OpenrWrapper<apache::thrift::CompactSerializer>* node,
+    const thrift::IpPrefix& prefix,
+    const std::string& ifName) {
+  const auto routeDb = node->fibDumpRouteDatabase();
+  for (const auto& route : routeDb.unicastRoutes) {
+    if (route.dest != prefix) {
+      continue;
+    }
+    for (const auto& nextHop : route.nextHops) {
+      if (nextHop.address.ifName_ref().value_or("") == ifName) {
+        return false;
+      }
+    }
+    return route.nextHops.size() > 0;
+  }
+  return false;
+}
+
+} // namespace
+
+//
+// Scenario: full cold start. All nodes boot at once; measure until every
+// node has a fib route towards every other node's allocated prefix.
+//
+TEST(ConvergenceBenchmark, ColdStart) {
+  OpenrEmulator emulator;
+  buildRing(emulator);
+  emulator.run();
+
+  const auto converged = emulator.waitFor(
+      [&]() { return emulator.hasFullMeshReachability(); }, kScenarioTimeout);
+  ASSERT_TRUE(converged.has_value());
+  LOG(INFO) << "ColdStart: " << FLAGS_num_nodes << " nodes converged in "
+            << converged->count() << "ms";
+  reportPerfDistribution(emulator, "ColdStart");
+
+  EXPECT_LE(converged->count(), FLAGS_cold_start_threshold_ms);
+}
+
+//
+// Scenario: single link flap. Fail one ring link, measure re-route the
+// long way around; heal it, measure fall-back onto the direct path.
+//
+TEST(ConvergenceBenchmark, SingleLinkFlap) {
+  OpenrEmulator emulator;
+  buildRing(emulator);
+  emulator.run();
+  ASSERT_TRUE(emulator
+                  .waitFor(
+                      [&]() { return emulator.hasFullMeshReachability(); },
+                      kScenarioTimeout)
+                  .has_value());
+
+  auto* node1 = emulator.getNode("1");
+  const auto prefix2 = emulator.getNode("2")->getIpPrefix();
+  ASSERT_TRUE(prefix2.has_value());
+  const auto iface12 = OpenrEmulator::linkIfName("1", "2");
+
+  emulator.failLink("1", "2");
+  const auto reRouted = emulator.waitFor(
+      [&]() { return routeAvoidsInterface(node1, prefix2.value(), iface12); },
+      kScenarioTimeout);
+  ASSERT_TRUE(reRouted.has_value());
+
+  emulator.restoreLink("1", "2");
+  const auto healed = emulator.waitFor(
+      [&]() {
+        return not routeAvoidsInterface(node1, prefix2.value(), iface12);
+      },
+      kScenarioTimeout);
+  ASSERT_TRUE(healed.has_value());
+
+  LOG(INFO) << "SingleLinkFlap: re-route " << reRouted->count()
+            << "ms, heal " << healed->count() << "ms";
+  reportPerfDistribution(emulator, "SingleLinkFlap");
+
+  EXPECT_LE(reRouted->count(), FLAGS_link_flap_threshold_ms);
+  EXPECT_LE(healed->count(), FLAGS_link_flap_threshold_ms);
+}
+
+//
+// Scenario: node failure. Isolate one node (all of its links go down) and
+// measure until a neighbor withdraws its route towards the dead node.
+//
+TEST(ConvergenceBenchmark, NodeFailure) {
+  OpenrEmulator emulator;
+  buildRing(emulator);
+  emulator.run();
+  ASSERT_TRUE(emulator
+                  .waitFor(
+                      [&]() { return emulator.hasFullMeshReachability(); },
+                      kScenarioTimeout)
+                  .has_value());
+
+  auto* node1 = emulator.getNode("1");
+  const auto prefix2 = emulator.getNode("2")->getIpPrefix();
+  ASSERT_TRUE(prefix2.has_value());
+
+  emulator.failNode("2");
+  const auto withdrawn = emulator.waitFor(
+      [&]() {
+        return not OpenrWrapper<apache::thrift::CompactSerializer>::
+            checkPrefixExists(prefix2.value(), node1->fibDumpRouteDatabase());
+      },
+      kScenarioTimeout);
+  ASSERT_TRUE(withdrawn.has_value());
+  LOG(INFO) << "NodeFailure: routes withdrawn in " << withdrawn->count()
+            << "ms";
+  reportPerfDistribution(emulator, "NodeFailure");
+
+  EXPECT_LE(withdrawn->count(), FLAGS_node_failure_threshold_ms);
+}
+
+//
+// Scenario: bulk prefix injection. One node announces a batch of prefixes;
+// measure until the node farthest around the ring has programmed them all.
+//
+TEST(ConvergenceBenchmark, BulkPrefixInjection) {
+  OpenrEmulator emulator;
+  buildRing(emulator);
+  emulator.run();
+  ASSERT_TRUE(emulator
+                  .waitFor(
+                      [&]() { return emulator.hasFullMeshReachability(); },
+                      kScenarioTimeout)
+                  .has_value());
+
+  std::vector<thrift::PrefixEntry> prefixEntries;
+  std::vector<thrift::IpPrefix> prefixes;
+  for (uint32_t i = 0; i < FLAGS_bulk_prefixes; ++i) {
+    auto prefix = toIpPrefix(folly::sformat("fc00:dead:{}::/64", i));
+    prefixes.emplace_back(prefix);
+    prefixEntries.emplace_back(createPrefixEntry(std::move(prefix)));
+  }
+  auto* farNode =
+      emulator.getNode(std::to_string(1 + FLAGS_num_nodes / 2));
+
+  ASSERT_TRUE(emulator.getNode("1")->addPrefixEntries(prefixEntries));
+  const auto programmed = emulator.waitFor(
+      [&]() {
+        const auto routeDb = farNode->fibDumpRouteDatabase();
+        for (const auto& prefix : prefixes) {
+          if (not OpenrWrapper<apache::thrift::CompactSerializer>::
+                  checkPrefixExists(prefix, routeDb)) {
+            return false;
+          }
+        }
+        return true;
+      },
+      kScenarioTimeout);
+  ASSERT_TRUE(programmed.has_value());
+  LOG(INFO) << "BulkPrefixInjection: " << FLAGS_bulk_prefixes
+            << " prefixes programmed across the ring in "
+            << programmed->count() << "ms";
+  reportPerfDistribution(emulator, "BulkPrefixInjection");
+
+  EXPECT_LE(programmed->count(), FLAGS_bulk_prefix_threshold_ms);
+}
+
+int
+main(int argc, char** argv) {
+  // parse command line flags
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv);
+  google::InstallFailureSignalHandler();
+
+  // init sodium security library
+  if (::sodium_init() == -1) {
+    LOG(ERROR) << "Failed initializing sodium";
+    return 1;
+  }
+
+  // Run the tests
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,121 @@
+/**
+ * Copyright (c) 2014-present, Facebook, Inc.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <folly/init/Init.h>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <sodium.h>
+
+#include <openr/tests/OpenrEmulator.h>
+
+using namespace openr;
+
+namespace {
+
+// ring size for the smoke test; bump this for fabric-scale soak runs
+// (allocation seed in OpenrEmulator accommodates up to 256 nodes)
+const uint32_t kNumNodes{8};
+
+const std::chrono::seconds kConvergenceTimeout(120);
+
+// does `node` have a route towards `prefix` that does NOT traverse the
+// given interface
+bool
+routeAvoidsInterface(
+    OpenrWrapper<apache::thrift::CompactSerializer>* node,
+    const thrift::IpPrefix& prefix,
+    const std::string& ifName) {
+  const auto routeDb = node->fibDumpRouteDatabase();
+  for (const auto& route : routeDb.unicastRoutes) {
+    if (route.dest != prefix) {
+      continue;
+    }
+    for (const auto& nextHop : route.nextHops) {
+      if (nextHop.address.ifName_ref().value_or("") == ifName) {
+        return false;
+      }
+    }
+    return route.nextHops.size() > 0;
+  }
+  return false;
+}
+
+} // namespace
+
+//
+// Bring up a ring of kNumNodes nodes, measure initial convergence, then
+// inject a link failure and verify traffic re-routes the long way around
+// the ring before healing the link again.
+//
+TEST(OpenrEmulationTest, RingConvergenceAndFailover) {
+  OpenrEmulator emulator;
+
+  for (uint32_t i = 1; i <= kNumNodes; ++i) {
+    emulator.addNode(std::to_string(i));
+  }
+  for (uint32_t i = 1; i <= kNumNodes; ++i) {
+    emulator.addLink(
+        std::to_string(i),
+        std::to_string(i % kNumNodes + 1),
+        std::chrono::milliseconds(10));
+  }
+  emulator.run();
+
+  // initial convergence: every node can reach every other node's prefix
+  const auto converged = emulator.waitFor(
+      [&]() { return emulator.hasFullMeshReachability(); },
+      kConvergenceTimeout);
+  ASSERT_TRUE(converged.has_value());
+  LOG(INFO) << "Initial convergence of " << kNumNodes << " nodes took "
+            << converged->count() << "ms";
+
+  auto* node1 = emulator.getNode("1");
+  const auto prefix2 = emulator.getNode("2")->getIpPrefix();
+  ASSERT_TRUE(prefix2.has_value());
+  const auto iface12 = OpenrEmulator::linkIfName("1", "2");
+
+  // fail the 1-2 link; node 1 must re-route towards node 2 the long way
+  // around the ring
+  emulator.failLink("1", "2");
+  const auto reconverged = emulator.waitFor(
+      [&]() {
+        return routeAvoidsInterface(node1, prefix2.value(), iface12);
+      },
+      kConvergenceTimeout);
+  ASSERT_TRUE(reconverged.has_value());
+  LOG(INFO) << "Re-convergence after link failure took "
+            << reconverged->count() << "ms";
+
+  // heal the link; the direct path is shorter and must win again
+  emulator.restoreLink("1", "2");
+  const auto healed = emulator.waitFor(
+      [&]() {
+        return not routeAvoidsInterface(node1, prefix2.value(), iface12) and
+            emulator.hasFullMeshReachability();
+      },
+      kConvergenceTimeout);
+  ASSERT_TRUE(healed.has_value());
+  LOG(INFO) << "Re-convergence after link restore took " << healed->count()
+            << "ms";
+}
+
+int
+main(int argc, char** argv) {
+  // parse command line flags
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv);
+  google::InstallFailureSignalHandler();
+
+  // init sodium security library
+  if (::sodium_init() == -1) {
+    LOG(ERROR) << "Failed initializing sodium";
+    return 1;
+  }
+
+  // Run the tests
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,270 @@
+/**
+ * Copyright (c) 2014-present, Facebook, Inc.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "OpenrEmulator.h"
+
+#include <folly/Format.h>
+
+namespace {
+
+// module timers are scaled down uniformly so large topologies converge
+// within test timeouts
+const std::chrono::seconds kKvStoreDbSyncInterval(1);
+const std::chrono::milliseconds kSpark2HelloTime(100);
+const std::chrono::milliseconds kSpark2FastInitHelloTime(20);
+const std::chrono::milliseconds kSpark2HandshakeTime(20);
+const std::chrono::milliseconds kSpark2HeartbeatTime(20);
+const std::chrono::milliseconds kSpark2HandshakeHoldTime(200);
+const std::chrono::milliseconds kSpark2HeartbeatHoldTime(500);
+const std::chrono::milliseconds kSpark2GRHoldTime(1000);
+const std::chrono::seconds kLinkMonitorAdjHoldTime(1);
+const std::chrono::milliseconds kLinkFlapInitialBackoff(1);
+const std::chrono::milliseconds kLinkFlapMaxBackoff(8);
+const std::chrono::seconds kFibColdStartDuration(1);
+
+// a /56 seed with /64 allocations accommodates 256 nodes
+const std::string kSeedPrefix{"fc00:cafe:babe::/56"};
+const uint8_t kAllocPrefixLen{64};
+
+} // namespace
+
+namespace openr {
+
+OpenrEmulator::OpenrEmulator(bool v4Enabled) : v4Enabled_(v4Enabled) {
+  mockIoProvider_ = std::make_shared<MockIoProvider>();
+
+  // start mock IoProvider thread
+  mockIoProviderThread_ = std::make_unique<std::thread>([this]() {
+    LOG(INFO) << "Starting mockIoProvider thread.";
+    mockIoProvider_->start();
+    LOG(INFO) << "mockIoProvider thread got stopped.";
+  });
+  mockIoProvider_->waitUntilRunning();
+
+  // start mock system service shared by all instances
+  mockServiceHandler_ = std::make_shared<MockSystemHandler>();
+  server_ = std::make_shared<apache::thrift::ThriftServer>();
+  server_->setNumIOWorkerThreads(1);
+  server_->setNumAcceptThreads(1);
+  server_->setPort(0);
+  server_->setInterface(mockServiceHandler_);
+
+  systemThriftThread_.start(server_);
+  port_ = systemThriftThread_.getAddress()->getPort();
+}
+
+OpenrEmulator::~OpenrEmulator() {
+  // stop instances before tearing down the io-provider they poll on.
+  // OpenrWrapper destructor takes care of stopping each instance
+  nodes_.clear();
+
+  LOG(INFO) << "Stopping mockIoProvider thread.";
+  mockIoProvider_->stop();
+  mockIoProviderThread_->join();
+  systemThriftThread_.stop();
+}
+
+void
+OpenrEmulator::addNode(const std::string& nodeName) {
+  CHECK(not running_) << "Topology must be built before run()";
+  CHECK_EQ(nodes_.count(nodeName), 0) << "Duplicate node " << nodeName;
+
+  const auto index = nodeNames_.size();
+  EmulatedNode node;
+  node.v4Addr = folly::CIDRNetwork(
+      folly::IPAddress(folly::sformat("10.0.{}.{}", index / 256, index % 256)),
+      32);
+  node.v6Addr = folly::CIDRNetwork(
+      folly::IPAddress(folly::sformat("fe80::{:x}", index + 1)), 128);
+  node.wrapper =
+      std::make_unique<OpenrWrapper<apache::thrift::CompactSerializer>>(
+          context_,
+          nodeName,
+          v4Enabled_,
+          kKvStoreDbSyncInterval,
+          kSpark2HelloTime,
+          kSpark2FastInitHelloTime,
+          kSpark2HandshakeTime,
+          kSpark2HeartbeatTime,
+          kSpark2HandshakeHoldTime,
+          kSpark2HeartbeatHoldTime,
+          kSpark2GRHoldTime,
+          kLinkMonitorAdjHoldTime,
+          kLinkFlapInitialBackoff,
+          kLinkFlapMaxBackoff,
+          kFibColdStartDuration,
+          mockIoProvider_,
+          port_,
+          openr::memLimitMB,
+          false /* per_prefix_keys */,
+          kSeedPrefix,
+          kAllocPrefixLen);
+
+  nodeNames_.emplace_back(nodeName);
+  nodes_.emplace(nodeName, std::move(node));
+}
+
+void
+OpenrEmulator::addLink(
+    const std::string& node1,
+    const std::string& node2,
+    std::chrono::milliseconds delay) {
+  CHECK(not running_) << "Topology must be built before run()";
+
+  EmulatedLink link;
+  link.node1 = node1;
+  link.node2 = node2;
+  link.ifName1 = linkIfName(node1, node2);
+  link.ifName2 = linkIfName(node2, node1);
+  link.ifIndex1 = nextIfIndex_++;
+  link.ifIndex2 = nextIfIndex_++;
+  link.delay = delay;
+
+  auto& n1 = nodes_.at(node1);
+  auto& n2 = nodes_.at(node2);
+  n1.interfaces.push_back(
+      {link.ifName1, link.ifIndex1, n1.v4Addr, n1.v6Addr});
+  n2.interfaces.push_back(
+      {link.ifName2, link.ifIndex2, n2.v4Addr, n2.v6Addr});
+
+  links_.emplace_back(std::move(link));
+}
+
+void
+OpenrEmulator::run() {
+  CHECK(not running_);
+  running_ = true;
+
+  // register all link interfaces with the io-provider and wire them up
+  IfNameAndifIndex entries;
+  for (const auto& link : links_) {
+    entries.emplace_back(link.ifName1, link.ifIndex1);
+    entries.emplace_back(link.ifName2, link.ifIndex2);
+  }
+  mockIoProvider_->addIfNameIfIndex(entries);
+  applyConnectedPairs();
+
+  // start all instances, then announce their interfaces
+  for (const auto& nodeName : nodeNames_) {
+    nodes_.at(nodeName).wrapper->run();
+  }
+  for (const auto& nodeName : nodeNames_) {
+    auto& node = nodes_.at(nodeName);
+    CHECK(node.wrapper->sparkUpdateInterfaceDb(node.interfaces))
+        << "Failed to announce interfaces on " << nodeName;
+  }
+}
+
+void
+OpenrEmulator::applyConnectedPairs() {
+  ConnectedIfPairs connectedPairs;
+  for (const auto& link : links_) {
+    if (not link.up) {
+      continue;
+    }
+    connectedPairs[link.ifName1].emplace_back(
+        link.ifName2, link.delay.count());
+    connectedPairs[link.ifName2].emplace_back(
+        link.ifName1, link.delay.count());
+  }
+  mockIoProvider_->setConnectedPairs(std::move(connectedPairs));
+}
+
+OpenrEmulator::EmulatedLink&
+OpenrEmulator::getLink(const std::string& node1, const std::string& node2) {
+  for (auto& link : links_) {
+    if ((link.node1 == node1 and link.node2 == node2) or
+        (link.node1 == node2 and link.node2 == node1)) {
+      return link;
+    }
+  }
+  LOG(FATAL) << "No link between " << node1 << " and " << node2;
+}
+
+void
+OpenrEmulator::failLink(const std::string& node1, const std::string& node2) {
+  getLink(node1, node2).up = false;
+  applyConnectedPairs();
+}
+
+void
+OpenrEmulator::restoreLink(
+    const std::string& node1, const std::string& node2) {
+  getLink(node1, node2).up = true;
+  applyConnectedPairs();
+}
+
+void
+OpenrEmulator::failNode(const std::string& nodeName) {
+  for (auto& link : links_) {
+    if (link.node1 == nodeName or link.node2 == nodeName) {
+      link.up = false;
+    }
+  }
+  applyConnectedPairs();
+}
+
+void
+OpenrEmulator::restoreNode(const std::string& nodeName) {
+  for (auto& link : links_) {
+    if (link.node1 == nodeName or link.node2 == nodeName) {
+      link.up = true;
+    }
+  }
+  applyConnectedPairs();
+}
+
+std::optional<std::chrono::milliseconds>
+OpenrEmulator::waitFor(
+    folly::Function<bool()> check, std::chrono::seconds timeout) {
+  const auto start = std::chrono::steady_clock::now();
+  const auto deadline = start + timeout;
+  while (std::chrono::steady_clock::now() < deadline) {
+    if (check()) {
+      return std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - start);
+    }
+    /* sleep override */
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  return std::nullopt;
+}
+
+bool
+OpenrEmulator::hasFullMeshReachability() {
+  // every node must have allocated a prefix
+  std::vector<thrift::IpPrefix> prefixes;
+  for (const auto& nodeName : nodeNames_) {
+    auto prefix = nodes_.at(nodeName).wrapper->getIpPrefix();
+    if (not prefix.has_value()) {
+      return false;
+    }
+    prefixes.emplace_back(std::move(prefix).value());
+  }
+
+  // and a fib route towards every other node's prefix
+  for (size_t i = 0; i < nodeNames_.size(); ++i) {
+    auto routeDb = nodes_.at(nodeNames_[i]).wrapper->fibDumpRouteDatabase();
+    for (size_t j = 0; j < prefixes.size(); ++j) {
+      if (i == j) {
+        continue;
+      }
+      if (not OpenrWrapper<apache::thrift::CompactSerializer>::
+              checkPrefixExists(prefixes[j], routeDb)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+OpenrWrapper<apache::thrift::CompactSerializer>*
+OpenrEmulator::getNode(const std::string& nodeName) {
+  return nodes_.at(nodeName).wrapper.get();
+}
+
+} // namespace openr
@@ -0,0 +1,158 @@
+/**
+ * Copyright (c) 2014-present, Facebook, Inc.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fbzmq/zmq/Zmq.h>
+#include <folly/Function.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+#include <thrift/lib/cpp2/server/ThriftServer.h>
+#include <thrift/lib/cpp2/util/ScopedServerThread.h>
+
+#include <openr/spark/tests/MockIoProvider.h>
+#include <openr/tests/MockSystemHandler.h>
+#include <openr/tests/OpenrWrapper.h>
+
+namespace openr {
+
+/**
+ * OpenrEmulator wires many in-process Open/R instances (OpenrWrapper) into
+ * an arbitrary topology, without lab hardware. All Spark traffic flows
+ * through a shared MockIoProvider which emulates per-link delay; KvStore
+ * and thrift endpoints are connected in-process as usual.
+ *
+ * Usage: build the topology with addNode()/addLink(), call run(), then
+ * drive the emulation with the failure-injection knobs and measure
+ * convergence with waitFor(). Link failures can be injected and healed at
+ * any time; a scripted sequence of failLink()/restoreLink() calls doubles
+ * as a link-flap / lossy-link scenario.
+ *
+ * Not thread-safe, use from the same thread only.
+ */
+class OpenrEmulator {
+ public:
+  explicit OpenrEmulator(bool v4Enabled = false);
+  ~OpenrEmulator();
+
+  // Disable copy constructor
+  OpenrEmulator(OpenrEmulator const&) = delete;
+  OpenrEmulator& operator=(OpenrEmulator const&) = delete;
+
+  //
+  // topology construction; must happen before run()
+  //
+
+  void addNode(const std::string& nodeName);
+
+  // bidirectional link with symmetric one-way delay
+  void addLink(
+      const std::string& node1,
+      const std::string& node2,
+      std::chrono::milliseconds delay = std::chrono::milliseconds(10));
+
+  // start the io-provider thread and all instances, then announce each
+  // instance's interfaces to its spark
+  void run();
+
+  //
+  // scripted failure injection; usable while running
+  //
+
+  void failLink(const std::string& node1, const std::string& node2);
+  void restoreLink(const std::string& node1, const std::string& node2);
+
+  // isolate/reconnect a node by failing/restoring all of its links. The
+  // instance itself keeps running - OpenrWrapper does not support
+  // restarting a stopped instance
+  void failNode(const std::string& nodeName);
+  void restoreNode(const std::string& nodeName);
+
+  //
+  // convergence measurement
+  //
+
+  // poll check every 100ms; returns the time waited until it held, or
+  // std::nullopt if the timeout expired first
+  std::optional<std::chrono::milliseconds> waitFor(
+      folly::Function<bool()> check, std::chrono::seconds timeout);
+
+  // every node has an allocated prefix and a fib route towards every
+  // other node's allocated prefix
+  bool hasFullMeshReachability();
+
+  //
+  // accessors
+  //
+
+  OpenrWrapper<apache::thrift::CompactSerializer>* getNode(
+      const std::string& nodeName);
+
+  const std::vector<std::string>&
+  getNodeNames() const {
+    return nodeNames_;
+  }
+
+  // interface name this emulator assigned on node1 for its link to node2
+  static std::string
+  linkIfName(const std::string& node1, const std::string& node2) {
+    return folly::sformat("{}/{}", node1, node2);
+  }
+
+ private:
+  struct EmulatedLink {
+    std::string node1;
+    std::string node2;
+    std::string ifName1;
+    std::string ifName2;
+    int ifIndex1{0};
+    int ifIndex2{0};
+    std::chrono::milliseconds delay{0};
+    bool up{true};
+  };
+
+  struct EmulatedNode {
+    std::unique_ptr<OpenrWrapper<apache::thrift::CompactSerializer>> wrapper;
+    folly::CIDRNetwork v4Addr;
+    folly::CIDRNetwork v6Addr;
+    std::vector<SparkInterfaceEntry> interfaces;
+  };
+
+  // push the current up/down state of all links into the io-provider
+  void applyConnectedPairs();
+
+  EmulatedLink& getLink(const std::string& node1, const std::string& node2);
+
+  const bool v4Enabled_{false};
+  bool running_{false};
+  int nextIfIndex_{1};
+
+  // shared zmq context and spark io emulation
+  fbzmq::Context context_;
+  std::shared_ptr<MockIoProvider> mockIoProvider_{nullptr};
+  std::unique_ptr<std::thread> mockIoProviderThread_{nullptr};
+
+  // mock system service shared by all instances
+  std::shared_ptr<MockSystemHandler> mockServiceHandler_{nullptr};
+  std::shared_ptr<apache::thrift::ThriftServer> server_{nullptr};
+  apache::thrift::util::ScopedServerThread systemThriftThread_;
+  int32_t port_{0};
+
+  // nodes in creation order plus per-node state
+  std::vector<std::string> nodeNames_;
+  std::map<std::string, EmulatedNode> nodes_;
+  std::vector<EmulatedLink> links_;
+};
+
+} // namespace openr
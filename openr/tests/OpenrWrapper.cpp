@@ -35,7 +35,9 @@ OpenrWrapper<Serializer>::OpenrWrapper(
     std::shared_ptr<IoProvider> ioProvider,
     int32_t systemPort,
     uint32_t memLimit,
-    bool per_prefix_keys)
+    bool per_prefix_keys,
+    const std::string& seedPrefix,
+    uint8_t allocPrefixLen)
     : context_(context),
       nodeId_(nodeId),
       ioProvider_(std::move(ioProvider)),
@@ -70,8 +72,8 @@ OpenrWrapper<Serializer>::OpenrWrapper(
   pfxAllocationConf.loopback_interface = "";
   pfxAllocationConf.prefix_allocation_mode =
       thrift::PrefixAllocationMode::DYNAMIC_ROOT_NODE;
-  pfxAllocationConf.seed_prefix_ref() = "fc00:cafe:babe::/62";
-  pfxAllocationConf.allocate_prefix_len_ref() = 64;
+  pfxAllocationConf.seed_prefix_ref() = seedPrefix;
+  pfxAllocationConf.allocate_prefix_len_ref() = allocPrefixLen;
   tConfig.prefix_allocation_config_ref() = std::move(pfxAllocationConf);
 
   // watchdog
@@ -487,6 +489,13 @@ OpenrWrapper<Serializer>::fibDumpRouteDatabase() {
   return std::move(*routes);
 }
 
+template <class Serializer>
+thrift::PerfDatabase
+OpenrWrapper<Serializer>::fibDumpPerfDb() {
+  auto perfDb = fib_->getPerfDb().get();
+  return std::move(*perfDb);
+}
+
 template <class Serializer>
 bool
 OpenrWrapper<Serializer>::addPrefixEntries(
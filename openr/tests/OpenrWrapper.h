@@ -55,7 +55,11 @@ class OpenrWrapper {
       std::shared_ptr<IoProvider> ioProvider,
       int32_t systemPort,
       uint32_t memLimit = openr::memLimitMB,
-      bool per_prefix_keys = false);
+      bool per_prefix_keys = false,
+      // seed prefix bounds how many nodes can allocate a prefix; widen it
+      // when instantiating more than four nodes (e.g. via OpenrEmulator)
+      const std::string& seedPrefix = "fc00:cafe:babe::/62",
+      uint8_t allocPrefixLen = 64);
 
   ~OpenrWrapper() {
     stop();
@@ -85,6 +89,11 @@ class OpenrWrapper {
    */
   thrift::RouteDatabase fibDumpRouteDatabase();
 
+  /**
+   * get perf event database from fib
+   */
+  thrift::PerfDatabase fibDumpPerfDb();
+
   /**
    * add prefix entries into prefix manager using prefix manager client
    */
@@ -0,0 +1,152 @@
+/**
+ * Copyright (c) 2014-present, Facebook, Inc.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <fb303/ServiceData.h>
+#include <fbzmq/zmq/Zmq.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include <openr/common/ReplayLog.h>
+#include <openr/config/Config.h>
+#include <openr/config/tests/Utils.h>
+#include <openr/decision/Decision.h>
+#include <openr/messaging/ReplicateQueue.h>
+
+using namespace openr;
+
+namespace fb303 = facebook::fb303;
+
+DEFINE_string(
+    capture_file,
+    "",
+    "Publication capture to replay (event_capture_dir/"
+    "decision-publications.bin from the production box)");
+DEFINE_string(
+    node_name,
+    "",
+    "Node name to compute routes as; must match the node the capture was "
+    "taken on for the SPF results to be meaningful");
+DEFINE_double(
+    speedup,
+    1.0,
+    "Replay timing acceleration factor; <= 0 replays back-to-back with no "
+    "inter-record delay");
+DEFINE_bool(enable_v4, true, "Enable v4 route computation during replay");
+
+int
+main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  google::InstallFailureSignalHandler();
+
+  if (FLAGS_capture_file.empty() or FLAGS_node_name.empty()) {
+    LOG(ERROR) << "Both --capture_file and --node_name are required";
+    return 1;
+  }
+
+  // load the whole capture up front so file IO does not skew replay timing
+  std::vector<ReplayRecord> records;
+  {
+    ReplayLogReader reader(FLAGS_capture_file);
+    while (auto record = reader.next()) {
+      if (record->type == ReplayRecordType::PUBLICATION) {
+        records.emplace_back(std::move(*record));
+      }
+    }
+  }
+  if (records.empty()) {
+    LOG(ERROR) << "No publications found in " << FLAGS_capture_file;
+    return 1;
+  }
+  LOG(INFO) << "Loaded " << records.size() << " publications spanning "
+            << (records.back().timestampNs - records.front().timestampNs) /
+          1000000
+            << "ms of capture time";
+
+  // spin up a Decision instance the same way the module tests do
+  auto tConfig = getBasicOpenrConfig(FLAGS_node_name);
+  tConfig.enable_v4_ref() = FLAGS_enable_v4;
+  auto config = std::make_shared<Config>(tConfig);
+
+  fbzmq::Context zmqContext;
+  messaging::ReplicateQueue<thrift::Publication> kvStoreUpdatesQueue;
+  messaging::ReplicateQueue<thrift::RouteDatabaseDelta>
+      staticRoutesUpdateQueue;
+  messaging::ReplicateQueue<thrift::RouteDatabaseDelta> routeUpdatesQueue;
+
+  Decision decision(
+      config,
+      true /* computeLfaPaths */,
+      false /* bgpDryRun */,
+      std::chrono::milliseconds(10) /* debounceMinDur */,
+      std::chrono::milliseconds(250) /* debounceMaxDur */,
+      kvStoreUpdatesQueue.getReader(),
+      staticRoutesUpdateQueue.getReader(),
+      routeUpdatesQueue,
+      zmqContext);
+
+  std::thread decisionThread([&decision]() { decision.run(); });
+  decision.waitUntilRunning();
+
+  // drain route deltas as Fib would, recording when each one lands
+  std::vector<std::chrono::steady_clock::time_point> deltaTimes;
+  std::thread drainThread(
+      [reader = routeUpdatesQueue.getReader(), &deltaTimes]() mutable {
+        while (true) {
+          auto maybeDelta = reader.get();
+          if (maybeDelta.hasError()) {
+            break;
+          }
+          deltaTimes.emplace_back(std::chrono::steady_clock::now());
+        }
+      });
+
+  // feed the capture at original (scaled) timing
+  const auto replayStart = std::chrono::steady_clock::now();
+  auto target = replayStart;
+  for (size_t i = 0; i < records.size(); ++i) {
+    if (i > 0 and FLAGS_speedup > 0) {
+      const auto capturedGapNs =
+          records[i].timestampNs - records[i - 1].timestampNs;
+      target += std::chrono::nanoseconds(
+          static_cast<int64_t>(capturedGapNs / FLAGS_speedup));
+      std::this_thread::sleep_for(target - std::chrono::steady_clock::now());
+    }
+    kvStoreUpdatesQueue.push(ReplayLogReader::decodePublication(records[i]));
+  }
+
+  // let the debounced tail of the computation land before tearing down
+  /* sleep override */
+  std::this_thread::sleep_for(std::chrono::seconds(2));
+  const auto replayEnd = std::chrono::steady_clock::now();
+
+  kvStoreUpdatesQueue.close();
+  staticRoutesUpdateQueue.close();
+  routeUpdatesQueue.close();
+  decision.stop();
+  decisionThread.join();
+  drainThread.join();
+
+  // report what the run did: wall time, emitted route deltas and the
+  // decision module's own perf counters (spf/route-build durations)
+  LOG(INFO) << "Replayed " << records.size() << " publications in "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(
+                   replayEnd - replayStart)
+                   .count()
+            << "ms, emitting " << deltaTimes.size() << " route deltas";
+  for (const auto& [key, value] : fb303::fbData->getCounters()) {
+    if (key.find("decision.") == 0) {
+      LOG(INFO) << "  " << key << " : " << value;
+    }
+  }
+
+  return 0;
+}
@@ -7,9 +7,14 @@
 
 #include "Watchdog.h"
 
+#include <fb303/ServiceData.h>
+#include <folly/memory/Malloc.h>
+
 #include <openr/common/Constants.h>
 #include <openr/common/Util.h>
 
+namespace fb303 = facebook::fb303;
+
 namespace openr {
 
 Watchdog::Watchdog(std::shared_ptr<const Config> config)
@@ -22,6 +27,7 @@ Watchdog::Watchdog(std::shared_ptr<const Config> config)
   watchdogTimer_ = folly::AsyncTimeout::make(*getEvb(), [this]() noexcept {
     updateCounters();
     monitorMemory();
+    updateMemoryCounters();
     // Schedule next timer
     watchdogTimer_->scheduleTimeout(interval_);
   });
@@ -45,6 +51,35 @@ Watchdog::memoryLimitExceeded() {
   return result;
 }
 
+void
+Watchdog::updateMemoryCounters() {
+  // process view
+  auto rss = systemMetrics_.getRSSMemBytes();
+  if (rss.has_value()) {
+    fb303::fbData->setCounter("watchdog.memory.rss_bytes", rss.value());
+  }
+
+  // allocator view; only meaningful when running on jemalloc
+  if (not folly::usingJEMalloc()) {
+    return;
+  }
+  // bump jemalloc's stats epoch so the reads below are current
+  uint64_t epoch = 1;
+  size_t epochLen = sizeof(epoch);
+  if (mallctl("epoch", &epoch, &epochLen, &epoch, epochLen) != 0) {
+    return;
+  }
+  for (const auto* stat : {"allocated", "active", "resident"}) {
+    size_t value = 0;
+    size_t valueLen = sizeof(value);
+    const auto name = folly::sformat("stats.{}", stat);
+    if (mallctl(name.c_str(), &value, &valueLen, nullptr, 0) == 0) {
+      fb303::fbData->setCounter(
+          folly::sformat("watchdog.memory.jemalloc.{}_bytes", stat), value);
+    }
+  }
+}
+
 void
 Watchdog::monitorMemory() {
   auto memInUse_ = systemMetrics_.getRSSMemBytes();
@@ -94,6 +129,19 @@ Watchdog::updateCounters() {
       LOG(WARNING) << "Watchdog: " << name << " thread detected to be dead";
       stuckThreads.emplace_back(name);
     }
+
+    // export loop responsiveness below the kill threshold, so creeping
+    // event-loop degradation is visible before it becomes an outage
+    const auto stats = kv.first->getLoopLatencyStats();
+    fb303::fbData->setCounter(
+        folly::sformat("watchdog.evb.{}.loop_delay_ms.p50", name),
+        stats.p50Ms);
+    fb303::fbData->setCounter(
+        folly::sformat("watchdog.evb.{}.loop_delay_ms.p99", name),
+        stats.p99Ms);
+    fb303::fbData->setCounter(
+        folly::sformat("watchdog.evb.{}.loop_delay_ms.max", name),
+        stats.maxMs);
   }
 
   if (stuckThreads.size() and previousStatus_) {
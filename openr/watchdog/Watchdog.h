@@ -39,6 +39,9 @@ class Watchdog final : public OpenrEventBase {
   // monitor memory usage
   void monitorMemory();
 
+  // export allocator and process memory stats as fb303 counters
+  void updateMemoryCounters();
+
   void fireCrash(const std::string& msg);
 
   const std::string myNodeName_;